@@ -13,13 +13,106 @@
  *                Basic I/O primitives                                  *
  ************************************************************************/
 
+/* Maximum number of serialized but unwritten bytes we allow to pile
+ * up for a client before we consider it gone. The protocol messages
+ * are diffs against previously sent state, so we can't drop
+ * individual messages for a slow client; past this point the client
+ * is treated the same as one whose socket write failed.
+ */
+#define BROADWAY_OUTPUT_MAX_QUEUED_BYTES (16 * 1024 * 1024)
+
 struct BroadwayOutput {
   GOutputStream *out;
   GString *buf;
   int error;
   guint32 serial;
+  gboolean compress;
+  GThread *writer_thread;
+  GAsyncQueue *writer_queue;
+  int queued_bytes;
 };
 
+/* Per-message zlib compression, used when the client negotiated the
+ * broadway-zlib subprotocol. The node trees we send are full of
+ * near-identical records, so even a low compression level cuts them
+ * down substantially. Texture uploads are PNG data and don't shrink
+ * further, but they share the message framing so they get wrapped
+ * too.
+ */
+static GBytes *
+compress_payload (const void *data, gsize count)
+{
+  GZlibCompressor *compressor;
+  GOutputStream *mem, *conv;
+  GBytes *result = NULL;
+
+  compressor = g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB, 3);
+  mem = g_memory_output_stream_new_resizable ();
+  conv = g_converter_output_stream_new (mem, G_CONVERTER (compressor));
+
+  if (g_output_stream_write_all (conv, data, count, NULL, NULL, NULL) &&
+      g_output_stream_close (conv, NULL, NULL))
+    result = g_memory_output_stream_steal_as_bytes (G_MEMORY_OUTPUT_STREAM (mem));
+
+  g_object_unref (conv);
+  g_object_unref (mem);
+  g_object_unref (compressor);
+
+  return result;
+}
+
+/* All socket writes happen on this thread, so a client that reads
+ * slowly only stalls its own queue, not the main loop. A zero-sized
+ * GBytes is pushed as quit sentinel from broadway_output_free().
+ */
+static gpointer
+writer_thread_func (gpointer data)
+{
+  BroadwayOutput *output = data;
+  GBytes *message;
+
+  while (TRUE)
+    {
+      gsize size;
+
+      message = g_async_queue_pop (output->writer_queue);
+      size = g_bytes_get_size (message);
+      if (size == 0)
+        {
+          g_bytes_unref (message);
+          break;
+        }
+
+      if (!g_atomic_int_get (&output->error) &&
+          !g_output_stream_write_all (output->out,
+                                      g_bytes_get_data (message, NULL), size,
+                                      NULL, NULL, NULL))
+        g_atomic_int_set (&output->error, TRUE);
+
+      g_atomic_int_add (&output->queued_bytes, -(int)size);
+      g_bytes_unref (message);
+    }
+
+  return NULL;
+}
+
+static void
+broadway_output_queue_message (BroadwayOutput *output,
+                               GBytes         *message)
+{
+  gsize size = g_bytes_get_size (message);
+
+  if (g_atomic_int_get (&output->queued_bytes) + size > BROADWAY_OUTPUT_MAX_QUEUED_BYTES)
+    {
+      g_atomic_int_set (&output->error, TRUE);
+      g_bytes_unref (message);
+      return;
+    }
+
+  g_atomic_int_add (&output->queued_bytes, (int)size);
+  g_async_queue_push (output->writer_queue, message);
+}
+
 static void
 broadway_output_send_cmd (BroadwayOutput *output,
                           gboolean fin, BroadwayWSOpCode code,
@@ -28,9 +121,19 @@ broadway_output_send_cmd (BroadwayOutput *output,
   gboolean mask = FALSE;
   guchar header[16];
   size_t p;
+  GByteArray *message;
+  GBytes *compressed = NULL;
+  gboolean mid_header, long_header;
+
+  if (output->compress && code == BROADWAY_WS_BINARY && count > 0)
+    {
+      compressed = compress_payload (buf, count);
+      if (compressed)
+        buf = g_bytes_get_data (compressed, &count);
+    }
 
-  gboolean mid_header = count > 125 && count <= 65535;
-  gboolean long_header = count > 65535;
+  mid_header = count > 125 && count <= 65535;
+  long_header = count > 65535;
 
   /* NB. big-endian spec => bit 0 == MSB */
   header[0] = ( (fin ? 0x80 : 0) | (code & 0x0f) );
@@ -48,9 +151,16 @@ broadway_output_send_cmd (BroadwayOutput *output,
       p += 8;
     }
   // FIXME: if we are paranoid we should 'mask' the data
-  // FIXME: we should really emit these as a single write
-  g_output_stream_write_all (output->out, header, p, NULL, NULL, NULL);
-  g_output_stream_write_all (output->out, buf, count, NULL, NULL, NULL);
+
+  message = g_byte_array_sized_new (p + count);
+  g_byte_array_append (message, header, p);
+  if (count > 0)
+    g_byte_array_append (message, buf, count);
+
+  broadway_output_queue_message (output, g_byte_array_free_to_bytes (message));
+
+  if (compressed)
+    g_bytes_unref (compressed);
 }
 
 void broadway_output_pong (BroadwayOutput *output)
@@ -69,12 +179,13 @@ broadway_output_flush (BroadwayOutput *output)
 
   g_string_set_size (output->buf, 0);
 
-  return !output->error;
+  return !g_atomic_int_get (&output->error);
 
 }
 
 BroadwayOutput *
-broadway_output_new (GOutputStream *out, guint32 serial)
+broadway_output_new (GOutputStream *out, guint32 serial,
+                     gboolean compress)
 {
   BroadwayOutput *output;
 
@@ -83,6 +194,10 @@ broadway_output_new (GOutputStream *out, guint32 serial)
   output->out = g_object_ref (out);
   output->buf = g_string_new ("");
   output->serial = serial;
+  output->compress = compress;
+  output->writer_queue = g_async_queue_new_full ((GDestroyNotify)g_bytes_unref);
+  output->writer_thread = g_thread_new ("broadway-output",
+                                        writer_thread_func, output);
 
   return output;
 }
@@ -90,7 +205,16 @@ broadway_output_new (GOutputStream *out, guint32 serial)
 void
 broadway_output_free (BroadwayOutput *output)
 {
+  /* Wake the writer thread up; it drains what's still queued (which
+   * skips the actual writes if the connection already errored out)
+   * and then exits.
+   */
+  g_async_queue_push (output->writer_queue, g_bytes_new (NULL, 0));
+  g_thread_join (output->writer_thread);
+  g_async_queue_unref (output->writer_queue);
+
   g_object_unref (output->out);
+  g_string_free (output->buf, TRUE);
   free (output);
 }
 
@@ -978,7 +978,7 @@ start_input (HttpRequest *request)
   const char *p;
   int i;
   char *res;
-  const char *origin, *host;
+  const char *origin, *host, *protocol;
   BroadwayInput *input;
   const void *data_buffer;
   gsize data_buffer_size;
@@ -995,6 +995,7 @@ start_input (HttpRequest *request)
   key = NULL;
   origin = NULL;
   host = NULL;
+  protocol = "broadway";
   for (i = 0; lines[i] != NULL; i++)
     {
       if ((p = parse_line (lines[i], "Sec-WebSocket-Key")))
@@ -1005,6 +1006,14 @@ start_input (HttpRequest *request)
         host = p;
       else if ((p = parse_line (lines[i], "Sec-WebSocket-Origin")))
         origin = p;
+      else if ((p = parse_line (lines[i], "Sec-WebSocket-Protocol")))
+        {
+          /* Clients that can inflate offer broadway-zlib in addition
+           * to the plain protocol; prefer it to save bandwidth.
+           */
+          if (strstr (p, "broadway-zlib") != NULL)
+            protocol = "broadway-zlib";
+        }
     }
 
   if (host == NULL)
@@ -1023,10 +1032,10 @@ start_input (HttpRequest *request)
                              "Sec-WebSocket-Accept: %s\r\n"
                              "%s%s%s"
                              "Sec-WebSocket-Location: ws://%s/socket\r\n"
-                             "Sec-WebSocket-Protocol: broadway\r\n"
+                             "Sec-WebSocket-Protocol: %s\r\n"
                              "\r\n", accept,
                              origin?"Sec-WebSocket-Origin: ":"", origin?origin:"", origin?"\r\n":"",
-                             host);
+                             host, protocol);
       g_free (accept);
 
 #ifdef DEBUG_WEBSOCKETS
@@ -1057,7 +1066,8 @@ start_input (HttpRequest *request)
   g_byte_array_append (input->buffer, data_buffer, data_buffer_size);
 
   input->output =
-    broadway_output_new (g_io_stream_get_output_stream (request->connection), 0);
+    broadway_output_new (g_io_stream_get_output_stream (request->connection), 0,
+                         strcmp (protocol, "broadway-zlib") == 0);
 
   /* This will free and close the data input stream, but we got all the buffered content already */
   http_request_free (request);
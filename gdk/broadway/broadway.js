@@ -133,6 +133,14 @@ function sendConfigureNotify(surface)
     sendInput("w", [surface.id, surface.x, surface.y, surface.width, surface.height]);
 }
 
+/* Surfaces are placed with a transform rather than left/top: moving a
+ * compositor layer does not relayout the document, and the will-change
+ * hint on the div keeps the layer alive between moves */
+function positionSurfaceDiv(surface)
+{
+    surface.div.style["transform"] = "translate(" + surface.x + "px," + surface.y + "px)";
+}
+
 var positionIndex = 0;
 function cmdCreateSurface(id, x, y, width, height, isTemp)
 {
@@ -149,8 +157,10 @@ function cmdCreateSurface(id, x, y, width, height, isTemp)
     document.body.appendChild(div);
 
     div.style["position"] = "absolute";
-    div.style["left"] = surface.x + "px";
-    div.style["top"] = surface.y + "px";
+    div.style["left"] = "0px";
+    div.style["top"] = "0px";
+    div.style["will-change"] = "transform";
+    positionSurfaceDiv(surface);
     div.style["width"] = surface.width + "px";
     div.style["height"] = surface.height + "px";
     div.style["display"] = "block";
@@ -170,11 +180,7 @@ function cmdShowSurface(id)
         return;
     surface.visible = true;
 
-    var xOffset = surface.x;
-    var yOffset = surface.y;
-
-    surface.div.style["left"] = xOffset + "px";
-    surface.div.style["top"] = yOffset + "px";
+    positionSurfaceDiv(surface);
     surface.div.style["visibility"] = "visible";
 
     restackSurfaces();
@@ -268,15 +274,8 @@ function cmdMoveResizeSurface(id, has_pos, x, y, has_size, w, h)
         surface.div.style["height"] = surface.height + "px";
     }
 
-    if (surface.visible) {
-        if (has_pos) {
-            var xOffset = surface.x;
-            var yOffset = surface.y;
-
-            surface.div.style["left"] = xOffset + "px";
-            surface.div.style["top"] = yOffset + "px";
-        }
-    }
+    if (has_pos)
+        positionSurfaceDiv(surface);
 
     sendConfigureNotify(surface);
 }
@@ -435,14 +434,26 @@ SwapNodes.prototype.insertNode = function(parent, posInParent, oldNode)
         {
             var rect = this.decode_rect();
             var texture_id = this.decode_uint32();
-            var image = new Image();
-            image.width = rect.width;
-            image.height = rect.height;
-            image.style["position"] = "absolute";
-            set_rect_style(image, rect);
-            var texture_url = textures[texture_id];
-            image.src = texture_url;
-            newNode = image;
+            var texture = textures[texture_id];
+            if (texture.bitmap) {
+                var canvas = document.createElement('canvas');
+                canvas.width = Math.round(rect.width);
+                canvas.height = Math.round(rect.height);
+                canvas.style["position"] = "absolute";
+                set_rect_style(canvas, rect);
+                texture.bitmap.then(function(bitmap) {
+                    canvas.getContext('2d').drawImage(bitmap, 0, 0, canvas.width, canvas.height);
+                });
+                newNode = canvas;
+            } else {
+                var image = new Image();
+                image.width = rect.width;
+                image.height = rect.height;
+                image.style["position"] = "absolute";
+                set_rect_style(image, rect);
+                image.src = texture.url;
+                newNode = image;
+            }
         }
         break;
 
@@ -710,14 +721,28 @@ function cmdSurfaceSetNodes(id, node_data)
 function cmdUploadTexture(id, data)
 {
     var blob = new Blob([data],{type: "image/png"});
-    var url = window.URL.createObjectURL(blob);
-    textures[id] = url;
+    var texture = { url: null, bitmap: null };
+
+    if (window.createImageBitmap) {
+        /* Decode the png on the browser's worker pool right away,
+         * instead of on the main thread during the paint that first
+         * shows the image */
+        texture.bitmap = createImageBitmap(blob);
+    } else {
+        texture.url = window.URL.createObjectURL(blob);
+    }
+
+    textures[id] = texture;
 }
 
 function cmdReleaseTexture(id)
 {
-    var url = textures[id];
-    window.URL.revokeObjectURL(url);
+    var texture = textures[id];
+
+    if (texture.url)
+        window.URL.revokeObjectURL(texture.url);
+    if (texture.bitmap)
+        texture.bitmap.then(function(bitmap) { bitmap.close(); });
     delete textures[id];
 }
 
@@ -916,13 +941,63 @@ BinCommands.prototype.get_data = function() {
     return data;
 };
 
+/* Applying commands touches the DOM, so batch up everything that
+ * arrives between two frames and apply it from one animation frame
+ * callback; high update rates then cost at most one relayout and
+ * repaint per display frame. */
+var flushScheduled = false;
+
+function flushOutstanding()
+{
+    flushScheduled = false;
+    handleOutstanding();
+    if (outstandingCommands.length > 0)
+        scheduleFlush();
+}
+
+function scheduleFlush()
+{
+    if (flushScheduled)
+        return;
+    flushScheduled = true;
+
+    /* Animation frames do not fire in background tabs, which would
+     * stall the server's roundtrips, so fall back to a timeout there */
+    if (document.hidden)
+        window.setTimeout(flushOutstanding, 30);
+    else
+        window.requestAnimationFrame(flushOutstanding);
+}
+
 function handleMessage(message)
 {
-    var cmd = new BinCommands(message);
-    outstandingCommands.push(cmd);
-    if (outstandingCommands.length == 1) {
-        handleOutstanding();
-    }
+    outstandingCommands.push(new BinCommands(message));
+    scheduleFlush();
+}
+
+/* When the broadway-zlib subprotocol was negotiated each message is
+ * zlib-compressed. Inflating is asynchronous, so chain the messages
+ * on a promise to keep them in order. */
+var inflateChain = null;
+
+function inflateMessage(data)
+{
+    var ds = new DecompressionStream("deflate");
+    var writer = ds.writable.getWriter();
+    writer.write(data);
+    writer.close();
+    return new Response(ds.readable).arrayBuffer();
+}
+
+function handleCompressedMessage(message)
+{
+    if (inflateChain == null)
+        inflateChain = Promise.resolve();
+    inflateChain = inflateChain.then(function() {
+        return inflateMessage(message);
+    }).then(function(inflated) {
+        handleMessage(inflated);
+    });
 }
 
 function getSurfaceId(ev) {
@@ -2830,7 +2905,10 @@ function connect()
 
     var loc = window.location.toString().replace("http:", "ws:").replace("https:", "wss:");
     loc = loc.substr(0, loc.lastIndexOf('/')) + "/socket";
-    ws = new WebSocket(loc, "broadway");
+    var protocols = "broadway";
+    if (typeof DecompressionStream !== "undefined")
+        protocols = ["broadway-zlib", "broadway"];
+    ws = new WebSocket(loc, protocols);
     ws.binaryType = "arraybuffer";
 
     ws.onopen = function() {
@@ -2842,7 +2920,10 @@ function connect()
         inputSocket = null;
     };
     ws.onmessage = function(event) {
-        handleMessage(event.data);
+        if (ws.protocol == "broadway-zlib")
+            handleCompressedMessage(event.data);
+        else
+            handleMessage(event.data);
     };
 
     var iOS = /(iPad|iPhone|iPod)/g.test( navigator.userAgent );
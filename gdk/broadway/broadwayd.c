@@ -325,6 +325,22 @@ decode_nodes (BroadwayClient *client,
   return node;
 }
 
+typedef struct {
+  void *data;
+  gsize size;
+  int fd;
+} TextureMapping;
+
+static void
+texture_mapping_free (gpointer user_data)
+{
+  TextureMapping *mapping = user_data;
+
+  munmap (mapping->data, mapping->size);
+  close (mapping->fd);
+  g_free (mapping);
+}
+
 static void
 client_handle_request (BroadwayClient *client,
                        BroadwayRequest *request)
@@ -414,40 +430,35 @@ client_handle_request (BroadwayClient *client,
         g_warning ("FD passing mismatch for texture upload %d", request->release_texture.id);
       else
         {
-          char *data, *p;
-          gsize to_read;
-          gssize num_read;
+          TextureMapping *mapping;
+          void *data;
+          gsize map_size;
           GBytes *texture;
 
           fd = GPOINTER_TO_INT (client->fds->data);
           client->fds = g_list_delete_link (client->fds, client->fds);
 
-          data = g_malloc (request->upload_texture.size);
-          to_read = request->upload_texture.size;
-          lseek (fd, request->upload_texture.offset, SEEK_SET);
-
-          p = data;
-          do
+          /* Map the shared memory instead of copying it out; the
+           * mapping (and the fd behind it) stays alive for as long as
+           * the texture data is referenced.
+           */
+          map_size = request->upload_texture.offset + request->upload_texture.size;
+          data = mmap (NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (data == MAP_FAILED)
             {
-              num_read = read (fd, p, to_read);
-              if (num_read == -1 && errno == EAGAIN)
-                continue;
-
-              if (num_read > 0)
-                {
-                  p += num_read;
-                  to_read -= num_read;
-                }
-              else
-                {
-                  g_warning ("Unexpected short read of texture");
-                  break;
-                }
+              g_warning ("Failed to map texture upload: %m");
+              close (fd);
+              break;
             }
-          while (to_read > 0);
-          close (fd);
 
-          texture = g_bytes_new_take (data, request->upload_texture.size);
+          mapping = g_new (TextureMapping, 1);
+          mapping->data = data;
+          mapping->size = map_size;
+          mapping->fd = fd;
+
+          texture = g_bytes_new_with_free_func ((char *)data + request->upload_texture.offset,
+                                                request->upload_texture.size,
+                                                texture_mapping_free, mapping);
           global_id = broadway_server_upload_texture (server, texture);
           g_bytes_unref (texture);
 
@@ -561,7 +572,7 @@ client_input_cb (GPollableInputStream *stream,
           int *fds = g_unix_fd_message_steal_fds (G_UNIX_FD_MESSAGE (messages[i]), &n_fds);
           for (j = 0; j < n_fds; j++)
             {
-              int fd = fds[i];
+              int fd = fds[j];
               client->fds = g_list_append (client->fds, GINT_TO_POINTER (fd));
             }
           g_free (fds);
@@ -585,6 +585,23 @@ gdk_content_serialize_finish (GAsyncResult  *result,
 
 /*** SERIALIZERS ***/
 
+typedef struct {
+  GdkContentSerializer *serializer;
+  GdkPixbuf *pixbuf;          /* exactly one of these is set */
+  cairo_surface_t *surface;
+} PixbufSaveData;
+
+static void
+pixbuf_save_data_free (gpointer data)
+{
+  PixbufSaveData *save = data;
+
+  g_clear_object (&save->serializer);
+  g_clear_object (&save->pixbuf);
+  g_clear_pointer (&save->surface, cairo_surface_destroy);
+  g_free (save);
+}
+
 static void
 pixbuf_serializer_finish (GObject      *source,
                           GAsyncResult *res,
@@ -592,49 +609,88 @@ pixbuf_serializer_finish (GObject      *source,
 {
   GError *error = NULL;
 
-  if (!gdk_pixbuf_save_to_stream_finish (res, &error))
+  if (!g_task_propagate_boolean (G_TASK (res), &error))
     gdk_content_serializer_return_error (serializer, error);
   else
     gdk_content_serializer_return_success (serializer);
 }
 
 static void
-pixbuf_serializer (GdkContentSerializer *serializer)
+pixbuf_serializer_save_in_thread (GTask        *task,
+                                  gpointer      source_object,
+                                  gpointer      task_data,
+                                  GCancellable *cancellable)
 {
-  const GValue *value;
+  PixbufSaveData *save = task_data;
   GdkPixbuf *pixbuf;
   const char *name;
-  
-  name = gdk_content_serializer_get_user_data (serializer);
+  GError *error = NULL;
+  gboolean result;
+
+  name = gdk_content_serializer_get_user_data (save->serializer);
+
+  if (save->pixbuf)
+    pixbuf = g_object_ref (save->pixbuf);
+  else
+    pixbuf = gdk_pixbuf_get_from_surface (save->surface,
+                                          0, 0,
+                                          cairo_image_surface_get_width (save->surface),
+                                          cairo_image_surface_get_height (save->surface));
+
+  result = gdk_pixbuf_save_to_stream (pixbuf,
+                                      gdk_content_serializer_get_output_stream (save->serializer),
+                                      name,
+                                      cancellable,
+                                      &error,
+                                      g_str_equal (name, "png") ? "compression" : NULL, "2",
+                                      NULL);
+  g_object_unref (pixbuf);
+
+  if (result)
+    g_task_return_boolean (task, TRUE);
+  else
+    g_task_return_error (task, error);
+}
+
+static void
+pixbuf_serializer (GdkContentSerializer *serializer)
+{
+  PixbufSaveData *save;
+  const GValue *value;
+  GTask *task;
+
+  save = g_new0 (PixbufSaveData, 1);
+  save->serializer = g_object_ref (serializer);
+
   value = gdk_content_serializer_get_value (serializer);
 
   if (G_VALUE_HOLDS (value, GDK_TYPE_PIXBUF))
     {
-      pixbuf = g_value_dup_object (value);
+      save->pixbuf = g_value_dup_object (value);
     }
   else if (G_VALUE_HOLDS (value, GDK_TYPE_TEXTURE))
     {
       GdkTexture *texture = g_value_get_object (value);
-      cairo_surface_t *surface = gdk_texture_download_surface (texture);
-      pixbuf = gdk_pixbuf_get_from_surface (surface,
-                                            0, 0,
-                                            gdk_texture_get_width (texture), gdk_texture_get_height (texture));
-      cairo_surface_destroy (surface);
+
+      /* The download may need the GL context, so it has to happen
+       * here; the expensive pixbuf conversion and encoding run in the
+       * task thread.
+       */
+      save->surface = gdk_texture_download_surface (texture);
     }
   else
     {
       g_assert_not_reached ();
     }
 
-  gdk_pixbuf_save_to_stream_async (pixbuf,
-                                   gdk_content_serializer_get_output_stream (serializer),
-                                   name,
-				   gdk_content_serializer_get_cancellable (serializer),
-                                   pixbuf_serializer_finish,
-                                   serializer,
-                                   g_str_equal (name, "png") ? "compression" : NULL, "2",
-                                   NULL);
-  g_object_unref (pixbuf);
+  task = g_task_new (NULL,
+                     gdk_content_serializer_get_cancellable (serializer),
+                     pixbuf_serializer_finish,
+                     serializer);
+  g_task_set_priority (task, gdk_content_serializer_get_priority (serializer));
+  g_task_set_task_data (task, save, pixbuf_save_data_free);
+  g_task_run_in_thread (task, pixbuf_serializer_save_in_thread);
+  g_object_unref (task);
 }
 
 static void
@@ -365,6 +365,9 @@ gdk_device_finalize (GObject *object)
   g_clear_pointer (&device->vendor_id, g_free);
   g_clear_pointer (&device->product_id, g_free);
 
+  if (device->raw_input_destroy)
+    device->raw_input_destroy (device->raw_input_data);
+
   G_OBJECT_CLASS (gdk_device_parent_class)->finalize (object);
 }
 
@@ -766,6 +769,55 @@ gdk_device_free_history (GdkTimeCoord **events,
   g_free (events);
 }
 
+/**
+ * gdk_device_set_raw_input_callback:
+ * @device: a physical #GdkDevice
+ * @callback: (allow-none): the function to receive raw samples, or
+ *     %NULL to unsubscribe
+ * @user_data: user data to pass to @callback
+ * @destroy: the function to call when @callback is removed
+ *
+ * Subscribes to the raw input stream of @device.
+ *
+ * Raw samples are delivered straight from the windowing system
+ * connection, bypassing the event queue: they are not subject to
+ * motion compression or to frame-clock event pacing, so a subscriber
+ * sees every sample the hardware produced, with the timestamps the
+ * windowing system reported. Drawing applications can use this to
+ * sample fast strokes at the full device rate rather than at the
+ * display frequency.
+ *
+ * The callback is invoked while windowing system events are being
+ * dispatched, i.e. on the thread running the display's main context.
+ * It is purely informational; the regular (possibly compressed)
+ * events are still emitted.
+ */
+void
+gdk_device_set_raw_input_callback (GdkDevice             *device,
+                                   GdkDeviceRawEventFunc  callback,
+                                   gpointer               user_data,
+                                   GDestroyNotify         destroy)
+{
+  g_return_if_fail (GDK_IS_DEVICE (device));
+
+  if (device->raw_input_destroy)
+    device->raw_input_destroy (device->raw_input_data);
+
+  device->raw_input_callback = callback;
+  device->raw_input_data = user_data;
+  device->raw_input_destroy = destroy;
+}
+
+void
+_gdk_device_deliver_raw_input (GdkDevice          *device,
+                               const GdkTimeCoord *samples,
+                               guint               n_samples)
+{
+  if (device->raw_input_callback)
+    device->raw_input_callback (device, samples, n_samples,
+                                device->raw_input_data);
+}
+
 /**
  * gdk_device_get_name:
  * @device: a #GdkDevice
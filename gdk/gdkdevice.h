@@ -121,6 +121,21 @@ struct _GdkTimeCoord
   gdouble axes[GDK_MAX_TIMECOORD_AXES];
 };
 
+/**
+ * GdkDeviceRawEventFunc:
+ * @device: the #GdkDevice the samples come from
+ * @samples: an array of raw motion samples with hardware timestamps
+ * @n_samples: the number of samples in @samples
+ * @user_data: the data passed to gdk_device_set_raw_input_callback()
+ *
+ * Receives raw motion samples registered with
+ * gdk_device_set_raw_input_callback().
+ */
+typedef void (* GdkDeviceRawEventFunc) (GdkDevice          *device,
+                                        const GdkTimeCoord *samples,
+                                        guint               n_samples,
+                                        gpointer            user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType                 gdk_device_get_type       (void) G_GNUC_CONST;
 
@@ -197,6 +212,12 @@ GDK_AVAILABLE_IN_ALL
 void     gdk_device_free_history (GdkTimeCoord     **events,
                                   gint               n_events);
 
+GDK_AVAILABLE_IN_ALL
+void     gdk_device_set_raw_input_callback (GdkDevice             *device,
+                                            GdkDeviceRawEventFunc  callback,
+                                            gpointer               user_data,
+                                            GDestroyNotify         destroy);
+
 GDK_AVAILABLE_IN_ALL
 gint     gdk_device_get_n_axes     (GdkDevice       *device);
 GDK_AVAILABLE_IN_ALL
@@ -64,6 +64,13 @@ struct _GdkDevice
 
   GdkSeat *seat;
   GdkDeviceTool *last_tool;
+
+  /* Raw input subscription; samples are delivered straight from the
+   * windowing backend, bypassing the event queue
+   */
+  GdkDeviceRawEventFunc raw_input_callback;
+  gpointer raw_input_data;
+  GDestroyNotify raw_input_destroy;
 };
 
 struct _GdkDeviceClass
@@ -162,6 +169,10 @@ gboolean   _gdk_device_translate_axis         (GdkDevice *device,
 GdkTimeCoord ** _gdk_device_allocate_history  (GdkDevice *device,
                                                gint       n_events);
 
+void _gdk_device_deliver_raw_input            (GdkDevice          *device,
+                                               const GdkTimeCoord *samples,
+                                               guint               n_samples);
+
 void _gdk_device_add_slave (GdkDevice *device,
                             GdkDevice *slave);
 void _gdk_device_remove_slave (GdkDevice *device,
@@ -379,6 +379,9 @@ gdk_display_dispose (GObject *object)
   g_list_free_full (display->queued_events, (GDestroyNotify) gdk_event_free);
   display->queued_events = NULL;
   display->queued_tail = NULL;
+  display->queued_length = 0;
+
+  g_clear_object (&display->gl_share_context);
 
   G_OBJECT_CLASS (gdk_display_parent_class)->dispose (object);
 }
@@ -732,9 +735,23 @@ _gdk_display_device_grab_update (GdkDisplay *display,
   GList *grabs;
   guint32 time;
 
-  time = display->last_event_time;
   grabs = g_hash_table_lookup (display->device_grabs, device);
 
+  if (grabs == NULL)
+    return;
+
+  /* Fast path for the steady state: the first grab is the currently
+   * active one and has already been activated, so there is no
+   * transition to perform for this event.
+   */
+  current_grab = grabs->data;
+  if (current_grab->activated &&
+      current_grab->serial_start <= current_serial &&
+      current_grab->serial_end > current_serial)
+    return;
+
+  time = display->last_event_time;
+
   while (grabs != NULL)
     {
       current_grab = grabs->data;
@@ -76,6 +76,8 @@ struct _GdkDisplay
 
   GList *queued_events;
   GList *queued_tail;
+  guint queued_length;           /* Depth of the event queue */
+  guint queued_watermark;        /* Deepest the queue has been, for GDK_DEBUG=events */
 
   guint event_pause_count;       /* How many times events are blocked */
 
@@ -86,6 +88,12 @@ struct _GdkDisplay
   GdkClipboard *clipboard;
   GdkClipboard *primary_clipboard;
 
+  /* Anchor of the display-wide GL share group; the first paint context
+   * created on this display, which all later GL contexts share with so
+   * textures and other GL resources are usable across windows.
+   */
+  GdkGLContext *gl_share_context;
+
   GHashTable *pointers_info;  /* GdkPointerWindowInfo for each device */
   guint32 last_event_time;    /* Last reported event time from server */
 
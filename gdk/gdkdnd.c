@@ -28,6 +28,7 @@
 #include "gdkdisplay.h"
 #include "gdkwindow.h"
 #include "gdkintl.h"
+#include "gdkcontentdeserializer.h"
 #include "gdkcontentformats.h"
 #include "gdkcontentprovider.h"
 #include "gdkcontentserializer.h"
@@ -781,6 +782,196 @@ gdk_drop_read_finish (GdkDragContext *context,
     }
 }
 
+/* Finds the content provider of an in-process drag, so that values can
+ * be transferred without a serialization round trip.  Destination-side
+ * contexts are separate objects, so look up the source-side context
+ * sharing our source window.  Returns %NULL if the drag originated in
+ * another application.
+ */
+static GdkContentProvider *
+gdk_drag_context_get_local_content (GdkDragContext *context)
+{
+  GList *l;
+
+  if (context->is_source)
+    return context->content;
+
+  for (l = contexts; l; l = l->next)
+    {
+      GdkDragContext *other = l->data;
+
+      if (other->is_source &&
+          other->display == context->display &&
+          other->source_window == context->source_window &&
+          other->content != NULL)
+        return other->content;
+    }
+
+  return NULL;
+}
+
+static void
+free_value (gpointer value)
+{
+  g_value_unset (value);
+  g_slice_free (GValue, value);
+}
+
+static void
+gdk_drop_read_value_done (GObject      *source,
+                          GAsyncResult *result,
+                          gpointer      data)
+{
+  GTask *task = data;
+  GError *error = NULL;
+  GValue *value;
+
+  value = g_task_get_task_data (task);
+
+  if (!gdk_content_deserialize_finish (result, value, &error))
+    g_task_return_error (task, error);
+  else
+    g_task_return_pointer (task, value, NULL);
+
+  g_object_unref (task);
+}
+
+static void
+gdk_drop_read_value_got_stream (GObject      *source,
+                                GAsyncResult *result,
+                                gpointer      data)
+{
+  GInputStream *stream;
+  GError *error = NULL;
+  GTask *task = data;
+  const char *mime_type;
+
+  stream = gdk_drop_read_finish (GDK_DRAG_CONTEXT (source), &mime_type, result, &error);
+  if (stream == NULL)
+    {
+      g_task_return_error (task, error);
+      g_object_unref (task);
+      return;
+    }
+
+  gdk_content_deserialize_async (stream,
+                                 mime_type,
+                                 G_VALUE_TYPE (g_task_get_task_data (task)),
+                                 g_task_get_priority (task),
+                                 g_task_get_cancellable (task),
+                                 gdk_drop_read_value_done,
+                                 task);
+  g_object_unref (stream);
+}
+
+/**
+ * gdk_drop_read_value_async:
+ * @context: a #GdkDragContext
+ * @type: a #GType to read
+ * @io_priority: the [I/O priority][io-priority] of the request.
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore.
+ * @callback: (scope async): callback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to callback function
+ *
+ * Asynchronously request the dragged content converted to the given
+ * @type. When the operation is finished @callback will be called.
+ * You can then call gdk_drop_read_value_finish() to get the resulting
+ * #GValue.
+ *
+ * For drags that started in this process and whose content is available
+ * in the given #GType, the value is copied directly from the drag source,
+ * so e.g. a #GdkTexture is handed over without being encoded to and
+ * decoded from an image format. Otherwise, GDK will try to use
+ * gdk_content_deserialize_async() to convert the transferred data.
+ **/
+void
+gdk_drop_read_value_async (GdkDragContext      *context,
+                           GType                type,
+                           int                  io_priority,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+  GdkContentFormatsBuilder *builder;
+  GdkContentFormats *formats;
+  GdkContentProvider *content;
+  GValue *value;
+  GTask *task;
+
+  g_return_if_fail (GDK_IS_DRAG_CONTEXT (context));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+  g_return_if_fail (callback != NULL);
+
+  task = g_task_new (context, cancellable, callback, user_data);
+  g_task_set_priority (task, io_priority);
+  g_task_set_source_tag (task, gdk_drop_read_value_async);
+  value = g_slice_new0 (GValue);
+  g_value_init (value, type);
+  g_task_set_task_data (task, value, free_value);
+
+  content = gdk_drag_context_get_local_content (context);
+  if (content)
+    {
+      GError *error = NULL;
+
+      if (gdk_content_provider_get_value (content, value, &error))
+        {
+          g_task_return_pointer (task, value, NULL);
+          g_object_unref (task);
+          return;
+        }
+      else if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED))
+        {
+          g_task_return_error (task, error);
+          g_object_unref (task);
+          return;
+        }
+      else
+        {
+          /* fall through to regular stream transfer */
+          g_clear_error (&error);
+        }
+    }
+
+  builder = gdk_content_formats_builder_new ();
+  gdk_content_formats_builder_add_gtype (builder, type);
+  formats = gdk_content_formats_builder_free_to_formats (builder);
+  formats = gdk_content_formats_union_deserialize_mime_types (formats);
+
+  GDK_DRAG_CONTEXT_GET_CLASS (context)->read_async (context,
+                                                    formats,
+                                                    io_priority,
+                                                    cancellable,
+                                                    gdk_drop_read_value_got_stream,
+                                                    task);
+
+  gdk_content_formats_unref (formats);
+}
+
+/**
+ * gdk_drop_read_value_finish:
+ * @context: a #GdkDragContext
+ * @result: a #GAsyncResult
+ * @error: a #GError location to store the error occurring, or %NULL to
+ * ignore.
+ *
+ * Finishes an asynchronous drop read started with
+ * gdk_drop_read_value_async().
+ *
+ * Returns: (transfer none): a #GValue containing the result.
+ **/
+const GValue *
+gdk_drop_read_value_finish (GdkDragContext  *context,
+                            GAsyncResult    *result,
+                            GError         **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, context), NULL);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == gdk_drop_read_value_async, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
 /**
  * gdk_drag_context_get_drag_window:
  * @context: a #GdkDragContext
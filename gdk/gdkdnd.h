@@ -128,6 +128,17 @@ GInputStream *          gdk_drop_read_finish            (GdkDragContext        *
                                                          const char           **out_mime_type,
                                                          GAsyncResult          *result,
                                                          GError               **error);
+GDK_AVAILABLE_IN_ALL
+void                    gdk_drop_read_value_async       (GdkDragContext        *context,
+                                                         GType                  type,
+                                                         int                    io_priority,
+                                                         GCancellable          *cancellable,
+                                                         GAsyncReadyCallback    callback,
+                                                         gpointer               user_data);
+GDK_AVAILABLE_IN_ALL
+const GValue *          gdk_drop_read_value_finish      (GdkDragContext        *context,
+                                                         GAsyncResult          *result,
+                                                         GError               **error);
 
 /* Source side */
 
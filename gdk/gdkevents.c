@@ -29,8 +29,10 @@
 #include "gdkinternals.h"
 #include "gdkdisplayprivate.h"
 #include "gdkdndprivate.h"
+#include "gdkseat.h"
 #include "gdk-private.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
@@ -161,9 +163,304 @@ gdk_event_class_init (GdkEventClass *klass)
   quark_event_user_data = g_quark_from_static_string ("gdk-event-user-data");
 }
 
+/*********************************************
+ *        Event recording and replay         *
+ *********************************************/
+
+/* An opt-in facility for capturing the input events of a session to a
+ * file and playing them back later, so performance regressions can be
+ * measured against real interactions instead of synthetic ones.
+ *
+ * Set GDK_EVENT_RECORD=<file> to write one line per input event, with
+ * timestamps relative to the first recorded event. Set
+ * GDK_EVENT_REPLAY=<file> to play a recording back: the replay starts
+ * when the first window is mapped and events are delivered to that
+ * window via gdk_display_put_event(), with inter-event delays scaled
+ * by GDK_EVENT_REPLAY_SPEED (2.0 replays twice as fast).
+ */
+
+typedef struct {
+  gint64 offset;        /* µs since the start of the recording */
+  GdkEventType type;
+  gdouble x, y;
+  guint state;
+  guint detail;         /* keyval, button or scroll direction */
+  guint keycode;
+  gdouble delta_x, delta_y;
+} GdkRecordedEvent;
+
+static FILE *record_file;
+static gint64 record_start;
+
+static GArray *replay_events;
+static guint replay_position;
+static GdkWindow *replay_window;
+static gint64 replay_start;
+static gdouble replay_speed = 1.0;
+
+static void
+gdk_event_record (GdkEvent *event)
+{
+  static int enabled = -1;
+  GdkRecordedEvent rec = { 0, };
+  char x_buf[G_ASCII_DTOSTR_BUF_SIZE], y_buf[G_ASCII_DTOSTR_BUF_SIZE];
+  char dx_buf[G_ASCII_DTOSTR_BUF_SIZE], dy_buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+  if (enabled < 0)
+    {
+      const char *filename = g_getenv ("GDK_EVENT_RECORD");
+
+      enabled = 0;
+      if (filename != NULL)
+        {
+          record_file = fopen (filename, "w");
+          if (record_file == NULL)
+            g_warning ("Could not open '%s' for event recording", filename);
+          else
+            enabled = 1;
+        }
+    }
+
+  if (!enabled)
+    return;
+
+  rec.type = event->any.type;
+
+  switch ((guint) event->any.type)
+    {
+    case GDK_KEY_PRESS:
+    case GDK_KEY_RELEASE:
+      rec.state = event->key.state;
+      rec.detail = event->key.keyval;
+      rec.keycode = event->key.hardware_keycode;
+      break;
+
+    case GDK_BUTTON_PRESS:
+    case GDK_BUTTON_RELEASE:
+      rec.x = event->button.x;
+      rec.y = event->button.y;
+      rec.state = event->button.state;
+      rec.detail = event->button.button;
+      break;
+
+    case GDK_MOTION_NOTIFY:
+      rec.x = event->motion.x;
+      rec.y = event->motion.y;
+      rec.state = event->motion.state;
+      break;
+
+    case GDK_SCROLL:
+      rec.x = event->scroll.x;
+      rec.y = event->scroll.y;
+      rec.state = event->scroll.state;
+      rec.detail = event->scroll.direction;
+      rec.delta_x = event->scroll.delta_x;
+      rec.delta_y = event->scroll.delta_y;
+      break;
+
+    default:
+      return;
+    }
+
+  if (record_start == 0)
+    record_start = g_get_monotonic_time ();
+  rec.offset = g_get_monotonic_time () - record_start;
+
+  /* Coordinates go through g_ascii_dtostr so recordings do not
+   * depend on the locale they were made in */
+  fprintf (record_file,
+           "%" G_GINT64_FORMAT " %d %s %s %u %u %u %s %s\n",
+           rec.offset, rec.type,
+           g_ascii_dtostr (x_buf, sizeof (x_buf), rec.x),
+           g_ascii_dtostr (y_buf, sizeof (y_buf), rec.y),
+           rec.state, rec.detail, rec.keycode,
+           g_ascii_dtostr (dx_buf, sizeof (dx_buf), rec.delta_x),
+           g_ascii_dtostr (dy_buf, sizeof (dy_buf), rec.delta_y));
+  fflush (record_file);
+}
+
+static gboolean
+gdk_event_replay_load (void)
+{
+  const char *filename;
+  char *contents;
+  char **lines;
+  GError *error = NULL;
+  guint i;
+
+  filename = g_getenv ("GDK_EVENT_REPLAY");
+  if (filename == NULL)
+    return FALSE;
+
+  if (!g_file_get_contents (filename, &contents, NULL, &error))
+    {
+      g_warning ("Could not load event recording: %s", error->message);
+      g_error_free (error);
+      return FALSE;
+    }
+
+  replay_events = g_array_new (FALSE, FALSE, sizeof (GdkRecordedEvent));
+
+  lines = g_strsplit (contents, "\n", -1);
+  for (i = 0; lines[i] != NULL; i++)
+    {
+      GdkRecordedEvent rec;
+      char **fields;
+
+      if (lines[i][0] == '\0')
+        continue;
+
+      fields = g_strsplit (lines[i], " ", -1);
+      if (g_strv_length (fields) != 9)
+        {
+          g_warning ("Skipping malformed line %u in event recording", i + 1);
+          g_strfreev (fields);
+          continue;
+        }
+
+      rec.offset = g_ascii_strtoll (fields[0], NULL, 10);
+      rec.type = atoi (fields[1]);
+      rec.x = g_ascii_strtod (fields[2], NULL);
+      rec.y = g_ascii_strtod (fields[3], NULL);
+      rec.state = (guint) g_ascii_strtoull (fields[4], NULL, 10);
+      rec.detail = (guint) g_ascii_strtoull (fields[5], NULL, 10);
+      rec.keycode = (guint) g_ascii_strtoull (fields[6], NULL, 10);
+      rec.delta_x = g_ascii_strtod (fields[7], NULL);
+      rec.delta_y = g_ascii_strtod (fields[8], NULL);
+
+      g_array_append_val (replay_events, rec);
+      g_strfreev (fields);
+    }
+  g_strfreev (lines);
+  g_free (contents);
+
+  if (g_getenv ("GDK_EVENT_REPLAY_SPEED"))
+    {
+      replay_speed = g_ascii_strtod (g_getenv ("GDK_EVENT_REPLAY_SPEED"), NULL);
+      if (replay_speed <= 0)
+        replay_speed = 1.0;
+    }
+
+  return replay_events->len > 0;
+}
+
+static void
+gdk_event_replay_put (GdkRecordedEvent *rec)
+{
+  GdkDisplay *display = gdk_window_get_display (replay_window);
+  GdkSeat *seat = gdk_display_get_default_seat (display);
+  GdkEvent *event;
+  guint32 time_;
+
+  event = gdk_event_new (rec->type);
+  event->any.window = g_object_ref (replay_window);
+  event->any.send_event = TRUE;
+
+  time_ = (guint32) ((g_get_monotonic_time () - replay_start) / 1000);
+
+  switch ((guint) rec->type)
+    {
+    case GDK_KEY_PRESS:
+    case GDK_KEY_RELEASE:
+      event->key.time = time_;
+      event->key.state = rec->state;
+      event->key.keyval = rec->detail;
+      event->key.hardware_keycode = rec->keycode;
+      gdk_event_set_device (event, gdk_seat_get_keyboard (seat));
+      break;
+
+    case GDK_BUTTON_PRESS:
+    case GDK_BUTTON_RELEASE:
+      event->button.time = time_;
+      event->button.x = event->button.x_root = rec->x;
+      event->button.y = event->button.y_root = rec->y;
+      event->button.state = rec->state;
+      event->button.button = rec->detail;
+      gdk_event_set_device (event, gdk_seat_get_pointer (seat));
+      break;
+
+    case GDK_MOTION_NOTIFY:
+      event->motion.time = time_;
+      event->motion.x = event->motion.x_root = rec->x;
+      event->motion.y = event->motion.y_root = rec->y;
+      event->motion.state = rec->state;
+      gdk_event_set_device (event, gdk_seat_get_pointer (seat));
+      break;
+
+    case GDK_SCROLL:
+      event->scroll.time = time_;
+      event->scroll.x = event->scroll.x_root = rec->x;
+      event->scroll.y = event->scroll.y_root = rec->y;
+      event->scroll.state = rec->state;
+      event->scroll.direction = rec->detail;
+      event->scroll.delta_x = rec->delta_x;
+      event->scroll.delta_y = rec->delta_y;
+      gdk_event_set_device (event, gdk_seat_get_pointer (seat));
+      break;
+
+    default:
+      g_object_unref (event);
+      return;
+    }
+
+  gdk_display_put_event (display, event);
+  g_object_unref (event);
+}
+
+static gboolean
+gdk_event_replay_next (gpointer data)
+{
+  while (replay_position < replay_events->len)
+    {
+      GdkRecordedEvent *rec = &g_array_index (replay_events, GdkRecordedEvent,
+                                              replay_position);
+      gint64 due = replay_start + (gint64) (rec->offset / replay_speed);
+      gint64 now = g_get_monotonic_time ();
+
+      if (due > now)
+        {
+          g_timeout_add ((due - now) / 1000 + 1, gdk_event_replay_next, NULL);
+          return G_SOURCE_REMOVE;
+        }
+
+      gdk_event_replay_put (rec);
+      replay_position++;
+    }
+
+  g_message ("Event replay finished (%u events)", replay_events->len);
+  g_clear_object (&replay_window);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gdk_event_replay_check (GdkEvent *event)
+{
+  static int enabled = -1;
+
+  if (enabled < 0)
+    enabled = gdk_event_replay_load () ? 1 : 0;
+
+  if (!enabled ||
+      replay_window != NULL ||
+      replay_position > 0)
+    return;
+
+  /* Events start flowing towards the first mapped window */
+  if (event->any.type == GDK_MAP)
+    {
+      replay_window = g_object_ref (event->any.window);
+      replay_start = g_get_monotonic_time ();
+      gdk_event_replay_next (NULL);
+    }
+}
+
 void
 _gdk_event_emit (GdkEvent *event)
 {
+  gdk_event_record (event);
+  gdk_event_replay_check (event);
+
   if (gdk_drag_context_handle_source_event (event))
     return;
 
@@ -219,11 +516,27 @@ _gdk_event_queue_find_first (GdkDisplay *display)
   return NULL;
 }
 
+static void
+gdk_event_queue_count_append (GdkDisplay *display)
+{
+  display->queued_length++;
+
+#ifdef G_ENABLE_DEBUG
+  if (display->queued_length > display->queued_watermark)
+    {
+      display->queued_watermark = display->queued_length;
+      GDK_DISPLAY_NOTE (display, EVENTS,
+                        g_message ("event queue depth reached %u",
+                                   display->queued_length));
+    }
+#endif
+}
+
 /**
  * _gdk_event_queue_append:
  * @display: a #GdkDisplay
  * @event: Event to append.
- * 
+ *
  * Appends an event onto the tail of the event queue.
  *
  * Returns: the newly appended list node.
@@ -233,12 +546,14 @@ _gdk_event_queue_append (GdkDisplay *display,
 			 GdkEvent   *event)
 {
   display->queued_tail = g_list_append (display->queued_tail, event);
-  
+
   if (!display->queued_events)
     display->queued_events = display->queued_tail;
   else
     display->queued_tail = display->queued_tail->next;
 
+  gdk_event_queue_count_append (display);
+
   return display->queued_tail;
 }
 
@@ -262,6 +577,7 @@ _gdk_event_queue_insert_after (GdkDisplay *display,
   if (prev && prev->next)
     {
       display->queued_events = g_list_insert_before (display->queued_events, prev->next, event);
+      gdk_event_queue_count_append (display);
       return prev->next;
     }
   else
@@ -288,6 +604,7 @@ _gdk_event_queue_insert_before (GdkDisplay *display,
   if (next)
     {
       display->queued_events = g_list_insert_before (display->queued_events, next, event);
+      gdk_event_queue_count_append (display);
       return next->prev;
     }
   else
@@ -315,6 +632,8 @@ _gdk_event_queue_remove_link (GdkDisplay *display,
     node->next->prev = node->prev;
   else
     display->queued_tail = node->prev;
+
+  display->queued_length--;
 }
 
 /**
@@ -356,15 +675,24 @@ gdk_event_push_history (GdkEvent       *event,
   g_assert (event->any.type == GDK_MOTION_NOTIFY);
   g_assert (history_event->any.type == GDK_MOTION_NOTIFY);
 
-  hist = g_new0 (GdkTimeCoord, 1);
+  /* The history entries are kept in one array, appended in order,
+   * rather than allocated one by one; compressed tablet motion is by
+   * far our most frequent event allocation.
+   */
+  if (event->motion.history == NULL)
+    event->motion.history = g_array_new (FALSE, TRUE, sizeof (GdkTimeCoord));
+
+  g_array_set_size (event->motion.history, event->motion.history->len + 1);
+  hist = &g_array_index (event->motion.history, GdkTimeCoord,
+                         event->motion.history->len - 1);
+
+  hist->time = gdk_event_get_time (history_event);
 
   device = gdk_event_get_device (history_event);
   n_axes = gdk_device_get_n_axes (device);
 
   for (i = 0; i <= MIN (n_axes, GDK_MAX_TIMECOORD_AXES); i++)
     gdk_event_get_axis (history_event, i, &hist->axes[i]);
-
-  event->motion.history = g_list_prepend (event->motion.history, hist);
 }
 
 void
@@ -422,6 +750,7 @@ _gdk_event_queue_handle_motion_compression (GdkDisplay *display)
       gdk_event_free (pending_motions->data);
       display->queued_events = g_list_delete_link (display->queued_events,
                                                    pending_motions);
+      display->queued_length--;
       pending_motions = next;
     }
 
@@ -591,12 +920,6 @@ gdk_event_get_pointer_emulated (GdkEvent *event)
   return (event->any.flags & GDK_EVENT_POINTER_EMULATED) != 0;
 }
 
-static GdkTimeCoord *
-copy_time_coord (const GdkTimeCoord *coord)
-{
-  return g_memdup (coord, sizeof (GdkTimeCoord));
-}
-
 /**
  * gdk_event_copy:
  * @event: a #GdkEvent
@@ -680,8 +1003,10 @@ gdk_event_copy (const GdkEvent *event)
 
       if (event->motion.history)
         {
-          new_event->motion.history = g_list_copy_deep (event->motion.history,
-                                                        (GCopyFunc) copy_time_coord, NULL);
+          new_event->motion.history = g_array_new (FALSE, TRUE, sizeof (GdkTimeCoord));
+          g_array_append_vals (new_event->motion.history,
+                               event->motion.history->data,
+                               event->motion.history->len);
         }
       break;
 
@@ -755,7 +1080,8 @@ gdk_event_finalize (GObject *object)
     case GDK_MOTION_NOTIFY:
       g_clear_object (&event->motion.tool);
       g_free (event->motion.axes);
-      g_list_free_full (event->motion.history, g_free);
+      if (event->motion.history)
+        g_array_unref (event->motion.history);
       break;
 
     default:
@@ -2530,7 +2856,21 @@ gdk_event_get_axes (GdkEvent  *event,
 GList *
 gdk_event_get_motion_history (const GdkEvent *event)
 {
+  GList *result = NULL;
+  GArray *history;
+  guint i;
+
   if (event->any.type != GDK_MOTION_NOTIFY)
     return NULL;
-  return g_list_reverse (g_list_copy (event->motion.history));
+
+  history = event->motion.history;
+  if (history == NULL)
+    return NULL;
+
+  /* Oldest entry first, the entries stay owned by the event */
+  for (i = history->len; i > 0; i--)
+    result = g_list_prepend (result,
+                             &g_array_index (history, GdkTimeCoord, i - 1));
+
+  return result;
 }
@@ -118,7 +118,7 @@ struct _GdkEventMotion
   guint state;
   GdkDeviceTool *tool;
   gdouble x_root, y_root;
-  GList *history;
+  GArray *history; /* <GdkTimeCoord> */
 };
 
 /*
@@ -27,6 +27,10 @@
 #include "gdkframeclockprivate.h"
 #include "gdkinternals.h"
 
+#ifdef G_OS_UNIX
+#include <signal.h>
+#endif
+
 /**
  * SECTION:gdkframeclock
  * @Short_description: Frame clock syncs painting to a window or display
@@ -82,6 +86,7 @@ enum {
   PAINT,
   AFTER_PAINT,
   RESUME_EVENTS,
+  TIMINGS_COMPLETE,
   LAST_SIGNAL
 };
 
@@ -92,11 +97,97 @@ static guint signals[LAST_SIGNAL];
 struct _GdkFrameClockPrivate
 {
   gint64 frame_counter;
+  gint64 reported;
   gint n_timings;
   gint current;
   GdkFrameTimings *timings[FRAME_HISTORY_MAX_LENGTH];
 };
 
+/* Process-wide histogram of completed frame timings, so that jank can
+ * be monitored in production builds without G_ENABLE_DEBUG. Collection
+ * is enabled by setting GDK_FRAME_HISTOGRAM in the environment; the
+ * accumulated counts are dumped to stderr when the process receives
+ * SIGUSR2.
+ */
+#define FRAME_HISTOGRAM_N_BUCKETS 64  /* one bucket per millisecond */
+
+static gboolean frame_histogram_enabled;
+static guint64 frame_histogram_frames;
+static guint64 frame_histogram_missed;
+static guint frame_histogram_paint[FRAME_HISTOGRAM_N_BUCKETS + 1];
+static guint frame_histogram_latency[FRAME_HISTOGRAM_N_BUCKETS + 1];
+
+#ifdef G_OS_UNIX
+static volatile sig_atomic_t frame_histogram_dump_requested;
+
+static void
+frame_histogram_sigusr2 (int signum)
+{
+  frame_histogram_dump_requested = 1;
+}
+#endif
+
+static void
+frame_histogram_add_time (guint  *buckets,
+                          gint64  usecs)
+{
+  buckets[MIN (usecs / 1000, FRAME_HISTOGRAM_N_BUCKETS)]++;
+}
+
+static void
+frame_histogram_print (const char *description,
+                       guint      *buckets)
+{
+  int i;
+
+  g_printerr ("%s (ms: frames)\n", description);
+  for (i = 0; i <= FRAME_HISTOGRAM_N_BUCKETS; i++)
+    {
+      if (buckets[i] == 0)
+        continue;
+
+      if (i < FRAME_HISTOGRAM_N_BUCKETS)
+        g_printerr ("  %3d: %u\n", i, buckets[i]);
+      else
+        g_printerr ("  >%2d: %u\n", FRAME_HISTOGRAM_N_BUCKETS, buckets[i]);
+    }
+}
+
+static void
+frame_histogram_dump (void)
+{
+  g_printerr ("Frame timings for %" G_GUINT64_FORMAT " frames, "
+              "%" G_GUINT64_FORMAT " missed deadlines\n",
+              frame_histogram_frames, frame_histogram_missed);
+  frame_histogram_print ("Paint duration", frame_histogram_paint);
+  frame_histogram_print ("Present latency", frame_histogram_latency);
+}
+
+static void
+frame_histogram_add (GdkFrameClock   *clock,
+                     GdkFrameTimings *timings)
+{
+  GdkFrameTimings *previous;
+
+  frame_histogram_frames++;
+
+  if (timings->frame_end_time != 0)
+    frame_histogram_add_time (frame_histogram_paint,
+                              timings->frame_end_time - timings->frame_time);
+
+  if (timings->presentation_time != 0)
+    frame_histogram_add_time (frame_histogram_latency,
+                              timings->presentation_time - timings->frame_time);
+
+  previous = gdk_frame_clock_get_timings (clock, timings->frame_counter - 1);
+  if (previous != NULL &&
+      timings->presentation_time != 0 &&
+      previous->presentation_time != 0 &&
+      timings->refresh_interval != 0 &&
+      timings->presentation_time - previous->presentation_time > timings->refresh_interval * 3 / 2)
+    frame_histogram_missed++;
+}
+
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GdkFrameClock, gdk_frame_clock, G_TYPE_OBJECT)
 
 static void
@@ -241,6 +332,40 @@ gdk_frame_clock_class_init (GdkFrameClockClass *klass)
                   NULL, NULL,
                   g_cclosure_marshal_VOID__VOID,
                   G_TYPE_NONE, 0);
+
+  /**
+   * GdkFrameClock::timings-complete:
+   * @clock: the frame clock emitting the signal
+   * @timings: the completed #GdkFrameTimings
+   *
+   * This signal is emitted once per frame, as soon as the backend
+   * has filled in all the timing information that will become
+   * available for the frame, i.e. once
+   * gdk_frame_timings_get_complete() returns %TRUE for @timings.
+   * It can be used to continuously monitor frame timings without
+   * polling the frame history.
+   *
+   * Frames are reported in frame counter order. A frame whose
+   * timing information never completes is skipped silently once
+   * it falls out of the history.
+   */
+  signals[TIMINGS_COMPLETE] =
+    g_signal_new (g_intern_static_string ("timings-complete"),
+                  GDK_TYPE_FRAME_CLOCK,
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  g_cclosure_marshal_VOID__BOXED,
+                  G_TYPE_NONE, 1,
+                  gdk_frame_timings_get_type () | G_SIGNAL_TYPE_STATIC_SCOPE);
+
+  if (g_getenv ("GDK_FRAME_HISTOGRAM") != NULL)
+    {
+      frame_histogram_enabled = TRUE;
+#ifdef G_OS_UNIX
+      signal (SIGUSR2, frame_histogram_sigusr2);
+#endif
+    }
 }
 
 static void
@@ -411,6 +536,11 @@ _gdk_frame_clock_begin_frame (GdkFrameClock *frame_clock)
 
   priv = frame_clock->priv;
 
+  /* Catch frames whose timings completed since the last paint cycle
+   * before their history slots can be reused
+   */
+  _gdk_frame_clock_report_completed (frame_clock);
+
   priv->frame_counter++;
   priv->current = (priv->current + 1) % FRAME_HISTORY_MAX_LENGTH;
 
@@ -430,6 +560,50 @@ _gdk_frame_clock_begin_frame (GdkFrameClock *frame_clock)
   priv->timings[priv->current] = _gdk_frame_timings_new (priv->frame_counter);
 }
 
+/* Report newly completed frames to ::timings-complete subscribers and
+ * the frame histogram. Called after each paint cycle and at the start
+ * of the next frame, so that timing information that a backend fills
+ * in asynchronously (e.g. presentation feedback) is picked up too.
+ */
+void
+_gdk_frame_clock_report_completed (GdkFrameClock *frame_clock)
+{
+  GdkFrameClockPrivate *priv;
+  gint64 frame_counter;
+
+  g_return_if_fail (GDK_IS_FRAME_CLOCK (frame_clock));
+
+  priv = frame_clock->priv;
+
+#ifdef G_OS_UNIX
+  if (frame_histogram_dump_requested)
+    {
+      frame_histogram_dump_requested = 0;
+      frame_histogram_dump ();
+    }
+#endif
+
+  for (frame_counter = MAX (priv->reported, gdk_frame_clock_get_history_start (frame_clock));
+       frame_counter <= priv->frame_counter;
+       frame_counter++)
+    {
+      GdkFrameTimings *timings = gdk_frame_clock_get_timings (frame_clock, frame_counter);
+
+      if (timings == NULL)
+        continue;
+
+      if (!timings->complete)
+        break;
+
+      if (frame_histogram_enabled)
+        frame_histogram_add (frame_clock, timings);
+
+      g_signal_emit (frame_clock, signals[TIMINGS_COMPLETE], 0, timings);
+    }
+
+  priv->reported = frame_counter;
+}
+
 /**
  * gdk_frame_clock_get_timings:
  * @frame_clock: a #GdkFrameClock
@@ -41,7 +41,12 @@ struct _GdkFrameClockIdlePrivate
   /* timer_base is used to avoid ever going backward */
   gint64 timer_base;
   gint64 frame_time;
+  /* how often to tick when the backend provides no frame timings;
+   * follows the refresh rate of the monitor the window is on
+   */
+  gint64 frame_interval;
   gint64 min_next_frame_time;
+  gint64 last_flush_time;
   gint64 sleep_serial;
 
   guint flush_idle_id;
@@ -124,6 +129,7 @@ gdk_frame_clock_idle_init (GdkFrameClockIdle *frame_clock_idle)
     gdk_frame_clock_idle_get_instance_private (frame_clock_idle);
 
   priv->frame_time = g_get_monotonic_time (); /* more sane than zero */
+  priv->frame_interval = FRAME_INTERVAL;
   priv->freeze_count = 0;
 }
 
@@ -194,12 +200,12 @@ gdk_frame_clock_idle_get_frame_time (GdkFrameClock *clock)
   /* Outside a paint, pick something close to "now" */
   computed_frame_time = compute_frame_time (GDK_FRAME_CLOCK_IDLE (clock));
 
-  /* 16ms is 60fps. We only update frame time that often because we'd
+  /* We only update frame time once per frame interval because we'd
    * like to try to keep animations on the same start times.
    * get_frame_time() would normally be used outside of a paint to
    * record an animation start time for example.
    */
-  if ((computed_frame_time - priv->frame_time) > FRAME_INTERVAL)
+  if ((computed_frame_time - priv->frame_time) > priv->frame_interval)
     priv->frame_time = computed_frame_time;
 
   return priv->frame_time;
@@ -237,8 +243,25 @@ maybe_start_idle (GdkFrameClockIdle *clock_idle)
 
       if (priv->flush_idle_id == 0 && RUN_FLUSH_IDLE (priv))
         {
+          guint flush_interval = min_interval;
+
+          /* Pace event flushing at the frame rate even when no paint is
+           * pending, so that fast pointer motion gets compressed into one
+           * event per paint cycle instead of being dispatched at input
+           * device rate.
+           */
+          if (priv->last_flush_time != 0)
+            {
+              gint64 now = compute_frame_time (clock_idle);
+              gint64 next_flush_time = priv->last_flush_time + priv->frame_interval;
+
+              if (next_flush_time > now)
+                flush_interval = MAX (flush_interval,
+                                      (guint) ((next_flush_time - now + 500) / 1000));
+            }
+
           priv->flush_idle_id = g_timeout_add_full (GDK_PRIORITY_EVENTS + 1,
-                                                    min_interval,
+                                                    flush_interval,
                                                     gdk_frame_clock_flush_idle,
                                                     g_object_ref (clock_idle),
                                                     (GDestroyNotify) g_object_unref);
@@ -280,6 +303,7 @@ static gint64
 compute_min_next_frame_time (GdkFrameClockIdle *clock_idle,
                              gint64             last_frame_time)
 {
+  GdkFrameClockIdlePrivate *priv = clock_idle->priv;
   gint64 presentation_time;
   gint64 refresh_interval;
 
@@ -287,8 +311,11 @@ compute_min_next_frame_time (GdkFrameClockIdle *clock_idle,
                                     last_frame_time,
                                     &refresh_interval, &presentation_time);
 
+  /* Without presentation feedback we are self-driven, so tick at the
+   * rate of the monitor rather than the 60Hz default.
+   */
   if (presentation_time == 0)
-    return last_frame_time + refresh_interval;
+    return last_frame_time + priv->frame_interval;
   else
     return presentation_time + refresh_interval / 2;
 }
@@ -307,6 +334,7 @@ gdk_frame_clock_flush_idle (void *data)
 
   priv->phase = GDK_FRAME_CLOCK_PHASE_FLUSH_EVENTS;
   priv->requested &= ~GDK_FRAME_CLOCK_PHASE_FLUSH_EVENTS;
+  priv->last_flush_time = compute_frame_time (clock_idle);
 
   _gdk_frame_clock_emit_flush_events (clock);
 
@@ -351,7 +379,7 @@ gdk_frame_clock_paint_idle (void *data)
         case GDK_FRAME_CLOCK_PHASE_BEFORE_PAINT:
           if (priv->freeze_count == 0)
             {
-              gint64 frame_interval = FRAME_INTERVAL;
+              gint64 frame_interval = priv->frame_interval;
               gint64 reset_frame_time;
               gint64 smoothest_frame_time;
               gint64 frame_time_error;
@@ -414,14 +442,10 @@ gdk_frame_clock_paint_idle (void *data)
           if (priv->freeze_count == 0)
             {
 	      int iter;
-#ifdef G_ENABLE_DEBUG
-              if (GDK_DEBUG_CHECK (FRAMES))
-                {
-                  if (priv->phase != GDK_FRAME_CLOCK_PHASE_LAYOUT &&
-                      (priv->requested & GDK_FRAME_CLOCK_PHASE_LAYOUT))
-                    timings->layout_start_time = g_get_monotonic_time ();
-                }
-#endif /* G_ENABLE_DEBUG */
+
+              if (priv->phase != GDK_FRAME_CLOCK_PHASE_LAYOUT &&
+                  (priv->requested & GDK_FRAME_CLOCK_PHASE_LAYOUT))
+                timings->layout_start_time = g_get_monotonic_time ();
 
               priv->phase = GDK_FRAME_CLOCK_PHASE_LAYOUT;
 	      /* We loop in the layout phase, because we don't want to progress
@@ -443,14 +467,9 @@ gdk_frame_clock_paint_idle (void *data)
         case GDK_FRAME_CLOCK_PHASE_PAINT:
           if (priv->freeze_count == 0)
             {
-#ifdef G_ENABLE_DEBUG
-              if (GDK_DEBUG_CHECK (FRAMES))
-                {
-                  if (priv->phase != GDK_FRAME_CLOCK_PHASE_PAINT &&
-                      (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT))
-                    timings->paint_start_time = g_get_monotonic_time ();
-                }
-#endif /* G_ENABLE_DEBUG */
+              if (priv->phase != GDK_FRAME_CLOCK_PHASE_PAINT &&
+                  (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT))
+                timings->paint_start_time = g_get_monotonic_time ();
 
               priv->phase = GDK_FRAME_CLOCK_PHASE_PAINT;
               if (priv->requested & GDK_FRAME_CLOCK_PHASE_PAINT)
@@ -469,10 +488,7 @@ gdk_frame_clock_paint_idle (void *data)
                */
               priv->phase = GDK_FRAME_CLOCK_PHASE_NONE;
 
-#ifdef G_ENABLE_DEBUG
-              if (GDK_DEBUG_CHECK (FRAMES))
-                timings->frame_end_time = g_get_monotonic_time ();
-#endif /* G_ENABLE_DEBUG */
+              timings->frame_end_time = g_get_monotonic_time ();
             }
           /* fallthrough */
         case GDK_FRAME_CLOCK_PHASE_RESUME_EVENTS:
@@ -489,6 +505,9 @@ gdk_frame_clock_paint_idle (void *data)
     }
 #endif /* G_ENABLE_DEBUG */
 
+  if (timings)
+    _gdk_frame_clock_report_completed (clock);
+
   if (priv->requested & GDK_FRAME_CLOCK_PHASE_RESUME_EVENTS)
     {
       priv->requested &= ~GDK_FRAME_CLOCK_PHASE_RESUME_EVENTS;
@@ -625,3 +644,20 @@ _gdk_frame_clock_idle_new (void)
 
   return GDK_FRAME_CLOCK (clock);
 }
+
+/* Sets the interval the clock ticks at when it has to drive itself,
+ * i.e. when the backend provides no presentation feedback. Windows
+ * call this with the refresh interval of the monitor they are on, so
+ * a window on a 144Hz monitor is not limited to the 60Hz default.
+ */
+void
+_gdk_frame_clock_idle_set_frame_interval (GdkFrameClockIdle *clock_idle,
+                                          gint64             frame_interval)
+{
+  GdkFrameClockIdlePrivate *priv = clock_idle->priv;
+
+  if (frame_interval <= 0)
+    frame_interval = FRAME_INTERVAL;
+
+  priv->frame_interval = frame_interval;
+}
@@ -59,6 +59,8 @@ struct _GdkFrameClockIdleClass
 GType           gdk_frame_clock_idle_get_type       (void) G_GNUC_CONST;
 
 GdkFrameClock *_gdk_frame_clock_idle_new            (void);
+void           _gdk_frame_clock_idle_set_frame_interval (GdkFrameClockIdle *clock_idle,
+                                                         gint64             frame_interval);
 void           _gdk_frame_clock_idle_freeze_updates (GdkFrameClockIdle *clock_idle);
 void           _gdk_frame_clock_idle_thaw_updates   (GdkFrameClockIdle *clock_idle);
 
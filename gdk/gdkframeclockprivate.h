@@ -94,11 +94,9 @@ struct _GdkFrameTimings
   gint64 refresh_interval;
   gint64 predicted_presentation_time;
 
-#ifdef G_ENABLE_DEBUG
   gint64 layout_start_time;
   gint64 paint_start_time;
   gint64 frame_end_time;
-#endif /* G_ENABLE_DEBUG */
 
   guint complete : 1;
   guint slept_before : 1;
@@ -108,6 +106,7 @@ void _gdk_frame_clock_freeze (GdkFrameClock *clock);
 void _gdk_frame_clock_thaw   (GdkFrameClock *clock);
 
 void _gdk_frame_clock_begin_frame         (GdkFrameClock   *clock);
+void _gdk_frame_clock_report_completed    (GdkFrameClock   *clock);
 void _gdk_frame_clock_debug_print_timings (GdkFrameClock   *clock,
                                            GdkFrameTimings *timings);
 
@@ -252,6 +252,31 @@ gdk_gl_context_upload_texture (GdkGLContext    *context,
     }
 }
 
+/*< private >
+ * gdk_gl_context_import_dmabuf_texture:
+ * @context: a #GdkGLContext
+ * @texture: a #GdkDmabufTexture
+ *
+ * Imports the dmabuf wrapped by @texture into a GL texture, without
+ * copying the pixel data. The caller owns the returned texture id
+ * and must delete it with glDeleteTextures() when done.
+ *
+ * Returns: the GL texture id, or 0 when the backend cannot import
+ *     dmabufs or the buffer's format is not supported
+ */
+guint
+gdk_gl_context_import_dmabuf_texture (GdkGLContext     *context,
+                                      GdkDmabufTexture *texture)
+{
+  g_return_val_if_fail (GDK_IS_GL_CONTEXT (context), 0);
+  g_return_val_if_fail (GDK_IS_DMABUF_TEXTURE (texture), 0);
+
+  if (GDK_GL_CONTEXT_GET_CLASS (context)->import_dmabuf == NULL)
+    return 0;
+
+  return GDK_GL_CONTEXT_GET_CLASS (context)->import_dmabuf (context, texture);
+}
+
 static gboolean
 gdk_gl_context_real_realize (GdkGLContext  *self,
                              GError       **error)
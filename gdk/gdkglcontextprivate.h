@@ -23,6 +23,7 @@
 
 #include "gdkglcontext.h"
 #include "gdkdrawcontextprivate.h"
+#include "gdktextureprivate.h"
 
 G_BEGIN_DECLS
 
@@ -49,6 +50,9 @@ struct _GdkGLContextClass
   gboolean (* texture_from_surface) (GdkGLContext    *context,
                                      cairo_surface_t *surface,
                                      cairo_region_t  *region);
+
+  guint (* import_dmabuf) (GdkGLContext     *context,
+                           GdkDmabufTexture *texture);
 };
 
 typedef struct {
@@ -82,6 +86,8 @@ void                    gdk_gl_context_upload_texture           (GdkGLContext
                                                                  int              height,
                                                                  int              stride,
                                                                  guint            texture_target);
+guint                   gdk_gl_context_import_dmabuf_texture    (GdkGLContext     *context,
+                                                                 GdkDmabufTexture *texture);
 GdkGLContextPaintData * gdk_gl_context_get_paint_data           (GdkGLContext    *context);
 gboolean                gdk_gl_context_use_texture_rectangle    (GdkGLContext    *context);
 gboolean                gdk_gl_context_has_framebuffer_blit     (GdkGLContext    *context);
@@ -210,6 +210,7 @@ struct _GdkWindow
   guint in_update : 1;
   guint geometry_dirty : 1;
   guint frame_clock_events_paused : 1;
+  guint overlay_hint : 1;
 
   /* The GdkWindow that has the impl, ref:ed if another window.
    * This ref is required to keep the wrapper of the impl window alive
@@ -244,6 +245,23 @@ struct _GdkWindow
   GdkDrawingContext *drawing_context;
 
   cairo_region_t *opaque_region;
+
+  /* Invalidations are rounded outward to multiples of this; 1 means
+   * pixel-exact. See gdk_window_set_invalidate_granularity().
+   */
+  int invalidate_granularity;
+
+  /* Hit-test pruning grid over the children, built lazily for windows
+   * with many children; see gdk_window_pick_index_build(). A serial
+   * mismatch marks the grid as stale.
+   */
+  struct {
+    GPtrArray **cells;          /* n_cols * n_rows lists in stacking order */
+    int n_cols, n_rows;
+    int cell_width, cell_height;
+    guint serial;               /* bumped on child list/geometry changes */
+    guint built_serial;         /* value of serial the cells were built at */
+  } pick_index;
 };
 
 #define GDK_WINDOW_TYPE(d) ((((GdkWindow *)(d)))->window_type)
@@ -41,6 +41,11 @@
 
 #include <epoxy/gl.h>
 
+#ifdef G_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /**
  * SECTION:gdktexture
  * @Short_description: Image data for display
@@ -101,6 +106,37 @@ gdk_texture_real_download_surface (GdkTexture *texture)
   return surface;
 }
 
+static void
+gdk_texture_real_download_async (GdkTexture          *self,
+                                 GCancellable        *cancellable,
+                                 GAsyncReadyCallback  callback,
+                                 gpointer             user_data)
+{
+  GTask *task;
+  guchar *data;
+  gsize stride;
+
+  task = g_task_new (self, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gdk_texture_real_download_async);
+
+  stride = self->width * 4;
+  data = g_malloc (stride * self->height);
+  gdk_texture_download (self, data, stride);
+
+  g_task_return_pointer (task,
+                         g_bytes_new_take (data, stride * self->height),
+                         (GDestroyNotify) g_bytes_unref);
+  g_object_unref (task);
+}
+
+static GBytes *
+gdk_texture_real_download_finish (GdkTexture    *self,
+                                  GAsyncResult  *result,
+                                  GError       **error)
+{
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
 static void
 gdk_texture_set_property (GObject      *gobject,
                           guint         prop_id,
@@ -166,6 +202,8 @@ gdk_texture_class_init (GdkTextureClass *klass)
 
   klass->download = gdk_texture_real_download;
   klass->download_surface = gdk_texture_real_download_surface;
+  klass->download_async = gdk_texture_real_download_async;
+  klass->download_finish = gdk_texture_real_download_finish;
 
   gobject_class->set_property = gdk_texture_set_property;
   gobject_class->get_property = gdk_texture_get_property;
@@ -509,6 +547,161 @@ gdk_gl_texture_download (GdkTexture *texture,
   cairo_surface_destroy (surface);
 }
 
+/* Async download via a pixel buffer object: glReadPixels() into the PBO
+ * returns immediately, a fence sync tells us when the GPU is done and we
+ * can map the buffer without blocking.
+ */
+typedef struct {
+  GdkGLContext *context;
+  guint pbo_id;
+  guint fbo_id;
+  GLsync sync;
+} GdkGLTextureDownload;
+
+static void
+gdk_gl_texture_download_free (gpointer data)
+{
+  GdkGLTextureDownload *download = data;
+
+  gdk_gl_context_make_current (download->context);
+
+  if (download->sync)
+    glDeleteSync (download->sync);
+  glDeleteBuffers (1, &download->pbo_id);
+  glDeleteFramebuffers (1, &download->fbo_id);
+
+  g_object_unref (download->context);
+
+  g_slice_free (GdkGLTextureDownload, download);
+}
+
+static gboolean
+gdk_gl_texture_download_poll (gpointer data)
+{
+  GTask *task = data;
+  GdkTexture *texture = g_task_get_source_object (task);
+  GdkGLTextureDownload *download = g_task_get_task_data (task);
+  gsize stride, size;
+  const guchar *mapped;
+  guchar *pixels;
+  int y;
+
+  if (g_task_return_error_if_cancelled (task))
+    {
+      g_object_unref (task);
+      return G_SOURCE_REMOVE;
+    }
+
+  gdk_gl_context_make_current (download->context);
+
+  switch (glClientWaitSync (download->sync, 0, 0))
+    {
+    case GL_TIMEOUT_EXPIRED:
+      return G_SOURCE_CONTINUE;
+
+    case GL_ALREADY_SIGNALED:
+    case GL_CONDITION_SATISFIED:
+      break;
+
+    case GL_WAIT_FAILED:
+    default:
+      g_task_return_new_error (task,
+                               G_IO_ERROR, G_IO_ERROR_FAILED,
+                               "Failed to wait for the GPU to finish the download");
+      g_object_unref (task);
+      return G_SOURCE_REMOVE;
+    }
+
+  stride = texture->width * 4;
+  size = stride * texture->height;
+
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, download->pbo_id);
+  mapped = glMapBufferRange (GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+  if (mapped == NULL)
+    {
+      glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+      g_task_return_new_error (task,
+                               G_IO_ERROR, G_IO_ERROR_FAILED,
+                               "Failed to map the downloaded pixel data");
+      g_object_unref (task);
+      return G_SOURCE_REMOVE;
+    }
+
+  /* GL puts the bottom row first, so flip while copying out */
+  pixels = g_malloc (size);
+  for (y = 0; y < texture->height; y++)
+    memcpy (pixels + y * stride,
+            mapped + (texture->height - 1 - y) * stride,
+            stride);
+
+  glUnmapBuffer (GL_PIXEL_PACK_BUFFER);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+
+  g_task_return_pointer (task,
+                         g_bytes_new_take (pixels, size),
+                         (GDestroyNotify) g_bytes_unref);
+  g_object_unref (task);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gdk_gl_texture_download_async (GdkTexture          *texture,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+  GdkGLTexture *self = GDK_GL_TEXTURE (texture);
+  GdkGLTextureDownload *download;
+  GTask *task;
+
+  /* The fast path needs fence syncs and the BGRA pack format; fall back
+   * to the synchronous download when the texture contents were already
+   * saved to the CPU or on OpenGL ES.
+   */
+  if (self->saved != NULL ||
+      gdk_gl_context_get_use_es (self->context))
+    {
+      GDK_TEXTURE_CLASS (gdk_gl_texture_parent_class)->download_async (texture, cancellable, callback, user_data);
+      return;
+    }
+
+  gdk_gl_context_make_current (self->context);
+
+  if (epoxy_gl_version () < 32 && !epoxy_has_gl_extension ("GL_ARB_sync"))
+    {
+      GDK_TEXTURE_CLASS (gdk_gl_texture_parent_class)->download_async (texture, cancellable, callback, user_data);
+      return;
+    }
+
+  task = g_task_new (texture, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gdk_gl_texture_download_async);
+
+  download = g_slice_new0 (GdkGLTextureDownload);
+  download->context = g_object_ref (self->context);
+  g_task_set_task_data (task, download, gdk_gl_texture_download_free);
+
+  glGenFramebuffers (1, &download->fbo_id);
+  glBindFramebuffer (GL_FRAMEBUFFER, download->fbo_id);
+  glFramebufferTexture2D (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, self->id, 0);
+
+  glGenBuffers (1, &download->pbo_id);
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, download->pbo_id);
+  glBufferData (GL_PIXEL_PACK_BUFFER, texture->width * texture->height * 4, NULL, GL_STREAM_READ);
+
+  glPixelStorei (GL_PACK_ALIGNMENT, 4);
+  glReadPixels (0, 0, texture->width, texture->height,
+                GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, NULL);
+
+  glBindBuffer (GL_PIXEL_PACK_BUFFER, 0);
+  glBindFramebuffer (GL_FRAMEBUFFER, 0);
+
+  download->sync = glFenceSync (GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  /* make sure the fence actually reaches the GPU */
+  glFlush ();
+
+  g_timeout_add (1, gdk_gl_texture_download_poll, task);
+}
+
 static void
 gdk_gl_texture_class_init (GdkGLTextureClass *klass)
 {
@@ -516,6 +709,7 @@ gdk_gl_texture_class_init (GdkGLTextureClass *klass)
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
 
   texture_class->download = gdk_gl_texture_download;
+  texture_class->download_async = gdk_gl_texture_download_async;
   gobject_class->dispose = gdk_gl_texture_dispose;
 }
 
@@ -536,6 +730,311 @@ gdk_gl_texture_get_id (GdkGLTexture *self)
   return self->id;
 }
 
+/* GdkDmabufTexture */
+
+#define GDK_DMABUF_FOURCC(a,b,c,d) ((guint32)(a) | \
+                                    ((guint32)(b) << 8) | \
+                                    ((guint32)(c) << 16) | \
+                                    ((guint32)(d) << 24))
+
+/* The linear formats the CPU fallback understands; they match
+ * cairo's ARGB32 memory layout on little-endian
+ */
+#define GDK_DMABUF_FORMAT_ARGB8888 GDK_DMABUF_FOURCC ('A', 'R', '2', '4')
+#define GDK_DMABUF_FORMAT_XRGB8888 GDK_DMABUF_FOURCC ('X', 'R', '2', '4')
+
+struct _GdkDmabufTexture {
+  GdkTexture parent_instance;
+
+  int fd;
+  guint32 fourcc;
+  guint stride;
+  guint offset;
+  guint64 modifier;
+
+  GDestroyNotify destroy;
+  gpointer data;
+};
+
+struct _GdkDmabufTextureClass {
+  GdkTextureClass parent_class;
+};
+
+G_DEFINE_TYPE (GdkDmabufTexture, gdk_dmabuf_texture, GDK_TYPE_TEXTURE)
+
+static void
+gdk_dmabuf_texture_dispose (GObject *object)
+{
+  GdkDmabufTexture *self = GDK_DMABUF_TEXTURE (object);
+
+  if (self->destroy)
+    {
+      self->destroy (self->data);
+      self->destroy = NULL;
+      self->data = NULL;
+    }
+
+  if (self->fd >= 0)
+    {
+#ifdef G_OS_UNIX
+      close (self->fd);
+#endif
+      self->fd = -1;
+    }
+
+  G_OBJECT_CLASS (gdk_dmabuf_texture_parent_class)->dispose (object);
+}
+
+static void
+gdk_dmabuf_texture_download (GdkTexture *texture,
+                             guchar     *data,
+                             gsize       stride)
+{
+  GdkDmabufTexture *self = GDK_DMABUF_TEXTURE (texture);
+  int y;
+
+#ifdef G_OS_UNIX
+  if ((self->fourcc == GDK_DMABUF_FORMAT_ARGB8888 ||
+       self->fourcc == GDK_DMABUF_FORMAT_XRGB8888) &&
+      (self->modifier == GDK_DMABUF_MODIFIER_LINEAR ||
+       self->modifier == GDK_DMABUF_MODIFIER_INVALID))
+    {
+      gsize map_len = self->offset + (gsize) texture->height * self->stride;
+      guchar *map = mmap (NULL, map_len, PROT_READ, MAP_SHARED, self->fd, 0);
+
+      if (map != MAP_FAILED)
+        {
+          for (y = 0; y < texture->height; y++)
+            memcpy (data + y * stride,
+                    map + self->offset + (gsize) y * self->stride,
+                    texture->width * 4);
+
+          if (self->fourcc == GDK_DMABUF_FORMAT_XRGB8888)
+            {
+              int x;
+
+              for (y = 0; y < texture->height; y++)
+                for (x = 0; x < texture->width; x++)
+                  data[y * stride + 4 * x + 3] = 0xff;
+            }
+
+          munmap (map, map_len);
+          return;
+        }
+    }
+#endif
+
+  g_warning ("Cannot read back dmabuf (format %c%c%c%c, modifier 0x%016" G_GINT64_MODIFIER "x) with the CPU",
+             self->fourcc & 0xff,
+             (self->fourcc >> 8) & 0xff,
+             (self->fourcc >> 16) & 0xff,
+             (self->fourcc >> 24) & 0xff,
+             self->modifier);
+
+  for (y = 0; y < texture->height; y++)
+    memset (data + y * stride, 0, texture->width * 4);
+}
+
+static void
+gdk_dmabuf_texture_class_init (GdkDmabufTextureClass *klass)
+{
+  GdkTextureClass *texture_class = GDK_TEXTURE_CLASS (klass);
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  texture_class->download = gdk_dmabuf_texture_download;
+  gobject_class->dispose = gdk_dmabuf_texture_dispose;
+}
+
+static void
+gdk_dmabuf_texture_init (GdkDmabufTexture *self)
+{
+  self->fd = -1;
+}
+
+int
+gdk_dmabuf_texture_get_fd (GdkDmabufTexture *self)
+{
+  return self->fd;
+}
+
+guint32
+gdk_dmabuf_texture_get_fourcc (GdkDmabufTexture *self)
+{
+  return self->fourcc;
+}
+
+guint
+gdk_dmabuf_texture_get_stride (GdkDmabufTexture *self)
+{
+  return self->stride;
+}
+
+guint
+gdk_dmabuf_texture_get_offset (GdkDmabufTexture *self)
+{
+  return self->offset;
+}
+
+guint64
+gdk_dmabuf_texture_get_modifier (GdkDmabufTexture *self)
+{
+  return self->modifier;
+}
+
+/* GdkMemoryTexture */
+
+/* How many per-update dirty regions we keep around so that renderers
+ * which skipped a few frames can still do an incremental upload
+ */
+#define GDK_MEMORY_TEXTURE_MAX_DIFFS 16
+
+typedef struct _MemoryTextureDiff MemoryTextureDiff;
+
+struct _MemoryTextureDiff {
+  gsize serial;
+  cairo_region_t *region;
+};
+
+struct _GdkMemoryTexture {
+  GdkTexture parent_instance;
+
+  GBytes *bytes;
+  gsize stride;
+
+  gsize serial;
+  GQueue diffs;
+};
+
+struct _GdkMemoryTextureClass {
+  GdkTextureClass parent_class;
+};
+
+G_DEFINE_TYPE (GdkMemoryTexture, gdk_memory_texture, GDK_TYPE_TEXTURE)
+
+static void
+memory_texture_diff_free (MemoryTextureDiff *diff)
+{
+  cairo_region_destroy (diff->region);
+  g_slice_free (MemoryTextureDiff, diff);
+}
+
+static void
+gdk_memory_texture_finalize (GObject *object)
+{
+  GdkMemoryTexture *self = GDK_MEMORY_TEXTURE (object);
+
+  g_bytes_unref (self->bytes);
+  g_queue_foreach (&self->diffs, (GFunc) memory_texture_diff_free, NULL);
+  g_queue_clear (&self->diffs);
+
+  G_OBJECT_CLASS (gdk_memory_texture_parent_class)->finalize (object);
+}
+
+static void
+gdk_memory_texture_download (GdkTexture *texture,
+                             guchar     *data,
+                             gsize       stride)
+{
+  GdkMemoryTexture *self = GDK_MEMORY_TEXTURE (texture);
+  const guchar *src = g_bytes_get_data (self->bytes, NULL);
+  int y;
+
+  for (y = 0; y < texture->height; y++)
+    memcpy (data + y * stride, src + y * self->stride, texture->width * 4);
+}
+
+static cairo_surface_t *
+gdk_memory_texture_download_surface (GdkTexture *texture)
+{
+  GdkMemoryTexture *self = GDK_MEMORY_TEXTURE (texture);
+  static cairo_user_data_key_t bytes_key;
+  cairo_surface_t *surface;
+
+  /* The bytes are immutable (updates swap in a new GBytes), so the
+   * surface can point into them as long as it holds a reference.
+   */
+  surface = cairo_image_surface_create_for_data ((guchar *) g_bytes_get_data (self->bytes, NULL),
+                                                 CAIRO_FORMAT_ARGB32,
+                                                 texture->width, texture->height,
+                                                 self->stride);
+  cairo_surface_set_user_data (surface, &bytes_key,
+                               g_bytes_ref (self->bytes),
+                               (cairo_destroy_func_t) g_bytes_unref);
+
+  return surface;
+}
+
+static void
+gdk_memory_texture_class_init (GdkMemoryTextureClass *klass)
+{
+  GdkTextureClass *texture_class = GDK_TEXTURE_CLASS (klass);
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  texture_class->download = gdk_memory_texture_download;
+  texture_class->download_surface = gdk_memory_texture_download_surface;
+
+  gobject_class->finalize = gdk_memory_texture_finalize;
+}
+
+static void
+gdk_memory_texture_init (GdkMemoryTexture *self)
+{
+  g_queue_init (&self->diffs);
+}
+
+GBytes *
+gdk_memory_texture_get_bytes (GdkMemoryTexture *self)
+{
+  return self->bytes;
+}
+
+gsize
+gdk_memory_texture_get_stride (GdkMemoryTexture *self)
+{
+  return self->stride;
+}
+
+gsize
+gdk_memory_texture_get_serial (GdkMemoryTexture *self)
+{
+  return self->serial;
+}
+
+/*< private >
+ * gdk_memory_texture_get_diff:
+ * @self: a #GdkMemoryTexture
+ * @since_serial: the serial the caller last uploaded
+ *
+ * Collects the region that changed between @since_serial and the
+ * current serial. Returns %NULL when the history does not reach back
+ * far enough, in which case the caller must treat the whole texture
+ * as changed.
+ *
+ * Returns: (nullable) (transfer full): the changed region
+ */
+cairo_region_t *
+gdk_memory_texture_get_diff (GdkMemoryTexture *self,
+                             gsize             since_serial)
+{
+  cairo_region_t *region;
+  GList *l;
+
+  if (self->diffs.head == NULL ||
+      ((MemoryTextureDiff *) self->diffs.head->data)->serial > since_serial + 1)
+    return NULL;
+
+  region = cairo_region_create ();
+  for (l = self->diffs.head; l; l = l->next)
+    {
+      MemoryTextureDiff *diff = l->data;
+
+      if (diff->serial > since_serial)
+        cairo_region_union (region, diff->region);
+    }
+
+  return region;
+}
+
 /**
  * gdk_texture_release_gl:
  * @texture: a #GdkTexture wrapping a GL texture
@@ -722,6 +1221,157 @@ gdk_texture_new_for_gl (GdkGLContext   *context,
   return GDK_TEXTURE (self);
 }
 
+/**
+ * gdk_texture_new_for_dmabuf:
+ * @fd: the dmabuf file descriptor
+ * @width: the width of the buffer, in pixels
+ * @height: the height of the buffer, in pixels
+ * @fourcc: the DRM format of the buffer, as a fourcc code
+ * @stride: the stride of the first plane, in bytes
+ * @offset: the offset of the first plane, in bytes
+ * @modifier: the DRM format modifier of the buffer, or
+ *     `DRM_FORMAT_MOD_INVALID` when it is not known
+ * @destroy: a destroy notify that will be called when the buffer
+ *     is no longer used
+ * @data: data that gets passed to @destroy
+ *
+ * Creates a new texture wrapping a dmabuf, for example a video frame
+ * from a camera or a decoder. The texture takes ownership of the file
+ * descriptor and closes it when the texture is released.
+ *
+ * Renderers that can import dmabufs sample the buffer directly, so
+ * the frame reaches the GPU without any copy. The buffer contents
+ * must not change while the texture is in use. Where import is not
+ * supported, GDK falls back to reading the buffer with the CPU,
+ * which is only possible for linear ARGB8888/XRGB8888 buffers.
+ *
+ * Return value: A newly-created #GdkTexture
+ **/
+GdkTexture *
+gdk_texture_new_for_dmabuf (int             fd,
+                            int             width,
+                            int             height,
+                            guint32         fourcc,
+                            guint           stride,
+                            guint           offset,
+                            guint64         modifier,
+                            GDestroyNotify  destroy,
+                            gpointer        data)
+{
+  GdkDmabufTexture *self;
+
+  g_return_val_if_fail (fd >= 0, NULL);
+  g_return_val_if_fail (width > 0, NULL);
+  g_return_val_if_fail (height > 0, NULL);
+  g_return_val_if_fail (fourcc != 0, NULL);
+  g_return_val_if_fail (stride > 0, NULL);
+
+  self = g_object_new (GDK_TYPE_DMABUF_TEXTURE,
+                       "width", width,
+                       "height", height,
+                       NULL);
+
+  self->fd = fd;
+  self->fourcc = fourcc;
+  self->stride = stride;
+  self->offset = offset;
+  self->modifier = modifier;
+  self->destroy = destroy;
+  self->data = data;
+
+  return GDK_TEXTURE (self);
+}
+
+/**
+ * gdk_texture_new_for_bytes:
+ * @bytes: the pixel data, in CAIRO_FORMAT_ARGB32 format
+ * @width: the number of pixels in each row
+ * @height: the number of rows
+ * @stride: the distance from the beginning of one row to the next, in bytes
+ *
+ * Creates a new texture object reading pixels out of @bytes.
+ *
+ * Unlike the textures returned by gdk_texture_new_for_data(), the
+ * result can be updated in place with gdk_texture_update(), which
+ * lets renderers re-upload only the pixels that actually changed.
+ * @bytes itself is never modified; it is kept alive as long as
+ * anything still reads from it.
+ *
+ * Returns: a new #GdkTexture
+ */
+GdkTexture *
+gdk_texture_new_for_bytes (GBytes *bytes,
+                           int     width,
+                           int     height,
+                           int     stride)
+{
+  GdkMemoryTexture *self;
+
+  g_return_val_if_fail (bytes != NULL, NULL);
+  g_return_val_if_fail (width > 0, NULL);
+  g_return_val_if_fail (height > 0, NULL);
+  g_return_val_if_fail (stride >= width * 4, NULL);
+  g_return_val_if_fail (g_bytes_get_size (bytes) >= (gsize) stride * height, NULL);
+
+  self = g_object_new (GDK_TYPE_MEMORY_TEXTURE,
+                       "width", width,
+                       "height", height,
+                       NULL);
+
+  self->bytes = g_bytes_ref (bytes);
+  self->stride = stride;
+
+  return GDK_TEXTURE (self);
+}
+
+/**
+ * gdk_texture_update:
+ * @texture: a #GdkTexture returned by gdk_texture_new_for_bytes()
+ * @bytes: the new pixel data, with the same size and stride as before
+ * @region: (nullable): the area that differs from the previous contents,
+ *     or %NULL for the whole texture
+ *
+ * Replaces the contents of a texture created with
+ * gdk_texture_new_for_bytes().
+ *
+ * Renderers use @region to upload only the changed pixels, so a small
+ * dirty rectangle on a large texture does not re-upload everything.
+ * Passing a @region that does not cover all changed pixels results in
+ * stale contents on screen.
+ */
+void
+gdk_texture_update (GdkTexture           *texture,
+                    GBytes               *bytes,
+                    const cairo_region_t *region)
+{
+  GdkMemoryTexture *self;
+  MemoryTextureDiff *diff;
+
+  g_return_if_fail (GDK_IS_MEMORY_TEXTURE (texture));
+  g_return_if_fail (bytes != NULL);
+
+  self = GDK_MEMORY_TEXTURE (texture);
+
+  g_return_if_fail (g_bytes_get_size (bytes) >= self->stride * texture->height);
+
+  g_bytes_unref (self->bytes);
+  self->bytes = g_bytes_ref (bytes);
+  self->serial++;
+
+  diff = g_slice_new (MemoryTextureDiff);
+  diff->serial = self->serial;
+  if (region)
+    diff->region = cairo_region_copy (region);
+  else
+    diff->region = cairo_region_create_rectangle (&(cairo_rectangle_int_t) {
+                       0, 0, texture->width, texture->height
+                   });
+  g_queue_push_tail (&self->diffs, diff);
+
+  while (self->diffs.length > GDK_MEMORY_TEXTURE_MAX_DIFFS)
+    memory_texture_diff_free (g_queue_pop_head (&self->diffs));
+}
+
 /**
  * gdk_texture_get_width:
  * @texture: a #GdkTexture
@@ -798,6 +1448,60 @@ gdk_texture_download (GdkTexture *texture,
   return GDK_TEXTURE_GET_CLASS (texture)->download (texture, data, stride);
 }
 
+/**
+ * gdk_texture_download_async:
+ * @texture: a #GdkTexture
+ * @cancellable: (nullable): optional #GCancellable object, %NULL to ignore
+ * @callback: (scope async): callback to call when the download is done
+ * @user_data: (closure): data to pass to @callback
+ *
+ * Asynchronously downloads the @texture into local memory.
+ *
+ * The pixel data is in the same format as gdk_texture_download() uses,
+ * with a stride of 4x the width of the texture.
+ *
+ * For textures that live on the GPU, the download happens without
+ * blocking on the GPU finishing its work, so continuously downloading
+ * textures - for example to stream screenshots - does not stall
+ * rendering.
+ *
+ * When the operation is finished, @callback will be called. Call
+ * gdk_texture_download_finish() to get the result.
+ */
+void
+gdk_texture_download_async (GdkTexture          *texture,
+                            GCancellable        *cancellable,
+                            GAsyncReadyCallback  callback,
+                            gpointer             user_data)
+{
+  g_return_if_fail (GDK_IS_TEXTURE (texture));
+  g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+  GDK_TEXTURE_GET_CLASS (texture)->download_async (texture, cancellable, callback, user_data);
+}
+
+/**
+ * gdk_texture_download_finish:
+ * @texture: a #GdkTexture
+ * @result: a #GAsyncResult
+ * @error: a #GError location to store the error occurring, or %NULL to ignore
+ *
+ * Finishes an asynchronous texture download started with
+ * gdk_texture_download_async().
+ *
+ * Returns: (transfer full): a new #GBytes with the pixel data, or %NULL on error
+ */
+GBytes *
+gdk_texture_download_finish (GdkTexture    *texture,
+                             GAsyncResult  *result,
+                             GError       **error)
+{
+  g_return_val_if_fail (GDK_IS_TEXTURE (texture), NULL);
+  g_return_val_if_fail (G_IS_ASYNC_RESULT (result), NULL);
+
+  return GDK_TEXTURE_GET_CLASS (texture)->download_finish (texture, result, error);
+}
+
 gboolean
 gdk_texture_set_render_data (GdkTexture     *self,
                              gpointer        key,
@@ -67,6 +67,28 @@ GdkTexture *            gdk_texture_new_for_gl                 (GdkGLContext
 GDK_AVAILABLE_IN_ALL
 void                    gdk_texture_release_gl                 (GdkTexture      *texture);
 
+GDK_AVAILABLE_IN_ALL
+GdkTexture *            gdk_texture_new_for_dmabuf             (int              fd,
+                                                                int              width,
+                                                                int              height,
+                                                                guint32          fourcc,
+                                                                guint            stride,
+                                                                guint            offset,
+                                                                guint64          modifier,
+                                                                GDestroyNotify   destroy,
+                                                                gpointer         data);
+
+GDK_AVAILABLE_IN_ALL
+GdkTexture *            gdk_texture_new_for_bytes              (GBytes          *bytes,
+                                                                int              width,
+                                                                int              height,
+                                                                int              stride);
+
+GDK_AVAILABLE_IN_ALL
+void                    gdk_texture_update                     (GdkTexture      *texture,
+                                                                GBytes          *bytes,
+                                                                const cairo_region_t *region);
+
 GDK_AVAILABLE_IN_ALL
 int                     gdk_texture_get_width                  (GdkTexture      *texture);
 GDK_AVAILABLE_IN_ALL
@@ -76,6 +98,15 @@ GDK_AVAILABLE_IN_ALL
 void                    gdk_texture_download                   (GdkTexture      *texture,
                                                                 guchar          *data,
                                                                 gsize            stride);
+GDK_AVAILABLE_IN_ALL
+void                    gdk_texture_download_async             (GdkTexture      *texture,
+                                                                GCancellable    *cancellable,
+                                                                GAsyncReadyCallback callback,
+                                                                gpointer         user_data);
+GDK_AVAILABLE_IN_ALL
+GBytes *                gdk_texture_download_finish            (GdkTexture      *texture,
+                                                                GAsyncResult    *result,
+                                                                GError         **error);
 
 G_END_DECLS
 
@@ -28,6 +28,13 @@ struct _GdkTextureClass {
                                                          guchar                 *data,
                                                          gsize                   stride);
   cairo_surface_t *     (* download_surface)            (GdkTexture             *texture);
+  void                  (* download_async)              (GdkTexture             *texture,
+                                                         GCancellable           *cancellable,
+                                                         GAsyncReadyCallback     callback,
+                                                         gpointer                user_data);
+  GBytes *              (* download_finish)             (GdkTexture             *texture,
+                                                         GAsyncResult           *result,
+                                                         GError                **error);
 };
 
 gpointer                gdk_texture_new                 (const GdkTextureClass  *klass,
@@ -51,6 +58,32 @@ G_DECLARE_FINAL_TYPE (GdkGLTexture, gdk_gl_texture, GDK, GL_TEXTURE, GdkTexture)
 GdkGLContext *          gdk_gl_texture_get_context      (GdkGLTexture           *self);
 guint                   gdk_gl_texture_get_id           (GdkGLTexture           *self);
 
+#define GDK_TYPE_DMABUF_TEXTURE (gdk_dmabuf_texture_get_type ())
+
+G_DECLARE_FINAL_TYPE (GdkDmabufTexture, gdk_dmabuf_texture, GDK, DMABUF_TEXTURE, GdkTexture)
+
+/* DRM_FORMAT_MOD_LINEAR / DRM_FORMAT_MOD_INVALID, so that we do not
+ * need drm_fourcc.h here
+ */
+#define GDK_DMABUF_MODIFIER_LINEAR  0
+#define GDK_DMABUF_MODIFIER_INVALID ((guint64) 0x00ffffffffffffff)
+
+int                     gdk_dmabuf_texture_get_fd       (GdkDmabufTexture       *self);
+guint32                 gdk_dmabuf_texture_get_fourcc   (GdkDmabufTexture       *self);
+guint                   gdk_dmabuf_texture_get_stride   (GdkDmabufTexture       *self);
+guint                   gdk_dmabuf_texture_get_offset   (GdkDmabufTexture       *self);
+guint64                 gdk_dmabuf_texture_get_modifier (GdkDmabufTexture       *self);
+
+#define GDK_TYPE_MEMORY_TEXTURE (gdk_memory_texture_get_type ())
+
+G_DECLARE_FINAL_TYPE (GdkMemoryTexture, gdk_memory_texture, GDK, MEMORY_TEXTURE, GdkTexture)
+
+GBytes *                gdk_memory_texture_get_bytes    (GdkMemoryTexture       *self);
+gsize                   gdk_memory_texture_get_stride   (GdkMemoryTexture       *self);
+gsize                   gdk_memory_texture_get_serial   (GdkMemoryTexture       *self);
+cairo_region_t *        gdk_memory_texture_get_diff     (GdkMemoryTexture       *self,
+                                                         gsize                   since_serial);
+
 G_END_DECLS
 
 #endif /* __GDK_TEXTURE_PRIVATE_H__ */
@@ -61,6 +61,10 @@ struct _GdkVulkanContextPrivate {
   int swapchain_width, swapchain_height;
   VkSwapchainKHR swapchain;
   VkSemaphore draw_semaphore;
+  VkFence draw_fence;
+
+  VkPresentModeKHR present_mode;
+  uint32_t preferred_images;    /* 0 means pick a default */
 
   guint n_images;
   VkImage *images;
@@ -173,6 +177,14 @@ gdk_vulkan_context_dispose (GObject *gobject)
 
   device = gdk_vulkan_context_get_device (context);
 
+  if (priv->draw_fence != VK_NULL_HANDLE)
+    {
+      vkDestroyFence (device,
+                      priv->draw_fence,
+                      NULL);
+      priv->draw_fence = VK_NULL_HANDLE;
+    }
+
   if (priv->draw_semaphore != VK_NULL_HANDLE)
     {
       vkDestroySemaphore (device,
@@ -213,6 +225,7 @@ gdk_vulkan_context_check_swapchain (GdkVulkanContext  *context,
   GdkWindow *window = gdk_draw_context_get_window (GDK_DRAW_CONTEXT (context));
   VkSurfaceCapabilitiesKHR capabilities;
   VkCompositeAlphaFlagBitsKHR composite_alpha;
+  VkPresentModeKHR present_mode;
   VkSwapchainKHR new_swapchain;
   VkResult res;
   VkDevice device;
@@ -261,13 +274,43 @@ gdk_vulkan_context_check_swapchain (GdkVulkanContext  *context,
       capabilities.currentExtent.height = gdk_window_get_height (window) * gdk_window_get_scale_factor (window);
     }
 
+  /* FIFO is the only mode the spec requires to be supported; anything
+   * else needs to be checked against the surface.
+   */
+  present_mode = VK_PRESENT_MODE_FIFO_KHR;
+  if (priv->present_mode != VK_PRESENT_MODE_FIFO_KHR)
+    {
+      uint32_t n_present_modes;
+      VkPresentModeKHR *present_modes;
+
+      GDK_VK_CHECK (vkGetPhysicalDeviceSurfacePresentModesKHR, gdk_vulkan_context_get_physical_device (context),
+                                                               priv->surface,
+                                                               &n_present_modes, NULL);
+      present_modes = g_newa (VkPresentModeKHR, n_present_modes);
+      GDK_VK_CHECK (vkGetPhysicalDeviceSurfacePresentModesKHR, gdk_vulkan_context_get_physical_device (context),
+                                                               priv->surface,
+                                                               &n_present_modes, present_modes);
+      for (i = 0; i < n_present_modes; i++)
+        {
+          if (present_modes[i] == priv->present_mode)
+            {
+              present_mode = priv->present_mode;
+              break;
+            }
+        }
+
+      if (present_mode != priv->present_mode)
+        GDK_DISPLAY_NOTE (gdk_draw_context_get_display (GDK_DRAW_CONTEXT (context)),
+                          VULKAN, g_warning ("Requested present mode not supported by surface. Using FIFO instead."));
+    }
+
   res = GDK_VK_CHECK (vkCreateSwapchainKHR, device,
                                             &(VkSwapchainCreateInfoKHR) {
                                                 .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
                                                 .pNext = NULL,
                                                 .flags = 0,
                                                 .surface = priv->surface,
-                                                .minImageCount = CLAMP (2,
+                                                .minImageCount = CLAMP (priv->preferred_images ? priv->preferred_images : 2,
                                                                         capabilities.minImageCount,
                                                                         capabilities.maxImageCount ? capabilities.maxImageCount : G_MAXUINT32),
                                                 .imageFormat = priv->image_format.format,
@@ -282,7 +325,7 @@ gdk_vulkan_context_check_swapchain (GdkVulkanContext  *context,
                                                 },
                                                 .preTransform = capabilities.currentTransform,
                                                 .compositeAlpha = composite_alpha,
-                                                .presentMode = VK_PRESENT_MODE_FIFO_KHR,
+                                                .presentMode = present_mode,
                                                 .clipped = VK_FALSE,
                                                 .oldSwapchain = priv->swapchain
                                             },
@@ -364,11 +407,16 @@ gdk_vulkan_context_begin_frame (GdkDrawContext *draw_context,
       cairo_region_union (priv->regions[i], region);
     }
 
+  if (priv->draw_fence != VK_NULL_HANDLE)
+    vkResetFences (gdk_vulkan_context_get_device (context),
+                   1,
+                   (VkFence[1]) { priv->draw_fence });
+
   GDK_VK_CHECK (vkAcquireNextImageKHR, gdk_vulkan_context_get_device (context),
                                        priv->swapchain,
                                        UINT64_MAX,
                                        priv->draw_semaphore,
-                                       VK_NULL_HANDLE,
+                                       priv->draw_fence,
                                        &priv->draw_index);
 
   cairo_region_union (region, priv->regions[priv->draw_index]);
@@ -434,6 +482,9 @@ gdk_vulkan_context_class_init (GdkVulkanContextClass *klass)
 static void
 gdk_vulkan_context_init (GdkVulkanContext *self)
 {
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (self);
+
+  priv->present_mode = VK_PRESENT_MODE_FIFO_KHR;
 }
 
 static gboolean
@@ -506,6 +557,14 @@ gdk_vulkan_context_real_init (GInitable     *initable,
                                        NULL,
                                        &priv->draw_semaphore);
 
+      GDK_VK_CHECK (vkCreateFence, gdk_vulkan_context_get_device (context),
+                                   &(VkFenceCreateInfo) {
+                                       .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+                                       .flags = VK_FENCE_CREATE_SIGNALED_BIT,
+                                   },
+                                   NULL,
+                                   &priv->draw_fence);
+
       return TRUE;
     }
 
@@ -708,6 +767,144 @@ gdk_vulkan_context_get_draw_semaphore (GdkVulkanContext *context)
   return priv->draw_semaphore;
 }
 
+/**
+ * gdk_vulkan_context_get_draw_fence:
+ * @context: a #GdkVulkanContext
+ *
+ * Gets the Vulkan fence that is signaled once the image that is currently
+ * being drawn has actually been handed over by the presentation engine.
+ *
+ * Waiting on this fence with vkWaitForFences() allows applications to
+ * block until the previously presented image has been consumed, instead
+ * of queueing up frames and increasing latency.
+ *
+ * This function can only be used between gdk_window_begin_draw_frame() and
+ * gdk_window_end_draw_frame() calls for the toplevel window that the
+ * @context is associated with.
+ *
+ * Returns: (transfer none): the VkFence
+ */
+VkFence
+gdk_vulkan_context_get_draw_fence (GdkVulkanContext *context)
+{
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (context);
+
+  g_return_val_if_fail (GDK_IS_VULKAN_CONTEXT (context), VK_NULL_HANDLE);
+  g_return_val_if_fail (gdk_draw_context_is_drawing (GDK_DRAW_CONTEXT (context)), VK_NULL_HANDLE);
+
+  return priv->draw_fence;
+}
+
+/**
+ * gdk_vulkan_context_set_present_mode:
+ * @context: a #GdkVulkanContext
+ * @present_mode: the Vulkan present mode to use
+ *
+ * Sets the present mode that @context should use for its swapchain.
+ *
+ * The default is %VK_PRESENT_MODE_FIFO_KHR, which is the only mode
+ * the Vulkan specification requires to be supported. If the surface
+ * does not support the requested mode, @context falls back to
+ * %VK_PRESENT_MODE_FIFO_KHR.
+ *
+ * The swapchain is recreated on the next frame, so the new mode does
+ * not take effect for a frame that is currently being drawn.
+ */
+void
+gdk_vulkan_context_set_present_mode (GdkVulkanContext *context,
+                                     VkPresentModeKHR  present_mode)
+{
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (context);
+
+  g_return_if_fail (GDK_IS_VULKAN_CONTEXT (context));
+
+  if (priv->present_mode == present_mode)
+    return;
+
+  priv->present_mode = present_mode;
+
+  /* force the swapchain to be recreated on the next frame */
+  priv->swapchain_width = 0;
+  priv->swapchain_height = 0;
+}
+
+/**
+ * gdk_vulkan_context_get_present_mode:
+ * @context: a #GdkVulkanContext
+ *
+ * Gets the present mode set via gdk_vulkan_context_set_present_mode().
+ *
+ * Note that this is the requested mode; if the surface does not
+ * support it, the swapchain uses %VK_PRESENT_MODE_FIFO_KHR instead.
+ *
+ * Returns: the requested present mode
+ */
+VkPresentModeKHR
+gdk_vulkan_context_get_present_mode (GdkVulkanContext *context)
+{
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (context);
+
+  g_return_val_if_fail (GDK_IS_VULKAN_CONTEXT (context), VK_PRESENT_MODE_FIFO_KHR);
+
+  return priv->present_mode;
+}
+
+/**
+ * gdk_vulkan_context_set_preferred_image_count:
+ * @context: a #GdkVulkanContext
+ * @count: the preferred number of swapchain images, or 0 for the default
+ *
+ * Sets the number of images @context should request for its swapchain.
+ *
+ * More images allow deeper pipelining at the cost of latency and memory,
+ * fewer images reduce latency. The actual number is clamped to what the
+ * surface supports, so the value eventually used may differ. A @count of
+ * 0 restores the default.
+ *
+ * The swapchain is recreated on the next frame, so the new count does
+ * not take effect for a frame that is currently being drawn.
+ */
+void
+gdk_vulkan_context_set_preferred_image_count (GdkVulkanContext *context,
+                                              uint32_t          count)
+{
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (context);
+
+  g_return_if_fail (GDK_IS_VULKAN_CONTEXT (context));
+
+  if (priv->preferred_images == count)
+    return;
+
+  priv->preferred_images = count;
+
+  /* force the swapchain to be recreated on the next frame */
+  priv->swapchain_width = 0;
+  priv->swapchain_height = 0;
+}
+
+/**
+ * gdk_vulkan_context_get_preferred_image_count:
+ * @context: a #GdkVulkanContext
+ *
+ * Gets the preferred swapchain image count set via
+ * gdk_vulkan_context_set_preferred_image_count().
+ *
+ * Use gdk_vulkan_context_get_n_images() to query the number of images
+ * the swapchain actually uses.
+ *
+ * Returns: the preferred number of swapchain images, or 0 if the
+ *     default is used
+ */
+uint32_t
+gdk_vulkan_context_get_preferred_image_count (GdkVulkanContext *context)
+{
+  GdkVulkanContextPrivate *priv = gdk_vulkan_context_get_instance_private (context);
+
+  g_return_val_if_fail (GDK_IS_VULKAN_CONTEXT (context), 0);
+
+  return priv->preferred_images;
+}
+
 static gboolean
 gdk_display_create_vulkan_device (GdkDisplay  *display,
                                   GError     **error)
@@ -73,6 +73,18 @@ GDK_AVAILABLE_IN_ALL
 uint32_t                gdk_vulkan_context_get_draw_index           (GdkVulkanContext  *context);
 GDK_AVAILABLE_IN_ALL
 VkSemaphore             gdk_vulkan_context_get_draw_semaphore       (GdkVulkanContext  *context);
+GDK_AVAILABLE_IN_ALL
+VkFence                 gdk_vulkan_context_get_draw_fence           (GdkVulkanContext  *context);
+GDK_AVAILABLE_IN_ALL
+void                    gdk_vulkan_context_set_present_mode         (GdkVulkanContext  *context,
+                                                                     VkPresentModeKHR   present_mode);
+GDK_AVAILABLE_IN_ALL
+VkPresentModeKHR        gdk_vulkan_context_get_present_mode         (GdkVulkanContext  *context);
+GDK_AVAILABLE_IN_ALL
+void                    gdk_vulkan_context_set_preferred_image_count (GdkVulkanContext *context,
+                                                                      uint32_t          count);
+GDK_AVAILABLE_IN_ALL
+uint32_t                gdk_vulkan_context_get_preferred_image_count (GdkVulkanContext *context);
 
 #endif /* GDK_RENDERING_VULKAN */
 #endif /* __GI_SCANNER__ */
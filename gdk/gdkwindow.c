@@ -124,6 +124,9 @@ static void gdk_window_get_property (GObject      *object,
 
 static void gdk_window_clear_backing_region (GdkWindow *window);
 
+static void gdk_window_pick_index_invalidate (GdkWindow *window);
+static void gdk_window_pick_index_clear      (GdkWindow *window);
+
 static void recompute_visible_regions   (GdkWindow *private,
 					 gboolean recalculate_children);
 static void gdk_window_invalidate_in_parent (GdkWindow *private);
@@ -234,7 +237,10 @@ gdk_window_init (GdkWindow *window)
   window->width = 1;
   window->height = 1;
   window->toplevel_window_type = -1;
+  window->invalidate_granularity = 1;
   window->children_list_node.data = window;
+  /* Stale from the start, so the first pick builds the index */
+  window->pick_index.serial = 1;
 
   window->device_cursor = g_hash_table_new_full (NULL, NULL,
                                                  NULL, g_object_unref);
@@ -396,6 +402,8 @@ gdk_window_finalize (GObject *object)
   if (window->opaque_region)
     cairo_region_destroy (window->opaque_region);
 
+  gdk_window_pick_index_clear (window);
+
   G_OBJECT_CLASS (gdk_window_parent_class)->finalize (object);
 }
 
@@ -789,6 +797,12 @@ recompute_visible_regions (GdkWindow *private,
 {
   GdkWindow *toplevel;
 
+  /* Every geometry or map-state change of a child passes through
+   * here, so this is the central point to age the parent's pick index
+   */
+  gdk_window_pick_index_invalidate (private->parent);
+  gdk_window_pick_index_invalidate (private);
+
   toplevel = gdk_window_get_toplevel (private);
   toplevel->geometry_dirty = TRUE;
 
@@ -1209,6 +1223,8 @@ _gdk_window_destroy_hierarchy (GdkWindow *window,
 	      if (window->parent->children)
                 window->parent->children = g_list_remove_link (window->parent->children, &window->children_list_node);
 
+	      gdk_window_pick_index_invalidate (window->parent);
+
 	      if (!recursing &&
 		  GDK_WINDOW_IS_MAPPED (window))
 		{
@@ -1693,10 +1709,14 @@ gdk_window_get_paint_gl_context (GdkWindow  *window,
           return NULL;
         }
 
+      /* All paint contexts on a display share one GL share group, so
+       * textures, atlases and programs uploaded for one window can be
+       * reused for every other window.
+       */
       window->impl_window->gl_paint_context =
         impl_class->create_gl_context (window->impl_window,
                                        TRUE,
-                                       NULL,
+                                       window->display->gl_share_context,
                                        &internal_error);
     }
 
@@ -1715,6 +1735,10 @@ gdk_window_get_paint_gl_context (GdkWindow  *window,
       return NULL;
     }
 
+  if (window->display->gl_share_context == NULL)
+    window->display->gl_share_context =
+      g_object_ref (window->impl_window->gl_paint_context);
+
   return window->impl_window->gl_paint_context;
 }
 
@@ -2436,6 +2460,34 @@ gdk_window_process_updates_internal (GdkWindow *window)
   g_object_unref (window);
 }
 
+/* Keep the frame clock ticking at the rate of the monitor the window
+ * occupies, so windows on fast monitors are not limited to the 60Hz
+ * default while windows on slow monitors do not paint frames that are
+ * never displayed.
+ */
+static void
+gdk_window_sync_frame_interval (GdkWindow     *window,
+                                GdkFrameClock *clock)
+{
+  GdkMonitor *monitor;
+  int refresh_rate;
+
+  if (!GDK_IS_FRAME_CLOCK_IDLE (clock))
+    return;
+
+  monitor = gdk_display_get_monitor_at_window (window->display, window);
+  if (monitor == NULL)
+    return;
+
+  refresh_rate = gdk_monitor_get_refresh_rate (monitor);
+  if (refresh_rate == 0)
+    return;
+
+  /* refresh rate is in milli-Hertz */
+  _gdk_frame_clock_idle_set_frame_interval (GDK_FRAME_CLOCK_IDLE (clock),
+                                            G_GINT64_CONSTANT (1000000000) / refresh_rate);
+}
+
 static void
 gdk_window_paint_on_clock (GdkFrameClock *clock,
 			   void          *data)
@@ -2450,6 +2502,8 @@ gdk_window_paint_on_clock (GdkFrameClock *clock,
   if (GDK_WINDOW_DESTROYED (window))
     return;
 
+  gdk_window_sync_frame_interval (window, clock);
+
   g_object_ref (window);
 
   if (window->update_area &&
@@ -2516,12 +2570,63 @@ gdk_window_invalidate_rect (GdkWindow          *window,
   gdk_window_invalidate_rect_full (window, rect, invalidate_children);
 }
 
+/* Pathological invalidation patterns (e.g. thousands of tiny dirty
+ * rectangles from a scatter plot) make every subsequent region
+ * operation iterate all of them. Once the update area has more
+ * rectangles than this, we collapse it into a few horizontal bands;
+ * redrawing only needs a superset of the dirty area, so the extra
+ * pixels are a fair trade for keeping the region algebra cheap.
+ */
+#define MAX_UPDATE_AREA_RECTANGLES 256
+#define UPDATE_AREA_SIMPLIFY_BANDS 8
+
+static cairo_region_t *
+simplify_update_area (cairo_region_t *region)
+{
+  cairo_rectangle_int_t extents, band;
+  cairo_region_t *simple, *in_band;
+  int band_height, i;
+
+  cairo_region_get_extents (region, &extents);
+
+  band_height = (extents.height + UPDATE_AREA_SIMPLIFY_BANDS - 1) /
+    UPDATE_AREA_SIMPLIFY_BANDS;
+
+  simple = cairo_region_create ();
+  for (i = 0; i < UPDATE_AREA_SIMPLIFY_BANDS; i++)
+    {
+      band.x = extents.x;
+      band.width = extents.width;
+      band.y = extents.y + i * band_height;
+      band.height = MIN (band_height, extents.y + extents.height - band.y);
+      if (band.height <= 0)
+	break;
+
+      in_band = cairo_region_copy (region);
+      cairo_region_intersect_rectangle (in_band, &band);
+      cairo_region_get_extents (in_band, &band);
+      cairo_region_union_rectangle (simple, &band);
+      cairo_region_destroy (in_band);
+    }
+
+  return simple;
+}
+
 static void
 impl_window_add_update_area (GdkWindow *impl_window,
 			     cairo_region_t *region)
 {
   if (impl_window->update_area)
-    cairo_region_union (impl_window->update_area, region);
+    {
+      cairo_region_union (impl_window->update_area, region);
+
+      if (cairo_region_num_rectangles (impl_window->update_area) > MAX_UPDATE_AREA_RECTANGLES)
+	{
+	  cairo_region_t *simplified = simplify_update_area (impl_window->update_area);
+	  cairo_region_destroy (impl_window->update_area);
+	  impl_window->update_area = simplified;
+	}
+    }
   else
     {
       gdk_window_add_update_window (impl_window);
@@ -2555,6 +2660,33 @@ gdk_window_invalidate_maybe_recurse_full (GdkWindow            *window,
 
   visible_region = cairo_region_copy (region);
 
+  if (window->invalidate_granularity > 1)
+    {
+      cairo_region_t *coarse;
+      cairo_rectangle_int_t rect;
+      int gran, x1, y1, x2, y2, i;
+
+      /* Snap every rectangle outward to the declared granularity;
+       * neighbouring rectangles then fuse instead of accumulating */
+      gran = window->invalidate_granularity;
+      coarse = cairo_region_create ();
+      for (i = 0; i < cairo_region_num_rectangles (visible_region); i++)
+	{
+	  cairo_region_get_rectangle (visible_region, i, &rect);
+	  x1 = (rect.x / gran) * gran;
+	  y1 = (rect.y / gran) * gran;
+	  x2 = ((rect.x + rect.width + gran - 1) / gran) * gran;
+	  y2 = ((rect.y + rect.height + gran - 1) / gran) * gran;
+	  rect.x = x1;
+	  rect.y = y1;
+	  rect.width = x2 - x1;
+	  rect.height = y2 - y1;
+	  cairo_region_union_rectangle (coarse, &rect);
+	}
+      cairo_region_destroy (visible_region);
+      visible_region = coarse;
+    }
+
   while (window != NULL && 
 	 !cairo_region_is_empty (visible_region))
     {
@@ -2656,6 +2788,31 @@ gdk_window_invalidate_region (GdkWindow       *window,
 				       NULL);
 }
 
+/**
+ * gdk_window_set_invalidate_granularity:
+ * @window: a #GdkWindow
+ * @granularity: the invalidation granularity in pixels, or 1 for
+ *     pixel-exact invalidation
+ *
+ * Declares how coarsely @window wants to be invalidated. Regions
+ * passed to gdk_window_invalidate_region() are rounded outward to
+ * multiples of @granularity, so many small neighbouring rectangles
+ * fuse into a few larger ones instead of accumulating.
+ *
+ * This is a hint for windows whose content is redrawn in coarse
+ * chunks anyway — more pixels may be reported as dirty than were
+ * invalidated, but the update area stays cheap to operate on.
+ **/
+void
+gdk_window_set_invalidate_granularity (GdkWindow *window,
+				       gint       granularity)
+{
+  g_return_if_fail (GDK_IS_WINDOW (window));
+  g_return_if_fail (granularity >= 1);
+
+  window->invalidate_granularity = granularity;
+}
+
 /**
  * _gdk_window_invalidate_for_expose:
  * @window: a #GdkWindow
@@ -3065,6 +3222,7 @@ gdk_window_raise_internal (GdkWindow *window)
     {
       parent->children = g_list_remove_link (parent->children, &window->children_list_node);
       parent->children = g_list_concat (&window->children_list_node, parent->children);
+      gdk_window_pick_index_invalidate (parent);
       did_raise = TRUE;
     }
 
@@ -3247,6 +3405,7 @@ gdk_window_lower_internal (GdkWindow *window)
     {
       parent->children = g_list_remove_link (parent->children, &window->children_list_node);
       parent->children = g_list_concat (parent->children, &window->children_list_node);
+      gdk_window_pick_index_invalidate (parent);
     }
 
   impl_class = GDK_WINDOW_IMPL_GET_CLASS (window->impl);
@@ -3374,6 +3533,8 @@ gdk_window_restack (GdkWindow     *window,
 	parent->children = list_insert_link_before (parent->children,
                                                     sibling_link->next,
                                                     &window->children_list_node);
+
+      gdk_window_pick_index_invalidate (parent);
     }
 
   gdk_window_invalidate_in_parent (window);
@@ -4927,6 +5088,129 @@ update_cursor (GdkDisplay *display,
   GDK_DEVICE_GET_CLASS (device)->set_window_cursor (device, toplevel, cursor);
 }
 
+/* Hit-test pruning: for windows with many children the linear child
+ * walks below get expensive, so we lazily build a uniform grid over
+ * the window, mapping each cell to the children covering it, in
+ * stacking order. The grid is aged by bumping pick_index.serial
+ * whenever the child list or child geometry changes and is rebuilt on
+ * the next pick; a stale grid is never dereferenced, so it may safely
+ * keep pointers to windows that are already gone.
+ */
+
+#define PICK_INDEX_MIN_CHILDREN 32
+#define PICK_INDEX_GRID_SIZE 8
+
+static void
+gdk_window_pick_index_clear (GdkWindow *window)
+{
+  int i;
+
+  if (window->pick_index.cells == NULL)
+    return;
+
+  for (i = 0; i < window->pick_index.n_cols * window->pick_index.n_rows; i++)
+    g_ptr_array_unref (window->pick_index.cells[i]);
+
+  g_free (window->pick_index.cells);
+  window->pick_index.cells = NULL;
+}
+
+static void
+gdk_window_pick_index_invalidate (GdkWindow *window)
+{
+  if (window != NULL)
+    window->pick_index.serial++;
+}
+
+static void
+gdk_window_pick_index_build (GdkWindow *window)
+{
+  GdkWindow *sub;
+  GList *l;
+  int i, col, row, first_col, last_col, first_row, last_row;
+
+  gdk_window_pick_index_clear (window);
+
+  window->pick_index.built_serial = window->pick_index.serial;
+
+  if (g_list_length (window->children) < PICK_INDEX_MIN_CHILDREN ||
+      window->width <= 0 || window->height <= 0)
+    return;
+
+  window->pick_index.n_cols = PICK_INDEX_GRID_SIZE;
+  window->pick_index.n_rows = PICK_INDEX_GRID_SIZE;
+  window->pick_index.cell_width =
+    (window->width + PICK_INDEX_GRID_SIZE - 1) / PICK_INDEX_GRID_SIZE;
+  window->pick_index.cell_height =
+    (window->height + PICK_INDEX_GRID_SIZE - 1) / PICK_INDEX_GRID_SIZE;
+
+  window->pick_index.cells =
+    g_new0 (GPtrArray *, PICK_INDEX_GRID_SIZE * PICK_INDEX_GRID_SIZE);
+  for (i = 0; i < PICK_INDEX_GRID_SIZE * PICK_INDEX_GRID_SIZE; i++)
+    window->pick_index.cells[i] = g_ptr_array_new ();
+
+  /* Children is ordered in reverse stack order, so appending here
+   * keeps each cell in reverse stack order too */
+  for (l = window->children; l != NULL; l = l->next)
+    {
+      sub = l->data;
+
+      if (!GDK_WINDOW_IS_MAPPED (sub))
+	continue;
+
+      /* Picked points are always within the window's own extent, so
+       * children entirely outside it can never be hit */
+      if (sub->x >= window->width || sub->y >= window->height ||
+	  sub->x + sub->width <= 0 || sub->y + sub->height <= 0)
+	continue;
+
+      first_col = CLAMP (sub->x / window->pick_index.cell_width,
+			 0, PICK_INDEX_GRID_SIZE - 1);
+      last_col = CLAMP ((sub->x + sub->width - 1) / window->pick_index.cell_width,
+			0, PICK_INDEX_GRID_SIZE - 1);
+      first_row = CLAMP (sub->y / window->pick_index.cell_height,
+			 0, PICK_INDEX_GRID_SIZE - 1);
+      last_row = CLAMP ((sub->y + sub->height - 1) / window->pick_index.cell_height,
+			0, PICK_INDEX_GRID_SIZE - 1);
+
+      for (row = first_row; row <= last_row; row++)
+	for (col = first_col; col <= last_col; col++)
+	  g_ptr_array_add (window->pick_index.cells[row * PICK_INDEX_GRID_SIZE + col], sub);
+    }
+}
+
+/* Returns the children possibly covering x,y in reverse stack order,
+ * or NULL if the window has no index and the full child list must be
+ * walked instead. The coordinates must be within the window.
+ */
+static GPtrArray *
+gdk_window_pick_index_lookup (GdkWindow *window,
+			      gdouble    x,
+			      gdouble    y)
+{
+  int col, row;
+
+  if (window->pick_index.built_serial != window->pick_index.serial)
+    gdk_window_pick_index_build (window);
+
+  if (window->pick_index.cells == NULL)
+    return NULL;
+
+  col = CLAMP ((int) x / window->pick_index.cell_width,
+	       0, window->pick_index.n_cols - 1);
+  row = CLAMP ((int) y / window->pick_index.cell_height,
+	       0, window->pick_index.n_rows - 1);
+
+  return window->pick_index.cells[row * window->pick_index.n_cols + col];
+}
+
+static GdkWindow * gdk_window_pick_child (GdkWindow  *window,
+					  gdouble     x,
+					  gdouble     y,
+					  GdkWindow **input_window,
+					  gdouble    *input_window_x,
+					  gdouble    *input_window_y);
+
 static gboolean
 point_in_window (GdkWindow *window,
 		 gdouble    x,
@@ -4954,8 +5238,6 @@ point_in_input_window (GdkWindow *window,
 		       gdouble   *input_window_y)
 {
   GdkWindow *sub;
-  double child_x, child_y;
-  GList *l;
 
   if (!point_in_window (window, x, y))
     return FALSE;
@@ -4972,6 +5254,56 @@ point_in_input_window (GdkWindow *window,
     }
 
   /* For pass-through, must be over a child input window */
+  sub = gdk_window_pick_child (window, x, y,
+			       input_window, input_window_x, input_window_y);
+  if (sub != NULL)
+    {
+      if (input_window)
+	gdk_window_coords_to_parent (sub,
+				     *input_window_x,
+				     *input_window_y,
+				     input_window_x,
+				     input_window_y);
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
+/* Finds the topmost mapped child input window at x,y, which must be
+ * within @window. Consults the pick index when one exists, otherwise
+ * walks the full child list.
+ */
+static GdkWindow *
+gdk_window_pick_child (GdkWindow  *window,
+		       gdouble     x,
+		       gdouble     y,
+		       GdkWindow **input_window,
+		       gdouble    *input_window_x,
+		       gdouble    *input_window_y)
+{
+  GdkWindow *sub;
+  double child_x, child_y;
+  GPtrArray *candidates;
+  GList *l;
+  guint i;
+
+  candidates = gdk_window_pick_index_lookup (window, x, y);
+  if (candidates)
+    {
+      /* Cells are in reverse stack order, i.e. first is topmost */
+      for (i = 0; i < candidates->len; i++)
+	{
+	  sub = g_ptr_array_index (candidates, i);
+
+	  gdk_window_coords_from_parent (sub, x, y, &child_x, &child_y);
+	  if (point_in_input_window (sub, child_x, child_y,
+				     input_window, input_window_x, input_window_y))
+	    return sub;
+	}
+
+      return NULL;
+    }
 
   /* Children is ordered in reverse stack order, i.e. first is topmost */
   for (l = window->children; l != NULL; l = l->next)
@@ -4981,23 +5313,13 @@ point_in_input_window (GdkWindow *window,
       if (!GDK_WINDOW_IS_MAPPED (sub))
 	continue;
 
-      gdk_window_coords_from_parent ((GdkWindow *)sub,
-				     x, y,
-				     &child_x, &child_y);
+      gdk_window_coords_from_parent (sub, x, y, &child_x, &child_y);
       if (point_in_input_window (sub, child_x, child_y,
 				 input_window, input_window_x, input_window_y))
-	{
-	  if (input_window)
-	    gdk_window_coords_to_parent (sub,
-					 *input_window_x,
-					 *input_window_y,
-					 input_window_x,
-					 input_window_y);
-	  return TRUE;
-	}
+	return sub;
     }
 
-  return FALSE;
+  return NULL;
 }
 
 GdkWindow *
@@ -5005,28 +5327,8 @@ _gdk_window_find_child_at (GdkWindow *window,
 			   double     x,
                            double     y)
 {
-  GdkWindow *sub;
-  double child_x, child_y;
-  GList *l;
-
   if (point_in_window (window, x, y))
-    {
-      /* Children is ordered in reverse stack order, i.e. first is topmost */
-      for (l = window->children; l != NULL; l = l->next)
-	{
-	  sub = l->data;
-
-	  if (!GDK_WINDOW_IS_MAPPED (sub))
-	    continue;
-
-	  gdk_window_coords_from_parent ((GdkWindow *)sub,
-                                         x, y,
-                                         &child_x, &child_y);
-	  if (point_in_input_window (sub, child_x, child_y,
-				     NULL, NULL, NULL))
-	    return (GdkWindow *)sub;
-	}
-    }
+    return gdk_window_pick_child (window, x, y, NULL, NULL, NULL);
 
   return NULL;
 }
@@ -5040,37 +5342,16 @@ _gdk_window_find_descendant_at (GdkWindow *window,
 {
   GdkWindow *sub, *input_window;
   gdouble child_x, child_y;
-  GList *l;
-  gboolean found;
 
   if (point_in_window (window, x, y))
     {
-      do
+      while ((sub = gdk_window_pick_child (window, x, y,
+					   &input_window, &child_x, &child_y)) != NULL)
 	{
-	  found = FALSE;
-	  /* Children is ordered in reverse stack order, i.e. first is topmost */
-	  for (l = window->children; l != NULL; l = l->next)
-	    {
-	      sub = l->data;
-
-	      if (!GDK_WINDOW_IS_MAPPED (sub))
-		continue;
-
-	      gdk_window_coords_from_parent ((GdkWindow *)sub,
-                                             x, y,
-                                             &child_x, &child_y);
-	      if (point_in_input_window (sub, child_x, child_y,
-					 &input_window, &child_x, &child_y))
-		{
-		  x = child_x;
-		  y = child_y;
-		  window = input_window;
-		  found = TRUE;
-		  break;
-		}
-	    }
+	  x = child_x;
+	  y = child_y;
+	  window = input_window;
 	}
-      while (found);
     }
   else
     {
@@ -6823,6 +7104,45 @@ gdk_window_set_opaque_region (GdkWindow      *window,
     impl_class->set_opaque_region (window, region);
 }
 
+/**
+ * gdk_window_set_overlay_hint:
+ * @window: a top-level #GdkWindow
+ * @overlay_hint: whether @window is a candidate for an overlay plane
+ *
+ * Hints that @window is a small surface that is always stacked above
+ * regular windows and follows the pointer, such as a drag icon or a
+ * tooltip.
+ *
+ * Windowing systems that support it may use this hint to place the
+ * window on a hardware cursor or overlay plane and to present its
+ * updates without waiting for the next compositing cycle, decoupling
+ * the window’s motion from the application frame rate.
+ *
+ * This is purely an optimisation hint; backends that have no way of
+ * acting on it will ignore it.
+ */
+void
+gdk_window_set_overlay_hint (GdkWindow *window,
+                             gboolean   overlay_hint)
+{
+  GdkWindowImplClass *impl_class;
+
+  g_return_if_fail (GDK_IS_WINDOW (window));
+  g_return_if_fail (!GDK_WINDOW_DESTROYED (window));
+
+  overlay_hint = !!overlay_hint;
+
+  if (window->overlay_hint == overlay_hint)
+    return;
+
+  window->overlay_hint = overlay_hint;
+
+  impl_class = GDK_WINDOW_IMPL_GET_CLASS (window->impl);
+
+  if (impl_class->set_overlay_hint)
+    impl_class->set_overlay_hint (window, overlay_hint);
+}
+
 /**
  * gdk_window_set_shadow_width:
  * @window: a #GdkWindow
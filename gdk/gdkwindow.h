@@ -859,6 +859,9 @@ GDK_AVAILABLE_IN_ALL
 void       gdk_window_invalidate_region         (GdkWindow          *window,
 					         const cairo_region_t    *region,
 					         gboolean            invalidate_children);
+GDK_AVAILABLE_IN_ALL
+void       gdk_window_set_invalidate_granularity (GdkWindow         *window,
+					         gint                granularity);
 
 /**
  * GdkWindowChildFunc:
@@ -910,6 +913,10 @@ GDK_AVAILABLE_IN_ALL
 void       gdk_window_set_opaque_region        (GdkWindow      *window,
                                                 cairo_region_t *region);
 
+GDK_AVAILABLE_IN_ALL
+void       gdk_window_set_overlay_hint         (GdkWindow      *window,
+                                                gboolean        overlay_hint);
+
 GDK_AVAILABLE_IN_ALL
 void       gdk_window_set_shadow_width         (GdkWindow      *window,
                                                 gint            left,
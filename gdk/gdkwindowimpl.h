@@ -234,6 +234,8 @@ struct _GdkWindowImplClass
 
   void         (* set_opaque_region)      (GdkWindow      *window,
                                            cairo_region_t *region);
+  void         (* set_overlay_hint)       (GdkWindow      *window,
+                                           gboolean        overlay_hint);
   void         (* set_shadow_width)       (GdkWindow      *window,
                                            gint            left,
                                            gint            right,
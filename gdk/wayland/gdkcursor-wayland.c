@@ -48,6 +48,7 @@ void
 _gdk_wayland_display_init_cursors (GdkWaylandDisplay *display)
 {
   display->cursor_surface_cache = g_hash_table_new_full (gdk_cursor_hash, gdk_cursor_equal, NULL, (GDestroyNotify) cairo_surface_destroy);
+  display->cursor_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 }
 
 void
@@ -60,6 +61,7 @@ _gdk_wayland_display_finalize_cursors (GdkWaylandDisplay *display)
   while (g_hash_table_iter_next (&iter, &cursor, NULL))
     g_object_weak_unref (G_OBJECT (cursor), gdk_wayland_cursor_remove_from_cache, display);
   g_hash_table_destroy (display->cursor_surface_cache);
+  g_hash_table_destroy (display->cursor_cache);
 }
 
 static const struct {
@@ -117,11 +119,32 @@ name_fallback (const gchar *name)
 }
 
 static struct wl_cursor *
-gdk_wayland_cursor_load_for_name (GdkWaylandDisplay      *display_wayland,
-                                  struct wl_cursor_theme *theme,
-                                  const char             *name)
+gdk_wayland_cursor_load_for_name (GdkWaylandDisplay *display_wayland,
+                                  const char        *name,
+                                  guint              scale)
 {
+  struct wl_cursor_theme *theme;
   struct wl_cursor *c;
+  char *key;
+
+  /* The theme lookup walks all cursors in the theme every time, which
+   * adds up for animated cursors fetching a buffer per frame, so keep
+   * a cache of resolved lookups (including failed ones).
+   */
+  key = g_strdup_printf ("%u/%s", scale, name);
+  if (g_hash_table_lookup_extended (display_wayland->cursor_cache, key,
+                                    NULL, (gpointer *) &c))
+    {
+      g_free (key);
+      return c;
+    }
+
+  theme = _gdk_wayland_display_get_scaled_cursor_theme (display_wayland, scale);
+  if (theme == NULL)
+    {
+      g_free (key);
+      return NULL;
+    }
 
   c = wl_cursor_theme_get_cursor (theme, name);
   if (!c)
@@ -135,9 +158,31 @@ gdk_wayland_cursor_load_for_name (GdkWaylandDisplay      *display_wayland,
         }
     }
 
+  g_hash_table_insert (display_wayland->cursor_cache, key, c);
+
   return c;
 }
 
+/* Resolve a few cursors that practically every application ends up
+ * using, so that entering a window does not pay for the theme lookup
+ * and the first wl_shm upload of the pointer image.
+ */
+void
+_gdk_wayland_display_preload_cursors (GdkWaylandDisplay *display)
+{
+  static const char *common_names[] = { "default", "text", "pointer" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (common_names); i++)
+    {
+      struct wl_cursor *c;
+
+      c = gdk_wayland_cursor_load_for_name (display, common_names[i], 1);
+      if (c && c->image_count > 0)
+        wl_cursor_image_get_buffer (c->images[0]);
+    }
+}
+
 static void
 buffer_release_callback (void             *_data,
                          struct wl_buffer *wl_buffer)
@@ -179,8 +224,8 @@ _gdk_wayland_cursor_get_buffer (GdkWaylandDisplay *display,
         }
 
       c = gdk_wayland_cursor_load_for_name (display,
-                                            _gdk_wayland_display_get_scaled_cursor_theme (display, desired_scale),
-                                            gdk_cursor_get_name (cursor));
+                                            gdk_cursor_get_name (cursor),
+                                            desired_scale);
       if (c)
         {
           struct wl_cursor_image *image;
@@ -270,8 +315,8 @@ _gdk_wayland_cursor_get_next_image_index (GdkWaylandDisplay *display,
     }
 
   c = gdk_wayland_cursor_load_for_name (display,
-                                        _gdk_wayland_display_get_scaled_cursor_theme (display, scale),
-                                        gdk_cursor_get_name (cursor));
+                                        gdk_cursor_get_name (cursor),
+                                        scale);
 
   if (c)
     {
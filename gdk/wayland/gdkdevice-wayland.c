@@ -3230,6 +3230,23 @@ gdk_wayland_tablet_flush_frame_event (GdkWaylandTabletData *tablet,
         g_memdup (tablet->axes,
                   sizeof (gdouble) *
                   gdk_device_get_n_axes (tablet->current_device));
+
+      /* Raw input subscribers get every tool frame as it comes off
+       * the wire, ahead of motion compression in the event queue
+       */
+      if (tablet->current_device->raw_input_callback)
+        {
+          GdkTimeCoord sample = { 0, };
+          gint i, n_axes;
+
+          sample.time = time;
+          n_axes = MIN (gdk_device_get_n_axes (tablet->current_device),
+                        GDK_MAX_TIMECOORD_AXES);
+          for (i = 0; i < n_axes; i++)
+            sample.axes[i] = tablet->axes[i];
+
+          _gdk_device_deliver_raw_input (tablet->current_device, &sample, 1);
+        }
       break;
     case GDK_BUTTON_PRESS:
     case GDK_BUTTON_RELEASE:
@@ -358,6 +358,21 @@ static const struct org_kde_kwin_server_decoration_manager_listener server_decor
   .default_mode = server_decoration_manager_default_mode
 };
 
+static void
+presentation_clock_id (void                   *data,
+                       struct wp_presentation *presentation,
+                       uint32_t                clk_id)
+{
+  GdkWaylandDisplay *display_wayland = data;
+
+  GDK_NOTE (MISC, g_message ("presentation-time clock id %u", clk_id));
+  display_wayland->presentation_clock_id = clk_id;
+}
+
+static const struct wp_presentation_listener presentation_listener = {
+  presentation_clock_id
+};
+
 gboolean
 gdk_wayland_display_prefers_ssd (GdkDisplay *display)
 {
@@ -392,8 +407,9 @@ gdk_registry_handle_global (void               *data,
   if (strcmp (interface, "wl_compositor") == 0)
     {
       display_wayland->compositor =
-        wl_registry_bind (display_wayland->wl_registry, id, &wl_compositor_interface, MIN (version, 3));
-      display_wayland->compositor_version = MIN (version, 3);
+        wl_registry_bind (display_wayland->wl_registry, id, &wl_compositor_interface,
+                          MIN (version, WL_SURFACE_HAS_DAMAGE_BUFFER));
+      display_wayland->compositor_version = MIN (version, WL_SURFACE_HAS_DAMAGE_BUFFER);
     }
   else if (strcmp (interface, "wl_shm") == 0)
     {
@@ -498,6 +514,15 @@ gdk_registry_handle_global (void               *data,
         wl_registry_bind (display_wayland->wl_registry, id,
                           &zwp_keyboard_shortcuts_inhibit_manager_v1_interface, 1);
     }
+  else if (strcmp (interface, "wp_presentation") == 0)
+    {
+      display_wayland->presentation =
+        wl_registry_bind (display_wayland->wl_registry, id,
+                          &wp_presentation_interface, 1);
+      wp_presentation_add_listener (display_wayland->presentation,
+                                    &presentation_listener,
+                                    display_wayland);
+    }
   else if (strcmp (interface, "org_kde_kwin_server_decoration_manager") == 0)
     {
       display_wayland->server_decoration_manager =
@@ -1036,11 +1061,16 @@ gdk_wayland_display_set_cursor_theme (GdkDisplay  *display,
           display_wayland->scaled_cursor_themes[i] = NULL;
         }
     }
+  /* the cached cursors belonged to the old themes */
+  g_hash_table_remove_all (display_wayland->cursor_cache);
+
   display_wayland->scaled_cursor_themes[0] = theme;
   if (display_wayland->cursor_theme_name != NULL)
     g_free (display_wayland->cursor_theme_name);
   display_wayland->cursor_theme_name = g_strdup (name);
   display_wayland->cursor_theme_size = size;
+
+  _gdk_wayland_display_preload_cursors (display_wayland);
 }
 
 struct wl_cursor_theme *
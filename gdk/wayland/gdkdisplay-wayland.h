@@ -34,6 +34,7 @@
 #include <gdk/wayland/xdg-foreign-unstable-v1-client-protocol.h>
 #include <gdk/wayland/keyboard-shortcuts-inhibit-unstable-v1-client-protocol.h>
 #include <gdk/wayland/server-decoration-client-protocol.h>
+#include <gdk/wayland/presentation-time-client-protocol.h>
 
 #include <glib.h>
 #include <gdk/gdkkeys.h>
@@ -96,6 +97,7 @@ struct _GdkWaylandDisplay
   struct zxdg_importer_v1 *xdg_importer;
   struct zwp_keyboard_shortcuts_inhibit_manager_v1 *keyboard_shortcuts_inhibit;
   struct org_kde_kwin_server_decoration_manager *server_decoration_manager;
+  struct wp_presentation *presentation;
 
   GList *async_roundtrips;
 
@@ -115,6 +117,7 @@ struct _GdkWaylandDisplay
   gchar *cursor_theme_name;
   int cursor_theme_size;
   GHashTable *cursor_surface_cache;
+  GHashTable *cursor_cache;     /* "scale/name" => struct wl_cursor *, owned by the theme */
 
   GSource *event_source;
 
@@ -124,6 +127,7 @@ struct _GdkWaylandDisplay
   int gtk_shell_version;
 
   uint32_t server_decoration_mode;
+  uint32_t presentation_clock_id;
 
   struct xkb_context *xkb_context;
 
@@ -142,6 +146,7 @@ struct _GdkWaylandDisplay
   guint have_egl_khr_create_context : 1;
   guint have_egl_buffer_age : 1;
   guint have_egl_swap_buffers_with_damage : 1;
+  guint have_egl_khr_swap_buffers_with_damage : 1;
   guint have_egl_surfaceless_context : 1;
 };
 
@@ -473,7 +473,12 @@ create_dnd_window (GdkDisplay *display)
   window = gdk_window_new_popup (display, &(GdkRectangle) { 0, 0, 100, 100 });
 
   gdk_window_set_type_hint (window, GDK_WINDOW_TYPE_HINT_DND);
-  
+
+  /* The icon surface moves with the pointer; let the compositor
+   * promote it to a cursor/overlay plane if it can
+   */
+  gdk_window_set_overlay_hint (window, TRUE);
+
   return window;
 }
 
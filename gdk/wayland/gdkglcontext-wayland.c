@@ -223,7 +223,8 @@ gdk_wayland_gl_context_end_frame (GdkDrawContext *draw_context,
   egl_surface = gdk_wayland_window_get_egl_surface (window->impl_window,
                                                     context_wayland->egl_config);
 
-  if (display_wayland->have_egl_swap_buffers_with_damage && damage != NULL)
+  if ((display_wayland->have_egl_swap_buffers_with_damage ||
+       display_wayland->have_egl_khr_swap_buffers_with_damage) && damage != NULL)
     {
       int i, j, n_rects = cairo_region_num_rectangles (damage);
       EGLint *rects = g_new (EGLint, n_rects * 4);
@@ -238,7 +239,10 @@ gdk_wayland_gl_context_end_frame (GdkDrawContext *draw_context,
           rects[j++] = rect.width;
           rects[j++] = rect.height;
         }
-      eglSwapBuffersWithDamageEXT (display_wayland->egl_display, egl_surface, rects, n_rects);
+      if (display_wayland->have_egl_swap_buffers_with_damage)
+        eglSwapBuffersWithDamageEXT (display_wayland->egl_display, egl_surface, rects, n_rects);
+      else
+        eglSwapBuffersWithDamageKHR (display_wayland->egl_display, egl_surface, rects, n_rects);
       g_free (rects);
     }
   else
@@ -247,6 +251,71 @@ gdk_wayland_gl_context_end_frame (GdkDrawContext *draw_context,
   gdk_wayland_window_sync (window);
 }
 
+static guint
+gdk_wayland_gl_context_import_dmabuf (GdkGLContext     *context,
+                                      GdkDmabufTexture *texture)
+{
+  GdkDisplay *display = gdk_gl_context_get_display (context);
+  GdkWaylandDisplay *display_wayland = GDK_WAYLAND_DISPLAY (display);
+  guint64 modifier = gdk_dmabuf_texture_get_modifier (texture);
+  EGLint attribs[17];
+  EGLImageKHR image;
+  guint texture_id;
+  int i = 0;
+
+  if (!epoxy_has_egl_extension (display_wayland->egl_display,
+                                "EGL_EXT_image_dma_buf_import"))
+    return 0;
+
+  attribs[i++] = EGL_WIDTH;
+  attribs[i++] = gdk_texture_get_width (GDK_TEXTURE (texture));
+  attribs[i++] = EGL_HEIGHT;
+  attribs[i++] = gdk_texture_get_height (GDK_TEXTURE (texture));
+  attribs[i++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attribs[i++] = gdk_dmabuf_texture_get_fourcc (texture);
+  attribs[i++] = EGL_DMA_BUF_PLANE0_FD_EXT;
+  attribs[i++] = gdk_dmabuf_texture_get_fd (texture);
+  attribs[i++] = EGL_DMA_BUF_PLANE0_OFFSET_EXT;
+  attribs[i++] = gdk_dmabuf_texture_get_offset (texture);
+  attribs[i++] = EGL_DMA_BUF_PLANE0_PITCH_EXT;
+  attribs[i++] = gdk_dmabuf_texture_get_stride (texture);
+  if (modifier != GDK_DMABUF_MODIFIER_INVALID &&
+      epoxy_has_egl_extension (display_wayland->egl_display,
+                               "EGL_EXT_image_dma_buf_import_modifiers"))
+    {
+      attribs[i++] = EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT;
+      attribs[i++] = modifier & 0xffffffff;
+      attribs[i++] = EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT;
+      attribs[i++] = modifier >> 32;
+    }
+  attribs[i++] = EGL_NONE;
+
+  image = eglCreateImageKHR (display_wayland->egl_display,
+                             EGL_NO_CONTEXT,
+                             EGL_LINUX_DMA_BUF_EXT,
+                             (EGLClientBuffer) NULL,
+                             attribs);
+  if (image == EGL_NO_IMAGE_KHR)
+    return 0;
+
+  gdk_gl_context_make_current (context);
+
+  glGenTextures (1, &texture_id);
+  glBindTexture (GL_TEXTURE_2D, texture_id);
+  glEGLImageTargetTexture2DOES (GL_TEXTURE_2D, image);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  /* The GL texture keeps the underlying buffer alive as a sibling of
+   * the image, so the image itself is not needed any more
+   */
+  eglDestroyImageKHR (display_wayland->egl_display, image);
+
+  return texture_id;
+}
+
 static void
 gdk_wayland_gl_context_class_init (GdkWaylandGLContextClass *klass)
 {
@@ -260,6 +329,7 @@ gdk_wayland_gl_context_class_init (GdkWaylandGLContextClass *klass)
 
   context_class->realize = gdk_wayland_gl_context_realize;
   context_class->get_damage = gdk_wayland_gl_context_get_damage;
+  context_class->import_dmabuf = gdk_wayland_gl_context_import_dmabuf;
 }
 
 static void
@@ -337,6 +407,9 @@ gdk_wayland_display_init_gl (GdkDisplay *display)
   display_wayland->have_egl_swap_buffers_with_damage =
     epoxy_has_egl_extension (dpy, "EGL_EXT_swap_buffers_with_damage");
 
+  display_wayland->have_egl_khr_swap_buffers_with_damage =
+    epoxy_has_egl_extension (dpy, "EGL_KHR_swap_buffers_with_damage");
+
   display_wayland->have_egl_surfaceless_context =
     epoxy_has_egl_extension (dpy, "EGL_KHR_surfaceless_context");
 
@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
 
 enum {
   COMMITTED,
@@ -126,6 +127,8 @@ struct _GdkWindowImplWayland
   unsigned int pending_buffer_attached : 1;
   unsigned int pending_commit : 1;
   unsigned int awaiting_frame : 1;
+  unsigned int awaiting_presented : 1;
+  unsigned int overlay_hint : 1;
   GdkWindowTypeHint hint;
   GdkWindow *transient_for;
   GdkWindow *popup_parent;
@@ -193,8 +196,14 @@ struct _GdkWindowImplWayland
     int width;
     int height;
     GdkWindowState state;
+    gboolean resizing;
   } pending;
 
+  /* Throttling of configure events during interactive resize */
+  uint32_t pending_configure_serial;
+  guint pending_configure_timeout;
+  guint resize_configure_count;
+
   struct {
     GdkWaylandWindowExported callback;
     gpointer user_data;
@@ -432,6 +441,118 @@ out:
   g_clear_pointer (&impl->backfill_cairo_surface, cairo_surface_destroy);
 }
 
+typedef struct {
+  GdkWindow *window;
+  gint64 frame_counter;
+} PresentationFeedbackData;
+
+static void
+presentation_feedback_free (struct wp_presentation_feedback *feedback,
+                            PresentationFeedbackData        *data)
+{
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (data->window->impl);
+
+  impl->awaiting_presented = FALSE;
+
+  wp_presentation_feedback_destroy (feedback);
+  g_object_unref (data->window);
+  g_free (data);
+}
+
+static void
+presentation_feedback_sync_output (void                            *data,
+                                   struct wp_presentation_feedback *feedback,
+                                   struct wl_output                *output)
+{
+}
+
+static void
+presentation_feedback_presented (void                            *data,
+                                 struct wp_presentation_feedback *feedback,
+                                 uint32_t                         tv_sec_hi,
+                                 uint32_t                         tv_sec_lo,
+                                 uint32_t                         tv_nsec,
+                                 uint32_t                         refresh,
+                                 uint32_t                         seq_hi,
+                                 uint32_t                         seq_lo,
+                                 uint32_t                         flags)
+{
+  PresentationFeedbackData *feedback_data = data;
+  GdkWindow *window = feedback_data->window;
+  GdkWaylandDisplay *display_wayland =
+    GDK_WAYLAND_DISPLAY (gdk_window_get_display (window));
+  GdkFrameClock *clock = gdk_window_get_frame_clock (window);
+  GdkFrameTimings *timings = NULL;
+
+  if (!GDK_WINDOW_DESTROYED (window) && clock != NULL)
+    timings = gdk_frame_clock_get_timings (clock, feedback_data->frame_counter);
+  if (timings)
+    {
+      /* The exact refresh the compositor is running at, which on a
+       * 90Hz panel differs from the 60Hz we'd otherwise assume
+       */
+      if (refresh > 0)
+        timings->refresh_interval = refresh / 1000;
+
+      /* The timestamp is only comparable to our frame times when the
+       * compositor uses the same clock as g_get_monotonic_time()
+       */
+      if (display_wayland->presentation_clock_id == CLOCK_MONOTONIC)
+        timings->presentation_time =
+          ((((gint64) tv_sec_hi << 32) | tv_sec_lo) * G_USEC_PER_SEC) + tv_nsec / 1000;
+
+      timings->complete = TRUE;
+
+#ifdef G_ENABLE_DEBUG
+      if ((_gdk_debug_flags & GDK_DEBUG_FRAMES) != 0)
+        _gdk_frame_clock_debug_print_timings (clock, timings);
+#endif
+    }
+
+  presentation_feedback_free (feedback, feedback_data);
+}
+
+static void
+presentation_feedback_discarded (void                            *data,
+                                 struct wp_presentation_feedback *feedback)
+{
+  PresentationFeedbackData *feedback_data = data;
+
+  GDK_NOTE (FRAMES, g_message ("presentation discarded, frame %" G_GINT64_FORMAT " wasted",
+                               feedback_data->frame_counter));
+
+  presentation_feedback_free (feedback, feedback_data);
+}
+
+static const struct wp_presentation_feedback_listener presentation_feedback_listener = {
+  presentation_feedback_sync_output,
+  presentation_feedback_presented,
+  presentation_feedback_discarded
+};
+
+static void
+request_presentation_feedback (GdkWindow *window)
+{
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+  GdkWaylandDisplay *display_wayland =
+    GDK_WAYLAND_DISPLAY (gdk_window_get_display (window));
+  GdkFrameClock *clock = gdk_window_get_frame_clock (window);
+  struct wp_presentation_feedback *feedback;
+  PresentationFeedbackData *data;
+
+  feedback = wp_presentation_feedback (display_wayland->presentation,
+                                       impl->display_server.wl_surface);
+
+  data = g_new0 (PresentationFeedbackData, 1);
+  data->window = g_object_ref (window);
+  data->frame_counter = gdk_frame_clock_get_frame_counter (clock);
+
+  wp_presentation_feedback_add_listener (feedback,
+                                         &presentation_feedback_listener,
+                                         data);
+  impl->awaiting_presented = TRUE;
+}
+
 static void
 frame_callback (void               *data,
                 struct wl_callback *callback,
@@ -475,6 +596,12 @@ frame_callback (void               *data,
         timings->refresh_interval = G_GINT64_CONSTANT(1000000000) / refresh_rate;
     }
 
+  /* If we asked for presentation feedback, the compositor will tell
+   * us the real presentation time and refresh; don't guess them here
+   */
+  if (impl->awaiting_presented)
+    return;
+
   fill_presentation_time_from_frame_time (timings, time);
 
   timings->complete = TRUE;
@@ -535,9 +662,24 @@ on_frame_clock_after_paint (GdkFrameClock *clock,
   if (window->update_freeze_count > 0)
     return;
 
-  callback = wl_surface_frame (impl->display_server.wl_surface);
-  wl_callback_add_listener (callback, &frame_listener, window);
-  _gdk_frame_clock_freeze (clock);
+  /* Overlay-hinted surfaces (drag icons, tooltips) are presented by
+   * the compositor on whatever plane it sees fit and move with the
+   * pointer, so don't throttle their commits behind frame callbacks;
+   * each update goes out as soon as it is drawn
+   */
+  if (!impl->overlay_hint)
+    {
+      callback = wl_surface_frame (impl->display_server.wl_surface);
+      wl_callback_add_listener (callback, &frame_listener, window);
+      _gdk_frame_clock_freeze (clock);
+
+      /* Ask the compositor when and at which refresh this frame actually
+       * made it to the screen, so paint scheduling follows the display
+       * cadence instead of an assumed 60Hz
+       */
+      if (GDK_WAYLAND_DISPLAY (gdk_window_get_display (window))->presentation)
+        request_presentation_feedback (window);
+    }
 
   /* Before we commit a new buffer, make sure we've backfilled
    * undrawn parts from any old committed buffer
@@ -560,8 +702,12 @@ on_frame_clock_after_paint (GdkFrameClock *clock,
 
   impl->pending_buffer_attached = FALSE;
   impl->pending_commit = FALSE;
-  impl->pending_frame_counter = gdk_frame_clock_get_frame_counter (clock);
-  impl->awaiting_frame = TRUE;
+
+  if (!impl->overlay_hint)
+    {
+      impl->pending_frame_counter = gdk_frame_clock_get_frame_counter (clock);
+      impl->awaiting_frame = TRUE;
+    }
 
   g_signal_emit (impl, signals[COMMITTED], 0);
 }
@@ -834,6 +980,7 @@ static void
 gdk_window_impl_wayland_end_paint (GdkWindow *window)
 {
   GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+  GdkWaylandDisplay *display = GDK_WAYLAND_DISPLAY (gdk_window_get_display (window));
   cairo_rectangle_int_t rect;
   int i, n;
 
@@ -861,11 +1008,23 @@ gdk_window_impl_wayland_end_paint (GdkWindow *window)
             }
         }
 
+      /* Post the damage in buffer coordinates when the compositor
+       * supports it; with surface coordinates the compositor has to
+       * round the damage out to whole surface units, repainting up to
+       * scale² times the changed pixels on hidpi outputs.
+       */
       n = cairo_region_num_rectangles (window->current_paint.region);
       for (i = 0; i < n; i++)
         {
           cairo_region_get_rectangle (window->current_paint.region, i, &rect);
-          wl_surface_damage (impl->display_server.wl_surface, rect.x, rect.y, rect.width, rect.height);
+          if (display->compositor_version >= WL_SURFACE_HAS_DAMAGE_BUFFER)
+            wl_surface_damage_buffer (impl->display_server.wl_surface,
+                                      rect.x * impl->scale,
+                                      rect.y * impl->scale,
+                                      rect.width * impl->scale,
+                                      rect.height * impl->scale);
+          else
+            wl_surface_damage (impl->display_server.wl_surface, rect.x, rect.y, rect.width, rect.height);
         }
 
       impl->pending_commit = TRUE;
@@ -1306,12 +1465,20 @@ gdk_wayland_window_create_surface (GdkWindow *window)
   wl_surface_add_listener (impl->display_server.wl_surface, &surface_listener, window);
 }
 
+/* During interactive resize, relayout only for every Nth configure
+ * event; intermediate ones just accumulate the latest size
+ */
+#define RESIZE_RELAYOUT_INTERVAL 3
+
+/* How long to wait for another configure event before settling on the
+ * accumulated size (roughly one 60Hz frame)
+ */
+#define RESIZE_RELAYOUT_TIMEOUT 17
+
 static void
-xdg_surface_configure (void                   *data,
-                       struct zxdg_surface_v6 *xdg_surface,
-                       uint32_t                serial)
+gdk_wayland_window_apply_configure (GdkWindow *window,
+                                    uint32_t   serial)
 {
-  GdkWindow *window = GDK_WINDOW (data);
   GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
   GdkWindowState new_state;
   int width = impl->pending.width;
@@ -1319,18 +1486,6 @@ xdg_surface_configure (void                   *data,
   gboolean fixed_size;
   gboolean saved_size;
 
-  if (!impl->initial_configure_received)
-    {
-      gdk_window_thaw_updates (window);
-      impl->initial_configure_received = TRUE;
-    }
-
-  if (impl->display_server.xdg_popup)
-    {
-      zxdg_surface_v6_ack_configure (xdg_surface, serial);
-      return;
-    }
-
   new_state = impl->pending.state;
   impl->pending.state = 0;
 
@@ -1385,12 +1540,87 @@ xdg_surface_configure (void                   *data,
                        (new_state & GDK_WINDOW_STATE_TILED) ? " tiled" : ""));
 
   gdk_window_set_state (window, new_state);
-  zxdg_surface_v6_ack_configure (xdg_surface, serial);
+  zxdg_surface_v6_ack_configure (impl->display_server.xdg_surface, serial);
   if (impl->hint != GDK_WINDOW_TYPE_HINT_DIALOG &&
       new_state & GDK_WINDOW_STATE_FOCUSED)
     gdk_wayland_window_update_dialogs (window);
 }
 
+static gboolean
+resize_configure_timeout (gpointer data)
+{
+  GdkWindow *window = data;
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+
+  impl->pending_configure_timeout = 0;
+  impl->resize_configure_count = 0;
+  gdk_wayland_window_apply_configure (window, impl->pending_configure_serial);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+xdg_surface_configure (void                   *data,
+                       struct zxdg_surface_v6 *xdg_surface,
+                       uint32_t                serial)
+{
+  GdkWindow *window = GDK_WINDOW (data);
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+  gboolean resizing;
+
+  if (!impl->initial_configure_received)
+    {
+      gdk_window_thaw_updates (window);
+      impl->initial_configure_received = TRUE;
+    }
+
+  if (impl->display_server.xdg_popup)
+    {
+      zxdg_surface_v6_ack_configure (xdg_surface, serial);
+      return;
+    }
+
+  resizing = impl->pending.resizing;
+  impl->pending.resizing = FALSE;
+
+  /* Interactive resizing performs a full relayout and reallocates the
+   * window buffer for every configure event, which is what makes large
+   * windows trail the pointer.  The compositor keeps presenting the
+   * last committed buffer until we commit one at the new size, so
+   * while only the size is changing we let configures accumulate and
+   * relayout at a throttled rate, acking the configure we apply.
+   * Skipping an ack_configure is allowed; only the latest serial needs
+   * to be acknowledged.
+   */
+  if (resizing &&
+      impl->pending.state == gdk_window_get_state (window))
+    {
+      if ((impl->resize_configure_count++ % RESIZE_RELAYOUT_INTERVAL) != 0)
+        {
+          impl->pending_configure_serial = serial;
+
+          /* Settle on the accumulated size if the stream of configure
+           * events pauses mid-resize
+           */
+          if (impl->pending_configure_timeout == 0)
+            impl->pending_configure_timeout =
+              g_timeout_add (RESIZE_RELAYOUT_TIMEOUT,
+                             resize_configure_timeout, window);
+          return;
+        }
+    }
+  else
+    impl->resize_configure_count = 0;
+
+  if (impl->pending_configure_timeout)
+    {
+      g_source_remove (impl->pending_configure_timeout);
+      impl->pending_configure_timeout = 0;
+    }
+
+  gdk_wayland_window_apply_configure (window, serial);
+}
+
 static const struct zxdg_surface_v6_listener xdg_surface_listener = {
   xdg_surface_configure,
 };
@@ -1421,6 +1651,7 @@ xdg_toplevel_configure (void                    *data,
           impl->pending.state |= GDK_WINDOW_STATE_FOCUSED;
           break;
         case ZXDG_TOPLEVEL_V6_STATE_RESIZING:
+          impl->pending.resizing = TRUE;
           break;
         default:
           /* Unknown state */
@@ -2496,6 +2727,14 @@ gdk_wayland_window_hide_surface (GdkWindow *window)
             impl->initial_configure_received = FALSE;
         }
 
+      if (impl->pending_configure_timeout)
+        {
+          g_source_remove (impl->pending_configure_timeout);
+          impl->pending_configure_timeout = 0;
+        }
+      impl->resize_configure_count = 0;
+      impl->pending.resizing = FALSE;
+
       if (impl->display_server.wl_subsurface)
         unmap_subsurface (window);
 
@@ -3530,6 +3769,18 @@ gdk_wayland_window_set_opaque_region (GdkWindow      *window,
   impl->opaque_region_dirty = TRUE;
 }
 
+static void
+gdk_wayland_window_set_overlay_hint (GdkWindow *window,
+                                     gboolean   overlay_hint)
+{
+  GdkWindowImplWayland *impl = GDK_WINDOW_IMPL_WAYLAND (window->impl);
+
+  if (GDK_WINDOW_DESTROYED (window))
+    return;
+
+  impl->overlay_hint = overlay_hint;
+}
+
 static void
 gdk_wayland_window_set_shadow_width (GdkWindow *window,
                                      int        left,
@@ -3673,6 +3924,7 @@ _gdk_window_impl_wayland_class_init (GdkWindowImplWaylandClass *klass)
   impl_class->drag_begin = _gdk_wayland_window_drag_begin;
   impl_class->get_scale_factor = gdk_wayland_window_get_scale_factor;
   impl_class->set_opaque_region = gdk_wayland_window_set_opaque_region;
+  impl_class->set_overlay_hint = gdk_wayland_window_set_overlay_hint;
   impl_class->set_shadow_width = gdk_wayland_window_set_shadow_width;
   impl_class->show_window_menu = gdk_wayland_window_show_window_menu;
   impl_class->create_gl_context = gdk_wayland_window_create_gl_context;
@@ -40,6 +40,7 @@
 
 #include <cairo.h>
 #include <epoxy/wgl.h>
+#include <dwmapi.h>
 
 G_DEFINE_TYPE (GdkWin32GLContext, gdk_win32_gl_context, GDK_TYPE_GL_CONTEXT)
 
@@ -139,8 +140,15 @@ gdk_win32_gl_context_end_frame (GdkDrawContext *draw_context,
     }
 
   whole_window = (GdkRectangle) { 0, 0, gdk_window_get_width (window), gdk_window_get_height (window) };
-  if (cairo_region_contains_rectangle (painted, &whole_window) == CAIRO_REGION_OVERLAP_IN)
+  if (cairo_region_contains_rectangle (painted, &whole_window) == CAIRO_REGION_OVERLAP_IN ||
+      context_win32->swap_copy ||
+      context_win32->swap_exchange)
     {
+      /* A partial repaint only ends up here when get_damage() could
+       * vouch for the rest of the back buffer, so presenting is always
+       * a plain swap. DWM then flips or copies the buffer as a whole,
+       * which neither tears nor goes through a GDI front buffer copy.
+       */
       SwapBuffers (context_win32->gl_hdc);
     }
   else if (gdk_gl_context_has_framebuffer_blit (context))
@@ -159,29 +167,40 @@ gdk_win32_gl_context_end_frame (GdkDrawContext *draw_context,
       g_warning ("Need to swap whole buffer even thouigh not everything was redrawn. Expect artifacts.");
       SwapBuffers (context_win32->gl_hdc);
     }
+
+  /* When the compositor runs, the swap returns immediately; wait for
+   * the frame to be picked up so that we do not queue up frames
+   * faster than they can be shown.
+   */
+  if (gdk_display_is_composited (GDK_DISPLAY (display)))
+    DwmFlush ();
 }
 
-static void
-gdk_win32_gl_context_begin_frame (GdkDrawContext *draw_context,
-                                  cairo_region_t *update_area)
+static cairo_region_t *
+gdk_win32_gl_context_get_damage (GdkGLContext *context)
 {
-  GdkGLContext *context = GDK_GL_CONTEXT (draw_context);
-  GdkWindow *window;
+  GdkGLContext *shared = gdk_gl_context_get_shared_context (context);
+  GdkWin32GLContext *context_win32 = GDK_WIN32_GL_CONTEXT (shared ? shared : context);
+  GdkWindow *window = gdk_draw_context_get_window (GDK_DRAW_CONTEXT (context));
 
-  GDK_DRAW_CONTEXT_CLASS (gdk_win32_gl_context_parent_class)->begin_frame (draw_context, update_area);
-  if (gdk_gl_context_get_shared_context (context))
-    return;
-
-  if (gdk_gl_context_has_framebuffer_blit (context))
-    return;
+  if (context_win32->swap_copy)
+    {
+      /* SwapBuffers() copies, so the back buffer still holds the frame
+       * that was just presented */
+      return cairo_region_create ();
+    }
+  else if (context_win32->swap_exchange)
+    {
+      /* The buffers were exchanged, so the back buffer holds the frame
+       * before the last one; everything the last frame painted has to
+       * be redrawn on top of the new damage */
+      if (window->old_updated_area[0])
+        return cairo_region_copy (window->old_updated_area[0]);
+    }
 
-  /* If nothing else is known, repaint everything so that the back
-     buffer is fully up-to-date for the swapbuffer */
-  window = gdk_gl_context_get_window (context);
-  cairo_region_union_rectangle (update_area, &(GdkRectangle) {
-                                                 0, 0,
-                                                 gdk_window_get_width (window),
-                                                 gdk_window_get_height (window) });
+  /* Buffer contents after a swap are undefined for this pixel format,
+   * repaint everything */
+  return GDK_GL_CONTEXT_CLASS (gdk_win32_gl_context_parent_class)->get_damage (context);
 }
 
 typedef struct
@@ -640,6 +659,7 @@ gdk_win32_gl_context_realize (GdkGLContext *context,
   /* These are the real WGL context items that we will want to use later */
   HGLRC hglrc;
   gint pixel_format;
+  PIXELFORMATDESCRIPTOR pfd;
   gboolean debug_bit, compat_bit, legacy_bit;
 
   /* request flags and specific versions for core (3.2+) WGL context */
@@ -662,6 +682,17 @@ gdk_win32_gl_context_realize (GdkGLContext *context,
       return FALSE;
     }
 
+  /* Find out how SwapBuffers() treats the back buffer for this pixel
+   * format. With exchange or copy semantics its contents after a swap
+   * are well-defined, which get_damage() exploits to only redraw what
+   * actually changed between frames.
+   */
+  if (DescribePixelFormat (context_win32->gl_hdc, pixel_format, sizeof (pfd), &pfd) != 0)
+    {
+      context_win32->swap_copy = (pfd.dwFlags & PFD_SWAP_COPY) != 0;
+      context_win32->swap_exchange = (pfd.dwFlags & PFD_SWAP_EXCHANGE) != 0;
+    }
+
   gdk_gl_context_get_required_version (context, &glver_major, &glver_minor);
   debug_bit = gdk_gl_context_get_debug_enabled (context);
   compat_bit = gdk_gl_context_get_forward_compatible (context);
@@ -739,8 +770,8 @@ gdk_win32_gl_context_class_init (GdkWin32GLContextClass *klass)
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
 
   gl_context_class->realize = gdk_win32_gl_context_realize;
+  gl_context_class->get_damage = gdk_win32_gl_context_get_damage;
 
-  draw_context_class->begin_frame = gdk_win32_gl_context_begin_frame;
   draw_context_class->end_frame = gdk_win32_gl_context_end_frame;
 
   gobject_class->dispose = _gdk_win32_gl_context_dispose;
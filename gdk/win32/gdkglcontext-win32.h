@@ -43,6 +43,13 @@ struct _GdkWin32GLContext
   /* other items */
   guint is_attached : 1;
   guint do_frame_sync : 1;
+
+  /* SwapBuffers() semantics of the pixel format; when either is set,
+   * the back buffer contents after a swap are well-defined and partial
+   * redraws can be presented with a plain swap
+   */
+  guint swap_copy : 1;
+  guint swap_exchange : 1;
 };
 
 struct _GdkWin32GLContextClass
@@ -72,6 +72,10 @@
 #include <X11/extensions/Xdamage.h>
 #endif
 
+#ifdef HAVE_XPRESENT
+#include <X11/extensions/Xpresent.h>
+#endif
+
 #ifdef HAVE_RANDR
 #include <X11/extensions/Xrandr.h>
 #endif
@@ -176,7 +180,12 @@ static const char *const precache_atoms[] = {
   "_NET_VIRTUAL_ROOTS",
   "GDK_SELECTION",
   "_NET_WM_STATE_FOCUSED",
-  "GDK_VISUALS"
+  "GDK_VISUALS",
+  "_NET_SUPPORTED",
+  "_NET_SUPPORTING_WM_CHECK",
+  "_NET_WORKAREA",
+  "_XSETTINGS_SETTINGS",
+  "MANAGER"
 };
 
 static char *gdk_sm_client_id;
@@ -628,6 +637,53 @@ get_event_xwindow (const XEvent *xevent)
   return xwindow;
 }
 
+#ifdef HAVE_XPRESENT
+static void
+gdk_x11_display_handle_present_event (GdkDisplay   *display,
+                                      const XEvent *xevent)
+{
+  XPresentCompleteNotifyEvent *complete = xevent->xcookie.data;
+  GdkWindow *window;
+  GdkWindowImplX11 *window_impl;
+  GdkFrameClock *clock;
+  GdkFrameTimings *timings;
+  gint64 ust;
+
+  if (xevent->xcookie.evtype != PresentCompleteNotify || complete == NULL)
+    return;
+
+  window = gdk_x11_window_lookup_for_display (display, complete->window);
+  if (window == NULL || GDK_WINDOW_DESTROYED (window))
+    return;
+
+  window_impl = GDK_WINDOW_IMPL_X11 (window->impl);
+
+  clock = gdk_window_get_frame_clock (window);
+  if (clock == NULL)
+    return;
+
+  timings = gdk_frame_clock_get_timings (clock, window_impl->xpresent_frame_counter);
+  if (timings == NULL || timings->complete ||
+      (guint32) timings->frame_counter != complete->serial_number)
+    return;
+
+  /* The UST is in microseconds and, when the server runs on top of DRM,
+   * comes from the same CLOCK_MONOTONIC that g_get_monotonic_time()
+   * reads. Other servers may use a different clock, so sanity-check
+   * against the current time before trusting it.
+   */
+  ust = (gint64) complete->ust;
+  if (ust != 0 && ABS (ust - g_get_monotonic_time ()) < G_USEC_PER_SEC)
+    timings->presentation_time = ust;
+
+  timings->complete = TRUE;
+#ifdef G_ENABLE_DEBUG
+  if (GDK_DISPLAY_DEBUG_CHECK (display, FRAMES))
+    _gdk_frame_clock_debug_print_timings (clock, timings);
+#endif /* G_ENABLE_DEBUG */
+}
+#endif /* HAVE_XPRESENT */
+
 static gboolean
 gdk_x11_display_translate_event (GdkEventTranslator *translator,
                                  GdkDisplay         *display,
@@ -643,6 +699,16 @@ gdk_x11_display_translate_event (GdkEventTranslator *translator,
   GdkX11Display *display_x11 = GDK_X11_DISPLAY (display);
   gboolean return_val;
 
+#ifdef HAVE_XPRESENT
+  if (xevent->type == GenericEvent &&
+      display_x11->have_xpresent &&
+      xevent->xcookie.extension == display_x11->xpresent_opcode)
+    {
+      gdk_x11_display_handle_present_event (display, xevent);
+      return FALSE;
+    }
+#endif
+
   /* Find the GdkWindow that this event relates to. If that's
    * not the same as the window that the event was sent to,
    * we are getting an event from SubstructureNotifyMask.
@@ -1481,13 +1547,12 @@ gdk_x11_display_open (const gchar *display_name)
   }
 #endif
 
-  /* initialize the display's screens */ 
+  /* initialize the display's screens */
   display_x11->screen = _gdk_x11_screen_new (display, DefaultScreen (display_x11->xdisplay), TRUE);
 
-  /* We need to initialize events after we have the screen
-   * structures in places
+  /* XSETTINGS are snapshotted lazily on first access, so there is no
+   * settings manager round trip here
    */
-  _gdk_x11_xsettings_init (GDK_X11_SCREEN (display_x11->screen));
 
   display_x11->device_manager = _gdk_x11_device_manager_new (display);
 
@@ -1515,6 +1580,17 @@ gdk_x11_display_open (const gchar *display_name)
 #endif
     display_x11->have_xfixes = FALSE;
 
+#ifdef HAVE_XPRESENT
+  if (XPresentQueryExtension (display_x11->xdisplay,
+			      &display_x11->xpresent_opcode,
+			      &ignore, &ignore))
+    {
+      display_x11->have_xpresent = TRUE;
+    }
+  else
+#endif
+    display_x11->have_xpresent = FALSE;
+
 #ifdef HAVE_XCOMPOSITE
   if (XCompositeQueryExtension (display_x11->xdisplay,
 				&ignore, &ignore))
@@ -2867,12 +2943,18 @@ gdk_x11_display_get_max_request_size (GdkDisplay *display)
   Display *xdisplay = GDK_DISPLAY_XDISPLAY (display);
   gsize size;
 
+  /* Both functions report the limit in 4-byte units */
   size = XExtendedMaxRequestSize (xdisplay);
   if (size <= 0)
     size = XMaxRequestSize (xdisplay);
-  
-  size = MIN (262144, size - 100);
-  return size;
+
+  /* Convert to bytes, leaving room for the request header.  With
+   * BIG-REQUESTS this allows multi-megabyte selection chunks; cap it
+   * so a single chunk can't pin tens of megabytes in the server.
+   */
+  size = size * 4 - 100;
+
+  return MIN (size, 8 * 1024 * 1024);
 }
 
 /**
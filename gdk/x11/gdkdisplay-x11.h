@@ -71,6 +71,9 @@ struct _GdkX11Display
   gboolean have_xfixes;
   gint xfixes_event_base;
 
+  gboolean have_xpresent;
+  gint xpresent_opcode;
+
   gboolean have_xcomposite;
   gboolean have_xdamage;
   gint xdamage_event_base;
@@ -159,6 +162,7 @@ struct _GdkX11Display
   guint has_glx_texture_from_pixmap : 1;
   guint has_glx_video_sync : 1;
   guint has_glx_buffer_age : 1;
+  guint has_glx_copy_sub_buffer : 1;
   guint has_glx_sync_control : 1;
   guint has_glx_multisample : 1;
   guint has_glx_visual_rating : 1;
@@ -118,6 +118,21 @@ maybe_wait_for_vblank (GdkDisplay  *display,
     }
 }
 
+/* Partial copies only pay off when most of the window stays unchanged;
+ * otherwise a full (and possibly page-flipped) swap is cheaper.
+ */
+static gboolean
+should_copy_sub_buffer (GdkWindow      *window,
+                        cairo_region_t *painted)
+{
+  cairo_rectangle_int_t extents;
+
+  cairo_region_get_extents (painted, &extents);
+
+  return extents.width * extents.height * 2 <
+         gdk_window_get_width (window) * gdk_window_get_height (window);
+}
+
 static void
 gdk_x11_gl_context_end_frame (GdkDrawContext *draw_context,
                               cairo_region_t *painted,
@@ -182,7 +197,35 @@ gdk_x11_gl_context_end_frame (GdkDrawContext *draw_context,
         }
     }
 
-  glXSwapBuffers (dpy, drawable);
+  if (display_x11->has_glx_copy_sub_buffer &&
+      painted != NULL &&
+      should_copy_sub_buffer (window, painted))
+    {
+      int i, n_rects = cairo_region_num_rectangles (painted);
+      cairo_rectangle_int_t rect;
+      int window_scale = gdk_window_get_scale_factor (window->impl_window);
+      int unscaled_window_height;
+
+      gdk_window_get_unscaled_size (window->impl_window, NULL, &unscaled_window_height);
+
+      /* Copy only what we painted to the front buffer, so the server can
+       * skip recompositing the rest of the window. The back buffer is not
+       * touched, so the buffer age reported for the next frame stays valid.
+       */
+      glFlush ();
+
+      for (i = 0; i < n_rects; i++)
+        {
+          cairo_region_get_rectangle (painted, i, &rect);
+          glXCopySubBufferMESA (dpy, drawable,
+                                rect.x * window_scale,
+                                unscaled_window_height - (rect.y + rect.height) * window_scale,
+                                rect.width * window_scale,
+                                rect.height * window_scale);
+        }
+    }
+  else
+    glXSwapBuffers (dpy, drawable);
 
   if (context_x11->do_frame_sync && info != NULL && display_x11->has_glx_video_sync)
     glXGetVideoSyncSGI (&info->last_frame_counter);
@@ -822,6 +865,8 @@ gdk_x11_screen_init_gl (GdkX11Screen *screen)
     epoxy_has_glx_extension (dpy, screen_num, "GLX_SGI_video_sync");
   display_x11->has_glx_buffer_age =
     epoxy_has_glx_extension (dpy, screen_num, "GLX_EXT_buffer_age");
+  display_x11->has_glx_copy_sub_buffer =
+    epoxy_has_glx_extension (dpy, screen_num, "GLX_MESA_copy_sub_buffer");
   display_x11->has_glx_sync_control =
     epoxy_has_glx_extension (dpy, screen_num, "GLX_OML_sync_control");
   display_x11->has_glx_multisample =
@@ -839,6 +884,7 @@ gdk_x11_screen_init_gl (GdkX11Screen *screen)
                        "\t* GLX_EXT_texture_from_pixmap: %s\n"
                        "\t* GLX_SGI_video_sync: %s\n"
                        "\t* GLX_EXT_buffer_age: %s\n"
+                       "\t* GLX_MESA_copy_sub_buffer: %s\n"
                        "\t* GLX_OML_sync_control: %s",
                      display_x11->glx_version / 10,
                      display_x11->glx_version % 10,
@@ -849,6 +895,7 @@ gdk_x11_screen_init_gl (GdkX11Screen *screen)
                      display_x11->has_glx_texture_from_pixmap ? "yes" : "no",
                      display_x11->has_glx_video_sync ? "yes" : "no",
                      display_x11->has_glx_buffer_age ? "yes" : "no",
+                     display_x11->has_glx_copy_sub_buffer ? "yes" : "no",
                      display_x11->has_glx_sync_control ? "yes" : "no"));
 
   return TRUE;
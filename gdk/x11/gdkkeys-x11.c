@@ -177,8 +177,19 @@ update_modmap (Display      *display,
   gint i, j, k;
 
   if (!vmods[0].atom)
-    for (i = 0; vmods[i].name; i++)
-      vmods[i].atom = XInternAtom (display, vmods[i].name, FALSE);
+    {
+      char *names[G_N_ELEMENTS (vmods) - 1];
+      Atom atoms[G_N_ELEMENTS (vmods) - 1];
+
+      /* Intern all the names in a single round trip */
+      for (i = 0; vmods[i].name; i++)
+        names[i] = (char *) vmods[i].name;
+
+      XInternAtoms (display, names, i, FALSE, atoms);
+
+      for (i = 0; vmods[i].name; i++)
+        vmods[i].atom = atoms[i];
+    }
 
   for (i = 0; i < 8; i++)
     keymap_x11->modmap[i] = 1 << i;
@@ -160,7 +160,8 @@ get_current_desktop (GdkX11Screen *screen)
   display = GDK_DISPLAY_XDISPLAY (GDK_SCREEN_DISPLAY (screen));
   win = XRootWindow (display, gdk_x11_screen_get_screen_number (screen));
 
-  current_desktop = XInternAtom (display, "_NET_CURRENT_DESKTOP", True);
+  current_desktop = gdk_x11_get_xatom_by_name_for_display (GDK_SCREEN_DISPLAY (screen),
+                                                           "_NET_CURRENT_DESKTOP");
 
   XGetWindowProperty (display,
                       win,
@@ -197,7 +198,6 @@ gdk_x11_screen_get_work_area (GdkX11Screen *x11_screen,
   Display        *display;
 
   display = GDK_SCREEN_XDISPLAY (x11_screen);
-  workarea = XInternAtom (display, "_NET_WORKAREA", True);
 
   /* Defaults in case of error */
   area->x = 0;
@@ -209,8 +209,8 @@ gdk_x11_screen_get_work_area (GdkX11Screen *x11_screen,
                                             g_intern_static_string ("_NET_WORKAREA")))
     return;
 
-  if (workarea == None)
-    return;
+  workarea = gdk_x11_get_xatom_by_name_for_display (GDK_SCREEN_DISPLAY (x11_screen),
+                                                    "_NET_WORKAREA");
 
   win = XRootWindow (display, gdk_x11_screen_get_screen_number (x11_screen));
   result = XGetWindowProperty (display,
@@ -937,6 +937,8 @@ gdk_x11_screen_get_setting (GdkX11Screen   *x11_screen,
 {
   const GValue *setting;
 
+  _gdk_x11_xsettings_ensure (x11_screen);
+
   if (x11_screen->xsettings == NULL)
     goto out;
   setting = g_hash_table_lookup (x11_screen->xsettings, name);
@@ -72,6 +72,7 @@ struct _GdkX11Screen
   guint xft_init : 1; /* Whether we've intialized these values yet */
   guint xft_antialias : 1;
   guint xft_hinting : 1;
+  guint xsettings_initialized : 1; /* Whether the XSETTINGS snapshot was read */
 
   /* Visual Part */
   gint nvisuals;
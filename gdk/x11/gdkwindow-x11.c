@@ -73,6 +73,10 @@
 #include <X11/extensions/Xdamage.h>
 #endif
 
+#ifdef HAVE_XPRESENT
+#include <X11/extensions/Xpresent.h>
+#endif
+
 const int _gdk_x11_event_mask_table[21] =
 {
   ExposureMask,
@@ -387,6 +391,32 @@ gdk_x11_window_begin_frame (GdkWindow *window,
     }
 }
 
+#ifdef HAVE_XPRESENT
+/* Make sure we receive PresentCompleteNotify for the window, so that
+ * we can fill in real presentation times when the window manager
+ * doesn't speak the _NET_WM_FRAME_DRAWN protocol.
+ */
+static gboolean
+gdk_x11_window_select_present_events (GdkWindow *window)
+{
+  GdkWindowImplX11 *impl = GDK_WINDOW_IMPL_X11 (window->impl);
+  GdkX11Display *display_x11 = GDK_X11_DISPLAY (gdk_window_get_display (window));
+
+  if (!display_x11->have_xpresent)
+    return FALSE;
+
+  if (!impl->xpresent_selected)
+    {
+      XPresentSelectInput (GDK_WINDOW_XDISPLAY (window),
+                           GDK_WINDOW_XID (window),
+                           PresentCompleteNotifyMask);
+      impl->xpresent_selected = TRUE;
+    }
+
+  return TRUE;
+}
+#endif /* HAVE_XPRESENT */
+
 static void
 gdk_x11_window_end_frame (GdkWindow *window)
 {
@@ -456,7 +486,25 @@ gdk_x11_window_end_frame (GdkWindow *window)
     }
 
   if (!impl->toplevel->frame_pending)
-    timings->complete = TRUE;
+    {
+#ifdef HAVE_XPRESENT
+      /* Without a frame-synchronizing window manager we don't get
+       * _NET_WM_FRAME_TIMINGS; ask the Present extension to notify us
+       * at the next vblank instead, which is the earliest our frame
+       * can reach the screen, and complete the timings from that.
+       */
+      if (gdk_x11_window_select_present_events (window))
+        {
+          impl->xpresent_frame_counter = timings->frame_counter;
+          XPresentNotifyMSC (GDK_WINDOW_XDISPLAY (window),
+                             GDK_WINDOW_XID (window),
+                             (guint32) timings->frame_counter,
+                             0, 0, 0);
+        }
+      else
+#endif
+        timings->complete = TRUE;
+    }
 }
 
 /*****************************************************
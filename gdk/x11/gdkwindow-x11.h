@@ -73,6 +73,7 @@ struct _GdkWindowImplX11
   guint frame_clock_connected : 1;
   guint frame_sync_enabled : 1;
   guint tracking_damage: 1;
+  guint xpresent_selected : 1;
 
   gint window_scale;
 
@@ -86,6 +87,11 @@ struct _GdkWindowImplX11
 
   cairo_surface_t *cairo_surface;
 
+  /* Frame counter of the frame we asked XPresent to notify us about,
+   * so that a PresentCompleteNotify can be matched back to its timings.
+   */
+  gint64 xpresent_frame_counter;
+
 #if defined (HAVE_XCOMPOSITE) && defined(HAVE_XDAMAGE) && defined (HAVE_XFIXES)
   Damage damage;
 #endif
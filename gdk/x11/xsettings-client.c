@@ -486,6 +486,8 @@ check_manager_window (GdkX11Screen *x11_screen,
   display = x11_screen->display;
   xdisplay = gdk_x11_display_get_xdisplay (display);
 
+  x11_screen->xsettings_initialized = TRUE;
+
   gdk_x11_display_grab (display);
 
   x11_screen->xsettings_manager_window = XGetSelectionOwner (xdisplay, get_selection_atom (x11_screen));
@@ -549,15 +551,26 @@ gdk_xsettings_manager_window_filter (const XEvent *xev,
 }
 
 void
-_gdk_x11_xsettings_init (GdkX11Screen *x11_screen)
+_gdk_x11_xsettings_ensure (GdkX11Screen *x11_screen)
 {
+  /* Settings are snapshotted in one batched property read the first
+   * time anything asks for one, so opening the display stays free of
+   * XSETTINGS round trips.  Later changes still arrive asynchronously
+   * through the manager window filters.
+   */
+  if (x11_screen->xsettings_initialized)
+    return;
+
   check_manager_window (x11_screen, FALSE);
 }
 
 void
 _gdk_x11_settings_force_reread (GdkX11Screen *x11_screen)
 {
-  read_settings (x11_screen, TRUE);
+  if (!x11_screen->xsettings_initialized)
+    _gdk_x11_xsettings_ensure (x11_screen);
+  else
+    read_settings (x11_screen, TRUE);
 }
 
 void
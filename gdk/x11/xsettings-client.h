@@ -26,7 +26,7 @@
 #include <gdk/x11/gdkprivate-x11.h>
 #include <gdk/x11/gdkx11screen.h>
 
-void _gdk_x11_xsettings_init            (GdkX11Screen        *x11_screen);
+void _gdk_x11_xsettings_ensure          (GdkX11Screen        *x11_screen);
 void _gdk_x11_xsettings_finish          (GdkX11Screen        *x11_screen);
 void _gdk_x11_settings_force_reread     (GdkX11Screen        *x11_screen);
 
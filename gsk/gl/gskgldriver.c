@@ -5,6 +5,7 @@
 #include "gskdebugprivate.h"
 #include "gskprofilerprivate.h"
 #include "gdk/gdktextureprivate.h"
+#include "gdk/gdkglcontextprivate.h"
 
 #include <gdk/gdk.h>
 #include <epoxy/gl.h>
@@ -12,6 +13,8 @@
  typedef struct {
   GLuint fbo_id;
   GLuint depth_stencil_id;
+  guint has_depth : 1;
+  guint has_stencil : 1;
 } Fbo;
 
 typedef struct {
@@ -22,10 +25,37 @@ typedef struct {
   GLuint mag_filter;
   Fbo fbo;
   GdkTexture *user;
+  gsize user_serial;            /* last uploaded GdkMemoryTexture serial */
   guint in_use : 1;
   guint permanent : 1;
 } Texture;
 
+/* Small textures get packed into shared atlas pages so runs of icons
+ * can be drawn from one bound texture instead of causing a bind per
+ * image.
+ */
+#define GSK_GL_TEXTURE_ATLAS_SIZE               2048
+#define GSK_GL_TEXTURE_ATLAS_MAX_ENTRY_SIZE     128
+#define GSK_GL_TEXTURE_ATLAS_PADDING            1
+
+typedef struct {
+  int texture_id;
+  int width;
+  int height;
+
+  /* Shelf allocator state */
+  int x;
+  int y;
+  int row_height;
+} TextureAtlas;
+
+typedef struct {
+  GskGLDriver *driver;
+  GdkTexture *user;
+  int texture_id;
+  graphene_rect_t region;       /* in texture coordinates */
+} AtlasEntry;
+
 struct _GskGLDriver
 {
   GObject parent_instance;
@@ -42,10 +72,14 @@ struct _GskGLDriver
 
   GHashTable *textures;
 
+  GPtrArray *atlases;
+  GHashTable *atlas_entries;
+
   const Texture *bound_source_texture;
   const Fbo *bound_fbo;
 
   int max_texture_size;
+  int use_texture_compression;
 
   gboolean in_frame : 1;
 };
@@ -87,9 +121,22 @@ static void
 gsk_gl_driver_finalize (GObject *gobject)
 {
   GskGLDriver *self = GSK_GL_DRIVER (gobject);
+  GHashTableIter iter;
+  gpointer key, value;
 
   gdk_gl_context_make_current (self->gl_context);
 
+  g_hash_table_iter_init (&iter, self->atlas_entries);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      AtlasEntry *entry = value;
+
+      entry->driver = NULL;
+      gdk_texture_clear_render_data (key);
+    }
+  g_clear_pointer (&self->atlas_entries, g_hash_table_unref);
+  g_clear_pointer (&self->atlases, g_ptr_array_unref);
+
   g_clear_pointer (&self->textures, g_hash_table_unref);
   g_clear_object (&self->profiler);
 
@@ -112,7 +159,11 @@ gsk_gl_driver_init (GskGLDriver *self)
 {
   self->textures = g_hash_table_new_full (NULL, NULL, NULL, texture_free);
 
+  self->atlases = g_ptr_array_new_with_free_func (g_free);
+  self->atlas_entries = g_hash_table_new (NULL, NULL);
+
   self->max_texture_size = -1;
+  self->use_texture_compression = -1;
 
 #ifdef G_ENABLE_DEBUG
   self->profiler = gsk_profiler_new ();
@@ -226,13 +277,11 @@ gsk_gl_driver_collect_textures (GskGLDriver *driver)
 
       if (t->in_use)
         {
+          /* Keep the render target attached to the texture, so reusing
+           * the texture next frame also recycles the FBO instead of
+           * setting up a new one.
+           */
           t->in_use = FALSE;
-
-          if (t->fbo.fbo_id != 0)
-            {
-              fbo_clear (&t->fbo);
-              t->fbo.fbo_id = 0;
-            }
         }
       else
         g_hash_table_iter_remove (&iter);
@@ -361,43 +410,490 @@ gsk_gl_driver_release_texture (gpointer data)
   t->user = NULL;
 }
 
+static gboolean
+filter_uses_mipmaps (int filter)
+{
+  return filter == GL_NEAREST_MIPMAP_NEAREST ||
+         filter == GL_NEAREST_MIPMAP_LINEAR ||
+         filter == GL_LINEAR_MIPMAP_NEAREST ||
+         filter == GL_LINEAR_MIPMAP_LINEAR;
+}
+
+/* Consumes @surface. Halves repeatedly instead of scaling in one step
+ * so every output pixel still averages the whole source area it covers.
+ */
+static cairo_surface_t *
+downscale_surface (cairo_surface_t *surface,
+                   int              width,
+                   int              height,
+                   int              target_width,
+                   int              target_height)
+{
+  while (width > target_width || height > target_height)
+    {
+      const int next_width = MAX (width / 2, target_width);
+      const int next_height = MAX (height / 2, target_height);
+      cairo_surface_t *scaled;
+      cairo_t *cr;
+
+      scaled = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, next_width, next_height);
+      cr = cairo_create (scaled);
+      cairo_scale (cr, (double) next_width / width, (double) next_height / height);
+      cairo_set_source_surface (cr, surface, 0, 0);
+      cairo_pattern_set_filter (cairo_get_source (cr), CAIRO_FILTER_BILINEAR);
+      cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+      cairo_paint (cr);
+      cairo_destroy (cr);
+
+      cairo_surface_destroy (surface);
+      surface = scaled;
+      width = next_width;
+      height = next_height;
+    }
+
+  return surface;
+}
+
+static void
+gsk_gl_driver_set_texture_parameters (GskGLDriver *driver,
+                                      int          min_filter,
+                                      int          mag_filter)
+{
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+/* Optional driver-side compression of application textures. DXT5 is
+ * the only format GL drivers can encode on the fly; BC7 or ASTC data
+ * would have to come out of an external encoder. The compression is
+ * lossy and shows on smooth gradients, so it is opt-in via
+ * GSK_TEXTURE_COMPRESSION; in exchange it cuts the texture memory and
+ * sampling bandwidth of never-changing imagery to a quarter.
+ */
+static gboolean
+gsk_gl_driver_use_texture_compression (GskGLDriver *self)
+{
+  if (self->use_texture_compression < 0)
+    self->use_texture_compression =
+      g_getenv ("GSK_TEXTURE_COMPRESSION") != NULL &&
+      !gdk_gl_context_get_use_es (self->gl_context) &&
+      epoxy_has_gl_extension ("GL_EXT_texture_compression_s3tc");
+
+  return self->use_texture_compression;
+}
+
+static void
+gsk_gl_driver_init_texture_with_surface_compressed (GskGLDriver     *self,
+                                                    Texture         *t,
+                                                    cairo_surface_t *surface,
+                                                    int              min_filter,
+                                                    int              mag_filter)
+{
+  gsk_gl_driver_set_texture_parameters (self, min_filter, mag_filter);
+
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, cairo_image_surface_get_stride (surface) / 4);
+  glTexImage2D (GL_TEXTURE_2D, 0, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+                t->width, t->height, 0,
+                GL_BGRA, GL_UNSIGNED_BYTE,
+                cairo_image_surface_get_data (surface));
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+
+#ifdef G_ENABLE_DEBUG
+  gsk_profiler_counter_inc (self->profiler, self->counters.surface_uploads);
+#endif
+
+  t->min_filter = min_filter;
+  t->mag_filter = mag_filter;
+
+  if (filter_uses_mipmaps (t->min_filter))
+    glGenerateMipmap (GL_TEXTURE_2D);
+}
+
+/* Only called on desktop GL: the sub-image upload uses GL_BGRA and
+ * GL_UNPACK_ROW_LENGTH
+ */
+static void
+gsk_gl_driver_update_memory_texture (GskGLDriver      *driver,
+                                     Texture          *t,
+                                     GdkMemoryTexture *memory)
+{
+  const gsize serial = gdk_memory_texture_get_serial (memory);
+  const guchar *data;
+  gsize stride;
+  cairo_region_t *diff;
+  int i, n;
+
+  if (t->user_serial == serial)
+    return;
+
+  data = g_bytes_get_data (gdk_memory_texture_get_bytes (memory), NULL);
+  stride = gdk_memory_texture_get_stride (memory);
+
+  gsk_gl_driver_bind_source_texture (driver, t->texture_id);
+
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, stride / 4);
+
+  diff = gdk_memory_texture_get_diff (memory, t->user_serial);
+  if (diff)
+    {
+      n = cairo_region_num_rectangles (diff);
+      for (i = 0; i < n; i++)
+        {
+          cairo_rectangle_int_t rect;
+
+          cairo_region_get_rectangle (diff, i, &rect);
+          glTexSubImage2D (GL_TEXTURE_2D, 0, rect.x, rect.y,
+                           rect.width, rect.height,
+                           GL_BGRA, GL_UNSIGNED_BYTE,
+                           data + rect.y * stride + rect.x * 4);
+        }
+      cairo_region_destroy (diff);
+    }
+  else
+    {
+      /* The dirty history does not reach back to what we have */
+      glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0,
+                       t->width, t->height,
+                       GL_BGRA, GL_UNSIGNED_BYTE,
+                       data);
+    }
+
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+
+  if (filter_uses_mipmaps (t->min_filter))
+    glGenerateMipmap (GL_TEXTURE_2D);
+
+  t->user_serial = serial;
+}
+
 int
 gsk_gl_driver_get_texture_for_texture (GskGLDriver *driver,
                                        GdkTexture  *texture,
                                        int          min_filter,
-                                       int          mag_filter)
+                                       int          mag_filter,
+                                       int          draw_width,
+                                       int          draw_height)
 {
   Texture *t;
   cairo_surface_t *surface;
+  int width, height;
+  int lod_width, lod_height;
 
   if (GDK_IS_GL_TEXTURE (texture))
     return gdk_gl_texture_get_id (GDK_GL_TEXTURE (texture));
 
+  if (GDK_IS_DMABUF_TEXTURE (texture))
+    {
+      guint texture_id;
+
+      /* Zero-copy: sample the dmabuf directly instead of downloading
+       * and re-uploading it. When the context cannot import dmabufs
+       * we fall through to the download path below. The imported
+       * texture keeps its own filters, as the GL texture path does.
+       */
+      t = gdk_texture_get_render_data (texture, driver);
+      if (t)
+        return t->texture_id;
+
+      texture_id = gdk_gl_context_import_dmabuf_texture (driver->gl_context,
+                                                         GDK_DMABUF_TEXTURE (texture));
+      if (texture_id != 0)
+        {
+          t = texture_new ();
+          t->texture_id = texture_id;
+          t->width = gdk_texture_get_width (texture);
+          t->height = gdk_texture_get_height (texture);
+          t->min_filter = GL_LINEAR;
+          t->mag_filter = GL_LINEAR;
+          t->in_use = TRUE;
+          g_hash_table_insert (driver->textures, GINT_TO_POINTER (texture_id), t);
+
+          if (gdk_texture_set_render_data (texture, driver, t, gsk_gl_driver_release_texture))
+            t->user = texture;
+
+          return t->texture_id;
+        }
+    }
+
+  if (GDK_IS_MEMORY_TEXTURE (texture))
+    {
+      t = gdk_texture_get_render_data (texture, driver);
+      if (t && t->min_filter == min_filter && t->mag_filter == mag_filter)
+        {
+          GdkMemoryTexture *memory = GDK_MEMORY_TEXTURE (texture);
+
+          if (!gdk_gl_context_get_use_es (driver->gl_context))
+            {
+              gsk_gl_driver_update_memory_texture (driver, t, memory);
+              return t->texture_id;
+            }
+
+          if (t->user_serial == gdk_memory_texture_get_serial (memory))
+            return t->texture_id;
+
+          /* GLES can't do the GL_BGRA sub-image upload; re-upload
+           * everything below
+           */
+          gdk_texture_clear_render_data (texture);
+        }
+    }
+
+  width = lod_width = gdk_texture_get_width (texture);
+  height = lod_height = gdk_texture_get_height (texture);
+
+  /* Strongly minified draws only ever sample the lower mipmap levels,
+   * so don't upload detail that can never reach the screen: halve the
+   * image down to within one octave of the draw size and let
+   * glGenerateMipmap() build the rest of the chain from that.
+   */
+  if (filter_uses_mipmaps (min_filter) && draw_width > 0 && draw_height > 0 &&
+      !GDK_IS_MEMORY_TEXTURE (texture))
+    {
+      while (lod_width / 2 >= 2 * draw_width && lod_height / 2 >= 2 * draw_height)
+        {
+          lod_width /= 2;
+          lod_height /= 2;
+        }
+    }
+
   t = gdk_texture_get_render_data (texture, driver);
 
   if (t)
     {
-      if (t->min_filter == min_filter && t->mag_filter == mag_filter)
+      if (t->min_filter == min_filter && t->mag_filter == mag_filter &&
+          t->width >= lod_width && t->height >= lod_height)
         return t->texture_id;
+
+      /* Cached with other filters or at a lower resolution than this
+       * draw needs; drop it so the upload below can take its place.
+       */
+      gdk_texture_clear_render_data (texture);
     }
 
-  t = create_texture (driver, gdk_texture_get_width (texture), gdk_texture_get_height (texture));
+  t = create_texture (driver, lod_width, lod_height);
 
   if (gdk_texture_set_render_data (texture, driver, t, gsk_gl_driver_release_texture))
     t->user = texture;
 
   surface = gdk_texture_download_surface (texture);
+  if (lod_width < width || lod_height < height)
+    surface = downscale_surface (surface, width, height, lod_width, lod_height);
   gsk_gl_driver_bind_source_texture (driver, t->texture_id);
-  gsk_gl_driver_init_texture_with_surface (driver,
-                                           t->texture_id,
-                                           surface,
-                                           min_filter,
-                                           mag_filter);
+
+  /* Memory textures are excluded: their update path patches the
+   * texture with sub-image uploads, which compressed formats cannot
+   * do block-for-block.
+   */
+  if (!GDK_IS_MEMORY_TEXTURE (texture) &&
+      gsk_gl_driver_use_texture_compression (driver))
+    gsk_gl_driver_init_texture_with_surface_compressed (driver, t, surface,
+                                                        min_filter, mag_filter);
+  else
+    gsk_gl_driver_init_texture_with_surface (driver,
+                                             t->texture_id,
+                                             surface,
+                                             min_filter,
+                                             mag_filter);
   cairo_surface_destroy (surface);
 
+  if (GDK_IS_MEMORY_TEXTURE (texture))
+    t->user_serial = gdk_memory_texture_get_serial (GDK_MEMORY_TEXTURE (texture));
+
   return t->texture_id;
 }
 
+static gboolean
+texture_atlas_allocate (TextureAtlas *atlas,
+                        int           width,
+                        int           height,
+                        int          *out_x,
+                        int          *out_y)
+{
+  if (atlas->x + width + GSK_GL_TEXTURE_ATLAS_PADDING > atlas->width)
+    {
+      atlas->x = 0;
+      atlas->y += atlas->row_height + GSK_GL_TEXTURE_ATLAS_PADDING;
+      atlas->row_height = 0;
+    }
+
+  if (atlas->y + height + GSK_GL_TEXTURE_ATLAS_PADDING > atlas->height)
+    return FALSE;
+
+  *out_x = atlas->x;
+  *out_y = atlas->y;
+
+  atlas->x += width + GSK_GL_TEXTURE_ATLAS_PADDING;
+  atlas->row_height = MAX (atlas->row_height, height);
+
+  return TRUE;
+}
+
+static void
+texture_atlas_upload (GskGLDriver  *self,
+                      TextureAtlas *atlas,
+                      int           x,
+                      int           y,
+                      GdkTexture   *texture)
+{
+  cairo_surface_t *surface = gdk_texture_download_surface (texture);
+
+  gsk_gl_driver_bind_source_texture (self, atlas->texture_id);
+
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, cairo_image_surface_get_stride (surface) / 4);
+  glTexSubImage2D (GL_TEXTURE_2D, 0, x, y,
+                   gdk_texture_get_width (texture),
+                   gdk_texture_get_height (texture),
+                   GL_BGRA, GL_UNSIGNED_BYTE,
+                   cairo_image_surface_get_data (surface));
+  glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+
+  cairo_surface_destroy (surface);
+
+#ifdef G_ENABLE_DEBUG
+  gsk_profiler_counter_inc (self->profiler, self->counters.surface_uploads);
+#endif
+}
+
+static void
+atlas_entry_release (gpointer data)
+{
+  AtlasEntry *entry = data;
+
+  if (entry->driver != NULL)
+    g_hash_table_remove (entry->driver->atlas_entries, entry->user);
+
+  g_free (entry);
+}
+
+/*
+ * gsk_gl_driver_get_texture_atlas_region:
+ * @driver: a #GskGLDriver
+ * @texture: the #GdkTexture to look up
+ * @min_filter: the minification filter the caller wants to use
+ * @mag_filter: the magnification filter the caller wants to use
+ * @out_region: return location for the sub-rect inside the atlas,
+ *     in texture coordinates
+ *
+ * Looks up (uploading on the first use) @texture in the driver's
+ * texture atlases. Returns the GL texture id of the atlas page the
+ * texture lives on, so consecutive draws of atlased textures can
+ * share one texture binding.
+ *
+ * Returns: the atlas texture id, or -1 if @texture is not eligible
+ *     for atlasing and should be uploaded as its own texture
+ */
+int
+gsk_gl_driver_get_texture_atlas_region (GskGLDriver     *driver,
+                                        GdkTexture      *texture,
+                                        int              min_filter,
+                                        int              mag_filter,
+                                        graphene_rect_t *out_region)
+{
+  AtlasEntry *entry;
+  TextureAtlas *atlas = NULL;
+  int width, height, x = 0, y = 0;
+  guint i;
+
+  g_return_val_if_fail (GSK_IS_GL_DRIVER (driver), -1);
+  g_return_val_if_fail (driver->in_frame, -1);
+
+  if (GDK_IS_GL_TEXTURE (texture))
+    return -1;
+
+  /* Updatable textures need their own GL texture so sub-image
+   * uploads can reach them
+   */
+  if (GDK_IS_MEMORY_TEXTURE (texture))
+    return -1;
+
+  /* All entries on a page share one set of sampler parameters */
+  if (min_filter != GL_NEAREST || mag_filter != GL_NEAREST)
+    return -1;
+
+  /* The sub-image upload below uses GL_BGRA */
+  if (gdk_gl_context_get_use_es (driver->gl_context))
+    return -1;
+
+  entry = gdk_texture_get_render_data (texture, driver->atlas_entries);
+  if (entry != NULL)
+    {
+      *out_region = entry->region;
+      return entry->texture_id;
+    }
+
+  width = gdk_texture_get_width (texture);
+  height = gdk_texture_get_height (texture);
+
+  if (width > GSK_GL_TEXTURE_ATLAS_MAX_ENTRY_SIZE ||
+      height > GSK_GL_TEXTURE_ATLAS_MAX_ENTRY_SIZE)
+    return -1;
+
+  for (i = 0; i < driver->atlases->len; i++)
+    {
+      TextureAtlas *candidate = g_ptr_array_index (driver->atlases, i);
+
+      if (texture_atlas_allocate (candidate, width, height, &x, &y))
+        {
+          atlas = candidate;
+          break;
+        }
+    }
+
+  if (atlas == NULL)
+    {
+      int size = MIN (GSK_GL_TEXTURE_ATLAS_SIZE,
+                      gsk_gl_driver_get_max_texture_size (driver));
+
+      atlas = g_new0 (TextureAtlas, 1);
+      atlas->width = size;
+      atlas->height = size;
+      atlas->texture_id = gsk_gl_driver_create_permanent_texture (driver, size, size);
+
+      gsk_gl_driver_bind_source_texture (driver, atlas->texture_id);
+      gsk_gl_driver_init_texture_empty (driver, atlas->texture_id);
+
+      g_ptr_array_add (driver->atlases, atlas);
+
+      GSK_NOTE (OPENGL, g_message ("Created texture atlas %d (%dx%d)",
+                                 atlas->texture_id, size, size));
+
+      if (!texture_atlas_allocate (atlas, width, height, &x, &y))
+        return -1;
+    }
+
+  texture_atlas_upload (driver, atlas, x, y, texture);
+
+  entry = g_new0 (AtlasEntry, 1);
+  entry->driver = driver;
+  entry->user = texture;
+  entry->texture_id = atlas->texture_id;
+  graphene_rect_init (&entry->region,
+                      (float) x / atlas->width,
+                      (float) y / atlas->height,
+                      (float) width / atlas->width,
+                      (float) height / atlas->height);
+
+  *out_region = entry->region;
+
+  if (gdk_texture_set_render_data (texture, driver->atlas_entries, entry, atlas_entry_release))
+    {
+      g_hash_table_insert (driver->atlas_entries, texture, entry);
+      return entry->texture_id;
+    }
+  else
+    {
+      /* Render data slot already taken; the region stays valid for
+       * this frame but won't be found again.
+       */
+      int texture_id = entry->texture_id;
+      g_free (entry);
+      return texture_id;
+    }
+}
+
 int
 gsk_gl_driver_create_permanent_texture (GskGLDriver *self,
                                         float        width,
@@ -444,7 +940,21 @@ gsk_gl_driver_create_render_target (GskGLDriver *driver,
     return -1;
 
   if (t->fbo.fbo_id != 0)
-    fbo_clear (&t->fbo);
+    {
+      /* The texture already carries a render target from an earlier
+       * use; recycle it if the requested attachments match.
+       */
+      if (t->fbo.has_depth == (add_depth_buffer != FALSE) &&
+          t->fbo.has_stencil == (add_stencil_buffer != FALSE))
+        {
+          GSK_NOTE (OPENGL, g_message ("Reusing FBO(%d) for Texture(%d)",
+                                     t->fbo.fbo_id, t->texture_id));
+          return t->fbo.fbo_id;
+        }
+
+      fbo_clear (&t->fbo);
+      t->fbo.fbo_id = 0;
+    }
 
   glGenFramebuffers (1, &fbo_id);
   glBindFramebuffer (GL_FRAMEBUFFER, fbo_id);
@@ -475,6 +985,8 @@ gsk_gl_driver_create_render_target (GskGLDriver *driver,
 
   t->fbo.fbo_id = fbo_id;
   t->fbo.depth_stencil_id = depth_stencil_buffer_id;
+  t->fbo.has_depth = add_depth_buffer != FALSE;
+  t->fbo.has_stencil = add_stencil_buffer != FALSE;
 
   g_assert_cmpint (glCheckFramebufferStatus (GL_FRAMEBUFFER), ==, GL_FRAMEBUFFER_COMPLETE);
   glBindFramebuffer (GL_FRAMEBUFFER, driver->default_fbo.fbo_id);
@@ -553,18 +1065,6 @@ gsk_gl_driver_destroy_texture (GskGLDriver *driver,
   g_hash_table_remove (driver->textures, GINT_TO_POINTER (texture_id));
 }
 
-static void
-gsk_gl_driver_set_texture_parameters (GskGLDriver *driver,
-                                      int          min_filter,
-                                      int          mag_filter)
-{
-  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
-  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
-
-  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-}
-
 void
 gsk_gl_driver_init_texture_empty (GskGLDriver *driver,
                                   int          texture_id)
@@ -631,6 +1131,6 @@ gsk_gl_driver_init_texture_with_surface (GskGLDriver     *self,
   t->min_filter = min_filter;
   t->mag_filter = mag_filter;
 
-  if (t->min_filter != GL_NEAREST)
+  if (filter_uses_mipmaps (t->min_filter))
     glGenerateMipmap (GL_TEXTURE_2D);
 }
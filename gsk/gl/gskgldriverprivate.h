@@ -26,7 +26,14 @@ void            gsk_gl_driver_end_frame                 (GskGLDriver     *driver
 int             gsk_gl_driver_get_texture_for_texture   (GskGLDriver     *driver,
                                                          GdkTexture      *texture,
                                                          int              min_filter,
-                                                         int              mag_filter);
+                                                         int              mag_filter,
+                                                         int              draw_width,
+                                                         int              draw_height);
+int             gsk_gl_driver_get_texture_atlas_region  (GskGLDriver     *driver,
+                                                         GdkTexture      *texture,
+                                                         int              min_filter,
+                                                         int              mag_filter,
+                                                         graphene_rect_t *out_region);
 int             gsk_gl_driver_create_permanent_texture  (GskGLDriver     *driver,
                                                          float            width,
                                                          float            height);
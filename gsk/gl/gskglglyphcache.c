@@ -3,6 +3,7 @@
 #include "gskglglyphcacheprivate.h"
 #include "gskgldriverprivate.h"
 #include "gskdebugprivate.h"
+#include "gskglyphcachesharedprivate.h"
 #include "gskprivate.h"
 
 #include <graphene.h>
@@ -16,11 +17,19 @@
  * count of the pixels of each atlas that are taken up by old glyphs. We check the
  * fraction of old pixels every CHECK_INTERVAL frames, and if it is above MAX_OLD, then
  * we drop the atlas an all the glyphs contained in it from the cache.
+ *
+ * Glyphs that have not been used for EVICT_AGE frames get their cache
+ * entry removed entirely (their pixels stay counted as old until their
+ * atlas goes away), so the hash table does not grow without bound when
+ * text cycles through many glyphs. When an atlas is dropped, glyphs in
+ * it that are still in use are re-added to the remaining atlases
+ * instead of being thrown away, compacting the live set.
  */
 
 #define MAX_AGE 60
 #define CHECK_INTERVAL 10
 #define MAX_OLD 0.333
+#define EVICT_AGE 600
 
 #define ATLAS_SIZE 512
 
@@ -29,6 +38,7 @@ typedef struct
   PangoFont *font;
   PangoGlyph glyph;
   guint scale; /* times 1024 */
+  guint xshift; /* quarter pixels, 0 - 3 */
 } GlyphCacheKey;
 
 typedef struct
@@ -120,7 +130,8 @@ glyph_cache_equal (gconstpointer v1, gconstpointer v2)
 
   return key1->font == key2->font &&
          key1->glyph == key2->glyph &&
-         key1->scale == key2->scale;
+         key1->scale == key2->scale &&
+         key1->xshift == key2->xshift;
 }
 
 static guint
@@ -128,7 +139,7 @@ glyph_cache_hash (gconstpointer v)
 {
   const GlyphCacheKey *key = v;
 
-  return GPOINTER_TO_UINT (key->font) ^ key->glyph ^ key->scale;
+  return GPOINTER_TO_UINT (key->font) ^ key->glyph ^ key->scale ^ (key->xshift << 24);
 }
 
 static void
@@ -249,29 +260,42 @@ render_glyph (const GskGLGlyphAtlas *atlas,
   if (G_UNLIKELY (!scaled_font || cairo_scaled_font_status (scaled_font) != CAIRO_STATUS_SUCCESS))
     return;
 
-  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
-                                        value->draw_width * key->scale / 1024,
-                                        value->draw_height * key->scale / 1024);
-  cairo_surface_set_device_scale (surface, key->scale / 1024.0, key->scale / 1024.0);
-
-  cr = cairo_create (surface);
-
-  cairo_set_scaled_font (cr, scaled_font);
-  cairo_set_source_rgba (cr, 1, 1, 1, 1);
-
-  glyph_info.glyph = key->glyph;
-  glyph_info.geometry.width = value->draw_width * 1024;
-  if (key->glyph & PANGO_GLYPH_UNKNOWN_FLAG)
-    glyph_info.geometry.x_offset = 0;
-  else
-    glyph_info.geometry.x_offset = - value->draw_x * 1024;
-  glyph_info.geometry.y_offset = - value->draw_y * 1024;
-
-  glyph_string.num_glyphs = 1;
-  glyph_string.glyphs = &glyph_info;
-
-  pango_cairo_show_glyph_string (cr, key->font, &glyph_string);
-  cairo_destroy (cr);
+  /* Some other process may have rasterized this glyph already */
+  surface = gsk_glyph_cache_shared_lookup (key->font, key->glyph,
+                                           key->scale, key->xshift,
+                                           value->draw_width * key->scale / 1024,
+                                           value->draw_height * key->scale / 1024);
+  if (surface == NULL)
+    {
+      surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                            value->draw_width * key->scale / 1024,
+                                            value->draw_height * key->scale / 1024);
+      cairo_surface_set_device_scale (surface, key->scale / 1024.0, key->scale / 1024.0);
+
+      cr = cairo_create (surface);
+
+      cairo_set_scaled_font (cr, scaled_font);
+      cairo_set_source_rgba (cr, 1, 1, 1, 1);
+
+      glyph_info.glyph = key->glyph;
+      glyph_info.geometry.width = value->draw_width * 1024;
+      if (key->glyph & PANGO_GLYPH_UNKNOWN_FLAG)
+        glyph_info.geometry.x_offset = 0;
+      else
+        glyph_info.geometry.x_offset = - value->draw_x * 1024;
+      glyph_info.geometry.x_offset += key->xshift * 256;
+      glyph_info.geometry.y_offset = - value->draw_y * 1024;
+
+      glyph_string.num_glyphs = 1;
+      glyph_string.glyphs = &glyph_info;
+
+      pango_cairo_show_glyph_string (cr, key->font, &glyph_string);
+      cairo_destroy (cr);
+
+      gsk_glyph_cache_shared_store (key->font, key->glyph,
+                                    key->scale, key->xshift,
+                                    surface);
+    }
 
   glyph->surface = surface;
 
@@ -313,7 +337,8 @@ gsk_gl_glyph_cache_lookup (GskGLGlyphCache *cache,
                            gboolean         create,
                            PangoFont       *font,
                            PangoGlyph       glyph,
-                           float            scale)
+                           float            scale,
+                           guint            xshift)
 {
   GlyphCacheKey lookup_key;
   GskGLCachedGlyph *value;
@@ -321,6 +346,7 @@ gsk_gl_glyph_cache_lookup (GskGLGlyphCache *cache,
   lookup_key.font = font;
   lookup_key.glyph = glyph;
   lookup_key.scale = (guint)(scale * 1024);
+  lookup_key.xshift = xshift;
 
   value = g_hash_table_lookup (cache->hash_table, &lookup_key);
 
@@ -348,6 +374,10 @@ gsk_gl_glyph_cache_lookup (GskGLGlyphCache *cache,
       pango_font_get_glyph_extents (font, glyph, &ink_rect, NULL);
       pango_extents_to_pixels (&ink_rect, NULL);
 
+      /* The subpixel shift can spill into one extra pixel on the right */
+      if (xshift != 0 && ink_rect.width > 0)
+        ink_rect.width += 1;
+
       value->draw_x = ink_rect.x;
       value->draw_y = ink_rect.y;
       value->draw_width = ink_rect.width;
@@ -358,6 +388,7 @@ gsk_gl_glyph_cache_lookup (GskGLGlyphCache *cache,
       key->font = g_object_ref (font);
       key->glyph = glyph;
       key->scale = (guint)(scale * 1024);
+      key->xshift = xshift;
 
       if (ink_rect.width > 0 && ink_rect.height > 0)
         add_to_cache (cache, key, value);
@@ -383,12 +414,35 @@ gsk_gl_glyph_cache_get_glyph_image (GskGLGlyphCache *self,
       gsk_gl_image_create (atlas->image, self->gl_driver, atlas->width, atlas->height);
     }
 
-  if (atlas->dirty_glyphs)
-    upload_dirty_glyphs (self, atlas);
+  /* Dirty glyphs are uploaded in one go by gsk_gl_glyph_cache_upload_dirty
+   * before the render ops get executed.
+   */
 
   return atlas->image;
 }
 
+void
+gsk_gl_glyph_cache_upload_dirty (GskGLGlyphCache *self)
+{
+  guint i;
+
+  for (i = 0; i < self->atlases->len; i++)
+    {
+      GskGLGlyphAtlas *atlas = g_ptr_array_index (self->atlases, i);
+
+      if (atlas->dirty_glyphs == NULL)
+        continue;
+
+      if (atlas->image == NULL)
+        {
+          atlas->image = g_new0 (GskGLImage, 1);
+          gsk_gl_image_create (atlas->image, self->gl_driver, atlas->width, atlas->height);
+        }
+
+      upload_dirty_glyphs (self, atlas);
+    }
+}
+
 void
 gsk_gl_glyph_cache_begin_frame (GskGLGlyphCache *self)
 {
@@ -418,6 +472,18 @@ gsk_gl_glyph_cache_begin_frame (GskGLGlyphCache *self)
           if (atlas)
             atlas->old_pixels += value->draw_width * value->draw_height;
         }
+      else if (age >= EVICT_AGE)
+        {
+          GskGLGlyphAtlas *atlas = value->atlas;
+
+          /* The glyph is cold; drop its entry. Its pixels stay counted
+           * as old, so the area gets reclaimed when the atlas is dropped.
+           */
+          if (atlas)
+            atlas->num_glyphs--;
+          g_hash_table_iter_remove (&iter);
+          dropped++;
+        }
     }
 
   /* look for atlases to drop, and create a mapping of updated texture indices */
@@ -437,12 +503,26 @@ gsk_gl_glyph_cache_begin_frame (GskGLGlyphCache *self)
               atlas->image->texture_id = 0;
             }
 
-          /* Remove all glyphs that point to this atlas */
+          /* Drop the old glyphs pointing to this atlas, and compact the
+           * ones that are still in use into the remaining atlases. They
+           * will be re-rendered and uploaded the next time they are used.
+           */
           g_hash_table_iter_init (&iter, self->hash_table);
           while (g_hash_table_iter_next (&iter, (gpointer *)&key, (gpointer *)&value))
             {
-              if (value->atlas == atlas)
-                g_hash_table_iter_remove (&iter);
+              if (value->atlas != atlas)
+                continue;
+
+              if (self->timestamp - value->timestamp < MAX_AGE)
+                {
+                  value->atlas = NULL;
+                  add_to_cache (self, key, value);
+                }
+              else
+                {
+                  g_hash_table_iter_remove (&iter);
+                  dropped++;
+                }
             }
           /* TODO: The above loop inside this other loop could be slow... */
 
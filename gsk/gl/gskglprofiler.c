@@ -6,6 +6,25 @@
 
 #define N_QUERIES       4
 
+/* A named GPU timer scope. Unlike the whole-frame region below, scopes
+ * can nest, so they are implemented with pairs of GL_TIMESTAMP queries
+ * instead of a single GL_TIME_ELAPSED query, of which only one can be
+ * active at a time.
+ */
+typedef struct
+{
+  char *name;
+  guint64 gpu_time;     /* inclusive time of the last collected frame */
+  guint64 begin_time;   /* pending begin timestamp while collecting */
+} Scope;
+
+typedef struct
+{
+  guint scope_id;
+  GLuint query;
+  gboolean begin;
+} TimestampEvent;
+
 struct _GskGLProfiler
 {
   GObject parent_instance;
@@ -18,6 +37,14 @@ struct _GskGLProfiler
   GLuint gl_queries[N_QUERIES];
   GLuint active_query;
 
+  GArray *scopes;        /* Scope */
+  /* The timestamp events of a frame are only read back when the next
+   * frame ends, so two frames are in flight
+   */
+  GArray *events[2];     /* TimestampEvent */
+  guint frame_events;    /* index into events for the current frame */
+  GArray *free_queries;  /* GLuint, recycled timestamp query objects */
+
   gboolean has_timer : 1;
   gboolean first_frame : 1;
 };
@@ -36,9 +63,26 @@ static void
 gsk_gl_profiler_finalize (GObject *gobject)
 {
   GskGLProfiler *self = GSK_GL_PROFILER (gobject);
+  guint i, j;
 
   glDeleteQueries (N_QUERIES, self->gl_queries);
 
+  for (i = 0; i < self->scopes->len; i++)
+    g_free (g_array_index (self->scopes, Scope, i).name);
+  g_array_unref (self->scopes);
+
+  for (i = 0; i < 2; i++)
+    {
+      for (j = 0; j < self->events[i]->len; j++)
+        glDeleteQueries (1, &g_array_index (self->events[i], TimestampEvent, j).query);
+      g_array_unref (self->events[i]);
+    }
+
+  if (self->free_queries->len > 0)
+    glDeleteQueries (self->free_queries->len,
+                     &g_array_index (self->free_queries, GLuint, 0));
+  g_array_unref (self->free_queries);
+
   g_clear_object (&self->gl_context);
 
   G_OBJECT_CLASS (gsk_gl_profiler_parent_class)->finalize (gobject);
@@ -108,6 +152,11 @@ gsk_gl_profiler_init (GskGLProfiler *self)
 {
   glGenQueries (N_QUERIES, self->gl_queries);
 
+  self->scopes = g_array_new (FALSE, FALSE, sizeof (Scope));
+  self->events[0] = g_array_new (FALSE, FALSE, sizeof (TimestampEvent));
+  self->events[1] = g_array_new (FALSE, FALSE, sizeof (TimestampEvent));
+  self->free_queries = g_array_new (FALSE, FALSE, sizeof (GLuint));
+
   self->first_frame = TRUE;
   self->has_timer = epoxy_has_gl_extension ("GL_ARB_timer_query");
 }
@@ -120,6 +169,169 @@ gsk_gl_profiler_new (GdkGLContext *context)
   return g_object_new (GSK_TYPE_GL_PROFILER, "gl-context", context, NULL);
 }
 
+/**
+ * gsk_gl_profiler_add_scope:
+ * @profiler: a #GskGLProfiler
+ * @name: the name of the scope, e.g. the pipeline it covers
+ *
+ * Registers a named GPU timer scope. The returned id is passed to
+ * gsk_gl_profiler_begin_scope() and gsk_gl_profiler_end_scope() to
+ * bracket the GL calls that should be attributed to the scope.
+ *
+ * Returns: the id of the new scope
+ */
+guint
+gsk_gl_profiler_add_scope (GskGLProfiler *profiler,
+                           const char    *name)
+{
+  Scope scope;
+
+  g_return_val_if_fail (GSK_IS_GL_PROFILER (profiler), 0);
+  g_return_val_if_fail (name != NULL, 0);
+
+  scope.name = g_strdup (name);
+  scope.gpu_time = 0;
+  scope.begin_time = 0;
+
+  g_array_append_val (profiler->scopes, scope);
+
+  return profiler->scopes->len - 1;
+}
+
+guint
+gsk_gl_profiler_get_n_scopes (GskGLProfiler *profiler)
+{
+  g_return_val_if_fail (GSK_IS_GL_PROFILER (profiler), 0);
+
+  return profiler->scopes->len;
+}
+
+const char *
+gsk_gl_profiler_get_scope_name (GskGLProfiler *profiler,
+                                guint          scope_id)
+{
+  g_return_val_if_fail (GSK_IS_GL_PROFILER (profiler), NULL);
+  g_return_val_if_fail (scope_id < profiler->scopes->len, NULL);
+
+  return g_array_index (profiler->scopes, Scope, scope_id).name;
+}
+
+/**
+ * gsk_gl_profiler_get_scope_gpu_time:
+ * @profiler: a #GskGLProfiler
+ * @scope_id: a scope id returned by gsk_gl_profiler_add_scope()
+ *
+ * Retrieves the GPU time spent inside the scope during the last frame
+ * whose queries have been collected, including nested scopes.
+ *
+ * Returns: the inclusive GPU time of the scope, in nanoseconds
+ */
+guint64
+gsk_gl_profiler_get_scope_gpu_time (GskGLProfiler *profiler,
+                                    guint          scope_id)
+{
+  g_return_val_if_fail (GSK_IS_GL_PROFILER (profiler), 0);
+  g_return_val_if_fail (scope_id < profiler->scopes->len, 0);
+
+  return g_array_index (profiler->scopes, Scope, scope_id).gpu_time;
+}
+
+static void
+gsk_gl_profiler_record_timestamp (GskGLProfiler *profiler,
+                                  guint          scope_id,
+                                  gboolean       begin)
+{
+  TimestampEvent event;
+
+  if (!profiler->has_timer)
+    return;
+
+  if (profiler->free_queries->len > 0)
+    {
+      event.query = g_array_index (profiler->free_queries, GLuint,
+                                   profiler->free_queries->len - 1);
+      g_array_set_size (profiler->free_queries, profiler->free_queries->len - 1);
+    }
+  else
+    glGenQueries (1, &event.query);
+
+  event.scope_id = scope_id;
+  event.begin = begin;
+
+  glQueryCounter (event.query, GL_TIMESTAMP);
+
+  g_array_append_val (profiler->events[profiler->frame_events], event);
+}
+
+void
+gsk_gl_profiler_begin_scope (GskGLProfiler *profiler,
+                             guint          scope_id)
+{
+  g_return_if_fail (GSK_IS_GL_PROFILER (profiler));
+  g_return_if_fail (scope_id < profiler->scopes->len);
+
+  gsk_gl_profiler_record_timestamp (profiler, scope_id, TRUE);
+}
+
+void
+gsk_gl_profiler_end_scope (GskGLProfiler *profiler,
+                           guint          scope_id)
+{
+  g_return_if_fail (GSK_IS_GL_PROFILER (profiler));
+  g_return_if_fail (scope_id < profiler->scopes->len);
+
+  gsk_gl_profiler_record_timestamp (profiler, scope_id, FALSE);
+}
+
+static void
+gsk_gl_profiler_collect_scopes (GskGLProfiler *profiler)
+{
+  GArray *events = profiler->events[1 - profiler->frame_events];
+  GLint res;
+  guint i;
+
+  /* Like the whole-frame region, scope results lag one frame behind
+   * so we never stall waiting for the GPU.
+   */
+  if (events->len > 0)
+    {
+      TimestampEvent *last = &g_array_index (events, TimestampEvent, events->len - 1);
+
+      glGetQueryObjectiv (last->query, GL_QUERY_RESULT_AVAILABLE, &res);
+      if (res == 1)
+        {
+          for (i = 0; i < profiler->scopes->len; i++)
+            g_array_index (profiler->scopes, Scope, i).gpu_time = 0;
+
+          /* Timestamps are monotonic, so if the last one is available,
+           * all of them are. Events are in issue order, which pairs up
+           * each end with its begin.
+           */
+          for (i = 0; i < events->len; i++)
+            {
+              TimestampEvent *event = &g_array_index (events, TimestampEvent, i);
+              Scope *scope = &g_array_index (profiler->scopes, Scope, event->scope_id);
+              GLuint64 timestamp;
+
+              glGetQueryObjectui64v (event->query, GL_QUERY_RESULT, &timestamp);
+
+              if (event->begin)
+                scope->begin_time = timestamp;
+              else
+                scope->gpu_time += timestamp - scope->begin_time;
+            }
+        }
+
+      /* Whether collected or dropped, the queries can be reused */
+      for (i = 0; i < events->len; i++)
+        g_array_append_val (profiler->free_queries,
+                            g_array_index (events, TimestampEvent, i).query);
+      g_array_set_size (events, 0);
+    }
+
+  profiler->frame_events = 1 - profiler->frame_events;
+}
+
 void
 gsk_gl_profiler_begin_gpu_region (GskGLProfiler *profiler)
 {
@@ -148,6 +360,8 @@ gsk_gl_profiler_end_gpu_region (GskGLProfiler *profiler)
 
   glEndQuery (GL_TIME_ELAPSED);
 
+  gsk_gl_profiler_collect_scopes (profiler);
+
   if (profiler->active_query == 0)
     last_query_id = N_QUERIES - 1;
   else
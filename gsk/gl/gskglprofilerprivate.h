@@ -13,6 +13,18 @@ GskGLProfiler * gsk_gl_profiler_new                     (GdkGLContext  *context)
 void            gsk_gl_profiler_begin_gpu_region        (GskGLProfiler *profiler);
 guint64         gsk_gl_profiler_end_gpu_region          (GskGLProfiler *profiler);
 
+guint           gsk_gl_profiler_add_scope               (GskGLProfiler *profiler,
+                                                         const char    *name);
+void            gsk_gl_profiler_begin_scope             (GskGLProfiler *profiler,
+                                                         guint          scope_id);
+void            gsk_gl_profiler_end_scope               (GskGLProfiler *profiler,
+                                                         guint          scope_id);
+guint           gsk_gl_profiler_get_n_scopes            (GskGLProfiler *profiler);
+const char *    gsk_gl_profiler_get_scope_name          (GskGLProfiler *profiler,
+                                                         guint          scope_id);
+guint64         gsk_gl_profiler_get_scope_gpu_time      (GskGLProfiler *profiler,
+                                                         guint          scope_id);
+
 G_END_DECLS
 
 #endif /* __GSK_GL_PROFILER_PRIVATE_H__ */
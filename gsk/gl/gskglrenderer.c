@@ -19,6 +19,8 @@
 
 #include <epoxy/gl.h>
 #include <cairo-ft.h>
+#include <math.h>
+#include <string.h>
 
 #define SHADER_VERSION_GLES             100
 #define SHADER_VERSION_GL2_LEGACY       110
@@ -91,6 +93,51 @@ get_gl_scaling_filters (GskRenderNode *node,
 {
   *min_filter_r = GL_LINEAR;
   *mag_filter_r = GL_LINEAR;
+
+  if (gsk_render_node_get_node_type (node) == GSK_TEXTURE_NODE)
+    {
+      GdkTexture *texture = gsk_texture_node_get_texture (node);
+
+      /* Plain GL_LINEAR only ever averages 4 texels, so textures drawn
+       * at half their size or less shimmer. Sample mipmaps instead; the
+       * driver generates them on upload when it sees this filter.
+       */
+      if (gdk_texture_get_width (texture) >= 2 * node->bounds.size.width &&
+          gdk_texture_get_height (texture) >= 2 * node->bounds.size.height)
+        *min_filter_r = GL_LINEAR_MIPMAP_LINEAR;
+    }
+}
+
+/* Whether the node gets drawn at its natural size, axis-aligned, at
+ * integer device pixel coordinates. Sampling such a draw with
+ * GL_LINEAR hits every texel exactly at its center, so the filter
+ * fetches four texels per fragment only to weight three of them with
+ * zero.
+ */
+static gboolean
+texture_node_is_pixel_aligned (GskRenderNode   *node,
+                               RenderOpBuilder *builder)
+{
+  GdkTexture *texture = gsk_texture_node_get_texture (node);
+  double xx, yx, xy, yy, x0, y0;
+  double x, y, w, h;
+  const double eps = 1.0 / 256.0;
+
+  if (!graphene_matrix_to_2d (&builder->current_modelview, &xx, &yx, &xy, &yy, &x0, &y0))
+    return FALSE;
+
+  if (yx != 0 || xy != 0)
+    return FALSE;
+
+  x = (builder->dx + node->bounds.origin.x) * xx + x0;
+  y = (builder->dy + node->bounds.origin.y) * yy + y0;
+  w = node->bounds.size.width * xx;
+  h = node->bounds.size.height * yy;
+
+  return fabs (x - rint (x)) < eps &&
+         fabs (y - rint (y)) < eps &&
+         fabs (w - gdk_texture_get_width (texture)) < eps &&
+         fabs (h - gdk_texture_get_height (texture)) < eps;
 }
 
 static inline void
@@ -182,6 +229,19 @@ typedef enum
   RENDER_SCISSOR
 } RenderMode;
 
+/* A top-level subtree that stayed identical for this many consecutive
+ * frames gets rendered into a cached texture once and replayed from it
+ * until it changes again.
+ */
+#define LAYER_CACHE_MIN_AGE 3
+
+typedef struct
+{
+  GskRenderNode *node;  /* last frame's subtree at this position */
+  int texture_id;       /* permanent texture with the rendered subtree, or 0 */
+  guint age;            /* consecutive frames the subtree was unchanged */
+} CachedLayer;
+
 struct _GskGLRenderer
 {
   GskRenderer parent_instance;
@@ -215,8 +275,28 @@ struct _GskGLRenderer
 
   GArray *render_ops;
 
+  /* GPU timer scopes in the GL profiler, one per program, so GPU time
+   * can be attributed to e.g. blurring vs. text
+   */
+  guint program_scopes[GL_N_PROGRAMS];
+
+  /* One entry per top-level child of the root container, matched up
+   * with last frame's children by position.
+   */
+  GArray *layers;
+
   GskGLGlyphCache glyph_cache;
 
+  /* Gradient stop lists, uploaded once as small ramp textures and
+   * shared by every gradient node using the same stops
+   */
+  GHashTable *gradient_cache;
+
+  /* Blurred nine-slice shadow textures, shared by all outset shadow
+   * nodes with the same corner radii, blur, spread and color
+   */
+  GHashTable *shadow_cache;
+
 #ifdef G_ENABLE_DEBUG
   struct {
     GQuark frames;
@@ -225,12 +305,19 @@ struct _GskGLRenderer
   struct {
     GQuark cpu_time;
     GQuark gpu_time;
+    GQuark program_gpu_time[GL_N_PROGRAMS];
   } profile_timers;
 #endif
 
   RenderMode render_mode;
 
   gboolean has_buffers : 1;
+
+  /* Whether the backbuffer contained exactly the previous frame when
+   * this frame started (buffer age 1), so node tree damage alone
+   * determines what needs to be redrawn.
+   */
+  gboolean buffer_is_prev_frame : 1;
 };
 
 struct _GskGLRendererClass
@@ -346,8 +433,8 @@ render_text_node (GskGLRenderer   *self,
   guint num_glyphs = gsk_text_node_get_num_glyphs (node);
   int i;
   int x_position = 0;
-  int x = gsk_text_node_get_x (node) + builder->dx;
-  int y = gsk_text_node_get_y (node) + builder->dy;
+  float x = gsk_text_node_get_x (node) + builder->dx;
+  float y = gsk_text_node_get_y (node) + builder->dy;
 
   /* If the font has color glyphs, we don't need to recolor anything */
   if (!force_color && font_has_color_glyphs (font))
@@ -370,23 +457,31 @@ render_text_node (GskGLRenderer   *self,
       float tx, ty, tx2, ty2;
       double cx;
       double cy;
+      float fx;
+      guint xshift;
 
       if (gi->glyph == PANGO_GLYPH_EMPTY)
         continue;
 
+      cx = (double)(x_position + gi->geometry.x_offset) / PANGO_SCALE;
+      cy = (double)(gi->geometry.y_offset) / PANGO_SCALE;
+
+      /* Cache glyphs at 4 subpixel x positions, so animated text does
+       * not get re-rasterized on every frame */
+      fx = x + cx;
+      xshift = (guint)((fx - floorf (fx)) * 4 + 0.5) % 4;
+
       glyph = gsk_gl_glyph_cache_lookup (&self->glyph_cache,
                                          TRUE,
                                          (PangoFont *)font,
                                          gi->glyph,
-                                         self->scale_factor);
+                                         self->scale_factor,
+                                         xshift);
 
       /* e.g. whitespace */
       if (glyph->draw_width <= 0 || glyph->draw_height <= 0)
         goto next;
 
-      cx = (double)(x_position + gi->geometry.x_offset) / PANGO_SCALE;
-      cy = (double)(gi->geometry.y_offset) / PANGO_SCALE;
-
       ops_set_texture (builder, gsk_gl_glyph_cache_get_glyph_image (&self->glyph_cache,
                                                                    glyph)->texture_id);
 
@@ -395,7 +490,7 @@ render_text_node (GskGLRenderer   *self,
       tx2 = tx + glyph->tw;
       ty2 = ty + glyph->th;
 
-      glyph_x = x + cx + glyph->draw_x;
+      glyph_x = floorf (fx) + glyph->draw_x;
       glyph_y = y + cy + glyph->draw_y;
       glyph_w = glyph->draw_width;
       glyph_h = glyph->draw_height;
@@ -591,12 +686,57 @@ render_texture_node (GskGLRenderer       *self,
   int gl_min_filter = GL_NEAREST, gl_mag_filter = GL_NEAREST;
   int texture_id;
 
+  graphene_rect_t region;
+
   get_gl_scaling_filters (node, &gl_min_filter, &gl_mag_filter);
 
+  /* Pixel-aligned 1:1 draws don't need filtering at all; sampling
+   * nearest skips the four-tap fetch and is what makes the texture
+   * eligible for the atlas below. Icon grids and video thumbnails are
+   * consistently drawn aligned, so their filter choice is stable and
+   * the driver's per-texture cache stays warm.
+   */
+  if (texture_node_is_pixel_aligned (node, builder))
+    {
+      gl_min_filter = GL_NEAREST;
+      gl_mag_filter = GL_NEAREST;
+    }
+
+  /* Small textures are packed into shared atlas pages, so consecutive
+   * icons can go out with a single texture bind.
+   */
+  texture_id = gsk_gl_driver_get_texture_atlas_region (self->gl_driver,
+                                                       texture,
+                                                       gl_min_filter,
+                                                       gl_mag_filter,
+                                                       &region);
+  if (texture_id >= 0)
+    {
+      const float u0 = region.origin.x;
+      const float v0 = region.origin.y;
+      const float u1 = region.origin.x + region.size.width;
+      const float v1 = region.origin.y + region.size.height;
+
+      ops_set_program (builder, &self->blit_program);
+      ops_set_texture (builder, texture_id);
+      ops_draw (builder, (GskQuadVertex[GL_N_VERTICES]) {
+        { { min_x, min_y }, { u0, v0 }, },
+        { { min_x, max_y }, { u0, v1 }, },
+        { { max_x, min_y }, { u1, v0 }, },
+
+        { { max_x, max_y }, { u1, v1 }, },
+        { { min_x, max_y }, { u0, v1 }, },
+        { { max_x, min_y }, { u1, v0 }, },
+      });
+      return;
+    }
+
   texture_id = gsk_gl_driver_get_texture_for_texture (self->gl_driver,
                                                       texture,
                                                       gl_min_filter,
-                                                      gl_mag_filter);
+                                                      gl_mag_filter,
+                                                      ceilf (node->bounds.size.width * self->scale_factor),
+                                                      ceilf (node->bounds.size.height * self->scale_factor));
   ops_set_program (builder, &self->blit_program);
   ops_set_texture (builder, texture_id);
 
@@ -691,6 +831,95 @@ render_opacity_node (GskGLRenderer   *self,
   ops_set_opacity (builder, prev_opacity);
 }
 
+typedef struct {
+  int n_stops;
+  GskColorStop stops[8];
+} GradientCacheKey;
+
+static guint
+gradient_cache_key_hash (gconstpointer v)
+{
+  const GradientCacheKey *key = v;
+  const guint *data = (const guint *) &key->stops[0];
+  guint hash = 5381 + key->n_stops;
+  gsize i;
+
+  for (i = 0; i < key->n_stops * sizeof (GskColorStop) / sizeof (guint); i ++)
+    hash = hash * 33 + data[i];
+
+  return hash;
+}
+
+static gboolean
+gradient_cache_key_equal (gconstpointer v1,
+                          gconstpointer v2)
+{
+  const GradientCacheKey *key1 = v1;
+  const GradientCacheKey *key2 = v2;
+
+  return key1->n_stops == key2->n_stops &&
+         memcmp (key1->stops, key2->stops, key1->n_stops * sizeof (GskColorStop)) == 0;
+}
+
+#define GRADIENT_RAMP_WIDTH 256
+
+/* Themes reuse a handful of gradients all over the place. Rasterize
+ * each distinct stop list once into a small ramp texture the shader
+ * can sample, instead of re-evaluating the stop math for every
+ * fragment of every gradient quad.
+ */
+static int
+gsk_gl_renderer_get_gradient_texture (GskGLRenderer      *self,
+                                      const GskColorStop *stops,
+                                      int                 n_stops)
+{
+  GradientCacheKey lookup = { 0, };
+  cairo_surface_t *surface;
+  cairo_pattern_t *pattern;
+  cairo_t *cr;
+  gpointer cached;
+  int texture_id;
+  int i;
+
+  lookup.n_stops = n_stops;
+  memcpy (lookup.stops, stops, n_stops * sizeof (GskColorStop));
+
+  cached = g_hash_table_lookup (self->gradient_cache, &lookup);
+  if (cached != NULL)
+    return GPOINTER_TO_INT (cached);
+
+  /* Let cairo do the stop interpolation, so the ramp matches what the
+   * cairo renderer produces for the same node
+   */
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, GRADIENT_RAMP_WIDTH, 1);
+  cr = cairo_create (surface);
+  pattern = cairo_pattern_create_linear (0, 0, GRADIENT_RAMP_WIDTH, 0);
+  for (i = 0; i < n_stops; i ++)
+    cairo_pattern_add_color_stop_rgba (pattern,
+                                       stops[i].offset,
+                                       stops[i].color.red,
+                                       stops[i].color.green,
+                                       stops[i].color.blue,
+                                       stops[i].color.alpha);
+  cairo_set_source (cr, pattern);
+  cairo_pattern_destroy (pattern);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  texture_id = gsk_gl_driver_create_permanent_texture (self->gl_driver,
+                                                       GRADIENT_RAMP_WIDTH, 1);
+  gsk_gl_driver_bind_source_texture (self->gl_driver, texture_id);
+  gsk_gl_driver_init_texture_with_surface (self->gl_driver, texture_id, surface,
+                                           GL_LINEAR, GL_LINEAR);
+  cairo_surface_destroy (surface);
+
+  g_hash_table_insert (self->gradient_cache,
+                       g_memdup (&lookup, sizeof lookup),
+                       GINT_TO_POINTER (texture_id));
+
+  return texture_id;
+}
+
 static inline void
 render_linear_gradient_node (GskGLRenderer       *self,
                              GskRenderNode       *node,
@@ -702,22 +931,13 @@ render_linear_gradient_node (GskGLRenderer       *self,
   const GskColorStop *stops = gsk_linear_gradient_node_peek_color_stops (node);
   const graphene_point_t *start = gsk_linear_gradient_node_peek_start (node);
   const graphene_point_t *end = gsk_linear_gradient_node_peek_end (node);
-  int i;
-
-  for (i = 0; i < n_color_stops; i ++)
-    {
-      const GskColorStop *stop = stops + i;
+  int texture_id;
 
-      op.linear_gradient.color_stops[(i * 4) + 0] = stop->color.red;
-      op.linear_gradient.color_stops[(i * 4) + 1] = stop->color.green;
-      op.linear_gradient.color_stops[(i * 4) + 2] = stop->color.blue;
-      op.linear_gradient.color_stops[(i * 4) + 3] = stop->color.alpha;
-      op.linear_gradient.color_offsets[i] = stop->offset;
-    }
+  texture_id = gsk_gl_renderer_get_gradient_texture (self, stops, n_color_stops);
 
   ops_set_program (builder, &self->linear_gradient_program);
+  ops_set_texture (builder, texture_id);
   op.op = OP_CHANGE_LINEAR_GRADIENT;
-  op.linear_gradient.n_color_stops = n_color_stops;
   op.linear_gradient.start_point = *start;
   op.linear_gradient.end_point = *end;
   ops_add (builder, &op);
@@ -832,6 +1052,10 @@ render_blur_node (GskGLRenderer       *self,
   op.op = OP_CHANGE_BLUR;
   graphene_size_init_from_size (&op.blur.size, &node->bounds.size);
   op.blur.radius = gsk_blur_node_get_radius (node);
+  /* Under deadline pressure, a tighter blur costs proportionally
+   * fewer shader samples */
+  if (gsk_renderer_is_degraded (GSK_RENDERER (self)))
+    op.blur.radius /= 2;
   ops_add (builder, &op);
 
   ops_set_texture (builder, texture_id);
@@ -918,23 +1142,48 @@ render_unblurred_outset_shadow_node (GskGLRenderer       *self,
   ops_draw (builder, vertex_data);
 }
 
-static inline void
-render_outset_shadow_node (GskGLRenderer       *self,
-                           GskRenderNode       *node,
-                           RenderOpBuilder     *builder)
+typedef struct {
+  GskRoundedRect outline;
+  float blur_radius;
+  GdkRGBA color;
+} ShadowCacheKey;
+
+static guint
+shadow_cache_key_hash (gconstpointer v)
+{
+  const guint *data = v;
+  guint hash = 5381;
+  gsize i;
+
+  /* The key is memset to zero before it is filled in, so hashing the
+   * padding along with the members is fine */
+  for (i = 0; i < sizeof (ShadowCacheKey) / sizeof (guint); i ++)
+    hash = hash * 33 + data[i];
+
+  return hash;
+}
+
+static gboolean
+shadow_cache_key_equal (gconstpointer v1,
+                        gconstpointer v2)
+{
+  return memcmp (v1, v2, sizeof (ShadowCacheKey)) == 0;
+}
+
+/* Renders the minimal blurred shadow texture for the given outline;
+ * the nine-slice quads in render_outset_shadow_node() stretch it to
+ * any element size, so the result only depends on the corner radii,
+ * the blur radius and the color.
+ */
+static int
+gsk_gl_renderer_create_shadow_texture (GskGLRenderer        *self,
+                                       RenderOpBuilder      *builder,
+                                       const GskRoundedRect *offset_outline,
+                                       const GdkRGBA        *color,
+                                       float                 blur_radius,
+                                       float                 texture_width,
+                                       float                 texture_height)
 {
-  const GskRoundedRect *outline = gsk_outset_shadow_node_peek_outline (node);
-  GskRoundedRect offset_outline;
-  const float blur_radius = gsk_outset_shadow_node_get_blur_radius (node);
-  const float blur_extra = gsk_cairo_blur_compute_pixels (blur_radius);
-  const float spread = gsk_outset_shadow_node_get_spread (node);
-  const float dx = gsk_outset_shadow_node_get_dx (node);
-  const float dy = gsk_outset_shadow_node_get_dy (node);
-  const float min_x = outline->bounds.origin.x - spread - blur_extra / 2.0;
-  const float min_y = outline->bounds.origin.y - spread - blur_extra / 2.0;
-  const float max_x = min_x + outline->bounds.size.width  + (spread + blur_extra/2.0) * 2;
-  const float max_y = min_y + outline->bounds.size.height + (spread + blur_extra/2.0) * 2;
-  float texture_width, texture_height;
   RenderOp op;
   graphene_matrix_t identity;
   graphene_matrix_t prev_projection;
@@ -946,26 +1195,6 @@ render_outset_shadow_node (GskGLRenderer       *self,
   int texture_id, render_target;
   int blurred_texture_id, blurred_render_target;
 
-  /* offset_outline is the minimal outline we need to draw the given drop shadow,
-   * enlarged by the spread and offset by the blur radius. */
-  offset_outline = *outline;
-  /* Shrink our outline to the minimum size that can still hold all the border radii */
-  gsk_rounded_rect_shrink_to_minimum (&offset_outline);
-  /* Increase by the spread */
-  gsk_rounded_rect_shrink (&offset_outline, -spread, -spread, -spread, -spread);
-  /* No we need to incorporate the blur radius; since we blur an edge an equal blur_extra/2.0
-   * on both sides, the minimum side of both width and height needs to be blur_extra */
-  offset_outline.bounds.size.width = MAX (offset_outline.bounds.size.width, blur_extra);
-  offset_outline.bounds.size.height = MAX (offset_outline.bounds.size.height, blur_extra);
-  /* For the center part, we add a few pixels */
-  offset_outline.bounds.size.width += SHADOW_EXTRA_SIZE;
-  offset_outline.bounds.size.height += SHADOW_EXTRA_SIZE;
-  offset_outline.bounds.origin.x = blur_extra / 2.0f;
-  offset_outline.bounds.origin.y = blur_extra / 2.0f;
-
-  texture_width = offset_outline.bounds.size.width   + blur_extra;
-  texture_height = offset_outline.bounds.size.height + blur_extra;
-
   texture_id = gsk_gl_driver_create_texture (self->gl_driver, texture_width, texture_height);
   gsk_gl_driver_bind_source_texture (self->gl_driver, texture_id);
   gsk_gl_driver_init_texture_empty (self->gl_driver, texture_id);
@@ -987,8 +1216,8 @@ render_outset_shadow_node (GskGLRenderer       *self,
 
   /* Draw outline */
   ops_set_program (builder, &self->color_program);
-  prev_clip = ops_set_clip (builder, &offset_outline);
-  ops_set_color (builder, gsk_outset_shadow_node_peek_color (node));
+  prev_clip = ops_set_clip (builder, offset_outline);
+  ops_set_color (builder, color);
   ops_draw (builder, (GskQuadVertex[GL_N_VERTICES]) {
     { { 0,                            }, { 0, 1 }, },
     { { 0,             texture_height }, { 0, 0 }, },
@@ -999,7 +1228,9 @@ render_outset_shadow_node (GskGLRenderer       *self,
     { { texture_width,                }, { 1, 1 }, },
   });
 
-  blurred_texture_id = gsk_gl_driver_create_texture (self->gl_driver, texture_width, texture_height);
+  /* The blurred result is kept across frames in the shadow cache, so
+   * it must survive the end-of-frame texture collection */
+  blurred_texture_id = gsk_gl_driver_create_permanent_texture (self->gl_driver, texture_width, texture_height);
   gsk_gl_driver_bind_source_texture (self->gl_driver, blurred_texture_id);
   gsk_gl_driver_init_texture_empty (self->gl_driver, blurred_texture_id);
   blurred_render_target = gsk_gl_driver_create_render_target (self->gl_driver, blurred_texture_id, TRUE, TRUE);
@@ -1038,6 +1269,76 @@ render_outset_shadow_node (GskGLRenderer       *self,
   ops_set_projection (builder, &prev_projection);
   ops_set_render_target (builder, prev_render_target);
 
+  return blurred_texture_id;
+}
+
+static inline void
+render_outset_shadow_node (GskGLRenderer       *self,
+                           GskRenderNode       *node,
+                           RenderOpBuilder     *builder)
+{
+  const GskRoundedRect *outline = gsk_outset_shadow_node_peek_outline (node);
+  GskRoundedRect offset_outline;
+  const float blur_radius = gsk_outset_shadow_node_get_blur_radius (node);
+  const float blur_extra = gsk_cairo_blur_compute_pixels (blur_radius);
+  const float spread = gsk_outset_shadow_node_get_spread (node);
+  const float dx = gsk_outset_shadow_node_get_dx (node);
+  const float dy = gsk_outset_shadow_node_get_dy (node);
+  const float min_x = outline->bounds.origin.x - spread - blur_extra / 2.0;
+  const float min_y = outline->bounds.origin.y - spread - blur_extra / 2.0;
+  const float max_x = min_x + outline->bounds.size.width  + (spread + blur_extra/2.0) * 2;
+  const float max_y = min_y + outline->bounds.size.height + (spread + blur_extra/2.0) * 2;
+  float texture_width, texture_height;
+  RenderOp op;
+  ShadowCacheKey key;
+  gpointer cached;
+  int blurred_texture_id;
+
+  /* offset_outline is the minimal outline we need to draw the given drop shadow,
+   * enlarged by the spread and offset by the blur radius. */
+  offset_outline = *outline;
+  /* Shrink our outline to the minimum size that can still hold all the border radii */
+  gsk_rounded_rect_shrink_to_minimum (&offset_outline);
+  /* Increase by the spread */
+  gsk_rounded_rect_shrink (&offset_outline, -spread, -spread, -spread, -spread);
+  /* No we need to incorporate the blur radius; since we blur an edge an equal blur_extra/2.0
+   * on both sides, the minimum side of both width and height needs to be blur_extra */
+  offset_outline.bounds.size.width = MAX (offset_outline.bounds.size.width, blur_extra);
+  offset_outline.bounds.size.height = MAX (offset_outline.bounds.size.height, blur_extra);
+  /* For the center part, we add a few pixels */
+  offset_outline.bounds.size.width += SHADOW_EXTRA_SIZE;
+  offset_outline.bounds.size.height += SHADOW_EXTRA_SIZE;
+  offset_outline.bounds.origin.x = blur_extra / 2.0f;
+  offset_outline.bounds.origin.y = blur_extra / 2.0f;
+
+  texture_width = offset_outline.bounds.size.width   + blur_extra;
+  texture_height = offset_outline.bounds.size.height + blur_extra;
+
+  /* Identical shadows - same corner radii, blur, spread and color, no
+   * matter the element size or position - share one blurred texture.
+   */
+  memset (&key, 0, sizeof (key));
+  key.outline = offset_outline;
+  key.blur_radius = blur_radius;
+  key.color = *gsk_outset_shadow_node_peek_color (node);
+
+  cached = g_hash_table_lookup (self->shadow_cache, &key);
+  if (cached != NULL)
+    {
+      blurred_texture_id = GPOINTER_TO_INT (cached);
+    }
+  else
+    {
+      blurred_texture_id = gsk_gl_renderer_create_shadow_texture (self, builder,
+                                                                  &offset_outline,
+                                                                  gsk_outset_shadow_node_peek_color (node),
+                                                                  blur_radius,
+                                                                  texture_width, texture_height);
+      g_hash_table_insert (self->shadow_cache,
+                           g_memdup (&key, sizeof (key)),
+                           GINT_TO_POINTER (blurred_texture_id));
+    }
+
   ops_set_program (builder, &self->outset_shadow_program);
   ops_set_texture (builder, blurred_texture_id);
   op.op = OP_CHANGE_OUTSET_SHADOW;
@@ -1261,8 +1562,6 @@ render_outset_shadow_node (GskGLRenderer       *self,
       }
 
   }
-
-  ops_set_clip (builder, &prev_clip);
 }
 
 static inline void
@@ -1612,14 +1911,6 @@ apply_linear_gradient_op (const Program  *program,
                           const RenderOp *op)
 {
   OP_PRINT (" -> Linear gradient");
-  glUniform1i (program->linear_gradient.num_color_stops_location,
-               op->linear_gradient.n_color_stops);
-  glUniform4fv (program->linear_gradient.color_stops_location,
-                op->linear_gradient.n_color_stops,
-                op->linear_gradient.color_stops);
-  glUniform1fv (program->linear_gradient.color_offsets_location,
-                op->linear_gradient.n_color_stops,
-                op->linear_gradient.color_offsets);
   glUniform2f (program->linear_gradient.start_point_location,
                op->linear_gradient.start_point.x, op->linear_gradient.start_point.y);
   glUniform2f (program->linear_gradient.end_point_location,
@@ -1672,6 +1963,7 @@ gsk_gl_renderer_dispose (GObject *gobject)
   GskGLRenderer *self = GSK_GL_RENDERER (gobject);
 
   g_clear_pointer (&self->render_ops, g_array_unref);
+  g_clear_pointer (&self->layers, g_array_unref);
 
   G_OBJECT_CLASS (gsk_gl_renderer_parent_class)->dispose (gobject);
 }
@@ -1746,6 +2038,26 @@ gsk_gl_renderer_create_programs (GskGLRenderer  *self,
       Program *prog = &self->programs[i];
 
       prog->index = i;
+      self->program_scopes[i] = gsk_gl_profiler_add_scope (self->gl_profiler,
+                                                           program_definitions[i].name);
+
+#ifdef G_ENABLE_DEBUG
+      /* The quarks survive unrealize/realize cycles, the profiler
+       * timers only need to be registered once */
+      if (self->profile_timers.program_gpu_time[i] == 0)
+        {
+          char *timer_name = g_strconcat ("gpu-time-", program_definitions[i].name, NULL);
+          char *description = g_strconcat ("GPU time (", program_definitions[i].name, ")", NULL);
+
+          self->profile_timers.program_gpu_time[i] =
+              gsk_profiler_add_timer (gsk_renderer_get_profiler (GSK_RENDERER (self)),
+                                      timer_name, description, FALSE, TRUE);
+
+          g_free (timer_name);
+          g_free (description);
+        }
+#endif
+
       prog->id = gsk_shader_builder_create_program (builder,
                                                     program_definitions[i].vs,
                                                     program_definitions[i].fs,
@@ -1785,9 +2097,6 @@ gsk_gl_renderer_create_programs (GskGLRenderer  *self,
   INIT_PROGRAM_UNIFORM_LOCATION (color_matrix, color_offset);
 
   /* linear gradient */
-  INIT_PROGRAM_UNIFORM_LOCATION (linear_gradient, color_stops);
-  INIT_PROGRAM_UNIFORM_LOCATION (linear_gradient, color_offsets);
-  INIT_PROGRAM_UNIFORM_LOCATION (linear_gradient, num_color_stops);
   INIT_PROGRAM_UNIFORM_LOCATION (linear_gradient, start_point);
   INIT_PROGRAM_UNIFORM_LOCATION (linear_gradient, end_point);
 
@@ -1863,6 +2172,12 @@ gsk_gl_renderer_realize (GskRenderer  *renderer,
     return FALSE;
 
   gsk_gl_glyph_cache_init (&self->glyph_cache, renderer, self->gl_driver);
+  self->gradient_cache = g_hash_table_new_full (gradient_cache_key_hash,
+                                                gradient_cache_key_equal,
+                                                g_free, NULL);
+  self->shadow_cache = g_hash_table_new_full (shadow_cache_key_hash,
+                                              shadow_cache_key_equal,
+                                              g_free, NULL);
 
   return TRUE;
 }
@@ -1883,11 +2198,25 @@ gsk_gl_renderer_unrealize (GskRenderer *renderer)
    */
   g_array_set_size (self->render_ops, 0);
 
+  /* Cached layer textures go down with the driver; the node references
+   * have to be released here. */
+  for (i = 0; i < self->layers->len; i ++)
+    {
+      CachedLayer *layer = &g_array_index (self->layers, CachedLayer, i);
+
+      g_clear_pointer (&layer->node, gsk_render_node_unref);
+    }
+  g_array_set_size (self->layers, 0);
+
   for (i = 0; i < GL_N_PROGRAMS; i ++)
     glDeleteProgram (self->programs[i].id);
 
   gsk_gl_glyph_cache_free (&self->glyph_cache);
 
+  /* The ramp and shadow textures themselves go down with the driver */
+  g_clear_pointer (&self->gradient_cache, g_hash_table_unref);
+  g_clear_pointer (&self->shadow_cache, g_hash_table_unref);
+
   g_clear_object (&self->gl_profiler);
   g_clear_object (&self->gl_driver);
 
@@ -1914,6 +2243,7 @@ gsk_gl_renderer_begin_draw_frame (GskRenderer          *renderer,
                      gdk_window_get_height (window) * self->scale_factor
                  };
   damage = gdk_gl_context_get_damage (self->gl_context);
+  self->buffer_is_prev_frame = cairo_region_is_empty (damage);
   cairo_region_union (damage, update_area);
 
   if (cairo_region_contains_rectangle (damage, &whole_window) == CAIRO_REGION_OVERLAP_IN)
@@ -1984,22 +2314,50 @@ gsk_gl_renderer_clear (GskGLRenderer *self)
   glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
+static void
+gsk_gl_renderer_set_scissor (GskGLRenderer               *self,
+                             const cairo_rectangle_int_t *extents)
+{
+  GdkWindow *window = gsk_renderer_get_window (GSK_RENDERER (self));
+  int window_height = gdk_window_get_height (window) * self->scale_factor;
+
+  glEnable (GL_SCISSOR_TEST);
+  glScissor (extents->x * self->scale_factor,
+             window_height - (extents->height * self->scale_factor) - (extents->y * self->scale_factor),
+             extents->width * self->scale_factor,
+             extents->height * self->scale_factor);
+}
+
 static void
 gsk_gl_renderer_setup_render_mode (GskGLRenderer *self)
 {
+  cairo_region_t *frame_damage = NULL;
+
+  /* If the backbuffer still contains the previous frame, the diff of
+   * the two node trees is all that needs redrawing.
+   */
+  if (self->buffer_is_prev_frame)
+    frame_damage = gsk_renderer_get_damage_region (GSK_RENDERER (self));
+
   switch (self->render_mode)
   {
     case RENDER_FULL:
-      glDisable (GL_SCISSOR_TEST);
+      if (frame_damage != NULL)
+        {
+          cairo_rectangle_int_t extents;
+
+          cairo_region_get_extents (frame_damage, &extents);
+          gsk_gl_renderer_set_scissor (self, &extents);
+        }
+      else
+        glDisable (GL_SCISSOR_TEST);
       break;
 
     case RENDER_SCISSOR:
       {
         GdkDrawingContext *context = gsk_renderer_get_drawing_context (GSK_RENDERER (self));
-        GdkWindow *window = gsk_renderer_get_window (GSK_RENDERER (self));
         cairo_region_t *clip = gdk_drawing_context_get_clip (context);
         cairo_rectangle_int_t extents;
-        int window_height;
 
         /* Fall back to RENDER_FULL */
         if (clip == NULL)
@@ -2010,16 +2368,19 @@ gsk_gl_renderer_setup_render_mode (GskGLRenderer *self)
 
         g_assert (cairo_region_num_rectangles (clip) == 1);
 
-        window_height = gdk_window_get_height (window) * self->scale_factor;
-
         /*cairo_region_get_extents (clip, &extents);*/
         cairo_region_get_rectangle (clip, 0, &extents);
 
-        glEnable (GL_SCISSOR_TEST);
-        glScissor (extents.x * self->scale_factor,
-                   window_height - (extents.height * self->scale_factor) - (extents.y * self->scale_factor),
-                   extents.width * self->scale_factor,
-                   extents.height * self->scale_factor);
+        if (frame_damage != NULL)
+          {
+            cairo_region_t *scissor = cairo_region_copy (frame_damage);
+
+            cairo_region_intersect_rectangle (scissor, &extents);
+            cairo_region_get_extents (scissor, &extents);
+            cairo_region_destroy (scissor);
+          }
+
+        gsk_gl_renderer_set_scissor (self, &extents);
 
         cairo_region_destroy (clip);
         break;
@@ -2052,6 +2413,20 @@ gsk_gl_renderer_add_render_ops (GskGLRenderer   *self,
     { { min_x, max_y }, { 0, 1 }, },
     { { max_x, min_y }, { 1, 0 }, },
   };
+  graphene_rect_t transformed_bounds;
+#ifdef G_ENABLE_DEBUG
+  GskProfiler *node_profiler = NULL;
+#endif
+
+  /* Nothing to draw for nodes entirely outside of the clip; this prunes
+   * whole subtrees, since node bounds contain the bounds of all children */
+  graphene_matrix_transform_bounds (&builder->current_modelview,
+                                    &GRAPHENE_RECT_INIT (min_x, min_y,
+                                                         max_x - min_x,
+                                                         max_y - min_y),
+                                    &transformed_bounds);
+  if (!graphene_rect_intersection (&transformed_bounds, &builder->current_clip.bounds, NULL))
+    return;
 
 #if DEBUG_OPS
   if (gsk_render_node_get_node_type (node) != GSK_CONTAINER_NODE)
@@ -2059,6 +2434,17 @@ gsk_gl_renderer_add_render_ops (GskGLRenderer   *self,
                gsk_render_node_get_node_type (node));
 #endif
 
+#ifdef G_ENABLE_DEBUG
+  if (GSK_RENDERER_DEBUG_CHECK (GSK_RENDERER (self), RENDER_TIMES))
+    {
+      node_profiler = gsk_renderer_get_profiler (GSK_RENDERER (self));
+      gsk_profiler_scope_begin (node_profiler,
+                                node->name != NULL
+                                  ? node->name
+                                  : node->node_class->type_name);
+    }
+#endif
+
   switch (gsk_render_node_get_node_type (node))
     {
     case GSK_NOT_A_RENDER_NODE:
@@ -2127,7 +2513,10 @@ gsk_gl_renderer_add_render_ops (GskGLRenderer   *self,
     break;
 
     case GSK_OUTSET_SHADOW_NODE:
-      if (gsk_outset_shadow_node_get_blur_radius (node) > 0)
+      /* Under deadline pressure, skip the offscreen blur pass and
+       * draw shadows hard-edged */
+      if (gsk_outset_shadow_node_get_blur_radius (node) > 0 &&
+          !gsk_renderer_is_degraded (GSK_RENDERER (self)))
         render_outset_shadow_node (self, node, builder);
       else
         render_unblurred_outset_shadow_node (self, node, builder, vertex_data);
@@ -2153,6 +2542,11 @@ gsk_gl_renderer_add_render_ops (GskGLRenderer   *self,
         render_fallback_node (self, node, builder, vertex_data);
       }
     }
+
+#ifdef G_ENABLE_DEBUG
+  if (node_profiler != NULL)
+    gsk_profiler_scope_end (node_profiler);
+#endif
 }
 
 static void
@@ -2191,7 +2585,9 @@ add_offscreen_ops (GskGLRenderer   *self,
       *texture_id = gsk_gl_driver_get_texture_for_texture (self->gl_driver,
                                                            texture,
                                                            gl_min_filter,
-                                                           gl_mag_filter);
+                                                           gl_mag_filter,
+                                                           ceilf (width * self->scale_factor),
+                                                           ceilf (height * self->scale_factor));
       *is_offscreen = FALSE;
       return;
     }
@@ -2230,6 +2626,446 @@ add_offscreen_ops (GskGLRenderer   *self,
   *is_offscreen = TRUE;
 }
 
+static void
+gsk_gl_renderer_drop_cached_layer (GskGLRenderer *self,
+                                   CachedLayer   *layer)
+{
+  if (layer->texture_id != 0)
+    {
+      gsk_gl_driver_destroy_texture (self->gl_driver, layer->texture_id);
+      layer->texture_id = 0;
+    }
+  layer->age = 0;
+}
+
+static gboolean
+node_is_unchanged (GskRenderNode *node1,
+                   GskRenderNode *node2)
+{
+  cairo_region_t *diff;
+  gboolean unchanged;
+
+  if (node1 == node2)
+    return TRUE;
+
+  diff = cairo_region_create ();
+  gsk_render_node_diff (node1, node2, diff);
+  unchanged = cairo_region_is_empty (diff);
+  cairo_region_destroy (diff);
+
+  return unchanged;
+}
+
+static void
+gsk_gl_renderer_add_cached_layer_ops (GskGLRenderer   *self,
+                                      RenderOpBuilder *builder,
+                                      GskRenderNode   *node,
+                                      CachedLayer     *layer)
+{
+  const float min_x = builder->dx + node->bounds.origin.x;
+  const float min_y = builder->dy + node->bounds.origin.y;
+  const float max_x = min_x + node->bounds.size.width;
+  const float max_y = min_y + node->bounds.size.height;
+
+  if (layer->texture_id == 0)
+    {
+      const float width = max_x - min_x;
+      const float height = max_y - min_y;
+      int render_target;
+      int prev_render_target;
+      RenderOp op;
+      graphene_matrix_t identity;
+      graphene_matrix_t prev_projection;
+      graphene_matrix_t prev_modelview;
+      graphene_rect_t prev_viewport;
+      graphene_matrix_t item_proj;
+      GskRoundedRect prev_clip;
+
+      /* Unlike the textures add_offscreen_ops() draws to, this one has
+       * to survive until the subtree changes, so it is exempt from the
+       * per-frame texture collection.
+       */
+      layer->texture_id = gsk_gl_driver_create_permanent_texture (self->gl_driver, width, height);
+      gsk_gl_driver_bind_source_texture (self->gl_driver, layer->texture_id);
+      gsk_gl_driver_init_texture_empty (self->gl_driver, layer->texture_id);
+      render_target = gsk_gl_driver_create_render_target (self->gl_driver, layer->texture_id, TRUE, TRUE);
+
+      graphene_matrix_init_ortho (&item_proj,
+                                  min_x, max_x,
+                                  min_y, max_y,
+                                  ORTHO_NEAR_PLANE, ORTHO_FAR_PLANE);
+      graphene_matrix_scale (&item_proj, 1, -1, 1);
+      graphene_matrix_init_identity (&identity);
+
+      prev_render_target = ops_set_render_target (builder, render_target);
+      op.op = OP_CLEAR;
+      ops_add (builder, &op);
+      prev_projection = ops_set_projection (builder, &item_proj);
+      prev_modelview = ops_set_modelview (builder, &identity);
+      prev_viewport = ops_set_viewport (builder, &GRAPHENE_RECT_INIT (min_x, min_y,
+                                                                      width, height));
+      prev_clip = ops_set_clip (builder,
+                                &GSK_ROUNDED_RECT_INIT (min_x, min_y, width, height));
+
+      gsk_gl_renderer_add_render_ops (self, node, builder);
+
+      ops_set_clip (builder, &prev_clip);
+      ops_set_viewport (builder, &prev_viewport);
+      ops_set_modelview (builder, &prev_modelview);
+      ops_set_projection (builder, &prev_projection);
+      ops_set_render_target (builder, prev_render_target);
+    }
+
+  ops_set_program (builder, &self->blit_program);
+  ops_set_texture (builder, layer->texture_id);
+  ops_draw (builder, (GskQuadVertex[GL_N_VERTICES]) {
+    { { min_x, min_y }, { 0, 1 }, },
+    { { min_x, max_y }, { 0, 0 }, },
+    { { max_x, min_y }, { 1, 1 }, },
+
+    { { max_x, max_y }, { 1, 0 }, },
+    { { min_x, max_y }, { 0, 0 }, },
+    { { max_x, min_y }, { 1, 1 }, },
+  });
+}
+
+static void
+gsk_gl_renderer_add_layered_render_ops (GskGLRenderer   *self,
+                                        GskRenderNode   *root,
+                                        RenderOpBuilder *builder)
+{
+  guint i, n_children;
+
+  if (gsk_render_node_get_node_type (root) != GSK_CONTAINER_NODE)
+    {
+      gsk_gl_renderer_add_render_ops (self, root, builder);
+      return;
+    }
+
+  n_children = gsk_container_node_get_n_children (root);
+
+  for (i = n_children; i < self->layers->len; i ++)
+    {
+      CachedLayer *layer = &g_array_index (self->layers, CachedLayer, i);
+
+      gsk_gl_renderer_drop_cached_layer (self, layer);
+      g_clear_pointer (&layer->node, gsk_render_node_unref);
+    }
+  g_array_set_size (self->layers, n_children);
+
+  for (i = 0; i < n_children; i ++)
+    {
+      GskRenderNode *child = gsk_container_node_get_child (root, i);
+      CachedLayer *layer = &g_array_index (self->layers, CachedLayer, i);
+
+      if (layer->node != NULL && node_is_unchanged (layer->node, child))
+        layer->age ++;
+      else
+        gsk_gl_renderer_drop_cached_layer (self, layer);
+
+      /* Like GskRenderer's prev_node, the reference only keeps last
+       * frame's node alive until here; nodes live in double-buffered
+       * arenas, so it must be replaced every frame.
+       */
+      if (layer->node != NULL)
+        gsk_render_node_unref (layer->node);
+      layer->node = gsk_render_node_ref (child);
+
+      if (layer->age >= LAYER_CACHE_MIN_AGE &&
+          child->bounds.size.width > 0 && child->bounds.size.height > 0)
+        gsk_gl_renderer_add_cached_layer_ops (self, builder, child, layer);
+      else
+        gsk_gl_renderer_add_render_ops (self, child, builder);
+    }
+}
+
+/* {{{ Draw call batching
+ *
+ * The op builder already merges consecutive draws with identical state,
+ * but tree order interleaves programs and textures (icon, label, icon,
+ * label, ...), so most runs stay short. The sort pass below reorders
+ * draws within windows of constant "heavy" state (render target, clip,
+ * matrices, viewport, opacity) by program and texture, moving a draw
+ * earlier only past draws whose screen bounds it does not overlap, and
+ * then re-merges adjacent compatible draws into single glDrawArrays
+ * calls.
+ */
+
+typedef struct
+{
+  guint start;                  /* first op of the span */
+  guint n_ops;
+  guint n_vaos;
+  gboolean is_draw;             /* state ops + vertex data + one OP_DRAW */
+  const Program *program;       /* effective state for draw spans */
+  int texture_id;
+  graphene_rect_t bounds;       /* union of the quads, in window-relative space */
+} OpSpan;
+
+static gboolean
+op_is_draw_state (guint kind)
+{
+  switch (kind)
+    {
+    case OP_CHANGE_PROGRAM:
+    case OP_CHANGE_SOURCE_TEXTURE:
+    case OP_CHANGE_COLOR:
+    case OP_CHANGE_LINEAR_GRADIENT:
+    case OP_CHANGE_COLOR_MATRIX:
+    case OP_CHANGE_BLUR:
+    case OP_CHANGE_INSET_SHADOW:
+    case OP_CHANGE_OUTSET_SHADOW:
+    case OP_CHANGE_UNBLURRED_OUTSET_SHADOW:
+    case OP_CHANGE_BORDER:
+    case OP_CHANGE_BORDER_COLOR:
+    case OP_CHANGE_CROSS_FADE:
+      return TRUE;
+    default:
+      return FALSE;
+    }
+}
+
+static void
+op_span_add_vertex_bounds (OpSpan         *span,
+                           const RenderOp *op)
+{
+  float min_x = G_MAXFLOAT, min_y = G_MAXFLOAT;
+  float max_x = -G_MAXFLOAT, max_y = -G_MAXFLOAT;
+  graphene_rect_t rect;
+  int i;
+
+  for (i = 0; i < GL_N_VERTICES; i++)
+    {
+      min_x = MIN (min_x, op->vertex_data[i].position[0]);
+      min_y = MIN (min_y, op->vertex_data[i].position[1]);
+      max_x = MAX (max_x, op->vertex_data[i].position[0]);
+      max_y = MAX (max_y, op->vertex_data[i].position[1]);
+    }
+
+  graphene_rect_init (&rect, min_x, min_y, max_x - min_x, max_y - min_y);
+
+  if (span->n_vaos == 0)
+    span->bounds = rect;
+  else
+    graphene_rect_union (&span->bounds, &rect, &span->bounds);
+}
+
+static gboolean
+op_span_before (const OpSpan *a,
+                const OpSpan *b)
+{
+  if (a->program != b->program)
+    return a->program->index < b->program->index;
+
+  return a->texture_id < b->texture_id;
+}
+
+static void
+gsk_gl_renderer_sort_render_ops (GskGLRenderer *self)
+{
+  GArray *ops = self->render_ops;
+  GArray *spans, *sorted;
+  const Program *cur_program = NULL;
+  int cur_texture = -1;
+  gsize pending_vertices = 0, pending_offset = 0, next_offset = 0;
+  guint i, j, k, window_start;
+
+  spans = g_array_new (FALSE, FALSE, sizeof (OpSpan));
+
+  /* Cut the op stream into spans: draw spans (program/texture/uniform
+   * changes plus vertex data ending in an OP_DRAW) and barrier spans
+   * (everything else, copied through untouched).
+   */
+  i = 0;
+  while (i < ops->len)
+    {
+      OpSpan span = { i, 0, 0, FALSE, cur_program, cur_texture, };
+
+      while (i < ops->len)
+        {
+          const RenderOp *op = &g_array_index (ops, RenderOp, i);
+
+          if (op->op == OP_CHANGE_VAO)
+            op_span_add_vertex_bounds (&span, op);
+          else if (op->op == OP_CHANGE_PROGRAM)
+            span.program = op->program;
+          else if (op->op == OP_CHANGE_SOURCE_TEXTURE)
+            span.texture_id = op->texture_id;
+          else if (!op_is_draw_state (op->op))
+            break;
+
+          if (op->op == OP_CHANGE_VAO)
+            span.n_vaos++;
+          i++;
+        }
+
+      if (span.n_vaos > 0 &&
+          i < ops->len &&
+          g_array_index (ops, RenderOp, i).op == OP_DRAW)
+        {
+          i++;
+          span.is_draw = TRUE;
+          cur_program = span.program;
+          cur_texture = span.texture_id;
+        }
+      else if (i == span.start)
+        {
+          /* Barrier op */
+          i++;
+        }
+      else
+        {
+          /* Trailing state ops without a draw; keep them in place */
+          cur_program = span.program;
+          cur_texture = span.texture_id;
+        }
+
+      span.n_ops = i - span.start;
+      g_array_append_val (spans, span);
+    }
+
+  /* Reorder draw spans inside each window of consecutive draw spans,
+   * never moving a span past one whose quads it overlaps.
+   */
+  window_start = 0;
+  for (i = 0; i <= spans->len; i++)
+    {
+      if (i < spans->len && g_array_index (spans, OpSpan, i).is_draw)
+        continue;
+
+      for (j = window_start + 1; j < i; j++)
+        {
+          OpSpan cur = g_array_index (spans, OpSpan, j);
+
+          for (k = j; k > window_start; k--)
+            {
+              OpSpan *prev = &g_array_index (spans, OpSpan, k - 1);
+
+              if (!op_span_before (&cur, prev) ||
+                  graphene_rect_intersection (&cur.bounds, &prev->bounds, NULL))
+                break;
+
+              g_array_index (spans, OpSpan, k) = *prev;
+            }
+          g_array_index (spans, OpSpan, k) = cur;
+        }
+
+      window_start = i + 1;
+    }
+
+  /* Emit the reordered stream, dropping now-redundant program/texture
+   * changes, keeping draws open while compatible vertex data arrives
+   * and recomputing all vertex buffer offsets.
+   */
+  sorted = g_array_sized_new (FALSE, FALSE, sizeof (RenderOp), ops->len);
+  cur_program = NULL;
+  cur_texture = -1;
+
+  for (i = 0; i < spans->len; i++)
+    {
+      const OpSpan *span = &g_array_index (spans, OpSpan, i);
+      gboolean needs_flush = FALSE;
+
+      if (!span->is_draw)
+        {
+          if (pending_vertices > 0)
+            {
+              RenderOp draw = { OP_DRAW, };
+              draw.draw.vao_offset = pending_offset;
+              draw.draw.vao_size = pending_vertices;
+              g_array_append_val (sorted, draw);
+              pending_vertices = 0;
+            }
+
+          for (j = span->start; j < span->start + span->n_ops; j++)
+            {
+              const RenderOp *op = &g_array_index (ops, RenderOp, j);
+
+              if (op->op == OP_CHANGE_PROGRAM)
+                cur_program = op->program;
+              else if (op->op == OP_CHANGE_SOURCE_TEXTURE)
+                cur_texture = op->texture_id;
+
+              g_array_append_val (sorted, *op);
+            }
+          continue;
+        }
+
+      for (j = span->start; j < span->start + span->n_ops; j++)
+        {
+          const RenderOp *op = &g_array_index (ops, RenderOp, j);
+
+          if (op->op == OP_CHANGE_VAO || op->op == OP_DRAW)
+            continue;
+          if (op->op == OP_CHANGE_PROGRAM && op->program == cur_program)
+            continue;
+          if (op->op == OP_CHANGE_SOURCE_TEXTURE && op->texture_id == cur_texture)
+            continue;
+
+          needs_flush = TRUE;
+          break;
+        }
+
+      if (needs_flush && pending_vertices > 0)
+        {
+          RenderOp draw = { OP_DRAW, };
+          draw.draw.vao_offset = pending_offset;
+          draw.draw.vao_size = pending_vertices;
+          g_array_append_val (sorted, draw);
+          pending_vertices = 0;
+        }
+
+      for (j = span->start; j < span->start + span->n_ops; j++)
+        {
+          const RenderOp *op = &g_array_index (ops, RenderOp, j);
+
+          if (op->op == OP_DRAW)
+            continue;
+
+          if (op->op == OP_CHANGE_VAO)
+            {
+              if (pending_vertices == 0)
+                pending_offset = next_offset;
+              next_offset += GL_N_VERTICES;
+              pending_vertices += GL_N_VERTICES;
+              g_array_append_val (sorted, *op);
+              continue;
+            }
+
+          if (op->op == OP_CHANGE_PROGRAM)
+            {
+              if (op->program == cur_program)
+                continue;
+              cur_program = op->program;
+            }
+          else if (op->op == OP_CHANGE_SOURCE_TEXTURE)
+            {
+              if (op->texture_id == cur_texture)
+                continue;
+              cur_texture = op->texture_id;
+            }
+
+          g_array_append_val (sorted, *op);
+        }
+    }
+
+  if (pending_vertices > 0)
+    {
+      RenderOp draw = { OP_DRAW, };
+      draw.draw.vao_offset = pending_offset;
+      draw.draw.vao_size = pending_vertices;
+      g_array_append_val (sorted, draw);
+    }
+
+  g_array_set_size (ops, 0);
+  g_array_append_vals (ops, sorted->data, sorted->len);
+
+  g_array_free (sorted, TRUE);
+  g_array_free (spans, TRUE);
+}
+
+/* }}} */
+
 static void
 gsk_gl_renderer_render_ops (GskGLRenderer *self,
                             gsize          vertex_data_size)
@@ -2306,8 +3142,13 @@ gsk_gl_renderer_render_ops (GskGLRenderer *self,
           break;
 
         case OP_CHANGE_PROGRAM:
+          if (program != NULL)
+            gsk_gl_profiler_end_scope (self->gl_profiler,
+                                       self->program_scopes[program->index]);
           apply_program_op (program, op);
           program = op->program;
+          gsk_gl_profiler_begin_scope (self->gl_profiler,
+                                       self->program_scopes[program->index]);
           break;
 
         case OP_CHANGE_RENDER_TARGET:
@@ -2391,6 +3232,10 @@ gsk_gl_renderer_render_ops (GskGLRenderer *self,
       OP_PRINT ("\n");
     }
 
+  if (program != NULL)
+    gsk_gl_profiler_end_scope (self->gl_profiler,
+                               self->program_scopes[program->index]);
+
   /* Done drawing, destroy the buffer again.
    * TODO: Can we reuse the memory, though? */
   g_free (vertex_data);
@@ -2451,7 +3296,22 @@ gsk_gl_renderer_do_render (GskRenderer           *renderer,
   if (texture_id != 0)
     ops_set_render_target (&render_op_builder, texture_id);
 
-  gsk_gl_renderer_add_render_ops (self, root, &render_op_builder);
+  /* Only window rendering sees the same tree frame after frame;
+   * render_texture() trees are one-offs and would just churn the
+   * layer cache.
+   */
+  if (texture_id == 0)
+    gsk_gl_renderer_add_layered_render_ops (self, root, &render_op_builder);
+  else
+    gsk_gl_renderer_add_render_ops (self, root, &render_op_builder);
+
+  gsk_gl_renderer_sort_render_ops (self);
+
+  /* All glyphs that this frame's text nodes need are known now; rasterize
+   * and upload them in one batch per atlas instead of stalling the
+   * pipeline with uploads between draw calls.
+   */
+  gsk_gl_glyph_cache_upload_dirty (&self->glyph_cache);
 
   /*g_message ("Ops: %u", self->render_ops->len);*/
 
@@ -2486,7 +3346,26 @@ gsk_gl_renderer_do_render (GskRenderer           *renderer,
   gpu_time = gsk_gl_profiler_end_gpu_region (self->gl_profiler);
   gsk_profiler_timer_set (profiler, self->profile_timers.gpu_time, gpu_time);
 
+  {
+    guint i;
+
+    for (i = 0; i < GL_N_PROGRAMS; i ++)
+      gsk_profiler_timer_set (profiler, self->profile_timers.program_gpu_time[i],
+                              gsk_gl_profiler_get_scope_gpu_time (self->gl_profiler,
+                                                                  self->program_scopes[i]));
+  }
+
   gsk_profiler_push_samples (profiler);
+
+  if (GSK_RENDERER_DEBUG_CHECK (renderer, RENDER_TIMES))
+    {
+      GString *buf = g_string_new (NULL);
+
+      gsk_profiler_append_scopes (profiler, buf);
+      g_print ("%s", buf->str);
+
+      g_string_free (buf, TRUE);
+    }
 #endif
 }
 
@@ -2565,6 +3444,25 @@ gsk_gl_renderer_render (GskRenderer   *renderer,
   gsk_gl_renderer_clear_tree (self);
 }
 
+static GskRendererFeatures
+gsk_gl_renderer_get_features (GskRenderer *renderer)
+{
+  return GSK_RENDERER_FEATURE_CHEAP_BLUR |
+         GSK_RENDERER_FEATURE_CHEAP_OFFSCREEN |
+         GSK_RENDERER_FEATURE_TEXTURE_ATLAS;
+}
+
+static int
+gsk_gl_renderer_get_max_texture_size (GskRenderer *renderer)
+{
+  GskGLRenderer *self = GSK_GL_RENDERER (renderer);
+
+  if (self->gl_driver == NULL)
+    return 0;
+
+  return gsk_gl_driver_get_max_texture_size (self->gl_driver);
+}
+
 static void
 gsk_gl_renderer_class_init (GskGLRendererClass *klass)
 {
@@ -2578,6 +3476,8 @@ gsk_gl_renderer_class_init (GskGLRendererClass *klass)
   renderer_class->begin_draw_frame = gsk_gl_renderer_begin_draw_frame;
   renderer_class->render = gsk_gl_renderer_render;
   renderer_class->render_texture = gsk_gl_renderer_render_texture;
+  renderer_class->get_features = gsk_gl_renderer_get_features;
+  renderer_class->get_max_texture_size = gsk_gl_renderer_get_max_texture_size;
 }
 
 static void
@@ -2586,6 +3486,7 @@ gsk_gl_renderer_init (GskGLRenderer *self)
   gsk_ensure_resources ();
 
   self->render_ops = g_array_new (FALSE, FALSE, sizeof (RenderOp));
+  self->layers = g_array_new (FALSE, TRUE, sizeof (CachedLayer));
 
 #ifdef G_ENABLE_DEBUG
   {
@@ -71,9 +71,6 @@ typedef struct
       int color_offset_location;
     } color_matrix;
     struct {
-      int num_color_stops_location;
-      int color_stops_location;
-      int color_offsets_location;
       int start_point_location;
       int end_point_location;
     } linear_gradient;
@@ -131,9 +128,6 @@ typedef struct
     GskRoundedRect clip;
     graphene_rect_t viewport;
     struct {
-      int n_color_stops;
-      float color_offsets[8];
-      float color_stops[4 * 8];
       graphene_point_t start_point;
       graphene_point_t end_point;
     } linear_gradient;
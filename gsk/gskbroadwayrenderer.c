@@ -8,6 +8,8 @@
 #include "gskrendernodeprivate.h"
 #include "gdk/gdktextureprivate.h"
 
+#include <string.h>
+
 
 struct _GskBroadwayRenderer
 {
@@ -408,6 +410,54 @@ cached_texture_gone (gpointer data,
   g_hash_table_remove (gsk_broadway_node_cache, element->node);
 }
 
+/* The cache holds its key node for as long as the texture stays
+ * alive, which can be many frames, while @node comes out of the
+ * frame's arena. Key the cache on a heap copy instead, so retiring
+ * the frame does not have to wait for the cache.
+ */
+static GskRenderNode *
+node_cache_key_copy (GskRenderNode *node)
+{
+  GskRenderNodeArena *arena;
+  GskRenderNode *copy;
+
+  arena = gsk_render_node_arena_suspend ();
+
+  if (gsk_render_node_get_node_type (node) == GSK_TEXT_NODE)
+    {
+      guint n_glyphs = gsk_text_node_get_num_glyphs (node);
+      PangoGlyphString *glyphs = pango_glyph_string_new ();
+
+      pango_glyph_string_set_size (glyphs, n_glyphs);
+      memcpy (glyphs->glyphs, gsk_text_node_peek_glyphs (node),
+              n_glyphs * sizeof (PangoGlyphInfo));
+      memset (glyphs->log_clusters, 0, n_glyphs * sizeof (int));
+
+      copy = gsk_text_node_new ((PangoFont *) gsk_text_node_peek_font (node),
+                                glyphs,
+                                gsk_text_node_peek_color (node),
+                                gsk_text_node_get_x (node),
+                                gsk_text_node_get_y (node));
+      pango_glyph_string_free (glyphs);
+    }
+  else
+    {
+      GskRenderNode *child = gsk_color_matrix_node_get_child (node);
+      GskRenderNode *texture_node;
+
+      texture_node = gsk_texture_node_new (gsk_texture_node_get_texture (child),
+                                           &child->bounds);
+      copy = gsk_color_matrix_node_new (texture_node,
+                                        gsk_color_matrix_node_peek_color_matrix (node),
+                                        gsk_color_matrix_node_peek_color_offset (node));
+      gsk_render_node_unref (texture_node);
+    }
+
+  gsk_render_node_arena_resume (arena);
+
+  return copy;
+}
+
 static void
 node_cache_store (GskRenderNode *node,
                   GdkTexture *texture,
@@ -423,9 +473,15 @@ node_cache_store (GskRenderNode *node,
       (type == GSK_COLOR_MATRIX_NODE &&
        gsk_render_node_get_node_type (gsk_color_matrix_node_get_child (node)) == GSK_TEXTURE_NODE))
     {
-      NodeCacheElement *element = g_new0 (NodeCacheElement, 1);
+      GskRenderNode *key = node_cache_key_copy (node);
+      NodeCacheElement *element;
+
+      if (key == NULL)
+        return;
+
+      element = g_new0 (NodeCacheElement, 1);
       element->texture = texture;
-      element->node = gsk_render_node_ref (node);
+      element->node = key;
       element->off_x = off_x;
       element->off_y = off_y;
       g_object_weak_ref (G_OBJECT (texture), cached_texture_gone, element);
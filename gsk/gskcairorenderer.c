@@ -7,6 +7,10 @@
 #include "gskrendernodeprivate.h"
 #include "gdk/gdktextureprivate.h"
 
+/* Don't bother splitting the target into bands smaller than this;
+ * the per-band node tree walk has a fixed cost. */
+#define MIN_BAND_HEIGHT 64
+
 #ifdef G_ENABLE_DEBUG
 typedef struct {
   GQuark cpu_time;
@@ -44,6 +48,147 @@ gsk_cairo_renderer_unrealize (GskRenderer *renderer)
 
 }
 
+typedef struct
+{
+  GskRenderNode *root;
+  cairo_surface_t *surface;
+  double x, y;                  /* band origin in user coordinates */
+
+  GMutex *mutex;
+  GCond *cond;
+  guint *n_bands_remaining;
+} GskCairoRenderBand;
+
+static void
+gsk_cairo_renderer_render_band (gpointer data,
+                                gpointer user_data)
+{
+  GskCairoRenderBand *band = data;
+  cairo_t *cr;
+
+  cr = cairo_create (band->surface);
+  cairo_translate (cr, - band->x, - band->y);
+
+  gsk_render_node_draw (band->root, cr);
+
+  cairo_destroy (cr);
+
+  g_mutex_lock (band->mutex);
+  (*band->n_bands_remaining)--;
+  g_cond_signal (band->cond);
+  g_mutex_unlock (band->mutex);
+}
+
+static GThreadPool *
+gsk_cairo_renderer_get_thread_pool (void)
+{
+  static GThreadPool *pool;
+
+  if (g_once_init_enter (&pool))
+    {
+      GThreadPool *the_pool;
+
+      the_pool = g_thread_pool_new (gsk_cairo_renderer_render_band,
+                                    NULL,
+                                    g_get_num_processors (),
+                                    FALSE,
+                                    NULL);
+
+      g_once_init_leave (&pool, the_pool);
+    }
+
+  return pool;
+}
+
+/* Splits the clip area of @cr into horizontal bands that worker
+ * threads render into separate image surfaces, then composites the
+ * results. The node tree is immutable during render, but the draw
+ * path lazily fills shared caches (the shadow corner masks, the
+ * gradient patterns); those take care of their own synchronization,
+ * so the bands only need to coordinate on completion.
+ *
+ * Returns FALSE when the target is too small to be worth tiling,
+ * in which case nothing was drawn.
+ */
+static gboolean
+gsk_cairo_renderer_render_tiled (GskRenderer   *renderer,
+                                 cairo_t       *cr,
+                                 GskRenderNode *root)
+{
+  GskCairoRenderBand *bands;
+  GThreadPool *pool;
+  GMutex mutex;
+  GCond cond;
+  guint n_bands_remaining;
+  double x1, y1, x2, y2;
+  double scale_x, scale_y;
+  int width, height, band_height;
+  guint i, n_bands;
+
+  cairo_clip_extents (cr, &x1, &y1, &x2, &y2);
+  width = ceil (x2) - floor (x1);
+  height = ceil (y2) - floor (y1);
+
+  if (width <= 0 || height < 2 * MIN_BAND_HEIGHT)
+    return FALSE;
+
+  n_bands = MIN (g_get_num_processors (), (guint) (height / MIN_BAND_HEIGHT));
+  if (n_bands < 2)
+    return FALSE;
+
+  cairo_surface_get_device_scale (cairo_get_target (cr), &scale_x, &scale_y);
+
+  band_height = (height + n_bands - 1) / n_bands;
+
+  g_mutex_init (&mutex);
+  g_cond_init (&cond);
+  n_bands_remaining = n_bands;
+
+  pool = gsk_cairo_renderer_get_thread_pool ();
+  bands = g_newa (GskCairoRenderBand, n_bands);
+
+  for (i = 0; i < n_bands; i ++)
+    {
+      GskCairoRenderBand *band = &bands[i];
+      int this_height = MIN (band_height, height - i * band_height);
+
+      band->root = root;
+      band->x = floor (x1);
+      band->y = floor (y1) + i * band_height;
+      band->surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                                  ceil (width * scale_x),
+                                                  ceil (this_height * scale_y));
+      cairo_surface_set_device_scale (band->surface, scale_x, scale_y);
+      band->mutex = &mutex;
+      band->cond = &cond;
+      band->n_bands_remaining = &n_bands_remaining;
+
+      g_thread_pool_push (pool, band, NULL);
+    }
+
+  g_mutex_lock (&mutex);
+  while (n_bands_remaining > 0)
+    g_cond_wait (&cond, &mutex);
+  g_mutex_unlock (&mutex);
+
+  for (i = 0; i < n_bands; i ++)
+    {
+      GskCairoRenderBand *band = &bands[i];
+
+      cairo_save (cr);
+      cairo_set_source_surface (cr, band->surface, band->x, band->y);
+      cairo_paint (cr);
+      cairo_restore (cr);
+
+      cairo_surface_destroy (band->surface);
+    }
+
+  g_mutex_clear (&mutex);
+  g_cond_clear (&cond);
+
+  return TRUE;
+}
+
 static void
 gsk_cairo_renderer_do_render (GskRenderer   *renderer,
                               cairo_t       *cr,
@@ -60,7 +205,8 @@ gsk_cairo_renderer_do_render (GskRenderer   *renderer,
   gsk_profiler_timer_begin (profiler, self->profile_timers.cpu_time);
 #endif
 
-  gsk_render_node_draw (root, cr);
+  if (!gsk_cairo_renderer_render_tiled (renderer, cr, root))
+    gsk_render_node_draw (root, cr);
 
 #ifdef G_ENABLE_DEBUG
   cpu_time = gsk_profiler_timer_end (profiler, self->profile_timers.cpu_time);
@@ -124,6 +270,21 @@ gsk_cairo_renderer_render (GskRenderer   *renderer,
   gsk_cairo_renderer_do_render (renderer, cr, root);
 }
 
+static GskRendererFeatures
+gsk_cairo_renderer_get_features (GskRenderer *renderer)
+{
+  /* Offscreens are plain image surfaces and cheap, but blurs run on
+   * the CPU and there is no texture atlas */
+  return GSK_RENDERER_FEATURE_CHEAP_OFFSCREEN;
+}
+
+static int
+gsk_cairo_renderer_get_max_texture_size (GskRenderer *renderer)
+{
+  /* cairo coordinates are 24.8 fixed point */
+  return 32767;
+}
+
 static void
 gsk_cairo_renderer_class_init (GskCairoRendererClass *klass)
 {
@@ -133,6 +294,8 @@ gsk_cairo_renderer_class_init (GskCairoRendererClass *klass)
   renderer_class->unrealize = gsk_cairo_renderer_unrealize;
   renderer_class->render = gsk_cairo_renderer_render;
   renderer_class->render_texture = gsk_cairo_renderer_render_texture;
+  renderer_class->get_features = gsk_cairo_renderer_get_features;
+  renderer_class->get_max_texture_size = gsk_cairo_renderer_get_max_texture_size;
 }
 
 static void
@@ -175,4 +175,25 @@ typedef enum {
   GSK_SERIALIZATION_INVALID_DATA
 } GskSerializationError;
 
+/**
+ * GskRendererFeatures:
+ * @GSK_RENDERER_FEATURE_CHEAP_BLUR: Blurs are rendered on the GPU and
+ *     are cheap enough to use freely
+ * @GSK_RENDERER_FEATURE_CHEAP_OFFSCREEN: Rendering parts of the scene
+ *     to an offscreen does not involve expensive copies or readbacks
+ * @GSK_RENDERER_FEATURE_TEXTURE_ATLAS: Small textures are packed into
+ *     shared atlases
+ *
+ * Flags describing operations a #GskRenderer can perform cheaply,
+ * for applications that want to adapt their drawing to the renderer
+ * in use. See gsk_renderer_get_features().
+ *
+ * Since: 3.90
+ */
+typedef enum {
+  GSK_RENDERER_FEATURE_CHEAP_BLUR      = 1 << 0,
+  GSK_RENDERER_FEATURE_CHEAP_OFFSCREEN = 1 << 1,
+  GSK_RENDERER_FEATURE_TEXTURE_ATLAS   = 1 << 2
+} GskRendererFeatures;
+
 #endif /* __GSK_TYPES_H__ */
@@ -0,0 +1,330 @@
+#include "config.h"
+
+#include "gskglyphcachesharedprivate.h"
+
+#include <string.h>
+
+#ifdef G_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* A cross-process cache of rasterized glyph bitmaps.
+ *
+ * Every GTK process rasterizes more or less the same glyphs of the
+ * same theme font at the same sizes. The per-renderer glyph caches
+ * (gl/gskglglyphcache.c and vulkan/gskvulkanglyphcache.c) consult
+ * this cache before rasterizing, so only the first process on a
+ * machine pays the cairo rendering cost for a given glyph.
+ *
+ * Rather than a session daemon handing out a memfd, the bitmaps are
+ * appended to a per-user cache file that every process maps read-only;
+ * writers serialize on flock() and the page cache ensures the bitmap
+ * pages exist only once in memory. Records are keyed by
+ * (font description hash, glyph, scale, subpixel shift) and carry
+ * their pixel size, so a hash collision or stale record is detected
+ * and simply treated as a miss.
+ *
+ * The cache is opt-in via GSK_GLYPH_CACHE, since the file grows
+ * monotonically and only a session with many GTK processes amortizes
+ * it. Removing the file is always safe.
+ */
+
+#define GLYPH_CACHE_MAGIC "GSKGLYF1"
+
+typedef struct
+{
+  guint32 font_hash;
+  guint32 glyph;
+  guint32 scale;  /* times 1024 */
+  guint32 xshift; /* quarter pixels, 0 - 3 */
+  gint32 width;
+  gint32 height;
+  gint32 stride;
+  guint32 data_size;
+} GlyphRecord;
+/* ... followed by data_size bytes of ARGB32 pixels */
+
+typedef struct
+{
+  guint32 font_hash;
+  guint32 glyph;
+  guint32 scale;
+  guint32 xshift;
+} SharedKey;
+
+#ifdef G_OS_UNIX
+
+G_LOCK_DEFINE_STATIC (glyph_cache);
+
+static GHashTable *glyph_index;  /* SharedKey -> offset of GlyphRecord */
+static GMappedFile *glyph_map;
+static gsize indexed_size;
+static int glyph_fd = -1;
+static char *glyph_path;
+
+static guint
+shared_key_hash (gconstpointer v)
+{
+  const SharedKey *key = v;
+
+  return key->font_hash ^ key->glyph ^ key->scale ^ (key->xshift << 24);
+}
+
+static gboolean
+shared_key_equal (gconstpointer v1, gconstpointer v2)
+{
+  return memcmp (v1, v2, sizeof (SharedKey)) == 0;
+}
+
+static guint32
+font_hash (PangoFont *font)
+{
+  PangoFontDescription *desc;
+  guint32 hash;
+
+  desc = pango_font_describe (font);
+  hash = pango_font_description_hash (desc);
+  pango_font_description_free (desc);
+
+  return hash;
+}
+
+/* Index the records appended since the last call, remapping the file
+ * if it grew. Earlier records win, so every process agrees on which
+ * copy of a twice-rasterized glyph it uses.
+ */
+static void
+refresh_index (void)
+{
+  struct stat st;
+  const char *data;
+  gsize size, offset;
+  GError *error = NULL;
+
+  if (fstat (glyph_fd, &st) < 0 || (gsize) st.st_size <= indexed_size)
+    return;
+
+  g_clear_pointer (&glyph_map, g_mapped_file_unref);
+  glyph_map = g_mapped_file_new (glyph_path, FALSE, &error);
+  if (glyph_map == NULL)
+    {
+      g_warning ("Failed to map glyph cache: %s", error->message);
+      g_error_free (error);
+      return;
+    }
+
+  data = g_mapped_file_get_contents (glyph_map);
+  size = g_mapped_file_get_length (glyph_map);
+
+  offset = MAX (indexed_size, strlen (GLYPH_CACHE_MAGIC));
+  while (offset + sizeof (GlyphRecord) <= size)
+    {
+      const GlyphRecord *record = (const GlyphRecord *) (data + offset);
+      SharedKey *key;
+
+      if (offset + sizeof (GlyphRecord) + record->data_size > size)
+        break; /* partial append in progress */
+
+      key = g_new0 (SharedKey, 1);
+      key->font_hash = record->font_hash;
+      key->glyph = record->glyph;
+      key->scale = record->scale;
+      key->xshift = record->xshift;
+
+      if (!g_hash_table_contains (glyph_index, key))
+        g_hash_table_insert (glyph_index, key, GSIZE_TO_POINTER (offset));
+      else
+        g_free (key);
+
+      offset += sizeof (GlyphRecord) + record->data_size;
+    }
+
+  indexed_size = offset;
+}
+
+static gboolean
+ensure_glyph_cache (void)
+{
+  static gsize initialized;
+
+  if (g_once_init_enter (&initialized))
+    {
+      if (g_getenv ("GSK_GLYPH_CACHE") != NULL)
+        {
+          char *dir;
+
+          dir = g_build_filename (g_get_user_cache_dir (), "gtk-4.0", NULL);
+          g_mkdir_with_parents (dir, 0755);
+          glyph_path = g_build_filename (dir, "gsk-glyphs.cache", NULL);
+          g_free (dir);
+
+          glyph_fd = open (glyph_path, O_RDWR | O_CREAT | O_APPEND, 0644);
+          if (glyph_fd >= 0)
+            {
+              struct stat st;
+
+              /* The first process writes the magic; everybody else
+               * sees a non-empty file */
+              if (flock (glyph_fd, LOCK_EX) == 0)
+                {
+                  if (fstat (glyph_fd, &st) == 0 && st.st_size == 0)
+                    {
+                      if (write (glyph_fd, GLYPH_CACHE_MAGIC,
+                                 strlen (GLYPH_CACHE_MAGIC)) < 0)
+                        {
+                          close (glyph_fd);
+                          glyph_fd = -1;
+                        }
+                    }
+                  if (glyph_fd >= 0)
+                    flock (glyph_fd, LOCK_UN);
+                }
+
+              if (glyph_fd >= 0)
+                glyph_index = g_hash_table_new_full (shared_key_hash,
+                                                     shared_key_equal,
+                                                     g_free, NULL);
+            }
+        }
+
+      g_once_init_leave (&initialized, 1);
+    }
+
+  return glyph_fd >= 0;
+}
+
+cairo_surface_t *
+gsk_glyph_cache_shared_lookup (PangoFont  *font,
+                               PangoGlyph  glyph,
+                               guint       scale,
+                               guint       xshift,
+                               int         width,
+                               int         height)
+{
+  SharedKey key;
+  const GlyphRecord *record;
+  const char *data;
+  cairo_surface_t *surface;
+  gpointer offset;
+  int y, copy_stride;
+
+  if (!ensure_glyph_cache ())
+    return NULL;
+
+  key.font_hash = font_hash (font);
+  key.glyph = glyph;
+  key.scale = scale;
+  key.xshift = xshift;
+
+  G_LOCK (glyph_cache);
+
+  if (!g_hash_table_lookup_extended (glyph_index, &key, NULL, &offset))
+    {
+      /* Another process may have rasterized it since we last looked */
+      refresh_index ();
+      if (!g_hash_table_lookup_extended (glyph_index, &key, NULL, &offset))
+        {
+          G_UNLOCK (glyph_cache);
+          return NULL;
+        }
+    }
+
+  data = g_mapped_file_get_contents (glyph_map);
+  record = (const GlyphRecord *) (data + GPOINTER_TO_SIZE (offset));
+
+  if (record->width != width ||
+      record->height != height ||
+      record->data_size != record->stride * record->height)
+    {
+      /* Hash collision or stale record; rasterize normally */
+      G_UNLOCK (glyph_cache);
+      return NULL;
+    }
+
+  /* The mapped pixels are not suitably aligned for cairo, so copy
+   * them row by row into a fresh surface */
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+  copy_stride = MIN (record->stride, cairo_image_surface_get_stride (surface));
+  for (y = 0; y < height; y++)
+    memcpy (cairo_image_surface_get_data (surface) +
+              y * cairo_image_surface_get_stride (surface),
+            (const guchar *) (record + 1) + y * record->stride,
+            copy_stride);
+  cairo_surface_mark_dirty (surface);
+
+  G_UNLOCK (glyph_cache);
+
+  return surface;
+}
+
+void
+gsk_glyph_cache_shared_store (PangoFont       *font,
+                              PangoGlyph       glyph,
+                              guint            scale,
+                              guint            xshift,
+                              cairo_surface_t *surface)
+{
+  GlyphRecord record;
+
+  if (!ensure_glyph_cache ())
+    return;
+
+  if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS ||
+      cairo_image_surface_get_format (surface) != CAIRO_FORMAT_ARGB32)
+    return;
+
+  cairo_surface_flush (surface);
+
+  record.font_hash = font_hash (font);
+  record.glyph = glyph;
+  record.scale = scale;
+  record.xshift = xshift;
+  record.width = cairo_image_surface_get_width (surface);
+  record.height = cairo_image_surface_get_height (surface);
+  record.stride = cairo_image_surface_get_stride (surface);
+  record.data_size = record.stride * record.height;
+
+  G_LOCK (glyph_cache);
+
+  if (flock (glyph_fd, LOCK_EX) == 0)
+    {
+      /* The record is picked up by the next refresh_index() */
+      if (write (glyph_fd, &record, sizeof (record)) == sizeof (record))
+        {
+          if (write (glyph_fd, cairo_image_surface_get_data (surface),
+                     record.data_size) != (gssize) record.data_size)
+            g_warning ("Short write to glyph cache; removing %s is safe", glyph_path);
+        }
+      flock (glyph_fd, LOCK_UN);
+    }
+
+  G_UNLOCK (glyph_cache);
+}
+
+#else /* !G_OS_UNIX */
+
+cairo_surface_t *
+gsk_glyph_cache_shared_lookup (PangoFont  *font,
+                               PangoGlyph  glyph,
+                               guint       scale,
+                               guint       xshift,
+                               int         width,
+                               int         height)
+{
+  return NULL;
+}
+
+void
+gsk_glyph_cache_shared_store (PangoFont       *font,
+                              PangoGlyph       glyph,
+                              guint            scale,
+                              guint            xshift,
+                              cairo_surface_t *surface)
+{
+}
+
+#endif /* G_OS_UNIX */
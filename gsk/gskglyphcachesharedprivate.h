@@ -0,0 +1,24 @@
+#ifndef __GSK_GLYPH_CACHE_SHARED_PRIVATE_H__
+#define __GSK_GLYPH_CACHE_SHARED_PRIVATE_H__
+
+#include <cairo.h>
+#include <pango/pango.h>
+
+G_BEGIN_DECLS
+
+cairo_surface_t * gsk_glyph_cache_shared_lookup (PangoFont  *font,
+                                                 PangoGlyph  glyph,
+                                                 guint       scale,
+                                                 guint       xshift,
+                                                 int         width,
+                                                 int         height);
+
+void              gsk_glyph_cache_shared_store  (PangoFont       *font,
+                                                 PangoGlyph       glyph,
+                                                 guint            scale,
+                                                 guint            xshift,
+                                                 cairo_surface_t *surface);
+
+G_END_DECLS
+
+#endif /* __GSK_GLYPH_CACHE_SHARED_PRIVATE_H__ */
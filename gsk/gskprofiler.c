@@ -2,6 +2,8 @@
 
 #include "gskprofilerprivate.h"
 
+#include <string.h>
+
 #define MAX_SAMPLES     32
 
 typedef struct {
@@ -31,6 +33,12 @@ typedef struct {
   gint64 value;
 } Sample;
 
+typedef struct {
+  gsize path_len;
+  gint64 start_time;
+  gint64 child_time;
+} ScopeFrame;
+
 struct _GskProfiler
 {
   GObject parent_instance;
@@ -40,6 +48,14 @@ struct _GskProfiler
 
   Sample timer_samples[MAX_SAMPLES];
   guint last_sample;
+
+  /* Hierarchical scopes; the stack tracks the currently open scopes,
+   * scope_path is the semicolon-joined names of those scopes, and
+   * scope_times accumulates the self time spent in each distinct path
+   */
+  GArray *scope_stack;
+  GString *scope_path;
+  GHashTable *scope_times;
 };
 
 G_DEFINE_TYPE (GskProfiler, gsk_profiler, G_TYPE_OBJECT)
@@ -77,6 +93,9 @@ gsk_profiler_finalize (GObject *gobject)
 
   g_clear_pointer (&self->counters, g_hash_table_unref);
   g_clear_pointer (&self->timers, g_hash_table_unref);
+  g_clear_pointer (&self->scope_times, g_hash_table_unref);
+  g_array_unref (self->scope_stack);
+  g_string_free (self->scope_path, TRUE);
 
   G_OBJECT_CLASS (gsk_profiler_parent_class)->finalize (gobject);
 }
@@ -96,6 +115,11 @@ gsk_profiler_init (GskProfiler *self)
   self->timers = g_hash_table_new_full (g_direct_hash, g_direct_equal,
                                         NULL,
                                         named_timer_free);
+  self->scope_stack = g_array_new (FALSE, FALSE, sizeof (ScopeFrame));
+  self->scope_path = g_string_new (NULL);
+  self->scope_times = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                             g_free,
+                                             g_free);
 }
 
 GskProfiler *
@@ -397,6 +421,8 @@ gsk_profiler_reset (GskProfiler *profiler)
         }
     }
 
+  g_hash_table_remove_all (profiler->scope_times);
+
   profiler->last_sample = 0;
 }
 
@@ -513,3 +539,92 @@ gsk_profiler_append_timers (GskProfiler *profiler,
       g_string_append (buffer, "\n");
     }
 }
+
+void
+gsk_profiler_scope_begin (GskProfiler *profiler,
+                          const char  *name)
+{
+  ScopeFrame frame;
+
+  g_return_if_fail (GSK_IS_PROFILER (profiler));
+  g_return_if_fail (name != NULL);
+
+  frame.path_len = profiler->scope_path->len;
+  frame.start_time = g_get_monotonic_time () * 1000;
+  frame.child_time = 0;
+
+  if (profiler->scope_path->len > 0)
+    g_string_append_c (profiler->scope_path, ';');
+  g_string_append (profiler->scope_path, name);
+
+  g_array_append_val (profiler->scope_stack, frame);
+}
+
+void
+gsk_profiler_scope_end (GskProfiler *profiler)
+{
+  ScopeFrame *frame;
+  gint64 total, self_time;
+  gint64 *accumulated;
+
+  g_return_if_fail (GSK_IS_PROFILER (profiler));
+  g_return_if_fail (profiler->scope_stack->len > 0);
+
+  frame = &g_array_index (profiler->scope_stack, ScopeFrame,
+                          profiler->scope_stack->len - 1);
+
+  total = g_get_monotonic_time () * 1000 - frame->start_time;
+  self_time = total - frame->child_time;
+
+  accumulated = g_hash_table_lookup (profiler->scope_times,
+                                     profiler->scope_path->str);
+  if (accumulated == NULL)
+    {
+      accumulated = g_new0 (gint64, 1);
+      g_hash_table_insert (profiler->scope_times,
+                           g_strdup (profiler->scope_path->str),
+                           accumulated);
+    }
+
+  *accumulated += self_time;
+
+  g_string_truncate (profiler->scope_path, frame->path_len);
+  g_array_set_size (profiler->scope_stack, profiler->scope_stack->len - 1);
+
+  if (profiler->scope_stack->len > 0)
+    {
+      frame = &g_array_index (profiler->scope_stack, ScopeFrame,
+                              profiler->scope_stack->len - 1);
+      frame->child_time += total;
+    }
+}
+
+/* Appends one "path;to;scope <self time in usec>" line per recorded scope
+ * path, i.e. the folded stack format consumed by flamegraph.pl, then
+ * drops the recorded scopes so every dump covers exactly one frame
+ */
+void
+gsk_profiler_append_scopes (GskProfiler *profiler,
+                            GString     *buffer)
+{
+  GList *paths, *l;
+
+  g_return_if_fail (GSK_IS_PROFILER (profiler));
+  g_return_if_fail (buffer != NULL);
+
+  paths = g_hash_table_get_keys (profiler->scope_times);
+  paths = g_list_sort (paths, (GCompareFunc) strcmp);
+
+  for (l = paths; l != NULL; l = l->next)
+    {
+      const char *path = l->data;
+      gint64 *self_time = g_hash_table_lookup (profiler->scope_times, path);
+
+      g_string_append_printf (buffer, "%s %" G_GINT64_FORMAT "\n",
+                              path,
+                              *self_time / 1000);
+    }
+
+  g_list_free (paths);
+  g_hash_table_remove_all (profiler->scope_times);
+}
@@ -41,6 +41,12 @@ gint64          gsk_profiler_counter_get        (GskProfiler *profiler,
 gint64          gsk_profiler_timer_get          (GskProfiler *profiler,
                                                  GQuark       timer_id);
 
+void            gsk_profiler_scope_begin        (GskProfiler *profiler,
+                                                 const char  *name);
+void            gsk_profiler_scope_end          (GskProfiler *profiler);
+void            gsk_profiler_append_scopes      (GskProfiler *profiler,
+                                                 GString     *buffer);
+
 void            gsk_profiler_reset              (GskProfiler *profiler);
 
 void            gsk_profiler_push_samples       (GskProfiler *profiler);
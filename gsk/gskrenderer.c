@@ -31,6 +31,13 @@
  * It is necessary to realize a #GskRenderer instance using gsk_renderer_realize()
  * before calling gsk_renderer_render(), in order to create the appropriate
  * windowing system resources needed to render the scene.
+ *
+ * A renderer must be realized, used and unrealized on the thread that
+ * owns the #GdkWindow it draws to; the begin/end draw frame cycle and
+ * buffer swaps go through GDK, which is not thread-safe. The node trees
+ * passed to gsk_renderer_render() have no such restriction and may be
+ * produced on any thread, see the
+ * [GskRenderNode threading notes][threading].
  */
 
 #include "config.h"
@@ -72,13 +79,28 @@ typedef struct
   GdkWindow *window;
   GdkDrawingContext *drawing_context;
   GskRenderNode *root_node;
+
+  /* Frames alternate between the two arenas, so the previous frame's
+   * tree stays valid for diffing while the current one is assembled.
+   */
+  GskRenderNodeArena *arenas[2];
+  guint current_arena;
+  GskRenderNode *prev_node;
+  cairo_region_t *damage_region;
   GdkDisplay *display;
 
   GskProfiler *profiler;
 
   GskDebugFlags debug_flags;
 
+  /* Render-quality governor state; see gsk_renderer_update_quality() */
+  gint64 quality_frame_counter;
+  guint missed_frames;
+  guint met_frames;
+
   gboolean is_realized : 1;
+  gboolean degraded : 1;
+  gboolean quality_pinned : 1;
 } GskRendererPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (GskRenderer, gsk_renderer, G_TYPE_OBJECT)
@@ -176,6 +198,10 @@ gsk_renderer_dispose (GObject *gobject)
    * So we insist that unrealize must be called before unreffing. */
   g_assert (!priv->is_realized);
 
+  g_clear_pointer (&priv->prev_node, gsk_render_node_unref);
+  g_clear_pointer (&priv->damage_region, cairo_region_destroy);
+  g_clear_pointer (&priv->arenas[0], gsk_render_node_arena_free);
+  g_clear_pointer (&priv->arenas[1], gsk_render_node_arena_free);
   g_clear_object (&priv->profiler);
   g_clear_object (&priv->display);
 
@@ -313,6 +339,7 @@ gsk_renderer_init (GskRenderer *self)
 
   priv->profiler = gsk_profiler_new ();
   priv->debug_flags = gsk_get_debug_flags ();
+  priv->quality_frame_counter = -1;
 }
 
 /**
@@ -455,11 +482,62 @@ gsk_renderer_unrealize (GskRenderer *renderer)
   if (!priv->is_realized)
     return;
 
+  /* The retained tree may reference backend resources */
+  g_clear_pointer (&priv->prev_node, gsk_render_node_unref);
+
   GSK_RENDERER_GET_CLASS (renderer)->unrealize (renderer);
 
   priv->is_realized = FALSE;
 }
 
+/**
+ * gsk_renderer_get_features:
+ * @renderer: a realized #GskRenderer
+ *
+ * Queries flags describing which operations @renderer can perform
+ * cheaply. Applications that choose their drawing strategy at runtime
+ * can use this to avoid expensive effects where the renderer falls
+ * back to slow paths - for example skipping blurs and shadows when
+ * %GSK_RENDERER_FEATURE_CHEAP_BLUR is not set.
+ *
+ * Returns: flags describing the capabilities of @renderer
+ *
+ * Since: 3.90
+ */
+GskRendererFeatures
+gsk_renderer_get_features (GskRenderer *renderer)
+{
+  g_return_val_if_fail (GSK_IS_RENDERER (renderer), 0);
+
+  if (GSK_RENDERER_GET_CLASS (renderer)->get_features)
+    return GSK_RENDERER_GET_CLASS (renderer)->get_features (renderer);
+
+  return 0;
+}
+
+/**
+ * gsk_renderer_get_max_texture_size:
+ * @renderer: a realized #GskRenderer
+ *
+ * Queries the biggest width or height of a texture that @renderer can
+ * handle in one piece; bigger textures have to be sliced or scaled
+ * down, with the corresponding cost.
+ *
+ * Returns: the maximum texture size, or 0 if it is not known yet
+ *
+ * Since: 3.90
+ */
+int
+gsk_renderer_get_max_texture_size (GskRenderer *renderer)
+{
+  g_return_val_if_fail (GSK_IS_RENDERER (renderer), 0);
+
+  if (GSK_RENDERER_GET_CLASS (renderer)->get_max_texture_size)
+    return GSK_RENDERER_GET_CLASS (renderer)->get_max_texture_size (renderer);
+
+  return G_MAXINT;
+}
+
 /**
  * gsk_renderer_render_texture:
  * @renderer: a realized #GdkRenderer
@@ -485,12 +563,17 @@ gsk_renderer_render_texture (GskRenderer           *renderer,
   GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
   graphene_rect_t real_viewport;
   GdkTexture *texture;
+  gboolean was_degraded;
 
   g_return_val_if_fail (GSK_IS_RENDERER (renderer), NULL);
   g_return_val_if_fail (priv->is_realized, NULL);
   g_return_val_if_fail (GSK_IS_RENDER_NODE (root), NULL);
   g_return_val_if_fail (priv->root_node == NULL, NULL);
 
+  /* Off-screen renders (screenshots etc) always use full quality */
+  was_degraded = priv->degraded;
+  priv->degraded = FALSE;
+
   priv->root_node = gsk_render_node_ref (root);
 
   if (viewport == NULL)
@@ -520,9 +603,154 @@ gsk_renderer_render_texture (GskRenderer           *renderer,
 
   g_clear_pointer (&priv->root_node, gsk_render_node_unref);
 
+  priv->degraded = was_degraded;
+
   return texture;
 }
 
+/* Parameters for the render-quality governor.
+ *
+ * Once QUALITY_DEGRADE_MISSES consecutive frames have been presented
+ * later than predicted by more than a quarter refresh interval, the
+ * renderer switches expensive effects (blurs, blurred shadows) to
+ * cheaper approximations; after QUALITY_RESTORE_HITS frames that made
+ * their deadline again, full quality is restored. The asymmetric
+ * thresholds are the hysteresis that keeps the governor from
+ * oscillating right at the break-even point.
+ */
+#define QUALITY_DEGRADE_MISSES 15
+#define QUALITY_RESTORE_HITS 120
+
+static void
+gsk_renderer_update_quality (GskRenderer *renderer)
+{
+  GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
+  GdkFrameClock *frame_clock;
+  gint64 counter, start;
+
+  if (priv->quality_pinned || priv->window == NULL)
+    return;
+
+  frame_clock = gdk_window_get_frame_clock (priv->window);
+  if (frame_clock == NULL)
+    return;
+
+  /* Classify the frames whose timings completed since last time */
+  start = MAX (priv->quality_frame_counter + 1,
+               gdk_frame_clock_get_history_start (frame_clock));
+
+  for (counter = start;
+       counter <= gdk_frame_clock_get_frame_counter (frame_clock);
+       counter++)
+    {
+      GdkFrameTimings *timings;
+      gint64 presentation, predicted, refresh;
+
+      timings = gdk_frame_clock_get_timings (frame_clock, counter);
+      if (timings == NULL || !gdk_frame_timings_get_complete (timings))
+        break;
+
+      priv->quality_frame_counter = counter;
+
+      presentation = gdk_frame_timings_get_presentation_time (timings);
+      predicted = gdk_frame_timings_get_predicted_presentation_time (timings);
+      refresh = gdk_frame_timings_get_refresh_interval (timings);
+
+      if (presentation == 0 || predicted == 0 || refresh == 0)
+        continue;
+
+      if (presentation > predicted + refresh / 4)
+        {
+          priv->missed_frames++;
+          priv->met_frames = 0;
+        }
+      else
+        {
+          priv->met_frames++;
+          priv->missed_frames = 0;
+        }
+    }
+
+  if (!priv->degraded && priv->missed_frames >= QUALITY_DEGRADE_MISSES)
+    {
+      GSK_RENDERER_NOTE (renderer, RENDERER,
+                         g_message ("Sustained frame misses; degrading render quality"));
+      priv->degraded = TRUE;
+      priv->met_frames = 0;
+    }
+  else if (priv->degraded && priv->met_frames >= QUALITY_RESTORE_HITS)
+    {
+      GSK_RENDERER_NOTE (renderer, RENDERER,
+                         g_message ("Deadlines met again; restoring render quality"));
+      priv->degraded = FALSE;
+      priv->missed_frames = 0;
+    }
+}
+
+/*< private >
+ * gsk_renderer_is_degraded:
+ * @renderer: a #GskRenderer
+ *
+ * Whether the render-quality governor currently asks for cheaper
+ * approximations of expensive effects. Renderers consult this while
+ * processing the node tree.
+ *
+ * Returns: %TRUE to use degraded quality
+ */
+gboolean
+gsk_renderer_is_degraded (GskRenderer *renderer)
+{
+  GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
+
+  return priv->degraded;
+}
+
+/**
+ * gsk_renderer_set_quality_pinned:
+ * @renderer: a #GskRenderer
+ * @pinned: whether to pin full render quality
+ *
+ * Pins the renderer to full quality, overriding the governor that
+ * trades effect quality for frame rate when frames repeatedly miss
+ * their deadline. Use this when visual fidelity matters more than
+ * smoothness, e.g. while taking a screenshot or recording.
+ */
+void
+gsk_renderer_set_quality_pinned (GskRenderer *renderer,
+                                 gboolean     pinned)
+{
+  GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
+
+  g_return_if_fail (GSK_IS_RENDERER (renderer));
+
+  priv->quality_pinned = pinned;
+  if (pinned)
+    {
+      priv->degraded = FALSE;
+      priv->missed_frames = 0;
+      priv->met_frames = 0;
+    }
+}
+
+/**
+ * gsk_renderer_get_quality_pinned:
+ * @renderer: a #GskRenderer
+ *
+ * Whether full render quality is pinned. See
+ * gsk_renderer_set_quality_pinned().
+ *
+ * Returns: %TRUE if the quality governor is overridden
+ */
+gboolean
+gsk_renderer_get_quality_pinned (GskRenderer *renderer)
+{
+  GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
+
+  g_return_val_if_fail (GSK_IS_RENDERER (renderer), FALSE);
+
+  return priv->quality_pinned;
+}
+
 /**
  * gsk_renderer_render:
  * @renderer: a #GskRenderer
@@ -549,8 +777,16 @@ gsk_renderer_render (GskRenderer       *renderer,
   g_return_if_fail (GDK_IS_DRAWING_CONTEXT (context));
   g_return_if_fail (context == priv->drawing_context);
 
+  gsk_renderer_update_quality (renderer);
+
   priv->root_node = gsk_render_node_ref (root);
 
+  if (priv->prev_node != NULL)
+    {
+      priv->damage_region = cairo_region_create ();
+      gsk_render_node_diff (priv->prev_node, root, priv->damage_region);
+    }
+
   GSK_RENDERER_GET_CLASS (renderer)->render (renderer, root);
 
 #ifdef G_ENABLE_DEBUG
@@ -570,7 +806,33 @@ gsk_renderer_render (GskRenderer       *renderer,
     }
 #endif
 
-  g_clear_pointer (&priv->root_node, gsk_render_node_unref);
+  /* Keep this frame's tree around for diffing against the next one */
+  g_clear_pointer (&priv->prev_node, gsk_render_node_unref);
+  priv->prev_node = priv->root_node;
+  priv->root_node = NULL;
+}
+
+/*< private >
+ * gsk_renderer_get_damage_region:
+ * @renderer: a #GskRenderer
+ *
+ * During a call to the render() vfunc, returns the region that changed
+ * between the previous frame's node tree and the current one, or %NULL
+ * when no previous frame is available for diffing.
+ *
+ * The region is an overestimation; renderers may use it to restrict
+ * drawing when the target buffer still contains the previous frame.
+ *
+ * Returns: (transfer none) (nullable): the damage region
+ */
+cairo_region_t *
+gsk_renderer_get_damage_region (GskRenderer *renderer)
+{
+  GskRendererPrivate *priv = gsk_renderer_get_instance_private (renderer);
+
+  g_return_val_if_fail (GSK_IS_RENDERER (renderer), NULL);
+
+  return priv->damage_region;
 }
 
 /*< private >
@@ -796,6 +1058,14 @@ gsk_renderer_begin_draw_frame (GskRenderer          *renderer,
 #endif
   priv->drawing_context = GSK_RENDERER_GET_CLASS (renderer)->begin_draw_frame (renderer, region);
 
+  /* All nodes created while the frame is being assembled come out of
+   * one arena, so retiring the frame is a single pointer reset instead
+   * of one free per node.
+   */
+  if (priv->arenas[priv->current_arena] == NULL)
+    priv->arenas[priv->current_arena] = gsk_render_node_arena_new ();
+  gsk_render_node_arena_push (priv->arenas[priv->current_arena]);
+
   return priv->drawing_context;
 }
 
@@ -822,6 +1092,20 @@ gsk_renderer_end_draw_frame (GskRenderer       *renderer,
 
   priv->drawing_context = NULL;
 
+  gsk_render_node_arena_pop (priv->arenas[priv->current_arena]);
+
+  /* The other arena held the frame before last; its tree was released
+   * when prev_node was replaced, so its memory can usually go now. If
+   * something still holds nodes from it - a frame that never made it
+   * to gsk_renderer_render() keeps prev_node alive for one more flip -
+   * the reset defers itself until the arena has drained.
+   */
+  priv->current_arena = !priv->current_arena;
+  if (priv->arenas[priv->current_arena] != NULL)
+    gsk_render_node_arena_reset (priv->arenas[priv->current_arena]);
+
+  g_clear_pointer (&priv->damage_region, cairo_region_destroy);
+
   GSK_RENDERER_GET_CLASS (renderer)->end_draw_frame (renderer, context);
 }
 
@@ -70,6 +70,17 @@ GDK_AVAILABLE_IN_ALL
 void                    gsk_renderer_end_draw_frame             (GskRenderer             *renderer,
                                                                  GdkDrawingContext       *context);
 
+GDK_AVAILABLE_IN_ALL
+void                    gsk_renderer_set_quality_pinned         (GskRenderer             *renderer,
+                                                                 gboolean                 pinned);
+GDK_AVAILABLE_IN_ALL
+gboolean                gsk_renderer_get_quality_pinned         (GskRenderer             *renderer);
+
+GDK_AVAILABLE_IN_ALL
+GskRendererFeatures     gsk_renderer_get_features               (GskRenderer             *renderer);
+GDK_AVAILABLE_IN_ALL
+int                     gsk_renderer_get_max_texture_size       (GskRenderer             *renderer);
+
 G_END_DECLS
 
 #endif /* __GSK_RENDERER_H__ */
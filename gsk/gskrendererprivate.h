@@ -57,6 +57,9 @@ struct _GskRendererClass
                                               cairo_format_t,
                                               int width,
                                               int height);
+
+  GskRendererFeatures (* get_features) (GskRenderer *renderer);
+  int (* get_max_texture_size) (GskRenderer *renderer);
 };
 
 gboolean gsk_renderer_is_realized (GskRenderer *renderer);
@@ -69,6 +72,9 @@ cairo_surface_t *       gsk_renderer_create_cairo_surface       (GskRenderer
                                                                  int             height);
 
 GskProfiler *           gsk_renderer_get_profiler               (GskRenderer    *renderer);
+cairo_region_t *        gsk_renderer_get_damage_region          (GskRenderer    *renderer);
+
+gboolean                gsk_renderer_is_degraded                (GskRenderer   *renderer);
 
 GskDebugFlags           gsk_renderer_get_debug_flags            (GskRenderer   *renderer);
 void                    gsk_renderer_set_debug_flags            (GskRenderer   *renderer,
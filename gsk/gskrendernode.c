@@ -34,6 +34,16 @@
  * to a #GskRenderer it's safe to release any reference you have on them.
  * All #GskRenderNodes are immutable, you can only specify their properties
  * during construction.
+ *
+ * # Threading # {#threading}
+ *
+ * Since render nodes are immutable after construction and reference
+ * counting is atomic, a finished node tree may be referenced, inspected
+ * and released from any thread; in particular a tree built on one
+ * thread can be handed as-is to code running on another. Rendering the
+ * tree is a different matter: a #GskRenderer is tied to a GDK drawing
+ * surface, and must only be used from the thread that owns the
+ * surface's drawing context.
  */
 
 #include "config.h"
@@ -46,6 +56,7 @@
 #include <graphene-gobject.h>
 
 #include <math.h>
+#include <string.h>
 
 #include <gobject/gvaluecollector.h>
 
@@ -61,6 +72,195 @@ G_DEFINE_BOXED_TYPE (GskRenderNode, gsk_render_node,
 
 G_DEFINE_QUARK (gsk-serialization-error-quark, gsk_serialization_error)
 
+/* Render nodes are transient: a frame's worth of nodes is built up,
+ * handed to the renderer and thrown away. GskRenderNodeArena exploits
+ * that by bump-allocating nodes out of large slabs; individual nodes
+ * are never freed, the whole arena is reset once the frame is retired.
+ *
+ * The arena counts its live nodes and a reset is silently deferred
+ * while any remain, so holding a reference past the frame is safe but
+ * keeps the whole arena's memory around. Code that retains a tree for
+ * an indefinite time (caches, offscreen painters) should record it
+ * with the arena suspended, so its nodes live on the heap.
+ */
+
+#define GSK_RENDER_NODE_ARENA_SLAB_SIZE (128 * 1024)
+
+typedef struct _GskRenderNodeArenaSlab GskRenderNodeArenaSlab;
+
+struct _GskRenderNodeArenaSlab
+{
+  GskRenderNodeArenaSlab *next;
+  gsize used;
+  gsize size;
+  /* data follows */
+};
+
+struct _GskRenderNodeArena
+{
+  GskRenderNodeArenaSlab *slabs;
+  GskRenderNodeArena *parent;
+
+  /* Number of nodes allocated from the arena that have not been
+   * finalized yet; while it is nonzero, resetting the arena is
+   * deferred */
+  gint n_live;
+};
+
+static GPrivate current_arena_key = G_PRIVATE_INIT (NULL);
+
+GskRenderNodeArena *
+gsk_render_node_arena_new (void)
+{
+  return g_new0 (GskRenderNodeArena, 1);
+}
+
+static GskRenderNodeArenaSlab *
+gsk_render_node_arena_slab_new (gsize payload)
+{
+  gsize size = MAX (payload, GSK_RENDER_NODE_ARENA_SLAB_SIZE);
+  GskRenderNodeArenaSlab *slab;
+
+  slab = g_malloc (sizeof (GskRenderNodeArenaSlab) + size);
+  slab->next = NULL;
+  slab->used = 0;
+  slab->size = size;
+
+  return slab;
+}
+
+static gpointer
+gsk_render_node_arena_alloc (GskRenderNodeArena *arena,
+                             gsize               size)
+{
+  GskRenderNodeArenaSlab *slab = arena->slabs;
+  gpointer res;
+
+  size = (size + G_MEM_ALIGN - 1) & ~(gsize) (G_MEM_ALIGN - 1);
+
+  if (slab == NULL || slab->size - slab->used < size)
+    {
+      slab = gsk_render_node_arena_slab_new (size);
+      slab->next = arena->slabs;
+      arena->slabs = slab;
+    }
+
+  res = (guchar *) (slab + 1) + slab->used;
+  slab->used += size;
+
+  return memset (res, 0, size);
+}
+
+/*< private >
+ * gsk_render_node_arena_reset:
+ * @arena: a #GskRenderNodeArena
+ *
+ * Reclaims all node memory allocated from @arena in one go.
+ *
+ * If any node allocated from @arena has not been finalized yet — a
+ * cache or a retained previous-frame tree may keep references longer
+ * than expected — nothing is reclaimed and the reset is deferred to a
+ * later call that finds the arena drained.
+ */
+void
+gsk_render_node_arena_reset (GskRenderNodeArena *arena)
+{
+  GskRenderNodeArenaSlab *slab = arena->slabs;
+
+  if (g_atomic_int_get (&arena->n_live) > 0)
+    return;
+
+  /* Keep the first slab around so the next frame starts out warm */
+  if (slab != NULL)
+    {
+      GskRenderNodeArenaSlab *next;
+
+      slab->used = 0;
+
+      for (slab = slab->next; slab != NULL; slab = next)
+        {
+          next = slab->next;
+          g_free (slab);
+        }
+
+      arena->slabs->next = NULL;
+    }
+}
+
+void
+gsk_render_node_arena_free (GskRenderNodeArena *arena)
+{
+  GskRenderNodeArenaSlab *slab, *next;
+
+  /* Finalizing a node after this point would touch freed memory */
+  g_warn_if_fail (g_atomic_int_get (&arena->n_live) == 0);
+
+  for (slab = arena->slabs; slab != NULL; slab = next)
+    {
+      next = slab->next;
+      g_free (slab);
+    }
+
+  g_free (arena);
+}
+
+/*< private >
+ * gsk_render_node_arena_push:
+ * @arena: a #GskRenderNodeArena
+ *
+ * Makes @arena the allocator used by gsk_render_node_new() on the
+ * current thread, until the matching gsk_render_node_arena_pop().
+ */
+void
+gsk_render_node_arena_push (GskRenderNodeArena *arena)
+{
+  arena->parent = g_private_get (&current_arena_key);
+  g_private_set (&current_arena_key, arena);
+}
+
+void
+gsk_render_node_arena_pop (GskRenderNodeArena *arena)
+{
+  g_return_if_fail (g_private_get (&current_arena_key) == arena);
+
+  g_private_set (&current_arena_key, arena->parent);
+  arena->parent = NULL;
+}
+
+/*< private >
+ * gsk_render_node_arena_suspend:
+ *
+ * Takes the current thread's arena (and any arenas pushed below it)
+ * out of service, so that nodes created until the matching
+ * gsk_render_node_arena_resume() are allocated on the heap. Use this
+ * around recording a tree that is meant to outlive the frame, like a
+ * widget's cached render node.
+ *
+ * Returns: (nullable): the suspended arena, to be passed to
+ *     gsk_render_node_arena_resume()
+ */
+GskRenderNodeArena *
+gsk_render_node_arena_suspend (void)
+{
+  GskRenderNodeArena *arena = g_private_get (&current_arena_key);
+
+  g_private_set (&current_arena_key, NULL);
+
+  return arena;
+}
+
+/*< private >
+ * gsk_render_node_arena_resume:
+ * @arena: (nullable): the arena returned by gsk_render_node_arena_suspend()
+ *
+ * Reinstates @arena as the current thread's allocator.
+ */
+void
+gsk_render_node_arena_resume (GskRenderNodeArena *arena)
+{
+  g_private_set (&current_arena_key, arena);
+}
+
 static void
 gsk_render_node_finalize (GskRenderNode *self)
 {
@@ -68,7 +268,13 @@ gsk_render_node_finalize (GskRenderNode *self)
 
   g_clear_pointer (&self->name, g_free);
 
-  g_free (self);
+  /* Arena node memory is reclaimed wholesale when the arena is reset,
+   * which an outstanding count of live nodes holds off until all of
+   * them went through here */
+  if (self->arena != NULL)
+    g_atomic_int_add (&self->arena->n_live, -1);
+  else
+    g_free (self);
 }
 
 /*< private >
@@ -80,12 +286,21 @@ gsk_render_node_finalize (GskRenderNode *self)
 GskRenderNode *
 gsk_render_node_new (const GskRenderNodeClass *node_class, gsize extra_size)
 {
+  GskRenderNodeArena *arena;
   GskRenderNode *self;
 
   g_return_val_if_fail (node_class != NULL, NULL);
   g_return_val_if_fail (node_class->node_type != GSK_NOT_A_RENDER_NODE, NULL);
 
-  self = g_malloc0 (node_class->struct_size + extra_size);
+  arena = g_private_get (&current_arena_key);
+  if (arena != NULL)
+    {
+      self = gsk_render_node_arena_alloc (arena, node_class->struct_size + extra_size);
+      self->arena = arena;
+      g_atomic_int_inc (&arena->n_live);
+    }
+  else
+    self = g_malloc0 (node_class->struct_size + extra_size);
 
   self->node_class = node_class;
 
@@ -164,6 +379,68 @@ gsk_render_node_get_bounds (GskRenderNode   *node,
   graphene_rect_init_from_rect (bounds, &node->bounds);
 }
 
+static void
+rectangle_init_from_graphene (cairo_rectangle_int_t *cairo,
+                              const graphene_rect_t *graphene)
+{
+  cairo->x = floorf (graphene->origin.x);
+  cairo->y = floorf (graphene->origin.y);
+  cairo->width = ceilf (graphene->origin.x + graphene->size.width) - cairo->x;
+  cairo->height = ceilf (graphene->origin.y + graphene->size.height) - cairo->y;
+}
+
+/*< private >
+ * gsk_render_node_diff_impossible:
+ * @node1: a #GskRenderNode
+ * @node2: the #GskRenderNode to compare with
+ * @region: a #cairo_region_t to add to
+ *
+ * Maximally conservative diff: assumes the nodes have nothing in
+ * common and adds both their bounds to @region.
+ */
+void
+gsk_render_node_diff_impossible (GskRenderNode  *node1,
+                                 GskRenderNode  *node2,
+                                 cairo_region_t *region)
+{
+  cairo_rectangle_int_t rect;
+
+  rectangle_init_from_graphene (&rect, &node1->bounds);
+  cairo_region_union_rectangle (region, &rect);
+  rectangle_init_from_graphene (&rect, &node2->bounds);
+  cairo_region_union_rectangle (region, &rect);
+}
+
+/*< private >
+ * gsk_render_node_diff:
+ * @node1: a #GskRenderNode
+ * @node2: the #GskRenderNode to compare with
+ * @region: a #cairo_region_t to add to
+ *
+ * Adds the region that needs to be redrawn when the contents of
+ * @node1 are replaced with the contents of @node2 to @region.
+ *
+ * The computed region is an overestimation; in the worst case the
+ * union of both nodes' bounds is added.
+ */
+void
+gsk_render_node_diff (GskRenderNode  *node1,
+                      GskRenderNode  *node2,
+                      cairo_region_t *region)
+{
+  if (node1 == node2)
+    return;
+
+  if (node1->node_class != node2->node_class ||
+      node1->node_class->diff == NULL)
+    {
+      gsk_render_node_diff_impossible (node1, node2, region);
+      return;
+    }
+
+  node1->node_class->diff (node1, node2, region);
+}
+
 /**
  * gsk_render_node_set_name:
  * @node: a #GskRenderNode
@@ -0,0 +1,728 @@
+/* GSK - The GTK Scene Kit
+ *
+ * Copyright 2018
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* A flat, mmap-able serialization format for render node trees.
+ *
+ * gsk_render_node_serialize() goes through GVariant, which copies every
+ * buffer on both ends and has to be parsed before anything can be drawn.
+ * For frame recording and replay benchmarks we want the opposite
+ * trade-off: a file that can be mapped into memory and whose pixel
+ * payloads can be handed to the GPU upload path without copying.
+ *
+ * The format is a sequence of 8-byte-aligned node records. Each record
+ * starts with a FlatNodeHeader followed by a type-specific payload;
+ * child nodes are written before their parent and referenced by byte
+ * offset. The last record is the root, its offset is in the file
+ * header. Node types without a native flat encoding are embedded as
+ * their GVariant serialization, so the format always round-trips the
+ * full tree.
+ */
+
+#include "config.h"
+
+#include "gskrendernodeflatprivate.h"
+
+#include "gskrendernodeprivate.h"
+#include "gskroundedrectprivate.h"
+
+#include <string.h>
+
+#define GSK_FLAT_MAGIC          0x6b736747      /* 'Gsgk' in little endian */
+#define GSK_FLAT_VERSION        1
+
+/* Record type for nodes embedded as GVariant data */
+#define GSK_FLAT_NODE_VARIANT   0xffffffffu
+
+typedef struct
+{
+  guint32 magic;
+  guint32 version;
+  guint32 root_offset;
+  guint32 size;
+} FlatFileHeader;
+
+typedef struct
+{
+  guint32 type;
+  guint32 size;                 /* size of the full record in bytes */
+  float bounds[4];
+} FlatNodeHeader;
+
+/* {{{ Writer */
+
+static guint32
+flat_write_node (GByteArray    *array,
+                 GskRenderNode *node);
+
+static guint32
+flat_align (GByteArray *array)
+{
+  static const guint8 zeroes[8] = { 0, };
+
+  if (array->len % 8 != 0)
+    g_byte_array_append (array, zeroes, 8 - array->len % 8);
+
+  return array->len;
+}
+
+static guint32
+flat_begin_node (GByteArray    *array,
+                 GskRenderNode *node,
+                 guint32        type)
+{
+  FlatNodeHeader header;
+  graphene_rect_t bounds;
+  guint32 offset;
+
+  offset = flat_align (array);
+
+  gsk_render_node_get_bounds (node, &bounds);
+  header.type = type;
+  header.size = 0; /* fixed up in flat_end_node() */
+  header.bounds[0] = bounds.origin.x;
+  header.bounds[1] = bounds.origin.y;
+  header.bounds[2] = bounds.size.width;
+  header.bounds[3] = bounds.size.height;
+
+  g_byte_array_append (array, (guint8 *) &header, sizeof header);
+
+  return offset;
+}
+
+static guint32
+flat_end_node (GByteArray *array,
+               guint32     offset)
+{
+  FlatNodeHeader *header = (FlatNodeHeader *) (array->data + offset);
+
+  header->size = array->len - offset;
+
+  return offset;
+}
+
+static void
+flat_append (GByteArray    *array,
+             gconstpointer  data,
+             gsize          size)
+{
+  g_byte_array_append (array, data, size);
+}
+
+static guint32
+flat_write_variant_node (GByteArray    *array,
+                         GskRenderNode *node)
+{
+  GVariant *variant = gsk_render_node_serialize_node (node);
+  const char *type_string = g_variant_get_type_string (variant);
+  guint32 lengths[2], offset;
+
+  lengths[0] = strlen (type_string) + 1;
+  lengths[1] = g_variant_get_size (variant);
+
+  offset = flat_begin_node (array, node, GSK_FLAT_NODE_VARIANT);
+  flat_append (array, &(guint32) { gsk_render_node_get_node_type (node) }, 4);
+  flat_append (array, lengths, sizeof lengths);
+  flat_append (array, type_string, lengths[0]);
+  flat_align (array);
+  flat_append (array, g_variant_get_data (variant), lengths[1]);
+
+  g_variant_unref (variant);
+
+  return flat_end_node (array, offset);
+}
+
+static guint32
+flat_write_node (GByteArray    *array,
+                 GskRenderNode *node)
+{
+  GskRenderNodeType type = gsk_render_node_get_node_type (node);
+  guint32 offset;
+
+  switch ((int) type)
+    {
+    case GSK_COLOR_NODE:
+      {
+        const GdkRGBA *color = gsk_color_node_peek_color (node);
+        float rgba[4] = { color->red, color->green, color->blue, color->alpha };
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, rgba, sizeof rgba);
+      }
+      break;
+
+    case GSK_TEXTURE_NODE:
+      {
+        GdkTexture *texture = gsk_texture_node_get_texture (node);
+        guint32 size[2] = { gdk_texture_get_width (texture),
+                            gdk_texture_get_height (texture) };
+        guchar *pixels;
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, size, sizeof size);
+        flat_align (array);
+
+        g_byte_array_set_size (array, array->len + size[0] * size[1] * 4);
+        pixels = array->data + array->len - size[0] * size[1] * 4;
+        gdk_texture_download (texture, pixels, size[0] * 4);
+      }
+      break;
+
+    case GSK_CAIRO_NODE:
+      {
+        cairo_surface_t *surface = (cairo_surface_t *) gsk_cairo_node_peek_surface (node);
+
+        if (surface != NULL &&
+            cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_IMAGE &&
+            cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
+          {
+            guint32 dim[3] = { cairo_image_surface_get_width (surface),
+                               cairo_image_surface_get_height (surface),
+                               cairo_image_surface_get_stride (surface) };
+
+            cairo_surface_flush (surface);
+
+            offset = flat_begin_node (array, node, type);
+            flat_append (array, dim, sizeof dim);
+            flat_align (array);
+            flat_append (array, cairo_image_surface_get_data (surface), dim[1] * dim[2]);
+          }
+        else
+          {
+            return flat_write_variant_node (array, node);
+          }
+      }
+      break;
+
+    case GSK_CONTAINER_NODE:
+      {
+        guint32 n_children = gsk_container_node_get_n_children (node);
+        guint32 *offsets = g_newa (guint32, n_children);
+        guint i;
+
+        for (i = 0; i < n_children; i++)
+          offsets[i] = flat_write_node (array, gsk_container_node_get_child (node, i));
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, &n_children, 4);
+        flat_append (array, offsets, n_children * 4);
+      }
+      break;
+
+    case GSK_TRANSFORM_NODE:
+      {
+        float matrix[16];
+        guint32 child;
+
+        child = flat_write_node (array, gsk_transform_node_get_child (node));
+        graphene_matrix_to_float (gsk_transform_node_peek_transform (node), matrix);
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, matrix, sizeof matrix);
+        flat_append (array, &child, 4);
+      }
+      break;
+
+    case GSK_OPACITY_NODE:
+      {
+        float opacity = gsk_opacity_node_get_opacity (node);
+        guint32 child;
+
+        child = flat_write_node (array, gsk_opacity_node_get_child (node));
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, &opacity, 4);
+        flat_append (array, &child, 4);
+      }
+      break;
+
+    case GSK_CLIP_NODE:
+      {
+        const graphene_rect_t *clip = gsk_clip_node_peek_clip (node);
+        float rect[4] = { clip->origin.x, clip->origin.y,
+                          clip->size.width, clip->size.height };
+        guint32 child;
+
+        child = flat_write_node (array, gsk_clip_node_get_child (node));
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, rect, sizeof rect);
+        flat_append (array, &child, 4);
+      }
+      break;
+
+    case GSK_ROUNDED_CLIP_NODE:
+      {
+        const GskRoundedRect *clip = gsk_rounded_clip_node_peek_clip (node);
+        float rect[12] = { clip->bounds.origin.x, clip->bounds.origin.y,
+                           clip->bounds.size.width, clip->bounds.size.height,
+                           clip->corner[0].width, clip->corner[0].height,
+                           clip->corner[1].width, clip->corner[1].height,
+                           clip->corner[2].width, clip->corner[2].height,
+                           clip->corner[3].width, clip->corner[3].height };
+        guint32 child;
+
+        child = flat_write_node (array, gsk_rounded_clip_node_get_child (node));
+
+        offset = flat_begin_node (array, node, type);
+        flat_append (array, rect, sizeof rect);
+        flat_append (array, &child, 4);
+      }
+      break;
+
+    default:
+      return flat_write_variant_node (array, node);
+    }
+
+  return flat_end_node (array, offset);
+}
+
+/* }}} */
+/* {{{ Reader */
+
+typedef struct
+{
+  GBytes *bytes;
+  const guint8 *data;
+  gsize size;
+} FlatReader;
+
+static GskRenderNode *
+flat_read_node (FlatReader  *reader,
+                guint32      offset,
+                GError     **error);
+
+static gboolean
+flat_reader_check (FlatReader  *reader,
+                   guint32      offset,
+                   gsize        size,
+                   GError     **error)
+{
+  if (offset > reader->size || size > reader->size - offset)
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Node data out of bounds");
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* The smallest payload a record of @type can have; the fixed parts
+ * every reader below dereferences unconditionally. Variable-length
+ * tails (child offset arrays, pixel data, variant data) are checked
+ * separately once their lengths are known.
+ */
+static gsize
+flat_node_min_payload (guint32 type)
+{
+  switch (type)
+    {
+    case GSK_COLOR_NODE:
+      return 4 * sizeof (float);
+    case GSK_TEXTURE_NODE:
+      return 2 * sizeof (guint32);
+    case GSK_CAIRO_NODE:
+      return 3 * sizeof (guint32);
+    case GSK_CONTAINER_NODE:
+      return sizeof (guint32);
+    case GSK_TRANSFORM_NODE:
+      return 16 * sizeof (float) + sizeof (guint32);
+    case GSK_OPACITY_NODE:
+      return sizeof (float) + sizeof (guint32);
+    case GSK_CLIP_NODE:
+      return 4 * sizeof (float) + sizeof (guint32);
+    case GSK_ROUNDED_CLIP_NODE:
+      return 12 * sizeof (float) + sizeof (guint32);
+    case GSK_FLAT_NODE_VARIANT:
+      return 3 * sizeof (guint32) + 1;
+    default:
+      return 0;
+    }
+}
+
+/* Children are written before their parent, so in a well-formed file
+ * child references only ever point backwards. Requiring that here
+ * rules out reference cycles and bounds the recursion depth.
+ */
+static GskRenderNode *
+flat_read_child (FlatReader  *reader,
+                 guint32      offset,
+                 guint32      parent_offset,
+                 GError     **error)
+{
+  if (offset >= parent_offset)
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Child node does not precede its parent");
+      return NULL;
+    }
+
+  return flat_read_node (reader, offset, error);
+}
+
+static void
+flat_reader_bounds (const FlatNodeHeader *header,
+                    graphene_rect_t      *bounds)
+{
+  graphene_rect_init (bounds,
+                      header->bounds[0], header->bounds[1],
+                      header->bounds[2], header->bounds[3]);
+}
+
+static GskRenderNode *
+flat_read_variant_node (FlatReader            *reader,
+                        const FlatNodeHeader  *header,
+                        const guint8          *payload,
+                        GError               **error)
+{
+  guint32 node_type, type_len, data_len;
+  gsize payload_size, data_offset;
+  const char *type_string;
+  const guint8 *data;
+  GVariant *variant;
+  GskRenderNode *node;
+
+  payload_size = header->size - sizeof (FlatNodeHeader);
+
+  node_type = *(const guint32 *) payload;
+  type_len = *(const guint32 *) (payload + 4);
+  data_len = *(const guint32 *) (payload + 8);
+  type_string = (const char *) payload + 12;
+  /* 64-bit arithmetic, so a huge type_len cannot wrap the offset
+   * around to before the bounds check */
+  data_offset = (12 + (gsize) type_len + 7) & ~(gsize) 7;
+
+  if (type_len == 0 ||
+      12 + (gsize) type_len > payload_size ||
+      type_string[type_len - 1] != '\0' ||
+      data_offset > payload_size ||
+      data_len > payload_size - data_offset)
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Embedded variant out of bounds");
+      return NULL;
+    }
+
+  if (!g_variant_type_string_is_valid (type_string))
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Embedded variant has an invalid type");
+      return NULL;
+    }
+
+  data = payload + data_offset;
+
+  /* Refs the GBytes instead of copying the data */
+  variant = g_variant_new_from_data (G_VARIANT_TYPE (type_string),
+                                     data, data_len,
+                                     FALSE,
+                                     (GDestroyNotify) g_bytes_unref,
+                                     g_bytes_ref (reader->bytes));
+  g_variant_ref_sink (variant);
+
+  node = gsk_render_node_deserialize_node (node_type, variant, error);
+
+  g_variant_unref (variant);
+
+  return node;
+}
+
+static GskRenderNode *
+flat_read_node (FlatReader  *reader,
+                guint32      offset,
+                GError     **error)
+{
+  const FlatNodeHeader *header;
+  const guint8 *payload;
+  graphene_rect_t bounds;
+  GskRenderNode *node = NULL;
+  GskRenderNode *child;
+
+  if (!flat_reader_check (reader, offset, sizeof (FlatNodeHeader), error))
+    return NULL;
+
+  header = (const FlatNodeHeader *) (reader->data + offset);
+
+  if (!flat_reader_check (reader, offset, header->size, error))
+    return NULL;
+
+  if (header->size < sizeof (FlatNodeHeader) ||
+      header->size - sizeof (FlatNodeHeader) < flat_node_min_payload (header->type))
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Node record too small for type %u", header->type);
+      return NULL;
+    }
+
+  payload = (const guint8 *) (header + 1);
+  flat_reader_bounds (header, &bounds);
+
+  switch (header->type)
+    {
+    case GSK_COLOR_NODE:
+      {
+        const float *rgba = (const float *) payload;
+
+        node = gsk_color_node_new (&(GdkRGBA) { rgba[0], rgba[1], rgba[2], rgba[3] },
+                                   &bounds);
+      }
+      break;
+
+    case GSK_TEXTURE_NODE:
+      {
+        const guint32 *size = (const guint32 *) payload;
+        const guint8 *pixels = payload + 8;
+        GdkTexture *texture;
+
+        if (size[0] == 0 || size[1] == 0 ||
+            (gsize) size[0] * size[1] > G_MAXSIZE / 4)
+          {
+            g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                         "Texture node with invalid size");
+            return NULL;
+          }
+
+        if (!flat_reader_check (reader, pixels - reader->data,
+                                (gsize) size[0] * size[1] * 4, error))
+          return NULL;
+
+        texture = gdk_texture_new_for_data (pixels, size[0], size[1], size[0] * 4);
+        node = gsk_texture_node_new (texture, &bounds);
+        g_object_unref (texture);
+      }
+      break;
+
+    case GSK_CAIRO_NODE:
+      {
+        const guint32 *dim = (const guint32 *) payload;
+        const guint8 *pixels = payload + ((12 + 7) & ~7u);
+        cairo_surface_t *surface;
+        static cairo_user_data_key_t key;
+
+        if (!flat_reader_check (reader, pixels - reader->data,
+                                (gsize) dim[1] * dim[2], error))
+          return NULL;
+
+        /* Zero-copy: the surface references the mapped data, the
+         * GBytes is kept alive through surface user data.
+         */
+        surface = cairo_image_surface_create_for_data ((guchar *) pixels,
+                                                       CAIRO_FORMAT_ARGB32,
+                                                       dim[0], dim[1], dim[2]);
+        cairo_surface_set_user_data (surface, &key,
+                                     g_bytes_ref (reader->bytes),
+                                     (cairo_destroy_func_t) g_bytes_unref);
+
+        node = gsk_cairo_node_new_for_surface (&bounds, surface);
+        cairo_surface_destroy (surface);
+      }
+      break;
+
+    case GSK_CONTAINER_NODE:
+      {
+        guint32 n_children = *(const guint32 *) payload;
+        const guint32 *offsets = (const guint32 *) (payload + 4);
+        GskRenderNode **children;
+        guint i;
+
+        if (header->size < sizeof (FlatNodeHeader) + 4 + (gsize) n_children * 4)
+          {
+            g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                         "Container children out of bounds");
+            return NULL;
+          }
+
+        children = g_new (GskRenderNode *, n_children);
+        for (i = 0; i < n_children; i++)
+          {
+            children[i] = flat_read_child (reader, offsets[i], offset, error);
+            if (children[i] == NULL)
+              {
+                while (i-- > 0)
+                  gsk_render_node_unref (children[i]);
+                g_free (children);
+                return NULL;
+              }
+          }
+
+        node = gsk_container_node_new (children, n_children);
+
+        for (i = 0; i < n_children; i++)
+          gsk_render_node_unref (children[i]);
+        g_free (children);
+      }
+      break;
+
+    case GSK_TRANSFORM_NODE:
+      {
+        graphene_matrix_t matrix;
+
+        graphene_matrix_init_from_float (&matrix, (const float *) payload);
+
+        child = flat_read_child (reader, *(const guint32 *) (payload + 64), offset, error);
+        if (child == NULL)
+          return NULL;
+
+        node = gsk_transform_node_new (child, &matrix);
+        gsk_render_node_unref (child);
+      }
+      break;
+
+    case GSK_OPACITY_NODE:
+      {
+        child = flat_read_child (reader, *(const guint32 *) (payload + 4), offset, error);
+        if (child == NULL)
+          return NULL;
+
+        node = gsk_opacity_node_new (child, *(const float *) payload);
+        gsk_render_node_unref (child);
+      }
+      break;
+
+    case GSK_CLIP_NODE:
+      {
+        const float *rect = (const float *) payload;
+
+        child = flat_read_child (reader, *(const guint32 *) (payload + 16), offset, error);
+        if (child == NULL)
+          return NULL;
+
+        node = gsk_clip_node_new (child,
+                                  &GRAPHENE_RECT_INIT (rect[0], rect[1], rect[2], rect[3]));
+        gsk_render_node_unref (child);
+      }
+      break;
+
+    case GSK_ROUNDED_CLIP_NODE:
+      {
+        const float *r = (const float *) payload;
+        GskRoundedRect clip;
+
+        gsk_rounded_rect_init (&clip,
+                               &GRAPHENE_RECT_INIT (r[0], r[1], r[2], r[3]),
+                               &GRAPHENE_SIZE_INIT (r[4], r[5]),
+                               &GRAPHENE_SIZE_INIT (r[6], r[7]),
+                               &GRAPHENE_SIZE_INIT (r[8], r[9]),
+                               &GRAPHENE_SIZE_INIT (r[10], r[11]));
+
+        child = flat_read_child (reader, *(const guint32 *) (payload + 48), offset, error);
+        if (child == NULL)
+          return NULL;
+
+        node = gsk_rounded_clip_node_new (child, &clip);
+        gsk_render_node_unref (child);
+      }
+      break;
+
+    case GSK_FLAT_NODE_VARIANT:
+      node = flat_read_variant_node (reader, header, payload, error);
+      break;
+
+    default:
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Unknown node record type %u", header->type);
+      return NULL;
+    }
+
+  return node;
+}
+
+/* }}} */
+
+/*< private >
+ * gsk_render_node_serialize_flat:
+ * @node: a #GskRenderNode
+ *
+ * Serializes @node into the flat binary format, suitable for
+ * gsk_render_node_deserialize_flat().
+ *
+ * Returns: a #GBytes with the flat serialization
+ */
+GBytes *
+gsk_render_node_serialize_flat (GskRenderNode *node)
+{
+  GByteArray *array;
+  FlatFileHeader header;
+  guint32 root;
+
+  g_return_val_if_fail (GSK_IS_RENDER_NODE (node), NULL);
+
+  array = g_byte_array_new ();
+  g_byte_array_set_size (array, sizeof (FlatFileHeader));
+
+  root = flat_write_node (array, node);
+
+  header.magic = GSK_FLAT_MAGIC;
+  header.version = GSK_FLAT_VERSION;
+  header.root_offset = root;
+  header.size = array->len;
+  memcpy (array->data, &header, sizeof header);
+
+  return g_byte_array_free_to_bytes (array);
+}
+
+/*< private >
+ * gsk_render_node_deserialize_flat:
+ * @bytes: the flat serialization of a node tree
+ * @error: return location for an error
+ *
+ * Reconstructs the render node tree serialized with
+ * gsk_render_node_serialize_flat().
+ *
+ * @bytes can come straight from g_mapped_file_get_bytes(); pixel
+ * payloads are used in place without copying, with @bytes kept
+ * alive as long as any node references its data.
+ *
+ * Returns: (transfer full) (nullable): the root node, or %NULL on error
+ */
+GskRenderNode *
+gsk_render_node_deserialize_flat (GBytes  *bytes,
+                                  GError **error)
+{
+  FlatReader reader;
+  const FlatFileHeader *header;
+
+  g_return_val_if_fail (bytes != NULL, NULL);
+
+  reader.bytes = bytes;
+  reader.data = g_bytes_get_data (bytes, &reader.size);
+
+  if (reader.size < sizeof (FlatFileHeader))
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Not enough data for a flat node file");
+      return NULL;
+    }
+
+  header = (const FlatFileHeader *) reader.data;
+
+  if (header->magic != GSK_FLAT_MAGIC)
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_INVALID_DATA,
+                   "Not a flat node file");
+      return NULL;
+    }
+  if (header->version != GSK_FLAT_VERSION)
+    {
+      g_set_error (error, GSK_SERIALIZATION_ERROR, GSK_SERIALIZATION_UNSUPPORTED_VERSION,
+                   "Unsupported flat node file version %u", header->version);
+      return NULL;
+    }
+
+  return flat_read_node (&reader, header->root_offset, error);
+}
@@ -0,0 +1,14 @@
+#ifndef __GSK_RENDER_NODE_FLAT_PRIVATE_H__
+#define __GSK_RENDER_NODE_FLAT_PRIVATE_H__
+
+#include "gskrendernode.h"
+
+G_BEGIN_DECLS
+
+GBytes *        gsk_render_node_serialize_flat   (GskRenderNode  *node);
+GskRenderNode * gsk_render_node_deserialize_flat (GBytes         *bytes,
+                                                  GError        **error);
+
+G_END_DECLS
+
+#endif /* __GSK_RENDER_NODE_FLAT_PRIVATE_H__ */
@@ -26,6 +26,9 @@
 #include "gskroundedrectprivate.h"
 #include "gdk/gdktextureprivate.h"
 
+#include <math.h>
+#include <string.h>
+
 static gboolean
 check_variant_type (GVariant *variant,
                     const char *type_string,
@@ -42,6 +45,16 @@ check_variant_type (GVariant *variant,
   return TRUE;
 }
 
+static void
+rectangle_init_from_graphene (cairo_rectangle_int_t *cairo,
+                              const graphene_rect_t *graphene)
+{
+  cairo->x = floorf (graphene->origin.x);
+  cairo->y = floorf (graphene->origin.y);
+  cairo->width = ceilf (graphene->origin.x + graphene->size.width) - cairo->x;
+  cairo->height = ceilf (graphene->origin.y + graphene->size.height) - cairo->y;
+}
+
 /*** GSK_COLOR_NODE ***/
 
 typedef struct _GskColorNode GskColorNode;
@@ -103,6 +116,21 @@ gsk_color_node_deserialize (GVariant  *variant,
   return gsk_color_node_new (&color, &GRAPHENE_RECT_INIT (x, y, w, h));
 }
 
+static void
+gsk_color_node_diff (GskRenderNode  *node1,
+                     GskRenderNode  *node2,
+                     cairo_region_t *region)
+{
+  GskColorNode *self1 = (GskColorNode *) node1;
+  GskColorNode *self2 = (GskColorNode *) node2;
+
+  if (graphene_rect_equal (&node1->bounds, &node2->bounds) &&
+      gdk_rgba_equal (&self1->color, &self2->color))
+    return;
+
+  gsk_render_node_diff_impossible (node1, node2, region);
+}
+
 static const GskRenderNodeClass GSK_COLOR_NODE_CLASS = {
   GSK_COLOR_NODE,
   sizeof (GskColorNode),
@@ -111,6 +139,7 @@ static const GskRenderNodeClass GSK_COLOR_NODE_CLASS = {
   gsk_color_node_draw,
   gsk_color_node_serialize,
   gsk_color_node_deserialize,
+  gsk_color_node_diff,
 };
 
 const GdkRGBA *
@@ -159,6 +188,8 @@ struct _GskLinearGradientNode
   graphene_point_t start;
   graphene_point_t end;
 
+  cairo_pattern_t *pattern;
+
   gsize n_stops;
   GskColorStop stops[];
 };
@@ -166,6 +197,10 @@ struct _GskLinearGradientNode
 static void
 gsk_linear_gradient_node_finalize (GskRenderNode *node)
 {
+  GskLinearGradientNode *self = (GskLinearGradientNode *) node;
+
+  if (self->pattern)
+    cairo_pattern_destroy (self->pattern);
 }
 
 static void
@@ -173,27 +208,39 @@ gsk_linear_gradient_node_draw (GskRenderNode *node,
                                cairo_t       *cr)
 {
   GskLinearGradientNode *self = (GskLinearGradientNode *) node;
-  cairo_pattern_t *pattern;
-  gsize i;
 
-  pattern = cairo_pattern_create_linear (self->start.x, self->start.y,
-                                         self->end.x, self->end.y);
+  /* Nodes are immutable and get drawn again whenever their area is
+   * damaged, so build the pattern once and keep it; cairo caches the
+   * rasterized gradient ramp per pattern. The tiled cairo renderer
+   * draws the same node from multiple band threads, so the pattern
+   * has to be published with the once-init primitives: a plain store
+   * could expose the pointer before the stops are visible.
+   */
+  if (g_once_init_enter (&self->pattern))
+    {
+      cairo_pattern_t *pattern;
+      gsize i;
 
-  if (gsk_render_node_get_node_type (node) == GSK_REPEATING_LINEAR_GRADIENT_NODE)
-    cairo_pattern_set_extend (pattern, CAIRO_EXTEND_REPEAT);
+      pattern = cairo_pattern_create_linear (self->start.x, self->start.y,
+                                             self->end.x, self->end.y);
 
-  for (i = 0; i < self->n_stops; i++)
-    {
-      cairo_pattern_add_color_stop_rgba (pattern,
-                                         self->stops[i].offset,
-                                         self->stops[i].color.red,
-                                         self->stops[i].color.green,
-                                         self->stops[i].color.blue,
-                                         self->stops[i].color.alpha);
+      if (gsk_render_node_get_node_type (node) == GSK_REPEATING_LINEAR_GRADIENT_NODE)
+        cairo_pattern_set_extend (pattern, CAIRO_EXTEND_REPEAT);
+
+      for (i = 0; i < self->n_stops; i++)
+        {
+          cairo_pattern_add_color_stop_rgba (pattern,
+                                             self->stops[i].offset,
+                                             self->stops[i].color.red,
+                                             self->stops[i].color.green,
+                                             self->stops[i].color.blue,
+                                             self->stops[i].color.alpha);
+        }
+
+      g_once_init_leave (&self->pattern, pattern);
     }
 
-  cairo_set_source (cr, pattern);
-  cairo_pattern_destroy (pattern);
+  cairo_set_source (cr, self->pattern);
 
   cairo_rectangle (cr,
                    node->bounds.origin.x, node->bounds.origin.y,
@@ -749,6 +796,21 @@ gsk_texture_node_deserialize (GVariant  *variant,
   return node;
 }
 
+static void
+gsk_texture_node_diff (GskRenderNode  *node1,
+                       GskRenderNode  *node2,
+                       cairo_region_t *region)
+{
+  GskTextureNode *self1 = (GskTextureNode *) node1;
+  GskTextureNode *self2 = (GskTextureNode *) node2;
+
+  if (graphene_rect_equal (&node1->bounds, &node2->bounds) &&
+      self1->texture == self2->texture)
+    return;
+
+  gsk_render_node_diff_impossible (node1, node2, region);
+}
+
 static const GskRenderNodeClass GSK_TEXTURE_NODE_CLASS = {
   GSK_TEXTURE_NODE,
   sizeof (GskTextureNode),
@@ -756,7 +818,8 @@ static const GskRenderNodeClass GSK_TEXTURE_NODE_CLASS = {
   gsk_texture_node_finalize,
   gsk_texture_node_draw,
   gsk_texture_node_serialize,
-  gsk_texture_node_deserialize
+  gsk_texture_node_deserialize,
+  gsk_texture_node_diff
 };
 
 /**
@@ -897,6 +960,15 @@ corner_mask_equal (CornerMask *mask1,
     mask1->corner.height == mask2->corner.height;
 }
 
+/* The cache is shared between all shadow nodes and the tiled cairo
+ * renderer draws from multiple band threads at once, so every lookup
+ * and insert has to happen under the lock. The cached surfaces are
+ * immutable once inserted and never evicted, so they can be used
+ * after dropping it.
+ */
+static GHashTable *corner_mask_cache = NULL;
+G_LOCK_DEFINE_STATIC (corner_mask_cache);
+
 static void
 draw_shadow_corner (cairo_t               *cr,
                     gboolean               inset,
@@ -915,7 +987,6 @@ draw_shadow_corner (cairo_t               *cr,
   cairo_pattern_t *pattern;
   cairo_matrix_t matrix;
   float sx, sy;
-  static GHashTable *corner_mask_cache = NULL;
   float max_other;
   CornerMask key;
   gboolean overlapped;
@@ -1003,6 +1074,8 @@ draw_shadow_corner (cairo_t               *cr,
    * mask, so we cache rendered masks based on the blur radius and the
    * corner radius.
    */
+  G_LOCK (corner_mask_cache);
+
   if (corner_mask_cache == NULL)
     corner_mask_cache = g_hash_table_new_full ((GHashFunc)corner_mask_hash,
                                                (GEqualFunc)corner_mask_equal,
@@ -1027,6 +1100,8 @@ draw_shadow_corner (cairo_t               *cr,
       g_hash_table_insert (corner_mask_cache, g_memdup (&key, sizeof (key)), mask);
     }
 
+  G_UNLOCK (corner_mask_cache);
+
   gdk_cairo_set_source_rgba (cr, color);
   pattern = cairo_pattern_create_for_surface (mask);
   cairo_matrix_init_identity (&matrix);
@@ -1811,6 +1886,21 @@ gsk_cairo_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static void
+gsk_cairo_node_diff (GskRenderNode  *node1,
+                     GskRenderNode  *node2,
+                     cairo_region_t *region)
+{
+  GskCairoNode *self1 = (GskCairoNode *) node1;
+  GskCairoNode *self2 = (GskCairoNode *) node2;
+
+  if (graphene_rect_equal (&node1->bounds, &node2->bounds) &&
+      self1->surface == self2->surface)
+    return;
+
+  gsk_render_node_diff_impossible (node1, node2, region);
+}
+
 static const GskRenderNodeClass GSK_CAIRO_NODE_CLASS = {
   GSK_CAIRO_NODE,
   sizeof (GskCairoNode),
@@ -1818,7 +1908,8 @@ static const GskRenderNodeClass GSK_CAIRO_NODE_CLASS = {
   gsk_cairo_node_finalize,
   gsk_cairo_node_draw,
   gsk_cairo_node_serialize,
-  gsk_cairo_node_deserialize
+  gsk_cairo_node_deserialize,
+  gsk_cairo_node_diff
 };
 
 const cairo_surface_t *
@@ -2068,6 +2159,25 @@ gsk_container_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static void
+gsk_container_node_diff (GskRenderNode  *node1,
+                         GskRenderNode  *node2,
+                         cairo_region_t *region)
+{
+  GskContainerNode *self1 = (GskContainerNode *) node1;
+  GskContainerNode *self2 = (GskContainerNode *) node2;
+  guint i;
+
+  if (self1->n_children != self2->n_children)
+    {
+      gsk_render_node_diff_impossible (node1, node2, region);
+      return;
+    }
+
+  for (i = 0; i < self1->n_children; i++)
+    gsk_render_node_diff (self1->children[i], self2->children[i], region);
+}
+
 static const GskRenderNodeClass GSK_CONTAINER_NODE_CLASS = {
   GSK_CONTAINER_NODE,
   sizeof (GskContainerNode),
@@ -2075,7 +2185,8 @@ static const GskRenderNodeClass GSK_CONTAINER_NODE_CLASS = {
   gsk_container_node_finalize,
   gsk_container_node_draw,
   gsk_container_node_serialize,
-  gsk_container_node_deserialize
+  gsk_container_node_deserialize,
+  gsk_container_node_diff
 };
 
 /**
@@ -2251,6 +2362,57 @@ gsk_transform_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static gboolean
+matrix_is_integer_translation (const float *m,
+                               int         *dx,
+                               int         *dy)
+{
+  static const float identity[12] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0 };
+
+  if (memcmp (m, identity, sizeof identity) != 0)
+    return FALSE;
+
+  if (floorf (m[12]) != m[12] || floorf (m[13]) != m[13] ||
+      m[14] != 0 || m[15] != 1)
+    return FALSE;
+
+  *dx = m[12];
+  *dy = m[13];
+  return TRUE;
+}
+
+static void
+gsk_transform_node_diff (GskRenderNode  *node1,
+                         GskRenderNode  *node2,
+                         cairo_region_t *region)
+{
+  GskTransformNode *self1 = (GskTransformNode *) node1;
+  GskTransformNode *self2 = (GskTransformNode *) node2;
+  float m1[16], m2[16];
+  int dx, dy;
+
+  graphene_matrix_to_float (&self1->transform, m1);
+  graphene_matrix_to_float (&self2->transform, m2);
+
+  /* We can only turn damage in child coordinates into damage in
+   * node coordinates for pixel-aligned translations; everything
+   * else is treated as a full redraw of both nodes.
+   */
+  if (memcmp (m1, m2, sizeof m1) == 0 &&
+      matrix_is_integer_translation (m1, &dx, &dy))
+    {
+      cairo_region_t *sub = cairo_region_create ();
+
+      gsk_render_node_diff (self1->child, self2->child, sub);
+      cairo_region_translate (sub, dx, dy);
+      cairo_region_union (region, sub);
+      cairo_region_destroy (sub);
+      return;
+    }
+
+  gsk_render_node_diff_impossible (node1, node2, region);
+}
+
 static const GskRenderNodeClass GSK_TRANSFORM_NODE_CLASS = {
   GSK_TRANSFORM_NODE,
   sizeof (GskTransformNode),
@@ -2258,7 +2420,8 @@ static const GskRenderNodeClass GSK_TRANSFORM_NODE_CLASS = {
   gsk_transform_node_finalize,
   gsk_transform_node_draw,
   gsk_transform_node_serialize,
-  gsk_transform_node_deserialize
+  gsk_transform_node_deserialize,
+  gsk_transform_node_diff
 };
 
 /**
@@ -2280,6 +2443,21 @@ gsk_transform_node_new (GskRenderNode           *child,
   g_return_val_if_fail (GSK_IS_RENDER_NODE (child), NULL);
   g_return_val_if_fail (transform != NULL, NULL);
 
+  /* Canonicalize away the no-op transforms and transform chains that
+   * snapshotting tends to produce, so the renderers don't have to walk
+   * them every frame */
+  if (graphene_matrix_is_identity (transform))
+    return gsk_render_node_ref (child);
+
+  if (gsk_render_node_get_node_type (child) == GSK_TRANSFORM_NODE)
+    {
+      GskTransformNode *child_transform = (GskTransformNode *) child;
+      graphene_matrix_t combined;
+
+      graphene_matrix_multiply (&child_transform->transform, transform, &combined);
+      return gsk_transform_node_new (child_transform->child, &combined);
+    }
+
   self = (GskTransformNode *) gsk_render_node_new (&GSK_TRANSFORM_NODE_CLASS, 0);
 
   self->child = gsk_render_node_ref (child);
@@ -2404,6 +2582,20 @@ gsk_opacity_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static void
+gsk_opacity_node_diff (GskRenderNode  *node1,
+                       GskRenderNode  *node2,
+                       cairo_region_t *region)
+{
+  GskOpacityNode *self1 = (GskOpacityNode *) node1;
+  GskOpacityNode *self2 = (GskOpacityNode *) node2;
+
+  if (self1->opacity == self2->opacity)
+    gsk_render_node_diff (self1->child, self2->child, region);
+  else
+    gsk_render_node_diff_impossible (node1, node2, region);
+}
+
 static const GskRenderNodeClass GSK_OPACITY_NODE_CLASS = {
   GSK_OPACITY_NODE,
   sizeof (GskOpacityNode),
@@ -2411,7 +2603,8 @@ static const GskRenderNodeClass GSK_OPACITY_NODE_CLASS = {
   gsk_opacity_node_finalize,
   gsk_opacity_node_draw,
   gsk_opacity_node_serialize,
-  gsk_opacity_node_deserialize
+  gsk_opacity_node_deserialize,
+  gsk_opacity_node_diff
 };
 
 /**
@@ -2432,10 +2625,25 @@ gsk_opacity_node_new (GskRenderNode *child,
 
   g_return_val_if_fail (GSK_IS_RENDER_NODE (child), NULL);
 
+  opacity = CLAMP (opacity, 0.0, 1.0);
+
+  /* Fully opaque nodes draw exactly like their child, and nested
+   * opacities multiply into a single node */
+  if (opacity >= 1.0)
+    return gsk_render_node_ref (child);
+
+  if (gsk_render_node_get_node_type (child) == GSK_OPACITY_NODE)
+    {
+      GskOpacityNode *child_opacity = (GskOpacityNode *) child;
+
+      return gsk_opacity_node_new (child_opacity->child,
+                                   opacity * child_opacity->opacity);
+    }
+
   self = (GskOpacityNode *) gsk_render_node_new (&GSK_OPACITY_NODE_CLASS, 0);
 
   self->child = gsk_render_node_ref (child);
-  self->opacity = CLAMP (opacity, 0.0, 1.0);
+  self->opacity = opacity;
 
   graphene_rect_init_from_rect (&self->render_node.bounds, &child->bounds);
 
@@ -2972,6 +3180,31 @@ gsk_clip_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static void
+gsk_clip_node_diff (GskRenderNode  *node1,
+                    GskRenderNode  *node2,
+                    cairo_region_t *region)
+{
+  GskClipNode *self1 = (GskClipNode *) node1;
+  GskClipNode *self2 = (GskClipNode *) node2;
+
+  if (graphene_rect_equal (&self1->clip, &self2->clip))
+    {
+      cairo_region_t *sub = cairo_region_create ();
+      cairo_rectangle_int_t clip_rect;
+
+      gsk_render_node_diff (self1->child, self2->child, sub);
+      rectangle_init_from_graphene (&clip_rect, &self1->clip);
+      cairo_region_intersect_rectangle (sub, &clip_rect);
+      cairo_region_union (region, sub);
+      cairo_region_destroy (sub);
+    }
+  else
+    {
+      gsk_render_node_diff_impossible (node1, node2, region);
+    }
+}
+
 static const GskRenderNodeClass GSK_CLIP_NODE_CLASS = {
   GSK_CLIP_NODE,
   sizeof (GskClipNode),
@@ -2979,7 +3212,8 @@ static const GskRenderNodeClass GSK_CLIP_NODE_CLASS = {
   gsk_clip_node_finalize,
   gsk_clip_node_draw,
   gsk_clip_node_serialize,
-  gsk_clip_node_deserialize
+  gsk_clip_node_deserialize,
+  gsk_clip_node_diff
 };
 
 /**
@@ -2997,14 +3231,31 @@ gsk_clip_node_new (GskRenderNode         *child,
                    const graphene_rect_t *clip)
 {
   GskClipNode *self;
+  graphene_rect_t normalized;
 
   g_return_val_if_fail (GSK_IS_RENDER_NODE (child), NULL);
   g_return_val_if_fail (clip != NULL, NULL);
 
+  graphene_rect_normalize_r (clip, &normalized);
+
+  /* Clips that don't clip anything disappear, and nested clips merge
+   * into a single node with the intersected rect */
+  if (graphene_rect_contains_rect (&normalized, &child->bounds))
+    return gsk_render_node_ref (child);
+
+  if (gsk_render_node_get_node_type (child) == GSK_CLIP_NODE)
+    {
+      GskClipNode *child_clip = (GskClipNode *) child;
+      graphene_rect_t intersection;
+
+      graphene_rect_intersection (&normalized, &child_clip->clip, &intersection);
+      return gsk_clip_node_new (child_clip->child, &intersection);
+    }
+
   self = (GskClipNode *) gsk_render_node_new (&GSK_CLIP_NODE_CLASS, 0);
 
   self->child = gsk_render_node_ref (child);
-  graphene_rect_normalize_r (clip, &self->clip);
+  graphene_rect_init_from_rect (&self->clip, &normalized);
 
   graphene_rect_intersection (&self->clip, &child->bounds, &self->render_node.bounds);
 
@@ -3133,6 +3384,31 @@ gsk_rounded_clip_node_deserialize (GVariant  *variant,
   return result;
 }
 
+static void
+gsk_rounded_clip_node_diff (GskRenderNode  *node1,
+                            GskRenderNode  *node2,
+                            cairo_region_t *region)
+{
+  GskRoundedClipNode *self1 = (GskRoundedClipNode *) node1;
+  GskRoundedClipNode *self2 = (GskRoundedClipNode *) node2;
+
+  if (memcmp (&self1->clip, &self2->clip, sizeof (GskRoundedRect)) == 0)
+    {
+      cairo_region_t *sub = cairo_region_create ();
+      cairo_rectangle_int_t clip_rect;
+
+      gsk_render_node_diff (self1->child, self2->child, sub);
+      rectangle_init_from_graphene (&clip_rect, &self1->clip.bounds);
+      cairo_region_intersect_rectangle (sub, &clip_rect);
+      cairo_region_union (region, sub);
+      cairo_region_destroy (sub);
+    }
+  else
+    {
+      gsk_render_node_diff_impossible (node1, node2, region);
+    }
+}
+
 static const GskRenderNodeClass GSK_ROUNDED_CLIP_NODE_CLASS = {
   GSK_ROUNDED_CLIP_NODE,
   sizeof (GskRoundedClipNode),
@@ -3140,7 +3416,8 @@ static const GskRenderNodeClass GSK_ROUNDED_CLIP_NODE_CLASS = {
   gsk_rounded_clip_node_finalize,
   gsk_rounded_clip_node_draw,
   gsk_rounded_clip_node_serialize,
-  gsk_rounded_clip_node_deserialize
+  gsk_rounded_clip_node_deserialize,
+  gsk_rounded_clip_node_diff
 };
 
 /**
@@ -3992,14 +4269,34 @@ gsk_text_node_new (PangoFont        *font,
                    double            x,
                    double            y)
 {
-  GskTextNode *self;
   PangoRectangle ink_rect;
 
   pango_glyph_string_extents (glyphs, font, &ink_rect, NULL);
   pango_extents_to_pixels (&ink_rect, NULL);
 
+  return gsk_text_node_new_with_extents (font, glyphs, color, x, y, &ink_rect);
+}
+
+/*< private >
+ * gsk_text_node_new_with_extents:
+ * @ink_rect: the ink extents of @glyphs in @font, in pixels
+ *
+ * Like gsk_text_node_new(), but takes precomputed extents so that
+ * callers which draw the same run over and over (see gskpango.c)
+ * don't have to measure every glyph on every snapshot.
+ */
+GskRenderNode *
+gsk_text_node_new_with_extents (PangoFont            *font,
+                                PangoGlyphString     *glyphs,
+                                const GdkRGBA        *color,
+                                double                x,
+                                double                y,
+                                const PangoRectangle *ink_rect)
+{
+  GskTextNode *self;
+
   /* Don't create nodes with empty bounds */
-  if (ink_rect.width == 0 || ink_rect.height == 0)
+  if (ink_rect->width == 0 || ink_rect->height == 0)
     return NULL;
 
   self = (GskTextNode *) gsk_render_node_new (&GSK_TEXT_NODE_CLASS, sizeof (PangoGlyphInfo) * glyphs->num_glyphs);
@@ -4013,9 +4310,9 @@ gsk_text_node_new (PangoFont        *font,
 
   graphene_rect_init (&self->render_node.bounds,
                       x,
-                      y + ink_rect.y,
-                      ink_rect.x + ink_rect.width,
-                      ink_rect.height);
+                      y + ink_rect->y,
+                      ink_rect->x + ink_rect->width,
+                      ink_rect->height);
 
   return &self->render_node;
 }
@@ -4369,6 +4666,136 @@ gsk_blur_node_get_radius (GskRenderNode *node)
   return self->radius;
 }
 
+static gboolean
+gsk_render_node_compute_opaque (GskRenderNode   *node,
+                                graphene_rect_t *opaque)
+{
+  switch (gsk_render_node_get_node_type (node))
+    {
+    case GSK_COLOR_NODE:
+      if (gsk_color_node_peek_color (node)->alpha < 1.0)
+        return FALSE;
+      *opaque = node->bounds;
+      return TRUE;
+
+    case GSK_CONTAINER_NODE:
+      {
+        /* Keep the largest opaque rectangle any child contributes.
+         * Merging adjacent rectangles would find more, but a single
+         * rectangle is what the common case of a solid background
+         * under smaller children produces.
+         */
+        graphene_rect_t best = GRAPHENE_RECT_INIT (0, 0, 0, 0);
+        guint i;
+
+        for (i = 0; i < gsk_container_node_get_n_children (node); i++)
+          {
+            graphene_rect_t child_opaque;
+
+            if (gsk_render_node_get_opaque_rect (gsk_container_node_get_child (node, i), &child_opaque) &&
+                child_opaque.size.width * child_opaque.size.height >
+                best.size.width * best.size.height)
+              best = child_opaque;
+          }
+
+        if (best.size.width <= 0 || best.size.height <= 0)
+          return FALSE;
+        *opaque = best;
+        return TRUE;
+      }
+
+    case GSK_TRANSFORM_NODE:
+      {
+        double xx, yx, xy, yy, dx, dy;
+
+        /* Only pure translations keep rectangles axis-aligned */
+        if (!graphene_matrix_to_2d (gsk_transform_node_peek_transform (node),
+                                    &xx, &yx, &xy, &yy, &dx, &dy) ||
+            xx != 1.0 || yy != 1.0 || xy != 0.0 || yx != 0.0)
+          return FALSE;
+
+        if (!gsk_render_node_get_opaque_rect (gsk_transform_node_get_child (node), opaque))
+          return FALSE;
+        graphene_rect_offset (opaque, dx, dy);
+        return TRUE;
+      }
+
+    case GSK_OPACITY_NODE:
+      if (gsk_opacity_node_get_opacity (node) < 1.0)
+        return FALSE;
+      return gsk_render_node_get_opaque_rect (gsk_opacity_node_get_child (node), opaque);
+
+    case GSK_CLIP_NODE:
+      if (!gsk_render_node_get_opaque_rect (gsk_clip_node_get_child (node), opaque))
+        return FALSE;
+      return graphene_rect_intersection (gsk_clip_node_peek_clip (node), opaque, opaque);
+
+    case GSK_ROUNDED_CLIP_NODE:
+      {
+        const GskRoundedRect *clip = gsk_rounded_clip_node_peek_clip (node);
+        graphene_rect_t inside;
+
+        /* The largest axis-aligned rectangle inside the rounded
+         * rectangle, found by insetting past the corner radii
+         */
+        inside.origin.x = clip->bounds.origin.x + MAX (clip->corner[GSK_CORNER_TOP_LEFT].width,
+                                                       clip->corner[GSK_CORNER_BOTTOM_LEFT].width);
+        inside.origin.y = clip->bounds.origin.y + MAX (clip->corner[GSK_CORNER_TOP_LEFT].height,
+                                                       clip->corner[GSK_CORNER_TOP_RIGHT].height);
+        inside.size.width = clip->bounds.origin.x + clip->bounds.size.width
+                            - MAX (clip->corner[GSK_CORNER_TOP_RIGHT].width,
+                                   clip->corner[GSK_CORNER_BOTTOM_RIGHT].width)
+                            - inside.origin.x;
+        inside.size.height = clip->bounds.origin.y + clip->bounds.size.height
+                             - MAX (clip->corner[GSK_CORNER_BOTTOM_LEFT].height,
+                                    clip->corner[GSK_CORNER_BOTTOM_RIGHT].height)
+                             - inside.origin.y;
+
+        if (!gsk_render_node_get_opaque_rect (gsk_rounded_clip_node_get_child (node), opaque))
+          return FALSE;
+        return graphene_rect_intersection (&inside, opaque, opaque);
+      }
+
+    default:
+      /* Textures, gradients, cairo surfaces etc. may well be opaque,
+       * but we cannot know without looking at every pixel.
+       */
+      return FALSE;
+    }
+}
+
+/*< private >
+ * gsk_render_node_get_opaque_rect:
+ * @node: a #GskRenderNode
+ * @opaque: (out): return location for the opaque rectangle
+ *
+ * Returns a rectangle that is guaranteed to be covered by fully opaque
+ * pixels when @node is rendered. The result is conservative: pixels
+ * outside of it may be opaque, too.
+ *
+ * The rectangle is computed once and cached, so repeated calls on the
+ * same node - or on ancestors containing it - are cheap.
+ *
+ * Returns: %TRUE if an opaque rectangle is known for @node
+ */
+gboolean
+gsk_render_node_get_opaque_rect (GskRenderNode   *node,
+                                 graphene_rect_t *opaque)
+{
+  if (!node->opaque_valid)
+    {
+      if (!gsk_render_node_compute_opaque (node, &node->opaque))
+        node->opaque = *graphene_rect_zero ();
+      node->opaque_valid = TRUE;
+    }
+
+  if (node->opaque.size.width <= 0 || node->opaque.size.height <= 0)
+    return FALSE;
+
+  *opaque = node->opaque;
+  return TRUE;
+}
+
 static const GskRenderNodeClass *klasses[] = {
   [GSK_CONTAINER_NODE] = &GSK_CONTAINER_NODE_CLASS,
   [GSK_CAIRO_NODE] = &GSK_CAIRO_NODE_CLASS,
@@ -7,6 +7,7 @@
 G_BEGIN_DECLS
 
 typedef struct _GskRenderNodeClass GskRenderNodeClass;
+typedef struct _GskRenderNodeArena GskRenderNodeArena;
 
 #define GSK_IS_RENDER_NODE_TYPE(node,type) (GSK_IS_RENDER_NODE (node) && (node)->node_class->node_type == (type))
 
@@ -16,10 +17,22 @@ struct _GskRenderNode
 
   volatile int ref_count;
 
+  /* The arena this node was allocated from, or %NULL for a node on
+   * the heap */
+  GskRenderNodeArena *arena;
+
+  guint opaque_valid : 1;
+
   /* Use for debugging */
   char *name;
 
   graphene_rect_t bounds;
+
+  /* Largest known rectangle covered by fully opaque pixels, lazily
+   * computed by gsk_render_node_get_opaque_rect(). Empty if none is
+   * known. Nodes are immutable, so the cached value never goes stale.
+   */
+  graphene_rect_t opaque;
 };
 
 struct _GskRenderNodeClass
@@ -34,11 +47,32 @@ struct _GskRenderNodeClass
   GVariant *      (* serialize)   (GskRenderNode  *node);
   GskRenderNode * (* deserialize) (GVariant       *variant,
                                    GError        **error);
+  void            (* diff)        (GskRenderNode  *node1,
+                                   GskRenderNode  *node2,
+                                   cairo_region_t *region);
 };
 
 GskRenderNode * gsk_render_node_new              (const GskRenderNodeClass  *node_class,
                                                   gsize                      extra_size);
 
+GskRenderNodeArena *    gsk_render_node_arena_new   (void);
+void                    gsk_render_node_arena_free  (GskRenderNodeArena *arena);
+void                    gsk_render_node_arena_push  (GskRenderNodeArena *arena);
+void                    gsk_render_node_arena_pop   (GskRenderNodeArena *arena);
+void                    gsk_render_node_arena_reset (GskRenderNodeArena *arena);
+GskRenderNodeArena *    gsk_render_node_arena_suspend (void);
+void                    gsk_render_node_arena_resume  (GskRenderNodeArena *arena);
+
+gboolean        gsk_render_node_get_opaque_rect  (GskRenderNode             *node,
+                                                  graphene_rect_t           *opaque);
+
+void            gsk_render_node_diff             (GskRenderNode             *node1,
+                                                  GskRenderNode             *node2,
+                                                  cairo_region_t            *region);
+void            gsk_render_node_diff_impossible  (GskRenderNode             *node1,
+                                                  GskRenderNode             *node2,
+                                                  cairo_region_t            *region);
+
 GVariant *      gsk_render_node_serialize_node   (GskRenderNode             *node);
 GskRenderNode * gsk_render_node_deserialize_node (GskRenderNodeType          type,
                                                   GVariant                  *variant,
@@ -47,6 +81,13 @@ GskRenderNode * gsk_render_node_deserialize_node (GskRenderNodeType          typ
 GskRenderNode * gsk_cairo_node_new_for_surface   (const graphene_rect_t    *bounds,
                                                   cairo_surface_t          *surface);
 
+GskRenderNode * gsk_text_node_new_with_extents   (PangoFont                *font,
+                                                  PangoGlyphString         *glyphs,
+                                                  const GdkRGBA            *color,
+                                                  double                    x,
+                                                  double                    y,
+                                                  const PangoRectangle     *ink_rect);
+
 G_END_DECLS
 
 #endif /* __GSK_RENDER_NODE_PRIVATE_H__ */
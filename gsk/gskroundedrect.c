@@ -42,37 +42,43 @@
 static void
 gsk_rounded_rect_normalize_in_place (GskRoundedRect *self)
 {
+  graphene_simd4f_t c01, c23, factor4;
   float factor = 1.0;
   float corners;
-  guint i;
+  float c[8];
 
   graphene_rect_normalize (&self->bounds);
 
-  for (i = 0; i < 4; i++)
-    {
-      self->corner[i].width = MAX (self->corner[i].width, 0);
-      self->corner[i].height = MAX (self->corner[i].height, 0);
-    }
-
-  /* clamp border radius, following CSS specs */
-  corners = self->corner[GSK_CORNER_TOP_LEFT].width + self->corner[GSK_CORNER_TOP_RIGHT].width;
+  /* The corner sizes are 8 consecutive floats, so clamping them to
+   * positive values is two 4-wide operations. */
+  c01 = graphene_simd4f_max (graphene_simd4f_init_4f (&self->corner[0].width),
+                             graphene_simd4f_init_zero ());
+  c23 = graphene_simd4f_max (graphene_simd4f_init_4f (&self->corner[2].width),
+                             graphene_simd4f_init_zero ());
+  graphene_simd4f_dup_4f (c01, c);
+  graphene_simd4f_dup_4f (c23, c + 4);
+
+  /* clamp border radius, following CSS specs;
+   * c holds { w0, h0, w1, h1, w2, h2, w3, h3 } in corner order */
+  corners = c[2 * GSK_CORNER_TOP_LEFT] + c[2 * GSK_CORNER_TOP_RIGHT];
   if (corners > self->bounds.size.width)
     factor = MIN (factor, self->bounds.size.width / corners);
 
-  corners = self->corner[GSK_CORNER_TOP_RIGHT].height + self->corner[GSK_CORNER_BOTTOM_RIGHT].height;
+  corners = c[2 * GSK_CORNER_TOP_RIGHT + 1] + c[2 * GSK_CORNER_BOTTOM_RIGHT + 1];
   if (corners > self->bounds.size.height)
     factor = MIN (factor, self->bounds.size.height / corners);
 
-  corners = self->corner[GSK_CORNER_BOTTOM_RIGHT].width + self->corner[GSK_CORNER_BOTTOM_LEFT].width;
+  corners = c[2 * GSK_CORNER_BOTTOM_RIGHT] + c[2 * GSK_CORNER_BOTTOM_LEFT];
   if (corners > self->bounds.size.width)
     factor = MIN (factor, self->bounds.size.width / corners);
 
-  corners = self->corner[GSK_CORNER_TOP_LEFT].height + self->corner[GSK_CORNER_BOTTOM_LEFT].height;
+  corners = c[2 * GSK_CORNER_TOP_LEFT + 1] + c[2 * GSK_CORNER_BOTTOM_LEFT + 1];
   if (corners > self->bounds.size.height)
     factor = MIN (factor, self->bounds.size.height / corners);
 
-  for (i = 0; i < 4; i++)
-    graphene_size_scale (&self->corner[i], factor, &self->corner[i]);
+  factor4 = graphene_simd4f_splat (factor);
+  graphene_simd4f_dup_4f (graphene_simd4f_mul (c01, factor4), &self->corner[0].width);
+  graphene_simd4f_dup_4f (graphene_simd4f_mul (c23, factor4), &self->corner[2].width);
 }
 
 /**
@@ -310,12 +316,87 @@ gsk_rounded_rect_is_rectilinear (const GskRoundedRect *self)
   return TRUE;
 }
 
+/* The four corner ellipse tests of the containment functions map onto
+ * 4-wide SIMD with one lane per corner. The ellipse equation
+ * (dx/w)² + (dy/h)² <= 1 is cross-multiplied to dx²h² + dy²w² <= w²h²
+ * so that square corners come out as 0 <= 0 instead of dividing by
+ * zero, and dx/dy are clamped to 0 outside the corner area so that the
+ * straight parts of the border always pass.
+ */
+typedef struct
+{
+  graphene_simd4f_t center_x;   /* corner ellipse centers */
+  graphene_simd4f_t center_y;
+  graphene_simd4f_t sign_x;     /* direction towards the corner */
+  graphene_simd4f_t sign_y;
+  graphene_simd4f_t width_2;    /* squared corner radii */
+  graphene_simd4f_t height_2;
+  graphene_simd4f_t limit;      /* width² * height² */
+} CornerEllipses;
+
+static void
+corner_ellipses_init (CornerEllipses       *ce,
+                      const GskRoundedRect *self)
+{
+  const graphene_rect_t *b = &self->bounds;
+  const graphene_size_t *c = self->corner;
+  graphene_simd4f_t w, h;
+
+  ce->center_x = graphene_simd4f_init (b->origin.x + c[GSK_CORNER_TOP_LEFT].width,
+                                       b->origin.x + b->size.width - c[GSK_CORNER_TOP_RIGHT].width,
+                                       b->origin.x + b->size.width - c[GSK_CORNER_BOTTOM_RIGHT].width,
+                                       b->origin.x + c[GSK_CORNER_BOTTOM_LEFT].width);
+  ce->center_y = graphene_simd4f_init (b->origin.y + c[GSK_CORNER_TOP_LEFT].height,
+                                       b->origin.y + c[GSK_CORNER_TOP_RIGHT].height,
+                                       b->origin.y + b->size.height - c[GSK_CORNER_BOTTOM_RIGHT].height,
+                                       b->origin.y + b->size.height - c[GSK_CORNER_BOTTOM_LEFT].height);
+  ce->sign_x = graphene_simd4f_init (1, -1, -1, 1);
+  ce->sign_y = graphene_simd4f_init (1, 1, -1, -1);
+
+  w = graphene_simd4f_init (c[GSK_CORNER_TOP_LEFT].width,
+                            c[GSK_CORNER_TOP_RIGHT].width,
+                            c[GSK_CORNER_BOTTOM_RIGHT].width,
+                            c[GSK_CORNER_BOTTOM_LEFT].width);
+  h = graphene_simd4f_init (c[GSK_CORNER_TOP_LEFT].height,
+                            c[GSK_CORNER_TOP_RIGHT].height,
+                            c[GSK_CORNER_BOTTOM_RIGHT].height,
+                            c[GSK_CORNER_BOTTOM_LEFT].height);
+  ce->width_2 = graphene_simd4f_mul (w, w);
+  ce->height_2 = graphene_simd4f_mul (h, h);
+  ce->limit = graphene_simd4f_mul (ce->width_2, ce->height_2);
+}
+
+/* Assumes the point was already checked against the bounds */
+static gboolean
+corner_ellipses_contain_point (const CornerEllipses   *ce,
+                               const graphene_point_t *point)
+{
+  graphene_simd4f_t zero = graphene_simd4f_init_zero ();
+  graphene_simd4f_t dx, dy;
+
+  dx = graphene_simd4f_mul (graphene_simd4f_sub (ce->center_x,
+                                                 graphene_simd4f_splat (point->x)),
+                            ce->sign_x);
+  dy = graphene_simd4f_mul (graphene_simd4f_sub (ce->center_y,
+                                                 graphene_simd4f_splat (point->y)),
+                            ce->sign_y);
+  dx = graphene_simd4f_max (dx, zero);
+  dy = graphene_simd4f_max (dy, zero);
+
+  return graphene_simd4f_cmp_le (graphene_simd4f_add (graphene_simd4f_mul (graphene_simd4f_mul (dx, dx), ce->height_2),
+                                                      graphene_simd4f_mul (graphene_simd4f_mul (dy, dy), ce->width_2)),
+                                 ce->limit);
+}
+
+/* Assumes the rect was already checked against the bounds */
 static gboolean
-ellipsis_contains_point (const graphene_size_t *ellipsis,
-                         const graphene_point_t *point)
+corner_ellipses_contain_rect (const CornerEllipses  *ce,
+                              const graphene_rect_t *rect)
 {
-  return (point->x * point->x) / (ellipsis->width * ellipsis->width)
-       + (point->y * point->y) / (ellipsis->height * ellipsis->height) <= 1;
+  return corner_ellipses_contain_point (ce, &rect->origin) &&
+         corner_ellipses_contain_point (ce, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y)) &&
+         corner_ellipses_contain_point (ce, &GRAPHENE_POINT_INIT (rect->origin.x, rect->origin.y + rect->size.height)) &&
+         corner_ellipses_contain_point (ce, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y + rect->size.height));
 }
 
 /**
@@ -332,46 +413,14 @@ gboolean
 gsk_rounded_rect_contains_point (const GskRoundedRect   *self,
                                  const graphene_point_t *point)
 {
-  if (!graphene_rect_contains_point (&self->bounds, point))
-    return FALSE;
-
-  if (self->bounds.origin.x + self->corner[GSK_CORNER_TOP_LEFT].width > point->x &&
-      self->bounds.origin.y + self->corner[GSK_CORNER_TOP_LEFT].height > point->y &&
-      !ellipsis_contains_point (&self->corner[GSK_CORNER_TOP_LEFT],
-                                &GRAPHENE_POINT_INIT (
-                                    self->bounds.origin.x + self->corner[GSK_CORNER_TOP_LEFT].width - point->x,
-                                    self->bounds.origin.y + self->corner[GSK_CORNER_TOP_LEFT].height- point->y
-                                )))
-    return FALSE;
+  CornerEllipses ce;
 
-  if (self->bounds.origin.x + self->bounds.size.width - self->corner[GSK_CORNER_TOP_RIGHT].width < point->x &&
-      self->bounds.origin.y + self->corner[GSK_CORNER_TOP_RIGHT].height > point->y &&
-      !ellipsis_contains_point (&self->corner[GSK_CORNER_TOP_RIGHT],
-                                &GRAPHENE_POINT_INIT (
-                                    self->bounds.origin.x + self->bounds.size.width - self->corner[GSK_CORNER_TOP_RIGHT].width - point->x,
-                                    self->bounds.origin.y + self->corner[GSK_CORNER_TOP_RIGHT].height- point->y
-                                )))
+  if (!graphene_rect_contains_point (&self->bounds, point))
     return FALSE;
 
-  if (self->bounds.origin.x + self->corner[GSK_CORNER_BOTTOM_LEFT].width > point->x &&
-      self->bounds.origin.y + self->bounds.size.height - self->corner[GSK_CORNER_BOTTOM_LEFT].height < point->y &&
-      !ellipsis_contains_point (&self->corner[GSK_CORNER_BOTTOM_LEFT],
-                                &GRAPHENE_POINT_INIT (
-                                    self->bounds.origin.x + self->corner[GSK_CORNER_BOTTOM_LEFT].width - point->x,
-                                    self->bounds.origin.y + self->bounds.size.height - self->corner[GSK_CORNER_BOTTOM_LEFT].height- point->y
-                                )))
-    return FALSE;
+  corner_ellipses_init (&ce, self);
 
-  if (self->bounds.origin.x + self->bounds.size.width - self->corner[GSK_CORNER_BOTTOM_RIGHT].width < point->x &&
-      self->bounds.origin.y + self->bounds.size.height - self->corner[GSK_CORNER_BOTTOM_RIGHT].height < point->y &&
-      !ellipsis_contains_point (&self->corner[GSK_CORNER_BOTTOM_RIGHT],
-                                &GRAPHENE_POINT_INIT (
-                                    self->bounds.origin.x + self->bounds.size.width - self->corner[GSK_CORNER_BOTTOM_RIGHT].width - point->x,
-                                    self->bounds.origin.y + self->bounds.size.height - self->corner[GSK_CORNER_BOTTOM_RIGHT].height- point->y
-                                )))
-    return FALSE;
-
-  return TRUE;
+  return corner_ellipses_contain_point (&ce, point);
 }
 
 /**
@@ -389,16 +438,14 @@ gboolean
 gsk_rounded_rect_contains_rect (const GskRoundedRect  *self,
                                 const graphene_rect_t *rect)
 {
+  CornerEllipses ce;
+
   if (!graphene_rect_contains_rect (&self->bounds, rect))
     return FALSE;
 
-  if (!gsk_rounded_rect_contains_point (self, &rect->origin) ||
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y)) ||
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x, rect->origin.y + rect->size.height)) ||
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y + rect->size.height)))
-    return FALSE;
+  corner_ellipses_init (&ce, self);
 
-  return TRUE;
+  return corner_ellipses_contain_rect (&ce, rect);
 }
 
 /**
@@ -416,16 +463,61 @@ gboolean
 gsk_rounded_rect_intersects_rect (const GskRoundedRect  *self,
                                   const graphene_rect_t *rect)
 {
+  CornerEllipses ce;
+
   if (!graphene_rect_intersection (&self->bounds, rect, NULL))
     return FALSE;
 
-  if (!gsk_rounded_rect_contains_point (self, &rect->origin) &&
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y)) &&
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x, rect->origin.y + rect->size.height)) &&
-      !gsk_rounded_rect_contains_point (self, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y + rect->size.height)))
-    return FALSE;
+  corner_ellipses_init (&ce, self);
 
-  return TRUE;
+  if ((graphene_rect_contains_point (&self->bounds, &rect->origin) &&
+       corner_ellipses_contain_point (&ce, &rect->origin)) ||
+      (graphene_rect_contains_point (&self->bounds, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y)) &&
+       corner_ellipses_contain_point (&ce, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y))) ||
+      (graphene_rect_contains_point (&self->bounds, &GRAPHENE_POINT_INIT (rect->origin.x, rect->origin.y + rect->size.height)) &&
+       corner_ellipses_contain_point (&ce, &GRAPHENE_POINT_INIT (rect->origin.x, rect->origin.y + rect->size.height))) ||
+      (graphene_rect_contains_point (&self->bounds, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y + rect->size.height)) &&
+       corner_ellipses_contain_point (&ce, &GRAPHENE_POINT_INIT (rect->origin.x + rect->size.width, rect->origin.y + rect->size.height))))
+    return TRUE;
+
+  return FALSE;
+}
+
+/*< private >
+ * gsk_rounded_rect_classify_rects:
+ * @self: a #GskRoundedRect
+ * @rects: the rectangles to classify
+ * @n_rects: the number of rectangles
+ * @out_coverage: return location for one coverage value per rectangle
+ *
+ * Classifies many rectangles against @self in a single call.
+ *
+ * This is equivalent to calling gsk_rounded_rect_intersects_rect() and
+ * gsk_rounded_rect_contains_rect() per rectangle, but the per-corner
+ * setup is only done once, which is noticeably cheaper when a clip is
+ * tested against every node in a subtree.
+ */
+void
+gsk_rounded_rect_classify_rects (const GskRoundedRect   *self,
+                                 const graphene_rect_t  *rects,
+                                 guint                   n_rects,
+                                 GskRoundedRectCoverage *out_coverage)
+{
+  CornerEllipses ce;
+  guint i;
+
+  corner_ellipses_init (&ce, self);
+
+  for (i = 0; i < n_rects; i++)
+    {
+      if (!graphene_rect_intersection (&self->bounds, &rects[i], NULL))
+        out_coverage[i] = GSK_ROUNDED_RECT_COVERAGE_OUT;
+      else if (graphene_rect_contains_rect (&self->bounds, &rects[i]) &&
+               corner_ellipses_contain_rect (&ce, &rects[i]))
+        out_coverage[i] = GSK_ROUNDED_RECT_COVERAGE_IN;
+      else
+        out_coverage[i] = GSK_ROUNDED_RECT_COVERAGE_PARTIAL;
+    }
 }
 
 static void
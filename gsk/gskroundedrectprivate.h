@@ -7,8 +7,19 @@
 
 G_BEGIN_DECLS
 
+typedef enum {
+  GSK_ROUNDED_RECT_COVERAGE_OUT,      /* rect does not overlap the rounded rect */
+  GSK_ROUNDED_RECT_COVERAGE_IN,       /* rect is fully inside the rounded rect */
+  GSK_ROUNDED_RECT_COVERAGE_PARTIAL   /* anything in between */
+} GskRoundedRectCoverage;
+
 gboolean                 gsk_rounded_rect_is_circular           (const GskRoundedRect     *self);
 
+void                     gsk_rounded_rect_classify_rects        (const GskRoundedRect     *self,
+                                                                 const graphene_rect_t    *rects,
+                                                                 guint                     n_rects,
+                                                                 GskRoundedRectCoverage   *out_coverage);
+
 void                     gsk_rounded_rect_path                  (const GskRoundedRect     *self,
                                                                  cairo_t                  *cr);
 void                     gsk_rounded_rect_to_float              (const GskRoundedRect     *self,
@@ -7,6 +7,8 @@
 #include <gdk/gdk.h>
 #include <epoxy/gl.h>
 
+#include <string.h>
+
 typedef struct {
   int program_id;
 
@@ -202,17 +204,13 @@ lookup_shader_code (GString *code,
   return TRUE;
 }
 
-static int
-gsk_shader_builder_compile_shader (GskShaderBuilder *builder,
-                                   int               shader_type,
-                                   const char       *shader_preamble,
-                                   const char       *shader_source,
-                                   GError          **error)
+static char *
+gsk_shader_builder_build_source (GskShaderBuilder *builder,
+                                 const char       *shader_preamble,
+                                 const char       *shader_source,
+                                 GError          **error)
 {
   GString *code;
-  char *source;
-  int shader_id;
-  int status;
   int i;
 
   code = g_string_new (NULL);
@@ -242,7 +240,7 @@ gsk_shader_builder_compile_shader (GskShaderBuilder *builder,
   if (!lookup_shader_code (code, builder->resource_base_path, shader_preamble, error))
     {
       g_string_free (code, TRUE);
-      return -1;
+      return NULL;
     }
 
   g_string_append_c (code, '\n');
@@ -250,10 +248,22 @@ gsk_shader_builder_compile_shader (GskShaderBuilder *builder,
   if (!lookup_shader_code (code, builder->resource_base_path, shader_source, error))
     {
       g_string_free (code, TRUE);
-      return -1;
+      return NULL;
     }
 
-  source = g_string_free (code, FALSE);
+  return g_string_free (code, FALSE);
+}
+
+static int
+gsk_shader_builder_compile_shader (GskShaderBuilder *builder,
+                                   int               shader_type,
+                                   const char       *shader_preamble,
+                                   const char       *shader_source,
+                                   const char       *source,
+                                   GError          **error)
+{
+  int shader_id;
+  int status;
 
   shader_id = glCreateShader (shader_type);
   glShaderSource (shader_id, 1, (const GLchar **) &source, NULL);
@@ -270,8 +280,6 @@ gsk_shader_builder_compile_shader (GskShaderBuilder *builder,
     }
 #endif
 
-  g_free (source);
-
   glGetShaderiv (shader_id, GL_COMPILE_STATUS, &status);
   if (status == GL_FALSE)
     {
@@ -331,6 +339,126 @@ gsk_shader_builder_cache_attributes (GskShaderBuilder *builder,
     }
 }
 
+/* Linked program binaries are cached on disk, keyed by a hash of the
+ * complete shader sources and the driver identification strings, so a
+ * driver or GTK+ update automatically invalidates stale entries. With
+ * a warm cache, renderer creation skips GLSL compilation entirely.
+ */
+
+static gboolean
+gsk_shader_builder_have_program_binary (void)
+{
+  static int have = -1;
+
+  if (have < 0)
+    have = epoxy_gl_version () >= 41 ||
+           epoxy_has_gl_extension ("GL_ARB_get_program_binary") ||
+           epoxy_has_gl_extension ("GL_OES_get_program_binary");
+
+  return have;
+}
+
+static char *
+gsk_shader_builder_get_program_cache_path (const char *vertex_source,
+                                           const char *fragment_source)
+{
+  const char *vendor = (const char *) glGetString (GL_VENDOR);
+  const char *renderer = (const char *) glGetString (GL_RENDERER);
+  const char *version = (const char *) glGetString (GL_VERSION);
+  GChecksum *checksum;
+  char *filename, *path;
+
+  if (vendor == NULL || renderer == NULL || version == NULL)
+    return NULL;
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) vendor, -1);
+  g_checksum_update (checksum, (const guchar *) renderer, -1);
+  g_checksum_update (checksum, (const guchar *) version, -1);
+  g_checksum_update (checksum, (const guchar *) vertex_source, -1);
+  g_checksum_update (checksum, (const guchar *) fragment_source, -1);
+
+  filename = g_strconcat (g_checksum_get_string (checksum), ".program", NULL);
+  path = g_build_filename (g_get_user_cache_dir (),
+                           "gtk-4.0", "gsk-shaders",
+                           filename,
+                           NULL);
+
+  g_free (filename);
+  g_checksum_free (checksum);
+
+  return path;
+}
+
+static int
+gsk_shader_builder_load_cached_program (const char *path)
+{
+  char *contents;
+  gsize len;
+  guint32 format;
+  int program_id;
+  int status;
+
+  if (path == NULL ||
+      !g_file_get_contents (path, &contents, &len, NULL))
+    return -1;
+
+  if (len < sizeof (guint32))
+    {
+      g_free (contents);
+      return -1;
+    }
+
+  memcpy (&format, contents, sizeof (guint32));
+
+  program_id = glCreateProgram ();
+  glProgramBinary (program_id, format,
+                   contents + sizeof (guint32),
+                   len - sizeof (guint32));
+
+  g_free (contents);
+
+  /* A failed load is expected after driver updates; just recompile */
+  glGetProgramiv (program_id, GL_LINK_STATUS, &status);
+  if (status == GL_FALSE)
+    {
+      glDeleteProgram (program_id);
+      return -1;
+    }
+
+  return program_id;
+}
+
+static void
+gsk_shader_builder_save_cached_program (const char *path,
+                                        int         program_id)
+{
+  int len = 0;
+  GLenum format = 0;
+  guint32 format32;
+  char *data, *dir;
+
+  if (path == NULL)
+    return;
+
+  glGetProgramiv (program_id, GL_PROGRAM_BINARY_LENGTH, &len);
+  if (len <= 0)
+    return;
+
+  data = g_malloc (sizeof (guint32) + len);
+  glGetProgramBinary (program_id, len, NULL, &format, data + sizeof (guint32));
+  format32 = format;
+  memcpy (data, &format32, sizeof (guint32));
+
+  dir = g_path_get_dirname (path);
+  g_mkdir_with_parents (dir, 0700);
+  g_free (dir);
+
+  g_file_set_contents (path, data, sizeof (guint32) + len, NULL);
+
+  g_free (data);
+}
+
 int
 gsk_shader_builder_create_program (GskShaderBuilder *builder,
                                    const char       *vertex_shader,
@@ -338,7 +466,9 @@ gsk_shader_builder_create_program (GskShaderBuilder *builder,
                                    GError          **error)
 {
   ShaderProgram *program;
-  int vertex_id, fragment_id;
+  char *vertex_source, *fragment_source;
+  char *cache_path = NULL;
+  int vertex_id = -1, fragment_id = -1;
   int program_id;
   int status;
 
@@ -346,26 +476,71 @@ gsk_shader_builder_create_program (GskShaderBuilder *builder,
   g_return_val_if_fail (vertex_shader != NULL, -1);
   g_return_val_if_fail (fragment_shader != NULL, -1);
 
+  vertex_source = gsk_shader_builder_build_source (builder,
+                                                   builder->vertex_preamble,
+                                                   vertex_shader,
+                                                   error);
+  if (vertex_source == NULL)
+    return -1;
+
+  fragment_source = gsk_shader_builder_build_source (builder,
+                                                     builder->fragment_preamble,
+                                                     fragment_shader,
+                                                     error);
+  if (fragment_source == NULL)
+    {
+      g_free (vertex_source);
+      return -1;
+    }
+
+  if (gsk_shader_builder_have_program_binary ())
+    {
+      cache_path = gsk_shader_builder_get_program_cache_path (vertex_source,
+                                                              fragment_source);
+
+      program_id = gsk_shader_builder_load_cached_program (cache_path);
+      if (program_id >= 0)
+        {
+          GSK_NOTE (SHADERS, g_message ("Loaded cached program for '%s' + '%s'",
+                                        vertex_shader, fragment_shader));
+          g_free (vertex_source);
+          g_free (fragment_source);
+          g_free (cache_path);
+          goto linked;
+        }
+    }
+
   vertex_id = gsk_shader_builder_compile_shader (builder, GL_VERTEX_SHADER,
                                                  builder->vertex_preamble,
                                                  vertex_shader,
+                                                 vertex_source,
                                                  error);
+  g_free (vertex_source);
   if (vertex_id < 0)
-    return -1;
+    {
+      g_free (fragment_source);
+      g_free (cache_path);
+      return -1;
+    }
 
   fragment_id = gsk_shader_builder_compile_shader (builder, GL_FRAGMENT_SHADER,
                                                    builder->fragment_preamble,
                                                    fragment_shader,
+                                                   fragment_source,
                                                    error);
+  g_free (fragment_source);
   if (fragment_id < 0)
     {
       glDeleteShader (vertex_id);
+      g_free (cache_path);
       return -1;
     }
 
   program_id = glCreateProgram ();
   glAttachShader (program_id, vertex_id);
   glAttachShader (program_id, fragment_id);
+  if (cache_path != NULL)
+    glProgramParameteri (program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   glLinkProgram (program_id);
 
   glGetProgramiv (program_id, GL_LINK_STATUS, &status);
@@ -386,9 +561,17 @@ gsk_shader_builder_create_program (GskShaderBuilder *builder,
       glDeleteProgram (program_id);
       program_id = -1;
 
+      g_free (cache_path);
       goto out;
     }
 
+  if (cache_path != NULL)
+    {
+      gsk_shader_builder_save_cached_program (cache_path, program_id);
+      g_free (cache_path);
+    }
+
+linked:
   program = shader_program_new (program_id);
   gsk_shader_builder_cache_uniforms (builder, program);
   gsk_shader_builder_cache_attributes (builder, program);
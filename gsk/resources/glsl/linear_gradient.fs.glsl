@@ -1,6 +1,3 @@
-uniform vec4 u_color_stops[8];
-uniform float u_color_offsets[8];
-uniform int u_num_color_stops;
 uniform vec2 u_start_point;
 uniform vec2 u_end_point;
 
@@ -30,16 +27,10 @@ void main() {
   // Offset of the current pixel
   float offset = length(proj) / maxDist;
 
-  vec4 color = u_color_stops[0];
-  for (int i = 1; i < u_num_color_stops; i ++) {
-    if (offset >= u_color_offsets[i - 1])  {
-      float o = (offset - u_color_offsets[i - 1]) / (u_color_offsets[i] - u_color_offsets[i - 1]);
-      color = mix(u_color_stops[i - 1], u_color_stops[i], clamp(o, 0.0, 1.0));
-    }
-  }
-
-  /* Pre-multiply */
-  color.rgb *= color.a;
+  // The ramp texture holds the rasterized stop list, premultiplied like
+  // all our textures; it clamps to edge, matching what the stop math
+  // used to do outside of [0, 1]
+  vec4 color = Texture(u_source, vec2(offset, 0.5));
 
   setOutputColor(color * u_alpha);
 }
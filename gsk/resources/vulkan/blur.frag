@@ -6,6 +6,7 @@ layout(location = 0) in vec2 inPos;
 layout(location = 1) in flat vec2 inSize;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in float inRadius;
+layout(location = 4) in flat vec2 inDir;
 
 layout(set = 0, binding = 0) uniform sampler2D inTexture;
 
@@ -44,7 +45,30 @@ vec4 blur_pixel (in vec2 uv)
   return ret / total;
 }
 
+// One direction of a separable blur; run once with inDir = (1, 0) and
+// once with inDir = (0, 1) over the result to get the full Gaussian at
+// a cost that is linear in the radius instead of quadratic.
+vec4 blur_pixel_1d (in vec2 uv)
+{
+  vec2 pixel_step = inDir / inSize;
+  int half_samples = int (ceil (inRadius * 1.5));
+  float total = 1.0;
+  vec4 ret = texture (inTexture, uv);
+
+  for (int i = 1; i <= half_samples; ++i)
+    {
+      float f = Gaussian (inRadius, float (i));
+      ret += (texture (inTexture, uv + pixel_step * float (i)) +
+              texture (inTexture, uv - pixel_step * float (i))) * f;
+      total += 2.0 * f;
+    }
+  return ret / total;
+}
+
 void main()
 {
-  color = clip (inPos, blur_pixel (inTexCoord));
+  if (inDir == vec2 (0.0))
+    color = clip (inPos, blur_pixel (inTexCoord));
+  else
+    color = clip (inPos, blur_pixel_1d (inTexCoord));
 }
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+#
+# Validate the GL shaders at build time, assembled the same way
+# GskShaderBuilder puts them together at runtime: version, defines,
+# preamble, body - for every GL variant the renderer can select.
+# Writes a stamp file listing the SHA-256 of each assembled
+# combination.
+#
+# Usage: validate-glsl.py GLSLANG-VALIDATOR OUTPUT-FILE [SHADER1] ...
+
+import hashlib, os, subprocess, sys, tempfile
+
+validator = sys.argv[1]
+outfile = sys.argv[2]
+shaders = sys.argv[3:]
+
+# Mirrors gsk_gl_renderer_create_programs()
+variants = [
+  (100, 'GSK_GLES', 'es2_common'),
+  (110, 'GSK_LEGACY', 'gl_common'),
+  (130, 'GSK_LEGACY', 'gl_common'),
+  (150, 'GSK_GL3', 'gl3_common'),
+]
+
+preambles = {}
+bodies = []
+
+for f in shaders:
+  base = os.path.basename(f)
+  if base.startswith(('es2_common', 'gl_common', 'gl3_common')):
+    preambles[base] = f
+  else:
+    bodies.append(f)
+
+hashes = []
+
+for f in bodies:
+  base = os.path.basename(f)
+  if base.endswith('.vs.glsl'):
+    stage, ext = 'vert', 'vs.glsl'
+  else:
+    stage, ext = 'frag', 'fs.glsl'
+
+  for version, define, preamble in variants:
+    source = '#version {0}\n\n#define {1} 1\n\n'.format(version, define)
+    source += open(preambles['{0}.{1}'.format(preamble, ext)]).read()
+    source += '\n'
+    source += open(f).read()
+
+    tmp = tempfile.NamedTemporaryFile(mode='w', suffix='.' + stage, delete=False)
+    tmp.write(source)
+    tmp.close()
+
+    res = subprocess.run([validator, '-S', stage, tmp.name],
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    os.unlink(tmp.name)
+
+    if res.returncode != 0:
+      sys.stderr.write('{0} (#version {1}, {2}):\n{3}'.format(
+        base, version, define, res.stdout.decode()))
+      sys.exit(1)
+
+    digest = hashlib.sha256(source.encode('utf-8')).hexdigest()
+    hashes.append('{0} {1} {2} {3}'.format(digest, base, version, define))
+
+with open(outfile, 'w') as f:
+  f.write('\n'.join(hashes) + '\n')
@@ -91,11 +91,12 @@ gsk_vulkan_blend_mode_pipeline_init (GskVulkanBlendModePipeline *self)
 
 GskVulkanPipeline *
 gsk_vulkan_blend_mode_pipeline_new (GdkVulkanContext        *context,
+                                    VkPipelineCache          cache,
                                     VkPipelineLayout         layout,
                                     const char              *shader_name,
                                     VkRenderPass             render_pass)
 {
-  return gsk_vulkan_pipeline_new (GSK_TYPE_VULKAN_BLEND_MODE_PIPELINE, context, layout, shader_name, render_pass);
+  return gsk_vulkan_pipeline_new (GSK_TYPE_VULKAN_BLEND_MODE_PIPELINE, context, cache, layout, shader_name, render_pass);
 }
 
 gsize
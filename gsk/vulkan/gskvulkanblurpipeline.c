@@ -14,6 +14,7 @@ struct _GskVulkanBlurInstance
   float rect[4];
   float tex_rect[4];
   float blur_radius;
+  float blur_dir[2]; /* (0, 0) means blurring both directions at once */
 };
 
 G_DEFINE_TYPE (GskVulkanBlurPipeline, gsk_vulkan_blur_pipeline, GSK_TYPE_VULKAN_PIPELINE)
@@ -46,6 +47,12 @@ gsk_vulkan_blur_pipeline_get_input_state_create_info (GskVulkanPipeline *self)
           .binding = 0,
           .format = VK_FORMAT_R32_SFLOAT,
           .offset = G_STRUCT_OFFSET (GskVulkanBlurInstance, blur_radius),
+      },
+      {
+          .location = 3,
+          .binding = 0,
+          .format = VK_FORMAT_R32G32_SFLOAT,
+          .offset = G_STRUCT_OFFSET (GskVulkanBlurInstance, blur_dir),
       }
   };
   static const VkPipelineVertexInputStateCreateInfo info = {
@@ -84,11 +91,12 @@ gsk_vulkan_blur_pipeline_init (GskVulkanBlurPipeline *self)
 
 GskVulkanPipeline *
 gsk_vulkan_blur_pipeline_new (GdkVulkanContext        *context,
+                              VkPipelineCache          cache,
                               VkPipelineLayout         layout,
                               const char              *shader_name,
                               VkRenderPass             render_pass)
 {
-  return gsk_vulkan_pipeline_new (GSK_TYPE_VULKAN_BLUR_PIPELINE, context, layout, shader_name, render_pass);
+  return gsk_vulkan_pipeline_new (GSK_TYPE_VULKAN_BLUR_PIPELINE, context, cache, layout, shader_name, render_pass);
 }
 
 gsize
@@ -102,7 +110,9 @@ gsk_vulkan_blur_pipeline_collect_vertex_data (GskVulkanBlurPipeline *pipeline,
                                               guchar                *data,
                                               const graphene_rect_t *rect,
                                               const graphene_rect_t *tex_rect,
-                                              double                 blur_radius)
+                                              double                 blur_radius,
+                                              double                 blur_dir_x,
+                                              double                 blur_dir_y)
 {
   GskVulkanBlurInstance *instance = (GskVulkanBlurInstance *) data;
 
@@ -115,6 +125,8 @@ gsk_vulkan_blur_pipeline_collect_vertex_data (GskVulkanBlurPipeline *pipeline,
   instance->tex_rect[2] = tex_rect->size.width;
   instance->tex_rect[3] = tex_rect->size.height;
   instance->blur_radius = blur_radius;
+  instance->blur_dir[0] = blur_dir_x;
+  instance->blur_dir[1] = blur_dir_y;
 }
 
 gsize
@@ -14,6 +14,7 @@ typedef struct _GskVulkanBlurPipelineLayout GskVulkanBlurPipelineLayout;
 G_DECLARE_FINAL_TYPE (GskVulkanBlurPipeline, gsk_vulkan_blur_pipeline, GSK, VULKAN_BLUR_PIPELINE, GskVulkanPipeline)
 
 GskVulkanPipeline *     gsk_vulkan_blur_pipeline_new                   (GdkVulkanContext        *context,
+                                                                        VkPipelineCache          cache,
                                                                         VkPipelineLayout         layout,
                                                                         const char              *shader_name,
                                                                         VkRenderPass             render_pass);
@@ -23,7 +24,9 @@ void                    gsk_vulkan_blur_pipeline_collect_vertex_data   (GskVulka
                                                                         guchar                  *data,
                                                                         const graphene_rect_t   *rect,
                                                                         const graphene_rect_t   *tex_rect,
-                                                                        double                   radius);
+                                                                        double                   radius,
+                                                                        double                   dir_x,
+                                                                        double                   dir_y);
 gsize                   gsk_vulkan_blur_pipeline_draw                  (GskVulkanBlurPipeline   *pipeline,
                                                                         VkCommandBuffer          command_buffer,
                                                                         gsize                    offset,
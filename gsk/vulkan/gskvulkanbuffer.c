@@ -13,6 +13,8 @@ struct _GskVulkanBuffer
   VkBuffer vk_buffer;
 
   GskVulkanMemory *memory;
+
+  guchar *map; /* set while the buffer is persistently mapped */
 };
 
 static GskVulkanBuffer *
@@ -80,6 +82,9 @@ gsk_vulkan_buffer_new_download (GdkVulkanContext  *context,
 void
 gsk_vulkan_buffer_free (GskVulkanBuffer *self)
 {
+  if (self->map)
+    gsk_vulkan_memory_unmap (self->memory);
+
   vkDestroyBuffer (gdk_vulkan_context_get_device (self->vulkan),
                    self->vk_buffer,
                    NULL);
@@ -108,3 +113,16 @@ gsk_vulkan_buffer_unmap (GskVulkanBuffer *self)
 {
   gsk_vulkan_memory_unmap (self->memory);
 }
+
+/* Maps the buffer on first use and keeps it mapped for its entire
+ * lifetime. The memory is host-coherent, so writes through the
+ * returned pointer don't need an unmap to become visible.
+ */
+guchar *
+gsk_vulkan_buffer_get_data (GskVulkanBuffer *self)
+{
+  if (self->map == NULL)
+    self->map = gsk_vulkan_memory_map (self->memory);
+
+  return self->map;
+}
@@ -19,6 +19,7 @@ VkBuffer                gsk_vulkan_buffer_get_buffer                    (GskVulk
 
 guchar *                gsk_vulkan_buffer_map                           (GskVulkanBuffer        *self);
 void                    gsk_vulkan_buffer_unmap                         (GskVulkanBuffer        *self);
+guchar *                gsk_vulkan_buffer_get_data                      (GskVulkanBuffer        *self);
 
 G_END_DECLS
 
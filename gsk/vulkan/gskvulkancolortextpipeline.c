@@ -2,6 +2,8 @@
 
 #include "gskvulkancolortextpipelineprivate.h"
 
+#include <math.h>
+
 struct _GskVulkanColorTextPipeline
 {
   GObject parent_instance;
@@ -77,11 +79,12 @@ gsk_vulkan_color_text_pipeline_init (GskVulkanColorTextPipeline *self)
 
 GskVulkanPipeline *
 gsk_vulkan_color_text_pipeline_new (GdkVulkanContext        *context,
+                                    VkPipelineCache          cache,
                                     VkPipelineLayout         layout,
                                     const char              *shader_name,
                                     VkRenderPass             render_pass)
 {
-  return gsk_vulkan_pipeline_new_full (GSK_TYPE_VULKAN_COLOR_TEXT_PIPELINE, context, layout, shader_name, render_pass,
+  return gsk_vulkan_pipeline_new_full (GSK_TYPE_VULKAN_COLOR_TEXT_PIPELINE, context, cache, layout, shader_name, render_pass,
                                        VK_BLEND_FACTOR_SRC_ALPHA, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA);
 }
 
@@ -124,15 +127,17 @@ gsk_vulkan_color_text_pipeline_collect_vertex_data (GskVulkanColorTextPipeline *
           double cy = (double)(gi->geometry.y_offset) / PANGO_SCALE;
           GskVulkanColorTextInstance *instance = &instances[count];
           GskVulkanCachedGlyph *glyph;
+          float fx = x + cx;
+          guint xshift = (guint)((fx - floorf (fx)) * 4 + 0.5) % 4;
 
-          glyph = gsk_vulkan_renderer_get_cached_glyph (renderer, font, gi->glyph, scale);
+          glyph = gsk_vulkan_renderer_get_cached_glyph (renderer, font, gi->glyph, scale, xshift);
 
           instance->tex_rect[0] = glyph->tx;
           instance->tex_rect[1] = glyph->ty;
           instance->tex_rect[2] = glyph->tw;
           instance->tex_rect[3] = glyph->th;
 
-          instance->rect[0] = x + cx + glyph->draw_x;
+          instance->rect[0] = floorf (fx) + glyph->draw_x;
           instance->rect[1] = y + cy + glyph->draw_y;
           instance->rect[2] = glyph->draw_width;
           instance->rect[3] = glyph->draw_height;
@@ -72,6 +72,49 @@ gsk_vulkan_command_pool_get_buffer (GskVulkanCommandPool *self)
   return command_buffer;
 }
 
+/* Allocates a secondary command buffer that may only be executed inside
+ * the given render pass. Recording into the returned buffer must happen
+ * on a single thread, and the pool may not be used from another thread
+ * until that recording has ended.
+ */
+VkCommandBuffer
+gsk_vulkan_command_pool_get_secondary_buffer (GskVulkanCommandPool *self,
+                                              VkRenderPass          render_pass,
+                                              VkFramebuffer         framebuffer)
+{
+  VkCommandBuffer command_buffer;
+
+  GSK_VK_CHECK (vkAllocateCommandBuffers, gdk_vulkan_context_get_device (self->vulkan),
+                                          &(VkCommandBufferAllocateInfo) {
+                                              .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                              .commandPool = self->vk_command_pool,
+                                              .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+                                              .commandBufferCount = 1,
+                                          },
+                                          &command_buffer);
+
+  GSK_VK_CHECK (vkBeginCommandBuffer, command_buffer,
+                                      &(VkCommandBufferBeginInfo) {
+                                          .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                          .flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                          .pInheritanceInfo = &(VkCommandBufferInheritanceInfo) {
+                                              .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                                              .renderPass = render_pass,
+                                              .subpass = 0,
+                                              .framebuffer = framebuffer
+                                          }
+                                      });
+
+  return command_buffer;
+}
+
+void
+gsk_vulkan_command_pool_end_buffer (GskVulkanCommandPool *self,
+                                    VkCommandBuffer       command_buffer)
+{
+  GSK_VK_CHECK (vkEndCommandBuffer, command_buffer);
+}
+
 void
 gsk_vulkan_command_pool_submit_buffer (GskVulkanCommandPool *self,
                                        VkCommandBuffer       command_buffer,
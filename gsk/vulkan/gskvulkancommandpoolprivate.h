@@ -13,6 +13,11 @@ void                    gsk_vulkan_command_pool_free                    (GskVulk
 void                    gsk_vulkan_command_pool_reset                   (GskVulkanCommandPool   *self);
 
 VkCommandBuffer         gsk_vulkan_command_pool_get_buffer              (GskVulkanCommandPool   *self);
+VkCommandBuffer         gsk_vulkan_command_pool_get_secondary_buffer    (GskVulkanCommandPool   *self,
+                                                                         VkRenderPass            render_pass,
+                                                                         VkFramebuffer           framebuffer);
+void                    gsk_vulkan_command_pool_end_buffer              (GskVulkanCommandPool   *self,
+                                                                         VkCommandBuffer         buffer);
 void                    gsk_vulkan_command_pool_submit_buffer           (GskVulkanCommandPool   *self,
                                                                          VkCommandBuffer         buffer,
                                                                          gsize                   wait_semaphore_count,
@@ -4,6 +4,7 @@
 
 #include "gskvulkanimageprivate.h"
 #include "gskdebugprivate.h"
+#include "gskglyphcachesharedprivate.h"
 #include "gskprivate.h"
 #include "gskrendererprivate.h"
 
@@ -116,6 +117,7 @@ typedef struct {
   PangoFont *font;
   PangoGlyph glyph;
   guint scale; /* times 1024 */
+  guint xshift; /* quarter pixels, 0 - 3 */
 } GlyphCacheKey;
 
 static gboolean
@@ -126,7 +128,8 @@ glyph_cache_equal (gconstpointer v1, gconstpointer v2)
 
   return key1->font == key2->font &&
          key1->glyph == key2->glyph &&
-         key1->scale == key2->scale;
+         key1->scale == key2->scale &&
+         key1->xshift == key2->xshift;
 }
 
 static guint
@@ -134,7 +137,7 @@ glyph_cache_hash (gconstpointer v)
 {
   const GlyphCacheKey *key = v;
 
-  return GPOINTER_TO_UINT (key->font) ^ key->glyph ^ key->scale;
+  return GPOINTER_TO_UINT (key->font) ^ key->glyph ^ key->scale ^ (key->xshift << 24);
 }
 
 static void
@@ -256,28 +259,41 @@ render_glyph (Atlas          *atlas,
   PangoGlyphString glyphs;
   PangoGlyphInfo gi;
 
-  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
-                                        value->draw_width * key->scale / 1024,
-                                        value->draw_height * key->scale / 1024);
-  cairo_surface_set_device_scale (surface, key->scale / 1024.0, key->scale / 1024.0);
-
-  cr = cairo_create (surface);
-  cairo_set_source_rgba (cr, 1, 1, 1, 1);
+  /* Some other process may have rasterized this glyph already */
+  surface = gsk_glyph_cache_shared_lookup (key->font, key->glyph,
+                                           key->scale, key->xshift,
+                                           value->draw_width * key->scale / 1024,
+                                           value->draw_height * key->scale / 1024);
+  if (surface == NULL)
+    {
+      surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                            value->draw_width * key->scale / 1024,
+                                            value->draw_height * key->scale / 1024);
+      cairo_surface_set_device_scale (surface, key->scale / 1024.0, key->scale / 1024.0);
+
+      cr = cairo_create (surface);
+      cairo_set_source_rgba (cr, 1, 1, 1, 1);
+
+      gi.glyph = key->glyph;
+      gi.geometry.width = value->draw_width * 1024;
+      if (key->glyph & PANGO_GLYPH_UNKNOWN_FLAG)
+        gi.geometry.x_offset = 0;
+      else
+        gi.geometry.x_offset = - value->draw_x * 1024;
+      gi.geometry.x_offset += key->xshift * 256;
+      gi.geometry.y_offset = - value->draw_y * 1024;
 
-  gi.glyph = key->glyph;
-  gi.geometry.width = value->draw_width * 1024;
-  if (key->glyph & PANGO_GLYPH_UNKNOWN_FLAG)
-    gi.geometry.x_offset = 0;
-  else
-    gi.geometry.x_offset = - value->draw_x * 1024;
-  gi.geometry.y_offset = - value->draw_y * 1024;
+      glyphs.num_glyphs = 1;
+      glyphs.glyphs = &gi;
 
-  glyphs.num_glyphs = 1;
-  glyphs.glyphs = &gi;
+      pango_cairo_show_glyph_string (cr, key->font, &glyphs);
 
-  pango_cairo_show_glyph_string (cr, key->font, &glyphs);
+      cairo_destroy (cr);
 
-  cairo_destroy (cr);
+      gsk_glyph_cache_shared_store (key->font, key->glyph,
+                                    key->scale, key->xshift,
+                                    surface);
+    }
 
   glyph->surface = surface;
 
@@ -333,7 +349,8 @@ gsk_vulkan_glyph_cache_lookup (GskVulkanGlyphCache *cache,
                                gboolean             create,
                                PangoFont           *font,
                                PangoGlyph           glyph,
-                               float                scale)
+                               float                scale,
+                               guint                xshift)
 {
   GlyphCacheKey lookup_key;
   GskVulkanCachedGlyph *value;
@@ -341,6 +358,7 @@ gsk_vulkan_glyph_cache_lookup (GskVulkanGlyphCache *cache,
   lookup_key.font = font;
   lookup_key.glyph = glyph;
   lookup_key.scale = (guint)(scale * 1024);
+  lookup_key.xshift = xshift;
 
   value = g_hash_table_lookup (cache->hash_table, &lookup_key);
 
@@ -366,6 +384,10 @@ gsk_vulkan_glyph_cache_lookup (GskVulkanGlyphCache *cache,
       pango_font_get_glyph_extents (font, glyph, &ink_rect, NULL);
       pango_extents_to_pixels (&ink_rect, NULL);
 
+      /* The subpixel shift can spill into one extra pixel on the right */
+      if (xshift != 0 && ink_rect.width > 0)
+        ink_rect.width += 1;
+
       value->draw_x = ink_rect.x;
       value->draw_y = ink_rect.y;
       value->draw_width = ink_rect.width;
@@ -375,6 +397,7 @@ gsk_vulkan_glyph_cache_lookup (GskVulkanGlyphCache *cache,
       key->font = g_object_ref (font);
       key->glyph = glyph;
       key->scale = (guint)(scale * 1024);
+      key->xshift = xshift;
 
       if (ink_rect.width > 0 && ink_rect.height > 0)
         add_to_cache (cache, key, value);
@@ -22,7 +22,8 @@ GskVulkanCachedGlyph *gsk_vulkan_glyph_cache_lookup         (GskVulkanGlyphCache
                                                              gboolean             create,
                                                              PangoFont           *font,
                                                              PangoGlyph           glyph,
-                                                             float                scale);
+                                                             float                scale,
+                                                             guint                xshift);
 
 void                  gsk_vulkan_glyph_cache_begin_frame    (GskVulkanGlyphCache *cache);
 
@@ -26,6 +26,12 @@
 #define DESCRIPTOR_POOL_MAXSETS 128
 #define DESCRIPTOR_POOL_MAXSETS_INCREASE 128
 
+/* Cached descriptor sets are dropped when their (sampler, image view)
+ * combination hasn't been used for this many frames */
+#define DESCRIPTOR_SET_MAX_AGE 60
+
+#define VERTEX_BUFFER_SIZE (128 * 1024)
+
 struct _GskVulkanRender
 {
   GskRenderer *renderer;
@@ -41,13 +47,25 @@ struct _GskVulkanRender
   VkRenderPass render_pass;
   VkDescriptorSetLayout descriptor_set_layout;
   VkPipelineLayout pipeline_layout[3]; /* indexed by number of textures */
+  VkPipelineCache pipeline_cache;
+  gsize pipeline_cache_size; /* size of the data the cache was loaded with */
   GskVulkanUploader *uploader;
 
+  /* Ring of persistently mapped vertex buffers; one slot per frame in
+   * flight, so geometry is written straight into GPU-visible memory
+   * without per-frame allocation or map/unmap.
+   */
+  GskVulkanBuffer *vertex_buffers[3];
+  gsize vertex_buffer_sizes[3];
+  guint current_vertex_buffer;
+  gsize vertex_buffer_used;
+
   GHashTable *descriptor_set_indexes;
   VkDescriptorPool descriptor_pool;
   uint32_t descriptor_pool_maxsets;
   VkDescriptorSet *descriptor_sets;
   gsize n_descriptor_sets;
+  guint descriptor_set_frame;
   GskVulkanPipeline *pipelines[GSK_VULKAN_N_PIPELINES];
 
   GskVulkanImage *target;
@@ -93,6 +111,103 @@ gsk_vulkan_render_setup (GskVulkanRender       *self,
 
 static guint desc_set_index_hash (gconstpointer v);
 static gboolean desc_set_index_equal (gconstpointer v1, gconstpointer v2);
+static void desc_set_index_entry_free (gpointer v);
+
+/* The pipeline cache is persisted to disk, keyed by the pipeline cache
+ * UUID of the device, so pipeline construction on the next renderer
+ * init is mostly a cache lookup instead of a full shader compile.
+ */
+static char *
+gsk_vulkan_render_get_pipeline_cache_path (GskVulkanRender *self)
+{
+  VkPhysicalDeviceProperties props;
+  GString *uuid;
+  char *path;
+  guint i;
+
+  vkGetPhysicalDeviceProperties (gdk_vulkan_context_get_physical_device (self->vulkan), &props);
+
+  uuid = g_string_new (NULL);
+  for (i = 0; i < VK_UUID_SIZE; i++)
+    g_string_append_printf (uuid, "%02x", props.pipelineCacheUUID[i]);
+  g_string_append (uuid, ".cache");
+
+  path = g_build_filename (g_get_user_cache_dir (), "gtk-4.0", "vulkan-pipeline-cache", uuid->str, NULL);
+  g_string_free (uuid, TRUE);
+
+  return path;
+}
+
+static void
+gsk_vulkan_render_load_pipeline_cache (GskVulkanRender *self)
+{
+  char *path;
+  char *data;
+  gsize size;
+
+  path = gsk_vulkan_render_get_pipeline_cache_path (self);
+  if (!g_file_get_contents (path, &data, &size, NULL))
+    {
+      data = NULL;
+      size = 0;
+    }
+  g_free (path);
+
+  /* The driver validates the header of the initial data itself and
+   * falls back to an empty cache if it does not match the device.
+   */
+  GSK_VK_CHECK (vkCreatePipelineCache, gdk_vulkan_context_get_device (self->vulkan),
+                                       &(VkPipelineCacheCreateInfo) {
+                                           .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+                                           .initialDataSize = size,
+                                           .pInitialData = data,
+                                       },
+                                       NULL,
+                                       &self->pipeline_cache);
+
+  self->pipeline_cache_size = size;
+
+  g_free (data);
+}
+
+static void
+gsk_vulkan_render_save_pipeline_cache (GskVulkanRender *self)
+{
+  VkDevice device;
+  char *path;
+  char *dir;
+  char *data;
+  size_t size;
+
+  if (self->pipeline_cache == VK_NULL_HANDLE)
+    return;
+
+  device = gdk_vulkan_context_get_device (self->vulkan);
+
+  if (GSK_VK_CHECK (vkGetPipelineCacheData, device, self->pipeline_cache, &size, NULL) != VK_SUCCESS)
+    return;
+
+  /* No new pipelines were compiled; the file on disk is up to date */
+  if (size == self->pipeline_cache_size)
+    return;
+
+  data = g_malloc (size);
+  if (GSK_VK_CHECK (vkGetPipelineCacheData, device, self->pipeline_cache, &size, data) != VK_SUCCESS)
+    {
+      g_free (data);
+      return;
+    }
+
+  path = gsk_vulkan_render_get_pipeline_cache_path (self);
+  dir = g_path_get_dirname (path);
+  if (g_mkdir_with_parents (dir, 0700) == 0 &&
+      g_file_set_contents (path, data, size, NULL))
+    GSK_NOTE (VULKAN, g_message ("Saved %" G_GSIZE_FORMAT " bytes of pipeline cache to %s",
+                               (gsize) size, path));
+  g_free (dir);
+  g_free (path);
+  g_free (data);
+}
 
 GskVulkanRender *
 gsk_vulkan_render_new (GskRenderer      *renderer,
@@ -106,7 +221,7 @@ gsk_vulkan_render_new (GskRenderer      *renderer,
   self->vulkan = context;
   self->renderer = renderer;
   self->framebuffers = g_hash_table_new (g_direct_hash, g_direct_equal);
-  self->descriptor_set_indexes = g_hash_table_new_full (desc_set_index_hash, desc_set_index_equal, NULL, g_free);
+  self->descriptor_set_indexes = g_hash_table_new_full (desc_set_index_hash, desc_set_index_equal, NULL, desc_set_index_entry_free);
 
   device = gdk_vulkan_context_get_device (self->vulkan);
 
@@ -119,10 +234,13 @@ gsk_vulkan_render_new (GskRenderer      *renderer,
                                NULL,
                                &self->fence);
 
+  gsk_vulkan_render_load_pipeline_cache (self);
+
   self->descriptor_pool_maxsets = DESCRIPTOR_POOL_MAXSETS;
   GSK_VK_CHECK (vkCreateDescriptorPool, device,
                                         &(VkDescriptorPoolCreateInfo) {
                                             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                                            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
                                             .maxSets = self->descriptor_pool_maxsets,
                                             .poolSizeCount = 1,
                                             .pPoolSizes = (VkDescriptorPoolSize[1]) {
@@ -321,6 +439,21 @@ gsk_vulkan_render_add_render_pass (GskVulkanRender     *self,
 #endif
 }
 
+/* Like gsk_vulkan_render_add_render_pass(), but keeps the pass added
+ * most recently in front, for passes that consume its output and
+ * therefore have to be drawn after it.
+ */
+void
+gsk_vulkan_render_add_dependent_render_pass (GskVulkanRender     *self,
+                                             GskVulkanRenderPass *pass)
+{
+  self->render_passes = g_list_insert (self->render_passes, pass, 1);
+
+#ifdef G_ENABLE_DEBUG
+  gsk_profiler_counter_inc (gsk_renderer_get_profiler (self->renderer), self->render_pass_counter);
+#endif
+}
+
 void
 gsk_vulkan_render_add_node (GskVulkanRender *self,
                             GskRenderNode   *node)
@@ -368,7 +501,7 @@ gsk_vulkan_render_get_pipeline (GskVulkanRender       *self,
   static const struct {
     const char *name;
     guint num_textures;
-    GskVulkanPipeline * (* create_func) (GdkVulkanContext *context, VkPipelineLayout layout, const char *name, VkRenderPass render_pass);
+    GskVulkanPipeline * (* create_func) (GdkVulkanContext *context, VkPipelineCache cache, VkPipelineLayout layout, const char *name, VkRenderPass render_pass);
   } pipeline_info[GSK_VULKAN_N_PIPELINES] = {
     { "texture",                    1, gsk_vulkan_texture_pipeline_new },
     { "texture-clip",               1, gsk_vulkan_texture_pipeline_new },
@@ -412,6 +545,7 @@ gsk_vulkan_render_get_pipeline (GskVulkanRender       *self,
 
   if (self->pipelines[type] == NULL)
     self->pipelines[type] = pipeline_info[type].create_func (self->vulkan,
+                                                             self->pipeline_cache,
                                                              self->pipeline_layout[pipeline_info[type].num_textures],
                                                              pipeline_info[type].name,
                                                              self->render_pass);
@@ -419,6 +553,57 @@ gsk_vulkan_render_get_pipeline (GskVulkanRender       *self,
   return self->pipelines[type];
 }
 
+/*
+ * gsk_vulkan_render_reserve_vertex_data:
+ * @self: the render
+ * @size: number of bytes to reserve
+ * @offset: return location for the offset of the reserved range
+ * @data: return location for the mapped memory of the whole buffer;
+ *     the caller writes its vertices at @data + @offset
+ *
+ * Reserves a range in the current slot of the vertex buffer ring. The
+ * slot advances once per frame after the render's fence was waited on,
+ * so the GPU is never reading a slot that gets written to.
+ *
+ * Returns: the buffer the range was reserved in, or %NULL if @size
+ *     does not fit behind the ranges already handed out this frame;
+ *     the caller should then use a buffer of its own
+ */
+GskVulkanBuffer *
+gsk_vulkan_render_reserve_vertex_data (GskVulkanRender  *self,
+                                       gsize             size,
+                                       gsize            *offset,
+                                       guchar          **data)
+{
+  guint i = self->current_vertex_buffer;
+
+  if (self->vertex_buffers[i] == NULL ||
+      self->vertex_buffer_used + size > self->vertex_buffer_sizes[i])
+    {
+      gsize new_size;
+
+      /* Growing now would invalidate ranges already handed out */
+      if (self->vertex_buffer_used != 0)
+        return NULL;
+
+      new_size = MAX (VERTEX_BUFFER_SIZE, 2 * self->vertex_buffer_sizes[i]);
+      while (new_size < size)
+        new_size *= 2;
+
+      g_clear_pointer (&self->vertex_buffers[i], gsk_vulkan_buffer_free);
+      self->vertex_buffers[i] = gsk_vulkan_buffer_new (self->vulkan, new_size);
+      self->vertex_buffer_sizes[i] = new_size;
+    }
+
+  *offset = self->vertex_buffer_used;
+  *data = gsk_vulkan_buffer_get_data (self->vertex_buffers[i]);
+
+  /* Keep the next range aligned for instance data */
+  self->vertex_buffer_used += (size + 15) & ~(gsize) 15;
+
+  return self->vertex_buffers[i];
+}
+
 VkDescriptorSet
 gsk_vulkan_render_get_descriptor_set (GskVulkanRender *self,
                                       gsize            id)
@@ -430,8 +615,9 @@ gsk_vulkan_render_get_descriptor_set (GskVulkanRender *self,
 
 typedef struct {
   gsize index;
-  GskVulkanImage *image;
+  GskVulkanImage *image; /* we hold a reference */
   gboolean repeat;
+  guint last_used; /* frame the entry was last looked up in */
 } HashDescriptorSetIndexEntry;
 
 static guint
@@ -451,6 +637,15 @@ desc_set_index_equal (gconstpointer v1, gconstpointer v2)
   return e1->image == e2->image && e1->repeat == e2->repeat;
 }
 
+static void
+desc_set_index_entry_free (gpointer v)
+{
+  HashDescriptorSetIndexEntry *entry = v;
+
+  g_object_unref (entry->image);
+  g_free (entry);
+}
+
 gsize
 gsk_vulkan_render_reserve_descriptor_set (GskVulkanRender *self,
                                           GskVulkanImage  *source,
@@ -466,12 +661,16 @@ gsk_vulkan_render_reserve_descriptor_set (GskVulkanRender *self,
 
   entry = g_hash_table_lookup (self->descriptor_set_indexes, &lookup);
   if (entry)
-    return entry->index;
+    {
+      entry->last_used = self->descriptor_set_frame;
+      return entry->index;
+    }
 
   entry = g_new (HashDescriptorSetIndexEntry, 1);
-  entry->image = source;
+  entry->image = g_object_ref (source);
   entry->repeat = repeat;
   entry->index = g_hash_table_size (self->descriptor_set_indexes);
+  entry->last_used = self->descriptor_set_frame;
   g_hash_table_add (self->descriptor_set_indexes, entry);
 
   return entry->index;
@@ -497,12 +696,16 @@ gsk_vulkan_render_prepare_descriptor_sets (GskVulkanRender *self)
   needed_sets = g_hash_table_size (self->descriptor_set_indexes);
   if (needed_sets > self->n_descriptor_sets)
     {
+      gsize first_new = self->n_descriptor_sets;
+
       if (needed_sets > self->descriptor_pool_maxsets)
         {
           guint added_sets = needed_sets - self->descriptor_pool_maxsets;
           added_sets = added_sets + DESCRIPTOR_POOL_MAXSETS_INCREASE - 1;
           added_sets -= added_sets % DESCRIPTOR_POOL_MAXSETS_INCREASE;
 
+          /* Recreating the pool loses all cached sets, so they all
+           * have to be allocated and written again below */
           vkDestroyDescriptorPool (device,
                                    self->descriptor_pool,
                                    NULL);
@@ -510,6 +713,7 @@ gsk_vulkan_render_prepare_descriptor_sets (GskVulkanRender *self)
           GSK_VK_CHECK (vkCreateDescriptorPool, device,
                                                 &(VkDescriptorPoolCreateInfo) {
                                                     .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                                                    .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
                                                     .maxSets = self->descriptor_pool_maxsets,
                                                     .poolSizeCount = 1,
                                                     .pPoolSizes = (VkDescriptorPoolSize[1]) {
@@ -521,57 +725,56 @@ gsk_vulkan_render_prepare_descriptor_sets (GskVulkanRender *self)
                                                 },
                                                 NULL,
                                                 &self->descriptor_pool);
-        }
-      else
-        {
-          GSK_VK_CHECK (vkResetDescriptorPool, device,
-                                               self->descriptor_pool,
-                                               0);
+          first_new = 0;
         }
 
       self->n_descriptor_sets = needed_sets;
       self->descriptor_sets = g_renew (VkDescriptorSet, self->descriptor_sets, needed_sets);
-    }
 
-  VkDescriptorSetLayout *layouts = g_newa (VkDescriptorSetLayout, needed_sets);
-  for (i = 0; i < needed_sets; i++)
-    layouts[i] = self->descriptor_set_layout;
-
-  GSK_VK_CHECK (vkAllocateDescriptorSets, device,
-                                          &(VkDescriptorSetAllocateInfo) {
-                                              .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-                                              .descriptorPool = self->descriptor_pool,
-                                              .descriptorSetCount = needed_sets,
-                                              .pSetLayouts = layouts
-                                          },
-                                          self->descriptor_sets);
-
-  g_hash_table_iter_init (&iter, self->descriptor_set_indexes);
-  while (g_hash_table_iter_next (&iter, &key, NULL))
-    {
-      HashDescriptorSetIndexEntry *entry = key;
-      GskVulkanImage *image = entry->image;
-      gsize id = entry->index;
-      gboolean repeat = entry->repeat;
-
-      vkUpdateDescriptorSets (device,
-                              1,
-                              (VkWriteDescriptorSet[1]) {
-                                  {
-                                      .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                                      .dstSet = self->descriptor_sets[id],
-                                      .dstBinding = 0,
-                                      .dstArrayElement = 0,
-                                      .descriptorCount = 1,
-                                      .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                      .pImageInfo = &(VkDescriptorImageInfo) {
-                                          .sampler = repeat ? self->repeating_sampler : self->sampler,
-                                          .imageView = gsk_vulkan_image_get_image_view (image),
-                                          .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+      VkDescriptorSetLayout *layouts = g_newa (VkDescriptorSetLayout, needed_sets - first_new);
+      for (i = 0; i < needed_sets - first_new; i++)
+        layouts[i] = self->descriptor_set_layout;
+
+      GSK_VK_CHECK (vkAllocateDescriptorSets, device,
+                                              &(VkDescriptorSetAllocateInfo) {
+                                                  .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                                                  .descriptorPool = self->descriptor_pool,
+                                                  .descriptorSetCount = needed_sets - first_new,
+                                                  .pSetLayouts = layouts
+                                              },
+                                              self->descriptor_sets + first_new);
+
+      g_hash_table_iter_init (&iter, self->descriptor_set_indexes);
+      while (g_hash_table_iter_next (&iter, &key, NULL))
+        {
+          HashDescriptorSetIndexEntry *entry = key;
+          GskVulkanImage *image = entry->image;
+          gsize id = entry->index;
+          gboolean repeat = entry->repeat;
+
+          /* Sets cached from previous frames are still written */
+          if (id < first_new)
+            continue;
+
+          vkUpdateDescriptorSets (device,
+                                  1,
+                                  (VkWriteDescriptorSet[1]) {
+                                      {
+                                          .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                          .dstSet = self->descriptor_sets[id],
+                                          .dstBinding = 0,
+                                          .dstArrayElement = 0,
+                                          .descriptorCount = 1,
+                                          .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                          .pImageInfo = &(VkDescriptorImageInfo) {
+                                              .sampler = repeat ? self->repeating_sampler : self->sampler,
+                                              .imageView = gsk_vulkan_image_get_image_view (image),
+                                              .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                                          }
                                       }
-                                  }
-                              },
-                              0, NULL);
+                                  },
+                                  0, NULL);
+        }
     }
 }
 
@@ -643,6 +846,9 @@ static void
 gsk_vulkan_render_cleanup (GskVulkanRender *self)
 {
   VkDevice device = gdk_vulkan_context_get_device (self->vulkan);
+  GHashTableIter iter;
+  gpointer key;
+  gboolean dropped_sets;
 
   /* XXX: Wait for fence here or just in reset()? */
   GSK_VK_CHECK (vkWaitForFences, device,
@@ -655,14 +861,56 @@ gsk_vulkan_render_cleanup (GskVulkanRender *self)
                                1,
                                &self->fence);
 
+  /* The fence wait above guarantees the GPU is done with the oldest
+   * slot of the vertex buffer ring, so it is safe to reuse.
+   */
+  self->current_vertex_buffer = (self->current_vertex_buffer + 1) % G_N_ELEMENTS (self->vertex_buffers);
+  self->vertex_buffer_used = 0;
+
   gsk_vulkan_uploader_reset (self->uploader);
 
   gsk_vulkan_command_pool_reset (self->command_pool);
 
-  g_hash_table_remove_all (self->descriptor_set_indexes);
-  GSK_VK_CHECK (vkResetDescriptorPool, device,
-                                       self->descriptor_pool,
-                                       0);
+  /* Descriptor sets are kept across frames, we only drop combinations
+   * that haven't been used in a while and compact the indexes so they
+   * stay a dense range.
+   */
+  self->descriptor_set_frame++;
+  dropped_sets = FALSE;
+  g_hash_table_iter_init (&iter, self->descriptor_set_indexes);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      HashDescriptorSetIndexEntry *entry = key;
+
+      if (self->descriptor_set_frame - entry->last_used > DESCRIPTOR_SET_MAX_AGE)
+        {
+          GSK_VK_CHECK (vkFreeDescriptorSets, device,
+                                              self->descriptor_pool,
+                                              1,
+                                              &self->descriptor_sets[entry->index]);
+          g_hash_table_iter_remove (&iter);
+          dropped_sets = TRUE;
+        }
+    }
+  if (dropped_sets)
+    {
+      VkDescriptorSet *sets;
+      guint i = 0;
+
+      sets = g_new (VkDescriptorSet, g_hash_table_size (self->descriptor_set_indexes));
+      g_hash_table_iter_init (&iter, self->descriptor_set_indexes);
+      while (g_hash_table_iter_next (&iter, &key, NULL))
+        {
+          HashDescriptorSetIndexEntry *entry = key;
+
+          sets[i] = self->descriptor_sets[entry->index];
+          entry->index = i;
+          i++;
+        }
+      g_free (self->descriptor_sets);
+      self->descriptor_sets = sets;
+      self->n_descriptor_sets = i;
+    }
 
   g_list_free_full (self->render_passes, (GDestroyNotify) gsk_vulkan_render_pass_free);
   self->render_passes = NULL;
@@ -702,6 +950,14 @@ gsk_vulkan_render_free (GskVulkanRender *self)
   for (i = 0; i < GSK_VULKAN_N_PIPELINES; i++)
     g_clear_object (&self->pipelines[i]);
 
+  gsk_vulkan_render_save_pipeline_cache (self);
+  vkDestroyPipelineCache (device,
+                          self->pipeline_cache,
+                          NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (self->vertex_buffers); i++)
+    g_clear_pointer (&self->vertex_buffers[i], gsk_vulkan_buffer_free);
+
   g_clear_pointer (&self->uploader, gsk_vulkan_uploader_free);
 
   for (i = 0; i < 3; i++)
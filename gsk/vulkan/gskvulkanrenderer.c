@@ -22,6 +22,7 @@ struct _GskVulkanTextureData {
   GdkTexture *texture;
   GskVulkanImage *image;
   GskVulkanRenderer *renderer;
+  gsize serial;                 /* last uploaded GdkMemoryTexture serial */
 };
 
 #ifdef G_ENABLE_DEBUG
@@ -263,6 +264,29 @@ gsk_vulkan_renderer_begin_draw_frame (GskRenderer          *renderer,
   return result;
 }
 
+static GskRendererFeatures
+gsk_vulkan_renderer_get_features (GskRenderer *renderer)
+{
+  return GSK_RENDERER_FEATURE_CHEAP_BLUR |
+         GSK_RENDERER_FEATURE_CHEAP_OFFSCREEN |
+         GSK_RENDERER_FEATURE_TEXTURE_ATLAS;
+}
+
+static int
+gsk_vulkan_renderer_get_max_texture_size (GskRenderer *renderer)
+{
+  GskVulkanRenderer *self = GSK_VULKAN_RENDERER (renderer);
+  VkPhysicalDeviceProperties props;
+
+  if (self->vulkan == NULL)
+    return 0;
+
+  vkGetPhysicalDeviceProperties (gdk_vulkan_context_get_physical_device (self->vulkan),
+                                 &props);
+
+  return props.limits.maxImageDimension2D;
+}
+
 static void
 gsk_vulkan_renderer_class_init (GskVulkanRendererClass *klass)
 {
@@ -273,6 +297,8 @@ gsk_vulkan_renderer_class_init (GskVulkanRendererClass *klass)
   renderer_class->render = gsk_vulkan_renderer_render;
   renderer_class->render_texture = gsk_vulkan_renderer_render_texture;
   renderer_class->begin_draw_frame = gsk_vulkan_renderer_begin_draw_frame;
+  renderer_class->get_features = gsk_vulkan_renderer_get_features;
+  renderer_class->get_max_texture_size = gsk_vulkan_renderer_get_max_texture_size;
 }
 
 static void
@@ -309,6 +335,71 @@ gsk_vulkan_renderer_clear_texture (gpointer p)
   g_slice_free (GskVulkanTextureData, data);
 }
 
+/* Copy only the rows that changed since we last saw the texture into
+ * the staging buffer, instead of re-uploading everything
+ */
+static void
+gsk_vulkan_renderer_update_memory_texture (GskVulkanTextureData *data,
+                                           GdkMemoryTexture     *memory,
+                                           GskVulkanUploader    *uploader)
+{
+  const gsize serial = gdk_memory_texture_get_serial (memory);
+  guchar *bytes_data;
+  gsize stride;
+  cairo_region_t *diff;
+  GskImageRegion *regions;
+  int i, n;
+
+  if (data->serial == serial)
+    return;
+
+  bytes_data = (guchar *) g_bytes_get_data (gdk_memory_texture_get_bytes (memory), NULL);
+  stride = gdk_memory_texture_get_stride (memory);
+
+  diff = gdk_memory_texture_get_diff (memory, data->serial);
+  if (diff)
+    {
+      n = cairo_region_num_rectangles (diff);
+      if (n == 0)
+        {
+          cairo_region_destroy (diff);
+          data->serial = serial;
+          return;
+        }
+
+      regions = g_newa (GskImageRegion, n);
+      for (i = 0; i < n; i++)
+        {
+          cairo_rectangle_int_t rect;
+
+          cairo_region_get_rectangle (diff, i, &rect);
+          regions[i].data = bytes_data + rect.y * stride + rect.x * 4;
+          regions[i].width = rect.width;
+          regions[i].height = rect.height;
+          regions[i].stride = stride;
+          regions[i].x = rect.x;
+          regions[i].y = rect.y;
+        }
+      cairo_region_destroy (diff);
+    }
+  else
+    {
+      /* The dirty history does not reach back to what we have */
+      n = 1;
+      regions = g_newa (GskImageRegion, 1);
+      regions[0].data = bytes_data;
+      regions[0].width = gdk_texture_get_width (GDK_TEXTURE (memory));
+      regions[0].height = gdk_texture_get_height (GDK_TEXTURE (memory));
+      regions[0].stride = stride;
+      regions[0].x = 0;
+      regions[0].y = 0;
+    }
+
+  gsk_vulkan_image_upload_regions (data->image, uploader, n, regions);
+
+  data->serial = serial;
+}
+
 GskVulkanImage *
 gsk_vulkan_renderer_ref_texture_image (GskVulkanRenderer *self,
                                        GdkTexture        *texture,
@@ -320,7 +411,12 @@ gsk_vulkan_renderer_ref_texture_image (GskVulkanRenderer *self,
 
   data = gdk_texture_get_render_data (texture, self);
   if (data)
-    return g_object_ref (data->image);
+    {
+      if (GDK_IS_MEMORY_TEXTURE (texture))
+        gsk_vulkan_renderer_update_memory_texture (data, GDK_MEMORY_TEXTURE (texture), uploader);
+
+      return g_object_ref (data->image);
+    }
 
   surface = gdk_texture_download_surface (texture);
   image = gsk_vulkan_image_new_from_data (uploader,
@@ -334,6 +430,8 @@ gsk_vulkan_renderer_ref_texture_image (GskVulkanRenderer *self,
   data->image = image;
   data->texture = texture;
   data->renderer = self;
+  if (GDK_IS_MEMORY_TEXTURE (texture))
+    data->serial = gdk_memory_texture_get_serial (GDK_MEMORY_TEXTURE (texture));
 
   if (gdk_texture_set_render_data (texture, self, data, gsk_vulkan_renderer_clear_texture))
     {
@@ -352,9 +450,10 @@ guint
 gsk_vulkan_renderer_cache_glyph (GskVulkanRenderer *self,
                                  PangoFont         *font,
                                  PangoGlyph         glyph,
-                                 float              scale)
+                                 float              scale,
+                                 guint              xshift)
 {
-  return gsk_vulkan_glyph_cache_lookup (self->glyph_cache, TRUE, font, glyph, scale)->texture_index;
+  return gsk_vulkan_glyph_cache_lookup (self->glyph_cache, TRUE, font, glyph, scale, xshift)->texture_index;
 }
 
 GskVulkanImage *
@@ -369,7 +468,8 @@ GskVulkanCachedGlyph *
 gsk_vulkan_renderer_get_cached_glyph (GskVulkanRenderer *self,
                                       PangoFont         *font,
                                       PangoGlyph         glyph,
-                                      float              scale)
+                                      float              scale,
+                                      guint              xshift)
 {
-  return gsk_vulkan_glyph_cache_lookup (self->glyph_cache, FALSE, font, glyph, scale);
+  return gsk_vulkan_glyph_cache_lookup (self->glyph_cache, FALSE, font, glyph, scale, xshift);
 }
@@ -45,7 +45,8 @@ typedef struct
 guint                  gsk_vulkan_renderer_cache_glyph      (GskVulkanRenderer *renderer,
                                                              PangoFont         *font,
                                                              PangoGlyph         glyph,
-                                                             float              scale);
+                                                             float              scale,
+                                                             guint              xshift);
 
 GskVulkanImage *       gsk_vulkan_renderer_ref_glyph_image  (GskVulkanRenderer *self,
                                                              GskVulkanUploader *uploader,
@@ -54,7 +55,8 @@ GskVulkanImage *       gsk_vulkan_renderer_ref_glyph_image  (GskVulkanRenderer *
 GskVulkanCachedGlyph * gsk_vulkan_renderer_get_cached_glyph (GskVulkanRenderer *self,
                                                              PangoFont         *font,
                                                              PangoGlyph         glyph,
-                                                             float              scale);
+                                                             float              scale,
+                                                             guint              xshift);
 
 
 G_END_DECLS
@@ -15,6 +15,7 @@
 #include "gskvulkanclipprivate.h"
 #include "gskvulkancolorpipelineprivate.h"
 #include "gskvulkancolortextpipelineprivate.h"
+#include "gskvulkancommandpoolprivate.h"
 #include "gskvulkancrossfadepipelineprivate.h"
 #include "gskvulkaneffectpipelineprivate.h"
 #include "gskvulkanlineargradientpipelineprivate.h"
@@ -26,10 +27,22 @@
 #include "gskprivate.h"
 
 #include <cairo-ft.h>
+#include <math.h>
 
 #define ORTHO_NEAR_PLANE        -10000
 #define ORTHO_FAR_PLANE          10000
 
+/* Command recording is split across up to this many secondary command
+ * buffers, but only when every chunk gets enough ops to make the thread
+ * handoff worthwhile. */
+#define MAX_RECORD_THREADS 8
+#define MIN_OPS_PER_THREAD 32
+
+/* Blurs above this radius are split into two 1D passes; the single-pass
+ * 2D kernel gets both slow and inaccurate when the radius outgrows it.
+ * Compare the large-radius special case in gskcairoblur.c. */
+#define BLUR_SEPARABLE_MIN_RADIUS 10.0
+
 typedef union _GskVulkanOp GskVulkanOp;
 typedef struct _GskVulkanOpRender GskVulkanOpRender;
 typedef struct _GskVulkanOpText GskVulkanOpText;
@@ -75,6 +88,9 @@ struct _GskVulkanOpRender
   gsize                descriptor_set_index2; /* descriptor index for the second source (if relevant) */
   graphene_rect_t      source_rect; /* area that source maps to */
   graphene_rect_t      source2_rect; /* area that source2 maps to */
+  graphene_rect_t      blur_rect; /* rect to draw for blur ops */
+  float                blur_radius; /* radius for blur ops */
+  float                blur_dir[2]; /* direction for separable blur ops, (0, 0) blurs both at once */
 };
 
 struct _GskVulkanOpText
@@ -125,6 +141,9 @@ struct _GskVulkanRenderPass
   VkSemaphore signal_semaphore;
   GArray *wait_semaphores;
   GskVulkanBuffer *vertex_data;
+  guint vertex_data_owned : 1;
+
+  GskVulkanCommandPool *record_pools[MAX_RECORD_THREADS]; /* one pool per recording thread */
 
   GQuark fallback_pixels;
   GQuark texture_pixels;
@@ -217,6 +236,16 @@ gsk_vulkan_render_pass_new (GdkVulkanContext  *context,
 void
 gsk_vulkan_render_pass_free (GskVulkanRenderPass *self)
 {
+  guint i;
+
+  /* We are only freed after the frame fence was waited on, so the GPU
+   * is done with the secondary command buffers in these pools. */
+  for (i = 0; i < G_N_ELEMENTS (self->record_pools); i++)
+    {
+      if (self->record_pools[i])
+        gsk_vulkan_command_pool_free (self->record_pools[i]);
+    }
+
   g_array_unref (self->render_ops);
   g_object_unref (self->vulkan);
   g_object_unref (self->target);
@@ -224,7 +253,7 @@ gsk_vulkan_render_pass_free (GskVulkanRenderPass *self)
   vkDestroyRenderPass (gdk_vulkan_context_get_device (self->vulkan),
                        self->render_pass,
                        NULL);
-  if (self->vertex_data)
+  if (self->vertex_data && self->vertex_data_owned)
     gsk_vulkan_buffer_free (self->vertex_data);
   if (self->signal_semaphore != VK_NULL_HANDLE)
     vkDestroySemaphore (gdk_vulkan_context_get_device (self->vulkan),
@@ -270,6 +299,12 @@ gsk_vulkan_render_pass_add_node (GskVulkanRenderPass           *self,
   };
   GskVulkanPipelineType pipeline_type;
 
+  /* Nothing to draw for nodes entirely outside of the clip; this prunes
+   * whole subtrees, since node bounds contain the bounds of all children */
+  if (constants->clip.type == GSK_VULKAN_CLIP_ALL_CLIPPED ||
+      !graphene_rect_intersection (&constants->clip.rect.bounds, &node->bounds, NULL))
+    return;
+
   switch (gsk_render_node_get_node_type (node))
     {
     case GSK_NOT_A_RENDER_NODE:
@@ -375,6 +410,8 @@ gsk_vulkan_render_pass_add_node (GskVulkanRenderPass           *self,
         const PangoGlyphInfo *glyphs = gsk_text_node_peek_glyphs (node);
         guint num_glyphs = gsk_text_node_get_num_glyphs (node);
         int i;
+        int x_position = 0;
+        float text_x = gsk_text_node_get_x (node);
         guint count;
         guint texture_index;
         GskVulkanRenderer *renderer = GSK_VULKAN_RENDERER (gsk_vulkan_render_get_renderer (render));
@@ -412,8 +449,10 @@ gsk_vulkan_render_pass_add_node (GskVulkanRenderPass           *self,
         for (i = 0, count = 0; i < num_glyphs; i++)
           {
             const PangoGlyphInfo *gi = &glyphs[i];
+            float fx = text_x + (float)(x_position + gi->geometry.x_offset) / PANGO_SCALE;
+            guint xshift = (guint)((fx - floorf (fx)) * 4 + 0.5) % 4;
 
-            texture_index = gsk_vulkan_renderer_cache_glyph (renderer, (PangoFont *)font, gi->glyph, op.text.scale);
+            texture_index = gsk_vulkan_renderer_cache_glyph (renderer, (PangoFont *)font, gi->glyph, op.text.scale, xshift);
             if (op.text.texture_index == G_MAXUINT)
               op.text.texture_index = texture_index;
             if (texture_index != op.text.texture_index)
@@ -428,6 +467,8 @@ gsk_vulkan_render_pass_add_node (GskVulkanRenderPass           *self,
               }
             else
               count++;
+
+            x_position += gi->geometry.width;
           }
 
         if (op.text.texture_index != G_MAXUINT && count != 0)
@@ -511,6 +552,8 @@ gsk_vulkan_render_pass_add_node (GskVulkanRenderPass           *self,
         FALLBACK ("Blur nodes can't deal with clip type %u", constants->clip.type);
       op.type = GSK_VULKAN_OP_BLUR;
       op.render.pipeline = gsk_vulkan_render_get_pipeline (render, pipeline_type);
+      op.render.blur_rect = node->bounds;
+      op.render.blur_radius = gsk_blur_node_get_radius (node);
       g_array_append_val (self->render_ops, op);
       return;
 
@@ -815,6 +858,103 @@ got_surface:
   return result;
 }
 
+/* Renders @source into a new image of the same size with a horizontal
+ * 1D blur applied, using a dedicated render pass that runs before this
+ * one. Drawing the result with a vertical 1D blur gives the same
+ * Gaussian as the 2D kernel, but at a cost that is linear in the
+ * radius instead of quadratic.
+ */
+static GskVulkanImage *
+gsk_vulkan_render_pass_blur_texture (GskVulkanRenderPass *self,
+                                     GskVulkanRender     *render,
+                                     GskRenderNode       *node,
+                                     GskVulkanImage      *source,
+                                     guint                first_wait_semaphore,
+                                     float                radius)
+{
+  GskVulkanRenderPass *pass;
+  GskVulkanImage *result;
+  VkSemaphore semaphore;
+  cairo_region_t *clip;
+  graphene_matrix_t identity;
+  graphene_matrix_t mvp;
+  graphene_rect_t viewport;
+  GskVulkanOp op = { 0, };
+  guint i;
+
+  viewport = GRAPHENE_RECT_INIT (0, 0,
+                                 gsk_vulkan_image_get_width (source),
+                                 gsk_vulkan_image_get_height (source));
+
+  result = gsk_vulkan_image_new_for_texture (self->vulkan,
+                                             viewport.size.width,
+                                             viewport.size.height);
+
+  vkCreateSemaphore (gdk_vulkan_context_get_device (self->vulkan),
+                     &(VkSemaphoreCreateInfo) {
+                       VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+                       NULL,
+                       0
+                     },
+                     NULL,
+                     &semaphore);
+
+  clip = cairo_region_create_rectangle (&(cairo_rectangle_int_t) {
+                                          0, 0,
+                                          gsk_vulkan_image_get_width (source),
+                                          gsk_vulkan_image_get_height (source)
+                                        });
+
+  graphene_matrix_init_identity (&identity);
+
+  pass = gsk_vulkan_render_pass_new (self->vulkan,
+                                     result,
+                                     1,
+                                     &identity,
+                                     &viewport,
+                                     clip,
+                                     semaphore);
+
+  cairo_region_destroy (clip);
+
+  /* The new pass consumes the source, so it takes over the waits for
+   * the passes rendering it; we wait for the new pass instead. */
+  for (i = first_wait_semaphore; i < self->wait_semaphores->len; i++)
+    g_array_append_val (pass->wait_semaphores,
+                        g_array_index (self->wait_semaphores, VkSemaphore, i));
+  g_array_set_size (self->wait_semaphores, first_wait_semaphore);
+  g_array_append_val (self->wait_semaphores, semaphore);
+
+  op.type = GSK_VULKAN_OP_PUSH_VERTEX_CONSTANTS;
+  graphene_matrix_multiply (&pass->mv, &pass->p, &mvp);
+  gsk_vulkan_push_constants_init (&op.constants.constants, &mvp, &pass->viewport);
+  g_array_append_val (pass->render_ops, op);
+
+  op = (GskVulkanOp) { 0, };
+  op.type = GSK_VULKAN_OP_BLUR;
+  op.render.node = node;
+  op.render.pipeline = gsk_vulkan_render_get_pipeline (render, GSK_VULKAN_PIPELINE_BLUR);
+  op.render.source = source;
+  op.render.source_rect = GRAPHENE_RECT_INIT (0, 0, 1, 1);
+  op.render.blur_rect = viewport;
+  op.render.blur_radius = radius;
+  op.render.blur_dir[0] = 1.0;
+  op.render.blur_dir[1] = 0.0;
+  g_array_append_val (pass->render_ops, op);
+
+  /* If the source comes out of a render pass of its own, that pass is
+   * the one added most recently and has to stay in front of us;
+   * otherwise the source is just an uploaded image and we can go
+   * anywhere before the consuming pass. */
+  if (pass->wait_semaphores->len > 0)
+    gsk_vulkan_render_add_dependent_render_pass (render, pass);
+  else
+    gsk_vulkan_render_add_render_pass (render, pass);
+  gsk_vulkan_render_add_cleanup_image (render, result);
+
+  return result;
+}
+
 static void
 gsk_vulkan_render_pass_upload_fallback (GskVulkanRenderPass  *self,
                                         GskVulkanOpRender    *op,
@@ -979,7 +1119,16 @@ gsk_vulkan_render_pass_upload (GskVulkanRenderPass  *self,
 
         case GSK_VULKAN_OP_BLUR:
           {
-            GskRenderNode *child = gsk_blur_node_get_child (op->render.node);
+            GskRenderNode *child;
+            guint first_wait_semaphore;
+
+            /* Ops of intermediate separable blur passes come with their
+             * source preassigned */
+            if (op->render.source)
+              break;
+
+            child = gsk_blur_node_get_child (op->render.node);
+            first_wait_semaphore = self->wait_semaphores->len;
 
             op->render.source = gsk_vulkan_render_pass_get_node_as_texture (self,
                                                                             render,
@@ -988,6 +1137,19 @@ gsk_vulkan_render_pass_upload (GskVulkanRenderPass  *self,
                                                                             &child->bounds,
                                                                             clip,
                                                                             &op->render.source_rect);
+
+            if (op->render.source != NULL &&
+                op->render.blur_radius > BLUR_SEPARABLE_MIN_RADIUS)
+              {
+                op->render.source = gsk_vulkan_render_pass_blur_texture (self,
+                                                                         render,
+                                                                         op->render.node,
+                                                                         op->render.source,
+                                                                         first_wait_semaphore,
+                                                                         op->render.blur_radius);
+                op->render.blur_dir[0] = 0.0;
+                op->render.blur_dir[1] = 1.0;
+              }
           }
           break;
 
@@ -1313,9 +1475,11 @@ gsk_vulkan_render_pass_collect_vertex_data (GskVulkanRenderPass *self,
             op->render.vertex_offset = offset + n_bytes;
             gsk_vulkan_blur_pipeline_collect_vertex_data (GSK_VULKAN_BLUR_PIPELINE (op->render.pipeline),
                                                           data + n_bytes + offset,
-                                                          &op->render.node->bounds,
+                                                          &op->render.blur_rect,
                                                           &op->render.source_rect,
-                                                          gsk_blur_node_get_radius (op->render.node));
+                                                          op->render.blur_radius,
+                                                          op->render.blur_dir[0],
+                                                          op->render.blur_dir[1]);
             n_bytes += op->render.vertex_count;
           }
           break;
@@ -1420,13 +1584,29 @@ gsk_vulkan_render_pass_get_vertex_data (GskVulkanRenderPass *self,
   if (self->vertex_data == NULL)
     {
       gsize n_bytes;
+      gsize offset;
       guchar *data;
 
       n_bytes = gsk_vulkan_render_pass_count_vertex_data (self);
-      self->vertex_data = gsk_vulkan_buffer_new (self->vulkan, n_bytes);
-      data = gsk_vulkan_buffer_map (self->vertex_data);
-      gsk_vulkan_render_pass_collect_vertex_data (self, render, data, 0, n_bytes);
-      gsk_vulkan_buffer_unmap (self->vertex_data);
+
+      /* Write straight into the render's persistently mapped vertex
+       * buffer ring; the vertex offsets stored in the ops account for
+       * where in the buffer our range starts.
+       */
+      self->vertex_data = gsk_vulkan_render_reserve_vertex_data (render, n_bytes, &offset, &data);
+      if (self->vertex_data != NULL)
+        {
+          gsk_vulkan_render_pass_collect_vertex_data (self, render, data, offset, n_bytes);
+        }
+      else
+        {
+          /* Didn't fit in the ring buffer; fall back to a buffer of our own */
+          self->vertex_data = gsk_vulkan_buffer_new (self->vulkan, n_bytes);
+          self->vertex_data_owned = TRUE;
+          data = gsk_vulkan_buffer_map (self->vertex_data);
+          gsk_vulkan_render_pass_collect_vertex_data (self, render, data, 0, n_bytes);
+          gsk_vulkan_buffer_unmap (self->vertex_data);
+        }
     }
 
   return self->vertex_data;
@@ -1506,12 +1686,20 @@ gsk_vulkan_render_pass_reserve_descriptor_sets (GskVulkanRenderPass *self,
     }
 }
 
+/* Records the ops in [first, first + count) into a command buffer.
+ * The range may start anywhere in the op stream; recording starts out
+ * with the vertex constants that were in effect at that point, so that
+ * ranges recorded into separate secondary command buffers concatenate
+ * to the same command stream a single-threaded walk would produce.
+ */
 static void
-gsk_vulkan_render_pass_draw_rect (GskVulkanRenderPass     *self,
-                                  GskVulkanRender         *render,
-                                  guint                    layout_count,
-                                  VkPipelineLayout        *pipeline_layout,
-                                  VkCommandBuffer          command_buffer)
+gsk_vulkan_render_pass_record_ops (GskVulkanRenderPass     *self,
+                                   GskVulkanRender         *render,
+                                   guint                    layout_count,
+                                   VkPipelineLayout        *pipeline_layout,
+                                   VkCommandBuffer          command_buffer,
+                                   guint                    first,
+                                   guint                    count)
 {
   GskVulkanPipeline *current_pipeline = NULL;
   gsize current_draw_index = 0;
@@ -1519,9 +1707,22 @@ gsk_vulkan_render_pass_draw_rect (GskVulkanRenderPass     *self,
   guint i, step;
   GskVulkanBuffer *vertex_buffer;
 
-  vertex_buffer = gsk_vulkan_render_pass_get_vertex_data (self, render);
+  vertex_buffer = self->vertex_data;
 
-  for (i = 0; i < self->render_ops->len; i += step)
+  for (i = first; i-- > 0; )
+    {
+      op = &g_array_index (self->render_ops, GskVulkanOp, i);
+      if (op->type == GSK_VULKAN_OP_PUSH_VERTEX_CONSTANTS)
+        {
+          for (int j = 0; j < layout_count; j++)
+            gsk_vulkan_push_constants_push (&op->constants.constants,
+                                            command_buffer,
+                                            pipeline_layout[j]);
+          break;
+        }
+    }
+
+  for (i = first; i < first + count; i += step)
     {
       op = &g_array_index (self->render_ops, GskVulkanOp, i);
       step = 1;
@@ -1722,7 +1923,7 @@ gsk_vulkan_render_pass_draw_rect (GskVulkanRenderPass     *self,
               current_draw_index = 0;
             }
 
-          for (step = 1; step + i < self->render_ops->len; step++)
+          for (step = 1; step + i < first + count; step++)
             {
               GskVulkanOp *cmp = &g_array_index (self->render_ops, GskVulkanOp, i + step);
               if (cmp->type != GSK_VULKAN_OP_COLOR || 
@@ -1884,6 +2085,70 @@ gsk_vulkan_render_pass_draw_rect (GskVulkanRenderPass     *self,
     }
 }
 
+typedef struct _GskVulkanRecordJob GskVulkanRecordJob;
+
+struct _GskVulkanRecordJob
+{
+  GskVulkanRenderPass *pass;
+  GskVulkanRender *render;
+  guint layout_count;
+  VkPipelineLayout *pipeline_layout;
+
+  GskVulkanCommandPool *command_pool;
+  VkCommandBuffer command_buffer;
+  VkViewport viewport;
+  VkRect2D scissor;
+  guint first;
+  guint count;
+
+  GMutex *mutex;
+  GCond *cond;
+  guint *n_jobs_remaining;
+};
+
+static void
+gsk_vulkan_render_pass_record_job (gpointer data,
+                                   gpointer user_data)
+{
+  GskVulkanRecordJob *job = data;
+
+  /* Secondary command buffers don't inherit dynamic state,
+   * so every chunk sets it up again */
+  vkCmdSetViewport (job->command_buffer, 0, 1, &job->viewport);
+  vkCmdSetScissor (job->command_buffer, 0, 1, &job->scissor);
+
+  gsk_vulkan_render_pass_record_ops (job->pass, job->render,
+                                     job->layout_count, job->pipeline_layout,
+                                     job->command_buffer,
+                                     job->first, job->count);
+
+  gsk_vulkan_command_pool_end_buffer (job->command_pool, job->command_buffer);
+
+  g_mutex_lock (job->mutex);
+  (*job->n_jobs_remaining)--;
+  g_cond_signal (job->cond);
+  g_mutex_unlock (job->mutex);
+}
+
+static GThreadPool *
+gsk_vulkan_render_pass_get_thread_pool (void)
+{
+  static gsize init = 0;
+  static GThreadPool *thread_pool;
+
+  if (g_once_init_enter (&init))
+    {
+      thread_pool = g_thread_pool_new (gsk_vulkan_render_pass_record_job,
+                                       NULL,
+                                       MIN (MAX_RECORD_THREADS, g_get_num_processors ()),
+                                       FALSE,
+                                       NULL);
+      g_once_init_leave (&init, 1);
+    }
+
+  return thread_pool;
+}
+
 void
 gsk_vulkan_render_pass_draw (GskVulkanRenderPass     *self,
                              GskVulkanRender         *render,
@@ -1891,51 +2156,129 @@ gsk_vulkan_render_pass_draw (GskVulkanRenderPass     *self,
                              VkPipelineLayout        *pipeline_layout,
                              VkCommandBuffer          command_buffer)
 {
+  VkFramebuffer framebuffer;
+  VkViewport viewport;
+  guint n_chunks;
   guint i;
 
+  /* Collect the vertex data up front, the recording threads only read it */
+  gsk_vulkan_render_pass_get_vertex_data (self, render);
+
+  framebuffer = gsk_vulkan_render_get_framebuffer (render, self->target);
+
+  viewport = (VkViewport) {
+                 .x = 0,
+                 .y = 0,
+                 .width = self->viewport.size.width,
+                 .height = self->viewport.size.height,
+                 .minDepth = 0,
+                 .maxDepth = 1
+             };
+
+  /* Split the op stream into consecutive chunks, one per recording
+   * thread. The stream is emitted in tree order, so consecutive chunks
+   * roughly correspond to disjoint areas of the scene. Small scenes
+   * are recorded inline as before. */
+  n_chunks = MIN (self->render_ops->len / MIN_OPS_PER_THREAD, g_get_num_processors ());
+  n_chunks = MIN (n_chunks, MAX_RECORD_THREADS);
+
   vkCmdSetViewport (command_buffer,
                     0,
                     1,
-                    &(VkViewport) {
-                        .x = 0,
-                        .y = 0,
-                        .width = self->viewport.size.width,
-                        .height = self->viewport.size.height,
-                        .minDepth = 0,
-                        .maxDepth = 1
-                    });
+                    &viewport);
 
   for (i = 0; i < cairo_region_num_rectangles (self->clip); i++)
     {
       cairo_rectangle_int_t rect;
+      VkRect2D scissor;
 
       cairo_region_get_rectangle (self->clip, i, &rect);
 
+      scissor = (VkRect2D) {
+                    { rect.x * self->scale_factor, rect.y * self->scale_factor },
+                    { rect.width * self->scale_factor, rect.height * self->scale_factor }
+                };
+
       vkCmdSetScissor (command_buffer,
                        0,
                        1,
-                       &(VkRect2D) {
-                          { rect.x * self->scale_factor, rect.y * self->scale_factor },
-                          { rect.width * self->scale_factor, rect.height * self->scale_factor }
-                       });
+                       &scissor);
 
       vkCmdBeginRenderPass (command_buffer,
                             &(VkRenderPassBeginInfo) {
                                 .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
                                 .renderPass = self->render_pass,
-                                .framebuffer = gsk_vulkan_render_get_framebuffer (render, self->target),
-                                .renderArea = { 
-                                    { rect.x * self->scale_factor, rect.y * self->scale_factor },
-                                    { rect.width * self->scale_factor, rect.height * self->scale_factor }
-                                },
+                                .framebuffer = framebuffer,
+                                .renderArea = scissor,
                                 .clearValueCount = 1,
                                 .pClearValues = (VkClearValue [1]) {
                                     { .color = { .float32 = { 0.f, 0.f, 0.f, 0.f } } }
                                 }
                             },
-                            VK_SUBPASS_CONTENTS_INLINE);
+                            n_chunks < 2 ? VK_SUBPASS_CONTENTS_INLINE
+                                         : VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
-      gsk_vulkan_render_pass_draw_rect (self, render, layout_count, pipeline_layout, command_buffer);
+      if (n_chunks < 2)
+        {
+          gsk_vulkan_render_pass_record_ops (self, render, layout_count, pipeline_layout,
+                                             command_buffer,
+                                             0, self->render_ops->len);
+        }
+      else
+        {
+          GskVulkanRecordJob jobs[MAX_RECORD_THREADS];
+          VkCommandBuffer buffers[MAX_RECORD_THREADS];
+          GThreadPool *thread_pool = gsk_vulkan_render_pass_get_thread_pool ();
+          GMutex mutex;
+          GCond cond;
+          guint n_jobs_remaining;
+          guint first, j;
+
+          g_mutex_init (&mutex);
+          g_cond_init (&cond);
+          n_jobs_remaining = n_chunks;
+
+          first = 0;
+          for (j = 0; j < n_chunks; j++)
+            {
+              GskVulkanRecordJob *job = &jobs[j];
+
+              /* Command pools are not thread-safe, every chunk gets its own */
+              if (self->record_pools[j] == NULL)
+                self->record_pools[j] = gsk_vulkan_command_pool_new (self->vulkan);
+
+              job->pass = self;
+              job->render = render;
+              job->layout_count = layout_count;
+              job->pipeline_layout = pipeline_layout;
+              job->command_pool = self->record_pools[j];
+              job->command_buffer = gsk_vulkan_command_pool_get_secondary_buffer (job->command_pool,
+                                                                                  self->render_pass,
+                                                                                  framebuffer);
+              job->viewport = viewport;
+              job->scissor = scissor;
+              job->first = first;
+              job->count = (self->render_ops->len - first) / (n_chunks - j);
+              job->mutex = &mutex;
+              job->cond = &cond;
+              job->n_jobs_remaining = &n_jobs_remaining;
+
+              buffers[j] = job->command_buffer;
+              first += job->count;
+
+              g_thread_pool_push (thread_pool, job, NULL);
+            }
+
+          g_mutex_lock (&mutex);
+          while (n_jobs_remaining > 0)
+            g_cond_wait (&cond, &mutex);
+          g_mutex_unlock (&mutex);
+
+          vkCmdExecuteCommands (command_buffer, n_chunks, buffers);
+
+          g_mutex_clear (&mutex);
+          g_cond_clear (&cond);
+        }
 
       vkCmdEndRenderPass (command_buffer);
     }
@@ -4,6 +4,7 @@
 #include <gdk/gdk.h>
 #include <gsk/gskrendernode.h>
 
+#include "gskvulkanbufferprivate.h"
 #include "gskvulkanimageprivate.h"
 #include "gskvulkanpipelineprivate.h"
 #include "gskvulkanrenderpassprivate.h"
@@ -71,6 +72,8 @@ void                    gsk_vulkan_render_add_node                      (GskVulk
 
 void                    gsk_vulkan_render_add_render_pass               (GskVulkanRender        *self,
                                                                          GskVulkanRenderPass    *pass);
+void                    gsk_vulkan_render_add_dependent_render_pass     (GskVulkanRender        *self,
+                                                                         GskVulkanRenderPass    *pass);
 
 void                    gsk_vulkan_render_upload                        (GskVulkanRender        *self);
 
@@ -81,6 +84,10 @@ VkDescriptorSet         gsk_vulkan_render_get_descriptor_set            (GskVulk
 gsize                   gsk_vulkan_render_reserve_descriptor_set        (GskVulkanRender        *self,
                                                                          GskVulkanImage         *source,
                                                                          gboolean                repeat);
+GskVulkanBuffer *       gsk_vulkan_render_reserve_vertex_data           (GskVulkanRender        *self,
+                                                                         gsize                   size,
+                                                                         gsize                  *offset,
+                                                                         guchar                **data);
 void                    gsk_vulkan_render_draw                          (GskVulkanRender        *self);
 
 void                    gsk_vulkan_render_submit                        (GskVulkanRender        *self);
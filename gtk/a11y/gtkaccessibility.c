@@ -20,12 +20,45 @@
 #include "gtkaccessibility.h"
 #include "gtkaccessibilityutil.h"
 
+#include <gio/gio.h>
+
 #ifdef GDK_WINDOWING_X11
 #include <atk-bridge.h>
 #endif
 
 static int initialized = FALSE;
 
+/* Whether the session wants toolkit accessibility at all; when it is
+ * switched off we never connect to the AT-SPI registry daemon, so
+ * sessions without assistive technologies pay no a11y bus cost
+ */
+static gboolean
+accessibility_enabled (void)
+{
+  GSettingsSchema *schema;
+  GSettings *settings;
+  gboolean enabled;
+
+  enabled = TRUE;
+
+  schema = g_settings_schema_source_lookup (g_settings_schema_source_get_default (),
+                                            "org.gnome.desktop.interface",
+                                            TRUE);
+
+  if (schema)
+    {
+      if (g_settings_schema_has_key (schema, "toolkit-accessibility"))
+        {
+          settings = g_settings_new_full (schema, NULL, NULL);
+          enabled = g_settings_get_boolean (settings, "toolkit-accessibility");
+          g_object_unref (settings);
+        }
+      g_settings_schema_unref (schema);
+    }
+
+  return enabled;
+}
+
 void
 _gtk_accessibility_init (void)
 {
@@ -37,7 +70,8 @@ _gtk_accessibility_init (void)
   _gtk_accessibility_override_atk_util ();
 
 #ifdef GDK_WINDOWING_X11
-  atk_bridge_adaptor_init (NULL, NULL);
+  if (accessibility_enabled ())
+    atk_bridge_adaptor_init (NULL, NULL);
 #endif
 
 }
@@ -21,6 +21,7 @@
 #ifdef GDK_WINDOWING_X11
 #include <gdk/x11/gdkx.h>
 #endif
+#include "gtkaccessibleprivate.h"
 #include "gtkwidgetaccessibleprivate.h"
 #include "gtknotebookpageaccessible.h"
 
@@ -102,8 +103,8 @@ map_cb (GtkWidget *widget)
   AtkObject *accessible;
 
   accessible = gtk_widget_get_accessible (widget);
-  atk_object_notify_state_change (accessible, ATK_STATE_SHOWING,
-                                  gtk_widget_get_mapped (widget));
+  _gtk_accessible_queue_state_change (accessible, ATK_STATE_SHOWING,
+                                      gtk_widget_get_mapped (widget));
   return 1;
 }
 
@@ -116,7 +117,7 @@ gtk_widget_accessible_focus_event (AtkObject *obj,
   focus_obj = g_object_get_data (G_OBJECT (obj), "gail-focus-object");
   if (focus_obj == NULL)
     focus_obj = obj;
-  atk_object_notify_state_change (focus_obj, ATK_STATE_FOCUSED, focus_in);
+  _gtk_accessible_queue_state_change (focus_obj, ATK_STATE_FOCUSED, focus_in);
 }
 
 static void
@@ -508,12 +509,12 @@ gtk_widget_accessible_notify_gtk (GObject    *obj,
   else
     return;
 
-  atk_object_notify_state_change (atk_obj, state, value);
+  _gtk_accessible_queue_state_change (atk_obj, state, value);
   if (state == ATK_STATE_SENSITIVE)
-    atk_object_notify_state_change (atk_obj, ATK_STATE_ENABLED, value);
+    _gtk_accessible_queue_state_change (atk_obj, ATK_STATE_ENABLED, value);
 
   if (state == ATK_STATE_HORIZONTAL)
-    atk_object_notify_state_change (atk_obj, ATK_STATE_VERTICAL, !value);
+    _gtk_accessible_queue_state_change (atk_obj, ATK_STATE_VERTICAL, !value);
 }
 
 static AtkAttributeSet *
@@ -16,11 +16,17 @@ xml = '''<?xml version='1.0' encoding='UTF-8'?>
 def get_files(subdir,extension):
   return sorted(filter(lambda x: x.endswith((extension)), os.listdir(os.path.join(srcdir,subdir))))
 
+# Text resources (css, svg, ui) are stored zlib-compressed: only the
+# files actually opened get inflated, and they are parsed once and
+# thrown away. Binary data (png, emoji.data) is already compressed and
+# stays uncompressed in the bundle, so GResource serves it directly
+# out of the mmap'ed file without copying it onto the heap.
+
 xml += '''
-    <file>theme/Adwaita/gtk.css</file>
-    <file>theme/Adwaita/gtk-dark.css</file>
-    <file>theme/Adwaita/gtk-contained.css</file>
-    <file>theme/Adwaita/gtk-contained-dark.css</file>
+    <file compressed='true'>theme/Adwaita/gtk.css</file>
+    <file compressed='true'>theme/Adwaita/gtk-dark.css</file>
+    <file compressed='true'>theme/Adwaita/gtk-contained.css</file>
+    <file compressed='true'>theme/Adwaita/gtk-contained-dark.css</file>
 '''
 
 for f in get_files('theme/Adwaita/assets', '.png'):
@@ -29,13 +35,13 @@ for f in get_files('theme/Adwaita/assets', '.png'):
 xml += '\n'
 
 for f in get_files('theme/Adwaita/assets', '.svg'):
-  xml += '    <file>theme/Adwaita/assets/{0}</file>\n'.format(f)
+  xml += '    <file compressed=\'true\'>theme/Adwaita/assets/{0}</file>\n'.format(f)
 
 xml += '''
-    <file>theme/HighContrast/gtk.css</file>
-    <file alias='theme/HighContrastInverse/gtk.css'>theme/HighContrast/gtk-inverse.css</file>
-    <file>theme/HighContrast/gtk-contained.css</file>
-    <file>theme/HighContrast/gtk-contained-inverse.css</file>
+    <file compressed='true'>theme/HighContrast/gtk.css</file>
+    <file compressed='true' alias='theme/HighContrastInverse/gtk.css'>theme/HighContrast/gtk-inverse.css</file>
+    <file compressed='true'>theme/HighContrast/gtk-contained.css</file>
+    <file compressed='true'>theme/HighContrast/gtk-contained-inverse.css</file>
 '''
 
 for f in get_files('theme/HighContrast/assets', '.png'):
@@ -44,11 +50,11 @@ for f in get_files('theme/HighContrast/assets', '.png'):
 xml += '\n'
 
 for f in get_files('theme/HighContrast/assets', '.svg'):
-  xml += '    <file>theme/HighContrast/assets/{0}</file>\n'.format(f)
+  xml += '    <file compressed=\'true\'>theme/HighContrast/assets/{0}</file>\n'.format(f)
 
 xml += '''
-    <file>theme/win32/gtk-win32-base.css</file>
-    <file>theme/win32/gtk.css</file>
+    <file compressed='true'>theme/win32/gtk-win32-base.css</file>
+    <file compressed='true'>theme/win32/gtk.css</file>
 '''
 
 for f in get_files('cursor', '.png'):
@@ -62,7 +68,7 @@ for f in get_files('gesture', '.symbolic.png'):
 xml += '\n'
 
 for f in get_files('ui', '.ui'):
-  xml += '    <file preprocess=\'xml-stripblanks\'>ui/{0}</file>\n'.format(f)
+  xml += '    <file compressed=\'true\' preprocess=\'xml-stripblanks\'>ui/{0}</file>\n'.format(f)
 
 xml += '\n'
 
@@ -74,7 +80,7 @@ for s in ['16x16', '22x22', '24x24', '32x32', '48x48']:
         xml += '    <file>icons/{0}/{1}/{2}</file>\n'.format(s,c,f)
 
 for f in get_files('inspector', '.ui'):
-  xml += '    <file preprocess=\'xml-stripblanks\'>inspector/{0}</file>\n'.format(f)
+  xml += '    <file compressed=\'true\' preprocess=\'xml-stripblanks\'>inspector/{0}</file>\n'.format(f)
 
 xml += '''
     <file>inspector/logo.png</file>
@@ -20,10 +20,14 @@
 #include "config.h"
 
 #include "gsk/gsk.h"
+#include "gsk/gskdebugprivate.h"
+#include "gsk/gskprofilerprivate.h"
+#include "gsk/gskrendernodeprivate.h"
 #include "gskpango.h"
 #include "gtksnapshotprivate.h"
 
 #include <math.h>
+#include <string.h>
 
 #include <pango/pango.h>
 #include <cairo.h>
@@ -99,6 +103,163 @@ set_color (GskPangoRenderer *crenderer,
   gdk_cairo_set_source_rgba (cr, &rgba);
 }
 
+/* The shaping itself happens in Pango and is cached per widget in the
+ * PangoLayout, but identical runs ("Cancel" on every button) still get
+ * re-measured here on every snapshot, and pango_glyph_string_extents()
+ * touches font metrics for each glyph. Cache the extents process-wide,
+ * keyed by font and glyph string contents, so repeated runs only pay
+ * for the node allocation.
+ */
+
+#define SHAPED_RUN_CACHE_MAX_SIZE       1024
+#define SHAPED_RUN_STATS_INTERVAL       1024
+
+typedef struct {
+  PangoFont *font;
+  guint hash;
+  int num_glyphs;
+  PangoGlyphInfo *glyphs;
+  PangoRectangle ink_rect;      /* in pixels */
+} ShapedRunEntry;
+
+static GHashTable *shaped_run_cache;
+static GskProfiler *shaped_run_profiler;
+static GQuark shaped_run_hits;
+static GQuark shaped_run_misses;
+static GQuark shaped_run_evictions;
+
+static guint
+shaped_run_entry_hash (gconstpointer data)
+{
+  const ShapedRunEntry *entry = data;
+
+  return entry->hash;
+}
+
+static gboolean
+shaped_run_entry_equal (gconstpointer a,
+                        gconstpointer b)
+{
+  const ShapedRunEntry *entry_a = a;
+  const ShapedRunEntry *entry_b = b;
+
+  return entry_a->font == entry_b->font &&
+         entry_a->num_glyphs == entry_b->num_glyphs &&
+         memcmp (entry_a->glyphs, entry_b->glyphs,
+                 sizeof (PangoGlyphInfo) * entry_a->num_glyphs) == 0;
+}
+
+static void
+shaped_run_entry_free (gpointer data)
+{
+  ShapedRunEntry *entry = data;
+
+  g_object_unref (entry->font);
+  g_free (entry->glyphs);
+  g_slice_free (ShapedRunEntry, entry);
+}
+
+static guint
+shaped_run_hash (PangoFont        *font,
+                 PangoGlyphString *glyphs)
+{
+  guint hash = g_direct_hash (font);
+  int i;
+
+  for (i = 0; i < glyphs->num_glyphs; i++)
+    {
+      const PangoGlyphInfo *glyph = &glyphs->glyphs[i];
+
+      hash = hash * 33 + glyph->glyph;
+      hash = hash * 33 + glyph->geometry.width;
+      hash = hash * 33 + glyph->geometry.x_offset;
+      hash = hash * 33 + glyph->geometry.y_offset;
+    }
+
+  return hash;
+}
+
+#ifdef G_ENABLE_DEBUG
+static void
+shaped_run_cache_maybe_dump_stats (void)
+{
+  gint64 lookups;
+
+  lookups = gsk_profiler_counter_get (shaped_run_profiler, shaped_run_hits) +
+            gsk_profiler_counter_get (shaped_run_profiler, shaped_run_misses);
+  if (lookups % SHAPED_RUN_STATS_INTERVAL == 0)
+    {
+      GString *buffer = g_string_new ("Shaped run cache:\n");
+
+      gsk_profiler_append_counters (shaped_run_profiler, buffer);
+      g_string_append_printf (buffer, "\tEntries ............... %u\n",
+                              g_hash_table_size (shaped_run_cache));
+      g_print ("%s", buffer->str);
+      g_string_free (buffer, TRUE);
+    }
+}
+#endif
+
+static const PangoRectangle *
+shaped_run_cache_get_extents (PangoFont        *font,
+                              PangoGlyphString *glyphs)
+{
+  ShapedRunEntry lookup;
+  ShapedRunEntry *entry;
+
+  if (G_UNLIKELY (shaped_run_cache == NULL))
+    {
+      shaped_run_cache = g_hash_table_new_full (shaped_run_entry_hash,
+                                                shaped_run_entry_equal,
+                                                shaped_run_entry_free,
+                                                NULL);
+      shaped_run_profiler = gsk_profiler_new ();
+      shaped_run_hits = gsk_profiler_add_counter (shaped_run_profiler,
+                                                  "hits", "Cache hits", FALSE);
+      shaped_run_misses = gsk_profiler_add_counter (shaped_run_profiler,
+                                                    "misses", "Cache misses", FALSE);
+      shaped_run_evictions = gsk_profiler_add_counter (shaped_run_profiler,
+                                                       "evictions", "Evicted entries", FALSE);
+    }
+
+  lookup.font = font;
+  lookup.hash = shaped_run_hash (font, glyphs);
+  lookup.num_glyphs = glyphs->num_glyphs;
+  lookup.glyphs = glyphs->glyphs;
+
+  entry = g_hash_table_lookup (shaped_run_cache, &lookup);
+  if (entry == NULL)
+    {
+      if (g_hash_table_size (shaped_run_cache) >= SHAPED_RUN_CACHE_MAX_SIZE)
+        {
+          gsk_profiler_counter_add (shaped_run_profiler, shaped_run_evictions,
+                                    g_hash_table_size (shaped_run_cache));
+          g_hash_table_remove_all (shaped_run_cache);
+        }
+
+      entry = g_slice_new (ShapedRunEntry);
+      entry->font = g_object_ref (font);
+      entry->hash = lookup.hash;
+      entry->num_glyphs = glyphs->num_glyphs;
+      entry->glyphs = g_memdup (glyphs->glyphs,
+                                sizeof (PangoGlyphInfo) * glyphs->num_glyphs);
+
+      pango_glyph_string_extents (glyphs, font, &entry->ink_rect, NULL);
+      pango_extents_to_pixels (&entry->ink_rect, NULL);
+
+      g_hash_table_add (shaped_run_cache, entry);
+      gsk_profiler_counter_inc (shaped_run_profiler, shaped_run_misses);
+    }
+  else
+    {
+      gsk_profiler_counter_inc (shaped_run_profiler, shaped_run_hits);
+    }
+
+  GSK_NOTE (GLYPH_CACHE, shaped_run_cache_maybe_dump_stats ());
+
+  return &entry->ink_rect;
+}
+
 static void
 gsk_pango_renderer_show_text_glyphs (PangoRenderer        *renderer,
                                      const char           *text,
@@ -119,7 +280,10 @@ gsk_pango_renderer_show_text_glyphs (PangoRenderer        *renderer,
   gtk_snapshot_get_offset (crenderer->snapshot, &x_offset, &y_offset);
   get_color (crenderer, PANGO_RENDER_PART_FOREGROUND, &color);
 
-  node = gsk_text_node_new (font, glyphs, &color, x_offset + (double)x/PANGO_SCALE, y_offset + (double)y/PANGO_SCALE);
+  node = gsk_text_node_new_with_extents (font, glyphs, &color,
+                                         x_offset + (double)x/PANGO_SCALE,
+                                         y_offset + (double)y/PANGO_SCALE,
+                                         shaped_run_cache_get_extents (font, glyphs));
   if (node == NULL)
     return;
 
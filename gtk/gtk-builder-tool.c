@@ -716,6 +716,79 @@ do_simplify (int          *argc,
     }
 }
 
+static void
+do_compile (int          *argc,
+            const char ***argv)
+{
+  gchar *buffer;
+  gsize length;
+  gchar *output = NULL;
+  char **filenames = NULL;
+  GBytes *compiled;
+  GOptionContext *ctx;
+  const GOptionEntry entries[] = {
+    { "output", 0, 0, G_OPTION_ARG_FILENAME, &output, NULL, NULL },
+    { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &filenames, NULL, NULL },
+    { NULL, }
+  };
+  GError *error = NULL;
+
+  ctx = g_option_context_new (NULL);
+  g_option_context_set_help_enabled (ctx, FALSE);
+  g_option_context_add_main_entries (ctx, entries, NULL);
+
+  if (!g_option_context_parse (ctx, argc, (char ***)argv, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      g_error_free (error);
+      exit (1);
+    }
+
+  g_option_context_free (ctx);
+
+  if (filenames == NULL)
+    {
+      g_printerr ("No .ui file specified\n");
+      exit (1);
+    }
+
+  if (g_strv_length (filenames) > 1)
+    {
+      g_printerr ("Can only compile a single .ui file\n");
+      exit (1);
+    }
+
+  if (!g_file_get_contents (filenames[0], &buffer, &length, &error))
+    {
+      g_printerr (_("Can’t load file: %s\n"), error->message);
+      exit (1);
+    }
+
+  compiled = gtk_builder_compile_ui (buffer, length, &error);
+  if (compiled == NULL)
+    {
+      g_printerr (_("Can’t parse file: %s\n"), error->message);
+      exit (1);
+    }
+
+  if (output == NULL)
+    output = g_strconcat (filenames[0], "c", NULL);
+
+  if (!g_file_set_contents (output,
+                            g_bytes_get_data (compiled, NULL),
+                            g_bytes_get_size (compiled),
+                            &error))
+    {
+      g_printerr ("Failed to write %s: %s\n", output, error->message);
+      exit (1);
+    }
+
+  g_bytes_unref (compiled);
+  g_free (buffer);
+  g_free (output);
+  g_strfreev (filenames);
+}
+
 static GType
 make_fake_type (const gchar *type_name,
                 const gchar *parent_name)
@@ -1057,12 +1130,16 @@ usage (void)
              "Commands:\n"
              "  validate           Validate the file\n"
              "  simplify [OPTIONS] Simplify the file\n"
+             "  compile [OPTIONS]  Compile the file for gtk_builder_add_from_compiled()\n"
              "  enumerate          List all named objects\n"
              "  preview [OPTIONS]  Preview the file\n"
              "\n"
              "Simplify Options:\n"
              "  --replace          Replace the file\n"
              "\n"
+             "Compile Options:\n"
+             "  --output=FILE      Write to FILE instead of FILE.uic\n"
+             "\n"
              "Preview Options:\n"
              "  --id=ID            Preview only the named object\n"
              "  --css=FILE         Use style from CSS file\n"
@@ -1093,6 +1170,8 @@ main (int argc, const char *argv[])
     do_validate (argv[1]);
   else if (strcmp (argv[0], "simplify") == 0)
     do_simplify (&argc, &argv);
+  else if (strcmp (argv[0], "compile") == 0)
+    do_compile (&argc, &argv);
   else if (strcmp (argv[0], "enumerate") == 0)
     do_enumerate (argv[1]);
   else if (strcmp (argv[0], "preview") == 0)
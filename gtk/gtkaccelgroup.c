@@ -189,6 +189,7 @@ gtk_accel_group_finalize (GObject *object)
     }
 
   g_free (accel_group->priv->priv_accels);
+  g_hash_table_destroy (accel_group->priv->accel_index);
 
   G_OBJECT_CLASS (gtk_accel_group_parent_class)->finalize (object);
 }
@@ -228,6 +229,8 @@ gtk_accel_group_init (GtkAccelGroup *accel_group)
   priv->acceleratables = NULL;
   priv->n_accels = 0;
   priv->priv_accels = NULL;
+  priv->accel_index = g_hash_table_new_full (g_int64_hash, g_int64_equal,
+                                             g_free, NULL);
 }
 
 /**
@@ -468,6 +471,43 @@ bsearch_compare_accels (const void *d1,
     return entry1->key.accel_key < entry2->key.accel_key ? -1 : 1;
 }
 
+/* The accel index maps (accel_key, accel_mods) to the first matching
+ * position + 1 in the sorted entry array (so 0 means "not present"),
+ * making per-key-press lookups a single hash probe. It is rebuilt on
+ * every registration or removal; both are rare compared to lookups.
+ */
+static inline gint64
+accel_index_key (guint           accel_key,
+                 GdkModifierType accel_mods)
+{
+  return ((gint64) accel_key << 32) | (guint32) accel_mods;
+}
+
+static void
+quick_accel_rebuild_index (GtkAccelGroup *accel_group)
+{
+  GtkAccelGroupPrivate *priv = accel_group->priv;
+  guint i;
+
+  g_hash_table_remove_all (priv->accel_index);
+
+  for (i = 0; i < priv->n_accels; i++)
+    {
+      gint64 *index_key;
+
+      /* equal keys are adjacent, only the first position is indexed */
+      if (i > 0 &&
+          priv->priv_accels[i].key.accel_key == priv->priv_accels[i - 1].key.accel_key &&
+          priv->priv_accels[i].key.accel_mods == priv->priv_accels[i - 1].key.accel_mods)
+        continue;
+
+      index_key = g_new (gint64, 1);
+      *index_key = accel_index_key (priv->priv_accels[i].key.accel_key,
+                                    priv->priv_accels[i].key.accel_mods);
+      g_hash_table_insert (priv->accel_index, index_key, GUINT_TO_POINTER (i + 1));
+    }
+}
+
 static void
 quick_accel_add (GtkAccelGroup   *accel_group,
                  guint            accel_key,
@@ -497,6 +537,8 @@ quick_accel_add (GtkAccelGroup   *accel_group,
   accel_group->priv->priv_accels[pos].accel_path_quark = path_quark;
   g_closure_sink (closure);
 
+  quick_accel_rebuild_index (accel_group);
+
   /* handle closure invalidation and reverse lookups */
   g_closure_add_invalidate_notifier (closure, accel_group, accel_closure_invalidate);
 
@@ -555,6 +597,8 @@ quick_accel_remove (GtkAccelGroup *accel_group,
   memmove (entry, entry + 1,
            (accel_group->priv->n_accels - pos) * sizeof (accel_group->priv->priv_accels[0]));
 
+  quick_accel_rebuild_index (accel_group);
+
   /* and notify */
   if (accel_quark)
     g_signal_emit (accel_group, signal_accel_changed, accel_quark, accel_key, accel_mods, closure);
@@ -570,26 +614,22 @@ quick_accel_find (GtkAccelGroup   *accel_group,
                   guint           *count_p)
 {
   GtkAccelGroupEntry *entry;
-  GtkAccelGroupEntry key;
+  gint64 index_key;
+  gpointer pos;
 
   *count_p = 0;
 
   if (!accel_group->priv->n_accels)
     return NULL;
 
-  key.key.accel_key = accel_key;
-  key.key.accel_mods = accel_mods;
-  entry = bsearch (&key, accel_group->priv->priv_accels, accel_group->priv->n_accels,
-                   sizeof (accel_group->priv->priv_accels[0]), bsearch_compare_accels);
+  index_key = accel_index_key (accel_key, accel_mods);
+  pos = g_hash_table_lookup (accel_group->priv->accel_index, &index_key);
 
-  if (!entry)
+  if (!pos)
     return NULL;
 
-  /* step back to the first member */
-  for (; entry > accel_group->priv->priv_accels; entry--)
-    if (entry[-1].key.accel_key != accel_key ||
-        entry[-1].key.accel_mods != accel_mods)
-      break;
+  /* the index points at the first member */
+  entry = accel_group->priv->priv_accels + (GPOINTER_TO_UINT (pos) - 1);
   /* count equal members */
   for (; entry + *count_p < accel_group->priv->priv_accels + accel_group->priv->n_accels; (*count_p)++)
     if (entry[*count_p].key.accel_key != accel_key ||
@@ -931,13 +971,32 @@ gtk_accel_groups_activate (GObject         *object,
     {
       gchar *accel_name;
       GQuark accel_quark;
-      GSList *slist;
+      GSList *groups, *slist;
+      gboolean have_accel = FALSE;
+      guint n;
+
+      groups = gtk_accel_groups_from_object (object);
+
+      /* cheap existence check before constructing the detail quark;
+       * only closures connected for exactly this key and modifier
+       * combination can be activated by the emission below
+       */
+      for (slist = groups; slist; slist = slist->next)
+        if (quick_accel_find (slist->data, gdk_keyval_to_lower (accel_key),
+                              accel_mods & gtk_accelerator_get_default_mod_mask (), &n))
+          {
+            have_accel = TRUE;
+            break;
+          }
+
+      if (!have_accel)
+        return FALSE;
 
       accel_name = gtk_accelerator_name (accel_key, (accel_mods & gtk_accelerator_get_default_mod_mask ()));
       accel_quark = g_quark_from_string (accel_name);
       g_free (accel_name);
 
-      for (slist = gtk_accel_groups_from_object (object); slist; slist = slist->next)
+      for (slist = groups; slist; slist = slist->next)
         if (gtk_accel_group_activate (slist->data, accel_quark, object, accel_key, accel_mods))
           return TRUE;
     }
@@ -32,6 +32,7 @@ struct _GtkAccelGroupPrivate
   GSList             *acceleratables;
   guint               n_accels;
   GtkAccelGroupEntry *priv_accels;
+  GHashTable         *accel_index;    /* (accel_key, accel_mods) -> first position + 1 in priv_accels */
 };
 
 void	_gtk_accel_group_reconnect        (GtkAccelGroup *accel_group,
@@ -21,6 +21,7 @@
 #include "gtkwidget.h"
 #include "gtkintl.h"
 #include "gtkaccessible.h"
+#include "gtkaccessibleprivate.h"
 
 /**
  * SECTION:gtkaccessible
@@ -213,3 +214,86 @@ gtk_accessible_get_widget (GtkAccessible *accessible)
   return accessible->priv->widget;
 }
 
+typedef struct {
+  AtkObject *object;
+  AtkStateType state;
+  gboolean value;
+} QueuedStateChange;
+
+static GArray *queued_state_changes = NULL;
+static guint state_change_flush_id = 0;
+
+static gboolean
+flush_queued_state_changes (gpointer data)
+{
+  GArray *changes;
+  guint i;
+
+  changes = queued_state_changes;
+  queued_state_changes = NULL;
+  state_change_flush_id = 0;
+
+  for (i = 0; i < changes->len; i++)
+    {
+      QueuedStateChange *change = &g_array_index (changes, QueuedStateChange, i);
+
+      atk_object_notify_state_change (change->object, change->state, change->value);
+      g_object_unref (change->object);
+    }
+
+  g_array_free (changes, TRUE);
+
+  return G_SOURCE_REMOVE;
+}
+
+/*< private >
+ * _gtk_accessible_queue_state_change:
+ * @object: an #AtkObject
+ * @state: the state whose value changed
+ * @value: the new value of the state
+ *
+ * Queues a state-change notification on @object to be emitted
+ * from an idle, after the current frame has been processed.
+ *
+ * State flips during a restyle or a focus change arrive in bursts,
+ * and every notification ends up as an AT-SPI emission on the bus
+ * once the bridge is connected. Collecting them per frame lets a
+ * state that changes several times within one frame be reported
+ * once, with its final value, instead of flooding the bus with
+ * superseded intermediate values.
+ */
+void
+_gtk_accessible_queue_state_change (AtkObject    *object,
+                                    AtkStateType  state,
+                                    gboolean      value)
+{
+  QueuedStateChange *change;
+  guint i;
+
+  if (queued_state_changes == NULL)
+    queued_state_changes = g_array_new (FALSE, FALSE, sizeof (QueuedStateChange));
+
+  for (i = 0; i < queued_state_changes->len; i++)
+    {
+      change = &g_array_index (queued_state_changes, QueuedStateChange, i);
+
+      if (change->object == object && change->state == state)
+        {
+          change->value = value;
+          return;
+        }
+    }
+
+  g_array_set_size (queued_state_changes, queued_state_changes->len + 1);
+  change = &g_array_index (queued_state_changes, QueuedStateChange,
+                           queued_state_changes->len - 1);
+  change->object = g_object_ref (object);
+  change->state = state;
+  change->value = value;
+
+  if (state_change_flush_id == 0)
+    state_change_flush_id = g_idle_add_full (GDK_PRIORITY_REDRAW + 10,
+                                             flush_queued_state_changes,
+                                             NULL, NULL);
+}
+
@@ -68,6 +68,13 @@ struct _GtkActionMuxer
   GHashTable *groups;
   GHashTable *primary_accels;
   GtkActionMuxer *parent;
+
+  /* While frozen, enabled- and state-changes are coalesced here (one
+   * entry per action, holding the latest value) and replayed on thaw.
+   */
+  gint freeze_count;
+  GHashTable *frozen_enabled;
+  GHashTable *frozen_state;
 };
 
 G_DEFINE_TYPE_WITH_CODE (GtkActionMuxer, gtk_action_muxer, G_TYPE_OBJECT,
@@ -173,6 +180,14 @@ gtk_action_muxer_action_enabled_changed (GtkActionMuxer *muxer,
   Action *action;
   GSList *node;
 
+  if (muxer->freeze_count > 0)
+    {
+      g_hash_table_replace (muxer->frozen_enabled,
+                            g_strdup (action_name),
+                            GINT_TO_POINTER (enabled));
+      return;
+    }
+
   action = g_hash_table_lookup (muxer->observed_actions, action_name);
   for (node = action ? action->watchers : NULL; node; node = node->next)
     gtk_action_observer_action_enabled_changed (node->data, GTK_ACTION_OBSERVABLE (muxer), action_name, enabled);
@@ -213,6 +228,14 @@ gtk_action_muxer_action_state_changed (GtkActionMuxer *muxer,
   Action *action;
   GSList *node;
 
+  if (muxer->freeze_count > 0)
+    {
+      g_hash_table_replace (muxer->frozen_state,
+                            g_strdup (action_name),
+                            g_variant_ref (state));
+      return;
+    }
+
   action = g_hash_table_lookup (muxer->observed_actions, action_name);
   for (node = action ? action->watchers : NULL; node; node = node->next)
     gtk_action_observer_action_state_changed (node->data, GTK_ACTION_OBSERVABLE (muxer), action_name, state);
@@ -537,6 +560,10 @@ gtk_action_muxer_finalize (GObject *object)
   g_hash_table_unref (muxer->groups);
   if (muxer->primary_accels)
     g_hash_table_unref (muxer->primary_accels);
+  if (muxer->frozen_enabled)
+    g_hash_table_unref (muxer->frozen_enabled);
+  if (muxer->frozen_state)
+    g_hash_table_unref (muxer->frozen_state);
 
   G_OBJECT_CLASS (gtk_action_muxer_parent_class)
     ->finalize (object);
@@ -733,6 +760,74 @@ gtk_action_muxer_remove (GtkActionMuxer *muxer,
     }
 }
 
+/*< private >
+ * gtk_action_muxer_freeze:
+ * @muxer: a #GtkActionMuxer
+ *
+ * Suspends enabled- and state-change notifications, recording only the
+ * latest value per action, until a matching call to
+ * gtk_action_muxer_thaw() replays them. Use this around code that
+ * flips many actions at once (a selection change, say) so each proxy
+ * widget updates once instead of once per intermediate value.
+ *
+ * Calls can be nested; notifications resume when the last freeze is
+ * thawed. Action added/removed notifications are not deferred - the
+ * observers' bookkeeping depends on seeing those immediately.
+ */
+void
+gtk_action_muxer_freeze (GtkActionMuxer *muxer)
+{
+  g_return_if_fail (GTK_IS_ACTION_MUXER (muxer));
+
+  if (muxer->freeze_count == 0)
+    {
+      muxer->frozen_enabled = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+      muxer->frozen_state = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                                   (GDestroyNotify) g_variant_unref);
+    }
+
+  muxer->freeze_count++;
+}
+
+/*< private >
+ * gtk_action_muxer_thaw:
+ * @muxer: a #GtkActionMuxer
+ *
+ * Undoes the effect of one call to gtk_action_muxer_freeze(). When the
+ * last freeze is undone, the coalesced notifications are emitted, one
+ * per changed action.
+ */
+void
+gtk_action_muxer_thaw (GtkActionMuxer *muxer)
+{
+  GHashTable *frozen_enabled, *frozen_state;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_if_fail (GTK_IS_ACTION_MUXER (muxer));
+  g_return_if_fail (muxer->freeze_count > 0);
+
+  muxer->freeze_count--;
+
+  if (muxer->freeze_count > 0)
+    return;
+
+  /* Steal the tables first: an observer callback could freeze again */
+  frozen_enabled = g_steal_pointer (&muxer->frozen_enabled);
+  frozen_state = g_steal_pointer (&muxer->frozen_state);
+
+  g_hash_table_iter_init (&iter, frozen_enabled);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    gtk_action_muxer_action_enabled_changed (muxer, key, GPOINTER_TO_INT (value));
+
+  g_hash_table_iter_init (&iter, frozen_state);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    gtk_action_muxer_action_state_changed (muxer, key, value);
+
+  g_hash_table_unref (frozen_enabled);
+  g_hash_table_unref (frozen_state);
+}
+
 const gchar **
 gtk_action_muxer_list_prefixes (GtkActionMuxer *muxer)
 {
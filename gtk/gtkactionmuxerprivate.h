@@ -49,6 +49,9 @@ GtkActionMuxer *        gtk_action_muxer_get_parent                     (GtkActi
 void                    gtk_action_muxer_set_parent                     (GtkActionMuxer *muxer,
                                                                          GtkActionMuxer *parent);
 
+void                    gtk_action_muxer_freeze                         (GtkActionMuxer *muxer);
+void                    gtk_action_muxer_thaw                           (GtkActionMuxer *muxer);
+
 void                    gtk_action_muxer_set_primary_accel              (GtkActionMuxer *muxer,
                                                                          const gchar    *action_and_target,
                                                                          const gchar    *primary_accel);
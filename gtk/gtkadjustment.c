@@ -60,7 +60,11 @@ struct _GtkAdjustmentPrivate {
   gint64 start_time;
   gint64 end_time;
   guint tick_id;
+  gulong batch_layout_id;
   GdkFrameClock *clock;
+
+  guint batch_updates : 1;
+  guint pending_value_changed : 1;
 };
 typedef struct _GtkAdjustmentPrivate GtkAdjustmentPrivate;
 
@@ -112,6 +116,8 @@ gtk_adjustment_finalize (GObject *object)
 
   if (priv->tick_id)
     g_signal_handler_disconnect (priv->clock, priv->tick_id);
+  if (priv->batch_layout_id)
+    g_signal_handler_disconnect (priv->clock, priv->batch_layout_id);
   if (priv->clock)
     g_object_unref (priv->clock);
 
@@ -431,6 +437,40 @@ gtk_adjustment_get_target_value (GtkAdjustment *adjustment)
     return priv->value;
 }
 
+/* Batched value notifications:
+ *
+ * During a fling the value is updated several times per frame and every
+ * update runs the full ::value-changed handler chain. With batch updates
+ * enabled the value itself still changes right away, but the
+ * ::value-changed and ::notify emissions are deferred to the frame
+ * clock's layout phase, so all sets within one frame collapse into a
+ * single notification carrying the final value.
+ */
+static void
+gtk_adjustment_flush_value_changed (GtkAdjustment *adjustment)
+{
+  GtkAdjustmentPrivate *priv = gtk_adjustment_get_instance_private (adjustment);
+
+  if (priv->batch_layout_id)
+    {
+      g_signal_handler_disconnect (priv->clock, priv->batch_layout_id);
+      priv->batch_layout_id = 0;
+    }
+
+  if (priv->pending_value_changed)
+    {
+      priv->pending_value_changed = FALSE;
+      emit_value_changed (adjustment);
+    }
+}
+
+static void
+gtk_adjustment_on_frame_clock_layout (GdkFrameClock *clock,
+                                      GtkAdjustment *adjustment)
+{
+  gtk_adjustment_flush_value_changed (adjustment);
+}
+
 static void
 adjustment_set_value (GtkAdjustment *adjustment,
                       gdouble        value)
@@ -440,7 +480,20 @@ adjustment_set_value (GtkAdjustment *adjustment,
   if (priv->value != value)
     {
       priv->value = value;
-      emit_value_changed (adjustment);
+
+      if (priv->batch_updates && priv->clock != NULL)
+        {
+          priv->pending_value_changed = TRUE;
+
+          if (priv->batch_layout_id == 0)
+            {
+              priv->batch_layout_id = g_signal_connect (priv->clock, "layout",
+                                                        G_CALLBACK (gtk_adjustment_on_frame_clock_layout), adjustment);
+              gdk_frame_clock_request_phase (priv->clock, GDK_FRAME_CLOCK_PHASE_LAYOUT);
+            }
+        }
+      else
+        emit_value_changed (adjustment);
     }
 }
 
@@ -952,6 +1005,8 @@ gtk_adjustment_enable_animation (GtkAdjustment *adjustment,
           gdk_frame_clock_end_updating (priv->clock);
         }
 
+      gtk_adjustment_flush_value_changed (adjustment);
+
       if (priv->clock)
         g_object_unref (priv->clock);
 
@@ -979,3 +1034,22 @@ gtk_adjustment_is_animating (GtkAdjustment *adjustment)
 
   return priv->tick_id != 0;
 }
+
+void
+gtk_adjustment_set_batch_updates (GtkAdjustment *adjustment,
+                                  gboolean       batch_updates)
+{
+  GtkAdjustmentPrivate *priv = gtk_adjustment_get_instance_private (adjustment);
+
+  g_return_if_fail (GTK_IS_ADJUSTMENT (adjustment));
+
+  batch_updates = batch_updates != FALSE;
+
+  if (priv->batch_updates == batch_updates)
+    return;
+
+  priv->batch_updates = batch_updates;
+
+  if (!batch_updates)
+    gtk_adjustment_flush_value_changed (adjustment);
+}
@@ -34,6 +34,9 @@ gdouble gtk_adjustment_get_target_value (GtkAdjustment *adjustment);
 
 gboolean gtk_adjustment_is_animating (GtkAdjustment *adjustment);
 
+void gtk_adjustment_set_batch_updates (GtkAdjustment *adjustment,
+                                       gboolean       batch_updates);
+
 G_END_DECLS
 
 
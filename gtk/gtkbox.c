@@ -947,12 +947,22 @@ gtk_box_get_size (GtkWidget      *widget,
         {
           gint child_minimum, child_natural;
           gint child_minimum_baseline = -1, child_natural_baseline = -1;
+          gboolean want_baseline;
+
+          /* Only children that align to the baseline take part in the
+           * baseline math, matching what size_allocate honors; most
+           * boxes have none and skip it entirely.
+           */
+          want_baseline = private->orientation == GTK_ORIENTATION_HORIZONTAL &&
+                          orientation == GTK_ORIENTATION_VERTICAL &&
+                          gtk_widget_get_valign (child) == GTK_ALIGN_BASELINE;
 
           gtk_widget_measure (child,
                               orientation,
                               -1,
                               &child_minimum, &child_natural,
-                              &child_minimum_baseline, &child_natural_baseline);
+                              want_baseline ? &child_minimum_baseline : NULL,
+                              want_baseline ? &child_natural_baseline : NULL);
 
           if (private->orientation == orientation)
 	    {
@@ -216,7 +216,7 @@ gtk_builder_menu_start_element (GMarkupParseContext  *context,
   {
     const GSList *element_stack;
 
-    element_stack = g_markup_parse_context_get_element_stack (context);
+    element_stack = _gtk_builder_parser_get_element_stack (context);
 
     if (element_stack->next)
       g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_UNKNOWN_ELEMENT,
@@ -315,7 +315,7 @@ gtk_builder_menu_text (GMarkupParseContext  *context,
         else
           g_set_error (error, G_MARKUP_ERROR, G_MARKUP_ERROR_INVALID_CONTENT,
                        _("Text may not appear inside <%s>"),
-                       g_markup_parse_context_get_element (context));
+                       _gtk_builder_parser_get_element (context));
         break;
       }
 }
@@ -163,6 +163,15 @@
  * The possible values for the “type” attribute are described in the
  * sections describing the widget-specific portions of UI definitions.
  *
+ * A <child> element can carry a “lazy” attribute. A child marked
+ * lazy="true" is not constructed while the UI definition is loaded;
+ * its construction is deferred until the parent widget is first
+ * mapped, or until an object declared inside the child is looked up
+ * with gtk_builder_get_object(). This is useful for expensive parts
+ * of a UI that are rarely shown, such as popovers or dialog pages.
+ * Since the objects inside a lazy child do not exist until then, they
+ * cannot be referenced from properties or bindings outside of it.
+ *
  * # A GtkBuilder UI Definition
  *
  * |[
@@ -238,10 +247,20 @@ enum {
 
 static GParamSpec *builder_props[LAST_PROP];
 
+/* Objects are also remembered in the order they were added, so that
+ * template binding can resolve a child by position instead of by
+ * hashing its name on every instance.
+ */
+typedef struct {
+  gchar   *id;
+  GObject *object;
+} ObjectOrderEntry;
+
 struct _GtkBuilderPrivate
 {
   gchar *domain;
   GHashTable *objects;
+  GArray *object_order;         /* ObjectOrderEntry */
   GHashTable *callbacks;
   GSList *delayed_properties;
   GSList *signals;
@@ -250,6 +269,14 @@ struct _GtkBuilderPrivate
   gchar *resource_prefix;
   GType template_type;
   GtkApplication *application;
+
+  GSList *lazy_children;        /* LazyChildInfo not built yet */
+
+  /* Remembered so that signals inside lazy children can be
+   * connected when the children are finally built
+   */
+  GtkBuilderConnectFunc connect_func;
+  gpointer connect_data;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkBuilder, gtk_builder, G_TYPE_OBJECT)
@@ -292,6 +319,7 @@ gtk_builder_init (GtkBuilder *builder)
   builder->priv->domain = NULL;
   builder->priv->objects = g_hash_table_new_full (g_str_hash, g_str_equal,
                                                   g_free, g_object_unref);
+  builder->priv->object_order = g_array_new (FALSE, FALSE, sizeof (ObjectOrderEntry));
 }
 
 
@@ -303,16 +331,27 @@ static void
 gtk_builder_finalize (GObject *object)
 {
   GtkBuilderPrivate *priv = GTK_BUILDER (object)->priv;
+  guint i;
 
   g_free (priv->domain);
   g_free (priv->filename);
   g_free (priv->resource_prefix);
 
+  for (i = 0; i < priv->object_order->len; i++)
+    {
+      ObjectOrderEntry *entry = &g_array_index (priv->object_order, ObjectOrderEntry, i);
+
+      g_free (entry->id);
+      g_object_unref (entry->object);
+    }
+  g_array_unref (priv->object_order);
+
   g_hash_table_destroy (priv->objects);
   if (priv->callbacks)
     g_hash_table_destroy (priv->callbacks);
 
   g_slist_free_full (priv->signals, (GDestroyNotify)_free_signal_info);
+  g_slist_free_full (priv->lazy_children, (GDestroyNotify)_gtk_builder_lazy_child_free);
 
   G_OBJECT_CLASS (gtk_builder_parent_class)->finalize (object);
 }
@@ -654,8 +693,14 @@ _gtk_builder_add_object (GtkBuilder  *builder,
                          const gchar *id,
                          GObject     *object)
 {
+  ObjectOrderEntry entry;
+
   object_set_name (object, id);
   g_hash_table_insert (builder->priv->objects, g_strdup (id), g_object_ref (object));
+
+  entry.id = g_strdup (id);
+  entry.object = g_object_ref (object);
+  g_array_append_val (builder->priv->object_order, entry);
 }
 
 static void
@@ -799,6 +844,11 @@ _gtk_builder_construct (GtkBuilder  *builder,
         custom_set_property = TRUE;
     }
 
+  /* Thaw once after all properties are applied, so each property
+   * results in at most one notify emission */
+  if (parameters->len)
+    g_object_freeze_notify (obj);
+
   for (i = 0; i < parameters->len; i++)
     {
       const char *name = object_properties_get_name (parameters, i);
@@ -818,6 +868,10 @@ _gtk_builder_construct (GtkBuilder  *builder,
         }
 #endif
     }
+
+  if (parameters->len)
+    g_object_thaw_notify (obj);
+
   object_properties_free (parameters);
 
   if (info->bindings)
@@ -864,6 +918,9 @@ _gtk_builder_apply_properties (GtkBuilder  *builder,
         custom_set_property = TRUE;
     }
 
+  if (parameters->len)
+    g_object_freeze_notify (info->object);
+
   for (i = 0; i < parameters->len; i++)
     {
       const char *name = object_properties_get_name (parameters, i);
@@ -882,6 +939,10 @@ _gtk_builder_apply_properties (GtkBuilder  *builder,
         }
 #endif
     }
+
+  if (parameters->len)
+    g_object_thaw_notify (info->object);
+
   object_properties_free (parameters);
 }
 
@@ -998,11 +1059,164 @@ gtk_builder_create_bindings (GtkBuilder *builder)
   builder->priv->bindings = NULL;
 }
 
+/*
+ * Lazy children, the GtkBuilder side. The parser hands over the
+ * recorded <child lazy="true"> subtrees via _gtk_builder_add_lazy_child();
+ * once the parse is finished the parent objects exist and we install a
+ * trigger on each: the child is built when its parent widget is first
+ * mapped, or earlier if gtk_builder_get_object() asks for an object
+ * declared inside it. The trigger holds a reference on the builder so
+ * that deferred children can still be built after the caller has
+ * dropped theirs, as gtk_widget_init_template() does.
+ */
+
+typedef struct {
+  GtkBuilder *builder;
+  LazyChildInfo *lazy;
+} LazyChildTrigger;
+
+static void
+lazy_child_trigger_free (gpointer  user_data,
+                         GClosure *closure)
+{
+  LazyChildTrigger *trigger = user_data;
+
+  g_object_unref (trigger->builder);
+  g_slice_free (LazyChildTrigger, trigger);
+}
+
+static void
+gtk_builder_build_lazy_child (GtkBuilder    *builder,
+                              LazyChildInfo *lazy)
+{
+  GError *error = NULL;
+
+  builder->priv->lazy_children = g_slist_remove (builder->priv->lazy_children,
+                                                 lazy);
+
+  if (lazy->map_handler)
+    {
+      gulong handler = lazy->map_handler;
+
+      lazy->map_handler = 0;
+      if (g_signal_handler_is_connected (lazy->parent, handler))
+        g_signal_handler_disconnect (lazy->parent, handler);
+    }
+
+  _gtk_builder_parser_replay_lazy_child (builder, lazy, &error);
+  if (error)
+    {
+      g_critical ("Error building lazy child of '%s': %s",
+                  lazy->parent_id, error->message);
+      g_error_free (error);
+    }
+
+  if (builder->priv->connect_func)
+    gtk_builder_connect_signals_full (builder,
+                                      builder->priv->connect_func,
+                                      builder->priv->connect_data);
+
+  _gtk_builder_lazy_child_free (lazy);
+}
+
+static void
+lazy_child_map_cb (GtkWidget *widget,
+                   gpointer   user_data)
+{
+  LazyChildTrigger *trigger = user_data;
+  GtkBuilder *builder = g_object_ref (trigger->builder);
+
+  /* Building disconnects this handler, which frees the trigger */
+  gtk_builder_build_lazy_child (builder, trigger->lazy);
+
+  g_object_unref (builder);
+}
+
+void
+_gtk_builder_add_lazy_child (GtkBuilder    *builder,
+                             LazyChildInfo *lazy)
+{
+  builder->priv->lazy_children = g_slist_prepend (builder->priv->lazy_children,
+                                                  lazy);
+}
+
+static void
+gtk_builder_install_lazy_triggers (GtkBuilder *builder)
+{
+  GSList *l, *build = NULL;
+
+  for (l = builder->priv->lazy_children; l; l = l->next)
+    {
+      LazyChildInfo *lazy = l->data;
+      LazyChildTrigger *trigger;
+
+      if (lazy->parent != NULL)
+        continue;
+
+      lazy->parent = gtk_builder_get_object (builder, lazy->parent_id);
+      if (lazy->parent == NULL)
+        {
+          g_warning ("Parent object '%s' of lazy child not found",
+                     lazy->parent_id);
+          continue;
+        }
+
+      if (!GTK_IS_WIDGET (lazy->parent) ||
+          gtk_widget_get_mapped (GTK_WIDGET (lazy->parent)))
+        {
+          /* There is no mapping to wait for; collect and build after
+           * the loop, building mutates the list we are walking
+           */
+          build = g_slist_prepend (build, lazy);
+          continue;
+        }
+
+      trigger = g_slice_new (LazyChildTrigger);
+      trigger->builder = g_object_ref (builder);
+      trigger->lazy = lazy;
+      lazy->map_handler = g_signal_connect_data (lazy->parent, "map",
+                                                 G_CALLBACK (lazy_child_map_cb),
+                                                 trigger,
+                                                 lazy_child_trigger_free,
+                                                 0);
+    }
+
+  for (l = build; l; l = l->next)
+    gtk_builder_build_lazy_child (builder, l->data);
+  g_slist_free (build);
+}
+
+/* Builds the lazy child declaring @name, if there is one */
+static GObject *
+gtk_builder_ensure_lazy_object (GtkBuilder  *builder,
+                                const gchar *name)
+{
+  GSList *l;
+
+  for (l = builder->priv->lazy_children; l; l = l->next)
+    {
+      LazyChildInfo *lazy = l->data;
+      guint i;
+
+      for (i = 0; i < lazy->object_ids->len; i++)
+        {
+          if (strcmp (g_ptr_array_index (lazy->object_ids, i), name) == 0)
+            {
+              gtk_builder_build_lazy_child (builder, lazy);
+              return g_hash_table_lookup (builder->priv->objects, name);
+            }
+        }
+    }
+
+  return NULL;
+}
+
 void
 _gtk_builder_finish (GtkBuilder *builder)
 {
   gtk_builder_apply_delayed_properties (builder);
   gtk_builder_create_bindings (builder);
+  gtk_builder_install_lazy_triggers (builder);
 }
 
 /**
@@ -1419,6 +1633,97 @@ gtk_builder_add_from_string (GtkBuilder   *builder,
   return 1;
 }
 
+/**
+ * gtk_builder_add_from_compiled:
+ * @builder: a #GtkBuilder
+ * @data: precompiled UI data created with gtk_builder_compile_ui()
+ * @error: (allow-none): return location for an error, or %NULL
+ *
+ * Builds the objects from a precompiled [GtkBuilder UI definition][BUILDER-UI]
+ * and merges them with the current contents of @builder.
+ *
+ * Precompiled data is created ahead of time with gtk_builder_compile_ui()
+ * or `gtk-builder-tool compile` and skips the XML parsing that otherwise
+ * dominates the cost of loading a UI definition. The data is used in
+ * place for the duration of the call, so it can come straight out of a
+ * #GMappedFile or a #GResource.
+ *
+ * Precompiled data is tied to the byte order of the machine that
+ * produced it and should be treated like a cache, not like a portable
+ * distribution format. The same trust caveats apply as for
+ * gtk_builder_add_from_file(); corrupt data can crash your program.
+ *
+ * Returns: A positive value on success, 0 if an error occurred
+ **/
+guint
+gtk_builder_add_from_compiled (GtkBuilder  *builder,
+                               GBytes      *data,
+                               GError     **error)
+{
+  const gchar *buffer;
+  gsize length;
+  GError *tmp_error;
+
+  g_return_val_if_fail (GTK_IS_BUILDER (builder), 0);
+  g_return_val_if_fail (data != NULL, 0);
+  g_return_val_if_fail (error == NULL || *error == NULL, 0);
+
+  buffer = g_bytes_get_data (data, &length);
+
+  if (!_gtk_builder_parser_is_precompiled (buffer, length))
+    {
+      g_set_error (error,
+                   GTK_BUILDER_ERROR,
+                   GTK_BUILDER_ERROR_INVALID_VALUE,
+                   "Data is not a precompiled GtkBuilder UI definition");
+      return 0;
+    }
+
+  tmp_error = NULL;
+
+  g_free (builder->priv->filename);
+  g_free (builder->priv->resource_prefix);
+  builder->priv->filename = g_strdup (".");
+  builder->priv->resource_prefix = NULL;
+
+  _gtk_builder_parser_parse_buffer (builder, "<compiled>",
+                                    buffer, length,
+                                    NULL,
+                                    &tmp_error);
+  if (tmp_error != NULL)
+    {
+      g_propagate_error (error, tmp_error);
+      return 0;
+    }
+
+  return 1;
+}
+
+/**
+ * gtk_builder_compile_ui:
+ * @buffer: the UI definition to compile
+ * @length: the length of @buffer (may be -1 if @buffer is nul-terminated)
+ * @error: (allow-none): return location for an error, or %NULL
+ *
+ * Compiles a [GtkBuilder UI definition][BUILDER-UI] into the binary
+ * representation understood by gtk_builder_add_from_compiled().
+ *
+ * This is exported purely to let gtk-builder-tool compile .ui files,
+ * applications have no need to call this function.
+ *
+ * Returns: (transfer full): the compiled data, or %NULL on error
+ **/
+GBytes *
+gtk_builder_compile_ui (const gchar  *buffer,
+                        gssize        length,
+                        GError      **error)
+{
+  g_return_val_if_fail (buffer != NULL, NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  return _gtk_builder_parser_precompile (buffer, length, error);
+}
+
 /**
  * gtk_builder_add_objects_from_string:
  * @builder: a #GtkBuilder
@@ -1490,10 +1795,72 @@ GObject *
 gtk_builder_get_object (GtkBuilder  *builder,
                         const gchar *name)
 {
+  GObject *object;
+
   g_return_val_if_fail (GTK_IS_BUILDER (builder), NULL);
   g_return_val_if_fail (name != NULL, NULL);
 
-  return g_hash_table_lookup (builder->priv->objects, name);
+  object = g_hash_table_lookup (builder->priv->objects, name);
+
+  /* The object may live in a lazy child that has not been built yet */
+  if (object == NULL && builder->priv->lazy_children != NULL)
+    object = gtk_builder_ensure_lazy_object (builder, name);
+
+  return object;
+}
+
+/*< private >
+ * _gtk_builder_get_object_ordered:
+ * @builder: a #GtkBuilder
+ * @name: name of object to get
+ * @position: (inout): last known position of the object in the order
+ *   objects were added, or %G_MAXUINT if not known yet
+ *
+ * Fast path for template binding. A class template always creates its
+ * objects in the same order, so a position recorded while binding one
+ * instance resolves the same child directly in every later instance,
+ * without hashing @name again. @position is verified against @name and
+ * updated when it does not match.
+ *
+ * Returns: (nullable) (transfer none): the object named @name or %NULL if
+ *    it could not be found in the object tree.
+ */
+GObject *
+_gtk_builder_get_object_ordered (GtkBuilder  *builder,
+                                 const gchar *name,
+                                 guint       *position)
+{
+  GArray *order = builder->priv->object_order;
+  GObject *object;
+  guint i;
+
+  if (*position < order->len)
+    {
+      ObjectOrderEntry *entry = &g_array_index (order, ObjectOrderEntry, *position);
+
+      if (strcmp (entry->id, name) == 0)
+        return entry->object;
+    }
+
+  /* Slow path: resolve by name, which also builds the object if it
+   * lives in an unbuilt lazy child, then remember where it ended up.
+   */
+  object = gtk_builder_get_object (builder, name);
+  if (object == NULL)
+    return NULL;
+
+  for (i = 0; i < order->len; i++)
+    {
+      ObjectOrderEntry *entry = &g_array_index (order, ObjectOrderEntry, i);
+
+      if (strcmp (entry->id, name) == 0)
+        {
+          *position = i;
+          break;
+        }
+    }
+
+  return object;
 }
 
 /**
@@ -1720,6 +2087,12 @@ gtk_builder_connect_signals_full (GtkBuilder            *builder,
   g_return_if_fail (GTK_IS_BUILDER (builder));
   g_return_if_fail (func != NULL);
 
+  /* Remember the connect func so that signals declared inside lazy
+   * children can be connected when those are built later
+   */
+  builder->priv->connect_func = func;
+  builder->priv->connect_data = user_data;
+
   if (!builder->priv->signals)
     return;
 
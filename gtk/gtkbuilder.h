@@ -134,6 +134,14 @@ guint        gtk_builder_add_from_string         (GtkBuilder    *builder,
                                                   gsize          length,
                                                   GError       **error);
 GDK_AVAILABLE_IN_ALL
+guint        gtk_builder_add_from_compiled       (GtkBuilder    *builder,
+                                                  GBytes        *data,
+                                                  GError       **error);
+GDK_AVAILABLE_IN_ALL
+GBytes*      gtk_builder_compile_ui              (const gchar   *buffer,
+                                                  gssize         length,
+                                                  GError       **error);
+GDK_AVAILABLE_IN_ALL
 guint        gtk_builder_add_objects_from_file   (GtkBuilder    *builder,
                                                   const gchar   *filename,
                                                   gchar        **object_ids,
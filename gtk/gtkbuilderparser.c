@@ -505,6 +505,7 @@ parse_child (ParserData   *data,
   ChildInfo *child_info;
   const gchar *type = NULL;
   const gchar *internal_child = NULL;
+  const gchar *lazy = NULL;
 
   object_info = state_peek_info (data, ObjectInfo);
   if (!object_info ||
@@ -515,9 +516,13 @@ parse_child (ParserData   *data,
       return;
     }
 
+  /* lazy="true" is intercepted in start_element(); we only get here
+   * for children that are built right away
+   */
   if (!g_markup_collect_attributes (element_name, names, values, error,
                                     G_MARKUP_COLLECT_STRING|G_MARKUP_COLLECT_OPTIONAL, "type", &type,
                                     G_MARKUP_COLLECT_STRING|G_MARKUP_COLLECT_OPTIONAL, "internal-child", &internal_child,
+                                    G_MARKUP_COLLECT_STRING|G_MARKUP_COLLECT_OPTIONAL, "lazy", &lazy,
                                     G_MARKUP_COLLECT_INVALID))
     {
       _gtk_builder_prefix_error (data->builder, data->ctx, error);
@@ -927,6 +932,184 @@ parse_custom (GMarkupParseContext  *context,
   return TRUE;
 }
 
+/*
+ * Lazy children
+ *
+ * A <child lazy="true"> subtree is not built during the main parse.
+ * Instead the markup events it spans are recorded verbatim and handed
+ * over to GtkBuilder, which replays them the first time the child is
+ * needed: when its parent widget is mapped, or when an object declared
+ * inside the subtree is looked up with gtk_builder_get_object().
+ * Replaying seeds the parser stack with the already constructed parent
+ * object, so the recorded events build into it exactly as they would
+ * have during the original parse.
+ */
+
+typedef enum {
+  LAZY_EVENT_START,
+  LAZY_EVENT_END,
+  LAZY_EVENT_TEXT
+} LazyEventType;
+
+typedef struct {
+  guint type;
+  gchar *name;      /* element name, or the text of a LAZY_EVENT_TEXT */
+  gsize text_len;
+  gchar **names;    /* attributes of a LAZY_EVENT_START */
+  gchar **values;
+} LazyEvent;
+
+static void
+lazy_event_free (LazyEvent *event)
+{
+  g_free (event->name);
+  g_strfreev (event->names);
+  g_strfreev (event->values);
+  g_slice_free (LazyEvent, event);
+}
+
+void
+_gtk_builder_lazy_child_free (LazyChildInfo *lazy)
+{
+  g_free (lazy->parent_id);
+  g_ptr_array_free (lazy->events, TRUE);
+  g_ptr_array_free (lazy->object_ids, TRUE);
+  g_slice_free (LazyChildInfo, lazy);
+}
+
+static gboolean
+child_lazy_attribute (ParserData   *data,
+                      const gchar **names,
+                      const gchar **values,
+                      gboolean     *lazy,
+                      GError      **error)
+{
+  gint i;
+
+  *lazy = FALSE;
+
+  for (i = 0; names[i]; i++)
+    {
+      if (strcmp (names[i], "lazy") == 0)
+        {
+          if (!_gtk_builder_boolean_from_string (values[i], lazy, error))
+            {
+              _gtk_builder_prefix_error (data->builder, data->ctx, error);
+              return FALSE;
+            }
+          break;
+        }
+    }
+
+  return TRUE;
+}
+
+static void
+start_lazy_child (ParserData   *data,
+                  const gchar  *element_name,
+                  const gchar **names,
+                  const gchar **values)
+{
+  ObjectInfo *object_info = state_peek_info (data, ObjectInfo);
+  LazyChildInfo *lazy;
+  LazyEvent *event;
+  guint i, j, n;
+
+  lazy = g_slice_new0 (LazyChildInfo);
+  lazy->parent_id = g_strdup (object_info->id);
+  lazy->events = g_ptr_array_new_with_free_func ((GDestroyNotify)lazy_event_free);
+  lazy->object_ids = g_ptr_array_new_with_free_func (g_free);
+
+  /* Record the <child> itself, minus the lazy attribute so that the
+   * replay builds it like a regular child
+   */
+  for (n = 0; names[n]; n++)
+    ;
+
+  event = g_slice_new0 (LazyEvent);
+  event->type = LAZY_EVENT_START;
+  event->name = g_strdup (element_name);
+  event->names = g_new (gchar *, n + 1);
+  event->values = g_new (gchar *, n + 1);
+  for (i = j = 0; i < n; i++)
+    {
+      if (strcmp (names[i], "lazy") == 0)
+        continue;
+      event->names[j] = g_strdup (names[i]);
+      event->values[j] = g_strdup (values[i]);
+      j++;
+    }
+  event->names[j] = NULL;
+  event->values[j] = NULL;
+  g_ptr_array_add (lazy->events, event);
+
+  data->lazy_child = lazy;
+  data->lazy_depth = 1;
+}
+
+static void
+lazy_child_record_start (ParserData   *data,
+                         const gchar  *element_name,
+                         const gchar **names,
+                         const gchar **values)
+{
+  LazyEvent *event;
+
+  event = g_slice_new0 (LazyEvent);
+  event->type = LAZY_EVENT_START;
+  event->name = g_strdup (element_name);
+  event->names = g_strdupv ((gchar **)names);
+  event->values = g_strdupv ((gchar **)values);
+  g_ptr_array_add (data->lazy_child->events, event);
+
+  /* Remember the ids declared inside, so that looking one of them
+   * up can trigger the build
+   */
+  if (strcmp (element_name, "object") == 0)
+    {
+      gint i;
+
+      for (i = 0; names[i]; i++)
+        if (strcmp (names[i], "id") == 0)
+          g_ptr_array_add (data->lazy_child->object_ids, g_strdup (values[i]));
+    }
+
+  data->lazy_depth++;
+}
+
+static void
+lazy_child_record_end (ParserData  *data,
+                       const gchar *element_name)
+{
+  LazyEvent *event;
+
+  event = g_slice_new0 (LazyEvent);
+  event->type = LAZY_EVENT_END;
+  event->name = g_strdup (element_name);
+  g_ptr_array_add (data->lazy_child->events, event);
+
+  data->lazy_depth--;
+  if (data->lazy_depth == 0)
+    {
+      _gtk_builder_add_lazy_child (data->builder, data->lazy_child);
+      data->lazy_child = NULL;
+    }
+}
+
+static void
+lazy_child_record_text (ParserData  *data,
+                        const gchar *text,
+                        gsize        text_len)
+{
+  LazyEvent *event;
+
+  event = g_slice_new0 (LazyEvent);
+  event->type = LAZY_EVENT_TEXT;
+  event->name = g_strndup (text, text_len);
+  event->text_len = text_len;
+  g_ptr_array_add (data->lazy_child->events, event);
+}
+
 static void
 start_element (GMarkupParseContext  *context,
                const gchar          *element_name,
@@ -955,6 +1138,12 @@ start_element (GMarkupParseContext  *context,
     }
 #endif
 
+  if (data->lazy_child)
+    {
+      lazy_child_record_start (data, element_name, names, values);
+      return;
+    }
+
   if (!data->last_element && strcmp (element_name, "interface") != 0)
     {
       error_unhandled_tag (data, element_name, error);
@@ -977,7 +1166,20 @@ start_element (GMarkupParseContext  *context,
   else if (strcmp (element_name, "property") == 0)
     parse_property (data, element_name, names, values, error);
   else if (strcmp (element_name, "child") == 0)
-    parse_child (data, element_name, names, values, error);
+    {
+      ObjectInfo *object_info = state_peek_info (data, ObjectInfo);
+      gboolean lazy;
+
+      if (!child_lazy_attribute (data, names, values, &lazy, error))
+        return;
+
+      if (lazy && object_info &&
+          (object_info->tag_type == TAG_OBJECT ||
+           object_info->tag_type == TAG_TEMPLATE))
+        start_lazy_child (data, element_name, names, values);
+      else
+        parse_child (data, element_name, names, values, error);
+    }
   else if (strcmp (element_name, "signal") == 0)
     parse_signal (data, element_name, names, values, error);
   else if (strcmp (element_name, "template") == 0)
@@ -1023,6 +1225,12 @@ end_element (GMarkupParseContext  *context,
 
   GTK_NOTE (BUILDER, g_message ("</%s>", element_name));
 
+  if (data->lazy_child)
+    {
+      lazy_child_record_end (data, element_name);
+      return;
+    }
+
   if (data->subparser && data->subparser->start)
     {
       subparser_end (context, element_name, data, error);
@@ -1169,6 +1377,12 @@ text (GMarkupParseContext  *context,
   ParserData *data = (ParserData*)user_data;
   CommonInfo *info;
 
+  if (data->lazy_child)
+    {
+      lazy_child_record_text (data, text, text_len);
+      return;
+    }
+
   if (data->subparser && data->subparser->start)
     {
       GError *tmp_error = NULL;
@@ -1187,7 +1401,7 @@ text (GMarkupParseContext  *context,
   info = state_peek_info (data, CommonInfo);
   g_assert (info != NULL);
 
-  if (strcmp (g_markup_parse_context_get_element (context), "property") == 0)
+  if (strcmp (_gtk_builder_parser_get_element (context), "property") == 0)
     {
       PropertyInfo *prop_info = (PropertyInfo*)info;
 
@@ -1228,6 +1442,511 @@ static const GMarkupParser parser = {
   NULL,
 };
 
+/*
+ * Precompiled buffers
+ *
+ * _gtk_builder_parser_precompile() records the GMarkup event stream
+ * of a .ui file into a flat binary blob: a deduplicated string table
+ * followed by start/end/text records referencing it. Loading such a
+ * blob replays the records into the same parser callbacks the XML
+ * path uses, so the GMarkup parse is skipped entirely. All strings
+ * are used in place, which makes the blob directly loadable from an
+ * mmap()ed file or a GResource without copying.
+ *
+ * The records are native-endian guint32 words; the header stores a
+ * byte order mark and blobs from the other endianness are rejected.
+ */
+
+#define COMPILED_MAGIC "GtkUIC01"
+#define COMPILED_MAGIC_LEN 8
+#define COMPILED_BYTE_ORDER 0x01020304u
+
+typedef struct {
+  gchar   magic[COMPILED_MAGIC_LEN];
+  guint32 byte_order;
+  guint32 records_offset;
+} CompiledHeader;
+
+enum {
+  RECORD_START_ELEMENT, /* name, n_attrs, (attr name, attr value) * n_attrs */
+  RECORD_END_ELEMENT,   /* name */
+  RECORD_TEXT           /* text, length in bytes */
+};
+
+typedef struct {
+  GString    *strings;
+  GArray     *records;
+  GHashTable *string_offsets;
+} CompileData;
+
+gboolean
+_gtk_builder_parser_is_precompiled (const gchar *buffer,
+                                    gsize        length)
+{
+  return length >= sizeof (CompiledHeader) &&
+         memcmp (buffer, COMPILED_MAGIC, COMPILED_MAGIC_LEN) == 0;
+}
+
+static guint32
+compile_string (CompileData *compile,
+                const gchar *string,
+                gssize       length)
+{
+  gpointer offset_plus_one;
+  gchar *copy;
+  guint32 offset;
+
+  if (length < 0)
+    copy = g_strdup (string);
+  else
+    copy = g_strndup (string, length);
+
+  offset_plus_one = g_hash_table_lookup (compile->string_offsets, copy);
+  if (offset_plus_one)
+    {
+      g_free (copy);
+      return GPOINTER_TO_UINT (offset_plus_one) - 1;
+    }
+
+  offset = compile->strings->len;
+  g_string_append_len (compile->strings, copy, strlen (copy) + 1);
+  g_hash_table_insert (compile->string_offsets, copy,
+                       GUINT_TO_POINTER (offset + 1));
+
+  return offset;
+}
+
+static void
+compile_record (CompileData *compile,
+                guint32      word)
+{
+  g_array_append_val (compile->records, word);
+}
+
+static void
+record_start_element (GMarkupParseContext  *context,
+                      const gchar          *element_name,
+                      const gchar         **names,
+                      const gchar         **values,
+                      gpointer              user_data,
+                      GError              **error)
+{
+  CompileData *compile = user_data;
+  guint32 i, n_attrs;
+
+  for (n_attrs = 0; names[n_attrs]; n_attrs++)
+    ;
+
+  compile_record (compile, RECORD_START_ELEMENT);
+  compile_record (compile, compile_string (compile, element_name, -1));
+  compile_record (compile, n_attrs);
+  for (i = 0; i < n_attrs; i++)
+    {
+      compile_record (compile, compile_string (compile, names[i], -1));
+      compile_record (compile, compile_string (compile, values[i], -1));
+    }
+}
+
+static void
+record_end_element (GMarkupParseContext  *context,
+                    const gchar          *element_name,
+                    gpointer              user_data,
+                    GError              **error)
+{
+  CompileData *compile = user_data;
+
+  compile_record (compile, RECORD_END_ELEMENT);
+  compile_record (compile, compile_string (compile, element_name, -1));
+}
+
+static void
+record_text (GMarkupParseContext  *context,
+             const gchar          *text,
+             gsize                 text_len,
+             gpointer              user_data,
+             GError              **error)
+{
+  CompileData *compile = user_data;
+
+  compile_record (compile, RECORD_TEXT);
+  compile_record (compile, compile_string (compile, text, text_len));
+  compile_record (compile, text_len);
+}
+
+GBytes *
+_gtk_builder_parser_precompile (const gchar  *text,
+                                gssize        length,
+                                GError      **error)
+{
+  const GMarkupParser recorder = {
+    record_start_element,
+    record_end_element,
+    record_text,
+    NULL,
+  };
+  GMarkupParseContext *context;
+  CompileData compile;
+  CompiledHeader header;
+  GString *result;
+  gsize total;
+
+  compile.strings = g_string_new (NULL);
+  compile.records = g_array_new (FALSE, FALSE, sizeof (guint32));
+  compile.string_offsets = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                  g_free, NULL);
+
+  context = g_markup_parse_context_new (&recorder,
+                                        G_MARKUP_TREAT_CDATA_AS_TEXT,
+                                        &compile, NULL);
+
+  if (!g_markup_parse_context_parse (context, text, length, error) ||
+      !g_markup_parse_context_end_parse (context, error))
+    {
+      g_markup_parse_context_free (context);
+      g_string_free (compile.strings, TRUE);
+      g_array_free (compile.records, TRUE);
+      g_hash_table_destroy (compile.string_offsets);
+      return NULL;
+    }
+
+  g_markup_parse_context_free (context);
+  g_hash_table_destroy (compile.string_offsets);
+
+  /* Pad the string table so that the records are 4-byte aligned */
+  while ((sizeof (CompiledHeader) + compile.strings->len) % 4 != 0)
+    g_string_append_c (compile.strings, '\0');
+
+  memcpy (header.magic, COMPILED_MAGIC, COMPILED_MAGIC_LEN);
+  header.byte_order = COMPILED_BYTE_ORDER;
+  header.records_offset = sizeof (CompiledHeader) + compile.strings->len;
+
+  result = g_string_sized_new (header.records_offset +
+                               compile.records->len * sizeof (guint32));
+  g_string_append_len (result, (const gchar *)&header, sizeof (CompiledHeader));
+  g_string_append_len (result, compile.strings->str, compile.strings->len);
+  g_string_append_len (result, compile.records->data,
+                       compile.records->len * sizeof (guint32));
+
+  g_string_free (compile.strings, TRUE);
+  g_array_free (compile.records, TRUE);
+
+  total = result->len;
+
+  return g_bytes_new_take (g_string_free (result, FALSE), total);
+}
+
+/* The replays that are currently in progress, needed to resolve
+ * a GMarkupParseContext back to its ParserData in the getters
+ * below. Replays can nest when building an object instantiates
+ * a composite template, hence a list.
+ */
+static GSList *active_replays = NULL;
+
+static ParserData *
+find_replay_data (GMarkupParseContext *context)
+{
+  GSList *l;
+
+  for (l = active_replays; l; l = l->next)
+    {
+      ParserData *data = l->data;
+
+      if (data->ctx == context)
+        return data;
+    }
+
+  return NULL;
+}
+
+const gchar *
+_gtk_builder_parser_get_element (GMarkupParseContext *context)
+{
+  ParserData *data = find_replay_data (context);
+
+  if (data)
+    return data->compiled_elements ? data->compiled_elements->data : NULL;
+
+  return g_markup_parse_context_get_element (context);
+}
+
+const GSList *
+_gtk_builder_parser_get_element_stack (GMarkupParseContext *context)
+{
+  ParserData *data = find_replay_data (context);
+
+  if (data)
+    return data->compiled_elements;
+
+  return g_markup_parse_context_get_element_stack (context);
+}
+
+static void
+corrupt_blob_error (ParserData  *data,
+                    GError     **error)
+{
+  g_set_error (error,
+               GTK_BUILDER_ERROR,
+               GTK_BUILDER_ERROR_INVALID_VALUE,
+               "%s: Corrupt precompiled GtkBuilder data", data->filename);
+}
+
+static gboolean
+replay_compiled_buffer (ParserData   *data,
+                        const gchar  *buffer,
+                        gsize         length,
+                        GError      **error)
+{
+  const CompiledHeader *header = (const CompiledHeader *)buffer;
+  const gchar *strings;
+  const guint32 *records;
+  guint32 strings_len, n_records, pos;
+  GPtrArray *attrs;
+  GError *tmp_error = NULL;
+
+  if (header->byte_order != COMPILED_BYTE_ORDER ||
+      header->records_offset < sizeof (CompiledHeader) ||
+      header->records_offset > length ||
+      (length - header->records_offset) % sizeof (guint32) != 0)
+    {
+      corrupt_blob_error (data, error);
+      return FALSE;
+    }
+
+  strings = buffer + sizeof (CompiledHeader);
+  strings_len = header->records_offset - sizeof (CompiledHeader);
+  records = (const guint32 *)(buffer + header->records_offset);
+  n_records = (length - header->records_offset) / sizeof (guint32);
+
+  active_replays = g_slist_prepend (active_replays, data);
+
+  attrs = g_ptr_array_new ();
+
+  pos = 0;
+  while (pos < n_records && tmp_error == NULL)
+    {
+      switch (records[pos])
+        {
+        case RECORD_START_ELEMENT:
+          {
+            const gchar *element_name;
+            const gchar **names, **values;
+            guint32 i, n_attrs;
+
+            if (pos + 3 > n_records ||
+                records[pos + 1] >= strings_len ||
+                records[pos + 2] > (n_records - pos - 3) / 2)
+              goto corrupt;
+
+            element_name = strings + records[pos + 1];
+            n_attrs = records[pos + 2];
+
+            g_ptr_array_set_size (attrs, 0);
+            for (i = 0; i < n_attrs; i++)
+              {
+                if (records[pos + 3 + 2 * i] >= strings_len ||
+                    records[pos + 4 + 2 * i] >= strings_len)
+                  goto corrupt;
+                g_ptr_array_add (attrs, (gpointer)(strings + records[pos + 3 + 2 * i]));
+              }
+            g_ptr_array_add (attrs, NULL);
+            for (i = 0; i < n_attrs; i++)
+              g_ptr_array_add (attrs, (gpointer)(strings + records[pos + 4 + 2 * i]));
+            g_ptr_array_add (attrs, NULL);
+
+            names = (const gchar **)attrs->pdata;
+            values = names + n_attrs + 1;
+
+            data->compiled_elements = g_slist_prepend (data->compiled_elements,
+                                                       (gpointer)element_name);
+
+            start_element (data->ctx, element_name, names, values,
+                           data, &tmp_error);
+
+            pos += 3 + 2 * n_attrs;
+          }
+          break;
+
+        case RECORD_END_ELEMENT:
+          if (pos + 2 > n_records ||
+              records[pos + 1] >= strings_len ||
+              data->compiled_elements == NULL)
+            goto corrupt;
+
+          end_element (data->ctx, strings + records[pos + 1],
+                       data, &tmp_error);
+
+          data->compiled_elements = g_slist_delete_link (data->compiled_elements,
+                                                         data->compiled_elements);
+          pos += 2;
+          break;
+
+        case RECORD_TEXT:
+          if (pos + 3 > n_records ||
+              records[pos + 1] >= strings_len)
+            goto corrupt;
+
+          text (data->ctx, strings + records[pos + 1], records[pos + 2],
+                data, &tmp_error);
+
+          pos += 3;
+          break;
+
+        default:
+          goto corrupt;
+        }
+    }
+
+  g_ptr_array_free (attrs, TRUE);
+  g_slist_free (data->compiled_elements);
+  data->compiled_elements = NULL;
+  active_replays = g_slist_remove (active_replays, data);
+
+  if (tmp_error)
+    {
+      g_propagate_error (error, tmp_error);
+      return FALSE;
+    }
+
+  return TRUE;
+
+corrupt:
+  g_ptr_array_free (attrs, TRUE);
+  g_slist_free (data->compiled_elements);
+  data->compiled_elements = NULL;
+  active_replays = g_slist_remove (active_replays, data);
+  g_clear_error (&tmp_error);
+  corrupt_blob_error (data, error);
+
+  return FALSE;
+}
+
+void
+_gtk_builder_parser_replay_lazy_child (GtkBuilder     *builder,
+                                       LazyChildInfo  *lazy,
+                                       GError        **error)
+{
+  ParserData data;
+  ObjectInfo *object_info;
+  GObject *parent;
+  GError *tmp_error = NULL;
+  GSList *l;
+  guint i;
+
+  parent = gtk_builder_get_object (builder, lazy->parent_id);
+  if (parent == NULL)
+    {
+      g_set_error (error,
+                   GTK_BUILDER_ERROR,
+                   GTK_BUILDER_ERROR_INVALID_ID,
+                   "Parent object '%s' of lazy child not found",
+                   lazy->parent_id);
+      return;
+    }
+
+  memset (&data, 0, sizeof (ParserData));
+  data.builder = builder;
+  data.filename = "<lazy child>";
+  data.domain = g_strdup (gtk_builder_get_translation_domain (builder));
+  data.object_ids = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                           (GDestroyNotify)g_free, NULL);
+  data.inside_requested_object = TRUE;
+  data.ctx = g_markup_parse_context_new (&parser,
+                                         G_MARKUP_TREAT_CDATA_AS_TEXT,
+                                         &data, NULL);
+
+  /* Seed the stack with the already built parent, the way the original
+   * parse would have left it when reaching the <child>
+   */
+  object_info = g_slice_new0 (ObjectInfo);
+  object_info->tag_type = TAG_OBJECT;
+  object_info->type = G_OBJECT_TYPE (parent);
+  object_info->oclass = g_type_class_ref (G_OBJECT_TYPE (parent));
+  object_info->id = g_strdup (lazy->parent_id);
+  object_info->object = parent;
+  object_info->applied_properties = TRUE;
+  state_push (&data, object_info);
+  data.cur_object_level = 1;
+  data.last_element = "object";
+
+  active_replays = g_slist_prepend (active_replays, &data);
+
+  for (i = 0; i < lazy->events->len && tmp_error == NULL; i++)
+    {
+      LazyEvent *event = g_ptr_array_index (lazy->events, i);
+
+      switch (event->type)
+        {
+        case LAZY_EVENT_START:
+          data.compiled_elements = g_slist_prepend (data.compiled_elements,
+                                                    event->name);
+          start_element (data.ctx, event->name,
+                         (const gchar **)event->names,
+                         (const gchar **)event->values,
+                         &data, &tmp_error);
+          break;
+        case LAZY_EVENT_END:
+          end_element (data.ctx, event->name, &data, &tmp_error);
+          data.compiled_elements = g_slist_delete_link (data.compiled_elements,
+                                                        data.compiled_elements);
+          break;
+        case LAZY_EVENT_TEXT:
+          text (data.ctx, event->name, event->text_len, &data, &tmp_error);
+          break;
+        default:
+          g_assert_not_reached ();
+        }
+    }
+
+  active_replays = g_slist_remove (active_replays, &data);
+
+  if (tmp_error)
+    {
+      g_propagate_error (error, tmp_error);
+      goto out;
+    }
+
+  _gtk_builder_finish (builder);
+  if (_gtk_builder_lookup_failed (builder, error))
+    goto out;
+
+  /* Custom parser_finished */
+  data.custom_finalizers = g_slist_reverse (data.custom_finalizers);
+  for (l = data.custom_finalizers; l; l = l->next)
+    {
+      SubParser *sub = (SubParser*)l->data;
+
+      gtk_buildable_custom_finished (GTK_BUILDABLE (sub->object),
+                                     builder,
+                                     sub->child,
+                                     sub->tagname,
+                                     sub->data);
+      if (_gtk_builder_lookup_failed (builder, error))
+        goto out;
+    }
+
+  /* Common parser_finished, for all created objects */
+  data.finalizers = g_slist_reverse (data.finalizers);
+  for (l = data.finalizers; l; l = l->next)
+    {
+      GtkBuildable *buildable = (GtkBuildable*)l->data;
+
+      gtk_buildable_parser_finished (GTK_BUILDABLE (buildable), builder);
+      if (_gtk_builder_lookup_failed (builder, error))
+        goto out;
+    }
+
+ out:
+  if (data.lazy_child)
+    _gtk_builder_lazy_child_free (data.lazy_child);
+  g_slist_free_full (data.stack, (GDestroyNotify)free_info);
+  g_slist_free_full (data.custom_finalizers, (GDestroyNotify)free_subparser);
+  g_slist_free (data.finalizers);
+  g_slist_free (data.compiled_elements);
+  g_free (data.domain);
+  g_hash_table_destroy (data.object_ids);
+  g_markup_parse_context_free (data.ctx);
+}
+
 void
 _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
                                   const gchar  *filename,
@@ -1269,7 +1988,12 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
                                           G_MARKUP_TREAT_CDATA_AS_TEXT,
                                           &data, NULL);
 
-  if (!g_markup_parse_context_parse (data.ctx, buffer, length, error))
+  if (_gtk_builder_parser_is_precompiled (buffer, length))
+    {
+      if (!replay_compiled_buffer (&data, buffer, length, error))
+        goto out;
+    }
+  else if (!g_markup_parse_context_parse (data.ctx, buffer, length, error))
     goto out;
 
   _gtk_builder_finish (builder);
@@ -1304,6 +2028,8 @@ _gtk_builder_parser_parse_buffer (GtkBuilder   *builder,
 
  out:
 
+  if (data.lazy_child)
+    _gtk_builder_lazy_child_free (data.lazy_child);
   g_slist_free_full (data.stack, (GDestroyNotify)free_info);
   g_slist_free_full (data.custom_finalizers, (GDestroyNotify)free_subparser);
   g_slist_free (data.finalizers);
@@ -97,6 +97,14 @@ typedef struct {
   GObject *child;
 } SubParser;
 
+typedef struct {
+  gchar     *parent_id;   /* id of the object the <child> belongs to */
+  GObject   *parent;      /* resolved when the trigger is installed */
+  gulong     map_handler;
+  GPtrArray *events;      /* the recorded markup events of the subtree */
+  GPtrArray *object_ids;  /* ids of the objects declared inside */
+} LazyChildInfo;
+
 typedef struct {
   const gchar *last_element;
   GtkBuilder *builder;
@@ -116,6 +124,15 @@ typedef struct {
   gint object_counter;
 
   GHashTable *object_ids;
+
+  /* Element name stack while replaying a precompiled buffer,
+   * NULL when parsing XML. The strings point into the buffer.
+   */
+  GSList *compiled_elements;
+
+  /* The <child lazy="true"> subtree currently being captured */
+  LazyChildInfo *lazy_child;
+  gint lazy_depth;
 } ParserData;
 
 typedef GType (*GTypeGetFunc) (void);
@@ -127,6 +144,24 @@ void _gtk_builder_parser_parse_buffer (GtkBuilder *builder,
                                        gsize length,
                                        gchar **requested_objs,
                                        GError **error);
+GBytes * _gtk_builder_parser_precompile (const gchar  *text,
+                                         gssize        length,
+                                         GError      **error);
+gboolean _gtk_builder_parser_is_precompiled (const gchar *buffer,
+                                             gsize        length);
+void _gtk_builder_add_lazy_child (GtkBuilder    *builder,
+                                  LazyChildInfo *lazy);
+void _gtk_builder_lazy_child_free (LazyChildInfo *lazy);
+void _gtk_builder_parser_replay_lazy_child (GtkBuilder     *builder,
+                                            LazyChildInfo  *lazy,
+                                            GError        **error);
+
+/* Wrappers around the GMarkupParseContext getters that also work
+ * while a precompiled buffer is being replayed, for use in custom
+ * tag subparsers
+ */
+const gchar  * _gtk_builder_parser_get_element       (GMarkupParseContext *context);
+const GSList * _gtk_builder_parser_get_element_stack (GMarkupParseContext *context);
 GObject * _gtk_builder_construct (GtkBuilder *builder,
                                   ObjectInfo *info,
 				  GError    **error);
@@ -190,6 +225,9 @@ GObject * _gtk_builder_lookup_object      (GtkBuilder           *builder,
                                            const gchar          *name,
                                            gint                  line,
                                            gint                  col);
+GObject * _gtk_builder_get_object_ordered (GtkBuilder           *builder,
+                                           const gchar          *name,
+                                           guint                *position);
 gboolean _gtk_builder_lookup_failed       (GtkBuilder           *builder,
                                            GError              **error);
 
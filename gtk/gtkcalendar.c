@@ -196,6 +196,13 @@ struct _GtkCalendarPrivate
   gint  day_month[6][7];
   gint  day[6][7];
 
+  /* Shaped day-number layouts, kept for the currently displayed
+   * month and dropped whenever the day grid is recomputed. Pango
+   * revalidates them against the widget's context, so font and
+   * direction changes do not need explicit invalidation.
+   */
+  PangoLayout *day_layouts[6][7];
+
   gint  num_marked_dates;
   gint  marked_date[31];
 
@@ -934,6 +941,17 @@ calendar_set_year_next (GtkCalendar *calendar)
   calendar_queue_refresh (calendar);
 }
 
+static void
+calendar_drop_day_layouts (GtkCalendar *calendar)
+{
+  GtkCalendarPrivate *priv = calendar->priv;
+  gint row, col;
+
+  for (row = 0; row < 6; row++)
+    for (col = 0; col < 7; col++)
+      g_clear_object (&priv->day_layouts[row][col]);
+}
+
 static void
 calendar_compute_days (GtkCalendar *calendar)
 {
@@ -947,6 +965,8 @@ calendar_compute_days (GtkCalendar *calendar)
   gint col;
   gint day;
 
+  calendar_drop_day_layouts (calendar);
+
   year = priv->year;
   month = priv->month + 1;
 
@@ -1299,6 +1319,8 @@ gtk_calendar_finalize (GObject *object)
 {
   GtkCalendarPrivate *priv = GTK_CALENDAR (object)->priv;
 
+  calendar_drop_day_layouts (GTK_CALENDAR (object));
+
   g_object_unref (priv->press_gesture);
   g_object_unref (priv->drag_gesture);
   g_object_unref (priv->scroll_controller);
@@ -2266,8 +2288,13 @@ calendar_snapshot_day (GtkCalendar *calendar,
 
   detail = gtk_calendar_get_detail (calendar, row, col);
 
-  layout = gtk_widget_create_pango_layout (widget, buffer);
-  pango_layout_set_alignment (layout, PANGO_ALIGN_CENTER);
+  layout = priv->day_layouts[row][col];
+  if (layout == NULL)
+    {
+      layout = gtk_widget_create_pango_layout (widget, buffer);
+      pango_layout_set_alignment (layout, PANGO_ALIGN_CENTER);
+      priv->day_layouts[row][col] = layout;
+    }
   pango_layout_get_pixel_extents (layout, NULL, &logical_rect);
 
   x_loc = day_rect.x + (day_rect.width - logical_rect.width) / 2;
@@ -2300,15 +2327,23 @@ calendar_snapshot_day (GtkCalendar *calendar,
 
   if (detail && show_details)
     {
+      PangoLayout *detail_layout;
       gchar *markup = g_strconcat ("<small>", detail, "</small>", NULL);
-      pango_layout_set_markup (layout, markup, -1);
+
+      /* Details come from an application callback and can change at
+       * any time, so they get a transient layout instead of touching
+       * the cached day-number layout.
+       */
+      detail_layout = gtk_widget_create_pango_layout (widget, NULL);
+      pango_layout_set_alignment (detail_layout, PANGO_ALIGN_CENTER);
+      pango_layout_set_markup (detail_layout, markup, -1);
       g_free (markup);
 
       if (day == priv->selected_day)
         {
           /* Stripping colors as they conflict with selection marking. */
 
-          PangoAttrList *attrs = pango_layout_get_attributes (layout);
+          PangoAttrList *attrs = pango_layout_get_attributes (detail_layout);
           PangoAttrList *colors = NULL;
 
           if (attrs)
@@ -2317,17 +2352,18 @@ calendar_snapshot_day (GtkCalendar *calendar,
             pango_attr_list_unref (colors);
         }
 
-      pango_layout_set_wrap (layout, PANGO_WRAP_WORD_CHAR);
-      pango_layout_set_width (layout, PANGO_SCALE * day_rect.width);
+      pango_layout_set_wrap (detail_layout, PANGO_WRAP_WORD_CHAR);
+      pango_layout_set_width (detail_layout, PANGO_SCALE * day_rect.width);
 
       if (priv->detail_height_rows)
         {
           gint dy = day_rect.height - (y_loc - day_rect.y);
-          pango_layout_set_height (layout, PANGO_SCALE * dy);
-          pango_layout_set_ellipsize (layout, PANGO_ELLIPSIZE_END);
+          pango_layout_set_height (detail_layout, PANGO_SCALE * dy);
+          pango_layout_set_ellipsize (detail_layout, PANGO_ELLIPSIZE_END);
         }
 
-      gtk_snapshot_render_layout (snapshot, context, day_rect.x, y_loc, layout);
+      gtk_snapshot_render_layout (snapshot, context, day_rect.x, y_loc, detail_layout);
+      g_object_unref (detail_layout);
     }
 
   if (gtk_widget_has_visible_focus (widget) &&
@@ -2342,7 +2378,6 @@ calendar_snapshot_day (GtkCalendar *calendar,
     priv->detail_overflow[row] &= ~(1 << col);
 
   gtk_style_context_restore (context);
-  g_object_unref (layout);
   g_free (detail);
 }
 
@@ -2286,6 +2286,50 @@ gtk_cell_area_attribute_get_column (GtkCellArea     *area,
   return -1;
 }
 
+/* _gtk_cell_area_cell_content_is_attribute:
+ * @area: a #GtkCellArea
+ * @renderer: the #GtkCellRenderer to check
+ * @attribute: an attribute on the renderer
+ *
+ * Checks whether the per-row content of @renderer comes from
+ * @attribute alone, i.e. @renderer has no cell data function and no
+ * attribute mappings other than @attribute.  Used by the tree view
+ * column to decide whether measured sizes can be cached by content.
+ *
+ * Returns: %TRUE if @attribute is the only per-row input of @renderer
+ */
+gboolean
+_gtk_cell_area_cell_content_is_attribute (GtkCellArea     *area,
+                                          GtkCellRenderer *renderer,
+                                          const gchar     *attribute)
+{
+  GtkCellAreaPrivate *priv;
+  CellInfo           *info;
+  GSList             *node;
+
+  g_return_val_if_fail (GTK_IS_CELL_AREA (area), FALSE);
+  g_return_val_if_fail (GTK_IS_CELL_RENDERER (renderer), FALSE);
+
+  priv = area->priv;
+  info = g_hash_table_lookup (priv->cell_info, renderer);
+
+  if (!info)
+    return TRUE;
+
+  if (info->func)
+    return FALSE;
+
+  for (node = info->attributes; node; node = node->next)
+    {
+      CellAttribute *cell_attribute = node->data;
+
+      if (strcmp (cell_attribute->attribute, attribute) != 0)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
 /**
  * gtk_cell_area_apply_attributes:
  * @area: a #GtkCellArea
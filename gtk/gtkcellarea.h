@@ -529,6 +529,13 @@ void                 _gtk_cell_area_set_cell_data_func_with_proxy  (GtkCellArea
 								    GDestroyNotify         destroy,
 								    gpointer               proxy);
 
+/* Private api for gtktreeviewcolumn.c, to decide whether measured cell
+ * sizes can be cached keyed on the renderer's content.
+ */
+gboolean             _gtk_cell_area_cell_content_is_attribute      (GtkCellArea           *area,
+								    GtkCellRenderer       *renderer,
+								    const gchar           *attribute);
+
 G_END_DECLS
 
 #endif /* __GTK_CELL_AREA_H__ */
@@ -305,6 +305,34 @@ notify_storage_type (GtkCellRendererPixbuf *cellpixbuf,
     }
 }
 
+/* Converting a pixbuf to a cairo surface copies the whole image, and a
+ * tree or icon view rebinding its visible rows does that for every cell
+ * on every size request and every draw. Cache the conversion on the
+ * pixbuf itself, so each image is converted only once for as long as
+ * the model keeps it alive. Pixbufs handed to a renderer are treated as
+ * immutable, like everywhere else in the cell machinery.
+ */
+static cairo_surface_t *
+get_surface_for_pixbuf (GdkPixbuf *pixbuf)
+{
+  static GQuark quark = 0;
+  cairo_surface_t *surface;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("gtk-cell-renderer-pixbuf-surface");
+
+  surface = g_object_get_qdata (G_OBJECT (pixbuf), quark);
+  if (surface)
+    return cairo_surface_reference (surface);
+
+  surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, 1, NULL);
+  g_object_set_qdata_full (G_OBJECT (pixbuf), quark,
+                           cairo_surface_reference (surface),
+                           (GDestroyNotify) cairo_surface_destroy);
+
+  return surface;
+}
+
 static void
 take_image_definition (GtkCellRendererPixbuf *cellpixbuf,
                        GtkImageDefinition    *def)
@@ -356,8 +384,10 @@ gtk_cell_renderer_pixbuf_set_property (GObject      *object,
       surface = NULL;
       pixbuf = g_value_get_object (value);
       if (pixbuf)
-        surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, 1, NULL);
+        surface = get_surface_for_pixbuf (pixbuf);
       take_image_definition (cellpixbuf, gtk_image_definition_new_surface (surface));
+      if (surface)
+        cairo_surface_destroy (surface);
       break;
     case PROP_PIXBUF_EXPANDER_OPEN:
       if (priv->pixbuf_expander_open)
@@ -552,14 +582,14 @@ gtk_cell_renderer_pixbuf_snapshot (GtkCellRenderer      *cell,
       if (is_expanded && priv->pixbuf_expander_open != NULL)
         {
           gtk_icon_helper_init (&icon_helper, gtk_style_context_get_node (context), widget);
-          surface = gdk_cairo_surface_create_from_pixbuf (priv->pixbuf_expander_open, 1, NULL);
+          surface = get_surface_for_pixbuf (priv->pixbuf_expander_open);
           _gtk_icon_helper_set_surface (&icon_helper, surface);
           cairo_surface_destroy (surface);
         }
       else if (!is_expanded && priv->pixbuf_expander_closed != NULL)
         {
           gtk_icon_helper_init (&icon_helper, gtk_style_context_get_node (context), widget);
-          surface = gdk_cairo_surface_create_from_pixbuf (priv->pixbuf_expander_closed, 1, NULL);
+          surface = get_surface_for_pixbuf (priv->pixbuf_expander_closed);
           _gtk_icon_helper_set_surface (&icon_helper, surface);
           cairo_surface_destroy (surface);
         }
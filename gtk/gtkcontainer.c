@@ -1561,11 +1561,21 @@ gtk_container_needs_idle_sizer (GtkContainer *container)
   return gtk_widget_needs_allocate (GTK_WIDGET (container));
 }
 
+/* How much of a frame the layout phase may use before we punt
+ * remaining work to the next frame, so that the paint phase still
+ * runs. Half of a frame at 60Hz - the other half is left for
+ * painting and everything else.
+ */
+#define LAYOUT_PHASE_BUDGET (8 * G_TIME_SPAN_MILLISECOND)
+
 static void
 gtk_container_idle_sizer (GdkFrameClock *clock,
 			  GtkContainer  *container)
 {
   GtkContainerPrivate *priv = gtk_container_get_instance_private (container);
+  gint64 budget_end;
+
+  budget_end = g_get_monotonic_time () + LAYOUT_PHASE_BUDGET;
 
   /* We validate the style contexts in a single loop before even trying
    * to handle resizes instead of doing validations inline.
@@ -1591,7 +1601,17 @@ gtk_container_idle_sizer (GdkFrameClock *clock,
    */
   if (gtk_widget_needs_allocate (GTK_WIDGET (container)))
     {
-      gtk_container_check_resize (container);
+      /* If style validation already used up the frame budget, defer the
+       * allocation pass to the next frame instead of blocking the paint
+       * phase even longer; we re-request the layout phase below, so the
+       * work is only postponed, never dropped. The old allocations are
+       * still valid, so painting one more frame with them is fine.
+       * An unallocated toplevel has nothing sane to paint yet, so its
+       * first allocation always runs, whatever the budget says.
+       */
+      if (gtk_widget_get_allocated_width (GTK_WIDGET (container)) <= 1 ||
+          g_get_monotonic_time () < budget_end)
+        gtk_container_check_resize (container);
     }
 
   if (!gtk_container_needs_idle_sizer (container))
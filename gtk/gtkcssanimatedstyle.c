@@ -72,7 +72,7 @@ gtk_css_animated_style_is_static (GtkCssStyle *style)
 
   for (list = animated->animations; list; list = list->next)
     {
-      if (!_gtk_style_animation_is_static (list->data))
+      if (!_gtk_style_animation_is_static (list->data, animated->current_time))
         return FALSE;
     }
 
@@ -280,10 +280,7 @@ gtk_css_animated_style_create_css_transitions (GSList              *animations,
             {
               animation = gtk_css_animated_style_find_transition (GTK_CSS_ANIMATED_STYLE (source), i);
               if (animation)
-                {
-                  animation = _gtk_style_animation_advance (animation, timestamp);
-                  animations = g_slist_prepend (animations, animation);
-                }
+                animations = g_slist_prepend (animations, g_object_ref (animation));
 
               continue;
             }
@@ -363,9 +360,15 @@ gtk_css_animated_style_create_css_animations (GSList           *animations,
 
       if (animation)
         {
-          animation = _gtk_css_animation_advance_with_play_state (GTK_CSS_ANIMATION (animation),
-                                                                  timestamp,
-                                                                  _gtk_css_play_state_value_get (_gtk_css_array_value_get_nth (play_states, i)));
+          GtkCssPlayState play_state;
+
+          play_state = _gtk_css_play_state_value_get (_gtk_css_array_value_get_nth (play_states, i));
+          if (play_state == _gtk_css_animation_get_play_state (GTK_CSS_ANIMATION (animation)))
+            animation = g_object_ref (animation);
+          else
+            animation = _gtk_css_animation_advance_with_play_state (GTK_CSS_ANIMATION (animation),
+                                                                    timestamp,
+                                                                    play_state);
         }
       else
         {
@@ -405,6 +408,7 @@ gtk_css_animated_style_apply_animations (GtkCssAnimatedStyle *style)
       GtkStyleAnimation *animation = l->data;
       
       _gtk_style_animation_apply_values (animation,
+                                         style->current_time,
                                          GTK_CSS_ANIMATED_STYLE (style));
     }
 }
@@ -467,12 +471,11 @@ gtk_css_animated_style_new_advance (GtkCssAnimatedStyle *source,
   for (l = source->animations; l; l = l->next)
     {
       GtkStyleAnimation *animation = l->data;
-      
-      if (_gtk_style_animation_is_finished (animation))
+
+      if (_gtk_style_animation_is_finished (animation, timestamp))
         continue;
 
-      animation = _gtk_style_animation_advance (animation, timestamp);
-      animations = g_slist_prepend (animations, animation);
+      animations = g_slist_prepend (animations, g_object_ref (animation));
     }
   animations = g_slist_reverse (animations);
 
@@ -28,10 +28,29 @@
 
 G_DEFINE_TYPE (GtkCssAnimation, _gtk_css_animation, GTK_TYPE_STYLE_ANIMATION)
 
+/* Animations are immutable and shared by all the frames they are
+ * running, so the tracker stored in the animation stays at the time
+ * the animation was created or its play state last changed. Queries
+ * for a later time advance a copy of it. While the animation is
+ * paused, time does not pass for it, so the copy is not advanced.
+ */
+static void
+gtk_css_animation_get_tracker (GtkCssAnimation    *animation,
+                               gint64              at_time_us,
+                               GtkProgressTracker *tracker)
+{
+  gtk_progress_tracker_init_copy (&animation->tracker, tracker);
+  if (animation->play_state == GTK_CSS_PLAY_STATE_PAUSED)
+    gtk_progress_tracker_skip_frame (tracker, at_time_us);
+  else
+    gtk_progress_tracker_advance_frame (tracker, at_time_us);
+}
+
 static gboolean
-gtk_css_animation_is_executing (GtkCssAnimation *animation)
+gtk_css_animation_is_executing (GtkCssAnimation    *animation,
+                                GtkProgressTracker *tracker)
 {
-  GtkProgressState state = gtk_progress_tracker_get_state (&animation->tracker);
+  GtkProgressState state = gtk_progress_tracker_get_state (tracker);
 
   switch (animation->fill_mode)
     {
@@ -49,10 +68,11 @@ gtk_css_animation_is_executing (GtkCssAnimation *animation)
 }
 
 static double
-gtk_css_animation_get_progress (GtkCssAnimation *animation)
+gtk_css_animation_get_progress (GtkCssAnimation    *animation,
+                                GtkProgressTracker *tracker)
 {
   gboolean reverse, odd_iteration;
-  gint cycle = gtk_progress_tracker_get_iteration_cycle (&animation->tracker);
+  gint cycle = gtk_progress_tracker_get_iteration_cycle (tracker);
   odd_iteration = cycle % 2 > 0;
 
   switch (animation->direction)
@@ -73,32 +93,25 @@ gtk_css_animation_get_progress (GtkCssAnimation *animation)
       g_return_val_if_reached (0.0);
     }
 
-  return gtk_progress_tracker_get_progress (&animation->tracker, reverse);
-}
-
-static GtkStyleAnimation *
-gtk_css_animation_advance (GtkStyleAnimation    *style_animation,
-                           gint64                timestamp)
-{
-  GtkCssAnimation *animation = GTK_CSS_ANIMATION (style_animation);
-
-  return _gtk_css_animation_advance_with_play_state (animation,
-                                                     timestamp,
-                                                     animation->play_state);
+  return gtk_progress_tracker_get_progress (tracker, reverse);
 }
 
 static void
 gtk_css_animation_apply_values (GtkStyleAnimation    *style_animation,
+                                gint64                for_time_us,
                                 GtkCssAnimatedStyle  *style)
 {
   GtkCssAnimation *animation = GTK_CSS_ANIMATION (style_animation);
+  GtkProgressTracker tracker;
   double progress;
   guint i;
 
-  if (!gtk_css_animation_is_executing (animation))
+  gtk_css_animation_get_tracker (animation, for_time_us, &tracker);
+
+  if (!gtk_css_animation_is_executing (animation, &tracker))
     return;
 
-  progress = gtk_css_animation_get_progress (animation);
+  progress = gtk_css_animation_get_progress (animation, &tracker);
   progress = _gtk_css_ease_value_transform (animation->ease, progress);
 
   for (i = 0; i < _gtk_css_keyframes_get_n_properties (animation->keyframes); i++)
@@ -118,20 +131,25 @@ gtk_css_animation_apply_values (GtkStyleAnimation    *style_animation,
 }
 
 static gboolean
-gtk_css_animation_is_finished (GtkStyleAnimation *style_animation)
+gtk_css_animation_is_finished (GtkStyleAnimation *style_animation,
+                               gint64             at_time_us)
 {
   return FALSE;
 }
 
 static gboolean
-gtk_css_animation_is_static (GtkStyleAnimation *style_animation)
+gtk_css_animation_is_static (GtkStyleAnimation *style_animation,
+                             gint64             at_time_us)
 {
   GtkCssAnimation *animation = GTK_CSS_ANIMATION (style_animation);
+  GtkProgressTracker tracker;
 
   if (animation->play_state == GTK_CSS_PLAY_STATE_PAUSED)
     return TRUE;
 
-  return gtk_progress_tracker_get_state (&animation->tracker) == GTK_PROGRESS_STATE_AFTER;
+  gtk_css_animation_get_tracker (animation, at_time_us, &tracker);
+
+  return gtk_progress_tracker_get_state (&tracker) == GTK_PROGRESS_STATE_AFTER;
 }
 
 static void
@@ -154,7 +172,6 @@ _gtk_css_animation_class_init (GtkCssAnimationClass *klass)
 
   object_class->finalize = gtk_css_animation_finalize;
 
-  animation_class->advance = gtk_css_animation_advance;
   animation_class->apply_values = gtk_css_animation_apply_values;
   animation_class->is_finished = gtk_css_animation_is_finished;
   animation_class->is_static = gtk_css_animation_is_static;
@@ -210,6 +227,14 @@ _gtk_css_animation_get_name (GtkCssAnimation *animation)
   return animation->name;
 }
 
+GtkCssPlayState
+_gtk_css_animation_get_play_state (GtkCssAnimation *animation)
+{
+  g_return_val_if_fail (GTK_IS_CSS_ANIMATION (animation), GTK_CSS_PLAY_STATE_RUNNING);
+
+  return animation->play_state;
+}
+
 GtkStyleAnimation *
 _gtk_css_animation_advance_with_play_state (GtkCssAnimation *source,
                                             gint64           timestamp,
@@ -229,7 +254,10 @@ _gtk_css_animation_advance_with_play_state (GtkCssAnimation *source,
   animation->fill_mode = source->fill_mode;
 
   gtk_progress_tracker_init_copy (&source->tracker, &animation->tracker);
-  if (animation->play_state == GTK_CSS_PLAY_STATE_PAUSED)
+  /* Skip the time the animation was paused instead of jumping ahead
+   * by it when it resumes. */
+  if (animation->play_state == GTK_CSS_PLAY_STATE_PAUSED ||
+      source->play_state == GTK_CSS_PLAY_STATE_PAUSED)
     gtk_progress_tracker_skip_frame (&animation->tracker, timestamp);
   else
     gtk_progress_tracker_advance_frame (&animation->tracker, timestamp);
@@ -74,6 +74,8 @@ GtkStyleAnimation *     _gtk_css_animation_advance_with_play_state (GtkCssAnimat
 
 const char *            _gtk_css_animation_get_name        (GtkCssAnimation   *animation);
 
+GtkCssPlayState         _gtk_css_animation_get_play_state  (GtkCssAnimation   *animation);
+
 G_END_DECLS
 
 #endif /* __GTK_CSS_ANIMATION_PRIVATE_H__ */
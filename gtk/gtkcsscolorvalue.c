@@ -69,9 +69,20 @@ struct _GtkCssValue
   } sym_col;
 };
 
+/* Theme stylesheets use the same handful of literal colors over and
+ * over, so those get interned here, keyed by their GdkRGBA. The values
+ * own themselves as usual, entries are removed again when they are
+ * freed.
+ */
+static GHashTable *literal_colors = NULL;
+
 static void
 gtk_css_value_color_free (GtkCssValue *color)
 {
+  if (color->type == COLOR_TYPE_LITERAL)
+    g_hash_table_remove (literal_colors,
+                         _gtk_css_rgba_value_get_rgba (color->last_value));
+
   if (color->last_value)
     _gtk_css_value_unref (color->last_value);
 
@@ -459,10 +470,22 @@ _gtk_css_color_value_new_literal (const GdkRGBA *color)
 
   g_return_val_if_fail (color != NULL, NULL);
 
+  if (literal_colors == NULL)
+    literal_colors = g_hash_table_new_full ((GHashFunc) gdk_rgba_hash,
+                                            (GEqualFunc) gdk_rgba_equal,
+                                            (GDestroyNotify) gdk_rgba_free,
+                                            NULL);
+
+  value = g_hash_table_lookup (literal_colors, color);
+  if (value)
+    return _gtk_css_value_ref (value);
+
   value = _gtk_css_value_new (GtkCssValue, &GTK_CSS_VALUE_COLOR);
   value->type = COLOR_TYPE_LITERAL;
   value->last_value = _gtk_css_rgba_value_new_from_rgba (color);
 
+  g_hash_table_insert (literal_colors, gdk_rgba_copy (color), value);
+
   return value;
 }
 
@@ -30,9 +30,38 @@ struct _GtkCssValue {
   double value;
 };
 
+/* Identical dimensions show up in huge numbers across the computed
+ * styles of an application, so all values that are not covered by
+ * the static singletons below get interned here. The values own
+ * themselves as usual, entries are removed again when they are freed.
+ */
+static GHashTable *dimension_cache = NULL;
+
+static guint
+gtk_css_value_dimension_cache_hash (gconstpointer item)
+{
+  const GtkCssValue *value = item;
+
+  return g_double_hash (&value->value) ^ value->unit;
+}
+
+static gboolean
+gtk_css_value_dimension_cache_equal (gconstpointer item1,
+                                     gconstpointer item2)
+{
+  const GtkCssValue *value1 = item1;
+  const GtkCssValue *value2 = item2;
+
+  return value1->unit == value2->unit &&
+         value1->value == value2->value;
+}
+
 static void
 gtk_css_value_dimension_free (GtkCssValue *value)
 {
+  if (!isnan (value->value))
+    g_hash_table_remove (dimension_cache, value);
+
   g_slice_free (GtkCssValue, value);
 }
 
@@ -316,10 +345,30 @@ gtk_css_dimension_value_new (double     value,
       return _gtk_css_value_ref (&px_singletons[(int) value]);
     }
 
+  /* NaN never compares equal to itself, so it could not be looked up
+   * or removed again and is not worth interning anyway. */
+  if (!isnan (value))
+    {
+      GtkCssValue lookup;
+
+      if (dimension_cache == NULL)
+        dimension_cache = g_hash_table_new (gtk_css_value_dimension_cache_hash,
+                                            gtk_css_value_dimension_cache_equal);
+
+      lookup.unit = unit;
+      lookup.value = value;
+      result = g_hash_table_lookup (dimension_cache, &lookup);
+      if (result)
+        return _gtk_css_value_ref (result);
+    }
+
   result = _gtk_css_value_new (GtkCssValue, &GTK_CSS_VALUE_DIMENSION.value_class);
   result->unit = unit;
   result->value = value;
 
+  if (!isnan (value))
+    g_hash_table_add (dimension_cache, result);
+
   return result;
 }
 
@@ -75,6 +75,30 @@ gtk_css_value_enum_print (const GtkCssValue *value,
   g_string_append (string, value->name);
 }
 
+/* The value arrays below are tiny, so collecting the names on the
+ * stack and matching the next identifier once beats tokenizing the
+ * input again for every candidate keyword. */
+static GtkCssValue *
+enum_value_try_parse (GtkCssParser      *parser,
+                      GtkCssValue       *values,
+                      guint              n_values)
+{
+  const char *names[32];
+  guint i;
+  int found;
+
+  g_assert (n_values <= G_N_ELEMENTS (names));
+
+  for (i = 0; i < n_values; i++)
+    names[i] = values[i].name;
+
+  found = _gtk_css_parser_try_keywords (parser, names, n_values);
+  if (found < 0)
+    return NULL;
+
+  return _gtk_css_value_ref (&values[found]);
+}
+
 /* GtkBorderStyle */
 
 static const GtkCssValueClass GTK_CSS_VALUE_BORDER_STYLE = {
@@ -109,17 +133,9 @@ _gtk_css_border_style_value_new (GtkBorderStyle border_style)
 GtkCssValue *
 _gtk_css_border_style_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (border_style_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, border_style_values[i].name, TRUE))
-        return _gtk_css_value_ref (&border_style_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, border_style_values, G_N_ELEMENTS (border_style_values));
 }
 
 GtkBorderStyle
@@ -170,17 +186,9 @@ _gtk_css_blend_mode_value_new (GskBlendMode blend_mode)
 GtkCssValue *
 _gtk_css_blend_mode_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (blend_mode_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, blend_mode_values[i].name, TRUE))
-        return _gtk_css_value_ref (&blend_mode_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, blend_mode_values, G_N_ELEMENTS (blend_mode_values));
 }
 
 GskBlendMode
@@ -311,17 +319,9 @@ _gtk_css_font_size_value_new (GtkCssFontSize font_size)
 GtkCssValue *
 _gtk_css_font_size_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_size_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_size_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_size_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_size_values, G_N_ELEMENTS (font_size_values));
 }
 
 GtkCssFontSize
@@ -359,17 +359,9 @@ _gtk_css_font_style_value_new (PangoStyle font_style)
 GtkCssValue *
 _gtk_css_font_style_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_style_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_style_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_style_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_style_values, G_N_ELEMENTS (font_style_values));
 }
 
 PangoStyle
@@ -550,17 +542,9 @@ _gtk_css_font_stretch_value_new (PangoStretch font_stretch)
 GtkCssValue *
 _gtk_css_font_stretch_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_stretch_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_stretch_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_stretch_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_stretch_values, G_N_ELEMENTS (font_stretch_values));
 }
 
 PangoStretch
@@ -598,17 +582,9 @@ _gtk_css_text_decoration_line_value_new (GtkTextDecorationLine line)
 GtkCssValue *
 _gtk_css_text_decoration_line_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (text_decoration_line_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, text_decoration_line_values[i].name, TRUE))
-        return _gtk_css_value_ref (&text_decoration_line_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, text_decoration_line_values, G_N_ELEMENTS (text_decoration_line_values));
 }
 
 GtkTextDecorationLine
@@ -646,17 +622,9 @@ _gtk_css_text_decoration_style_value_new (GtkTextDecorationStyle style)
 GtkCssValue *
 _gtk_css_text_decoration_style_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (text_decoration_style_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, text_decoration_style_values[i].name, TRUE))
-        return _gtk_css_value_ref (&text_decoration_style_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, text_decoration_style_values, G_N_ELEMENTS (text_decoration_style_values));
 }
 
 GtkTextDecorationStyle
@@ -700,17 +668,9 @@ _gtk_css_area_value_new (GtkCssArea area)
 GtkCssValue *
 _gtk_css_area_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (area_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, area_values[i].name, TRUE))
-        return _gtk_css_value_ref (&area_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, area_values, G_N_ELEMENTS (area_values));
 }
 
 GtkCssArea
@@ -755,20 +715,9 @@ _gtk_css_direction_value_new (GtkCssDirection direction)
 GtkCssValue *
 _gtk_css_direction_value_try_parse (GtkCssParser *parser)
 {
-  int i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  /* need to parse backwards here, otherwise "alternate" will also match "alternate-reverse".
-   * Our parser rocks!
-   */
-  for (i = G_N_ELEMENTS (direction_values) - 1; i >= 0; i--)
-    {
-      if (_gtk_css_parser_try (parser, direction_values[i].name, TRUE))
-        return _gtk_css_value_ref (&direction_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, direction_values, G_N_ELEMENTS (direction_values));
 }
 
 GtkCssDirection
@@ -811,17 +760,9 @@ _gtk_css_play_state_value_new (GtkCssPlayState play_state)
 GtkCssValue *
 _gtk_css_play_state_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (play_state_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, play_state_values[i].name, TRUE))
-        return _gtk_css_value_ref (&play_state_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, play_state_values, G_N_ELEMENTS (play_state_values));
 }
 
 GtkCssPlayState
@@ -866,17 +807,9 @@ _gtk_css_fill_mode_value_new (GtkCssFillMode fill_mode)
 GtkCssValue *
 _gtk_css_fill_mode_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (fill_mode_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, fill_mode_values[i].name, TRUE))
-        return _gtk_css_value_ref (&fill_mode_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, fill_mode_values, G_N_ELEMENTS (fill_mode_values));
 }
 
 GtkCssFillMode
@@ -920,17 +853,9 @@ _gtk_css_icon_style_value_new (GtkCssIconStyle icon_style)
 GtkCssValue *
 _gtk_css_icon_style_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (icon_style_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, icon_style_values[i].name, TRUE))
-        return _gtk_css_value_ref (&icon_style_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, icon_style_values, G_N_ELEMENTS (icon_style_values));
 }
 
 GtkCssIconStyle
@@ -974,17 +899,9 @@ _gtk_css_font_kerning_value_new (GtkCssFontKerning kerning)
 GtkCssValue *
 _gtk_css_font_kerning_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_kerning_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_kerning_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_kerning_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_kerning_values, G_N_ELEMENTS (font_kerning_values));
 }
 
 GtkCssFontKerning
@@ -1028,17 +945,9 @@ _gtk_css_font_variant_position_value_new (GtkCssFontVariantPosition position)
 GtkCssValue *
 _gtk_css_font_variant_position_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_position_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_position_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_variant_position_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_variant_position_values, G_N_ELEMENTS (font_variant_position_values));
 }
 
 GtkCssFontVariantPosition
@@ -1086,17 +995,9 @@ _gtk_css_font_variant_caps_value_new (GtkCssFontVariantCaps caps)
 GtkCssValue *
 _gtk_css_font_variant_caps_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_caps_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_caps_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_variant_caps_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_variant_caps_values, G_N_ELEMENTS (font_variant_caps_values));
 }
 
 GtkCssFontVariantCaps
@@ -1139,17 +1040,9 @@ _gtk_css_font_variant_alternate_value_new (GtkCssFontVariantAlternate alternate)
 GtkCssValue *
 _gtk_css_font_variant_alternate_value_try_parse (GtkCssParser *parser)
 {
-  guint i;
-
   g_return_val_if_fail (parser != NULL, NULL);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_alternate_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_alternate_values[i].name, TRUE))
-        return _gtk_css_value_ref (&font_variant_alternate_values[i]);
-    }
-
-  return NULL;
+  return enum_value_try_parse (parser, font_variant_alternate_values, G_N_ELEMENTS (font_variant_alternate_values));
 }
 
 GtkCssFontVariantAlternate
@@ -1169,6 +1062,27 @@ typedef struct {
   const char *name;
 } FlagsValue;
 
+static int
+flags_value_try_parse_one (GtkCssParser     *parser,
+                           const FlagsValue *values,
+                           guint             n_values)
+{
+  const char *names[32];
+  guint i;
+  int found;
+
+  g_assert (n_values <= G_N_ELEMENTS (names));
+
+  for (i = 0; i < n_values; i++)
+    names[i] = values[i].name;
+
+  found = _gtk_css_parser_try_keywords (parser, names, n_values);
+  if (found < 0)
+    return 0;
+
+  return values[found].value;
+}
+
 static gboolean
 gtk_css_value_flags_equal (const GtkCssValue *enum1,
                            const GtkCssValue *enum2)
@@ -1267,19 +1181,11 @@ GtkCssFontVariantLigature
 _gtk_css_font_variant_ligature_try_parse_one (GtkCssParser              *parser,
                                               GtkCssFontVariantLigature  base)
 {
-  guint i;
-  GtkCssFontVariantLigature value = 0;
+  GtkCssFontVariantLigature value;
 
   g_return_val_if_fail (parser != NULL, 0);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_ligature_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_ligature_values[i].name, TRUE))
-        {
-          value = font_variant_ligature_values[i].value;
-          break;
-        }
-    }
+  value = flags_value_try_parse_one (parser, font_variant_ligature_values, G_N_ELEMENTS (font_variant_ligature_values));
 
   if (value == 0)
     return base; /* not parsing this value */
@@ -1367,19 +1273,11 @@ GtkCssFontVariantNumeric
 _gtk_css_font_variant_numeric_try_parse_one (GtkCssParser             *parser,
                                              GtkCssFontVariantNumeric  base)
 {
-  guint i;
-  GtkCssFontVariantNumeric value = 0;
+  GtkCssFontVariantNumeric value;
 
   g_return_val_if_fail (parser != NULL, 0);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_numeric_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_numeric_values[i].name, TRUE))
-        {
-          value = font_variant_numeric_values[i].value;
-          break;
-        }
-    }
+  value = flags_value_try_parse_one (parser, font_variant_numeric_values, G_N_ELEMENTS (font_variant_numeric_values));
 
   if (value == 0)
     return base; /* not parsing this value */
@@ -1507,19 +1405,11 @@ GtkCssFontVariantEastAsian
 _gtk_css_font_variant_east_asian_try_parse_one (GtkCssParser               *parser,
                                                 GtkCssFontVariantEastAsian  base)
 {
-  guint i;
-  GtkCssFontVariantEastAsian value = 0;
+  GtkCssFontVariantEastAsian value;
 
   g_return_val_if_fail (parser != NULL, 0);
 
-  for (i = 0; i < G_N_ELEMENTS (font_variant_east_asian_values); i++)
-    {
-      if (_gtk_css_parser_try (parser, font_variant_east_asian_values[i].name, TRUE))
-        {
-          value = font_variant_east_asian_values[i].value;
-          break;
-        }
-    }
+  value = flags_value_try_parse_one (parser, font_variant_east_asian_values, G_N_ELEMENTS (font_variant_east_asian_values));
 
   if (value == 0)
     return base; /* not parsing this value */
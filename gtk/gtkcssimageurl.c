@@ -27,34 +27,90 @@
 
 G_DEFINE_TYPE (GtkCssImageUrl, _gtk_css_image_url, GTK_TYPE_CSS_IMAGE)
 
+/* Theme assets are referenced from many style values: every url()
+ * occurrence used to decode its own copy of the file, and since the
+ * renderers cache GPU uploads per GdkTexture, every copy got uploaded
+ * again for every window using it. Share one texture per URI instead.
+ * The registry only holds weak references, so assets go away with the
+ * last style value using them.
+ */
+static GHashTable *texture_registry = NULL;  /* uri => GdkTexture */
+
+static void
+texture_registry_texture_gone (gpointer  uri,
+                               GObject  *where_the_texture_was)
+{
+  g_hash_table_remove (texture_registry, uri);
+}
+
+static GdkTexture *
+texture_registry_lookup (const char *uri)
+{
+  GdkTexture *texture;
+
+  if (texture_registry == NULL)
+    return NULL;
+
+  texture = g_hash_table_lookup (texture_registry, uri);
+  if (texture)
+    g_object_ref (texture);
+
+  return texture;
+}
+
+static void
+texture_registry_add (const char *uri,
+                      GdkTexture *texture)
+{
+  char *key;
+
+  if (texture_registry == NULL)
+    texture_registry = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                              g_free, NULL);
+
+  key = g_strdup (uri);
+  g_hash_table_insert (texture_registry, key, texture);
+  g_object_weak_ref (G_OBJECT (texture), texture_registry_texture_gone, key);
+}
+
 static GtkCssImage *
 gtk_css_image_url_load_image (GtkCssImageUrl  *url,
                               GError         **error)
 {
   GdkTexture *texture;
   GError *local_error = NULL;
+  char *uri;
 
   if (url->loaded_image)
     return url->loaded_image;
 
-  /* We special case resources here so we can use
-     gdk_pixbuf_new_from_resource, which in turn has some special casing
-     for GdkPixdata files to avoid duplicating the memory for the pixbufs */
-  if (g_file_has_uri_scheme (url->file, "resource"))
+  uri = g_file_get_uri (url->file);
+  texture = texture_registry_lookup (uri);
+
+  if (texture == NULL)
     {
-      char *uri = g_file_get_uri (url->file);
-      char *resource_path = g_uri_unescape_string (uri + strlen ("resource://"), NULL);
+      /* We special case resources here so we can use
+         gdk_pixbuf_new_from_resource, which in turn has some special casing
+         for GdkPixdata files to avoid duplicating the memory for the pixbufs */
+      if (g_file_has_uri_scheme (url->file, "resource"))
+        {
+          char *resource_path = g_uri_unescape_string (uri + strlen ("resource://"), NULL);
 
-      texture = gdk_texture_new_from_resource (resource_path);
+          texture = gdk_texture_new_from_resource (resource_path);
 
-      g_free (resource_path);
-      g_free (uri);
-    }
-  else
-    {
-      texture = gdk_texture_new_from_file (url->file, &local_error);
+          g_free (resource_path);
+        }
+      else
+        {
+          texture = gdk_texture_new_from_file (url->file, &local_error);
+        }
+
+      if (texture)
+        texture_registry_add (uri, texture);
     }
 
+  g_free (uri);
+
   if (texture == NULL)
     {
       if (error)
@@ -25,6 +25,36 @@
 
 /* GTK_CSS_MATCHER_WIDGET_PATH */
 
+static guint64
+gtk_css_matcher_widget_path_compute_ancestor_filter (const GtkWidgetPath *path,
+                                                     guint                index)
+{
+  guint64 filter = 0;
+  guint i;
+
+  for (i = 0; i < index; i++)
+    {
+      const char *name;
+      const GQuark *classes;
+      guint j, n_classes;
+
+      name = gtk_widget_path_iter_get_object_name (path, i);
+      if (name == NULL)
+        name = g_type_name (gtk_widget_path_iter_get_object_type (path, i));
+      filter |= _gtk_css_bloom_hash_interned (name);
+
+      name = gtk_widget_path_iter_get_name (path, i);
+      if (name)
+        filter |= _gtk_css_bloom_hash_interned (name);
+
+      classes = gtk_widget_path_iter_get_qclasses (path, i, &n_classes);
+      for (j = 0; j < n_classes; j++)
+        filter |= _gtk_css_bloom_hash_quark (classes[j]);
+    }
+
+  return filter;
+}
+
 static gboolean
 gtk_css_matcher_widget_path_get_parent (GtkCssMatcher       *matcher,
                                         const GtkCssMatcher *child)
@@ -37,6 +67,7 @@ gtk_css_matcher_widget_path_get_parent (GtkCssMatcher       *matcher,
   matcher->path.path = child->path.path;
   matcher->path.index = child->path.index - 1;
   matcher->path.sibling_index = gtk_widget_path_iter_get_sibling_index (matcher->path.path, matcher->path.index);
+  matcher->path.ancestor_filter = gtk_css_matcher_widget_path_compute_ancestor_filter (matcher->path.path, matcher->path.index);
 
   return TRUE;
 }
@@ -53,6 +84,7 @@ gtk_css_matcher_widget_path_get_previous (GtkCssMatcher       *matcher,
   matcher->path.path = next->path.path;
   matcher->path.index = next->path.index;
   matcher->path.sibling_index = next->path.sibling_index - 1;
+  matcher->path.ancestor_filter = next->path.ancestor_filter;
 
   return TRUE;
 }
@@ -158,6 +190,12 @@ gtk_css_matcher_widget_path_has_position (const GtkCssMatcher *matcher,
   return x / a >= 0;
 }
 
+static guint64
+gtk_css_matcher_widget_path_get_ancestor_filter (const GtkCssMatcher *matcher)
+{
+  return matcher->path.ancestor_filter;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_WIDGET_PATH = {
   gtk_css_matcher_widget_path_get_parent,
   gtk_css_matcher_widget_path_get_previous,
@@ -166,6 +204,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_WIDGET_PATH = {
   gtk_css_matcher_widget_path_has_class,
   gtk_css_matcher_widget_path_has_id,
   gtk_css_matcher_widget_path_has_position,
+  gtk_css_matcher_widget_path_get_ancestor_filter,
   FALSE
 };
 
@@ -182,6 +221,7 @@ _gtk_css_matcher_init (GtkCssMatcher               *matcher,
   matcher->path.path = path;
   matcher->path.index = gtk_widget_path_length (path) - 1;
   matcher->path.sibling_index = gtk_widget_path_iter_get_sibling_index (path, matcher->path.index);
+  matcher->path.ancestor_filter = gtk_css_matcher_widget_path_compute_ancestor_filter (path, matcher->path.index);
 
   return TRUE;
 }
@@ -308,6 +348,12 @@ gtk_css_matcher_node_has_position (const GtkCssMatcher *matcher,
                                          a, b);
 }
 
+static guint64
+gtk_css_matcher_node_get_ancestor_filter (const GtkCssMatcher *matcher)
+{
+  return matcher->node.ancestor_filter;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_NODE = {
   gtk_css_matcher_node_get_parent,
   gtk_css_matcher_node_get_previous,
@@ -316,6 +362,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_NODE = {
   gtk_css_matcher_node_has_class,
   gtk_css_matcher_node_has_id,
   gtk_css_matcher_node_has_position,
+  gtk_css_matcher_node_get_ancestor_filter,
   FALSE
 };
 
@@ -325,6 +372,7 @@ _gtk_css_matcher_node_init (GtkCssMatcher *matcher,
 {
   matcher->node.klass = &GTK_CSS_MATCHER_NODE;
   matcher->node.node = node;
+  matcher->node.ancestor_filter = gtk_css_node_get_ancestor_filter (node);
 }
 
 /* GTK_CSS_MATCHER_WIDGET_ANY */
@@ -388,6 +436,14 @@ gtk_css_matcher_any_has_position (const GtkCssMatcher *matcher,
   return TRUE;
 }
 
+static guint64
+gtk_css_matcher_any_get_ancestor_filter (const GtkCssMatcher *matcher)
+{
+  /* The any matcher's parents match everything, so nothing
+   * may ever be rejected */
+  return G_MAXUINT64;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_ANY = {
   gtk_css_matcher_any_get_parent,
   gtk_css_matcher_any_get_previous,
@@ -396,6 +452,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_ANY = {
   gtk_css_matcher_any_has_class,
   gtk_css_matcher_any_has_id,
   gtk_css_matcher_any_has_position,
+  gtk_css_matcher_any_get_ancestor_filter,
   TRUE
 };
 
@@ -481,6 +538,13 @@ gtk_css_matcher_superset_has_position (const GtkCssMatcher *matcher,
     return TRUE;
 }
 
+static guint64
+gtk_css_matcher_superset_get_ancestor_filter (const GtkCssMatcher *matcher)
+{
+  /* The superset matcher's parent is the any matcher */
+  return G_MAXUINT64;
+}
+
 static const GtkCssMatcherClass GTK_CSS_MATCHER_SUPERSET = {
   gtk_css_matcher_superset_get_parent,
   gtk_css_matcher_superset_get_previous,
@@ -489,6 +553,7 @@ static const GtkCssMatcherClass GTK_CSS_MATCHER_SUPERSET = {
   gtk_css_matcher_superset_has_class,
   gtk_css_matcher_superset_has_id,
   gtk_css_matcher_superset_has_position,
+  gtk_css_matcher_superset_get_ancestor_filter,
   FALSE
 };
 
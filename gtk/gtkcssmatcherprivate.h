@@ -24,6 +24,37 @@
 
 G_BEGIN_DECLS
 
+/* Ancestor bloom filters: a 64-bit mask accumulating the names, ids
+ * and style classes along a node's parent chain, with 2 bits per
+ * value. Selectors with descendant combinators precompute the mask of
+ * values they require among the ancestors, so most of them can be
+ * rejected with an AND before walking the parent chain at all. False
+ * positives only cost the full match that would have run anyway.
+ */
+static inline guint64
+_gtk_css_bloom_hash (guint hash)
+{
+  return (G_GUINT64_CONSTANT (1) << (hash & 63))
+       | (G_GUINT64_CONSTANT (1) << ((hash >> 6) & 63));
+}
+
+/* All the values going into the filter are interned strings or quarks,
+ * so we can hash the pointer or quark value instead of the string
+ * contents. Multiply by Knuth's constant to mix the bits, since both
+ * aligned pointers and small sequential quarks cluster otherwise.
+ */
+static inline guint64
+_gtk_css_bloom_hash_interned (gconstpointer str)
+{
+  return _gtk_css_bloom_hash ((guint) (GPOINTER_TO_SIZE (str) >> 3) * 2654435761u);
+}
+
+static inline guint64
+_gtk_css_bloom_hash_quark (GQuark quark)
+{
+  return _gtk_css_bloom_hash ((guint) quark * 2654435761u);
+}
+
 typedef struct _GtkCssMatcherNode GtkCssMatcherNode;
 typedef struct _GtkCssMatcherSuperset GtkCssMatcherSuperset;
 typedef struct _GtkCssMatcherWidgetPath GtkCssMatcherWidgetPath;
@@ -46,6 +77,9 @@ struct _GtkCssMatcherClass {
                                                    gboolean               forward,
                                                    int                    a,
                                                    int                    b);
+  /* Bloom filter of names/ids/classes on the strict ancestors, or
+   * G_MAXUINT64 for matchers that cannot reject anything */
+  guint64         (* get_ancestor_filter)         (const GtkCssMatcher   *matcher);
   gboolean is_any;
 };
 
@@ -55,11 +89,13 @@ struct _GtkCssMatcherWidgetPath {
   const GtkWidgetPath      *path;
   guint                     index;
   guint                     sibling_index;
+  guint64                   ancestor_filter;
 };
 
 struct _GtkCssMatcherNode {
   const GtkCssMatcherClass *klass;
   GtkCssNode               *node;
+  guint64                   ancestor_filter;
 };
 
 struct _GtkCssMatcherSuperset {
@@ -136,6 +172,12 @@ _gtk_css_matcher_has_position (const GtkCssMatcher *matcher,
   return matcher->klass->has_position (matcher, forward, a, b);
 }
 
+static inline guint64
+_gtk_css_matcher_get_ancestor_filter (const GtkCssMatcher *matcher)
+{
+  return matcher->klass->get_ancestor_filter (matcher);
+}
+
 static inline gboolean
 _gtk_css_matcher_matches_any (const GtkCssMatcher *matcher)
 {
@@ -269,6 +269,24 @@ gtk_css_node_is_first_child (GtkCssNode *node)
   return TRUE;
 }
 
+/* Returns the 1-based position among visible siblings, ie what
+ * :nth-child selectors match against */
+static guint
+gtk_css_node_get_position (GtkCssNode *node)
+{
+  GtkCssNode *iter;
+  guint position = 1;
+
+  for (iter = node->previous_sibling;
+       iter != NULL;
+       iter = iter->previous_sibling)
+    {
+      if (iter->visible)
+        position++;
+    }
+  return position;
+}
+
 static gboolean
 gtk_css_node_is_last_child (GtkCssNode *node)
 {
@@ -320,7 +338,17 @@ lookup_in_global_parent_cache (GtkCssNode                  *node,
   node->cache = gtk_css_node_style_cache_lookup (parent->cache,
                                                  decl,
                                                  gtk_css_node_is_first_child (node),
-                                                 gtk_css_node_is_last_child (node));
+                                                 gtk_css_node_is_last_child (node),
+                                                 0);
+  if (node->cache == NULL)
+    {
+      /* Styles that depend on :nth-child are keyed by their position */
+      node->cache = gtk_css_node_style_cache_lookup (parent->cache,
+                                                     decl,
+                                                     gtk_css_node_is_first_child (node),
+                                                     gtk_css_node_is_last_child (node),
+                                                     gtk_css_node_get_position (node));
+    }
   if (node->cache == NULL)
     return NULL;
 
@@ -349,11 +377,14 @@ store_in_global_parent_cache (GtkCssNode                  *node,
                                                  (GtkCssNodeDeclaration *) decl,
                                                  gtk_css_node_is_first_child (node),
                                                  gtk_css_node_is_last_child (node),
+                                                 gtk_css_node_get_position (node),
                                                  style);
 }
 
 static GtkCssStyle *
-gtk_css_node_create_style (GtkCssNode *cssnode)
+gtk_css_node_create_style (GtkCssNode   *cssnode,
+                           GtkCssChange  change,
+                           GtkCssStyle  *old_style)
 {
   const GtkCssNodeDeclaration *decl;
   GtkCssMatcher matcher;
@@ -368,7 +399,18 @@ gtk_css_node_create_style (GtkCssNode *cssnode)
 
   parent = cssnode->parent ? cssnode->parent->style : NULL;
 
-  if (gtk_css_node_init_matcher (cssnode, &matcher))
+  if (old_style != NULL &&
+      (change & GTK_CSS_RADICAL_CHANGE & ~GTK_CSS_CHANGE_PARENT_STYLE) == 0 &&
+      (gtk_css_static_style_get_change (GTK_CSS_STATIC_STYLE (old_style)) & change) == 0)
+    {
+      /* Only the parent's style changed. That cannot change the
+       * matched rules, so just redo the cascade from the declarations
+       * the old style matched. */
+      style = gtk_css_static_style_new_update (GTK_CSS_STATIC_STYLE (old_style),
+                                               gtk_css_node_get_style_provider (cssnode),
+                                               parent);
+    }
+  else if (gtk_css_node_init_matcher (cssnode, &matcher))
     style = gtk_css_static_style_new_compute (gtk_css_node_get_style_provider (cssnode),
                                               &matcher,
                                               parent);
@@ -423,7 +465,7 @@ gtk_css_node_real_update_style (GtkCssNode   *cssnode,
     }
 
   if (gtk_css_style_needs_recreation (static_style, change))
-    new_static_style = gtk_css_node_create_style (cssnode);
+    new_static_style = gtk_css_node_create_style (cssnode, change, static_style);
   else
     new_static_style = g_object_ref (static_style);
 
@@ -998,20 +1040,31 @@ gtk_css_node_ensure_style (GtkCssNode *cssnode,
 
   if (cssnode->style_is_invalid)
     {
-      GtkCssStyle *new_style;
-
       if (cssnode->previous_sibling)
         gtk_css_node_ensure_style (cssnode->previous_sibling, current_time);
 
-      g_clear_pointer (&cssnode->cache, gtk_css_node_style_cache_unref);
+      /* The parent and the previous siblings have propagated their
+       * changes by now, so if we have no pending changes, nothing that
+       * our style depends on was touched and the style stays as it is.
+       */
+      if (cssnode->pending_changes)
+        {
+          GtkCssStyle *new_style;
+
+          g_clear_pointer (&cssnode->cache, gtk_css_node_style_cache_unref);
 
-      new_style = GTK_CSS_NODE_GET_CLASS (cssnode)->update_style (cssnode,
-                                                                  cssnode->pending_changes,
-                                                                  current_time,
-                                                                  cssnode->style);
+          new_style = GTK_CSS_NODE_GET_CLASS (cssnode)->update_style (cssnode,
+                                                                      cssnode->pending_changes,
+                                                                      current_time,
+                                                                      cssnode->style);
 
-      style_changed = gtk_css_node_set_style (cssnode, new_style);
-      g_object_unref (new_style);
+          style_changed = gtk_css_node_set_style (cssnode, new_style);
+          g_object_unref (new_style);
+        }
+      else
+        {
+          style_changed = FALSE;
+        }
     }
   else
     {
@@ -1330,6 +1383,15 @@ gtk_css_node_invalidate (GtkCssNode   *cssnode,
   gtk_css_node_invalidate_style (cssnode);
 }
 
+/* This walk is intentionally single-threaded, even though dirty
+ * subtrees look independent: computed styles depend on the previous
+ * siblings (sibling combinators), style computation goes through
+ * shared unlocked caches (the style cache, interned values, the
+ * selector tree), and the validate vfunc emits change notifications
+ * straight into widgets. Fanning subtrees out to a thread pool would
+ * require making all of that thread-safe first; keep the cost down by
+ * not invalidating nodes instead.
+ */
 static void
 gtk_css_node_validate_internal (GtkCssNode *cssnode,
                                 gint64      timestamp)
@@ -1374,6 +1436,38 @@ gtk_css_node_init_matcher (GtkCssNode     *cssnode,
   return GTK_CSS_NODE_GET_CLASS (cssnode)->init_matcher (cssnode, matcher);
 }
 
+/* Computes the bloom filter of names, ids and style classes found on
+ * the strict ancestors of @cssnode, which selector matching uses to
+ * quickly reject selectors with descendant combinators.
+ */
+guint64
+gtk_css_node_get_ancestor_filter (GtkCssNode *cssnode)
+{
+  guint64 filter = 0;
+  GtkCssNode *node;
+
+  for (node = cssnode->parent; node; node = node->parent)
+    {
+      const GQuark *classes;
+      const char *value;
+      guint i, n_classes;
+
+      value = gtk_css_node_get_name (node);
+      if (value)
+        filter |= _gtk_css_bloom_hash_interned (value);
+
+      value = gtk_css_node_get_id (node);
+      if (value)
+        filter |= _gtk_css_bloom_hash_interned (value);
+
+      classes = gtk_css_node_declaration_get_classes (node->decl, &n_classes);
+      for (i = 0; i < n_classes; i++)
+        filter |= _gtk_css_bloom_hash_quark (classes[i]);
+    }
+
+  return filter;
+}
+
 GtkWidgetPath *
 gtk_css_node_create_widget_path (GtkCssNode *cssnode)
 {
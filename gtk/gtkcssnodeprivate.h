@@ -157,6 +157,7 @@ void                    gtk_css_node_validate           (GtkCssNode            *
 
 gboolean                gtk_css_node_init_matcher       (GtkCssNode            *cssnode,
                                                          GtkCssMatcher         *matcher);
+guint64                 gtk_css_node_get_ancestor_filter(GtkCssNode            *cssnode);
 GtkWidgetPath *         gtk_css_node_create_widget_path (GtkCssNode            *cssnode);
 const GtkWidgetPath *   gtk_css_node_get_widget_path    (GtkCssNode            *cssnode);
 GtkStyleProvider *      gtk_css_node_get_style_provider (GtkCssNode            *cssnode);
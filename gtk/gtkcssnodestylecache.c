@@ -28,9 +28,14 @@ struct _GtkCssNodeStyleCache {
   GHashTable  *children;
 };
 
-#define UNPACK_DECLARATION(packed) ((GtkCssNodeDeclaration *) (GPOINTER_TO_SIZE (packed) & ~0x3))
-#define UNPACK_FLAGS(packed) (GPOINTER_TO_SIZE (packed) & 0x3)
-#define PACK(decl, first_child, last_child) GSIZE_TO_POINTER (GPOINTER_TO_SIZE (decl) | ((first_child) ? 0x2 : 0) | ((last_child) ? 0x1 : 0))
+typedef struct {
+  GtkCssNodeDeclaration *decl;
+  guint                  first_child : 1;
+  guint                  last_child : 1;
+  guint                  position; /* 1-based position among visible siblings
+                                      for styles that depend on :nth-child,
+                                      0 for position-independent styles */
+} GtkCssNodeStyleCacheKey;
 
 GtkCssNodeStyleCache *
 gtk_css_node_style_cache_new (GtkCssStyle *style)
@@ -102,37 +107,49 @@ may_be_stored_in_cache (GtkCssStyle *style)
   if (change & GTK_CSS_CHANGE_ANY_SIBLING)
     return FALSE;
 
-  /* Again, the cache is shared between all children of the parent.
-   * If the position is relevant, no child has the same style.
+  /* Styles that depend on the position from the start are keyed by
+   * that position, so equally positioned children still share. The
+   * position from the end changes whenever a sibling is appended,
+   * so those styles are not worth caching.
    */
-  if (change & (GTK_CSS_CHANGE_NTH_CHILD | GTK_CSS_CHANGE_NTH_LAST_CHILD))
+  if (change & GTK_CSS_CHANGE_NTH_LAST_CHILD)
     return FALSE;
 
   return TRUE;
 }
 
 static guint
-gtk_css_node_style_cache_decl_hash (gconstpointer item)
+gtk_css_node_style_cache_key_hash (gconstpointer item)
 {
-  return gtk_css_node_declaration_hash (UNPACK_DECLARATION (item)) << 2
-    | UNPACK_FLAGS (item);
+  const GtkCssNodeStyleCacheKey *key = item;
+
+  return (gtk_css_node_declaration_hash (key->decl) << 2
+          | key->first_child << 1 | key->last_child)
+    ^ key->position;
 }
 
 static gboolean
-gtk_css_node_style_cache_decl_equal (gconstpointer item1,
-                                     gconstpointer item2)
+gtk_css_node_style_cache_key_equal (gconstpointer item1,
+                                    gconstpointer item2)
 {
-  if (UNPACK_FLAGS (item1) != UNPACK_FLAGS (item2))
+  const GtkCssNodeStyleCacheKey *key1 = item1;
+  const GtkCssNodeStyleCacheKey *key2 = item2;
+
+  if (key1->first_child != key2->first_child ||
+      key1->last_child != key2->last_child ||
+      key1->position != key2->position)
     return FALSE;
 
-  return gtk_css_node_declaration_equal (UNPACK_DECLARATION (item1),
-                                         UNPACK_DECLARATION (item2));
+  return gtk_css_node_declaration_equal (key1->decl, key2->decl);
 }
 
 static void
-gtk_css_node_style_cache_decl_free (gpointer item)
+gtk_css_node_style_cache_key_free (gpointer item)
 {
-  gtk_css_node_declaration_unref (UNPACK_DECLARATION (item));
+  GtkCssNodeStyleCacheKey *key = item;
+
+  gtk_css_node_declaration_unref (key->decl);
+  g_slice_free (GtkCssNodeStyleCacheKey, key);
 }
 
 GtkCssNodeStyleCache *
@@ -140,23 +157,34 @@ gtk_css_node_style_cache_insert (GtkCssNodeStyleCache   *parent,
                                  GtkCssNodeDeclaration  *decl,
                                  gboolean                is_first,
                                  gboolean                is_last,
+                                 guint                   position,
                                  GtkCssStyle            *style)
 {
   GtkCssNodeStyleCache *result;
+  GtkCssNodeStyleCacheKey *key;
 
   if (!may_be_stored_in_cache (style))
     return NULL;
 
   if (parent->children == NULL)
-    parent->children = g_hash_table_new_full (gtk_css_node_style_cache_decl_hash,
-                                              gtk_css_node_style_cache_decl_equal,
-                                              gtk_css_node_style_cache_decl_free,
+    parent->children = g_hash_table_new_full (gtk_css_node_style_cache_key_hash,
+                                              gtk_css_node_style_cache_key_equal,
+                                              gtk_css_node_style_cache_key_free,
                                               (GDestroyNotify) gtk_css_node_style_cache_unref);
 
+  key = g_slice_new (GtkCssNodeStyleCacheKey);
+  key->decl = gtk_css_node_declaration_ref (decl);
+  key->first_child = is_first;
+  key->last_child = is_last;
+  if (gtk_css_static_style_get_change (GTK_CSS_STATIC_STYLE (style)) & GTK_CSS_CHANGE_NTH_CHILD)
+    key->position = position;
+  else
+    key->position = 0;
+
   result = gtk_css_node_style_cache_new (style);
 
   g_hash_table_insert (parent->children,
-                       PACK (gtk_css_node_declaration_ref (decl), is_first, is_last),
+                       key,
                        gtk_css_node_style_cache_ref (result));
 
   return result;
@@ -166,14 +194,21 @@ GtkCssNodeStyleCache *
 gtk_css_node_style_cache_lookup (GtkCssNodeStyleCache        *parent,
                                  const GtkCssNodeDeclaration *decl,
                                  gboolean                     is_first,
-                                 gboolean                     is_last)
+                                 gboolean                     is_last,
+                                 guint                        position)
 {
+  GtkCssNodeStyleCacheKey key;
   GtkCssNodeStyleCache *result;
 
   if (parent->children == NULL)
     return NULL;
 
-  result = g_hash_table_lookup (parent->children, PACK (decl, is_first, is_last));
+  key.decl = (GtkCssNodeDeclaration *) decl;
+  key.first_child = is_first;
+  key.last_child = is_last;
+  key.position = position;
+
+  result = g_hash_table_lookup (parent->children, &key);
   if (result == NULL)
     return NULL;
 
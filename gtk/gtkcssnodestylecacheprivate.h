@@ -35,11 +35,13 @@ GtkCssNodeStyleCache *  gtk_css_node_style_cache_insert         (GtkCssNodeStyle
                                                                  GtkCssNodeDeclaration  *decl,
                                                                  gboolean                is_first,
                                                                  gboolean                is_last,
+                                                                 guint                   position,
                                                                  GtkCssStyle            *style);
 GtkCssNodeStyleCache *  gtk_css_node_style_cache_lookup         (GtkCssNodeStyleCache        *parent,
                                                                  const GtkCssNodeDeclaration *decl,
                                                                  gboolean                     is_first,
-                                                                 gboolean                     is_last);
+                                                                 gboolean                     is_last,
+                                                                 guint                        position);
 
 G_END_DECLS
 
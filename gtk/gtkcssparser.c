@@ -315,6 +315,58 @@ _gtk_css_parser_try (GtkCssParser *parser,
   return TRUE;
 }
 
+/**
+ * _gtk_css_parser_try_keywords:
+ * @parser: the parser
+ * @keywords: the keywords to look for
+ * @n_keywords: the number of keywords
+ *
+ * Checks if the next token is an identifier equal to one of the
+ * @keywords and consumes it in that case. Unlike calling
+ * _gtk_css_parser_try() once per keyword this tokenizes the
+ * identifier only once and does not match keywords that are just a
+ * prefix of a longer identifier.
+ *
+ * Returns: the index of the matched keyword or -1
+ **/
+int
+_gtk_css_parser_try_keywords (GtkCssParser       *parser,
+                              const char * const *keywords,
+                              guint               n_keywords)
+{
+  const char *start;
+  char *ident;
+  guint i;
+
+  g_return_val_if_fail (GTK_IS_CSS_PARSER (parser), -1);
+  g_return_val_if_fail (keywords != NULL, -1);
+
+  start = parser->data;
+
+  ident = _gtk_css_parser_try_ident (parser, FALSE);
+  if (ident == NULL)
+    return -1;
+
+  for (i = 0; i < n_keywords; i++)
+    {
+      if (g_ascii_strcasecmp (ident, keywords[i]) == 0)
+        break;
+    }
+  g_free (ident);
+
+  if (i == n_keywords)
+    {
+      /* Identifiers cannot contain newlines, so this does not mess up
+       * the line bookkeeping. */
+      parser->data = start;
+      return -1;
+    }
+
+  _gtk_css_parser_skip_whitespace (parser);
+
+  return i;
+}
+
 static guint
 get_xdigit (char c)
 {
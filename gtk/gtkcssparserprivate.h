@@ -69,6 +69,9 @@ gboolean        _gtk_css_parser_is_string         (GtkCssParser          *parser
 gboolean        _gtk_css_parser_try               (GtkCssParser          *parser,
                                                    const char            *string,
                                                    gboolean               skip_whitespace);
+int             _gtk_css_parser_try_keywords      (GtkCssParser          *parser,
+                                                   const char * const    *keywords,
+                                                   guint                  n_keywords);
 char *          _gtk_css_parser_try_ident         (GtkCssParser          *parser,
                                                    gboolean               skip_whitespace);
 char *          _gtk_css_parser_try_name          (GtkCssParser          *parser,
@@ -108,6 +108,12 @@ struct _GtkCssScanner
   GSList *state;
 };
 
+typedef struct
+{
+  GFile *file;
+  guint64 mtime;
+} LoadedFile;
+
 struct _GtkCssProviderPrivate
 {
   GScanner *scanner;
@@ -119,6 +125,7 @@ struct _GtkCssProviderPrivate
   GtkCssSelectorTree *tree;
   GResource *resource;
   gchar *path;
+  GArray *loaded_files; /* LoadedFile, everything parsed into the rulesets */
 };
 
 enum {
@@ -425,6 +432,35 @@ gtk_css_scanner_pop_section (GtkCssScanner *scanner,
   scanner->section = parent;
 }
 
+static void
+loaded_file_clear (LoadedFile *loaded)
+{
+  g_object_unref (loaded->file);
+}
+
+static guint64
+gtk_css_provider_get_file_mtime (GFile *file)
+{
+  GFileInfo *info;
+  guint64 mtime;
+
+  info = g_file_query_info (file,
+                            G_FILE_ATTRIBUTE_TIME_MODIFIED ","
+                            G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC,
+                            G_FILE_QUERY_INFO_NONE,
+                            NULL,
+                            NULL);
+  if (info == NULL)
+    return 0;
+
+  mtime = g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED) * G_USEC_PER_SEC
+        + g_file_info_get_attribute_uint32 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+
+  g_object_unref (info);
+
+  return mtime;
+}
+
 static void
 gtk_css_provider_init (GtkCssProvider *css_provider)
 {
@@ -440,6 +476,9 @@ gtk_css_provider_init (GtkCssProvider *css_provider)
   priv->keyframes = g_hash_table_new_full (g_str_hash, g_str_equal,
                                            (GDestroyNotify) g_free,
                                            (GDestroyNotify) _gtk_css_keyframes_unref);
+
+  priv->loaded_files = g_array_new (FALSE, FALSE, sizeof (LoadedFile));
+  g_array_set_clear_func (priv->loaded_files, (GDestroyNotify) loaded_file_clear);
 }
 
 static void
@@ -653,6 +692,8 @@ gtk_css_provider_finalize (GObject *object)
 
   g_free (priv->path);
 
+  g_array_free (priv->loaded_files, TRUE);
+
   G_OBJECT_CLASS (gtk_css_provider_parent_class)->finalize (object);
 }
 
@@ -1387,6 +1428,25 @@ gtk_css_provider_load_internal (GtkCssProvider *css_provider,
 {
   GtkCssScanner *scanner;
   GBytes *bytes;
+  gint64 profile_start = 0;
+
+  if (parent == NULL)
+    {
+      profile_start = _gtk_profile_start ();
+      g_array_set_size (css_provider->priv->loaded_files, 0);
+    }
+
+  if (file != NULL)
+    {
+      LoadedFile loaded;
+
+      /* Record the file even when loading it fails, so that a file
+       * that appears later invalidates a skipped reload
+       */
+      loaded.file = g_object_ref (file);
+      loaded.mtime = gtk_css_provider_get_file_mtime (file);
+      g_array_append_val (css_provider->priv->loaded_files, loaded);
+    }
 
   if (text == NULL)
     {
@@ -1451,6 +1511,14 @@ gtk_css_provider_load_internal (GtkCssProvider *css_provider,
 
   if (bytes)
     g_bytes_unref (bytes);
+
+  if (parent == NULL && profile_start != 0)
+    {
+      char *path = file ? g_file_get_path (file) : NULL;
+
+      _gtk_profile_mark (profile_start, "css-parse", path);
+      g_free (path);
+    }
 }
 
 /**
@@ -1494,6 +1562,32 @@ gtk_css_provider_load_from_data (GtkCssProvider  *css_provider,
   gtk_style_provider_changed (GTK_STYLE_PROVIDER (css_provider));
 }
 
+/* Reparsing yields the same rulesets as long as the file and
+ * everything it imported are unchanged, so keep what we have.
+ * Reloading the same theme happens on every settings change.
+ */
+static gboolean
+gtk_css_provider_can_skip_reload (GtkCssProvider *css_provider,
+                                  GFile          *file)
+{
+  GtkCssProviderPrivate *priv = css_provider->priv;
+  guint i;
+
+  if (priv->loaded_files->len == 0 ||
+      !g_file_equal (g_array_index (priv->loaded_files, LoadedFile, 0).file, file))
+    return FALSE;
+
+  for (i = 0; i < priv->loaded_files->len; i++)
+    {
+      LoadedFile *loaded = &g_array_index (priv->loaded_files, LoadedFile, i);
+
+      if (gtk_css_provider_get_file_mtime (loaded->file) != loaded->mtime)
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
 /**
  * gtk_css_provider_load_from_file:
  * @css_provider: a #GtkCssProvider
@@ -1509,6 +1603,9 @@ gtk_css_provider_load_from_file (GtkCssProvider  *css_provider,
   g_return_if_fail (GTK_IS_CSS_PROVIDER (css_provider));
   g_return_if_fail (G_IS_FILE (file));
 
+  if (gtk_css_provider_can_skip_reload (css_provider, file))
+    return;
+
   gtk_css_provider_reset (css_provider);
 
   gtk_css_provider_load_internal (css_provider, NULL, file, NULL);
@@ -1516,6 +1613,118 @@ gtk_css_provider_load_from_file (GtkCssProvider  *css_provider,
   gtk_style_provider_changed (GTK_STYLE_PROVIDER (css_provider));
 }
 
+static void
+gtk_css_provider_load_bytes_cb (GObject      *source,
+                                GAsyncResult *result,
+                                gpointer      user_data)
+{
+  GTask *task = user_data;
+  GtkCssProvider *css_provider = g_task_get_source_object (task);
+  GFile *file = G_FILE (source);
+  GError *error = NULL;
+  GBytes *bytes;
+
+  bytes = g_file_load_bytes_finish (file, result, NULL, &error);
+
+  if (bytes == NULL &&
+      g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+      g_task_return_error (task, error);
+      g_object_unref (task);
+      return;
+    }
+  g_clear_error (&error);
+
+  gtk_css_provider_reset (css_provider);
+
+  if (bytes)
+    {
+      gtk_css_provider_load_internal (css_provider, NULL, file,
+                                      g_bytes_get_data (bytes, NULL));
+      g_bytes_unref (bytes);
+    }
+  else
+    {
+      /* Load again so the failure is reported via the parsing-error
+       * signal, just like gtk_css_provider_load_from_file() does.
+       */
+      gtk_css_provider_load_internal (css_provider, NULL, file, NULL);
+    }
+
+  gtk_style_provider_changed (GTK_STYLE_PROVIDER (css_provider));
+
+  g_task_return_boolean (task, TRUE);
+  g_object_unref (task);
+}
+
+/**
+ * gtk_css_provider_load_from_file_async:
+ * @css_provider: a #GtkCssProvider
+ * @file: #GFile pointing to a file to load
+ * @cancellable: (allow-none): a #GCancellable, or %NULL
+ * @callback: callback to call when the operation is finished
+ * @user_data: data to pass to @callback
+ *
+ * Asynchronously loads the data contained in @file into @css_provider,
+ * making it clear any previously loaded information.
+ *
+ * The file is read without blocking, so the frame clock keeps being
+ * serviced while a large stylesheet is loaded from slow media. The
+ * parsing itself and the resulting invalidation still happen in the
+ * thread-default main context once the data has arrived, as styles
+ * may only be modified from there.
+ **/
+void
+gtk_css_provider_load_from_file_async (GtkCssProvider      *css_provider,
+                                       GFile               *file,
+                                       GCancellable        *cancellable,
+                                       GAsyncReadyCallback  callback,
+                                       gpointer             user_data)
+{
+  GTask *task;
+
+  g_return_if_fail (GTK_IS_CSS_PROVIDER (css_provider));
+  g_return_if_fail (G_IS_FILE (file));
+
+  task = g_task_new (css_provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtk_css_provider_load_from_file_async);
+
+  if (gtk_css_provider_can_skip_reload (css_provider, file))
+    {
+      g_task_return_boolean (task, TRUE);
+      g_object_unref (task);
+      return;
+    }
+
+  g_file_load_bytes_async (file,
+                           cancellable,
+                           gtk_css_provider_load_bytes_cb,
+                           task);
+}
+
+/**
+ * gtk_css_provider_load_from_file_finish:
+ * @css_provider: a #GtkCssProvider
+ * @result: the #GAsyncResult
+ * @error: return location for an error
+ *
+ * Finishes an asynchronous load started with
+ * gtk_css_provider_load_from_file_async().
+ *
+ * Returns: %TRUE unless the operation was cancelled. Parse errors are
+ *     reported via #GtkCssProvider::parsing-error instead.
+ **/
+gboolean
+gtk_css_provider_load_from_file_finish (GtkCssProvider  *css_provider,
+                                        GAsyncResult    *result,
+                                        GError         **error)
+{
+  g_return_val_if_fail (GTK_IS_CSS_PROVIDER (css_provider), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, css_provider), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
 /**
  * gtk_css_provider_load_from_path:
  * @css_provider: a #GtkCssProvider
@@ -1735,7 +1944,10 @@ _gtk_css_provider_load_named (GtkCssProvider *provider,
   g_return_if_fail (GTK_IS_CSS_PROVIDER (provider));
   g_return_if_fail (name != NULL);
 
-  gtk_css_provider_reset (provider);
+  /* No reset here: the load functions do that themselves, and an early
+   * reset would throw away the rulesets that loading the same unchanged
+   * theme again could keep.
+   */
 
   /* try loading the resource for the theme. This is mostly meant for built-in
    * themes.
@@ -1770,9 +1982,24 @@ _gtk_css_provider_load_named (GtkCssProvider *provider,
 
       gtk_css_provider_load_from_path (provider, path);
 
-      /* Only set this after load, as load_from_path will clear it */
-      provider->priv->resource = resource;
-      provider->priv->path = dir;
+      if (provider->priv->path != NULL)
+        {
+          /* The theme was unchanged and got kept, along with its
+           * already registered resource
+           */
+          if (resource != NULL)
+            {
+              g_resources_unregister (resource);
+              g_resource_unref (resource);
+            }
+          g_free (dir);
+        }
+      else
+        {
+          /* Only set this after load, as load_from_path will clear it */
+          provider->priv->resource = resource;
+          provider->priv->path = dir;
+        }
 
       g_free (path);
     }
@@ -102,6 +102,18 @@ GDK_AVAILABLE_IN_ALL
 void             gtk_css_provider_load_from_file (GtkCssProvider  *css_provider,
                                                   GFile           *file);
 GDK_AVAILABLE_IN_ALL
+void             gtk_css_provider_load_from_file_async
+                                                 (GtkCssProvider      *css_provider,
+                                                  GFile               *file,
+                                                  GCancellable        *cancellable,
+                                                  GAsyncReadyCallback  callback,
+                                                  gpointer             user_data);
+GDK_AVAILABLE_IN_ALL
+gboolean         gtk_css_provider_load_from_file_finish
+                                                 (GtkCssProvider  *css_provider,
+                                                  GAsyncResult    *result,
+                                                  GError         **error);
+GDK_AVAILABLE_IN_ALL
 void             gtk_css_provider_load_from_path (GtkCssProvider  *css_provider,
                                                   const gchar     *path);
 
@@ -29,6 +29,17 @@
 # include <intrin.h>
 #endif
 
+#ifdef G_ENABLE_DEBUG
+/* Counters for GTK_DEBUG=css-stats; they are cheap enough to keep up
+ * to date unconditionally in debug builds and get printed at exit by
+ * _gtk_css_selector_stats_print() */
+static struct {
+  guint64 selectors_tested;
+  guint64 bloom_rejections;
+  guint64 matches;
+} match_stats;
+#endif
+
 typedef struct _GtkCssSelectorClass GtkCssSelectorClass;
 typedef gboolean (* GtkCssSelectorForeachFunc) (const GtkCssSelector *selector,
                                                 const GtkCssMatcher  *matcher,
@@ -107,6 +118,8 @@ struct _GtkCssSelectorTree
   gint32 previous_offset;
   gint32 sibling_offset;
   gint32 matches_offset; /* pointers that we return as matches if selector matches */
+  guint64 bloom; /* names/ids/classes required on the element or its ancestors
+                    for any match below this node */
 };
 
 static gboolean
@@ -161,6 +174,9 @@ gtk_css_selector_tree_found_match (const GtkCssSelectorTree  *tree,
   matches = gtk_css_selector_tree_get_matches (tree);
   if (matches)
     {
+#ifdef G_ENABLE_DEBUG
+      match_stats.matches++;
+#endif
       if (!*array)
         *array = g_ptr_array_sized_new (16);
 
@@ -580,7 +596,8 @@ match_name (const GtkCssSelector *selector,
 static guint
 hash_name (const GtkCssSelector *a)
 {
-  return g_str_hash (a->name.name);
+  /* interned, so hash the pointer like hash_id() does */
+  return GPOINTER_TO_UINT (a->name.name);
 }
 
 static int
@@ -1483,20 +1500,58 @@ gtk_css_selector_tree_match_foreach (const GtkCssSelector *selector,
 {
   const GtkCssSelectorTree *tree = (const GtkCssSelectorTree *) selector;
   const GtkCssSelectorTree *prev;
+  guint64 ancestor_filter;
+
+#ifdef G_ENABLE_DEBUG
+  match_stats.selectors_tested++;
+#endif
 
   if (!gtk_css_selector_match (selector, matcher))
     return FALSE;
 
   gtk_css_selector_tree_found_match (tree, res);
 
+  ancestor_filter = _gtk_css_matcher_get_ancestor_filter (matcher);
+
   for (prev = gtk_css_selector_tree_get_previous (tree);
        prev != NULL;
        prev = gtk_css_selector_tree_get_sibling (prev))
-    gtk_css_selector_foreach (&prev->selector, matcher, gtk_css_selector_tree_match_foreach, res);
+    {
+      /* Combinators that cross over to the ancestors can be rejected
+         without walking the parent chain when the ancestors don't have
+         all the names, ids and classes the subtree requires */
+      if ((prev->selector.class == &GTK_CSS_SELECTOR_DESCENDANT ||
+           prev->selector.class == &GTK_CSS_SELECTOR_CHILD) &&
+          (prev->bloom & ancestor_filter) != prev->bloom)
+        {
+#ifdef G_ENABLE_DEBUG
+          match_stats.bloom_rejections++;
+#endif
+          continue;
+        }
+
+      gtk_css_selector_foreach (&prev->selector, matcher, gtk_css_selector_tree_match_foreach, res);
+    }
 
   return FALSE;
 }
 
+#ifdef G_ENABLE_DEBUG
+void
+_gtk_css_selector_stats_print (void)
+{
+  g_printerr ("css selector stats: %" G_GUINT64_FORMAT " selectors tested, "
+              "%" G_GUINT64_FORMAT " subtrees bloom-rejected, "
+              "%" G_GUINT64_FORMAT " rules matched (%.1f tests per match)\n",
+              match_stats.selectors_tested,
+              match_stats.bloom_rejections,
+              match_stats.matches,
+              match_stats.matches > 0
+                ? (double) match_stats.selectors_tested / match_stats.matches
+                : 0.0);
+}
+#endif
+
 GPtrArray *
 _gtk_css_selector_tree_match_all (const GtkCssSelectorTree *tree,
 				  const GtkCssMatcher *matcher)
@@ -1861,6 +1916,58 @@ fixup_offsets (GtkCssSelectorTree *tree, guint8 *data)
     }
 }
 
+static guint64
+gtk_css_selector_get_bloom (const GtkCssSelector *selector)
+{
+  if (selector->class == &GTK_CSS_SELECTOR_NAME)
+    return _gtk_css_bloom_hash_interned (selector->name.name);
+
+  if (selector->class == &GTK_CSS_SELECTOR_CLASS)
+    return _gtk_css_bloom_hash_quark (selector->style_class.style_class);
+
+  if (selector->class == &GTK_CSS_SELECTOR_ID)
+    return _gtk_css_bloom_hash_interned (selector->id.name);
+
+  /* :not(), states, positions and combinators guarantee nothing
+     about the element itself */
+  return 0;
+}
+
+/* Precompute the required ancestor values used for fast rejection during
+   matching. A match below a tree node can only succeed if the element or
+   its ancestors carry all the values in the node's bloom filter, so a
+   value is known to be required when every branch requires it. Sibling
+   combinators cross over to elements that are not ancestors, so nothing
+   can be required through them. */
+static void
+compute_blooms (GtkCssSelectorTree *tree)
+{
+  while (tree != NULL)
+    {
+      GtkCssSelectorTree *prev;
+
+      tree->bloom = gtk_css_selector_get_bloom (&tree->selector);
+
+      prev = (GtkCssSelectorTree *)gtk_css_selector_tree_get_previous (tree);
+      if (prev != NULL)
+	{
+	  guint64 required = G_MAXUINT64;
+
+	  compute_blooms (prev);
+
+	  for (; prev != NULL;
+	       prev = (GtkCssSelectorTree *)gtk_css_selector_tree_get_sibling (prev))
+	    required &= prev->bloom;
+
+	  if (tree->selector.class != &GTK_CSS_SELECTOR_SIBLING &&
+	      tree->selector.class != &GTK_CSS_SELECTOR_ADJACENT)
+	    tree->bloom |= required;
+	}
+
+      tree = (GtkCssSelectorTree *)gtk_css_selector_tree_get_sibling (tree);
+    }
+}
+
 GtkCssSelectorTree *
 _gtk_css_selector_tree_builder_build (GtkCssSelectorTreeBuilder *builder)
 {
@@ -1884,6 +1991,8 @@ _gtk_css_selector_tree_builder_build (GtkCssSelectorTreeBuilder *builder)
 
   fixup_offsets (tree, data);
 
+  compute_blooms (tree);
+
   /* Convert offsets to final pointers */
   for (l = builder->infos; l != NULL; l = l->next)
     {
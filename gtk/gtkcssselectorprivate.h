@@ -59,6 +59,10 @@ void                       _gtk_css_selector_tree_builder_free  (GtkCssSelectorT
 
 const char *gtk_css_pseudoclass_name (GtkStateFlags flags);
 
+#ifdef G_ENABLE_DEBUG
+void         _gtk_css_selector_stats_print           (void);
+#endif
+
 G_END_DECLS
 
 #endif /* __GTK_CSS_SELECTOR_PRIVATE_H__ */
@@ -32,6 +32,7 @@
 #include "gtkcssstringvalueprivate.h"
 #include "gtkcssstylepropertyprivate.h"
 #include "gtkcsstransitionprivate.h"
+#include "gtkmemoryaccountingprivate.h"
 #include "gtkprivate.h"
 #include "gtkintl.h"
 #include "gtksettings.h"
@@ -80,10 +81,23 @@ gtk_css_static_style_dispose (GObject *object)
       g_ptr_array_unref (style->sections);
       style->sections = NULL;
     }
+  if (style->matched)
+    {
+      g_array_unref (style->matched);
+      style->matched = NULL;
+    }
 
   G_OBJECT_CLASS (gtk_css_static_style_parent_class)->dispose (object);
 }
 
+static void
+gtk_css_static_style_finalize (GObject *object)
+{
+  gtk_memory_accounting_remove_instance (object);
+
+  G_OBJECT_CLASS (gtk_css_static_style_parent_class)->finalize (object);
+}
+
 static void
 gtk_css_static_style_class_init (GtkCssStaticStyleClass *klass)
 {
@@ -91,6 +105,7 @@ gtk_css_static_style_class_init (GtkCssStaticStyleClass *klass)
   GtkCssStyleClass *style_class = GTK_CSS_STYLE_CLASS (klass);
 
   object_class->dispose = gtk_css_static_style_dispose;
+  object_class->finalize = gtk_css_static_style_finalize;
 
   style_class->get_value = gtk_css_static_style_get_value;
   style_class->get_section = gtk_css_static_style_get_section;
@@ -99,6 +114,7 @@ gtk_css_static_style_class_init (GtkCssStaticStyleClass *klass)
 static void
 gtk_css_static_style_init (GtkCssStaticStyle *style)
 {
+  gtk_memory_accounting_add_instance (style);
 }
 
 static void
@@ -166,6 +182,16 @@ gtk_css_static_style_get_default (void)
   return default_style;
 }
 
+static void
+clear_matched_declaration (gpointer data)
+{
+  GtkCssStaticStyleDeclaration *decl = data;
+
+  _gtk_css_value_unref (decl->value);
+  if (decl->section)
+    gtk_css_section_unref (decl->section);
+}
+
 GtkCssStyle *
 gtk_css_static_style_new_compute (GtkStyleProvider    *provider,
                                   const GtkCssMatcher *matcher,
@@ -174,6 +200,7 @@ gtk_css_static_style_new_compute (GtkStyleProvider    *provider,
   GtkCssStaticStyle *result;
   GtkCssLookup lookup;
   GtkCssChange change = GTK_CSS_CHANGE_ANY_SELF | GTK_CSS_CHANGE_ANY_SIBLING | GTK_CSS_CHANGE_ANY_PARENT;
+  guint i;
 
   _gtk_css_lookup_init (&lookup, NULL);
 
@@ -187,6 +214,60 @@ gtk_css_static_style_new_compute (GtkStyleProvider    *provider,
 
   result->change = change;
 
+  /* Keep the winning declarations around, so that
+   * gtk_css_static_style_new_update() can redo the cascade without
+   * doing the selector matching again.
+   */
+  result->matched = g_array_new (FALSE, FALSE, sizeof (GtkCssStaticStyleDeclaration));
+  g_array_set_clear_func (result->matched, clear_matched_declaration);
+  for (i = 0; i < GTK_CSS_PROPERTY_N_PROPERTIES; i++)
+    {
+      GtkCssStaticStyleDeclaration decl;
+
+      if (lookup.values[i].value == NULL)
+        continue;
+
+      decl.id = i;
+      decl.section = lookup.values[i].section ? gtk_css_section_ref (lookup.values[i].section) : NULL;
+      decl.value = _gtk_css_value_ref (lookup.values[i].value);
+      g_array_append_val (result->matched, decl);
+    }
+
+  _gtk_css_lookup_resolve (&lookup,
+                           provider,
+                           result,
+                           parent);
+
+  _gtk_css_lookup_destroy (&lookup);
+
+  return GTK_CSS_STYLE (result);
+}
+
+GtkCssStyle *
+gtk_css_static_style_new_update (GtkCssStaticStyle *style,
+                                 GtkStyleProvider  *provider,
+                                 GtkCssStyle       *parent)
+{
+  GtkCssStaticStyle *result;
+  GtkCssLookup lookup;
+  guint i;
+
+  gtk_internal_return_val_if_fail (GTK_IS_CSS_STATIC_STYLE (style), NULL);
+
+  _gtk_css_lookup_init (&lookup, NULL);
+
+  for (i = 0; i < style->matched->len; i++)
+    {
+      const GtkCssStaticStyleDeclaration *decl = &g_array_index (style->matched, GtkCssStaticStyleDeclaration, i);
+
+      _gtk_css_lookup_set (&lookup, decl->id, decl->section, decl->value);
+    }
+
+  result = g_object_new (GTK_TYPE_CSS_STATIC_STYLE, NULL);
+
+  result->change = style->change;
+  result->matched = g_array_ref (style->matched);
+
   _gtk_css_lookup_resolve (&lookup,
                            provider,
                            result,
@@ -35,6 +35,13 @@ G_BEGIN_DECLS
 typedef struct _GtkCssStaticStyle           GtkCssStaticStyle;
 typedef struct _GtkCssStaticStyleClass      GtkCssStaticStyleClass;
 
+/* A winning declaration from the value lookup */
+typedef struct {
+  guint                  id;
+  GtkCssSection         *section;
+  GtkCssValue           *value;
+} GtkCssStaticStyleDeclaration;
+
 struct _GtkCssStaticStyle
 {
   GtkCssStyle parent;
@@ -43,6 +50,8 @@ struct _GtkCssStaticStyle
   GPtrArray             *sections;             /* sections the values are defined in */
 
   GtkCssChange           change;               /* change as returned by value lookup */
+  GArray                *matched;              /* the winning declarations, so the cascade
+                                                  can be redone without selector matching */
 };
 
 struct _GtkCssStaticStyleClass
@@ -56,6 +65,9 @@ GtkCssStyle *           gtk_css_static_style_get_default        (void);
 GtkCssStyle *           gtk_css_static_style_new_compute        (GtkStyleProvider       *provider,
                                                                  const GtkCssMatcher    *matcher,
                                                                  GtkCssStyle            *parent);
+GtkCssStyle *           gtk_css_static_style_new_update         (GtkCssStaticStyle      *style,
+                                                                 GtkStyleProvider       *provider,
+                                                                 GtkCssStyle            *parent);
 
 void                    gtk_css_static_style_compute_value      (GtkCssStaticStyle      *style,
                                                                  GtkStyleProvider       *provider,
@@ -26,44 +26,40 @@
 
 G_DEFINE_TYPE (GtkCssTransition, _gtk_css_transition, GTK_TYPE_STYLE_ANIMATION)
 
-static GtkStyleAnimation *
-gtk_css_transition_advance (GtkStyleAnimation    *style_animation,
-                           gint64                timestamp)
+/* Transitions are immutable and shared by all the frames of an
+ * animation, so the tracker stored in the transition stays at the
+ * creation time. Queries for a later time advance a copy of it.
+ */
+static void
+gtk_css_transition_get_tracker (GtkCssTransition   *transition,
+                                gint64              at_time_us,
+                                GtkProgressTracker *tracker)
 {
-  GtkCssTransition *source = GTK_CSS_TRANSITION (style_animation);
-
-  GtkCssTransition *transition;
-
-  transition = g_object_new (GTK_TYPE_CSS_TRANSITION, NULL);
-
-  transition->property = source->property;
-  transition->start = _gtk_css_value_ref (source->start);
-  transition->ease = _gtk_css_value_ref (source->ease);
-
-  gtk_progress_tracker_init_copy (&source->tracker, &transition->tracker);
-  gtk_progress_tracker_advance_frame (&transition->tracker, timestamp);
-
-  return GTK_STYLE_ANIMATION (transition);
+  gtk_progress_tracker_init_copy (&transition->tracker, tracker);
+  gtk_progress_tracker_advance_frame (tracker, at_time_us);
 }
 
 static void
 gtk_css_transition_apply_values (GtkStyleAnimation   *style_animation,
+                                 gint64               for_time_us,
                                  GtkCssAnimatedStyle *style)
 {
   GtkCssTransition *transition = GTK_CSS_TRANSITION (style_animation);
   GtkCssValue *value, *end;
   double progress;
+  GtkProgressTracker tracker;
   GtkProgressState state;
 
   end = gtk_css_animated_style_get_intrinsic_value (style, transition->property);
 
-  state = gtk_progress_tracker_get_state (&transition->tracker);
+  gtk_css_transition_get_tracker (transition, for_time_us, &tracker);
+  state = gtk_progress_tracker_get_state (&tracker);
 
   if (state == GTK_PROGRESS_STATE_BEFORE)
     value = _gtk_css_value_ref (transition->start);
   else if (state == GTK_PROGRESS_STATE_DURING)
     {
-      progress = gtk_progress_tracker_get_progress (&transition->tracker, FALSE);
+      progress = gtk_progress_tracker_get_progress (&tracker, FALSE);
       progress = _gtk_css_ease_value_transform (transition->ease, progress);
 
       value = _gtk_css_value_transition (transition->start,
@@ -82,19 +78,27 @@ gtk_css_transition_apply_values (GtkStyleAnimation   *style_animation,
 }
 
 static gboolean
-gtk_css_transition_is_finished (GtkStyleAnimation *animation)
+gtk_css_transition_is_finished (GtkStyleAnimation *animation,
+                                gint64             at_time_us)
 {
   GtkCssTransition *transition = GTK_CSS_TRANSITION (animation);
+  GtkProgressTracker tracker;
+
+  gtk_css_transition_get_tracker (transition, at_time_us, &tracker);
 
-  return gtk_progress_tracker_get_state (&transition->tracker) == GTK_PROGRESS_STATE_AFTER;
+  return gtk_progress_tracker_get_state (&tracker) == GTK_PROGRESS_STATE_AFTER;
 }
 
 static gboolean
-gtk_css_transition_is_static (GtkStyleAnimation *animation)
+gtk_css_transition_is_static (GtkStyleAnimation *animation,
+                              gint64             at_time_us)
 {
   GtkCssTransition *transition = GTK_CSS_TRANSITION (animation);
+  GtkProgressTracker tracker;
+
+  gtk_css_transition_get_tracker (transition, at_time_us, &tracker);
 
-  return gtk_progress_tracker_get_state (&transition->tracker) == GTK_PROGRESS_STATE_AFTER;
+  return gtk_progress_tracker_get_state (&tracker) == GTK_PROGRESS_STATE_AFTER;
 }
 
 static void
@@ -116,7 +120,6 @@ _gtk_css_transition_class_init (GtkCssTransitionClass *klass)
 
   object_class->finalize = gtk_css_transition_finalize;
 
-  animation_class->advance = gtk_css_transition_advance;
   animation_class->apply_values = gtk_css_transition_apply_values;
   animation_class->is_finished = gtk_css_transition_is_finished;
   animation_class->is_static = gtk_css_transition_is_static;
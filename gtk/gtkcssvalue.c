@@ -141,6 +141,15 @@ _gtk_css_value_transition (GtkCssValue *start,
   if (start->class->transition != end->class->transition)
     return NULL;
 
+  /* Compound values (arrays, shadows, borders, ...) transition their
+   * components recursively, and most components of a transitioning
+   * value don't change at all. Top-level calls never take this path -
+   * transitions only get created for unequal endpoints - but for the
+   * recursive calls it replaces an allocation per component per frame
+   * with a comparison. */
+  if (_gtk_css_value_equal (start, end))
+    return _gtk_css_value_ref (start);
+
   return start->class->transition (start, end, property_id, progress);
 }
 
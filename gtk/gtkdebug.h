@@ -52,7 +52,9 @@ typedef enum {
   GTK_DEBUG_ACTIONS         = 1 << 14,
   GTK_DEBUG_RESIZE          = 1 << 15,
   GTK_DEBUG_LAYOUT          = 1 << 16,
-  GTK_DEBUG_SNAPSHOT        = 1 << 17
+  GTK_DEBUG_SNAPSHOT        = 1 << 17,
+  GTK_DEBUG_PROFILE         = 1 << 18,
+  GTK_DEBUG_CSS_STATS       = 1 << 19
 } GtkDebugFlag;
 
 #ifdef G_ENABLE_DEBUG
@@ -1116,6 +1116,7 @@ gtk_drag_set_icon_widget_internal (GdkDragContext *context,
       gtk_window_set_hardcoded_window (GTK_WINDOW (info->icon_window),
                                        gdk_drag_context_get_drag_window (context));
       gtk_widget_show (info->icon_window);
+      gdk_window_set_overlay_hint (gtk_widget_get_window (info->icon_window), TRUE);
     }
 
   if (gtk_bin_get_child (GTK_BIN (info->icon_window)))
@@ -70,6 +70,10 @@ struct _GtkEmojiChooser
   GtkGesture *body_multi_press;
 
   GVariant *data;
+  GVariantIter *populate_iter;
+  GtkWidget *populate_box;
+  guint populate_idle_id;
+  int base_emoji_width;
 
   GSettings *settings;
 };
@@ -92,7 +96,10 @@ gtk_emoji_chooser_finalize (GObject *object)
 {
   GtkEmojiChooser *chooser = GTK_EMOJI_CHOOSER (object);
 
-  g_variant_unref (chooser->data);
+  if (chooser->populate_idle_id)
+    g_source_remove (chooser->populate_idle_id);
+  g_clear_pointer (&chooser->populate_iter, g_variant_iter_free);
+  g_clear_pointer (&chooser->data, g_variant_unref);
   g_object_unref (chooser->settings);
 
   g_clear_object (&chooser->recent_long_press);
@@ -362,17 +369,35 @@ add_emoji (GtkWidget    *box,
   g_variant_unref (codes);
   p[0] = 0;
 
-  label = gtk_label_new ("🙂");
   attrs = pango_attr_list_new ();
   pango_attr_list_insert (attrs, pango_attr_scale_new (PANGO_SCALE_X_LARGE));
-  gtk_label_set_attributes (GTK_LABEL (label), attrs);
-  pango_attr_list_unref (attrs);
 
-  layout = gtk_label_get_layout (GTK_LABEL (label));
-  pango_layout_get_extents (layout, &rect, NULL);
-  width = rect.width;
+  /* The reference width only depends on the font, so measure it once
+   * per chooser instead of shaping an extra layout for every emoji.
+   */
+  if (chooser && chooser->base_emoji_width > 0)
+    {
+      width = chooser->base_emoji_width;
+
+      label = gtk_label_new (text);
+      gtk_label_set_attributes (GTK_LABEL (label), attrs);
+    }
+  else
+    {
+      label = gtk_label_new ("🙂");
+      gtk_label_set_attributes (GTK_LABEL (label), attrs);
+
+      layout = gtk_label_get_layout (GTK_LABEL (label));
+      pango_layout_get_extents (layout, &rect, NULL);
+      width = rect.width;
+
+      if (chooser)
+        chooser->base_emoji_width = width;
+
+      gtk_label_set_text (GTK_LABEL (label), text);
+    }
+  pango_attr_list_unref (attrs);
 
-  gtk_label_set_text (GTK_LABEL (label), text);
   layout = gtk_label_get_layout (GTK_LABEL (label));
   pango_layout_get_extents (layout, &rect, NULL);
 
@@ -398,47 +423,72 @@ add_emoji (GtkWidget    *box,
   gtk_flow_box_insert (GTK_FLOW_BOX (box), child, prepend ? 0 : -1);
 }
 
-static void
-populate_emoji_chooser (GtkEmojiChooser *chooser)
+/* Filling in all ~1500 emoji at once kept the popup from appearing for
+ * a noticeable time, so do it from an idle in small time slices; the
+ * sections fill in top to bottom while the chooser is already usable.
+ * The resource data itself is memory-mapped and GVariant parses it
+ * lazily, so only the items materialized so far are touched.
+ */
+#define POPULATE_TIME_SLICE 8000 /* microseconds */
+
+static gboolean
+populate_emoji_chooser (gpointer data)
 {
-  GBytes *bytes = NULL;
-  GVariantIter iter;
+  GtkEmojiChooser *chooser = data;
   GVariant *item;
-  GtkWidget *box;
+  guint64 start;
 
-  bytes = g_resources_lookup_data ("/org/gtk/libgtk/emoji/emoji.data", 0, NULL);
-  chooser->data = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE ("a(auss)"), bytes, TRUE));
+  start = g_get_monotonic_time ();
 
-  g_variant_iter_init (&iter, chooser->data);
-  box = chooser->people.box;
-  while ((item = g_variant_iter_next_value (&iter)))
+  if (!chooser->data)
+    {
+      GBytes *bytes;
+
+      bytes = g_resources_lookup_data ("/org/gtk/libgtk/emoji/emoji.data", 0, NULL);
+      chooser->data = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE ("a(auss)"), bytes, TRUE));
+      g_bytes_unref (bytes);
+    }
+
+  if (!chooser->populate_iter)
+    {
+      chooser->populate_iter = g_variant_iter_new (chooser->data);
+      chooser->populate_box = chooser->people.box;
+    }
+
+  while ((item = g_variant_iter_next_value (chooser->populate_iter)))
     {
       const char *name;
 
       g_variant_get_child (item, 1, "&s", &name);
 
       if (strcmp (name, chooser->body.first) == 0)
-        box = chooser->body.box;
+        chooser->populate_box = chooser->body.box;
       else if (strcmp (name, chooser->nature.first) == 0)
-        box = chooser->nature.box;
+        chooser->populate_box = chooser->nature.box;
       else if (strcmp (name, chooser->food.first) == 0)
-        box = chooser->food.box;
+        chooser->populate_box = chooser->food.box;
       else if (strcmp (name, chooser->travel.first) == 0)
-        box = chooser->travel.box;
+        chooser->populate_box = chooser->travel.box;
       else if (strcmp (name, chooser->activities.first) == 0)
-        box = chooser->activities.box;
+        chooser->populate_box = chooser->activities.box;
       else if (strcmp (name, chooser->objects.first) == 0)
-        box = chooser->objects.box;
+        chooser->populate_box = chooser->objects.box;
       else if (strcmp (name, chooser->symbols.first) == 0)
-        box = chooser->symbols.box;
+        chooser->populate_box = chooser->symbols.box;
       else if (strcmp (name, chooser->flags.first) == 0)
-        box = chooser->flags.box;
+        chooser->populate_box = chooser->flags.box;
 
-      add_emoji (box, FALSE, item, 0, chooser);
+      add_emoji (chooser->populate_box, FALSE, item, 0, chooser);
       g_variant_unref (item);
+
+      if (g_get_monotonic_time () > start + POPULATE_TIME_SLICE)
+        return G_SOURCE_CONTINUE;
     }
 
-  g_bytes_unref (bytes);
+  g_clear_pointer (&chooser->populate_iter, g_variant_iter_free);
+  chooser->populate_idle_id = 0;
+
+  return G_SOURCE_REMOVE;
 }
 
 static void
@@ -649,7 +699,8 @@ gtk_emoji_chooser_init (GtkEmojiChooser *chooser)
   setup_section (chooser, &chooser->symbols, "ATM sign", 0x2764);
   setup_section (chooser, &chooser->flags, "chequered flag", 0x1f3f4);
 
-  populate_emoji_chooser (chooser);
+  chooser->populate_idle_id = g_idle_add (populate_emoji_chooser, chooser);
+  g_source_set_name_by_id (chooser->populate_idle_id, "[gtk+] populate_emoji_chooser");
   populate_recent_section (chooser);
 
   /* We scroll to the top on show, so check the right button for the 1st time */
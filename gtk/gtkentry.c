@@ -252,6 +252,7 @@ struct _GtkEntryPrivate
 
   guint         activates_default       : 1;
   guint         cache_includes_preedit  : 1;
+  guint         cache_is_placeholder    : 1;
   guint         caps_lock_warning       : 1;
   guint         caps_lock_warning_shown : 1;
   guint         change_count            : 8;
@@ -570,6 +571,7 @@ static PangoLayout *gtk_entry_ensure_layout            (GtkEntry       *entry,
                                                         gboolean        include_preedit);
 static void         gtk_entry_reset_layout             (GtkEntry       *entry);
 static void         gtk_entry_recompute                (GtkEntry       *entry);
+static void         gtk_entry_recompute_text           (GtkEntry       *entry);
 static gint         gtk_entry_find_position            (GtkEntry       *entry,
 							gint            x);
 static void         gtk_entry_get_cursor_locations     (GtkEntry       *entry,
@@ -4640,7 +4642,6 @@ buffer_inserted_text (GtkEntryBuffer *buffer,
     selection_bound += n_chars;
 
   gtk_entry_set_positions (entry, current_pos, selection_bound);
-  gtk_entry_recompute (entry);
 
   /* Calculate the password hint if it needs to be displayed. */
   if (n_chars == 1 && !priv->visible)
@@ -4669,6 +4670,11 @@ buffer_inserted_text (GtkEntryBuffer *buffer,
           g_source_set_name_by_id (password_hint->source_id, "[gtk+] gtk_entry_remove_password_hint");
         }
     }
+
+  /* Refresh the layout after updating the password hint, so that the
+   * in-place fast path picks up the newly visible character.
+   */
+  gtk_entry_recompute_text (entry);
 }
 
 static void
@@ -4691,7 +4697,6 @@ buffer_deleted_text (GtkEntryBuffer *buffer,
     selection_bound -= MIN (selection_bound, end_pos) - position;
 
   gtk_entry_set_positions (entry, current_pos, selection_bound);
-  gtk_entry_recompute (entry);
 
   /* We might have deleted the selection */
   gtk_entry_update_primary_selection (entry);
@@ -4709,6 +4714,8 @@ buffer_deleted_text (GtkEntryBuffer *buffer,
           password_hint->position = -1;
         }
     }
+
+  gtk_entry_recompute_text (entry);
 }
 
 static void
@@ -5492,12 +5499,11 @@ update_im_cursor_location (GtkEntry *entry)
 }
 
 static void
-gtk_entry_recompute (GtkEntry *entry)
+gtk_entry_layout_changed (GtkEntry *entry)
 {
   GtkEntryPrivate *priv = entry->priv;
   GtkTextHandleMode handle_mode;
 
-  gtk_entry_reset_layout (entry);
   gtk_entry_check_cursor_blink (entry);
 
   gtk_entry_adjust_scroll (entry);
@@ -5515,6 +5521,14 @@ gtk_entry_recompute (GtkEntry *entry)
   gtk_widget_queue_draw (GTK_WIDGET (entry));
 }
 
+static void
+gtk_entry_recompute (GtkEntry *entry)
+{
+  gtk_entry_reset_layout (entry);
+  gtk_entry_layout_changed (entry);
+}
+
+
 static void
 gtk_entry_get_placeholder_text_color (GtkEntry   *entry,
                                       PangoColor *color)
@@ -5676,11 +5690,75 @@ gtk_entry_ensure_layout (GtkEntry *entry,
     {
       priv->cached_layout = gtk_entry_create_layout (entry, include_preedit);
       priv->cache_includes_preedit = include_preedit;
+      priv->cache_is_placeholder = show_placeholder_text (entry);
     }
 
   return priv->cached_layout;
 }
 
+/* Tries to refresh the retained layout in place after a buffer edit,
+ * keeping the layout object, its attributes and the resolved base
+ * direction.  Returns %FALSE when the layout has to be rebuilt from
+ * scratch instead.
+ */
+static gboolean
+gtk_entry_update_cached_layout (GtkEntry *entry)
+{
+  GtkEntryPrivate *priv = entry->priv;
+  gchar *display_text;
+  guint n_bytes;
+
+  if (!priv->cached_layout)
+    return FALSE;
+
+  /* Preedit text is interleaved with the display text, and the
+   * placeholder layout carries its own color and ellipsization;
+   * leave both to gtk_entry_create_layout().
+   */
+  if (priv->preedit_length > 0 || priv->cache_includes_preedit)
+    return FALSE;
+
+  if (priv->cache_is_placeholder || show_placeholder_text (entry))
+    return FALSE;
+
+  display_text = _gtk_entry_get_display_text (entry, 0, -1);
+  n_bytes = strlen (display_text);
+
+  /* Invisible display modes always resolve to a neutral base
+   * direction, so only normal display can flip with the text.
+   */
+  if (gtk_entry_get_display_mode (entry) == DISPLAY_NORMAL)
+    {
+      PangoDirection pango_dir = pango_find_base_dir (display_text, n_bytes);
+
+      if (pango_dir != PANGO_DIRECTION_NEUTRAL &&
+          pango_dir != priv->resolved_dir)
+        {
+          g_free (display_text);
+          return FALSE;
+        }
+    }
+
+  pango_layout_set_text (priv->cached_layout, display_text, n_bytes);
+  g_free (display_text);
+
+  return TRUE;
+}
+
+/* Like gtk_entry_recompute(), but only valid after buffer edits:
+ * everything that went into the layout besides the text itself is
+ * known to be unchanged, so ordinary typing skips recreating the
+ * layout and refetching the style attributes on every keystroke.
+ */
+static void
+gtk_entry_recompute_text (GtkEntry *entry)
+{
+  if (!gtk_entry_update_cached_layout (entry))
+    gtk_entry_reset_layout (entry);
+
+  gtk_entry_layout_changed (entry);
+}
+
 static void
 get_layout_position (GtkEntry *entry,
                      gint     *x,
@@ -135,6 +135,7 @@ static void     gtk_entry_completion_get_property        (GObject      *object,
                                                           GParamSpec   *pspec);
 static void     gtk_entry_completion_finalize            (GObject      *object);
 static void     gtk_entry_completion_dispose             (GObject      *object);
+static void     gtk_entry_completion_snapshot_invalidate (GtkEntryCompletion *completion);
 
 static gboolean gtk_entry_completion_visible_func        (GtkTreeModel       *model,
                                                           GtkTreeIter        *iter,
@@ -618,6 +619,7 @@ gtk_entry_completion_set_property (GObject      *object,
 
       case PROP_TEXT_COLUMN:
         priv->text_column = g_value_get_int (value);
+        gtk_entry_completion_snapshot_invalidate (completion);
         break;
 
       case PROP_INLINE_COMPLETION:
@@ -726,6 +728,8 @@ gtk_entry_completion_finalize (GObject *object)
   GtkEntryCompletion *completion = GTK_ENTRY_COMPLETION (object);
   GtkEntryCompletionPrivate *priv = completion->priv;
 
+  gtk_entry_completion_snapshot_invalidate (completion);
+
   g_free (priv->case_normalized_key);
   g_free (priv->completion_prefix);
 
@@ -794,6 +798,74 @@ gtk_entry_completion_get_area (GtkCellLayout *cell_layout)
   return priv->cell_area;
 }
 
+/* Folded snapshot
+ *
+ * Refiltering folds the text column of every row on each keystroke,
+ * which dominates typing latency on large models.  For the default
+ * match function the folded strings only depend on the model, so they
+ * are snapshotted once when a completion is first requested and reused
+ * until the model changes; refiltering then only runs strncmp() per
+ * row.  Custom match functions are opaque and keep the unsnapshotted
+ * path.
+ */
+static void
+gtk_entry_completion_snapshot_invalidate (GtkEntryCompletion *completion)
+{
+  if (completion->priv->folded_snapshot)
+    {
+      g_ptr_array_unref (completion->priv->folded_snapshot);
+      completion->priv->folded_snapshot = NULL;
+    }
+}
+
+static void
+gtk_entry_completion_snapshot_ensure (GtkEntryCompletion *completion)
+{
+  GtkEntryCompletionPrivate *priv = completion->priv;
+  GtkTreeModel *model;
+  GtkTreeIter iter;
+
+  if (priv->folded_snapshot != NULL)
+    return;
+
+  /* only the default match function folds the text column */
+  if (priv->match_func != NULL || priv->text_column < 0)
+    return;
+
+  model = gtk_tree_model_filter_get_model (priv->filter_model);
+
+  if (gtk_tree_model_get_column_type (model, priv->text_column) != G_TYPE_STRING)
+    return;
+
+  priv->folded_snapshot = g_ptr_array_new_with_free_func (g_free);
+
+  if (gtk_tree_model_get_iter_first (model, &iter))
+    {
+      do
+        {
+          gchar *item = NULL;
+          gchar *folded = NULL;
+
+          gtk_tree_model_get (model, &iter, priv->text_column, &item, -1);
+
+          if (item)
+            {
+              gchar *normalized = g_utf8_normalize (item, -1, G_NORMALIZE_ALL);
+
+              if (normalized)
+                {
+                  folded = g_utf8_casefold (normalized, -1);
+                  g_free (normalized);
+                }
+              g_free (item);
+            }
+
+          g_ptr_array_add (priv->folded_snapshot, folded);
+        }
+      while (gtk_tree_model_iter_next (model, &iter));
+    }
+}
+
 /* all those callbacks */
 static gboolean
 gtk_entry_completion_default_completion_func (GtkEntryCompletion *completion,
@@ -814,6 +886,31 @@ gtk_entry_completion_default_completion_func (GtkEntryCompletion *completion,
   g_return_val_if_fail (gtk_tree_model_get_column_type (model, completion->priv->text_column) == G_TYPE_STRING,
                         FALSE);
 
+  if (completion->priv->folded_snapshot)
+    {
+      GtkTreePath *path = gtk_tree_model_get_path (model, iter);
+
+      if (path != NULL)
+        {
+          if (gtk_tree_path_get_depth (path) == 1)
+            {
+              guint index = gtk_tree_path_get_indices (path)[0];
+              const gchar *folded;
+
+              gtk_tree_path_free (path);
+
+              if (index >= completion->priv->folded_snapshot->len)
+                return FALSE;
+
+              folded = g_ptr_array_index (completion->priv->folded_snapshot, index);
+
+              return folded != NULL && strncmp (key, folded, strlen (key)) == 0;
+            }
+
+          gtk_tree_path_free (path);
+        }
+    }
+
   gtk_tree_model_get (model, iter,
                       completion->priv->text_column, &item,
                       -1);
@@ -1056,6 +1153,12 @@ gtk_entry_completion_set_model (GtkEntryCompletion *completion,
   g_return_if_fail (GTK_IS_ENTRY_COMPLETION (completion));
   g_return_if_fail (model == NULL || GTK_IS_TREE_MODEL (model));
 
+  if (completion->priv->filter_model)
+    g_signal_handlers_disconnect_by_func (gtk_tree_model_filter_get_model (completion->priv->filter_model),
+                                          gtk_entry_completion_snapshot_invalidate,
+                                          completion);
+  gtk_entry_completion_snapshot_invalidate (completion);
+
   if (!model)
     {
       gtk_tree_view_set_model (GTK_TREE_VIEW (completion->priv->tree_view),
@@ -1073,6 +1176,19 @@ gtk_entry_completion_set_model (GtkEntryCompletion *completion,
                                           completion,
                                           NULL);
 
+  g_signal_connect_object (model, "row-changed",
+                           G_CALLBACK (gtk_entry_completion_snapshot_invalidate),
+                           completion, G_CONNECT_SWAPPED);
+  g_signal_connect_object (model, "row-inserted",
+                           G_CALLBACK (gtk_entry_completion_snapshot_invalidate),
+                           completion, G_CONNECT_SWAPPED);
+  g_signal_connect_object (model, "row-deleted",
+                           G_CALLBACK (gtk_entry_completion_snapshot_invalidate),
+                           completion, G_CONNECT_SWAPPED);
+  g_signal_connect_object (model, "rows-reordered",
+                           G_CALLBACK (gtk_entry_completion_snapshot_invalidate),
+                           completion, G_CONNECT_SWAPPED);
+
   gtk_tree_view_set_model (GTK_TREE_VIEW (completion->priv->tree_view),
                            GTK_TREE_MODEL (completion->priv->filter_model));
   g_object_unref (completion->priv->filter_model);
@@ -1200,6 +1316,8 @@ gtk_entry_completion_complete (GtkEntryCompletion *completion)
   completion->priv->case_normalized_key = g_utf8_casefold (tmp, -1);
   g_free (tmp);
 
+  gtk_entry_completion_snapshot_ensure (completion);
+
   gtk_tree_model_filter_refilter (completion->priv->filter_model);
 
   if (!gtk_tree_model_get_iter_first (GTK_TREE_MODEL (completion->priv->filter_model), &iter))
@@ -1333,6 +1451,7 @@ gtk_entry_completion_set_text_column (GtkEntryCompletion *completion,
     return;
 
   completion->priv->text_column = column;
+  gtk_entry_completion_snapshot_invalidate (completion);
 
   cell = gtk_cell_renderer_text_new ();
   gtk_cell_layout_pack_start (GTK_CELL_LAYOUT (completion),
@@ -47,6 +47,11 @@ struct _GtkEntryCompletionPrivate
 
   gchar *case_normalized_key;
 
+  /* folded text column of the model's toplevel rows, built lazily for
+   * the default match function; see gtk_entry_completion_complete()
+   */
+  GPtrArray *folded_snapshot;
+
   /* only used by GtkEntry when attached: */
   GtkWidget *popup_window;
   GtkWidget *vbox;
@@ -215,6 +215,11 @@ gtk_event_controller_handle_event (GtkEventController *controller,
 
   controller_class = GTK_EVENT_CONTROLLER_GET_CLASS (controller);
 
+  if (controller_class->event_mask != 0 &&
+      (controller_class->event_mask &
+       GTK_EVENT_CONTROLLER_EVENT_MASK (gdk_event_get_event_type (event))) == 0)
+    return retval;
+
   if (controller_class->filter_event (controller, event))
     return retval;
 
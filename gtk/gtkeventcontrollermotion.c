@@ -94,6 +94,10 @@ gtk_event_controller_motion_class_init (GtkEventControllerMotionClass *klass)
   GtkEventControllerClass *controller_class = GTK_EVENT_CONTROLLER_CLASS (klass);
 
   controller_class->handle_event = gtk_event_controller_motion_handle_event;
+  controller_class->event_mask =
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_ENTER_NOTIFY) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_LEAVE_NOTIFY) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_MOTION_NOTIFY);
 
   /**
    * GtkEventControllerMotion::enter:
@@ -42,7 +42,18 @@ struct _GtkEventControllerClass
    */
   gboolean (* filter_event) (GtkEventController *controller,
                              const GdkEvent     *event);
+
+  /* Mask of GdkEventTypes (as per GTK_EVENT_CONTROLLER_EVENT_MASK())
+   * the controller can possibly handle. Events of other types are
+   * rejected by gtk_event_controller_handle_event() without dispatching
+   * into the vfuncs above, which keeps widgets with many controllers
+   * cheap for unrelated events. 0 means every event must be offered.
+   */
+  guint64 event_mask;
+
   gpointer padding[10];
 };
 
+#define GTK_EVENT_CONTROLLER_EVENT_MASK(type) (G_GUINT64_CONSTANT (1) << (type))
+
 #endif /* __GTK_EVENT_CONTROLLER_PRIVATE_H__ */
@@ -179,6 +179,7 @@ struct _GtkFileSystemModel
   GtkTreeIterCompareFunc default_sort_func; /* default sort function */
   gpointer              default_sort_data; /* data to pass to default sort func */
   GDestroyNotify        default_sort_destroy; /* function to call to destroy default_sort_data */
+  guint                 n_sorted;       /* count of leading nodes (editable row included) known to be in sorted order */
 
   guint                 frozen;         /* number of times we're frozen */
 
@@ -766,6 +767,43 @@ compare_array_element (gconstpointer a, gconstpointer b, gpointer user_data)
   return data->func (GTK_TREE_MODEL (data->model), &itera, &iterb, data->data) * data->order;
 }
 
+/* Merges the sorted runs [1, middle) and [middle, len) of the files
+ * array into one sorted run. This is used while a directory is being
+ * loaded, where the bulk of the array is already in order and only the
+ * most recently added chunk of files is new: a linear merge is a lot
+ * cheaper than resorting everything for each chunk.
+ */
+static void
+merge_sorted_tail (GtkFileSystemModel *model,
+                   SortData           *data,
+                   guint               middle)
+{
+  gsize node_size = model->node_size;
+  guint8 *merged, *dest;
+  guint left = 1, right = middle;
+
+  merged = g_malloc ((model->files->len - 1) * node_size);
+  dest = merged;
+
+  while (left < middle && right < model->files->len)
+    {
+      if (compare_array_element (get_node (model, left),
+                                 get_node (model, right),
+                                 data) <= 0)
+        memcpy (dest, get_node (model, left++), node_size);
+      else
+        memcpy (dest, get_node (model, right++), node_size);
+      dest += node_size;
+    }
+  if (left < middle)
+    memcpy (dest, get_node (model, left), (middle - left) * node_size);
+  else if (right < model->files->len)
+    memcpy (dest, get_node (model, right), (model->files->len - right) * node_size);
+
+  memcpy (get_node (model, 1), merged, (model->files->len - 1) * node_size);
+  g_free (merged);
+}
+
 static void
 gtk_file_system_model_sort (GtkFileSystemModel *model)
 {
@@ -787,11 +825,24 @@ gtk_file_system_model_sort (GtkFileSystemModel *model)
       n_visible_rows = node_get_tree_row (model, model->files->len - 1) + 1;
       model->n_nodes_valid = 0;
       g_hash_table_remove_all (model->file_lookup);
-      g_qsort_with_data (get_node (model, 1), /* start at index 1; don't sort the editable row */
-                         model->files->len - 1,
-                         model->node_size,
-                         compare_array_element,
-                         &data);
+      if (model->n_sorted > 2 && model->n_sorted < model->files->len)
+        {
+          /* only a tail of files was appended since the last sort;
+           * sort it and merge it into the sorted bulk */
+          g_qsort_with_data (get_node (model, model->n_sorted),
+                             model->files->len - model->n_sorted,
+                             model->node_size,
+                             compare_array_element,
+                             &data);
+          merge_sorted_tail (model, &data, model->n_sorted);
+        }
+      else
+        g_qsort_with_data (get_node (model, 1), /* start at index 1; don't sort the editable row */
+                           model->files->len - 1,
+                           model->node_size,
+                           compare_array_element,
+                           &data);
+      model->n_sorted = model->files->len;
       g_assert (model->n_nodes_valid == 0);
       g_assert (g_hash_table_size (model->file_lookup) == 0);
       if (n_visible_rows)
@@ -829,7 +880,13 @@ gtk_file_system_model_sort (GtkFileSystemModel *model)
 static void
 gtk_file_system_model_sort_node (GtkFileSystemModel *model, guint node)
 {
-  /* FIXME: improve */
+  /* A node in the sorted bulk can move anywhere when its data changes,
+   * so force a full resort for those; freshly appended nodes are
+   * handled by the incremental tail merge in the sort function.
+   */
+  if (node < model->n_sorted)
+    model->n_sorted = 1;
+
   gtk_file_system_model_sort (model);
 }
 
@@ -888,6 +945,7 @@ gtk_file_system_model_set_sort_column_id (GtkTreeSortable  *sortable,
 
   gtk_tree_sortable_sort_column_changed (sortable);
 
+  model->n_sorted = 1;
   gtk_file_system_model_sort (model);
 }
 
@@ -905,7 +963,10 @@ gtk_file_system_model_set_sort_func (GtkTreeSortable        *sortable,
                                                      func, data, destroy);
 
   if (model->sort_column_id == sort_column_id)
-    gtk_file_system_model_sort (model);
+    {
+      model->n_sorted = 1;
+      gtk_file_system_model_sort (model);
+    }
 }
 
 static void
@@ -929,7 +990,10 @@ gtk_file_system_model_set_default_sort_func (GtkTreeSortable        *sortable,
   model->default_sort_destroy = destroy;
 
   if (model->sort_column_id == GTK_TREE_SORTABLE_DEFAULT_SORT_COLUMN_ID)
-    gtk_file_system_model_sort (model);
+    {
+      model->n_sorted = 1;
+      gtk_file_system_model_sort (model);
+    }
 }
 
 static gboolean
@@ -1173,7 +1237,7 @@ gtk_file_system_model_got_files (GObject *object, GAsyncResult *res, gpointer da
       g_list_free (files);
 
       g_file_enumerator_next_files_async (enumerator,
-					  g_file_is_native (model->dir) ? 50 * FILES_PER_QUERY : FILES_PER_QUERY,
+					  g_file_is_native (model->dir) ? 5 * FILES_PER_QUERY : FILES_PER_QUERY,
 					  IO_PRIORITY,
 					  model->cancellable,
 					  gtk_file_system_model_got_files,
@@ -1282,7 +1346,7 @@ gtk_file_system_model_got_enumerator (GObject *dir, GAsyncResult *res, gpointer
   else
     {
       g_file_enumerator_next_files_async (enumerator,
-                                          g_file_is_native (model->dir) ? 50 * FILES_PER_QUERY : FILES_PER_QUERY,
+                                          g_file_is_native (model->dir) ? 5 * FILES_PER_QUERY : FILES_PER_QUERY,
                                           IO_PRIORITY,
                                           model->cancellable,
                                           gtk_file_system_model_got_files,
@@ -1333,6 +1397,7 @@ gtk_file_system_model_set_n_columns (GtkFileSystemModel *model,
   /* add editable node at start */
   g_array_set_size (model->files, 1);
   memset (get_node (model, 0), 0, model->node_size);
+  model->n_sorted = 1;
 }
 
 static void
@@ -1899,6 +1964,8 @@ remove_file (GtkFileSystemModel *model,
   g_array_remove_index (model->files, id);
 
   /* We don't need to resort, as removing a row doesn't change the sorting order of the other rows */
+  if (id < model->n_sorted)
+    model->n_sorted--;
 
   if (was_visible)
     emit_row_deleted_for_row (model, row);
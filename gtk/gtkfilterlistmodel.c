@@ -0,0 +1,363 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkfilterlistmodel.h"
+
+#include "gtkintl.h"
+
+/**
+ * SECTION:gtkfilterlistmodel
+ * @title: GtkFilterListModel
+ * @short_description: A list model that filters its items
+ * @see_also: #GListModel
+ *
+ * #GtkFilterListModel is a list model that takes a list model and a
+ * filter function and presents only those items of the original model
+ * for which the filter function returns %TRUE.
+ *
+ * The model keeps track of which items of the original model are
+ * visible, so a change to the original model only causes the
+ * corresponding minimal #GListModel::items-changed emission on the
+ * filter model; unaffected items keep their positions and do not have
+ * to be rebound by consumers.
+ */
+
+struct _GtkFilterListModel
+{
+  GObject parent_instance;
+
+  GListModel *model;
+  GtkFilterListModelFilterFunc filter_func;
+  gpointer user_data;
+  GDestroyNotify user_destroy;
+
+  /* Positions in the child model of the items that match the filter,
+   * in ascending order
+   */
+  GArray *matches;
+};
+
+enum {
+  PROP_0,
+  PROP_MODEL,
+  NUM_PROPERTIES
+};
+
+static GParamSpec *properties[NUM_PROPERTIES] = { NULL, };
+
+static GType
+gtk_filter_list_model_get_item_type (GListModel *list)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (list);
+
+  if (self->model == NULL)
+    return G_TYPE_OBJECT;
+
+  return g_list_model_get_item_type (self->model);
+}
+
+static guint
+gtk_filter_list_model_get_n_items (GListModel *list)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (list);
+
+  return self->matches->len;
+}
+
+static gpointer
+gtk_filter_list_model_get_item (GListModel *list,
+                                guint       position)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (list);
+
+  if (position >= self->matches->len)
+    return NULL;
+
+  return g_list_model_get_item (self->model,
+                                g_array_index (self->matches, guint, position));
+}
+
+static void
+gtk_filter_list_model_model_init (GListModelInterface *iface)
+{
+  iface->get_item_type = gtk_filter_list_model_get_item_type;
+  iface->get_n_items = gtk_filter_list_model_get_n_items;
+  iface->get_item = gtk_filter_list_model_get_item;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GtkFilterListModel, gtk_filter_list_model, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL, gtk_filter_list_model_model_init))
+
+static gboolean
+gtk_filter_list_model_matches (GtkFilterListModel *self,
+                               guint               position)
+{
+  gpointer item;
+  gboolean visible;
+
+  if (self->filter_func == NULL)
+    return TRUE;
+
+  item = g_list_model_get_item (self->model, position);
+  visible = self->filter_func (item, self->user_data);
+  g_object_unref (item);
+
+  return visible;
+}
+
+static void
+gtk_filter_list_model_items_changed_cb (GListModel         *model,
+                                        guint               position,
+                                        guint               removed,
+                                        guint               added,
+                                        GtkFilterListModel *self)
+{
+  guint start, end, i, n_added;
+
+  /* Find the range of matches that falls into the changed region.
+   * The matches array is sorted, so everything before @start and
+   * after @end keeps its position in the filter model.
+   */
+  start = 0;
+  while (start < self->matches->len &&
+         g_array_index (self->matches, guint, start) < position)
+    start++;
+
+  end = start;
+  while (end < self->matches->len &&
+         g_array_index (self->matches, guint, end) < position + removed)
+    end++;
+
+  /* Shift the positions of the matches after the changed region */
+  for (i = end; i < self->matches->len; i++)
+    g_array_index (self->matches, guint, i) += added - removed;
+
+  g_array_remove_range (self->matches, start, end - start);
+
+  n_added = 0;
+  for (i = 0; i < added; i++)
+    {
+      guint child_position = position + i;
+
+      if (!gtk_filter_list_model_matches (self, child_position))
+        continue;
+
+      g_array_insert_val (self->matches, start + n_added, child_position);
+      n_added++;
+    }
+
+  if (end - start > 0 || n_added > 0)
+    g_list_model_items_changed (G_LIST_MODEL (self), start, end - start, n_added);
+}
+
+static void
+gtk_filter_list_model_refilter (GtkFilterListModel *self)
+{
+  guint n_before, n_items, i;
+
+  n_before = self->matches->len;
+  g_array_set_size (self->matches, 0);
+
+  n_items = self->model ? g_list_model_get_n_items (self->model) : 0;
+  for (i = 0; i < n_items; i++)
+    {
+      if (gtk_filter_list_model_matches (self, i))
+        g_array_append_val (self->matches, i);
+    }
+
+  if (n_before > 0 || self->matches->len > 0)
+    g_list_model_items_changed (G_LIST_MODEL (self), 0, n_before, self->matches->len);
+}
+
+static void
+gtk_filter_list_model_get_property (GObject     *object,
+                                    guint        prop_id,
+                                    GValue      *value,
+                                    GParamSpec  *pspec)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (object);
+
+  switch (prop_id)
+    {
+    case PROP_MODEL:
+      g_value_set_object (value, self->model);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+gtk_filter_list_model_clear_filter_func (GtkFilterListModel *self)
+{
+  if (self->user_destroy)
+    self->user_destroy (self->user_data);
+
+  self->filter_func = NULL;
+  self->user_data = NULL;
+  self->user_destroy = NULL;
+}
+
+static void
+gtk_filter_list_model_dispose (GObject *object)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (object);
+
+  if (self->model)
+    {
+      g_signal_handlers_disconnect_by_func (self->model,
+                                            gtk_filter_list_model_items_changed_cb,
+                                            self);
+      g_clear_object (&self->model);
+    }
+
+  gtk_filter_list_model_clear_filter_func (self);
+
+  G_OBJECT_CLASS (gtk_filter_list_model_parent_class)->dispose (object);
+}
+
+static void
+gtk_filter_list_model_finalize (GObject *object)
+{
+  GtkFilterListModel *self = GTK_FILTER_LIST_MODEL (object);
+
+  g_array_unref (self->matches);
+
+  G_OBJECT_CLASS (gtk_filter_list_model_parent_class)->finalize (object);
+}
+
+static void
+gtk_filter_list_model_class_init (GtkFilterListModelClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->get_property = gtk_filter_list_model_get_property;
+  gobject_class->dispose = gtk_filter_list_model_dispose;
+  gobject_class->finalize = gtk_filter_list_model_finalize;
+
+  /**
+   * GtkFilterListModel:model:
+   *
+   * The model being filtered
+   */
+  properties[PROP_MODEL] =
+      g_param_spec_object ("model",
+                           P_("Model"),
+                           P_("The model being filtered"),
+                           G_TYPE_LIST_MODEL,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
+}
+
+static void
+gtk_filter_list_model_init (GtkFilterListModel *self)
+{
+  self->matches = g_array_new (FALSE, FALSE, sizeof (guint));
+}
+
+/**
+ * gtk_filter_list_model_new:
+ * @model: (transfer none): the model to filter
+ * @filter_func: (allow-none): filter function or %NULL to not filter items
+ * @user_data: (closure): user data passed to @filter_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Creates a new #GtkFilterListModel that will filter @model using the given
+ * @filter_func.
+ *
+ * Returns: a new #GtkFilterListModel
+ */
+GtkFilterListModel *
+gtk_filter_list_model_new (GListModel                   *model,
+                           GtkFilterListModelFilterFunc  filter_func,
+                           gpointer                      user_data,
+                           GDestroyNotify                user_destroy)
+{
+  GtkFilterListModel *self;
+  guint n_items, i;
+
+  g_return_val_if_fail (G_IS_LIST_MODEL (model), NULL);
+
+  self = g_object_new (GTK_TYPE_FILTER_LIST_MODEL, NULL);
+
+  self->model = g_object_ref (model);
+  g_signal_connect (model, "items-changed",
+                    G_CALLBACK (gtk_filter_list_model_items_changed_cb), self);
+
+  self->filter_func = filter_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  n_items = g_list_model_get_n_items (model);
+  for (i = 0; i < n_items; i++)
+    {
+      if (gtk_filter_list_model_matches (self, i))
+        g_array_append_val (self->matches, i);
+    }
+
+  return self;
+}
+
+/**
+ * gtk_filter_list_model_set_filter_func:
+ * @self: a #GtkFilterListModel
+ * @filter_func: (allow-none): filter function or %NULL to not filter items
+ * @user_data: (closure): user data passed to @filter_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Sets the function used to filter items. The function will be called for
+ * every item and if it returns %TRUE the item is included in the model.
+ *
+ * All items are refiltered when this function is called.
+ */
+void
+gtk_filter_list_model_set_filter_func (GtkFilterListModel           *self,
+                                       GtkFilterListModelFilterFunc  filter_func,
+                                       gpointer                      user_data,
+                                       GDestroyNotify                user_destroy)
+{
+  g_return_if_fail (GTK_IS_FILTER_LIST_MODEL (self));
+
+  gtk_filter_list_model_clear_filter_func (self);
+
+  self->filter_func = filter_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  gtk_filter_list_model_refilter (self);
+}
+
+/**
+ * gtk_filter_list_model_get_model:
+ * @self: a #GtkFilterListModel
+ *
+ * Gets the model that is currently being filtered.
+ *
+ * Returns: (transfer none): The model that gets filtered
+ */
+GListModel *
+gtk_filter_list_model_get_model (GtkFilterListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_FILTER_LIST_MODEL (self), NULL);
+
+  return self->model;
+}
@@ -3778,12 +3778,24 @@ gtk_flow_box_bound_model_changed (GListModel *list,
   GtkFlowBoxPrivate *priv = BOX_PRIV (box);
   gint i;
 
-  while (removed--)
+  if (removed > 0)
     {
-      GtkFlowBoxChild *child;
+      GSequenceIter *iter;
+
+      /* With a bound model there is no sort function, so the sequence
+       * order matches the model order and we can walk it directly
+       * instead of looking up the same position for every removed item.
+       */
+      iter = g_sequence_get_iter_at_pos (priv->children, position);
+
+      while (removed--)
+        {
+          GtkWidget *child = g_sequence_get (iter);
 
-      child = gtk_flow_box_get_child_at_index (box, position);
-      gtk_widget_destroy (GTK_WIDGET (child));
+          /* Grab the next iter before the removal invalidates this one */
+          iter = g_sequence_iter_next (iter);
+          gtk_widget_destroy (child);
+        }
     }
 
   for (i = 0; i < added; i++)
@@ -4074,6 +4086,10 @@ gtk_flow_box_check_model_compat (GtkFlowBox *box)
  * Note that using a model is incompatible with the filtering and sorting
  * functionality in GtkFlowBox. When using a model, filtering and sorting
  * should be implemented by the model.
+ *
+ * A child widget is created for every item in @model up front. For very
+ * large data sets, bind a model that exposes only the currently
+ * relevant window of the data instead of the whole set.
  */
 void
 gtk_flow_box_bind_model (GtkFlowBox                 *box,
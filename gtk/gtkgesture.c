@@ -778,6 +778,17 @@ gtk_gesture_class_init (GtkGestureClass *klass)
 
   controller_class->filter_event = gtk_gesture_filter_event;
   controller_class->handle_event = gtk_gesture_handle_event;
+  controller_class->event_mask =
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_BUTTON_PRESS) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_BUTTON_RELEASE) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_MOTION_NOTIFY) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCH_BEGIN) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCH_UPDATE) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCH_END) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCH_CANCEL) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCHPAD_SWIPE) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_TOUCHPAD_PINCH) |
+    GTK_EVENT_CONTROLLER_EVENT_MASK (GDK_GRAB_BROKEN);
   controller_class->reset = gtk_gesture_reset;
 
   klass->check = gtk_gesture_check_impl;
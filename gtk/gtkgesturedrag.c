@@ -44,6 +44,10 @@ struct _GtkGestureDragPrivate
   gdouble start_y;
   gdouble last_x;
   gdouble last_y;
+
+  GtkGestureDragUpdateFunc update_func;
+  gpointer update_func_data;
+  GDestroyNotify update_func_destroy;
 };
 
 enum {
@@ -108,7 +112,21 @@ gtk_gesture_drag_update (GtkGesture       *gesture,
   x = priv->last_x - priv->start_x;
   y = priv->last_y - priv->start_y;
 
-  g_signal_emit (gesture, signals[DRAG_UPDATE], 0, x, y);
+  if (priv->update_func)
+    {
+      GtkGestureDragClass *klass = GTK_GESTURE_DRAG_GET_CLASS (gesture);
+
+      /* Fast path: invoke the class closure and the registered
+       * callback directly, skipping the GValue marshalling that
+       * g_signal_emit() would do for every pointer motion.
+       */
+      if (klass->drag_update)
+        klass->drag_update (GTK_GESTURE_DRAG (gesture), x, y);
+
+      priv->update_func (GTK_GESTURE_DRAG (gesture), x, y, priv->update_func_data);
+    }
+  else
+    g_signal_emit (gesture, signals[DRAG_UPDATE], 0, x, y);
 }
 
 static void
@@ -129,12 +147,28 @@ gtk_gesture_drag_end (GtkGesture       *gesture,
   g_signal_emit (gesture, signals[DRAG_END], 0, x, y);
 }
 
+static void
+gtk_gesture_drag_finalize (GObject *object)
+{
+  GtkGestureDragPrivate *priv;
+
+  priv = gtk_gesture_drag_get_instance_private (GTK_GESTURE_DRAG (object));
+
+  if (priv->update_func_destroy)
+    priv->update_func_destroy (priv->update_func_data);
+
+  G_OBJECT_CLASS (gtk_gesture_drag_parent_class)->finalize (object);
+}
+
 static void
 gtk_gesture_drag_class_init (GtkGestureDragClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkGestureClass *gesture_class = GTK_GESTURE_CLASS (klass);
   GtkEventControllerClass *event_controller_class = GTK_EVENT_CONTROLLER_CLASS (klass);
 
+  object_class->finalize = gtk_gesture_drag_finalize;
+
   event_controller_class->filter_event = gtk_gesture_drag_filter_event;
 
   gesture_class->begin = gtk_gesture_drag_begin;
@@ -211,6 +245,45 @@ gtk_gesture_drag_new (GtkWidget *widget)
                        NULL);
 }
 
+/**
+ * gtk_gesture_drag_set_update_func:
+ * @gesture: a #GtkGestureDrag
+ * @func: (nullable): the function to call on every drag update, or
+ *     %NULL to go back to signal emission
+ * @user_data: user data to pass to @func
+ * @destroy: (nullable): function to call on @user_data when it is
+ *     not needed anymore
+ *
+ * Registers a plain C callback that is invoked instead of emitting
+ * the #GtkGestureDrag::drag-update signal. The callback receives the
+ * same offsets the signal would carry, but without the per-emission
+ * GValue marshalling, which matters for high-frequency input like
+ * multitouch updates.
+ *
+ * While @func is set, ::drag-update is not emitted, so signal
+ * handlers connected to it do not run; class handlers of subclasses
+ * are still invoked.
+ **/
+void
+gtk_gesture_drag_set_update_func (GtkGestureDrag           *gesture,
+                                  GtkGestureDragUpdateFunc  func,
+                                  gpointer                  user_data,
+                                  GDestroyNotify            destroy)
+{
+  GtkGestureDragPrivate *priv;
+
+  g_return_if_fail (GTK_IS_GESTURE_DRAG (gesture));
+
+  priv = gtk_gesture_drag_get_instance_private (gesture);
+
+  if (priv->update_func_destroy)
+    priv->update_func_destroy (priv->update_func_data);
+
+  priv->update_func = func;
+  priv->update_func_data = user_data;
+  priv->update_func_destroy = destroy;
+}
+
 /**
  * gtk_gesture_drag_get_start_point:
  * @gesture: a #GtkGesture
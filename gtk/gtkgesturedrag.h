@@ -38,6 +38,21 @@ G_BEGIN_DECLS
 typedef struct _GtkGestureDrag GtkGestureDrag;
 typedef struct _GtkGestureDragClass GtkGestureDragClass;
 
+/**
+ * GtkGestureDragUpdateFunc:
+ * @gesture: the #GtkGestureDrag
+ * @offset_x: X offset, relative to the start point
+ * @offset_y: Y offset, relative to the start point
+ * @user_data: user data passed to gtk_gesture_drag_set_update_func()
+ *
+ * A callback invoked directly on drag updates in place of the
+ * #GtkGestureDrag::drag-update signal.
+ */
+typedef void (* GtkGestureDragUpdateFunc) (GtkGestureDrag *gesture,
+                                           gdouble         offset_x,
+                                           gdouble         offset_y,
+                                           gpointer        user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType        gtk_gesture_drag_get_type          (void) G_GNUC_CONST;
 
@@ -52,6 +67,11 @@ GDK_AVAILABLE_IN_ALL
 gboolean     gtk_gesture_drag_get_offset        (GtkGestureDrag *gesture,
                                                  gdouble        *x,
                                                  gdouble        *y);
+GDK_AVAILABLE_IN_ALL
+void         gtk_gesture_drag_set_update_func   (GtkGestureDrag           *gesture,
+                                                 GtkGestureDragUpdateFunc  func,
+                                                 gpointer                  user_data,
+                                                 GDestroyNotify            destroy);
 
 G_END_DECLS
 
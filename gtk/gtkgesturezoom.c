@@ -46,6 +46,10 @@ enum {
 struct _GtkGestureZoomPrivate
 {
   gdouble initial_distance;
+
+  GtkGestureZoomScaleChangedFunc scale_changed_func;
+  gpointer scale_changed_func_data;
+  GDestroyNotify scale_changed_func_destroy;
 };
 
 static guint signals[LAST_SIGNAL] = { 0 };
@@ -142,7 +146,22 @@ _gtk_gesture_zoom_check_emit (GtkGestureZoom *gesture)
     return FALSE;
 
   zoom = distance / priv->initial_distance;
-  g_signal_emit (gesture, signals[SCALE_CHANGED], 0, zoom);
+
+  if (priv->scale_changed_func)
+    {
+      GtkGestureZoomClass *klass = GTK_GESTURE_ZOOM_GET_CLASS (gesture);
+
+      /* Fast path: invoke the class closure and the registered
+       * callback directly, skipping the GValue marshalling that
+       * g_signal_emit() would do for every touch update.
+       */
+      if (klass->scale_changed)
+        klass->scale_changed (gesture, zoom);
+
+      priv->scale_changed_func (gesture, zoom, priv->scale_changed_func_data);
+    }
+  else
+    g_signal_emit (gesture, signals[SCALE_CHANGED], 0, zoom);
 
   return TRUE;
 }
@@ -185,6 +204,19 @@ gtk_gesture_zoom_update (GtkGesture       *gesture,
   _gtk_gesture_zoom_check_emit (GTK_GESTURE_ZOOM (gesture));
 }
 
+static void
+gtk_gesture_zoom_finalize (GObject *object)
+{
+  GtkGestureZoomPrivate *priv;
+
+  priv = gtk_gesture_zoom_get_instance_private (GTK_GESTURE_ZOOM (object));
+
+  if (priv->scale_changed_func_destroy)
+    priv->scale_changed_func_destroy (priv->scale_changed_func_data);
+
+  G_OBJECT_CLASS (gtk_gesture_zoom_parent_class)->finalize (object);
+}
+
 static void
 gtk_gesture_zoom_class_init (GtkGestureZoomClass *klass)
 {
@@ -193,6 +225,7 @@ gtk_gesture_zoom_class_init (GtkGestureZoomClass *klass)
   GtkGestureClass *gesture_class = GTK_GESTURE_CLASS (klass);
 
   object_class->constructor = gtk_gesture_zoom_constructor;
+  object_class->finalize = gtk_gesture_zoom_finalize;
 
   event_controller_class->filter_event = gtk_gesture_zoom_filter_event;
 
@@ -235,6 +268,45 @@ gtk_gesture_zoom_new (GtkWidget *widget)
                        NULL);
 }
 
+/**
+ * gtk_gesture_zoom_set_scale_changed_func:
+ * @gesture: a #GtkGestureZoom
+ * @func: (nullable): the function to call on every scale change, or
+ *     %NULL to go back to signal emission
+ * @user_data: user data to pass to @func
+ * @destroy: (nullable): function to call on @user_data when it is
+ *     not needed anymore
+ *
+ * Registers a plain C callback that is invoked instead of emitting
+ * the #GtkGestureZoom::scale-changed signal. The callback receives
+ * the same scale delta the signal would carry, but without the
+ * per-emission GValue marshalling, which matters for high-frequency
+ * input like multitouch updates.
+ *
+ * While @func is set, ::scale-changed is not emitted, so signal
+ * handlers connected to it do not run; class handlers of subclasses
+ * are still invoked.
+ **/
+void
+gtk_gesture_zoom_set_scale_changed_func (GtkGestureZoom                 *gesture,
+                                         GtkGestureZoomScaleChangedFunc  func,
+                                         gpointer                        user_data,
+                                         GDestroyNotify                  destroy)
+{
+  GtkGestureZoomPrivate *priv;
+
+  g_return_if_fail (GTK_IS_GESTURE_ZOOM (gesture));
+
+  priv = gtk_gesture_zoom_get_instance_private (gesture);
+
+  if (priv->scale_changed_func_destroy)
+    priv->scale_changed_func_destroy (priv->scale_changed_func_data);
+
+  priv->scale_changed_func = func;
+  priv->scale_changed_func_data = user_data;
+  priv->scale_changed_func_destroy = destroy;
+}
+
 /**
  * gtk_gesture_zoom_get_scale_delta:
  * @gesture: a #GtkGestureZoom
@@ -39,6 +39,19 @@ G_BEGIN_DECLS
 typedef struct _GtkGestureZoom GtkGestureZoom;
 typedef struct _GtkGestureZoomClass GtkGestureZoomClass;
 
+/**
+ * GtkGestureZoomScaleChangedFunc:
+ * @gesture: the #GtkGestureZoom
+ * @scale: Scale delta, taking the initial state as 1:1
+ * @user_data: user data passed to gtk_gesture_zoom_set_scale_changed_func()
+ *
+ * A callback invoked directly on scale changes in place of the
+ * #GtkGestureZoom::scale-changed signal.
+ */
+typedef void (* GtkGestureZoomScaleChangedFunc) (GtkGestureZoom *gesture,
+                                                 gdouble         scale,
+                                                 gpointer        user_data);
+
 GDK_AVAILABLE_IN_ALL
 GType        gtk_gesture_zoom_get_type        (void) G_GNUC_CONST;
 
@@ -47,6 +60,11 @@ GtkGesture * gtk_gesture_zoom_new             (GtkWidget      *widget);
 
 GDK_AVAILABLE_IN_ALL
 gdouble      gtk_gesture_zoom_get_scale_delta (GtkGestureZoom *gesture);
+GDK_AVAILABLE_IN_ALL
+void         gtk_gesture_zoom_set_scale_changed_func (GtkGestureZoom                 *gesture,
+                                                      GtkGestureZoomScaleChangedFunc  func,
+                                                      gpointer                        user_data,
+                                                      GDestroyNotify                  destroy);
 
 G_END_DECLS
 
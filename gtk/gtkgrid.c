@@ -673,6 +673,17 @@ compute_request_for_child (GtkGridRequest *request,
   if (natural_baseline)
     *natural_baseline = -1;
 
+  /* Only baseline-aligned children take part in the row baseline
+   * math; for everybody else the plain minimum/natural is all the
+   * lines need.
+   */
+  if (orientation != GTK_ORIENTATION_VERTICAL ||
+      gtk_widget_get_valign (child->widget) != GTK_ALIGN_BASELINE)
+    {
+      minimum_baseline = NULL;
+      natural_baseline = NULL;
+    }
+
   if (contextual)
     {
       gint size;
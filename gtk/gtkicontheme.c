@@ -28,6 +28,12 @@
 #include <glib.h>
 #include <glib/gstdio.h>
 
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 #ifdef G_OS_WIN32
 #ifndef S_ISDIR
 #define S_ISDIR(mode) ((mode)&_S_IFDIR)
@@ -231,9 +237,6 @@ struct _GtkIconInfo
   gdouble scale;
 
   SymbolicPixbufCache *symbolic_pixbuf_cache;
-
-  gint symbolic_width;
-  gint symbolic_height;
 };
 
 typedef struct
@@ -245,6 +248,13 @@ typedef struct
 
   /* In search order */
   GList *dirs;
+
+  /* The distinct caches covering the dirs above, and whether any
+   * dir is not covered by a cache; used to reject lookups for
+   * icons the theme cannot contain without probing every dir
+   */
+  GList *caches;
+  gboolean has_uncached_dirs;
 } IconTheme;
 
 typedef struct
@@ -313,6 +323,9 @@ static GtkIconInfo *icon_info_new             (IconThemeDirType  type,
                                                gint              dir_size,
                                                gint              dir_scale);
 static IconSuffix   suffix_from_name          (const gchar      *name);
+static const gchar *string_from_suffix        (IconSuffix        suffix);
+static IconSuffix   best_suffix               (IconSuffix        suffix,
+                                               gboolean          allow_svg);
 static void         remove_from_lru_cache     (GtkIconTheme     *icon_theme,
                                                GtkIconInfo      *icon_info);
 static gboolean     icon_info_ensure_scale_and_pixbuf (GtkIconInfo* icon_info);
@@ -1084,6 +1097,11 @@ insert_theme (GtkIconTheme *icon_theme,
       if (g_stat (path, &stat_buf) == 0 && S_ISDIR (stat_buf.st_mode)) {
         dir_mtime->mtime = stat_buf.st_mtime;
         dir_mtime->exists = TRUE;
+        /* Load the icon cache for this directory here, once; opening
+         * it lazily from theme_subdir_load () meant retrying a failed
+         * open for every subdir of a cacheless theme
+         */
+        dir_mtime->cache = gtk_icon_cache_new_for_path (path);
       } else {
         dir_mtime->mtime = 0;
         dir_mtime->exists = FALSE;
@@ -1403,8 +1421,12 @@ ensure_valid_themes (GtkIconTheme *icon_theme)
   
   if (!priv->themes_valid)
     {
+      gint64 profile_start = _gtk_profile_start ();
+
       load_themes (icon_theme);
 
+      _gtk_profile_mark (profile_start, "icon-theme-scan", priv->current_theme);
+
       if (was_valid)
         queue_theme_changed (icon_theme);
     }
@@ -1694,6 +1716,48 @@ real_choose_icon (GtkIconTheme       *icon_theme,
       if (unthemed_icon)
         break;
     }
+
+  /* Base directories with an icon cache are not enumerated into
+   * unthemed_icons; look the icon up in their mmap'd caches instead.
+   * This also picks up the embedded pixel data, so the common stock
+   * icons are decoded once system-wide instead of once per process.
+   */
+  if (!unthemed_icon)
+    {
+      for (l = priv->dir_mtimes; l != NULL; l = l->next)
+        {
+          IconThemeDirMtime *dir_mtime = l->data;
+          IconSuffix suffix;
+          gchar *file;
+
+          if (dir_mtime->cache == NULL)
+            continue;
+
+          for (i = 0; icon_names[i]; i++)
+            {
+              /* Toplevel icons are stored with the directory index 0xffff */
+              suffix = (IconSuffix)(gtk_icon_cache_get_icon_flags (dir_mtime->cache,
+                                                                   icon_names[i],
+                                                                   0xffff) & ~HAS_ICON_FILE);
+              suffix = best_suffix (suffix, allow_svg);
+              if (suffix == ICON_SUFFIX_NONE)
+                continue;
+
+              icon_info = icon_info_new (ICON_THEME_DIR_UNTHEMED, size, 1);
+
+              file = g_strconcat (icon_names[i], string_from_suffix (suffix), NULL);
+              icon_info->filename = g_build_filename (dir_mtime->dir, file, NULL);
+              g_free (file);
+              icon_info->icon_file = g_file_new_for_path (icon_info->filename);
+              icon_info->is_svg = suffix == ICON_SUFFIX_SVG;
+
+              icon_info->cache_pixbuf = gtk_icon_cache_get_icon (dir_mtime->cache,
+                                                                 icon_names[i],
+                                                                 0xffff);
+              goto out;
+            }
+        }
+    }
 #ifdef G_OS_WIN32
   /* Still not found an icon, check if reference to a Win32 resource */
   if (!unthemed_icon)
@@ -2687,7 +2751,8 @@ theme_destroy (IconTheme *theme)
   g_free (theme->example);
 
   g_list_free_full (theme->dirs, (GDestroyNotify) theme_dir_destroy);
-  
+  g_list_free_full (theme->caches, (GDestroyNotify) gtk_icon_cache_unref);
+
   g_free (theme);
 }
 
@@ -2904,6 +2969,48 @@ compare_dir_matches (IconThemeDir *dir_a, gint difference_a,
   return diff_a <= diff_b;
 }
 
+/* Check whether the theme can contain the icon at all, using only
+ * the mmap'd caches. Only conclusive when every directory of the
+ * theme is covered by a cache; for symbolic icons the .symbolic.png
+ * variant has its own cache entry, so probe that name too.
+ */
+static gboolean
+theme_caches_have_icon (IconTheme   *theme,
+                        const gchar *icon_name)
+{
+  GList *l;
+
+  if (theme->has_uncached_dirs)
+    return TRUE;
+
+  for (l = theme->caches; l; l = l->next)
+    {
+      if (gtk_icon_cache_has_icon (l->data, icon_name))
+        return TRUE;
+    }
+
+  if (icon_name_is_symbolic (icon_name))
+    {
+      gchar *icon_name_with_suffix;
+      gboolean found = FALSE;
+
+      icon_name_with_suffix = g_strconcat (icon_name, ".symbolic", NULL);
+      for (l = theme->caches; l; l = l->next)
+        {
+          if (gtk_icon_cache_has_icon (l->data, icon_name_with_suffix))
+            {
+              found = TRUE;
+              break;
+            }
+        }
+      g_free (icon_name_with_suffix);
+
+      return found;
+    }
+
+  return FALSE;
+}
+
 static GtkIconInfo *
 theme_lookup_icon (IconTheme   *theme,
                    const gchar *icon_name,
@@ -2918,6 +3025,9 @@ theme_lookup_icon (IconTheme   *theme,
   gint min_difference, difference;
   IconSuffix suffix;
 
+  if (!theme_caches_have_icon (theme, icon_name))
+    return NULL;
+
   min_difference = G_MAXINT;
   min_dir = NULL;
 
@@ -3026,6 +3136,9 @@ theme_has_icon (IconTheme   *theme,
 {
   GList *l;
 
+  if (!theme_caches_have_icon (theme, icon_name))
+    return FALSE;
+
   for (l = theme->dirs; l; l = l->next)
     {
       IconThemeDir *dir = l->data;
@@ -3223,15 +3336,12 @@ theme_subdir_load (GtkIconTheme *icon_theme,
 
       full_dir = g_build_filename (dir_mtime->dir, subdir, NULL);
 
-      /* First, see if we have a cache for the directory */
+      /* First, see if we have a cache for the directory; the cache
+       * was already loaded (or found missing) in insert_theme (), so
+       * with a valid cache no stat at all is needed per subdir
+       */
       if (dir_mtime->cache != NULL || g_file_test (full_dir, G_FILE_TEST_IS_DIR))
         {
-          if (dir_mtime->cache == NULL)
-            {
-              /* This will return NULL if the cache doesn't exist or is outdated */
-              dir_mtime->cache = gtk_icon_cache_new_for_path (dir_mtime->dir);
-            }
-
           dir = g_new0 (IconThemeDir, 1);
           dir->type = type;
           dir->is_resource = FALSE;
@@ -3258,7 +3368,18 @@ theme_subdir_load (GtkIconTheme *icon_theme,
             }
 
           if (has_icons)
-            theme->dirs = g_list_prepend (theme->dirs, dir);
+            {
+              theme->dirs = g_list_prepend (theme->dirs, dir);
+
+              if (dir->cache != NULL)
+                {
+                  if (g_list_find (theme->caches, dir_mtime->cache) == NULL)
+                    theme->caches = g_list_prepend (theme->caches,
+                                                    gtk_icon_cache_ref (dir_mtime->cache));
+                }
+              else
+                theme->has_uncached_dirs = TRUE;
+            }
           else
             theme_dir_destroy (dir);
         }
@@ -3288,7 +3409,10 @@ theme_subdir_load (GtkIconTheme *icon_theme,
           dir->subdir_index = -1;
 
           if (scan_resources (icon_theme->priv, dir, full_dir))
-            theme->dirs = g_list_prepend (theme->dirs, dir);
+            {
+              theme->dirs = g_list_prepend (theme->dirs, dir);
+              theme->has_uncached_dirs = TRUE;
+            }
           else
             theme_dir_destroy (dir);
         }
@@ -3367,8 +3491,6 @@ icon_info_dup (GtkIconInfo *icon_info)
   dup->is_resource = icon_info->is_resource;
   dup->min_size = icon_info->min_size;
   dup->max_size = icon_info->max_size;
-  dup->symbolic_width = icon_info->symbolic_width;
-  dup->symbolic_height = icon_info->symbolic_height;
 
   return dup;
 }
@@ -4087,6 +4209,176 @@ gtk_icon_info_load_icon_finish (GtkIconInfo   *icon_info,
   return gtk_icon_info_load_icon (icon_info, error);
 }
 
+typedef struct
+{
+  GTask *task;           /* the task for the whole batch */
+  GHashTable *textures;  /* icon name => GdkTexture */
+  guint pending;
+} LoadIconsData;
+
+typedef struct
+{
+  LoadIconsData *batch;
+  gchar *icon_name;
+  GtkIconInfo *dup;
+  GdkTexture *texture;
+} LoadIconsItem;
+
+static void
+load_icons_item_thread (GTask        *task,
+                        gpointer      source_object,
+                        gpointer      task_data,
+                        GCancellable *cancellable)
+{
+  LoadIconsItem *item = task_data;
+
+  if (icon_info_ensure_scale_and_pixbuf (item->dup) &&
+      item->dup->pixbuf != NULL)
+    item->texture = gdk_texture_new_for_pixbuf (item->dup->pixbuf);
+
+  g_task_return_boolean (task, TRUE);
+}
+
+static void
+load_icons_item_done (GObject      *source_object,
+                      GAsyncResult *result,
+                      gpointer      user_data)
+{
+  LoadIconsItem *item = user_data;
+  LoadIconsData *data = item->batch;
+
+  /* Icons that failed to load are simply absent from the result */
+  if (item->texture != NULL)
+    g_hash_table_insert (data->textures, item->icon_name, item->texture);
+  else
+    g_free (item->icon_name);
+
+  g_object_unref (item->dup);
+  g_slice_free (LoadIconsItem, item);
+
+  data->pending--;
+  if (data->pending > 0)
+    return;
+
+  if (g_task_return_error_if_cancelled (data->task))
+    g_hash_table_unref (data->textures);
+  else
+    g_task_return_pointer (data->task, data->textures,
+                           (GDestroyNotify) g_hash_table_unref);
+
+  g_object_unref (data->task);
+  g_slice_free (LoadIconsData, data);
+}
+
+/**
+ * gtk_icon_theme_load_icons_async:
+ * @icon_theme: a #GtkIconTheme
+ * @icon_names: (array zero-terminated=1): a %NULL-terminated array of
+ *     icon names to load
+ * @size: desired icon size
+ * @scale: desired scale
+ * @flags: flags modifying the behavior of the icon lookup
+ * @cancellable: (allow-none): optional #GCancellable object, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the
+ *     batch has been loaded
+ * @user_data: (closure): the data to pass to callback function
+ *
+ * Asynchronously looks up and loads a batch of icons, decoding them
+ * on worker threads so that populating a large icon grid does not
+ * saturate the main loop with one task per cell.
+ *
+ * Duplicate names are decoded only once. Names that cannot be found
+ * or fail to decode are left out of the result rather than failing
+ * the whole batch.
+ */
+void
+gtk_icon_theme_load_icons_async (GtkIconTheme        *icon_theme,
+                                 const gchar        **icon_names,
+                                 gint                 size,
+                                 gint                 scale,
+                                 GtkIconLookupFlags   flags,
+                                 GCancellable        *cancellable,
+                                 GAsyncReadyCallback  callback,
+                                 gpointer             user_data)
+{
+  LoadIconsData *data;
+  GHashTable *seen;
+  gint i;
+
+  g_return_if_fail (GTK_IS_ICON_THEME (icon_theme));
+  g_return_if_fail (icon_names != NULL);
+  g_return_if_fail (scale >= 1);
+
+  data = g_slice_new0 (LoadIconsData);
+  data->task = g_task_new (icon_theme, cancellable, callback, user_data);
+  data->textures = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                          g_free, g_object_unref);
+
+  seen = g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (i = 0; icon_names[i] != NULL; i++)
+    {
+      GtkIconInfo *icon_info;
+      LoadIconsItem *item;
+      GTask *task;
+
+      if (!g_hash_table_add (seen, (gpointer) icon_names[i]))
+        continue;
+
+      icon_info = gtk_icon_theme_lookup_icon_for_scale (icon_theme, icon_names[i],
+                                                        size, scale, flags);
+      if (icon_info == NULL)
+        continue;
+
+      item = g_slice_new0 (LoadIconsItem);
+      item->batch = data;
+      item->icon_name = g_strdup (icon_names[i]);
+      item->dup = icon_info_dup (icon_info);
+      g_object_unref (icon_info);
+
+      data->pending++;
+
+      task = g_task_new (icon_theme, cancellable, load_icons_item_done, item);
+      g_task_set_task_data (task, item, NULL);
+      g_task_run_in_thread (task, load_icons_item_thread);
+      g_object_unref (task);
+    }
+
+  g_hash_table_unref (seen);
+
+  if (data->pending == 0)
+    {
+      g_task_return_pointer (data->task, data->textures,
+                             (GDestroyNotify) g_hash_table_unref);
+      g_object_unref (data->task);
+      g_slice_free (LoadIconsData, data);
+    }
+}
+
+/**
+ * gtk_icon_theme_load_icons_finish:
+ * @icon_theme: a #GtkIconTheme
+ * @result: a #GAsyncResult
+ * @error: (allow-none): location to store error information on failure,
+ *     or %NULL.
+ *
+ * Finishes a batch icon load, see gtk_icon_theme_load_icons_async().
+ *
+ * Returns: (transfer full) (element-type utf8 GdkTexture): a hash table
+ *     mapping icon names to ready #GdkTexture objects. Use
+ *     g_hash_table_unref() to release your reference to it.
+ */
+GHashTable *
+gtk_icon_theme_load_icons_finish (GtkIconTheme  *icon_theme,
+                                  GAsyncResult  *result,
+                                  GError       **error)
+{
+  g_return_val_if_fail (GTK_IS_ICON_THEME (icon_theme), NULL);
+  g_return_val_if_fail (g_task_is_valid (result, icon_theme), NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
 static void
 proxy_symbolic_pixbuf_destroy (guchar   *pixels,
                                gpointer  data)
@@ -4137,17 +4429,6 @@ symbolic_cache_get_proxy (SymbolicPixbufCache *symbolic_cache,
   return symbolic_cache->proxy_pixbuf;
 }
 
-static gchar *
-rgba_to_string_noalpha (const GdkRGBA *rgba)
-{
-  GdkRGBA color;
-
-  color = *rgba;
-  color.alpha = 1.0;
-
-  return gdk_rgba_to_string (&color);
-}
-
 static void
 rgba_to_pixel(const GdkRGBA  *rgba,
 	      guint8 pixel[4])
@@ -4158,6 +4439,120 @@ rgba_to_pixel(const GdkRGBA  *rgba,
   pixel[3] = 255;
 }
 
+static inline void
+color_symbolic_pixel (const guchar *src,
+                      guchar       *dst,
+                      int           alpha,
+                      const guint8  fg_pixel[4],
+                      const guint8  success_pixel[4],
+                      const guint8  warning_pixel[4],
+                      const guint8  error_pixel[4])
+{
+  guint r, g, b, a;
+  int c1, c2, c3, c4;
+
+  a = src[3];
+  dst[3] = a * alpha / 255;
+
+  if (a == 0)
+    {
+      dst[0] = 0;
+      dst[1] = 0;
+      dst[2] = 0;
+    }
+  else
+    {
+      c2 = src[0];
+      c3 = src[1];
+      c4 = src[2];
+
+      if (c2 == 0 && c3 == 0 && c4 == 0)
+        {
+          dst[0] = fg_pixel[0];
+          dst[1] = fg_pixel[1];
+          dst[2] = fg_pixel[2];
+        }
+      else
+        {
+          c1 = 255 - c2 - c3 - c4;
+
+          r = fg_pixel[0] * c1 + success_pixel[0] * c2 +  warning_pixel[0] * c3 +  error_pixel[0] * c4;
+          g = fg_pixel[1] * c1 + success_pixel[1] * c2 +  warning_pixel[1] * c3 +  error_pixel[1] * c4;
+          b = fg_pixel[2] * c1 + success_pixel[2] * c2 +  warning_pixel[2] * c3 +  error_pixel[2] * c4;
+
+          dst[0] = r / 255;
+          dst[1] = g / 255;
+          dst[2] = b / 255;
+        }
+    }
+}
+
+#if defined (__SSE2__)
+
+/* Exact floor (x / 255) for 16-bit lanes */
+static inline __m128i
+div255_epu16 (__m128i x)
+{
+  return _mm_srli_epi16 (_mm_mulhi_epu16 (x, _mm_set1_epi16 ((short) 0x8081)), 7);
+}
+
+/* Recolor two pixels held as 8 unpacked 16-bit lanes
+ * [ c2 c3 c4 a  c2 c3 c4 a ]. The branches of the scalar code
+ * collapse into the weighted sum: c2 = c3 = c4 = 0 yields c1 = 255
+ * and thus the plain fg color, and a == 0 pixels are masked to
+ * black afterwards. Saturating arithmetic clamps inputs whose
+ * plane sum exceeds 255, which the scalar code leaves undefined.
+ */
+static inline __m128i
+color_symbolic_2px_sse2 (__m128i p,
+                         __m128i fg,
+                         __m128i success,
+                         __m128i warning,
+                         __m128i error,
+                         __m128i alpha)
+{
+  const __m128i c255 = _mm_set1_epi16 (255);
+  const __m128i alpha_lane = _mm_set_epi16 (-1, 0, 0, 0, -1, 0, 0, 0);
+  __m128i c1, c2, c3, c4, a, rgb, a_out;
+
+  c2 = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (p, _MM_SHUFFLE (0, 0, 0, 0)),
+                            _MM_SHUFFLE (0, 0, 0, 0));
+  c3 = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (p, _MM_SHUFFLE (1, 1, 1, 1)),
+                            _MM_SHUFFLE (1, 1, 1, 1));
+  c4 = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (p, _MM_SHUFFLE (2, 2, 2, 2)),
+                            _MM_SHUFFLE (2, 2, 2, 2));
+  a  = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (p, _MM_SHUFFLE (3, 3, 3, 3)),
+                            _MM_SHUFFLE (3, 3, 3, 3));
+
+  c1 = _mm_subs_epu16 (c255, _mm_adds_epu16 (_mm_adds_epu16 (c2, c3), c4));
+
+  rgb = _mm_adds_epu16 (_mm_adds_epu16 (_mm_mullo_epi16 (fg, c1),
+                                        _mm_mullo_epi16 (success, c2)),
+                        _mm_adds_epu16 (_mm_mullo_epi16 (warning, c3),
+                                        _mm_mullo_epi16 (error, c4)));
+  rgb = div255_epu16 (rgb);
+  rgb = _mm_andnot_si128 (_mm_cmpeq_epi16 (a, _mm_setzero_si128 ()), rgb);
+
+  a_out = div255_epu16 (_mm_mullo_epi16 (a, alpha));
+
+  return _mm_or_si128 (_mm_andnot_si128 (alpha_lane, rgb),
+                       _mm_and_si128 (alpha_lane, a_out));
+}
+
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+
+/* Exact floor (x / 255) for 16-bit lanes; x must stay below 65280,
+ * which holds for sums of products whose coefficients add up to 255
+ */
+static inline uint16x8_t
+div255_u16 (uint16x8_t x)
+{
+  return vshrq_n_u16 (vaddq_u16 (vaddq_u16 (x, vdupq_n_u16 (1)),
+                                 vshrq_n_u16 (x, 8)), 8);
+}
+
+#endif
+
 GdkPixbuf *
 gtk_icon_theme_color_symbolic_pixbuf (GdkPixbuf     *symbolic,
                                       const GdkRGBA *fg_color,
@@ -4194,49 +4589,71 @@ gtk_icon_theme_color_symbolic_pixbuf (GdkPixbuf     *symbolic,
     {
       src_row = src_data + src_stride * y;
       dst_row = dst_data + dst_stride * y;
-      for (x = 0; x < width; x++)
-        {
-          guint r, g, b, a;
-          int c1, c2, c3, c4;
-
-          a = src_row[3];
-          dst_row[3] = a * alpha / 255;
-
-          if (a == 0)
-            {
-              dst_row[0] = 0;
-              dst_row[1] = 0;
-              dst_row[2] = 0;
-            }
-          else
-            {
-              c2 = src_row[0];
-              c3 = src_row[1];
-              c4 = src_row[2];
-
-              if (c2 == 0 && c3 == 0 && c4 == 0)
-                {
-                  dst_row[0] = fg_pixel[0];
-                  dst_row[1] = fg_pixel[1];
-                  dst_row[2] = fg_pixel[2];
-                }
-              else
-                {
-                  c1 = 255 - c2 - c3 - c4;
+      x = 0;
 
-                  r = fg_pixel[0] * c1 + success_pixel[0] * c2 +  warning_pixel[0] * c3 +  error_pixel[0] * c4;
-                  g = fg_pixel[1] * c1 + success_pixel[1] * c2 +  warning_pixel[1] * c3 +  error_pixel[1] * c4;
-                  b = fg_pixel[2] * c1 + success_pixel[2] * c2 +  warning_pixel[2] * c3 +  error_pixel[2] * c4;
-
-                  dst_row[0] = r / 255;
-                  dst_row[1] = g / 255;
-                  dst_row[2] = b / 255;
-                }
-            }
+#if defined (__SSE2__)
+      {
+        const __m128i zero = _mm_setzero_si128 ();
+        const __m128i alpha16 = _mm_set1_epi16 (alpha);
+        const __m128i fg = _mm_set_epi16 (0, fg_pixel[2], fg_pixel[1], fg_pixel[0],
+                                          0, fg_pixel[2], fg_pixel[1], fg_pixel[0]);
+        const __m128i success = _mm_set_epi16 (0, success_pixel[2], success_pixel[1], success_pixel[0],
+                                               0, success_pixel[2], success_pixel[1], success_pixel[0]);
+        const __m128i warning = _mm_set_epi16 (0, warning_pixel[2], warning_pixel[1], warning_pixel[0],
+                                               0, warning_pixel[2], warning_pixel[1], warning_pixel[0]);
+        const __m128i error = _mm_set_epi16 (0, error_pixel[2], error_pixel[1], error_pixel[0],
+                                             0, error_pixel[2], error_pixel[1], error_pixel[0]);
+
+        for (; x + 4 <= width; x += 4)
+          {
+            __m128i p, lo, hi;
+
+            p = _mm_loadu_si128 ((const __m128i *) (src_row + 4 * x));
+            lo = color_symbolic_2px_sse2 (_mm_unpacklo_epi8 (p, zero),
+                                          fg, success, warning, error, alpha16);
+            hi = color_symbolic_2px_sse2 (_mm_unpackhi_epi8 (p, zero),
+                                          fg, success, warning, error, alpha16);
+            _mm_storeu_si128 ((__m128i *) (dst_row + 4 * x),
+                              _mm_packus_epi16 (lo, hi));
+          }
+      }
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+      {
+        const uint16x8_t alpha16 = vdupq_n_u16 (alpha);
+
+        for (; x + 8 <= width; x += 8)
+          {
+            uint8x8x4_t p = vld4_u8 (src_row + 4 * x);
+            uint16x8_t c2 = vmovl_u8 (p.val[0]);
+            uint16x8_t c3 = vmovl_u8 (p.val[1]);
+            uint16x8_t c4 = vmovl_u8 (p.val[2]);
+            uint16x8_t a  = vmovl_u8 (p.val[3]);
+            uint16x8_t c1, sum;
+            uint16x8_t opaque = vmvnq_u16 (vceqq_u16 (a, vdupq_n_u16 (0)));
+            uint8x8x4_t out;
+            int ch;
+
+            c1 = vqsubq_u16 (vdupq_n_u16 (255),
+                             vqaddq_u16 (vqaddq_u16 (c2, c3), c4));
+
+            for (ch = 0; ch < 3; ch++)
+              {
+                sum = vmulq_u16 (c1, vdupq_n_u16 (fg_pixel[ch]));
+                sum = vmlaq_u16 (sum, c2, vdupq_n_u16 (success_pixel[ch]));
+                sum = vmlaq_u16 (sum, c3, vdupq_n_u16 (warning_pixel[ch]));
+                sum = vmlaq_u16 (sum, c4, vdupq_n_u16 (error_pixel[ch]));
+                out.val[ch] = vqmovn_u16 (vandq_u16 (div255_u16 (sum), opaque));
+              }
+            out.val[3] = vqmovn_u16 (div255_u16 (vmulq_u16 (a, alpha16)));
+
+            vst4_u8 (dst_row + 4 * x, out);
+          }
+      }
+#endif
 
-          src_row += 4;
-          dst_row += 4;
-        }
+      for (; x < width; x++)
+        color_symbolic_pixel (src_row + 4 * x, dst_row + 4 * x, alpha,
+                              fg_pixel, success_pixel, warning_pixel, error_pixel);
     }
 
   return colored;
@@ -4288,142 +4705,29 @@ gtk_icon_info_load_symbolic_svg (GtkIconInfo    *icon_info,
                                  const GdkRGBA  *error_color,
                                  GError        **error)
 {
-  GInputStream *stream;
-  GdkPixbuf *pixbuf;
-  gchar *css_fg;
-  gchar *css_success;
-  gchar *css_warning;
-  gchar *css_error;
-  gchar *data;
-  gchar *width;
-  gchar *height;
-  gchar *file_data, *escaped_file_data;
-  gsize file_len;
-  gint symbolic_size;
-  double alpha;
-  gchar alphastr[G_ASCII_DTOSTR_BUF_SIZE];
-
-  alpha = fg->alpha;
-
-  css_fg = rgba_to_string_noalpha (fg);
-
-  css_success = css_warning = css_error = NULL;
-
-  if (warning_color)
-    css_warning = rgba_to_string_noalpha (warning_color);
-  else
-    css_warning = g_strdup ("rgb(245,121,62)");
-
-  if (error_color)
-    css_error = rgba_to_string_noalpha (error_color);
-  else
-    css_error = g_strdup ("rgb(204,0,0)");
-
-  if (success_color)
-    css_success = rgba_to_string_noalpha (success_color);
-  else
-    css_success = g_strdup ("rgb(78,154,6)");
-
-  if (!g_file_load_contents (icon_info->icon_file, NULL, &file_data, &file_len, NULL, error))
-    return NULL;
+  GdkRGBA success_default = { 0.3046921492332342,0.6015716792553597, 0.023437857633325704, 1.0};
+  GdkRGBA warning_default = {0.9570458533607996, 0.47266346227206835, 0.2421911955443656, 1.0 };
+  GdkRGBA error_default = { 0.796887159533074, 0 ,0, 1.0 };
 
+  /* The pixbuf that gets rendered for a symbolic svg is a
+   * color-agnostic mask whose channels hold the success/warning/error
+   * coverage (see gtk_make_symbolic_pixbuf_from_data()), so applying
+   * the colors is a matter of running it through the color matrix.
+   * The svg itself is only rendered once per size that way, instead
+   * of once per (color, size) combination.
+   */
   if (!icon_info_ensure_scale_and_pixbuf (icon_info))
     {
       g_propagate_error (error, icon_info->load_error);
       icon_info->load_error = NULL;
-      g_free (css_fg);
-      g_free (css_warning);
-      g_free (css_error);
-      g_free (css_success);
-      g_free (file_data);
       return NULL;
     }
 
-  if (icon_info->symbolic_width == 0 ||
-      icon_info->symbolic_height == 0)
-    {
-      /* Fetch size from the original icon */
-      stream = g_memory_input_stream_new_from_data (file_data, file_len, NULL);
-      pixbuf = gdk_pixbuf_new_from_stream (stream, NULL, error);
-      g_object_unref (stream);
-
-      if (!pixbuf)
-        {
-          g_free (css_fg);
-          g_free (css_warning);
-          g_free (css_error);
-          g_free (css_success);
-          g_free (file_data);
-          return NULL;
-        }
-
-      icon_info->symbolic_width = gdk_pixbuf_get_width (pixbuf);
-      icon_info->symbolic_height = gdk_pixbuf_get_height (pixbuf);
-      g_object_unref (pixbuf);
-    }
-
-  symbolic_size = MAX (icon_info->symbolic_width, icon_info->symbolic_height);
-
-  GTK_NOTE (ICONTHEME,
-  if (icon_info->dir_type == ICON_THEME_DIR_UNTHEMED)
-    g_message ("Symbolic icon %s is not in an icon theme directory",
-               icon_info->key.icon_names ? icon_info->key.icon_names[0] : icon_info->filename);
-  else if (icon_info->dir_size * icon_info->dir_scale != symbolic_size)
-    g_message ("Symbolic icon %s of size %d is in an icon theme directory of size %d",
-               icon_info->key.icon_names ? icon_info->key.icon_names[0] : icon_info->filename,
-               symbolic_size,
-               icon_info->dir_size * icon_info->dir_scale)
-  );
-
-  width = g_strdup_printf ("%d", icon_info->symbolic_width);
-  height = g_strdup_printf ("%d", icon_info->symbolic_height);
-
-  escaped_file_data = g_markup_escape_text (file_data, file_len);
-  g_free (file_data);
-
-  g_ascii_dtostr (alphastr, G_ASCII_DTOSTR_BUF_SIZE, CLAMP (alpha, 0, 1));
-
-  data = g_strconcat ("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
-                      "<svg version=\"1.1\"\n"
-                      "     xmlns=\"http://www.w3.org/2000/svg\"\n"
-                      "     xmlns:xi=\"http://www.w3.org/2001/XInclude\"\n"
-                      "     width=\"", width, "\"\n"
-                      "     height=\"", height, "\">\n"
-                      "  <style type=\"text/css\">\n"
-                      "    rect,path {\n"
-                      "      fill: ", css_fg," !important;\n"
-                      "    }\n"
-                      "    .warning {\n"
-                      "      fill: ", css_warning, " !important;\n"
-                      "    }\n"
-                      "    .error {\n"
-                      "      fill: ", css_error ," !important;\n"
-                      "    }\n"
-                      "    .success {\n"
-                      "      fill: ", css_success, " !important;\n"
-                      "    }\n"
-                      "  </style>\n"
-                      "  <g opacity=\"", alphastr, "\" ><xi:include href=\"data:text/xml,", escaped_file_data, "\"/></g>\n"
-                      "</svg>",
-                      NULL);
-  g_free (escaped_file_data);
-  g_free (css_fg);
-  g_free (css_warning);
-  g_free (css_error);
-  g_free (css_success);
-  g_free (width);
-  g_free (height);
-
-  stream = g_memory_input_stream_new_from_data (data, -1, g_free);
-  pixbuf = gdk_pixbuf_new_from_stream_at_scale (stream,
-                                                gdk_pixbuf_get_width (icon_info->pixbuf),
-                                                gdk_pixbuf_get_height (icon_info->pixbuf),
-                                                TRUE,
-                                                NULL,
-                                                error);
-  g_object_unref (stream);
-
-  return pixbuf;
+  return gtk_icon_theme_color_symbolic_pixbuf (icon_info->pixbuf,
+                                               fg,
+                                               success_color ? success_color : &success_default,
+                                               warning_color ? warning_color : &warning_default,
+                                               error_color ? error_color : &error_default);
 }
 
 
@@ -272,6 +272,20 @@ char *        gtk_icon_theme_get_example_icon_name (GtkIconTheme
 GDK_AVAILABLE_IN_ALL
 gboolean      gtk_icon_theme_rescan_if_needed      (GtkIconTheme                *icon_theme);
 
+GDK_AVAILABLE_IN_ALL
+void          gtk_icon_theme_load_icons_async      (GtkIconTheme                *icon_theme,
+                                                    const gchar                **icon_names,
+                                                    gint                         size,
+                                                    gint                         scale,
+                                                    GtkIconLookupFlags           flags,
+                                                    GCancellable                *cancellable,
+                                                    GAsyncReadyCallback          callback,
+                                                    gpointer                     user_data);
+GDK_AVAILABLE_IN_ALL
+GHashTable *  gtk_icon_theme_load_icons_finish     (GtkIconTheme                *icon_theme,
+                                                    GAsyncResult                *result,
+                                                    GError                     **error);
+
 GDK_AVAILABLE_IN_ALL
 GType                 gtk_icon_info_get_type           (void) G_GNUC_CONST;
 
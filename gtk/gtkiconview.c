@@ -939,8 +939,9 @@ gtk_icon_view_init (GtkIconView *icon_view)
 
   icon_view->priv->draw_focus = TRUE;
 
-  icon_view->priv->row_contexts = 
+  icon_view->priv->row_contexts =
     g_ptr_array_new_with_free_func ((GDestroyNotify)g_object_unref);
+  icon_view->priv->row_items = g_ptr_array_new ();
 
   gtk_style_context_add_class (gtk_widget_get_style_context (GTK_WIDGET (icon_view)),
                                GTK_STYLE_CLASS_VIEW);
@@ -991,6 +992,12 @@ gtk_icon_view_dispose (GObject *object)
       priv->row_contexts = NULL;
     }
 
+  if (priv->row_items)
+    {
+      g_ptr_array_free (priv->row_items, TRUE);
+      priv->row_items = NULL;
+    }
+
   if (priv->cell_area)
     {
       gtk_cell_area_stop_editing (icon_view->priv->cell_area, TRUE);
@@ -2364,6 +2371,10 @@ gtk_icon_view_start_rubberbanding (GtkIconView  *icon_view,
   priv->rubberband_y1 = y + gtk_adjustment_get_value (priv->vadjustment);
   priv->rubberband_x2 = priv->rubberband_x1;
   priv->rubberband_y2 = priv->rubberband_y1;
+  priv->rubberband_prev.x = priv->rubberband_x1;
+  priv->rubberband_prev.y = priv->rubberband_y1;
+  priv->rubberband_prev.width = 0;
+  priv->rubberband_prev.height = 0;
 
   priv->doing_rubberband = TRUE;
   priv->rubberband_device = device;
@@ -2392,39 +2403,95 @@ gtk_icon_view_stop_rubberbanding (GtkIconView *icon_view)
   gtk_widget_queue_draw (GTK_WIDGET (icon_view));
 }
 
+static gboolean
+gtk_icon_view_rubberband_select_item (GtkIconView     *icon_view,
+                                      GtkIconViewItem *item,
+                                      gint             x,
+                                      gint             y,
+                                      gint             width,
+                                      gint             height)
+{
+  gboolean is_in;
+  gboolean selected;
+
+  is_in = gtk_icon_view_item_hit_test (icon_view, item,
+                                       x, y, width, height);
+
+  selected = is_in ^ item->selected_before_rubberbanding;
+
+  if (item->selected != selected)
+    {
+      item->selected = selected;
+      gtk_icon_view_queue_draw_item (icon_view, item);
+
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
 static void
 gtk_icon_view_update_rubberband_selection (GtkIconView *icon_view)
 {
+  GtkIconViewPrivate *priv = icon_view->priv;
   GList *items;
   gint x, y, width, height;
   gboolean dirty = FALSE;
-  
-  x = MIN (icon_view->priv->rubberband_x1,
-	   icon_view->priv->rubberband_x2);
-  y = MIN (icon_view->priv->rubberband_y1,
-	   icon_view->priv->rubberband_y2);
-  width = ABS (icon_view->priv->rubberband_x1 - 
-	       icon_view->priv->rubberband_x2);
-  height = ABS (icon_view->priv->rubberband_y1 - 
-		icon_view->priv->rubberband_y2);
-  
-  for (items = icon_view->priv->items; items; items = items->next)
+  GdkRectangle band, walk;
+
+  x = MIN (priv->rubberband_x1, priv->rubberband_x2);
+  y = MIN (priv->rubberband_y1, priv->rubberband_y2);
+  width = ABS (priv->rubberband_x1 - priv->rubberband_x2);
+  height = ABS (priv->rubberband_y1 - priv->rubberband_y2);
+
+  /* An item can only change selection state if the band covers it now
+   * or covered it at the previous update, so only rows intersecting
+   * the union of both rectangles need to be hit-tested.
+   */
+  band.x = x;
+  band.y = y;
+  band.width = width;
+  band.height = height;
+  gdk_rectangle_union (&band, &priv->rubberband_prev, &walk);
+  priv->rubberband_prev = band;
+
+  if (priv->row_items->len > 0)
     {
-      GtkIconViewItem *item = items->data;
-      gboolean is_in;
-      gboolean selected;
-      
-      is_in = gtk_icon_view_item_hit_test (icon_view, item, 
-					   x, y, width, height);
+      guint row;
 
-      selected = is_in ^ item->selected_before_rubberbanding;
+      for (row = 0; row < priv->row_items->len; row++)
+        {
+          GtkIconViewItem *first;
 
-      if (item->selected != selected)
-	{
-	  item->selected = selected;
-	  dirty = TRUE;
-	  gtk_icon_view_queue_draw_item (icon_view, item);
-	}
+          items = g_ptr_array_index (priv->row_items, row);
+          first = items->data;
+
+          if (first->cell_area.y > walk.y + walk.height)
+            break;
+
+          if (first->cell_area.y + first->cell_area.height < walk.y)
+            continue;
+
+          for (; items; items = items->next)
+            {
+              GtkIconViewItem *item = items->data;
+
+              if (item->row != (gint) row)
+                break;
+
+              dirty |= gtk_icon_view_rubberband_select_item (icon_view, item,
+                                                             x, y, width, height);
+            }
+        }
+    }
+  else
+    {
+      /* No layouted row index (the items changed and we have not been
+       * re-layouted yet); fall back to walking everything.
+       */
+      for (items = priv->items; items; items = items->next)
+        dirty |= gtk_icon_view_rubberband_select_item (icon_view, items->data,
+                                                       x, y, width, height);
     }
 
   if (dirty)
@@ -2762,6 +2829,7 @@ gtk_icon_view_layout (GtkIconView *icon_view)
 
   /* Clear the per row contexts */
   g_ptr_array_set_size (icon_view->priv->row_contexts, 0);
+  g_ptr_array_set_size (icon_view->priv->row_items, 0);
 
   gtk_cell_area_context_reset (priv->cell_area_context);
   /* because layouting is complicated. We designed an API
@@ -2825,6 +2893,8 @@ gtk_icon_view_layout (GtkIconView *icon_view)
       GtkCellAreaContext *context = g_ptr_array_index (priv->row_contexts, row);
       gtk_cell_area_context_allocate (context, item_width, sizes[row].minimum_size);
 
+      g_ptr_array_add (priv->row_items, items);
+
       priv->height += priv->item_padding;
 
       for (col = 0; col < n_columns && items; col++, items = items->next)
@@ -3313,7 +3383,10 @@ gtk_icon_view_row_deleted (GtkTreeModel *model,
   
   icon_view->priv->items = g_list_delete_link (icon_view->priv->items, list);
 
-  verify_items (icon_view);  
+  /* The row index may point at the deleted link */
+  g_ptr_array_set_size (icon_view->priv->row_items, 0);
+
+  verify_items (icon_view);
   
   gtk_widget_queue_resize (GTK_WIDGET (icon_view));
 
@@ -3362,6 +3435,7 @@ gtk_icon_view_rows_reordered (GtkTreeModel *model,
   g_free (item_array);
   g_list_free (icon_view->priv->items);
   icon_view->priv->items = items;
+  g_ptr_array_set_size (icon_view->priv->row_items, 0);
 
   gtk_widget_queue_resize (GTK_WIDGET (icon_view));
 
@@ -4726,6 +4800,7 @@ gtk_icon_view_set_model (GtkIconView *icon_view,
       
       g_list_free_full (icon_view->priv->items, (GDestroyNotify) gtk_icon_view_item_free);
       icon_view->priv->items = NULL;
+      g_ptr_array_set_size (icon_view->priv->row_items, 0);
       icon_view->priv->anchor_item = NULL;
       icon_view->priv->cursor_item = NULL;
       icon_view->priv->last_single_clicked = NULL;
@@ -48,6 +48,13 @@ struct _GtkIconViewPrivate
 
   GPtrArray          *row_contexts;
 
+  /* First item (a link into the items list) of each layouted row,
+   * parallel to row_contexts; lets rubberband hit-testing skip rows
+   * outside the band. Cleared whenever the items list is relinked
+   * and rebuilt by the next layout.
+   */
+  GPtrArray          *row_items;
+
   gint width, height;
   double mouse_x;
   double mouse_y;
@@ -68,6 +75,7 @@ struct _GtkIconViewPrivate
 
   gint rubberband_x1, rubberband_y1;
   gint rubberband_x2, rubberband_y2;
+  GdkRectangle rubberband_prev;
   GdkDevice *rubberband_device;
   GtkCssNode *rubberband_node;
 
@@ -83,6 +83,8 @@ struct _GtkImagePrivate
 
   gchar                *filename;       /* Only used with GTK_IMAGE_SURFACE */
   gchar                *resource_path;  /* Only used with GTK_IMAGE_SURFACE */
+
+  GCancellable         *loading_cancellable; /* Pending gtk_image_set_from_file_async() */
 };
 
 
@@ -102,6 +104,7 @@ static void gtk_image_measure (GtkWidget      *widget,
                                int           *natural_baseline);
 
 static void gtk_image_style_updated        (GtkWidget    *widget);
+static void gtk_image_destroy              (GtkWidget    *widget);
 static void gtk_image_finalize             (GObject      *object);
 
 static void gtk_image_set_property         (GObject      *object,
@@ -146,6 +149,7 @@ gtk_image_class_init (GtkImageClass *class)
   gobject_class->finalize = gtk_image_finalize;
 
   widget_class = GTK_WIDGET_CLASS (class);
+  widget_class->destroy = gtk_image_destroy;
   widget_class->snapshot = gtk_image_snapshot;
   widget_class->measure = gtk_image_measure;
   widget_class->size_allocate = gtk_image_size_allocate;
@@ -276,12 +280,30 @@ gtk_image_init (GtkImage *image)
   gtk_icon_helper_init (&priv->icon_helper, widget_node, GTK_WIDGET (image));
 }
 
+static void
+gtk_image_destroy (GtkWidget *widget)
+{
+  GtkImagePrivate *priv = gtk_image_get_instance_private (GTK_IMAGE (widget));
+
+  /* The task holds a reference on the image until it completes, so
+   * cancel pending loads at destroy time rather than in finalize */
+  if (priv->loading_cancellable)
+    {
+      g_cancellable_cancel (priv->loading_cancellable);
+      g_clear_object (&priv->loading_cancellable);
+    }
+
+  GTK_WIDGET_CLASS (gtk_image_parent_class)->destroy (widget);
+}
+
 static void
 gtk_image_finalize (GObject *object)
 {
   GtkImage *image = GTK_IMAGE (object);
   GtkImagePrivate *priv = gtk_image_get_instance_private (image);
 
+  g_clear_object (&priv->loading_cancellable);
+
   gtk_icon_helper_destroy (&priv->icon_helper);
 
   g_free (priv->filename);
@@ -721,6 +743,178 @@ gtk_image_set_from_file   (GtkImage    *image,
   g_object_thaw_notify (G_OBJECT (image));
 }
 
+typedef struct
+{
+  gchar *filename;
+  int width;
+  int height;
+  int scale_factor;
+} AsyncLoadData;
+
+static void
+async_load_data_free (gpointer data)
+{
+  AsyncLoadData *load = data;
+
+  g_free (load->filename);
+  g_free (load);
+}
+
+static void
+gtk_image_load_in_thread (GTask        *task,
+                          gpointer      source_object,
+                          gpointer      task_data,
+                          GCancellable *cancellable)
+{
+  AsyncLoadData *data = task_data;
+  GdkPixbuf *pixbuf;
+  GError *error = NULL;
+
+  /* Decoding at the target size skips both the full-resolution
+   * decode and the later rescale */
+  pixbuf = gdk_pixbuf_new_from_file_at_scale (data->filename,
+                                              data->width > 0 ? data->width * data->scale_factor : -1,
+                                              data->height > 0 ? data->height * data->scale_factor : -1,
+                                              TRUE,
+                                              &error);
+  if (pixbuf == NULL)
+    g_task_return_error (task, error);
+  else
+    g_task_return_pointer (task, pixbuf, g_object_unref);
+}
+
+static void
+gtk_image_load_finished (GObject      *source_object,
+                         GAsyncResult *result,
+                         gpointer      user_data)
+{
+  GtkImage *image = GTK_IMAGE (source_object);
+  GtkImagePrivate *priv = gtk_image_get_instance_private (image);
+  AsyncLoadData *data = g_task_get_task_data (G_TASK (result));
+  GdkPixbuf *pixbuf;
+  cairo_surface_t *surface;
+  GError *error = NULL;
+
+  pixbuf = g_task_propagate_pointer (G_TASK (result), &error);
+
+  /* Superseded by a newer request or cancelled at destroy time;
+   * leave the image alone */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+      g_error_free (error);
+      return;
+    }
+
+  g_clear_object (&priv->loading_cancellable);
+
+  if (pixbuf == NULL)
+    {
+      gtk_image_set_from_icon_name (image, "image-missing");
+      g_clear_error (&error);
+      return;
+    }
+
+  surface = gdk_cairo_surface_create_from_pixbuf (pixbuf, data->scale_factor,
+                                                  _gtk_widget_get_window (GTK_WIDGET (image)));
+  gtk_image_set_from_surface (image, surface);
+  cairo_surface_destroy (surface);
+  g_object_unref (pixbuf);
+
+  priv->filename = g_strdup (data->filename);
+  g_object_notify_by_pspec (G_OBJECT (image), image_props[PROP_FILE]);
+}
+
+/**
+ * gtk_image_set_from_file_async:
+ * @image: a #GtkImage
+ * @filename: (type filename) (allow-none): a filename or %NULL
+ * @width: the width to decode to, or -1
+ * @height: the height to decode to, or -1
+ *
+ * Asynchronous variant of gtk_image_set_from_file(). The file is
+ * decoded on a worker thread directly at the given display size
+ * (scaled for high-dpi output), so large images neither stall the
+ * main loop nor get decoded at a resolution that is thrown away
+ * again. While decoding, the image shows a placeholder icon.
+ *
+ * The aspect ratio is preserved within @width x @height; passing -1
+ * for one dimension leaves it unconstrained. A later call to any of
+ * the gtk_image_set_from_*() family, or destroying the widget,
+ * cancels a pending load.
+ *
+ * Note that animations are not supported by this function; files
+ * containing animations are displayed as their first frame.
+ **/
+void
+gtk_image_set_from_file_async (GtkImage    *image,
+                               const gchar *filename,
+                               int          width,
+                               int          height)
+{
+  GtkImagePrivate *priv = gtk_image_get_instance_private (image);
+  AsyncLoadData *data;
+  GTask *task;
+
+  g_return_if_fail (GTK_IS_IMAGE (image));
+
+  /* A newer request supersedes whatever is still decoding */
+  if (priv->loading_cancellable)
+    {
+      g_cancellable_cancel (priv->loading_cancellable);
+      g_clear_object (&priv->loading_cancellable);
+    }
+
+  if (filename == NULL)
+    {
+      gtk_image_set_from_file (image, NULL);
+      return;
+    }
+
+  /* Placeholder until the decode finishes */
+  gtk_image_set_from_icon_name (image, "image-loading");
+
+  priv->loading_cancellable = g_cancellable_new ();
+
+  data = g_new0 (AsyncLoadData, 1);
+  data->filename = g_strdup (filename);
+  data->width = width;
+  data->height = height;
+  data->scale_factor = gtk_widget_get_scale_factor (GTK_WIDGET (image));
+
+  task = g_task_new (image, priv->loading_cancellable,
+                     gtk_image_load_finished, NULL);
+  g_task_set_task_data (task, data, async_load_data_free);
+  g_task_run_in_thread (task, gtk_image_load_in_thread);
+  g_object_unref (task);
+}
+
+/**
+ * gtk_image_new_from_file_async:
+ * @filename: (type filename): a filename
+ * @width: the width to decode to, or -1
+ * @height: the height to decode to, or -1
+ *
+ * Creates a new #GtkImage that asynchronously loads @filename at the
+ * given display size. See gtk_image_set_from_file_async() for
+ * details. This function never returns %NULL, it always returns a
+ * valid #GtkImage widget.
+ *
+ * Returns: a new #GtkImage
+ **/
+GtkWidget *
+gtk_image_new_from_file_async (const gchar *filename,
+                               int          width,
+                               int          height)
+{
+  GtkImage *image;
+
+  image = g_object_new (GTK_TYPE_IMAGE, NULL);
+
+  gtk_image_set_from_file_async (image, filename, width, height);
+
+  return GTK_WIDGET (image);
+}
+
 #ifndef GDK_PIXBUF_MAGIC_NUMBER
 #define GDK_PIXBUF_MAGIC_NUMBER (0x47646b50)    /* 'GdkP' */
 #endif
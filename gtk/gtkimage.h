@@ -107,6 +107,10 @@ GtkWidget* gtk_image_new                (void);
 GDK_AVAILABLE_IN_ALL
 GtkWidget* gtk_image_new_from_file      (const gchar     *filename);
 GDK_AVAILABLE_IN_ALL
+GtkWidget* gtk_image_new_from_file_async (const gchar    *filename,
+                                          int             width,
+                                          int             height);
+GDK_AVAILABLE_IN_ALL
 GtkWidget* gtk_image_new_from_resource  (const gchar     *resource_path);
 GDK_AVAILABLE_IN_ALL
 GtkWidget* gtk_image_new_from_pixbuf    (GdkPixbuf       *pixbuf);
@@ -125,6 +129,11 @@ GDK_AVAILABLE_IN_ALL
 void gtk_image_set_from_file      (GtkImage        *image,
                                    const gchar     *filename);
 GDK_AVAILABLE_IN_ALL
+void gtk_image_set_from_file_async (GtkImage       *image,
+                                    const gchar    *filename,
+                                    int             width,
+                                    int             height);
+GDK_AVAILABLE_IN_ALL
 void gtk_image_set_from_resource  (GtkImage        *image,
                                    const gchar     *resource_path);
 GDK_AVAILABLE_IN_ALL
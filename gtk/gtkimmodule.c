@@ -395,8 +395,10 @@ gtk_im_module_initialize (void)
   GString *line_buf = g_string_new (NULL);
   GString *tmp_buf = g_string_new (NULL);
   gchar *filename = gtk_get_im_module_file();
-  FILE *file;
+  GMappedFile *file;
+  const char *pos, *end;
   gboolean have_error = FALSE;
+  gint64 profile_start = _gtk_profile_start ();
 
   GtkIMModule *module = NULL;
   GSList *infos = NULL;
@@ -463,7 +465,11 @@ gtk_im_module_initialize (void)
 
 #undef do_builtin
 
-  file = g_fopen (filename, "r");
+  /* Map the registry instead of streaming it; the whole file is
+   * parsed in one pass over the mapping, without any read syscalls
+   * or stdio buffering
+   */
+  file = g_mapped_file_new (filename, FALSE, NULL);
   if (!file)
     {
       /* In case someone wants only the default input method,
@@ -472,10 +478,14 @@ gtk_im_module_initialize (void)
       g_string_free (line_buf, TRUE);
       g_string_free (tmp_buf, TRUE);
       g_free (filename);
+      _gtk_profile_mark (profile_start, "im-module-load", NULL);
       return;
     }
 
-  while (!have_error && gtk_read_line (file, line_buf))
+  pos = g_mapped_file_get_contents (file);
+  end = pos + g_mapped_file_get_length (file);
+
+  while (!have_error && gtk_read_line_from_string (&pos, end, line_buf))
     {
       const char *p;
 
@@ -563,10 +573,12 @@ gtk_im_module_initialize (void)
   else if (module)
     add_module (module, infos);
 
-  fclose (file);
+  g_mapped_file_unref (file);
   g_string_free (line_buf, TRUE);
   g_string_free (tmp_buf, TRUE);
   g_free (filename);
+
+  _gtk_profile_mark (profile_start, "im-module-load", NULL);
 }
 
 static gint
@@ -218,3 +218,59 @@ gtk_kinetic_scrolling_tick (GtkKineticScrolling *data,
   return data->phase != GTK_KINETIC_SCROLLING_PHASE_FINISHED;
 }
 
+/*
+ * gtk_kinetic_scrolling_predict:
+ * @data: kinetic scrolling state
+ * @time_ahead: how far into the future to look, in seconds
+ * @position: (out) (optional): predicted position
+ * @velocity: (out) (optional): predicted velocity
+ *
+ * Evaluates the deceleration curve @time_ahead seconds after the last
+ * tick, without advancing the state. Since the curves are closed-form,
+ * this is exact, not an extrapolation. The predicted position is
+ * clamped to the scrollable range, so callers can use it directly to
+ * prepare content that is about to come on screen.
+ */
+void
+gtk_kinetic_scrolling_predict (GtkKineticScrolling *data,
+                               gdouble              time_ahead,
+                               gdouble             *position,
+                               gdouble             *velocity)
+{
+  gdouble pos, vel;
+
+  switch (data->phase)
+    {
+    case GTK_KINETIC_SCROLLING_PHASE_DECELERATING:
+      {
+        gdouble exp_part = exp (-data->decel_friction * (data->t + time_ahead));
+
+        pos = data->c1 + data->c2 * exp_part;
+        vel = -data->decel_friction * data->c2 * exp_part;
+        break;
+      }
+
+    case GTK_KINETIC_SCROLLING_PHASE_OVERSHOOTING:
+      {
+        gdouble t = data->t + time_ahead;
+        gdouble exp_part = exp (-data->overshoot_friction / 2 * t);
+        gdouble rel = exp_part * (data->c1 + data->c2 * t);
+
+        pos = rel + data->equilibrium_position;
+        vel = data->c2 * exp_part - data->overshoot_friction / 2 * rel;
+        break;
+      }
+
+    case GTK_KINETIC_SCROLLING_PHASE_FINISHED:
+    default:
+      pos = data->position;
+      vel = 0;
+      break;
+    }
+
+  if (position)
+    *position = CLAMP (pos, data->lower, data->upper);
+  if (velocity)
+    *velocity = vel;
+}
+
@@ -38,6 +38,11 @@ gboolean                 gtk_kinetic_scrolling_tick (GtkKineticScrolling  *data,
                                                      gdouble               time_delta,
                                                      gdouble              *position);
 
+void                     gtk_kinetic_scrolling_predict (GtkKineticScrolling *data,
+                                                        gdouble              time_ahead,
+                                                        gdouble             *position,
+                                                        gdouble             *velocity);
+
 G_END_DECLS
 
 #endif /* __GTK_KINETIC_SCROLLING_H__ */
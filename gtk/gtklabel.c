@@ -280,6 +280,14 @@ struct _GtkLabelPrivate
   gint     width_chars;
   gint     max_width_chars;
   gint     lines;
+
+  /* Cache of the last height-for-width measurement; -1 width means
+   * invalid. Size negotiation often asks for the same width several
+   * times per allocation cycle, and each miss re-wraps the layout.
+   */
+  gint     hfw_width;
+  gint     hfw_height;
+  gint     hfw_baseline;
 };
 
 /* Notes about the handling of links:
@@ -1299,6 +1307,8 @@ gtk_label_init (GtkLabel *label)
   priv->mnemonic_window = NULL;
 
   priv->mnemonics_visible = TRUE;
+
+  priv->hfw_width = -1;
 }
 
 
@@ -3193,6 +3203,7 @@ gtk_label_clear_layout (GtkLabel *label)
   GtkLabelPrivate *priv = gtk_label_get_instance_private (label);
 
   g_clear_object (&priv->layout);
+  priv->hfw_width = -1;
 }
 
 /**
@@ -3322,6 +3333,9 @@ gtk_label_update_layout_attributes (GtkLabel *label)
 
   pango_layout_set_attributes (priv->layout, attrs);
 
+  /* The new attributes may change the extents */
+  priv->hfw_width = -1;
+
   if (attrs)
     pango_attr_list_unref (attrs);
   if (style_attrs)
@@ -3579,9 +3593,23 @@ gtk_label_measure (GtkWidget      *widget,
 
   if (orientation == GTK_ORIENTATION_VERTICAL && for_size != -1 && priv->wrap)
     {
+      if (priv->hfw_width == for_size)
+        {
+          /* Same width as last time, the layout has not changed in
+           * between (that resets the cache), so neither has the height.
+           */
+          *minimum = *natural = priv->hfw_height;
+          *minimum_baseline = *natural_baseline = priv->hfw_baseline;
+          return;
+        }
+
       gtk_label_clear_layout (label);
 
       get_height_for_width (label, for_size, minimum, natural, minimum_baseline, natural_baseline);
+
+      priv->hfw_width = for_size;
+      priv->hfw_height = *minimum;
+      priv->hfw_baseline = *minimum_baseline;
     }
   else
     gtk_label_get_preferred_size (widget, orientation, minimum, natural, minimum_baseline, natural_baseline);
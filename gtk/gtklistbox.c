@@ -3478,6 +3478,15 @@ gtk_list_box_buildable_interface_init (GtkBuildableIface *iface)
   iface->add_child = gtk_list_box_buildable_add_child;
 }
 
+/* If you are tempted to only create widgets for the rows that are
+ * scrolled into view and recycle them as the adjustment moves: the
+ * GtkListBox API hands out real row widgets for every item — via
+ * gtk_list_box_get_row_at_index(), headers, selection and the row
+ * signals — so rows cannot be materialized lazily behind the caller's
+ * back. Virtualizing has to happen on the model side, by binding a
+ * model that only contains the currently relevant window of the full
+ * data set and sliding that window from the scroll position.
+ */
 static void
 gtk_list_box_bound_model_changed (GListModel *list,
                                   guint       position,
@@ -3489,12 +3498,24 @@ gtk_list_box_bound_model_changed (GListModel *list,
   GtkListBoxPrivate *priv = BOX_PRIV (user_data);
   guint i;
 
-  while (removed--)
+  if (removed > 0)
     {
-      GtkListBoxRow *row;
+      GSequenceIter *iter;
+
+      /* With a bound model there is no sort function, so the sequence
+       * order matches the model order and we can walk it directly
+       * instead of looking up the same position over and over.
+       */
+      iter = g_sequence_get_iter_at_pos (priv->children, position);
 
-      row = gtk_list_box_get_row_at_index (box, position);
-      gtk_container_remove (GTK_CONTAINER (box), GTK_WIDGET (row));
+      while (removed--)
+        {
+          GtkWidget *row = g_sequence_get (iter);
+
+          /* Grab the next iter before the removal invalidates this one */
+          iter = g_sequence_iter_next (iter);
+          gtk_container_remove (GTK_CONTAINER (box), row);
+        }
     }
 
   for (i = 0; i < added; i++)
@@ -3558,6 +3579,10 @@ gtk_list_box_check_model_compat (GtkListBox *box)
  * Note that using a model is incompatible with the filtering and sorting
  * functionality in GtkListBox. When using a model, filtering and sorting
  * should be implemented by the model.
+ *
+ * A row widget is created for every item in @model up front. For very
+ * large data sets, bind a model that exposes only the currently
+ * relevant window of the data instead of the whole set.
  */
 void
 gtk_list_box_bind_model (GtkListBox                 *box,
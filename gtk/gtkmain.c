@@ -97,6 +97,8 @@
 
 #include <locale.h>
 
+#include <pango/pangocairo.h>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -115,6 +117,7 @@
 
 #include "gtkaccelmapprivate.h"
 #include "gtkbox.h"
+#include "gtkcssselectorprivate.h"
 #include "gtkdebug.h"
 #include "gtkdebugupdatesprivate.h"
 #include "gtkdndprivate.h"
@@ -170,7 +173,9 @@ static const GDebugKey gtk_debug_keys[] = {
   { "actions", GTK_DEBUG_ACTIONS },
   { "resize", GTK_DEBUG_RESIZE },
   { "layout", GTK_DEBUG_LAYOUT },
-  { "snapshot", GTK_DEBUG_SNAPSHOT }
+  { "snapshot", GTK_DEBUG_SNAPSHOT },
+  { "profile", GTK_DEBUG_PROFILE },
+  { "css-stats", GTK_DEBUG_CSS_STATS }
 };
 #endif /* G_ENABLE_DEBUG */
 
@@ -614,10 +619,65 @@ gettext_initialization (void)
 #endif
 }
 
+/* Loading the default font in a worker thread makes fontconfig build
+ * or read its caches there, instead of stalling the GUI thread for
+ * the resolution (100ms+ with cold caches) at the first text draw.
+ * The thread gets its own per-thread pango font map, but the warmed
+ * fontconfig state is process global.
+ */
+static gpointer
+font_prewarm_thread (gpointer data)
+{
+  char *font_name = data;
+  PangoFontMap *font_map;
+  PangoContext *context;
+  PangoFontDescription *font_desc;
+  PangoFont *font;
+
+  font_map = pango_cairo_font_map_get_default ();
+  context = pango_font_map_create_context (font_map);
+  font_desc = pango_font_description_from_string (font_name);
+
+  font = pango_font_map_load_font (font_map, context, font_desc);
+  g_clear_object (&font);
+
+  pango_font_description_free (font_desc);
+  g_object_unref (context);
+  g_free (font_name);
+
+  return NULL;
+}
+
+static void
+gtk_font_prewarm (void)
+{
+  static gboolean prewarmed = FALSE;
+  GtkSettings *settings;
+  char *font_name = NULL;
+  GThread *thread;
+
+  if (prewarmed)
+    return;
+
+  settings = gtk_settings_get_default ();
+  if (settings == NULL)
+    return;
+
+  g_object_get (settings, "gtk-font-name", &font_name, NULL);
+  if (font_name == NULL)
+    return;
+
+  prewarmed = TRUE;
+
+  thread = g_thread_new ("gtk-font-prewarm", font_prewarm_thread, font_name);
+  g_thread_unref (thread);
+}
+
 static void
 default_display_notify_cb (GdkDisplayManager *dm)
 {
   _gtk_accessibility_init ();
+  gtk_font_prewarm ();
   debug_flags[0].display = gdk_display_get_default ();
 }
 
@@ -625,10 +685,13 @@ static void
 do_post_parse_initialization (void)
 {
   GdkDisplayManager *display_manager;
+  gint64 profile_start;
 
   if (gtk_initialized)
     return;
 
+  profile_start = _gtk_profile_start ();
+
   gettext_initialization ();
 
 #ifdef SIGPIPE
@@ -659,11 +722,21 @@ do_post_parse_initialization (void)
 
   display_manager = gdk_display_manager_get ();
   if (gdk_display_manager_get_default_display (display_manager) != NULL)
-    _gtk_accessibility_init ();
+    {
+      _gtk_accessibility_init ();
+      gtk_font_prewarm ();
+    }
 
   g_signal_connect (display_manager, "notify::default-display",
                     G_CALLBACK (default_display_notify_cb),
                     NULL);
+
+#ifdef G_ENABLE_DEBUG
+  if (GTK_DEBUG_CHECK (CSS_STATS))
+    atexit (_gtk_css_selector_stats_print);
+#endif
+
+  _gtk_profile_mark (profile_start, "gtk-init", NULL);
 }
 
 guint
@@ -726,6 +799,47 @@ gtk_set_debug_flags (guint flags)
   gtk_set_display_debug_flags (gdk_display_get_default (), flags);
 }
 
+/* Returns the current monotonic time if GTK_DEBUG=profile is active,
+ * or 0 otherwise. Pass the result to _gtk_profile_mark() after the
+ * work being measured; keeping the timestamp on the caller's stack
+ * means tracepoints can nest freely.
+ */
+gint64
+_gtk_profile_start (void)
+{
+#ifdef G_ENABLE_DEBUG
+  if (GTK_DEBUG_CHECK (PROFILE))
+    return g_get_monotonic_time ();
+#endif
+
+  return 0;
+}
+
+/* Emits one machine-readable tracepoint line on stderr:
+ *
+ *   gtk-profile TAB mark TAB detail TAB start-time TAB duration
+ *
+ * with times in monotonic microseconds. Does nothing when @start_time
+ * is 0, i.e. when profiling was not active at _gtk_profile_start()
+ * time. For point events, pass a freshly taken start time.
+ */
+void
+_gtk_profile_mark (gint64      start_time,
+                   const char *mark,
+                   const char *detail)
+{
+#ifdef G_ENABLE_DEBUG
+  if (start_time == 0)
+    return;
+
+  g_printerr ("gtk-profile\t%s\t%s\t%" G_GINT64_FORMAT "\t%" G_GINT64_FORMAT "\n",
+              mark,
+              detail ? detail : "",
+              start_time,
+              g_get_monotonic_time () - start_time);
+#endif
+}
+
 gboolean
 gtk_simulate_touchscreen (void)
 {
@@ -0,0 +1,278 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkmaplistmodel.h"
+
+#include "gtkintl.h"
+
+/**
+ * SECTION:gtkmaplistmodel
+ * @title: GtkMapListModel
+ * @short_description: A list model that transforms its items
+ * @see_also: #GListModel
+ *
+ * #GtkMapListModel is a list model that takes a list model and maps each
+ * item in the list with a map function to produce the item it exposes.
+ *
+ * Because positions are unchanged by mapping, a change of @n items in the
+ * original model results in a change of exactly @n items in the map model,
+ * so consumers only have to rebind the affected rows.
+ *
+ * Items are mapped on demand in gtk_map_list_model_get_item() and the
+ * results are not cached, so the map function may be called more than
+ * once for the same position.
+ */
+
+struct _GtkMapListModel
+{
+  GObject parent_instance;
+
+  GListModel *model;
+  GtkMapListModelMapFunc map_func;
+  gpointer user_data;
+  GDestroyNotify user_destroy;
+};
+
+enum {
+  PROP_0,
+  PROP_MODEL,
+  NUM_PROPERTIES
+};
+
+static GParamSpec *properties[NUM_PROPERTIES] = { NULL, };
+
+static GType
+gtk_map_list_model_get_item_type (GListModel *list)
+{
+  return G_TYPE_OBJECT;
+}
+
+static guint
+gtk_map_list_model_get_n_items (GListModel *list)
+{
+  GtkMapListModel *self = GTK_MAP_LIST_MODEL (list);
+
+  if (self->model == NULL)
+    return 0;
+
+  return g_list_model_get_n_items (self->model);
+}
+
+static gpointer
+gtk_map_list_model_get_item (GListModel *list,
+                             guint       position)
+{
+  GtkMapListModel *self = GTK_MAP_LIST_MODEL (list);
+  gpointer item;
+
+  if (self->model == NULL)
+    return NULL;
+
+  item = g_list_model_get_item (self->model, position);
+  if (item == NULL)
+    return NULL;
+
+  if (self->map_func == NULL)
+    return item;
+
+  return self->map_func (item, self->user_data);
+}
+
+static void
+gtk_map_list_model_model_init (GListModelInterface *iface)
+{
+  iface->get_item_type = gtk_map_list_model_get_item_type;
+  iface->get_n_items = gtk_map_list_model_get_n_items;
+  iface->get_item = gtk_map_list_model_get_item;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GtkMapListModel, gtk_map_list_model, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL, gtk_map_list_model_model_init))
+
+static void
+gtk_map_list_model_items_changed_cb (GListModel      *model,
+                                     guint            position,
+                                     guint            removed,
+                                     guint            added,
+                                     GtkMapListModel *self)
+{
+  g_list_model_items_changed (G_LIST_MODEL (self), position, removed, added);
+}
+
+static void
+gtk_map_list_model_get_property (GObject     *object,
+                                 guint        prop_id,
+                                 GValue      *value,
+                                 GParamSpec  *pspec)
+{
+  GtkMapListModel *self = GTK_MAP_LIST_MODEL (object);
+
+  switch (prop_id)
+    {
+    case PROP_MODEL:
+      g_value_set_object (value, self->model);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+gtk_map_list_model_clear_map_func (GtkMapListModel *self)
+{
+  if (self->user_destroy)
+    self->user_destroy (self->user_data);
+
+  self->map_func = NULL;
+  self->user_data = NULL;
+  self->user_destroy = NULL;
+}
+
+static void
+gtk_map_list_model_dispose (GObject *object)
+{
+  GtkMapListModel *self = GTK_MAP_LIST_MODEL (object);
+
+  if (self->model)
+    {
+      g_signal_handlers_disconnect_by_func (self->model,
+                                            gtk_map_list_model_items_changed_cb,
+                                            self);
+      g_clear_object (&self->model);
+    }
+
+  gtk_map_list_model_clear_map_func (self);
+
+  G_OBJECT_CLASS (gtk_map_list_model_parent_class)->dispose (object);
+}
+
+static void
+gtk_map_list_model_class_init (GtkMapListModelClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->get_property = gtk_map_list_model_get_property;
+  gobject_class->dispose = gtk_map_list_model_dispose;
+
+  /**
+   * GtkMapListModel:model:
+   *
+   * The model being mapped
+   */
+  properties[PROP_MODEL] =
+      g_param_spec_object ("model",
+                           P_("Model"),
+                           P_("The model being mapped"),
+                           G_TYPE_LIST_MODEL,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
+}
+
+static void
+gtk_map_list_model_init (GtkMapListModel *self)
+{
+}
+
+/**
+ * gtk_map_list_model_new:
+ * @model: (transfer none): The model to map
+ * @map_func: (allow-none): map function or %NULL to not map items
+ * @user_data: (closure): user data passed to @map_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Creates a new #GtkMapListModel for the given arguments.
+ *
+ * Returns: a new #GtkMapListModel
+ */
+GtkMapListModel *
+gtk_map_list_model_new (GListModel             *model,
+                        GtkMapListModelMapFunc  map_func,
+                        gpointer                user_data,
+                        GDestroyNotify          user_destroy)
+{
+  GtkMapListModel *self;
+
+  g_return_val_if_fail (G_IS_LIST_MODEL (model), NULL);
+
+  self = g_object_new (GTK_TYPE_MAP_LIST_MODEL, NULL);
+
+  self->model = g_object_ref (model);
+  g_signal_connect (model, "items-changed",
+                    G_CALLBACK (gtk_map_list_model_items_changed_cb), self);
+
+  self->map_func = map_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  return self;
+}
+
+/**
+ * gtk_map_list_model_set_map_func:
+ * @self: a #GtkMapListModel
+ * @map_func: (allow-none): map function or %NULL to not map items
+ * @user_data: (closure): user data passed to @map_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Sets the function used to map items. The function will be called
+ * whenever an item needs to be mapped and must return the item to
+ * use for the original item.
+ *
+ * Note that #GtkMapListModel may call this function multiple times
+ * for the same item, because the results are not cached.
+ */
+void
+gtk_map_list_model_set_map_func (GtkMapListModel        *self,
+                                 GtkMapListModelMapFunc  map_func,
+                                 gpointer                user_data,
+                                 GDestroyNotify          user_destroy)
+{
+  guint n_items;
+
+  g_return_if_fail (GTK_IS_MAP_LIST_MODEL (self));
+
+  gtk_map_list_model_clear_map_func (self);
+
+  self->map_func = map_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (self));
+  if (n_items > 0)
+    g_list_model_items_changed (G_LIST_MODEL (self), 0, n_items, n_items);
+}
+
+/**
+ * gtk_map_list_model_get_model:
+ * @self: a #GtkMapListModel
+ *
+ * Gets the model that is currently being mapped.
+ *
+ * Returns: (transfer none): The model that gets mapped
+ */
+GListModel *
+gtk_map_list_model_get_model (GtkMapListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_MAP_LIST_MODEL (self), NULL);
+
+  return self->model;
+}
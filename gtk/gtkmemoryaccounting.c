@@ -0,0 +1,150 @@
+/*
+ * Copyright © 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkmemoryaccountingprivate.h"
+
+/* An opt-in accounting layer that attributes live allocation volume to
+ * GTypes, so the inspector's statistics page can show bytes next to
+ * instance counts. Instrumented call sites report their instance (or
+ * auxiliary buffer) sizes as they come and go; we keep a running sum
+ * per type.
+ *
+ * Accounting is enabled by setting GTK_MEMORY_ACCOUNTING in the
+ * environment; when it is not set, the hooks reduce to a single
+ * branch.
+ */
+
+static GHashTable *usage;  /* GType => live bytes */
+
+G_LOCK_DEFINE_STATIC (usage);
+
+/*< private >
+ * gtk_memory_accounting_enabled:
+ *
+ * Checks whether allocation accounting was requested via the
+ * GTK_MEMORY_ACCOUNTING environment variable.
+ *
+ * Returns: %TRUE if allocations are being accounted
+ */
+gboolean
+gtk_memory_accounting_enabled (void)
+{
+  static gsize enabled = 0;
+
+  if (g_once_init_enter (&enabled))
+    g_once_init_leave (&enabled, g_getenv ("GTK_MEMORY_ACCOUNTING") != NULL ? 2 : 1);
+
+  return enabled == 2;
+}
+
+/*< private >
+ * gtk_memory_accounting_add:
+ * @type: the type to attribute the allocation to
+ * @bytes: size of the allocation; negative when freeing
+ *
+ * Records @bytes of allocation volume against @type. Call sites must
+ * pair every positive contribution with a matching negative one when
+ * the memory is released.
+ */
+void
+gtk_memory_accounting_add (GType  type,
+                           gssize bytes)
+{
+  gssize value;
+
+  if (!gtk_memory_accounting_enabled ())
+    return;
+
+  G_LOCK (usage);
+
+  if (usage == NULL)
+    usage = g_hash_table_new (NULL, NULL);
+
+  value = (gssize) g_hash_table_lookup (usage, GSIZE_TO_POINTER (type));
+  value += bytes;
+  g_hash_table_insert (usage, GSIZE_TO_POINTER (type), GSIZE_TO_POINTER (value));
+
+  G_UNLOCK (usage);
+}
+
+/*< private >
+ * gtk_memory_accounting_add_instance:
+ * @instance: a #GTypeInstance
+ *
+ * Attributes the instance size (including private data) of @instance
+ * to its type. Meant to be called from instance init functions, paired
+ * with gtk_memory_accounting_remove_instance() in finalize.
+ */
+void
+gtk_memory_accounting_add_instance (gpointer instance)
+{
+  GTypeQuery query;
+
+  if (!gtk_memory_accounting_enabled ())
+    return;
+
+  g_type_query (G_TYPE_FROM_INSTANCE (instance), &query);
+  gtk_memory_accounting_add (query.type, query.instance_size);
+}
+
+/*< private >
+ * gtk_memory_accounting_remove_instance:
+ * @instance: a #GTypeInstance
+ *
+ * Undoes the attribution made by gtk_memory_accounting_add_instance().
+ */
+void
+gtk_memory_accounting_remove_instance (gpointer instance)
+{
+  GTypeQuery query;
+
+  if (!gtk_memory_accounting_enabled ())
+    return;
+
+  g_type_query (G_TYPE_FROM_INSTANCE (instance), &query);
+  gtk_memory_accounting_add (query.type, - (gssize) query.instance_size);
+}
+
+/*< private >
+ * gtk_memory_accounting_get:
+ * @type: a type
+ *
+ * Gets the live allocation volume attributed to @type. This only
+ * counts the instrumented call sites, not every malloc made on behalf
+ * of instances of @type.
+ *
+ * Returns: live bytes attributed to @type
+ */
+gsize
+gtk_memory_accounting_get (GType type)
+{
+  gssize value = 0;
+
+  if (!gtk_memory_accounting_enabled ())
+    return 0;
+
+  G_LOCK (usage);
+
+  if (usage)
+    value = (gssize) g_hash_table_lookup (usage, GSIZE_TO_POINTER (type));
+
+  G_UNLOCK (usage);
+
+  return value > 0 ? (gsize) value : 0;
+}
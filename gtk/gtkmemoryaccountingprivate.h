@@ -0,0 +1,36 @@
+/*
+ * Copyright © 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTK_MEMORY_ACCOUNTING_PRIVATE_H__
+#define __GTK_MEMORY_ACCOUNTING_PRIVATE_H__
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+gboolean gtk_memory_accounting_enabled         (void);
+
+void     gtk_memory_accounting_add             (GType    type,
+                                                gssize   bytes);
+void     gtk_memory_accounting_add_instance    (gpointer instance);
+void     gtk_memory_accounting_remove_instance (gpointer instance);
+
+gsize    gtk_memory_accounting_get             (GType    type);
+
+G_END_DECLS
+
+#endif /* __GTK_MEMORY_ACCOUNTING_PRIVATE_H__ */
@@ -46,6 +46,9 @@ struct _GtkMenuSectionBox
   guint              separator_sync_idle;
   gboolean           iconic;
   gint               depth;
+
+  /* Submenu item whose contents we only build on first map */
+  GtkMenuTrackerItem *deferred_item;
 };
 
 typedef struct
@@ -366,6 +369,7 @@ gtk_menu_section_box_dispose (GObject *object)
     }
 
   g_clear_object (&box->separator);
+  g_clear_object (&box->deferred_item);
 
   if (box->tracker)
     {
@@ -376,10 +380,34 @@ gtk_menu_section_box_dispose (GObject *object)
   G_OBJECT_CLASS (gtk_menu_section_box_parent_class)->dispose (object);
 }
 
+static void
+gtk_menu_section_box_map (GtkWidget *widget)
+{
+  GtkMenuSectionBox *box = GTK_MENU_SECTION_BOX (widget);
+
+  /* Submenu pages start out as empty placeholders in the stack and
+   * only get their contents when the user first navigates to them,
+   * so a deeply nested menu model doesn't cost widgets for the pages
+   * that are never visited. Populate before chaining up so the new
+   * children take part in the map.
+   */
+  if (box->deferred_item)
+    {
+      box->tracker = gtk_menu_tracker_new_for_item_link (box->deferred_item, G_MENU_LINK_SUBMENU, FALSE, FALSE,
+                                                         gtk_menu_section_box_insert_func,
+                                                         gtk_menu_section_box_remove_func,
+                                                         box);
+      g_clear_object (&box->deferred_item);
+    }
+
+  GTK_WIDGET_CLASS (gtk_menu_section_box_parent_class)->map (widget);
+}
+
 static void
 gtk_menu_section_box_class_init (GtkMenuSectionBoxClass *class)
 {
   G_OBJECT_CLASS (class)->dispose = gtk_menu_section_box_dispose;
+  GTK_WIDGET_CLASS (class)->map = gtk_menu_section_box_map;
 }
 
 static void
@@ -462,10 +490,11 @@ gtk_menu_section_box_new_submenu (GtkMenuTrackerItem *item,
   gtk_stack_add_named (GTK_STACK (gtk_widget_get_ancestor (GTK_WIDGET (toplevel), GTK_TYPE_STACK)),
                        GTK_WIDGET (box), gtk_menu_tracker_item_get_label (item));
 
-  box->tracker = gtk_menu_tracker_new_for_item_link (item, G_MENU_LINK_SUBMENU, FALSE, FALSE,
-                                                     gtk_menu_section_box_insert_func,
-                                                     gtk_menu_section_box_remove_func,
-                                                     box);
+  /* The tracker materializes the submenu's item widgets, so hold off
+   * on creating it until the page is first opened; see
+   * gtk_menu_section_box_map().
+   */
+  box->deferred_item = g_object_ref (item);
 }
 
 static GtkWidget *
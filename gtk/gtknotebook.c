@@ -149,6 +149,10 @@
 #define TIMEOUT_REPEAT    50
 #define TIMEOUT_EXPAND   500
 
+/* Time in µs the prevalidate idle may spend measuring pages per run */
+#define PREVALIDATE_BUDGET 2000
+#define GTK_NOTEBOOK_PRIORITY_PREVALIDATE (GDK_PRIORITY_REDRAW + 5)
+
 typedef struct _GtkNotebookPage GtkNotebookPage;
 
 typedef enum
@@ -205,6 +209,8 @@ struct _GtkNotebookPrivate
 
   guint32        timer;
 
+  guint          prevalidate_idle;
+
   guint          child_has_focus    : 1;
   guint          click_child        : 3;
   guint          remove_in_detach   : 1;
@@ -302,6 +308,7 @@ struct _GtkNotebookPage
   guint fill         : 1;
   guint reorderable  : 1;
   guint detachable   : 1;
+  guint prevalidated : 1;       /* child has been pre-measured from idle */
 
   GtkRequisition requisition;
 
@@ -355,7 +362,9 @@ static void gtk_notebook_dispose             (GObject         *object);
 
 /*** GtkWidget Methods ***/
 static void gtk_notebook_destroy             (GtkWidget        *widget);
+static void gtk_notebook_map                 (GtkWidget        *widget);
 static void gtk_notebook_unmap               (GtkWidget        *widget);
+static void gtk_notebook_schedule_prevalidate (GtkNotebook     *notebook);
 static void gtk_notebook_measure (GtkWidget      *widget,
                                   GtkOrientation  orientation,
                                   int             for_size,
@@ -669,6 +678,7 @@ gtk_notebook_class_init (GtkNotebookClass *class)
   gobject_class->dispose = gtk_notebook_dispose;
 
   widget_class->destroy = gtk_notebook_destroy;
+  widget_class->map = gtk_notebook_map;
   widget_class->unmap = gtk_notebook_unmap;
   widget_class->measure = gtk_notebook_measure;
   widget_class->size_allocate = gtk_notebook_size_allocate;
@@ -1583,6 +1593,12 @@ gtk_notebook_destroy (GtkWidget *widget)
 
   remove_switch_tab_timer (notebook);
 
+  if (priv->prevalidate_idle)
+    {
+      g_source_remove (priv->prevalidate_idle);
+      priv->prevalidate_idle = 0;
+    }
+
   GTK_WIDGET_CLASS (gtk_notebook_parent_class)->destroy (widget);
 }
 
@@ -1669,6 +1685,14 @@ gtk_notebook_get_tab_area_position (GtkNotebook  *notebook,
   return FALSE;
 }
 
+static void
+gtk_notebook_map (GtkWidget *widget)
+{
+  GTK_WIDGET_CLASS (gtk_notebook_parent_class)->map (widget);
+
+  gtk_notebook_schedule_prevalidate (GTK_NOTEBOOK (widget));
+}
+
 static void
 gtk_notebook_unmap (GtkWidget *widget)
 {
@@ -3973,6 +3997,59 @@ allocate_tab (GtkGizmo            *gizmo,
   gtk_widget_size_allocate (page->tab_label, &child_allocation, baseline, out_clip);
 }
 
+/* Measuring and styling a big page for the first time can take long
+ * enough to make the first switch to its tab hitch. After the current
+ * page is up we measure the remaining pages from an idle handler that
+ * runs below redraws, a few at a time within a small budget, so that
+ * switching tabs later only has to allocate.
+ */
+static gboolean
+gtk_notebook_prevalidate_cb (gpointer data)
+{
+  GtkNotebook *notebook = data;
+  GtkNotebookPrivate *priv = notebook->priv;
+  gint64 budget_end = g_get_monotonic_time () + PREVALIDATE_BUDGET;
+  GList *list;
+
+  for (list = priv->children; list; list = list->next)
+    {
+      GtkNotebookPage *page = list->data;
+      gint unused;
+
+      if (page->prevalidated ||
+          page == priv->cur_page ||
+          !gtk_widget_get_visible (page->child))
+        continue;
+
+      gtk_widget_measure (page->child, GTK_ORIENTATION_HORIZONTAL, -1,
+                          &unused, &unused, NULL, NULL);
+      gtk_widget_measure (page->child, GTK_ORIENTATION_VERTICAL, -1,
+                          &unused, &unused, NULL, NULL);
+      page->prevalidated = TRUE;
+
+      if (g_get_monotonic_time () >= budget_end)
+        return G_SOURCE_CONTINUE;
+    }
+
+  priv->prevalidate_idle = 0;
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gtk_notebook_schedule_prevalidate (GtkNotebook *notebook)
+{
+  GtkNotebookPrivate *priv = notebook->priv;
+
+  if (priv->prevalidate_idle ||
+      !gtk_widget_get_mapped (GTK_WIDGET (notebook)))
+    return;
+
+  priv->prevalidate_idle = g_idle_add_full (GTK_NOTEBOOK_PRIORITY_PREVALIDATE,
+                                            gtk_notebook_prevalidate_cb,
+                                            notebook, NULL);
+  g_source_set_name_by_id (priv->prevalidate_idle, "[gtk+] gtk_notebook_prevalidate_cb");
+}
+
 static gint
 gtk_notebook_real_insert_page (GtkNotebook *notebook,
                                GtkWidget   *child,
@@ -4093,6 +4170,8 @@ gtk_notebook_real_insert_page (GtkNotebook *notebook,
 
   update_arrow_state (notebook);
 
+  gtk_notebook_schedule_prevalidate (notebook);
+
   /* The page-added handler might have reordered the pages, re-get the position */
   return gtk_notebook_page_num (notebook, child);
 }
@@ -5413,6 +5492,8 @@ gtk_notebook_real_switch_page (GtkNotebook     *notebook,
   gtk_widget_queue_resize (GTK_WIDGET (notebook));
   gtk_widget_queue_resize (priv->tabs_widget);
   g_object_notify_by_pspec (G_OBJECT (notebook), properties[PROP_PAGE]);
+
+  gtk_notebook_schedule_prevalidate (notebook);
 }
 
 /* Private GtkNotebook Page Switch Functions:
@@ -134,6 +134,11 @@ struct _GtkPlacesSidebar {
   GtkSettings       *gtk_settings;
   GFile             *current_location;
 
+  /* Cached row data for mounts, so rebuilding the row set doesn't
+   * re-resolve mount locations on the main thread every time */
+  GHashTable        *mount_info_cache;
+  guint              update_places_idle_id;
+
   GtkWidget *rename_popover;
   GtkWidget *rename_entry;
   GtkWidget *rename_button;
@@ -906,6 +911,71 @@ update_trash_icon (GtkPlacesSidebar *sidebar)
     }
 }
 
+typedef struct {
+  gchar *name;
+  gchar *uri;
+  gchar *tooltip;
+  GIcon *start_icon;
+} MountInfo;
+
+static void
+mount_info_free (gpointer data)
+{
+  MountInfo *info = data;
+
+  g_free (info->name);
+  g_free (info->uri);
+  g_free (info->tooltip);
+  g_object_unref (info->start_icon);
+  g_free (info);
+}
+
+/* Resolving the default location of a mount can hit the filesystem
+ * (e.g. autofs mounts that are slow to answer), so do it once per mount
+ * and keep the result until the volume monitor reports a change.
+ */
+static MountInfo *
+get_mount_info (GtkPlacesSidebar *sidebar,
+                GMount           *mount)
+{
+  MountInfo *info;
+
+  if (sidebar->mount_info_cache == NULL)
+    sidebar->mount_info_cache = g_hash_table_new_full (NULL, NULL,
+                                                       g_object_unref,
+                                                       mount_info_free);
+
+  info = g_hash_table_lookup (sidebar->mount_info_cache, mount);
+  if (info == NULL)
+    {
+      GFile *root;
+
+      root = g_mount_get_default_location (mount);
+
+      info = g_new0 (MountInfo, 1);
+      info->name = g_mount_get_name (mount);
+      info->uri = g_file_get_uri (root);
+      info->tooltip = g_file_get_parse_name (root);
+      info->start_icon = g_mount_get_symbolic_icon (mount);
+
+      g_object_unref (root);
+
+      g_hash_table_insert (sidebar->mount_info_cache,
+                           g_object_ref (mount), info);
+    }
+
+  return info;
+}
+
+static void
+on_mount_info_invalidated (GVolumeMonitor   *volume_monitor,
+                           GMount           *mount,
+                           GtkPlacesSidebar *sidebar)
+{
+  if (sidebar->mount_info_cache)
+    g_hash_table_remove (sidebar->mount_info_cache, mount);
+}
+
 #ifdef HAVE_CLOUDPROVIDERS
 
 static gboolean
@@ -1126,7 +1196,7 @@ update_places (GtkPlacesSidebar *sidebar)
     {
       cloud_provider = CLOUD_PROVIDERS_PROVIDER (l->data);
       g_signal_connect_swapped (cloud_provider, "accounts-changed",
-                                G_CALLBACK (update_places), sidebar);
+                                G_CALLBACK (queue_update_places), sidebar);
       cloud_providers_accounts = cloud_providers_provider_get_accounts (cloud_provider);
       for (ll = cloud_providers_accounts; ll != NULL; ll = ll->next)
         {
@@ -1183,25 +1253,18 @@ update_places (GtkPlacesSidebar *sidebar)
               mount = g_volume_get_mount (volume);
               if (mount != NULL)
                 {
-                  char *mount_uri;
+                  MountInfo *mount_info;
 
                   /* Show mounted volume in the sidebar */
-                  start_icon = g_mount_get_symbolic_icon (mount);
-                  root = g_mount_get_default_location (mount);
-                  mount_uri = g_file_get_uri (root);
-                  name = g_mount_get_name (mount);
-                  tooltip = g_file_get_parse_name (root);
+                  mount_info = get_mount_info (sidebar, mount);
 
                   add_place (sidebar, PLACES_MOUNTED_VOLUME,
                              SECTION_MOUNTS,
-                             name, start_icon, NULL, mount_uri,
-                             drive, volume, mount, NULL, 0, tooltip);
-                  g_object_unref (root);
+                             mount_info->name, mount_info->start_icon,
+                             NULL, mount_info->uri,
+                             drive, volume, mount, NULL, 0,
+                             mount_info->tooltip);
                   g_object_unref (mount);
-                  g_object_unref (start_icon);
-                  g_free (tooltip);
-                  g_free (name);
-                  g_free (mount_uri);
                 }
               else
                 {
@@ -1289,23 +1352,15 @@ update_places (GtkPlacesSidebar *sidebar)
       mount = g_volume_get_mount (volume);
       if (mount != NULL)
         {
-          char *mount_uri;
+          MountInfo *mount_info;
 
-          start_icon = g_mount_get_symbolic_icon (mount);
-          root = g_mount_get_default_location (mount);
-          mount_uri = g_file_get_uri (root);
-          tooltip = g_file_get_parse_name (root);
-          name = g_mount_get_name (mount);
+          mount_info = get_mount_info (sidebar, mount);
           add_place (sidebar, PLACES_MOUNTED_VOLUME,
                      SECTION_MOUNTS,
-                     name, start_icon, NULL, mount_uri,
-                     NULL, volume, mount, NULL, 0, tooltip);
+                     mount_info->name, mount_info->start_icon,
+                     NULL, mount_info->uri,
+                     NULL, volume, mount, NULL, 0, mount_info->tooltip);
           g_object_unref (mount);
-          g_object_unref (root);
-          g_object_unref (start_icon);
-          g_free (name);
-          g_free (tooltip);
-          g_free (mount_uri);
         }
       else
         {
@@ -1340,7 +1395,7 @@ update_places (GtkPlacesSidebar *sidebar)
 
   for (l = mounts; l != NULL; l = l->next)
     {
-      char *mount_uri;
+      MountInfo *mount_info;
 
       mount = l->data;
       if (g_mount_is_shadowed (mount))
@@ -1363,21 +1418,15 @@ update_places (GtkPlacesSidebar *sidebar)
           g_object_unref (root);
           continue;
         }
+      g_object_unref (root);
 
-      start_icon = g_mount_get_symbolic_icon (mount);
-      mount_uri = g_file_get_uri (root);
-      name = g_mount_get_name (mount);
-      tooltip = g_file_get_parse_name (root);
+      mount_info = get_mount_info (sidebar, mount);
       add_place (sidebar, PLACES_MOUNTED_VOLUME,
                  SECTION_COMPUTER,
-                 name, start_icon, NULL, mount_uri,
-                 NULL, NULL, mount, NULL, 0, tooltip);
-      g_object_unref (root);
+                 mount_info->name, mount_info->start_icon,
+                 NULL, mount_info->uri,
+                 NULL, NULL, mount, NULL, 0, mount_info->tooltip);
       g_object_unref (mount);
-      g_object_unref (start_icon);
-      g_free (name);
-      g_free (mount_uri);
-      g_free (tooltip);
     }
   g_list_free (mounts);
 
@@ -1457,23 +1506,15 @@ update_places (GtkPlacesSidebar *sidebar)
       network_mounts = g_list_reverse (network_mounts);
       for (l = network_mounts; l != NULL; l = l->next)
         {
-          char *mount_uri;
+          MountInfo *mount_info;
 
           mount = l->data;
-          root = g_mount_get_default_location (mount);
-          start_icon = g_mount_get_symbolic_icon (mount);
-          mount_uri = g_file_get_uri (root);
-          name = g_mount_get_name (mount);
-          tooltip = g_file_get_parse_name (root);
+          mount_info = get_mount_info (sidebar, mount);
           add_place (sidebar, PLACES_MOUNTED_VOLUME,
                      SECTION_MOUNTS,
-                     name, start_icon, NULL, mount_uri,
-                     NULL, NULL, mount, NULL, 0, tooltip);
-          g_object_unref (root);
-          g_object_unref (start_icon);
-          g_free (name);
-          g_free (mount_uri);
-          g_free (tooltip);
+                     mount_info->name, mount_info->start_icon,
+                     NULL, mount_info->uri,
+                     NULL, NULL, mount, NULL, 0, mount_info->tooltip);
         }
     }
 
@@ -1509,6 +1550,28 @@ update_places (GtkPlacesSidebar *sidebar)
     }
 }
 
+static gboolean
+update_places_idle_cb (gpointer data)
+{
+  GtkPlacesSidebar *sidebar = data;
+
+  sidebar->update_places_idle_id = 0;
+  update_places (sidebar);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Volume monitor and bookmark signals tend to come in bursts (e.g. one
+ * per mount when a drive appears), so coalesce them into a single
+ * rebuild instead of rebuilding the row set from each signal handler.
+ */
+static void
+queue_update_places (GtkPlacesSidebar *sidebar)
+{
+  if (sidebar->update_places_idle_id == 0)
+    sidebar->update_places_idle_id = g_idle_add (update_places_idle_cb, sidebar);
+}
+
 static gboolean
 check_valid_drop_target (GtkPlacesSidebar *sidebar,
                          GtkSidebarRow    *row,
@@ -3918,7 +3981,7 @@ update_hostname (GtkPlacesSidebar *sidebar)
     {
       g_free (sidebar->hostname);
       sidebar->hostname = g_strdup (hostname);
-      update_places (sidebar);
+      queue_update_places (sidebar);
     }
 
   g_variant_unref (variant);
@@ -3965,23 +4028,28 @@ create_volume_monitor (GtkPlacesSidebar *sidebar)
   sidebar->volume_monitor = g_volume_monitor_get ();
 
   g_signal_connect_object (sidebar->volume_monitor, "volume_added",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "volume_removed",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "volume_changed",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "mount_added",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "mount_removed",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "mount_changed",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "drive_disconnected",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "drive_connected",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
   g_signal_connect_object (sidebar->volume_monitor, "drive_changed",
-                           G_CALLBACK (update_places), sidebar, G_CONNECT_SWAPPED);
+                           G_CALLBACK (queue_update_places), sidebar, G_CONNECT_SWAPPED);
+
+  g_signal_connect_object (sidebar->volume_monitor, "mount_changed",
+                           G_CALLBACK (on_mount_info_invalidated), sidebar, 0);
+  g_signal_connect_object (sidebar->volume_monitor, "mount_removed",
+                           G_CALLBACK (on_mount_info_invalidated), sidebar, 0);
 }
 
 static void
@@ -4003,7 +4071,7 @@ shell_shows_desktop_changed (GtkSettings *settings,
   if (show_desktop != sidebar->show_desktop)
     {
       sidebar->show_desktop = show_desktop;
-      update_places (sidebar);
+      queue_update_places (sidebar);
       g_object_notify_by_pspec (G_OBJECT (sidebar), properties[PROP_SHOW_DESKTOP]);
     }
 }
@@ -4023,7 +4091,7 @@ gtk_places_sidebar_init (GtkPlacesSidebar *sidebar)
 
   sidebar->open_flags = GTK_PLACES_OPEN_NORMAL;
 
-  sidebar->bookmarks_manager = _gtk_bookmarks_manager_new ((GtkBookmarksChangedFunc)update_places, sidebar);
+  sidebar->bookmarks_manager = _gtk_bookmarks_manager_new ((GtkBookmarksChangedFunc)queue_update_places, sidebar);
 
   sidebar->trash_monitor = _gtk_trash_monitor_get ();
   sidebar->trash_monitor_changed_id = g_signal_connect_swapped (sidebar->trash_monitor, "trash-state-changed",
@@ -4120,7 +4188,7 @@ gtk_places_sidebar_init (GtkPlacesSidebar *sidebar)
   sidebar->cloud_manager = cloud_providers_collector_dup_singleton ();
   g_signal_connect_swapped (sidebar->cloud_manager,
                             "providers-changed",
-                            G_CALLBACK (update_places),
+                            G_CALLBACK (queue_update_places),
                             sidebar);
 #endif
 
@@ -4300,13 +4368,23 @@ gtk_places_sidebar_dispose (GObject *object)
       sidebar->trash_row = NULL;
     }
 
+  if (sidebar->update_places_idle_id != 0)
+    {
+      g_source_remove (sidebar->update_places_idle_id);
+      sidebar->update_places_idle_id = 0;
+    }
+
   if (sidebar->volume_monitor != NULL)
     {
       g_signal_handlers_disconnect_by_func (sidebar->volume_monitor,
-                                            update_places, sidebar);
+                                            queue_update_places, sidebar);
+      g_signal_handlers_disconnect_by_func (sidebar->volume_monitor,
+                                            on_mount_info_invalidated, sidebar);
       g_clear_object (&sidebar->volume_monitor);
     }
 
+  g_clear_pointer (&sidebar->mount_info_cache, g_hash_table_unref);
+
   if (sidebar->hostnamed_cancellable != NULL)
     {
       g_cancellable_cancel (sidebar->hostnamed_cancellable);
@@ -60,6 +60,13 @@
  * #GtkPrintOperation::draw-page, which you are supposed to catch
  * and render the page on the provided #GtkPrintContext using Cairo.
  *
+ * Pages are not kept in memory while the document is produced: each
+ * page is written to the platform’s spool file (a temporary PDF or
+ * PostScript file, with compressed content streams where the format
+ * supports them) as soon as its ::draw-page handler returns, so peak
+ * memory use is bounded by a single page regardless of the number of
+ * pages in the document.
+ *
  * # The high-level printing API
  *
  * |[<!-- language="C" -->
@@ -102,6 +102,11 @@ GtkWidget *     _gtk_toplevel_pick (GtkWindow *toplevel,
 gdouble _gtk_get_slowdown (void);
 void    _gtk_set_slowdown (gdouble slowdown_factor);
 
+gint64  _gtk_profile_start (void);
+void    _gtk_profile_mark  (gint64      start_time,
+                            const char *mark,
+                            const char *detail);
+
 gboolean gtk_should_use_portal (void);
 
 #ifdef G_OS_WIN32
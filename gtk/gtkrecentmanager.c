@@ -165,6 +165,7 @@ struct _GtkRecentManagerPrivate
   gchar *filename;
 
   guint is_dirty : 1;
+  guint loaded : 1;     /* whether the bookmark file has been read */
 
   gint size;
 
@@ -174,6 +175,9 @@ struct _GtkRecentManagerPrivate
 
   guint changed_timeout;
   guint changed_age;
+
+  time_t last_write_time; /* mtime and size of our own last dump, used */
+  gint64 last_write_size; /* to avoid re-parsing the file we just wrote */
 };
 
 enum
@@ -216,6 +220,7 @@ static void     gtk_recent_manager_enabled_changed     (GtkRecentManager  *manag
 
 
 static void     build_recent_items_list                (GtkRecentManager  *manager);
+static void     ensure_items_list                      (GtkRecentManager  *manager);
 static void     purge_recent_items_list                (GtkRecentManager  *manager,
                                                         GError           **error);
 
@@ -368,6 +373,7 @@ gtk_recent_manager_get_property (GObject    *object,
       g_value_set_string (value, recent_manager->priv->filename);
       break;
     case PROP_SIZE:
+      ensure_items_list (recent_manager);
       g_value_set_int (value, recent_manager->priv->size);
       break;
     default:
@@ -507,6 +513,21 @@ gtk_recent_manager_real_changed (GtkRecentManager *manager)
                          g_strerror (errno));
               g_free (utf8);
             }
+
+          else
+            {
+              GStatBuf stat_buf;
+
+              /* remember what we just dumped, so the file monitor
+               * callback can tell our own write apart from changes
+               * made by other applications
+               */
+              if (g_stat (priv->filename, &stat_buf) == 0)
+                {
+                  priv->last_write_time = stat_buf.st_mtime;
+                  priv->last_write_size = stat_buf.st_size;
+                }
+            }
         }
 
       /* mark us as clean */
@@ -514,11 +535,27 @@ gtk_recent_manager_real_changed (GtkRecentManager *manager)
     }
   else
     {
+      GStatBuf stat_buf;
+
       /* we are not marked as dirty, so we have been called
        * because the recently used resources file has been
        * changed (and not from us).
        */
-      build_recent_items_list (manager);
+      if (!priv->loaded)
+        {
+          /* nobody has looked at the list yet; keep the load deferred */
+        }
+      else if (priv->filename != NULL &&
+               g_stat (priv->filename, &stat_buf) == 0 &&
+               stat_buf.st_mtime == priv->last_write_time &&
+               stat_buf.st_size == priv->last_write_size)
+        {
+          /* the monitor fired for our own write and the file still
+           * matches what we last dumped, so don't parse it again
+           */
+        }
+      else
+        build_recent_items_list (manager);
     }
 
   g_object_thaw_notify (G_OBJECT (manager));
@@ -645,7 +682,22 @@ gtk_recent_manager_set_filename (GtkRecentManager *manager,
       g_object_unref (file);
     }
 
-  build_recent_items_list (manager);
+  /* the initial load is deferred until the list is actually accessed,
+   * so applications that never use the recently used list don't pay
+   * for parsing the file at every startup
+   */
+  if (priv->loaded)
+    build_recent_items_list (manager);
+}
+
+/* Makes sure the bookmark file has been read, for the benefit of the
+ * entry points that access the items list directly.
+ */
+static void
+ensure_items_list (GtkRecentManager *manager)
+{
+  if (!manager->priv->loaded)
+    build_recent_items_list (manager);
 }
 
 /* reads the recently used resources file and builds the items list.
@@ -660,6 +712,8 @@ build_recent_items_list (GtkRecentManager *manager)
   GError *read_error;
   gint size;
 
+  priv->loaded = TRUE;
+
   if (!priv->recent_items)
     {
       priv->recent_items = g_bookmark_file_new ();
@@ -955,6 +1009,8 @@ gtk_recent_manager_add_full (GtkRecentManager    *manager,
 
   priv = manager->priv;
 
+  ensure_items_list (manager);
+
   if (!priv->recent_items)
     {
       priv->recent_items = g_bookmark_file_new ();
@@ -1023,6 +1079,8 @@ gtk_recent_manager_remove_item (GtkRecentManager  *manager,
 
   priv = manager->priv;
 
+  ensure_items_list (manager);
+
   if (!priv->recent_items)
     {
       priv->recent_items = g_bookmark_file_new ();
@@ -1075,7 +1133,10 @@ gtk_recent_manager_has_item (GtkRecentManager *manager,
   g_return_val_if_fail (uri != NULL, FALSE);
 
   priv = manager->priv;
-  g_return_val_if_fail (priv->recent_items != NULL, FALSE);
+
+  ensure_items_list (manager);
+  if (priv->recent_items == NULL)
+    return FALSE;
 
   return g_bookmark_file_has_item (priv->recent_items, uri);
 }
@@ -1169,6 +1230,9 @@ gtk_recent_manager_lookup_item (GtkRecentManager  *manager,
   g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
   priv = manager->priv;
+
+  ensure_items_list (manager);
+
   if (!priv->recent_items)
     {
       priv->recent_items = g_bookmark_file_new ();
@@ -1232,6 +1296,8 @@ gtk_recent_manager_move_item (GtkRecentManager  *recent_manager,
 
   priv = recent_manager->priv;
 
+  ensure_items_list (recent_manager);
+
   if (!priv->recent_items)
     {
       g_set_error (error, GTK_RECENT_MANAGER_ERROR,
@@ -1293,6 +1359,8 @@ gtk_recent_manager_get_items (GtkRecentManager *manager)
   g_return_val_if_fail (GTK_IS_RECENT_MANAGER (manager), NULL);
 
   priv = manager->priv;
+
+  ensure_items_list (manager);
   if (!priv->recent_items)
     return NULL;
 
@@ -1350,6 +1418,8 @@ gtk_recent_manager_purge_items (GtkRecentManager  *manager,
   g_return_val_if_fail (GTK_IS_RECENT_MANAGER (manager), -1);
 
   priv = manager->priv;
+
+  ensure_items_list (manager);
   if (!priv->recent_items)
     return 0;
 
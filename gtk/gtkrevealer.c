@@ -294,12 +294,16 @@ effective_transition (GtkRevealer *revealer)
   return priv->transition_type;
 }
 
+/* The child is always allocated at 0,0 and full size; the animated
+ * offset for the slide transitions is applied when snapshotting, so
+ * the child is never re-laid out as the reveal progresses and its
+ * render node stays valid for the whole animation.
+ */
 static void
 gtk_revealer_get_child_allocation (GtkRevealer         *revealer,
                                    const GtkAllocation *allocation,
                                    GtkAllocation       *child_allocation)
 {
-  GtkRevealerPrivate *priv = gtk_revealer_get_instance_private (revealer);
   GtkWidget *child;
   GtkRevealerTransitionType transition;
 
@@ -328,23 +332,6 @@ gtk_revealer_get_child_allocation (GtkRevealer         *revealer,
 
       child_allocation->width = MAX (child_allocation->width, allocation->width);
       child_allocation->height = MAX (child_allocation->height, allocation->height);
-
-      switch (transition)
-        {
-        case GTK_REVEALER_TRANSITION_TYPE_SLIDE_RIGHT:
-            child_allocation->x = - child_allocation->width * (1 - priv->current_pos);
-          break;
-        case GTK_REVEALER_TRANSITION_TYPE_SLIDE_DOWN:
-            child_allocation->y = - child_allocation->height * (1 - priv->current_pos);
-          break;
-
-        case GTK_REVEALER_TRANSITION_TYPE_NONE:
-        case GTK_REVEALER_TRANSITION_TYPE_CROSSFADE:
-        case GTK_REVEALER_TRANSITION_TYPE_SLIDE_LEFT:
-        case GTK_REVEALER_TRANSITION_TYPE_SLIDE_UP:
-        default:
-          break;
-        }
     }
 
 }
@@ -634,14 +621,47 @@ gtk_revealer_snapshot (GtkWidget   *widget,
     }
   else
     {
+      GtkAllocation allocation;
+      GtkAllocation child_allocation;
+      int x, y;
+
+      allocation.x = 0;
+      allocation.y = 0;
+      allocation.width = gtk_widget_get_width (widget);
+      allocation.height = gtk_widget_get_height (widget);
+
+      gtk_revealer_get_child_allocation (revealer, &allocation, &child_allocation);
+
+      /* The child is anchored at 0,0; shift it so the revealed part
+       * is the trailing edge for the transitions that slide towards it.
+       */
+      x = 0;
+      y = 0;
+      if (transition == GTK_REVEALER_TRANSITION_TYPE_SLIDE_RIGHT)
+        x = allocation.width - child_allocation.width;
+      else if (transition == GTK_REVEALER_TRANSITION_TYPE_SLIDE_DOWN)
+        y = allocation.height - child_allocation.height;
+
       gtk_snapshot_push_clip (snapshot,
                               &GRAPHENE_RECT_INIT(
                                   0, 0,
-                                  gtk_widget_get_width (widget),
-                                  gtk_widget_get_height (widget)
+                                  allocation.width,
+                                  allocation.height
                               ),
                               "RevealerClip");
-      gtk_widget_snapshot_child (widget, child, snapshot);
+
+      if (x != 0 || y != 0)
+        {
+          graphene_matrix_t matrix;
+
+          graphene_matrix_init_translate (&matrix, &GRAPHENE_POINT3D_INIT (x, y, 0));
+          gtk_snapshot_push_transform (snapshot, &matrix, "RevealerSlide");
+          gtk_widget_snapshot_child (widget, child, snapshot);
+          gtk_snapshot_pop (snapshot);
+        }
+      else
+        gtk_widget_snapshot_child (widget, child, snapshot);
+
       gtk_snapshot_pop (snapshot);
     }
 }
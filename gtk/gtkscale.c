@@ -1999,7 +1999,7 @@ marks_text (GMarkupParseContext  *context,
 {
   MarksSubparserData *data = (MarksSubparserData*)user_data;
 
-  if (strcmp (g_markup_parse_context_get_element (context), "mark") == 0)
+  if (strcmp (_gtk_builder_parser_get_element (context), "mark") == 0)
     {
       MarkData *mark = data->marks->data;
 
@@ -314,3 +314,32 @@ gtk_scrollable_get_border (GtkScrollable *scrollable,
 
   return FALSE;
 }
+
+/**
+ * gtk_scrollable_anticipate_scroll:
+ * @scrollable: a #GtkScrollable
+ * @hvalue: the predicted value of the horizontal adjustment
+ * @vvalue: the predicted value of the vertical adjustment
+ *
+ * Tells the scrollable where an ongoing scroll animation is expected
+ * to be a few frames from now. Scrollables with expensive lazy layout,
+ * like #GtkTreeView or #GtkTextView, can use this to validate the
+ * content that is about to come on screen ahead of time, so the
+ * animation does not stutter when it gets there.
+ *
+ * This is a hint: scrollables are free to ignore it, and ignoring it
+ * never affects what ends up on screen, only how smoothly it gets
+ * there. #GtkScrolledWindow calls this during kinetic deceleration.
+ *
+ * Since: 3.90
+ */
+void
+gtk_scrollable_anticipate_scroll (GtkScrollable *scrollable,
+                                  gdouble        hvalue,
+                                  gdouble        vvalue)
+{
+  g_return_if_fail (GTK_IS_SCROLLABLE (scrollable));
+
+  if (GTK_SCROLLABLE_GET_IFACE (scrollable)->anticipate_scroll)
+    GTK_SCROLLABLE_GET_IFACE (scrollable)->anticipate_scroll (scrollable, hvalue, vvalue);
+}
@@ -41,8 +41,11 @@ struct _GtkScrollableInterface
 {
   GTypeInterface base_iface;
 
-  gboolean (* get_border) (GtkScrollable *scrollable,
-                           GtkBorder     *border);
+  gboolean (* get_border)        (GtkScrollable *scrollable,
+                                  GtkBorder     *border);
+  void     (* anticipate_scroll) (GtkScrollable *scrollable,
+                                  gdouble        hvalue,
+                                  gdouble        vvalue);
 };
 
 /* Public API */
@@ -73,6 +76,11 @@ GDK_AVAILABLE_IN_ALL
 gboolean             gtk_scrollable_get_border             (GtkScrollable       *scrollable,
                                                             GtkBorder           *border);
 
+GDK_AVAILABLE_IN_ALL
+void                 gtk_scrollable_anticipate_scroll      (GtkScrollable       *scrollable,
+                                                            gdouble              hvalue,
+                                                            gdouble              vvalue);
+
 G_END_DECLS
 
 #endif /* __GTK_SCROLLABLE_H__ */
@@ -3241,6 +3241,7 @@ scrolled_window_deceleration_cb (GtkWidget         *widget,
   GtkScrolledWindow *scrolled_window = data->scrolled_window;
   GtkScrolledWindowPrivate *priv = scrolled_window->priv;
   GtkAdjustment *hadjustment, *vadjustment;
+  GtkWidget *child;
   gint64 current_time;
   gdouble position, elapsed;
 
@@ -3277,6 +3278,30 @@ scrolled_window_deceleration_cb (GtkWidget         *widget,
       return G_SOURCE_REMOVE;
     }
 
+  /* Tell the child where the fling will be a couple of frames from
+   * now, so scrollables with lazy layout can validate the content
+   * that is about to come on screen before the animation reaches it.
+   */
+  child = gtk_bin_get_child (GTK_BIN (scrolled_window));
+  if (child != NULL && GTK_IS_SCROLLABLE (child))
+    {
+      gint64 refresh_interval;
+      gdouble time_ahead, hvalue, vvalue;
+
+      gdk_frame_clock_get_refresh_info (frame_clock, current_time,
+                                        &refresh_interval, NULL);
+      time_ahead = 2 * refresh_interval / (gdouble) G_USEC_PER_SEC;
+
+      hvalue = gtk_adjustment_get_value (hadjustment);
+      vvalue = gtk_adjustment_get_value (vadjustment);
+      if (data->hscrolling)
+        gtk_kinetic_scrolling_predict (data->hscrolling, time_ahead, &hvalue, NULL);
+      if (data->vscrolling)
+        gtk_kinetic_scrolling_predict (data->vscrolling, time_ahead, &vvalue, NULL);
+
+      gtk_scrollable_anticipate_scroll (GTK_SCROLLABLE (child), hvalue, vvalue);
+    }
+
   gtk_scrolled_window_invalidate_overshoot (scrolled_window);
 
   return G_SOURCE_CONTINUE;
@@ -3298,6 +3323,14 @@ gtk_scrolled_window_cancel_deceleration (GtkScrolledWindow *scrolled_window)
 static void
 kinetic_scroll_data_free (KineticScrollData *data)
 {
+  GtkScrolledWindowPrivate *priv = data->scrolled_window->priv;
+
+  /* fling is over, go back to notifying synchronously */
+  if (priv->hscrollbar)
+    gtk_adjustment_set_batch_updates (gtk_scrollbar_get_adjustment (GTK_SCROLLBAR (priv->hscrollbar)), FALSE);
+  if (priv->vscrollbar)
+    gtk_adjustment_set_batch_updates (gtk_scrollbar_get_adjustment (GTK_SCROLLBAR (priv->vscrollbar)), FALSE);
+
   if (data->hscrolling)
     gtk_kinetic_scrolling_free (data->hscrolling);
   if (data->vscrolling)
@@ -3359,6 +3392,11 @@ gtk_scrolled_window_start_deceleration (GtkScrolledWindow *scrolled_window)
                                    priv->y_velocity);
     }
 
+  /* While the fling lasts, coalesce the multiple value updates per frame
+   * into one notification at layout phase */
+  gtk_adjustment_set_batch_updates (gtk_scrollbar_get_adjustment (GTK_SCROLLBAR (priv->hscrollbar)), TRUE);
+  gtk_adjustment_set_batch_updates (gtk_scrollbar_get_adjustment (GTK_SCROLLBAR (priv->vscrollbar)), TRUE);
+
   scrolled_window->priv->deceleration_id =
     gtk_widget_add_tick_callback (GTK_WIDGET (scrolled_window),
                                   scrolled_window_deceleration_cb, data,
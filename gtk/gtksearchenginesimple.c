@@ -32,6 +32,8 @@
 #include <string.h>
 
 #define BATCH_SIZE 500
+#define MAX_SEARCH_THREADS 4
+#define DIRECTORY_CACHE_MAX_DIRS 4096
 
 typedef struct
 {
@@ -40,6 +42,11 @@ typedef struct
 
   GQueue *directories;
 
+  GMutex lock;
+  GCond cond;
+  guint n_threads;   /* worker threads still running */
+  guint n_visiting;  /* workers currently enumerating a directory */
+
   gint n_processed_files;
   GList *hits;
 
@@ -47,6 +54,32 @@ typedef struct
   gboolean recursive;
 } SearchThreadData;
 
+/* Cached listing of a directory, so repeated searches over the same
+ * tree don't have to enumerate it again. Entries are validated against
+ * the directory's mtime, which changes whenever files are added to or
+ * removed from it; metadata of unchanged entries may be slightly stale
+ * until then.
+ */
+typedef struct
+{
+  guint64 mtime;
+  GPtrArray *files;  /* GFile */
+  GPtrArray *infos;  /* GFileInfo */
+} CachedDirectory;
+
+static GHashTable *directory_cache = NULL;  /* uri -> CachedDirectory */
+G_LOCK_DEFINE_STATIC (directory_cache);
+
+static void
+cached_directory_free (gpointer data)
+{
+  CachedDirectory *cached = data;
+
+  g_ptr_array_unref (cached->files);
+  g_ptr_array_unref (cached->infos);
+  g_free (cached);
+}
+
 
 struct _GtkSearchEngineSimple
 {
@@ -95,7 +128,12 @@ queue_if_local (SearchThreadData *data,
   if (file &&
       !_gtk_file_consider_as_remote (file) &&
       !g_file_has_uri_scheme (file, "recent"))
-    g_queue_push_tail (data->directories, g_object_ref (file));
+    {
+      g_mutex_lock (&data->lock);
+      g_queue_push_tail (data->directories, g_object_ref (file));
+      g_cond_signal (&data->cond);
+      g_mutex_unlock (&data->lock);
+    }
 }
 
 static SearchThreadData *
@@ -110,6 +148,14 @@ search_thread_data_new (GtkSearchEngineSimple *engine,
   data->directories = g_queue_new ();
   data->query = g_object_ref (query);
   data->recursive = _gtk_search_engine_get_recursive (GTK_SEARCH_ENGINE (engine));
+  g_mutex_init (&data->lock);
+  g_cond_init (&data->cond);
+
+  /* Force the lazy word split in the query now, while we are still
+   * single-threaded; the workers only read it afterwards.
+   */
+  gtk_query_matches_string (query, "");
+
   queue_if_local (data, gtk_query_get_location (query));
 
   data->cancellable = g_cancellable_new ();
@@ -122,6 +168,8 @@ search_thread_data_free (SearchThreadData *data)
 {
   g_queue_foreach (data->directories, (GFunc)g_object_unref, NULL);
   g_queue_free (data->directories);
+  g_mutex_clear (&data->lock);
+  g_cond_clear (&data->cond);
   g_object_unref (data->cancellable);
   g_object_unref (data->query);
   g_object_unref (data->engine);
@@ -139,7 +187,8 @@ search_thread_done_idle (gpointer user_data)
   if (!g_cancellable_is_cancelled (data->cancellable))
     _gtk_search_engine_finished (GTK_SEARCH_ENGINE (data->engine));
 
-  data->engine->active_search = NULL;
+  if (data->engine->active_search == data)
+    data->engine->active_search = NULL;
   search_thread_data_free (data);
 
   return FALSE;
@@ -165,6 +214,7 @@ search_thread_add_hits_idle (gpointer user_data)
   return FALSE;
 }
 
+/* Called with data->lock held */
 static void
 send_batch (SearchThreadData *data)
 {
@@ -206,6 +256,103 @@ is_indexed (GtkSearchEngineSimple *engine,
   return FALSE;
 }
 
+static void
+process_file (SearchThreadData *data,
+              GFile            *child,
+              GFileInfo        *info)
+{
+  if (gtk_query_matches_string (data->query, g_file_info_get_display_name (info)))
+    {
+      GtkSearchHit *hit;
+
+      hit = g_new (GtkSearchHit, 1);
+      hit->file = g_object_ref (child);
+      hit->info = g_object_ref (info);
+
+      g_mutex_lock (&data->lock);
+      data->hits = g_list_prepend (data->hits, hit);
+      g_mutex_unlock (&data->lock);
+    }
+
+  g_mutex_lock (&data->lock);
+  data->n_processed_files++;
+  if (data->n_processed_files > BATCH_SIZE)
+    send_batch (data);
+  g_mutex_unlock (&data->lock);
+
+  if (data->recursive &&
+      g_file_info_get_file_type (info) == G_FILE_TYPE_DIRECTORY &&
+      !is_indexed (data->engine, child))
+    queue_if_local (data, child);
+}
+
+static guint64
+get_directory_mtime (GFile        *dir,
+                     GCancellable *cancellable)
+{
+  GFileInfo *info;
+  guint64 mtime = 0;
+
+  info = g_file_query_info (dir,
+                            G_FILE_ATTRIBUTE_TIME_MODIFIED,
+                            G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS,
+                            cancellable, NULL);
+  if (info)
+    {
+      mtime = g_file_info_get_attribute_uint64 (info, G_FILE_ATTRIBUTE_TIME_MODIFIED);
+      g_object_unref (info);
+    }
+
+  return mtime;
+}
+
+static gboolean
+visit_directory_cached (GFile            *dir,
+                        SearchThreadData *data,
+                        guint64           mtime)
+{
+  CachedDirectory *cached;
+  GPtrArray *files, *infos;
+  gchar *uri;
+  guint i;
+
+  uri = g_file_get_uri (dir);
+
+  G_LOCK (directory_cache);
+
+  if (directory_cache)
+    cached = g_hash_table_lookup (directory_cache, uri);
+  else
+    cached = NULL;
+
+  g_free (uri);
+
+  if (cached == NULL || cached->mtime != mtime)
+    {
+      G_UNLOCK (directory_cache);
+      return FALSE;
+    }
+
+  files = g_ptr_array_ref (cached->files);
+  infos = g_ptr_array_ref (cached->infos);
+
+  G_UNLOCK (directory_cache);
+
+  for (i = 0; i < files->len; i++)
+    {
+      if (g_cancellable_is_cancelled (data->cancellable))
+        break;
+
+      process_file (data, g_ptr_array_index (files, i),
+                    g_ptr_array_index (infos, i));
+    }
+
+  g_ptr_array_unref (files);
+  g_ptr_array_unref (infos);
+
+  return TRUE;
+}
+
 static void
 visit_directory (GFile *dir, SearchThreadData *data)
 {
@@ -213,6 +360,19 @@ visit_directory (GFile *dir, SearchThreadData *data)
   GFileInfo *info;
   GFile *child;
   const gchar *display_name;
+  GPtrArray *files, *infos;
+  guint64 mtime = 0;
+
+  /* Only native directories can be validated by mtime; don't bother
+   * caching the rest.
+   */
+  if (g_file_is_native (dir))
+    {
+      mtime = get_directory_mtime (dir, data->cancellable);
+
+      if (mtime != 0 && visit_directory_cached (dir, data, mtime))
+        return;
+    }
 
   enumerator = g_file_enumerate_children (dir,
                                           G_FILE_ATTRIBUTE_STANDARD_NAME ","
@@ -233,6 +393,9 @@ visit_directory (GFile *dir, SearchThreadData *data)
   if (enumerator == NULL)
     return;
 
+  files = g_ptr_array_new_with_free_func (g_object_unref);
+  infos = g_ptr_array_new_with_free_func (g_object_unref);
+
   while (g_file_enumerator_iterate (enumerator, &info, &child, data->cancellable, NULL))
     {
       if (info == NULL)
@@ -245,27 +408,39 @@ visit_directory (GFile *dir, SearchThreadData *data)
       if (g_file_info_get_is_hidden (info))
         continue;
 
-      if (gtk_query_matches_string (data->query, display_name))
-        {
-          GtkSearchHit *hit;
+      g_ptr_array_add (files, g_object_ref (child));
+      g_ptr_array_add (infos, g_object_ref (info));
 
-          hit = g_new (GtkSearchHit, 1);
-          hit->file = g_object_ref (child);
-          hit->info = g_object_ref (info);
-          data->hits = g_list_prepend (data->hits, hit);
-        }
+      process_file (data, child, info);
+    }
 
-      data->n_processed_files++;
-      if (data->n_processed_files > BATCH_SIZE)
-        send_batch (data);
+  g_object_unref (enumerator);
+
+  if (mtime != 0 && !g_cancellable_is_cancelled (data->cancellable))
+    {
+      CachedDirectory *cached;
 
-      if (data->recursive &&
-          g_file_info_get_file_type (info) == G_FILE_TYPE_DIRECTORY &&
-          !is_indexed (data->engine, child))
-        queue_if_local (data, child);
+      cached = g_new (CachedDirectory, 1);
+      cached->mtime = mtime;
+      cached->files = g_ptr_array_ref (files);
+      cached->infos = g_ptr_array_ref (infos);
+
+      G_LOCK (directory_cache);
+
+      if (directory_cache == NULL)
+        directory_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, cached_directory_free);
+
+      if (g_hash_table_size (directory_cache) < DIRECTORY_CACHE_MAX_DIRS)
+        g_hash_table_replace (directory_cache, g_file_get_uri (dir), cached);
+      else
+        cached_directory_free (cached);
+
+      G_UNLOCK (directory_cache);
     }
 
-  g_object_unref (enumerator);
+  g_ptr_array_unref (files);
+  g_ptr_array_unref (infos);
 }
 
 static gpointer
@@ -273,22 +448,56 @@ search_thread_func (gpointer user_data)
 {
   SearchThreadData *data;
   GFile *dir;
-  guint id;
 
   data = user_data;
 
-  while (!g_cancellable_is_cancelled (data->cancellable) &&
-         (dir = g_queue_pop_head (data->directories)) != NULL)
+  g_mutex_lock (&data->lock);
+
+  while (!g_cancellable_is_cancelled (data->cancellable))
     {
+      dir = g_queue_pop_head (data->directories);
+      if (dir == NULL)
+        {
+          /* The search is done once no directories are queued and
+           * nobody is visiting one that could queue more.
+           */
+          if (data->n_visiting == 0)
+            break;
+
+          g_cond_wait (&data->cond, &data->lock);
+          continue;
+        }
+
+      data->n_visiting++;
+      g_mutex_unlock (&data->lock);
+
       visit_directory (dir, data);
       g_object_unref (dir);
+
+      g_mutex_lock (&data->lock);
+      data->n_visiting--;
+      if (data->n_visiting == 0)
+        g_cond_broadcast (&data->cond);
     }
 
-  if (!g_cancellable_is_cancelled (data->cancellable))
-    send_batch (data);
+  data->n_threads--;
+  if (data->n_threads == 0)
+    {
+      guint id;
+
+      if (!g_cancellable_is_cancelled (data->cancellable))
+        send_batch (data);
+
+      g_mutex_unlock (&data->lock);
 
-  id = g_idle_add (search_thread_done_idle, data);
-  g_source_set_name_by_id (id, "[gtk+] search_thread_done_idle");
+      id = g_idle_add (search_thread_done_idle, data);
+      g_source_set_name_by_id (id, "[gtk+] search_thread_done_idle");
+    }
+  else
+    {
+      g_cond_broadcast (&data->cond);
+      g_mutex_unlock (&data->lock);
+    }
 
   return NULL;
 }
@@ -298,6 +507,7 @@ gtk_search_engine_simple_start (GtkSearchEngine *engine)
 {
   GtkSearchEngineSimple *simple;
   SearchThreadData *data;
+  guint i;
 
   simple = GTK_SEARCH_ENGINE_SIMPLE (engine);
 
@@ -309,7 +519,9 @@ gtk_search_engine_simple_start (GtkSearchEngine *engine)
 
   data = search_thread_data_new (simple, simple->query);
 
-  g_thread_unref (g_thread_new ("file-search", search_thread_func, data));
+  data->n_threads = MIN (MAX_SEARCH_THREADS, g_get_num_processors ());
+  for (i = 0; i < data->n_threads; i++)
+    g_thread_unref (g_thread_new ("file-search", search_thread_func, data));
 
   simple->active_search = data;
 }
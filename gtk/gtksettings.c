@@ -255,6 +255,7 @@ gtk_settings_init (GtkSettings *settings)
   guint i = 0;
   gchar *path;
   const gchar * const *config_dirs;
+  gint64 profile_start;
 
   priv = gtk_settings_get_instance_private (settings);
   settings->priv = priv;
@@ -293,6 +294,8 @@ gtk_settings_init (GtkSettings *settings)
     }
   g_free (pspecs);
 
+  profile_start = _gtk_profile_start ();
+
   path = g_build_filename (_gtk_get_data_prefix (), "share", "gtk-4.0", "settings.ini", NULL);
   if (g_file_test (path, G_FILE_TEST_EXISTS))
     gtk_settings_load_from_key_file (settings, path, GTK_SETTINGS_SOURCE_DEFAULT);
@@ -317,6 +320,8 @@ gtk_settings_init (GtkSettings *settings)
     gtk_settings_load_from_key_file (settings, path, GTK_SETTINGS_SOURCE_DEFAULT);
   g_free (path);
 
+  _gtk_profile_mark (profile_start, "settings-read", NULL);
+
   g_object_thaw_notify (G_OBJECT (settings));
 
   /* ensure that derived fields are initialized */
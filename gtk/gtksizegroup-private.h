@@ -24,7 +24,18 @@
 G_BEGIN_DECLS
 
 GHashTable * _gtk_size_group_get_widget_peers (GtkWidget           *for_widget,
-                                               GtkOrientation       orientation);
+                                               GtkOrientation       orientation,
+                                               GHashTable         **groups);
+
+void         _gtk_size_group_invalidate_cache (GtkSizeGroup        *size_group);
+gboolean     _gtk_size_group_get_cached_size  (GtkSizeGroup        *size_group,
+                                               GtkOrientation       orientation,
+                                               gint                *minimum,
+                                               gint                *natural);
+void         _gtk_size_group_set_cached_size  (GtkSizeGroup        *size_group,
+                                               GtkOrientation       orientation,
+                                               gint                 minimum,
+                                               gint                 natural);
 
 G_END_DECLS
 
@@ -108,6 +108,15 @@ struct _GtkSizeGroupPrivate
   GSList         *widgets;
 
   guint8          mode;
+
+  /* The resolved group maximum for non-contextual (for_size == -1)
+   * requests, so re-measuring a form doesn't walk the whole peer
+   * closure per member. Invalidated whenever any widget in the
+   * closure queues a resize; see gtk_widget_queue_resize_full().
+   */
+  guint8          cache_valid; /* bit per orientation */
+  gint            cached_min[2];
+  gint            cached_nat[2];
 };
 
 enum {
@@ -179,8 +188,9 @@ add_widget_to_closure (GHashTable *widgets,
 }
 
 GHashTable *
-_gtk_size_group_get_widget_peers (GtkWidget      *for_widget,
-                                  GtkOrientation  orientation)
+_gtk_size_group_get_widget_peers (GtkWidget       *for_widget,
+                                  GtkOrientation   orientation,
+                                  GHashTable     **groups_out)
 {
   GHashTable *widgets, *groups;
 
@@ -189,17 +199,62 @@ _gtk_size_group_get_widget_peers (GtkWidget      *for_widget,
 
   add_widget_to_closure (widgets, groups, for_widget, orientation);
 
-  g_hash_table_unref (groups);
+  if (groups_out)
+    *groups_out = groups;
+  else
+    g_hash_table_unref (groups);
 
   return widgets;
 }
 
+void
+_gtk_size_group_invalidate_cache (GtkSizeGroup *size_group)
+{
+  size_group->priv->cache_valid = 0;
+}
+
+gboolean
+_gtk_size_group_get_cached_size (GtkSizeGroup   *size_group,
+                                 GtkOrientation  orientation,
+                                 gint           *minimum,
+                                 gint           *natural)
+{
+  GtkSizeGroupPrivate *priv = size_group->priv;
+
+  if (!(priv->cache_valid & (1 << orientation)))
+    return FALSE;
+
+  *minimum = priv->cached_min[orientation];
+  *natural = priv->cached_nat[orientation];
+
+  return TRUE;
+}
+
+void
+_gtk_size_group_set_cached_size (GtkSizeGroup   *size_group,
+                                 GtkOrientation  orientation,
+                                 gint            minimum,
+                                 gint            natural)
+{
+  GtkSizeGroupPrivate *priv = size_group->priv;
+
+  priv->cached_min[orientation] = minimum;
+  priv->cached_nat[orientation] = natural;
+  priv->cache_valid |= 1 << orientation;
+}
+
 static void
 queue_resize_on_group (GtkSizeGroup *size_group)
 {
   GtkSizeGroupPrivate *priv = size_group->priv;
   GSList *list;
 
+  /* Invalidate up front: the queue_resize calls below only reach the
+   * group caches through widgets that are not already flagged for
+   * resize.
+   */
+  _gtk_size_group_invalidate_cache (size_group);
+
   for (list = priv->widgets; list; list = list->next)
     {
       gtk_widget_queue_resize (list->data);
@@ -33,6 +33,12 @@
 #include "gtkcssnumbervalueprivate.h"
 
 
+#ifdef G_ENABLE_DEBUG
+/* Running cache statistics, reported with GTK_DEBUG=size-request */
+static guint64 size_request_cache_hits = 0;
+static guint64 size_request_cache_misses = 0;
+#endif
+
 #ifdef G_ENABLE_CONSISTENCY_CHECKS
 static GQuark recursion_check_quark = 0;
 
@@ -149,6 +155,13 @@ gtk_widget_query_size_for_orientation (GtkWidget        *widget,
                                                    &min_baseline,
                                                    &nat_baseline);
 
+#ifdef G_ENABLE_DEBUG
+  if (found_in_cache)
+    size_request_cache_hits++;
+  else
+    size_request_cache_misses++;
+#endif
+
   widget_class = GTK_WIDGET_GET_CLASS (widget);
 
   if (!found_in_cache)
@@ -365,8 +378,10 @@ gtk_widget_query_size_for_orientation (GtkWidget        *widget,
                 g_string_append_printf (s, ", baseline %d/%d",
                                         min_baseline, nat_baseline);
               }
-	    g_string_append_printf (s, " (hit cache: %s)\n",
-		                    found_in_cache ? "yes" : "no");
+	    g_string_append_printf (s, " (hit cache: %s, %" G_GUINT64_FORMAT " hits / %" G_GUINT64_FORMAT " misses total)\n",
+		                    found_in_cache ? "yes" : "no",
+		                    size_request_cache_hits,
+		                    size_request_cache_misses);
             g_message ("%s", s->str);
             g_string_free (s, TRUE);
 	    });
@@ -439,21 +454,56 @@ gtk_widget_measure (GtkWidget        *widget,
       return;
     }
 
-  widgets = _gtk_size_group_get_widget_peers (widget, orientation);
-
-  g_hash_table_iter_init (&iter, widgets);
-  while (g_hash_table_iter_next (&iter, &key, NULL))
+  /* For non-contextual requests the resolved maximum is cached on the
+   * groups themselves, so only the first member to be measured after an
+   * invalidation pays for walking the closure.
+   */
+  if (for_size < 0)
     {
-      GtkWidget *tmp_widget = key;
-      gint min_dimension, nat_dimension;
+      GSList *groups;
+
+      for (groups = _gtk_widget_get_sizegroups (widget); groups; groups = groups->next)
+        {
+          GtkSizeGroup *group = groups->data;
 
-      gtk_widget_query_size_for_orientation (tmp_widget, orientation, for_size, &min_dimension, &nat_dimension, NULL, NULL);
+          if ((gtk_size_group_get_mode (group) & (1 << orientation)) &&
+              _gtk_size_group_get_cached_size (group, orientation, &min_result, &nat_result))
+            break;
+        }
 
-      min_result = MAX (min_result, min_dimension);
-      nat_result = MAX (nat_result, nat_dimension);
+      if (groups != NULL)
+        goto out;
     }
 
-  g_hash_table_destroy (widgets);
+  {
+    GHashTable *groups;
+
+    widgets = _gtk_size_group_get_widget_peers (widget, orientation, &groups);
+
+    g_hash_table_iter_init (&iter, widgets);
+    while (g_hash_table_iter_next (&iter, &key, NULL))
+      {
+        GtkWidget *tmp_widget = key;
+        gint min_dimension, nat_dimension;
+
+        gtk_widget_query_size_for_orientation (tmp_widget, orientation, for_size, &min_dimension, &nat_dimension, NULL, NULL);
+
+        min_result = MAX (min_result, min_dimension);
+        nat_result = MAX (nat_result, nat_dimension);
+      }
+
+    if (for_size < 0)
+      {
+        g_hash_table_iter_init (&iter, groups);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
+          _gtk_size_group_set_cached_size (key, orientation, min_result, nat_result);
+      }
+
+    g_hash_table_destroy (groups);
+    g_hash_table_destroy (widgets);
+  }
+
+out:
 
   /* Baselines make no sense with sizegroups really */
   if (minimum_baseline)
@@ -32,34 +32,96 @@ _gtk_size_request_cache_init (SizeRequestCache *cache)
 }
 
 static void
-free_sizes_x (SizeRequestX **sizes)
+free_sizes_x (SizeRequestX **sizes,
+              guint          n_alloced)
 {
-  gint i;
+  guint i;
 
-  for (i = 0; i < GTK_SIZE_REQUEST_CACHED_SIZES && sizes[i] != NULL; i++)
+  for (i = 0; i < n_alloced && sizes[i] != NULL; i++)
     g_slice_free (SizeRequestX, sizes[i]);
 
-  g_slice_free1 (sizeof (SizeRequestY *) * GTK_SIZE_REQUEST_CACHED_SIZES, sizes);
+  g_slice_free1 (sizeof (SizeRequestX *) * n_alloced, sizes);
 }
 
 static void
-free_sizes_y (SizeRequestY **sizes)
+free_sizes_y (SizeRequestY **sizes,
+              guint          n_alloced)
 {
-  gint i;
+  guint i;
 
-  for (i = 0; i < GTK_SIZE_REQUEST_CACHED_SIZES && sizes[i] != NULL; i++)
+  for (i = 0; i < n_alloced && sizes[i] != NULL; i++)
     g_slice_free (SizeRequestY, sizes[i]);
 
-  g_slice_free1 (sizeof (SizeRequestY *) * GTK_SIZE_REQUEST_CACHED_SIZES, sizes);
+  g_slice_free1 (sizeof (SizeRequestY *) * n_alloced, sizes);
+}
+
+/* Grows the request array when it runs full, doubling its size
+ * up to GTK_SIZE_REQUEST_MAX_CACHED_SIZES. An interactive resize
+ * probes dozens of different sizes in quick succession, and
+ * evicting ranges that are about to be requested again is much
+ * more expensive than keeping them around.
+ */
+static SizeRequestX **
+grow_sizes_x (SizeRequestX **sizes,
+              guint          n_alloced,
+              guint         *new_n_alloced)
+{
+  SizeRequestX **new_sizes;
+  guint          n;
+
+  if (sizes == NULL)
+    n = GTK_SIZE_REQUEST_CACHED_SIZES;
+  else
+    n = MIN (n_alloced * 2, GTK_SIZE_REQUEST_MAX_CACHED_SIZES);
+
+  new_sizes = g_slice_alloc0 (sizeof (SizeRequestX *) * n);
+
+  if (sizes)
+    {
+      memcpy (new_sizes, sizes, sizeof (SizeRequestX *) * n_alloced);
+      g_slice_free1 (sizeof (SizeRequestX *) * n_alloced, sizes);
+    }
+
+  *new_n_alloced = n;
+
+  return new_sizes;
+}
+
+static SizeRequestY **
+grow_sizes_y (SizeRequestY **sizes,
+              guint          n_alloced,
+              guint         *new_n_alloced)
+{
+  SizeRequestY **new_sizes;
+  guint          n;
+
+  if (sizes == NULL)
+    n = GTK_SIZE_REQUEST_CACHED_SIZES;
+  else
+    n = MIN (n_alloced * 2, GTK_SIZE_REQUEST_MAX_CACHED_SIZES);
+
+  new_sizes = g_slice_alloc0 (sizeof (SizeRequestY *) * n);
+
+  if (sizes)
+    {
+      memcpy (new_sizes, sizes, sizeof (SizeRequestY *) * n_alloced);
+      g_slice_free1 (sizeof (SizeRequestY *) * n_alloced, sizes);
+    }
+
+  *new_n_alloced = n;
+
+  return new_sizes;
 }
 
 void
 _gtk_size_request_cache_free (SizeRequestCache *cache)
 {
   if (cache->requests_x)
-    free_sizes_x (cache->requests_x);
+    free_sizes_x (cache->requests_x,
+                  cache->flags[GTK_ORIENTATION_HORIZONTAL].n_alloced_requests);
   if (cache->requests_y)
-    free_sizes_y (cache->requests_y);
+    free_sizes_y (cache->requests_y,
+                  cache->flags[GTK_ORIENTATION_VERTICAL].n_alloced_requests);
 }
 
 void
@@ -132,21 +194,30 @@ _gtk_size_request_cache_commit (SizeRequestCache *cache,
 
       /* If not found, pull a new size from the cache, the returned size cache
        * will immediately be used to cache the new computed size so we go ahead
-       * and increment the last_cached_request right away */
-      if (n_sizes < GTK_SIZE_REQUEST_CACHED_SIZES)
+       * and increment the last_cached_request right away; grow the cache under
+       * pressure before starting to recycle entries */
+      if (n_sizes == cache->flags[orientation].n_alloced_requests &&
+	  cache->flags[orientation].n_alloced_requests < GTK_SIZE_REQUEST_MAX_CACHED_SIZES)
+	{
+	  guint n_alloced;
+
+	  cache->requests_x = grow_sizes_x (cache->requests_x,
+					    cache->flags[orientation].n_alloced_requests,
+					    &n_alloced);
+	  cache->flags[orientation].n_alloced_requests = n_alloced;
+	}
+
+      if (n_sizes < cache->flags[orientation].n_alloced_requests)
 	{
 	  cache->flags[orientation].n_cached_requests++;
 	  cache->flags[orientation].last_cached_request = cache->flags[orientation].n_cached_requests - 1;
 	}
       else
 	{
-	  if (++cache->flags[orientation].last_cached_request == GTK_SIZE_REQUEST_CACHED_SIZES)
+	  if (++cache->flags[orientation].last_cached_request == cache->flags[orientation].n_alloced_requests)
 	    cache->flags[orientation].last_cached_request = 0;
 	}
 
-      if (cache->requests_x == NULL)
-	cache->requests_x = g_slice_alloc0 (sizeof (SizeRequestX *) * GTK_SIZE_REQUEST_CACHED_SIZES);
-
       if (cache->requests_x[cache->flags[orientation].last_cached_request] == NULL)
 	cache->requests_x[cache->flags[orientation].last_cached_request] = g_slice_new (SizeRequestX);
 
@@ -177,21 +248,30 @@ _gtk_size_request_cache_commit (SizeRequestCache *cache,
 
       /* If not found, pull a new size from the cache, the returned size cache
        * will immediately be used to cache the new computed size so we go ahead
-       * and increment the last_cached_request right away */
-      if (n_sizes < GTK_SIZE_REQUEST_CACHED_SIZES)
+       * and increment the last_cached_request right away; grow the cache under
+       * pressure before starting to recycle entries */
+      if (n_sizes == cache->flags[orientation].n_alloced_requests &&
+	  cache->flags[orientation].n_alloced_requests < GTK_SIZE_REQUEST_MAX_CACHED_SIZES)
+	{
+	  guint n_alloced;
+
+	  cache->requests_y = grow_sizes_y (cache->requests_y,
+					    cache->flags[orientation].n_alloced_requests,
+					    &n_alloced);
+	  cache->flags[orientation].n_alloced_requests = n_alloced;
+	}
+
+      if (n_sizes < cache->flags[orientation].n_alloced_requests)
 	{
 	  cache->flags[orientation].n_cached_requests++;
 	  cache->flags[orientation].last_cached_request = cache->flags[orientation].n_cached_requests - 1;
 	}
       else
 	{
-	  if (++cache->flags[orientation].last_cached_request == GTK_SIZE_REQUEST_CACHED_SIZES)
+	  if (++cache->flags[orientation].last_cached_request == cache->flags[orientation].n_alloced_requests)
 	    cache->flags[orientation].last_cached_request = 0;
 	}
 
-      if (cache->requests_y == NULL)
-	cache->requests_y = g_slice_alloc0 (sizeof (SizeRequestY *) * GTK_SIZE_REQUEST_CACHED_SIZES);
-
       if (cache->requests_y[cache->flags[orientation].last_cached_request] == NULL)
 	cache->requests_y[cache->flags[orientation].last_cached_request] = g_slice_new (SizeRequestY);
 
@@ -244,6 +324,38 @@ _gtk_size_request_cache_lookup (SizeRequestCache *cache,
 		  break;
 		}
 	    }
+
+	  /* No cached range contains for_size directly; sizes are however
+	   * monotonic in for_size, so if the nearest cached results on
+	   * both sides of for_size agree, every size in between must
+	   * yield that same result and we can extend the lower range
+	   * over for_size instead of remeasuring.
+	   */
+	  if (result == NULL)
+	    {
+	      SizeRequestX *below = NULL;
+	      SizeRequestX *above = NULL;
+
+	      for (i = 0; i < cache->flags[orientation].n_cached_requests; i++)
+		{
+		  SizeRequestX *cur = cache->requests_x[i];
+
+		  if (cur->upper_for_size < for_size &&
+		      (below == NULL || cur->upper_for_size > below->upper_for_size))
+		    below = cur;
+		  else if (cur->lower_for_size > for_size &&
+			   (above == NULL || cur->lower_for_size < above->lower_for_size))
+		    above = cur;
+		}
+
+	      if (below != NULL && above != NULL &&
+		  below->cached_size.minimum_size == above->cached_size.minimum_size &&
+		  below->cached_size.natural_size == above->cached_size.natural_size)
+		{
+		  below->upper_for_size = for_size;
+		  result = &below->cached_size;
+		}
+	    }
 	}
 
       if (result)
@@ -282,6 +394,35 @@ _gtk_size_request_cache_lookup (SizeRequestCache *cache,
 		  break;
 		}
 	    }
+
+	  /* See the comment in the horizontal case above */
+	  if (result == NULL)
+	    {
+	      SizeRequestY *below = NULL;
+	      SizeRequestY *above = NULL;
+
+	      for (i = 0; i < cache->flags[orientation].n_cached_requests; i++)
+		{
+		  SizeRequestY *cur = cache->requests_y[i];
+
+		  if (cur->upper_for_size < for_size &&
+		      (below == NULL || cur->upper_for_size > below->upper_for_size))
+		    below = cur;
+		  else if (cur->lower_for_size > for_size &&
+			   (above == NULL || cur->lower_for_size < above->lower_for_size))
+		    above = cur;
+		}
+
+	      if (below != NULL && above != NULL &&
+		  below->cached_size.minimum_size == above->cached_size.minimum_size &&
+		  below->cached_size.natural_size == above->cached_size.natural_size &&
+		  below->cached_size.minimum_baseline == above->cached_size.minimum_baseline &&
+		  below->cached_size.natural_baseline == above->cached_size.natural_baseline)
+		{
+		  below->upper_for_size = for_size;
+		  result = &below->cached_size;
+		}
+	    }
 	}
 
       if (result)
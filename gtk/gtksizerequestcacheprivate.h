@@ -35,8 +35,16 @@ G_BEGIN_DECLS
  * for a said widget to have, if a label can
  * only wrap to 3 lines, only 3 caches will
  * ever be allocated for it.
+ *
+ * The cache starts out with room for a handful
+ * of ranges and grows on demand up to the
+ * maximum, so widgets that get probed with many
+ * different sizes during an interactive resize
+ * don't keep evicting results they are about to
+ * need again.
  */
-#define GTK_SIZE_REQUEST_CACHED_SIZES   (5)
+#define GTK_SIZE_REQUEST_CACHED_SIZES       (5)
+#define GTK_SIZE_REQUEST_MAX_CACHED_SIZES   (32)
 
 typedef struct {
   gint minimum_size;
@@ -74,8 +82,9 @@ typedef struct {
   GtkSizeRequestMode request_mode   : 3;
   guint       request_mode_valid    : 1;
   struct {
-    guint       n_cached_requests   : 3;
-    guint       last_cached_request : 3;
+    guint       n_cached_requests   : 6;
+    guint       n_alloced_requests  : 6;
+    guint       last_cached_request : 6;
     guint       cached_size_valid   : 1;
   }           flags[2];
 } SizeRequestCache;
@@ -50,6 +50,79 @@
  * the #GtkWidget::snapshot vfunc.
  */
 
+/* Walks the nodes back to front, accumulating the region known to be
+ * covered by fully opaque pixels, and drops every node that is hidden
+ * entirely underneath that region. Since siblings composite with the
+ * OVER operator, such nodes cannot contribute to the final image; this
+ * is what keeps a stack of themed backgrounds cheap when an opaque
+ * child covers them.
+ */
+static guint
+gtk_snapshot_cull_occluded (GskRenderNode **nodes,
+                            guint           n_nodes,
+                            GskRenderNode **kept)
+{
+  cairo_region_t *covered = NULL;
+  guint i, j, n_kept = 0;
+
+  for (i = n_nodes; i-- > 0;)
+    {
+      GskRenderNode *node = nodes[i];
+      graphene_rect_t opaque;
+      cairo_rectangle_int_t rect;
+
+      if (covered != NULL)
+        {
+          graphene_rect_t bounds;
+
+          gsk_render_node_get_bounds (node, &bounds);
+
+          /* Round outwards, so nodes are only dropped when every
+           * potentially touched pixel is covered
+           */
+          rect.x = (int) floorf (bounds.origin.x);
+          rect.y = (int) floorf (bounds.origin.y);
+          rect.width = (int) ceilf (bounds.origin.x + bounds.size.width) - rect.x;
+          rect.height = (int) ceilf (bounds.origin.y + bounds.size.height) - rect.y;
+
+          if (cairo_region_contains_rectangle (covered, &rect) == CAIRO_REGION_OVERLAP_IN)
+            continue;
+        }
+
+      kept[n_kept++] = node;
+
+      if (gsk_render_node_get_opaque_rect (node, &opaque))
+        {
+          /* Round inwards, so partially covered border pixels don't count */
+          rect.x = (int) ceilf (opaque.origin.x);
+          rect.y = (int) ceilf (opaque.origin.y);
+          rect.width = (int) floorf (opaque.origin.x + opaque.size.width) - rect.x;
+          rect.height = (int) floorf (opaque.origin.y + opaque.size.height) - rect.y;
+
+          if (rect.width > 0 && rect.height > 0)
+            {
+              if (covered == NULL)
+                covered = cairo_region_create_rectangle (&rect);
+              else
+                cairo_region_union_rectangle (covered, &rect);
+            }
+        }
+    }
+
+  if (covered != NULL)
+    cairo_region_destroy (covered);
+
+  /* We walked backwards, restore front-to-back order */
+  for (j = 0; j < n_kept / 2; j++)
+    {
+      GskRenderNode *tmp = kept[j];
+      kept[j] = kept[n_kept - 1 - j];
+      kept[n_kept - 1 - j] = tmp;
+    }
+
+  return n_kept;
+}
+
 static GskRenderNode *
 gtk_snapshot_collect_default (GtkSnapshot      *snapshot,
                               GtkSnapshotState *state,
@@ -69,9 +142,21 @@ gtk_snapshot_collect_default (GtkSnapshot      *snapshot,
     }
   else
     {
-      node = gsk_container_node_new (nodes, n_nodes);
-      if (name)
-        gsk_render_node_set_name (node, name);
+      GskRenderNode **kept = g_newa (GskRenderNode *, n_nodes);
+      guint n_kept;
+
+      n_kept = gtk_snapshot_cull_occluded (nodes, n_nodes, kept);
+
+      if (n_kept == 1)
+        {
+          node = gsk_render_node_ref (kept[0]);
+        }
+      else
+        {
+          node = gsk_container_node_new (kept, n_kept);
+          if (name)
+            gsk_render_node_set_name (node, name);
+        }
     }
 
   return node;
@@ -0,0 +1,364 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtksortlistmodel.h"
+
+#include "gtkintl.h"
+
+/**
+ * SECTION:gtksortlistmodel
+ * @title: GtkSortListModel
+ * @short_description: A list model that sorts its items
+ * @see_also: #GListModel
+ *
+ * #GtkSortListModel is a list model that takes a list model and sorts
+ * its items according to a compare function.
+ *
+ * When items are added to or removed from the original model, only the
+ * affected items are inserted into or removed from the sorted model and
+ * a minimal #GListModel::items-changed signal is emitted for each of
+ * them; the other items keep their positions.
+ */
+
+struct _GtkSortListModel
+{
+  GObject parent_instance;
+
+  GListModel *model;
+  GCompareDataFunc sort_func;
+  gpointer user_data;
+  GDestroyNotify user_destroy;
+
+  /* The items of the child model in sorted order; the iters array
+   * tracks the sequence iter of every item in child model order
+   */
+  GSequence *items;
+  GPtrArray *iters;
+};
+
+enum {
+  PROP_0,
+  PROP_MODEL,
+  NUM_PROPERTIES
+};
+
+static GParamSpec *properties[NUM_PROPERTIES] = { NULL, };
+
+static GType
+gtk_sort_list_model_get_item_type (GListModel *list)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (list);
+
+  if (self->model == NULL)
+    return G_TYPE_OBJECT;
+
+  return g_list_model_get_item_type (self->model);
+}
+
+static guint
+gtk_sort_list_model_get_n_items (GListModel *list)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (list);
+
+  return self->iters->len;
+}
+
+static gpointer
+gtk_sort_list_model_get_item (GListModel *list,
+                              guint       position)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (list);
+  GSequenceIter *iter;
+
+  if (position >= self->iters->len)
+    return NULL;
+
+  iter = g_sequence_get_iter_at_pos (self->items, position);
+
+  return g_object_ref (g_sequence_get (iter));
+}
+
+static void
+gtk_sort_list_model_model_init (GListModelInterface *iface)
+{
+  iface->get_item_type = gtk_sort_list_model_get_item_type;
+  iface->get_n_items = gtk_sort_list_model_get_n_items;
+  iface->get_item = gtk_sort_list_model_get_item;
+}
+
+G_DEFINE_TYPE_WITH_CODE (GtkSortListModel, gtk_sort_list_model, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL, gtk_sort_list_model_model_init))
+
+static void
+gtk_sort_list_model_insert (GtkSortListModel *self,
+                            guint             position)
+{
+  gpointer item = g_list_model_get_item (self->model, position);
+  GSequenceIter *iter;
+
+  if (self->sort_func)
+    {
+      iter = g_sequence_insert_sorted (self->items, item,
+                                       self->sort_func, self->user_data);
+    }
+  else
+    {
+      /* Without a sort function, keep the order of the child model */
+      GSequenceIter *next;
+
+      if (position < self->iters->len)
+        next = g_ptr_array_index (self->iters, position);
+      else
+        next = g_sequence_get_end_iter (self->items);
+
+      iter = g_sequence_insert_before (next, item);
+    }
+
+  g_ptr_array_insert (self->iters, position, iter);
+
+  g_list_model_items_changed (G_LIST_MODEL (self),
+                              g_sequence_iter_get_position (iter), 0, 1);
+}
+
+static void
+gtk_sort_list_model_items_changed_cb (GListModel       *model,
+                                      guint             position,
+                                      guint             removed,
+                                      guint             added,
+                                      GtkSortListModel *self)
+{
+  guint i;
+
+  for (i = 0; i < removed; i++)
+    {
+      GSequenceIter *iter = g_ptr_array_index (self->iters, position);
+      guint sorted_position = g_sequence_iter_get_position (iter);
+
+      g_sequence_remove (iter);
+      g_ptr_array_remove_index (self->iters, position);
+
+      g_list_model_items_changed (G_LIST_MODEL (self), sorted_position, 1, 0);
+    }
+
+  for (i = 0; i < added; i++)
+    gtk_sort_list_model_insert (self, position + i);
+}
+
+static void
+gtk_sort_list_model_get_property (GObject     *object,
+                                  guint        prop_id,
+                                  GValue      *value,
+                                  GParamSpec  *pspec)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (object);
+
+  switch (prop_id)
+    {
+    case PROP_MODEL:
+      g_value_set_object (value, self->model);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+gtk_sort_list_model_clear_sort_func (GtkSortListModel *self)
+{
+  if (self->user_destroy)
+    self->user_destroy (self->user_data);
+
+  self->sort_func = NULL;
+  self->user_data = NULL;
+  self->user_destroy = NULL;
+}
+
+static void
+gtk_sort_list_model_dispose (GObject *object)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (object);
+
+  if (self->model)
+    {
+      g_signal_handlers_disconnect_by_func (self->model,
+                                            gtk_sort_list_model_items_changed_cb,
+                                            self);
+      g_clear_object (&self->model);
+    }
+
+  gtk_sort_list_model_clear_sort_func (self);
+
+  G_OBJECT_CLASS (gtk_sort_list_model_parent_class)->dispose (object);
+}
+
+static void
+gtk_sort_list_model_finalize (GObject *object)
+{
+  GtkSortListModel *self = GTK_SORT_LIST_MODEL (object);
+
+  g_sequence_free (self->items);
+  g_ptr_array_unref (self->iters);
+
+  G_OBJECT_CLASS (gtk_sort_list_model_parent_class)->finalize (object);
+}
+
+static void
+gtk_sort_list_model_class_init (GtkSortListModelClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->get_property = gtk_sort_list_model_get_property;
+  gobject_class->dispose = gtk_sort_list_model_dispose;
+  gobject_class->finalize = gtk_sort_list_model_finalize;
+
+  /**
+   * GtkSortListModel:model:
+   *
+   * The model being sorted
+   */
+  properties[PROP_MODEL] =
+      g_param_spec_object ("model",
+                           P_("Model"),
+                           P_("The model being sorted"),
+                           G_TYPE_LIST_MODEL,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
+}
+
+static void
+gtk_sort_list_model_init (GtkSortListModel *self)
+{
+  self->items = g_sequence_new (g_object_unref);
+  self->iters = g_ptr_array_new ();
+}
+
+/**
+ * gtk_sort_list_model_new:
+ * @model: (transfer none): the model to sort
+ * @sort_func: (allow-none): sort function or %NULL to not sort items
+ * @user_data: (closure): user data passed to @sort_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Creates a new #GtkSortListModel that uses the @sort_func to sort the
+ * items of @model.
+ *
+ * Returns: a new #GtkSortListModel
+ */
+GtkSortListModel *
+gtk_sort_list_model_new (GListModel       *model,
+                         GCompareDataFunc  sort_func,
+                         gpointer          user_data,
+                         GDestroyNotify    user_destroy)
+{
+  GtkSortListModel *self;
+  guint n_items;
+
+  g_return_val_if_fail (G_IS_LIST_MODEL (model), NULL);
+
+  self = g_object_new (GTK_TYPE_SORT_LIST_MODEL, NULL);
+
+  self->model = g_object_ref (model);
+  g_signal_connect (model, "items-changed",
+                    G_CALLBACK (gtk_sort_list_model_items_changed_cb), self);
+
+  self->sort_func = sort_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  n_items = g_list_model_get_n_items (model);
+  if (n_items > 0)
+    gtk_sort_list_model_items_changed_cb (model, 0, 0, n_items, self);
+
+  return self;
+}
+
+/**
+ * gtk_sort_list_model_set_sort_func:
+ * @self: a #GtkSortListModel
+ * @sort_func: (allow-none): sort function or %NULL to not sort items
+ * @user_data: (closure): user data passed to @sort_func
+ * @user_destroy: destroy notifier for @user_data
+ *
+ * Sets the function used to sort items. The function will be called for
+ * pairs of items with the items as arguments, like a #GCompareDataFunc.
+ *
+ * All items are resorted when this function is called.
+ */
+void
+gtk_sort_list_model_set_sort_func (GtkSortListModel *self,
+                                   GCompareDataFunc  sort_func,
+                                   gpointer          user_data,
+                                   GDestroyNotify    user_destroy)
+{
+  guint n_items;
+
+  g_return_if_fail (GTK_IS_SORT_LIST_MODEL (self));
+
+  gtk_sort_list_model_clear_sort_func (self);
+
+  self->sort_func = sort_func;
+  self->user_data = user_data;
+  self->user_destroy = user_destroy;
+
+  n_items = self->iters->len;
+  if (n_items == 0)
+    return;
+
+  if (sort_func)
+    {
+      g_sequence_sort (self->items, sort_func, user_data);
+    }
+  else
+    {
+      /* Rebuild in child model order */
+      guint i;
+
+      g_sequence_remove_range (g_sequence_get_begin_iter (self->items),
+                               g_sequence_get_end_iter (self->items));
+
+      for (i = 0; i < n_items; i++)
+        {
+          gpointer item = g_list_model_get_item (self->model, i);
+
+          g_ptr_array_index (self->iters, i) =
+              g_sequence_append (self->items, item);
+        }
+    }
+
+  g_list_model_items_changed (G_LIST_MODEL (self), 0, n_items, n_items);
+}
+
+/**
+ * gtk_sort_list_model_get_model:
+ * @self: a #GtkSortListModel
+ *
+ * Gets the model that is currently being sorted.
+ *
+ * Returns: (transfer none): The model that gets sorted
+ */
+GListModel *
+gtk_sort_list_model_get_model (GtkSortListModel *self)
+{
+  g_return_val_if_fail (GTK_IS_SORT_LIST_MODEL (self), NULL);
+
+  return self->model;
+}
@@ -656,20 +656,6 @@ is_down_transition (GtkStackTransitionType transition_type)
           transition_type == GTK_STACK_TRANSITION_TYPE_OVER_DOWN);
 }
 
-/* Transitions that cause the bin window to move */
-static inline gboolean
-is_window_moving_transition (GtkStackTransitionType transition_type)
-{
-  return (transition_type == GTK_STACK_TRANSITION_TYPE_SLIDE_LEFT ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_SLIDE_RIGHT ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_SLIDE_UP ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_SLIDE_DOWN ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_OVER_UP ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_OVER_DOWN ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_OVER_LEFT ||
-          transition_type == GTK_STACK_TRANSITION_TYPE_OVER_RIGHT);
-}
-
 /* Transitions that change direction depending on the relative order of the
 old and new child */
 static inline gboolean
@@ -772,8 +758,6 @@ gtk_stack_progress_updated (GtkStack *stack)
 
   if (!priv->vhomogeneous || !priv->hhomogeneous)
     gtk_widget_queue_resize (GTK_WIDGET (stack));
-  else if (is_window_moving_transition (priv->active_transition_type))
-    gtk_widget_queue_allocate (GTK_WIDGET (stack));
 
   if (gtk_progress_tracker_get_state (&priv->tracker) == GTK_PROGRESS_STATE_AFTER)
     {
@@ -1881,6 +1865,7 @@ gtk_stack_snapshot_slide (GtkWidget   *widget,
 {
   GtkStack *stack = GTK_STACK (widget);
   GtkStackPrivate *priv = gtk_stack_get_instance_private (stack);
+  graphene_matrix_t child_matrix;
 
   if (priv->last_visible_node)
     {
@@ -1933,9 +1918,19 @@ gtk_stack_snapshot_slide (GtkWidget   *widget,
       gtk_snapshot_pop (snapshot);
      }
 
+  /* The incoming child is moved by a transform here instead of being
+   * re-allocated every frame, so its render node survives the whole
+   * transition no matter how expensive the page is to snapshot.
+   */
+  graphene_matrix_init_translate (&child_matrix,
+                                  &GRAPHENE_POINT3D_INIT (get_bin_window_x (stack),
+                                                          get_bin_window_y (stack),
+                                                          0));
+  gtk_snapshot_push_transform (snapshot, &child_matrix, "StackSlideChild");
   gtk_widget_snapshot_child (widget,
                              priv->visible_child->widget,
                              snapshot);
+  gtk_snapshot_pop (snapshot);
 }
 
 static void
@@ -2025,8 +2020,12 @@ gtk_stack_size_allocate (GtkWidget           *widget,
   GdkRectangle child_clip;
   GtkAllocation child_allocation;
 
-  child_allocation.x = get_bin_window_x (stack);
-  child_allocation.y = get_bin_window_y (stack);
+  /* Transition offsets are applied at snapshot time; allocating the
+   * children at their final position keeps their cached render nodes
+   * valid for the duration of the transition.
+   */
+  child_allocation.x = 0;
+  child_allocation.y = 0;
 
   if (priv->last_visible_child)
     {
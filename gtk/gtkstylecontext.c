@@ -1479,17 +1479,10 @@ void
 gtk_style_context_get_color (GtkStyleContext *context,
                              GdkRGBA         *color)
 {
-  GdkRGBA *c;
-
   g_return_if_fail (color != NULL);
   g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
 
-  gtk_style_context_get (context,
-                         "color", &c,
-                         NULL);
-
-  *color = *c;
-  gdk_rgba_free (c);
+  *color = *_gtk_css_rgba_value_get_rgba (_gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_COLOR));
 }
 
 /**
@@ -1514,17 +1507,10 @@ void
 gtk_style_context_get_background_color (GtkStyleContext *context,
                                         GdkRGBA         *color)
 {
-  GdkRGBA *c;
-
   g_return_if_fail (color != NULL);
   g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
 
-  gtk_style_context_get (context,
-                         "background-color", &c,
-                         NULL);
-
-  *color = *c;
-  gdk_rgba_free (c);
+  *color = *_gtk_css_rgba_value_get_rgba (_gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_BACKGROUND_COLOR));
 }
 
 /**
@@ -1540,17 +1526,11 @@ void
 gtk_style_context_get_border_color (GtkStyleContext *context,
                                     GdkRGBA         *color)
 {
-  GdkRGBA *c;
-
   g_return_if_fail (color != NULL);
   g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
 
-  gtk_style_context_get (context,
-                         "border-color", &c,
-                         NULL);
-
-  *color = *c;
-  gdk_rgba_free (c);
+  /* The border-color shorthand queries as its first subproperty */
+  *color = *_gtk_css_rgba_value_get_rgba (_gtk_style_context_peek_property (context, GTK_CSS_PROPERTY_BORDER_TOP_COLOR));
 }
 
 /**
@@ -1650,25 +1630,46 @@ gtk_style_context_get_margin (GtkStyleContext *context,
   margin->right = right;
 }
 
+/*
+ * _gtk_style_context_get_colors:
+ * @context: a #GtkStyleContext
+ * @colors: (out): struct to fill in
+ *
+ * Fills in all the colors the drawing code queries per frame from
+ * the computed style in one pass, without boxing them into GValues
+ * the way gtk_style_context_get() does.
+ */
+void
+_gtk_style_context_get_colors (GtkStyleContext       *context,
+                               GtkStyleContextColors *colors)
+{
+  GtkCssStyle *style;
+
+  g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
+  g_return_if_fail (colors != NULL);
+
+  style = gtk_style_context_lookup_style (context);
+
+  colors->color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_COLOR));
+  colors->background_color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_BACKGROUND_COLOR));
+  colors->caret_color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_CARET_COLOR));
+  colors->secondary_caret_color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_SECONDARY_CARET_COLOR));
+}
+
 void
 _gtk_style_context_get_cursor_color (GtkStyleContext *context,
                                      GdkRGBA         *primary_color,
                                      GdkRGBA         *secondary_color)
 {
-  GdkRGBA *pc, *sc;
+  GtkCssStyle *style;
+
+  style = gtk_style_context_lookup_style (context);
 
-  gtk_style_context_get (context,
-                         "caret-color", &pc,
-                         "-gtk-secondary-caret-color", &sc,
-                         NULL);
   if (primary_color)
-    *primary_color = *pc;
+    *primary_color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_CARET_COLOR));
 
   if (secondary_color)
-    *secondary_color = *sc;
-
-  gdk_rgba_free (pc);
-  gdk_rgba_free (sc);
+    *secondary_color = *_gtk_css_rgba_value_get_rgba (gtk_css_style_get_value (style, GTK_CSS_PROPERTY_SECONDARY_CARET_COLOR));
 }
 
 static void
@@ -62,6 +62,18 @@ void           _gtk_style_context_get_cursor_color           (GtkStyleContext
                                                               GdkRGBA            *primary_color,
                                                               GdkRGBA            *secondary_color);
 
+/* The colors the drawing code needs every frame, queried from the
+ * computed style in one go without boxing them into GValues */
+typedef struct {
+  GdkRGBA color;
+  GdkRGBA background_color;
+  GdkRGBA caret_color;
+  GdkRGBA secondary_caret_color;
+} GtkStyleContextColors;
+
+void           _gtk_style_context_get_colors                 (GtkStyleContext       *context,
+                                                              GtkStyleContextColors *colors);
+
 void           _gtk_style_context_get_icon_extents           (GtkStyleContext    *context,
                                                               GdkRectangle       *extents,
                                                               gint                x,
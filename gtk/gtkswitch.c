@@ -710,8 +710,9 @@ gtk_switch_set_active (GtkSwitch *sw,
 
       g_object_notify_by_pspec (G_OBJECT (sw), switch_props[PROP_ACTIVE]);
 
-      accessible = gtk_widget_get_accessible (GTK_WIDGET (sw));
-      atk_object_notify_state_change (accessible, ATK_STATE_CHECKED, priv->is_active);
+      accessible = _gtk_widget_peek_accessible (GTK_WIDGET (sw));
+      if (accessible != NULL)
+        atk_object_notify_state_change (accessible, ATK_STATE_CHECKED, priv->is_active);
 
       gtk_widget_queue_allocate (GTK_WIDGET (sw));
     }
@@ -212,7 +212,28 @@ struct _GtkTextBTree {
   int end_iter_segment_char_offset;
   guint end_iter_line_stamp;
   guint end_iter_segment_stamp;
-  
+
+  /* Cache the most recently looked up line; search and highlighting
+   * resolve many line numbers in ascending order, and walking a few
+   * lines forward from the last result is cheaper than a descent
+   * from the root.
+   */
+  GtkTextLine *last_lookup_line;
+  gint last_lookup_line_number;
+  guint last_lookup_stamp;
+
+  /* While a tag batch is open, redisplay from tag changes is not
+   * queued per range but accumulated here as a char-offset union,
+   * flushed by _gtk_text_btree_end_tag_batch().  Tagging doesn't
+   * change character counts, so the offsets stay valid for the
+   * duration of the batch.
+   */
+  guint tag_batch_depth;
+  guint tag_batch_invalidate : 1;   /* union needs relayout */
+  guint tag_batch_redraw : 1;       /* union only needs redraw */
+  gint tag_batch_start;
+  gint tag_batch_end;
+
   GHashTable *child_anchor_table;
 };
 
@@ -427,7 +448,11 @@ _gtk_text_btree_new (GtkTextTagTable *table,
   tree->end_iter_line = NULL;
   tree->end_iter_segment_byte_index = 0;
   tree->end_iter_segment_char_offset = 0;
-  
+
+  tree->last_lookup_stamp = tree->chars_changed_stamp - 1;
+  tree->last_lookup_line = NULL;
+  tree->last_lookup_line_number = 0;
+
   g_object_ref (tree->table);
 
   tree->tag_changed_handler = g_signal_connect (tree->table,
@@ -1118,6 +1143,8 @@ _gtk_text_btree_insert (GtkTextIter *iter,
   int char_count_delta;                /* change to number of chars */
   GtkTextBTree *tree;
   gint start_byte_index;
+  gint end_byte_index;                 /* index just past the insertion,
+                                        * within the final line */
   GtkTextLine *start_line;
 
   g_return_if_fail (text != NULL);
@@ -1155,6 +1182,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
   sol = 0;
   line_count_delta = 0;
   char_count_delta = 0;
+  end_byte_index = start_byte_index;
   while (eol < len)
     {
       sol = eol;
@@ -1196,6 +1224,8 @@ _gtk_text_btree_insert (GtkTextIter *iter,
         {
           /* chunk didn't end with a paragraph separator */
           g_assert (eol == len);
+          end_byte_index = (line == start_line) ?
+            start_byte_index + chunk_len : chunk_len;
           break;
         }
 
@@ -1213,6 +1243,7 @@ _gtk_text_btree_insert (GtkTextIter *iter,
       line = newline;
       cur_seg = NULL;
       line_count_delta++;
+      end_byte_index = 0;
     }
 
   /*
@@ -1239,12 +1270,16 @@ _gtk_text_btree_insert (GtkTextIter *iter,
                                       &start,
                                       start_line,
                                       start_byte_index);
-    end = start;
 
-    /* We could almost certainly be more efficient here
-       by saving the information from the insertion loop
-       above. FIXME */
-    gtk_text_iter_forward_chars (&end, char_count_delta);
+    /* The insertion loop tracked the line and byte index where the
+     * inserted text ends, so the end iterator can be built directly
+     * instead of walking forward char by char over the whole
+     * insertion, which dominated large pastes.
+     */
+    _gtk_text_btree_get_iter_at_line (tree,
+                                      &end,
+                                      line,
+                                      end_byte_index);
 
     DV (g_print ("invalidating due to inserting some text (%s)\n", G_STRLOC));
     _gtk_text_btree_invalidate_region (tree, &start, &end, FALSE);
@@ -1748,6 +1783,36 @@ queue_tag_redisplay (GtkTextBTree      *tree,
                      const GtkTextIter *start,
                      const GtkTextIter *end)
 {
+  if (tree->tag_batch_depth > 0)
+    {
+      gint start_offset, end_offset;
+
+      if (!_gtk_text_tag_affects_size (tag) &&
+          !_gtk_text_tag_affects_nonsize_appearance (tag))
+        return;
+
+      start_offset = gtk_text_iter_get_offset (start);
+      end_offset = gtk_text_iter_get_offset (end);
+
+      if (!tree->tag_batch_invalidate && !tree->tag_batch_redraw)
+        {
+          tree->tag_batch_start = start_offset;
+          tree->tag_batch_end = end_offset;
+        }
+      else
+        {
+          tree->tag_batch_start = MIN (tree->tag_batch_start, start_offset);
+          tree->tag_batch_end = MAX (tree->tag_batch_end, end_offset);
+        }
+
+      if (_gtk_text_tag_affects_size (tag))
+        tree->tag_batch_invalidate = TRUE;
+      else
+        tree->tag_batch_redraw = TRUE;
+
+      return;
+    }
+
   if (_gtk_text_tag_affects_size (tag))
     {
       DV (g_print ("invalidating due to size-affecting tag (%s)\n", G_STRLOC));
@@ -1762,6 +1827,43 @@ queue_tag_redisplay (GtkTextBTree      *tree,
   /* We don't need to do anything if the tag doesn't affect display */
 }
 
+void
+_gtk_text_btree_begin_tag_batch (GtkTextBTree *tree)
+{
+  g_return_if_fail (tree != NULL);
+
+  tree->tag_batch_depth++;
+}
+
+void
+_gtk_text_btree_end_tag_batch (GtkTextBTree *tree)
+{
+  g_return_if_fail (tree != NULL);
+  g_return_if_fail (tree->tag_batch_depth > 0);
+
+  tree->tag_batch_depth--;
+
+  if (tree->tag_batch_depth > 0)
+    return;
+
+  if (tree->tag_batch_invalidate || tree->tag_batch_redraw)
+    {
+      GtkTextIter start, end;
+
+      _gtk_text_btree_get_iter_at_char (tree, &start, tree->tag_batch_start);
+      _gtk_text_btree_get_iter_at_char (tree, &end, tree->tag_batch_end);
+
+      /* a relayout covers the redraw-only spans in the union as well */
+      if (tree->tag_batch_invalidate)
+        _gtk_text_btree_invalidate_region (tree, &start, &end, FALSE);
+      else
+        redisplay_region (tree, &start, &end, FALSE);
+
+      tree->tag_batch_invalidate = FALSE;
+      tree->tag_batch_redraw = FALSE;
+    }
+}
+
 void
 _gtk_text_btree_tag (const GtkTextIter *start_orig,
                      const GtkTextIter *end_orig,
@@ -2053,6 +2155,33 @@ get_line_internal (GtkTextBTree *tree,
   if (real_line_number)
     *real_line_number = line_number;
 
+  /*
+   * If the last line we looked up is at most this many lines before
+   * the requested one, walk forward from it instead of descending
+   * from the root again.
+   */
+#define LINE_LOOKUP_CACHE_DISTANCE 64
+
+  if (tree->last_lookup_stamp == tree->chars_changed_stamp &&
+      tree->last_lookup_line != NULL &&
+      line_number >= tree->last_lookup_line_number &&
+      line_number - tree->last_lookup_line_number <= LINE_LOOKUP_CACHE_DISTANCE)
+    {
+      line = tree->last_lookup_line;
+      lines_left = line_number - tree->last_lookup_line_number;
+
+      while (lines_left > 0)
+        {
+          line = _gtk_text_line_next (line);
+          lines_left -= 1;
+        }
+
+      tree->last_lookup_line = line;
+      tree->last_lookup_line_number = line_number;
+
+      return line;
+    }
+
   node = tree->root_node;
   lines_left = line_number;
 
@@ -2092,6 +2221,11 @@ get_line_internal (GtkTextBTree *tree,
 #endif
       lines_left -= 1;
     }
+
+  tree->last_lookup_line = line;
+  tree->last_lookup_line_number = line_number;
+  tree->last_lookup_stamp = tree->chars_changed_stamp;
+
   return line;
 }
 
@@ -115,6 +115,12 @@ void _gtk_text_btree_tag (const GtkTextIter *start,
                           GtkTextTag        *tag,
                           gboolean           apply);
 
+/* While a tag batch is open, redisplay from tag changes is coalesced
+ * into a single region, flushed when the outermost batch ends.
+ */
+void _gtk_text_btree_begin_tag_batch (GtkTextBTree *tree);
+void _gtk_text_btree_end_tag_batch   (GtkTextBTree *tree);
+
 /* "Getters" */
 
 GtkTextLine * _gtk_text_btree_get_line          (GtkTextBTree      *tree,
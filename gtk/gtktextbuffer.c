@@ -64,11 +64,52 @@ struct _GtkTextBufferPrivate
 
   guint user_action_count;
 
+  /* Native undo; see gtk_text_buffer_set_enable_undo().  New actions
+   * are pushed on the head of undo_actions, undoing moves them to
+   * redo_actions.  undo_bytes counts the stored text across both
+   * stacks.
+   */
+  GQueue undo_actions;
+  GQueue redo_actions;
+  gsize undo_bytes;
+  gsize undo_size_limit;      /* 0 means unlimited */
+
+  /* Background analysis; see gtk_text_buffer_set_analyze_func().
+   * Edits accumulate a dirty region in character offsets, which is
+   * snapshotted and handed to the analyze func on a worker thread,
+   * one job at a time.
+   */
+  GtkTextBufferAnalyzeFunc analyze_func;
+  gpointer analyze_func_user_data;
+  GDestroyNotify analyze_func_destroy;
+  gint analyze_dirty_start;   /* -1 when nothing is pending */
+  gint analyze_dirty_end;
+  guint analyze_idle;
+  guint analyze_stamp;        /* detects edits racing an analysis job */
+
   /* Whether the buffer has been modified since last save */
   guint modified : 1;
   guint has_selection : 1;
+  guint enable_undo : 1;
+  guint in_undo_redo : 1;
+  guint analyze_running : 1;
 };
 
+typedef enum
+{
+  GTK_TEXT_UNDO_ACTION_INSERT,
+  GTK_TEXT_UNDO_ACTION_DELETE
+} GtkTextUndoActionType;
+
+typedef struct
+{
+  GtkTextUndoActionType type;
+  gint start_offset;
+  gint end_offset;
+  gchar *text;                /* the inserted or deleted slice */
+  gsize text_bytes;
+} GtkTextUndoAction;
+
 typedef struct _ClipboardRequest ClipboardRequest;
 
 struct _ClipboardRequest
@@ -112,6 +153,11 @@ enum {
 };
 
 static void gtk_text_buffer_finalize   (GObject            *object);
+static void gtk_text_buffer_clear_undo_queue (GtkTextBuffer *buffer,
+                                              GQueue        *queue);
+static void gtk_text_buffer_mark_analyze_region (GtkTextBuffer *buffer,
+                                                 gint           start,
+                                                 gint           end);
 
 static void gtk_text_buffer_real_insert_text           (GtkTextBuffer     *buffer,
                                                         GtkTextIter       *iter,
@@ -848,6 +894,8 @@ gtk_text_buffer_init (GtkTextBuffer *buffer)
 {
   buffer->priv = gtk_text_buffer_get_instance_private (buffer);
   buffer->priv->tag_table = NULL;
+  buffer->priv->analyze_dirty_start = -1;
+  buffer->priv->analyze_dirty_end = -1;
 }
 
 static void
@@ -981,6 +1029,15 @@ gtk_text_buffer_finalize (GObject *object)
 
   remove_all_selection_clipboards (buffer);
 
+  if (priv->analyze_idle)
+    g_source_remove (priv->analyze_idle);
+
+  if (priv->analyze_func_destroy)
+    priv->analyze_func_destroy (priv->analyze_func_user_data);
+
+  gtk_text_buffer_clear_undo_queue (buffer, &priv->undo_actions);
+  gtk_text_buffer_clear_undo_queue (buffer, &priv->redo_actions);
+
   if (priv->tag_table)
     {
       _gtk_text_tag_table_remove_buffer (priv->tag_table, buffer);
@@ -1075,17 +1132,124 @@ gtk_text_buffer_set_text (GtkTextBuffer *buffer,
  * Insertion
  */
 
+static void
+gtk_text_buffer_free_undo_action (GtkTextBuffer     *buffer,
+                                  GtkTextUndoAction *action)
+{
+  buffer->priv->undo_bytes -= action->text_bytes;
+  g_free (action->text);
+  g_slice_free (GtkTextUndoAction, action);
+}
+
+static void
+gtk_text_buffer_clear_undo_queue (GtkTextBuffer *buffer,
+                                  GQueue        *queue)
+{
+  GtkTextUndoAction *action;
+
+  while ((action = g_queue_pop_head (queue)) != NULL)
+    gtk_text_buffer_free_undo_action (buffer, action);
+}
+
+static void
+gtk_text_buffer_trim_undo (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+
+  if (priv->undo_size_limit == 0)
+    return;
+
+  /* Drop the oldest actions first, but always keep the most recent
+   * one so the last edit stays undoable.
+   */
+  while (priv->undo_bytes > priv->undo_size_limit &&
+         g_queue_get_length (&priv->undo_actions) > 1)
+    gtk_text_buffer_free_undo_action (buffer,
+                                      g_queue_pop_tail (&priv->undo_actions));
+}
+
+/* Takes ownership of @text, which holds @text_bytes bytes. */
+static void
+gtk_text_buffer_record_edit (GtkTextBuffer         *buffer,
+                             GtkTextUndoActionType  type,
+                             gint                   start_offset,
+                             gint                   end_offset,
+                             gchar                 *text,
+                             gsize                  text_bytes)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+  GtkTextUndoAction *action;
+
+  /* a fresh edit invalidates the redo chain */
+  gtk_text_buffer_clear_undo_queue (buffer, &priv->redo_actions);
+
+  /* coalesce an insertion that directly continues the previous one,
+   * so typing a run of characters undoes as one action
+   */
+  if (type == GTK_TEXT_UNDO_ACTION_INSERT)
+    {
+      action = g_queue_peek_head (&priv->undo_actions);
+
+      if (action != NULL &&
+          action->type == GTK_TEXT_UNDO_ACTION_INSERT &&
+          action->end_offset == start_offset)
+        {
+          action->text = g_realloc (action->text,
+                                    action->text_bytes + text_bytes + 1);
+          memcpy (action->text + action->text_bytes, text, text_bytes);
+          action->text_bytes += text_bytes;
+          action->text[action->text_bytes] = '\0';
+          action->end_offset = end_offset;
+          priv->undo_bytes += text_bytes;
+
+          g_free (text);
+          gtk_text_buffer_trim_undo (buffer);
+          return;
+        }
+    }
+
+  action = g_slice_new (GtkTextUndoAction);
+  action->type = type;
+  action->start_offset = start_offset;
+  action->end_offset = end_offset;
+  action->text = text;
+  action->text_bytes = text_bytes;
+
+  g_queue_push_head (&priv->undo_actions, action);
+  priv->undo_bytes += text_bytes;
+
+  gtk_text_buffer_trim_undo (buffer);
+}
+
 static void
 gtk_text_buffer_real_insert_text (GtkTextBuffer *buffer,
                                   GtkTextIter   *iter,
                                   const gchar   *text,
                                   gint           len)
 {
+  gint start_offset;
+
   g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
   g_return_if_fail (iter != NULL);
-  
+
+  start_offset = gtk_text_iter_get_offset (iter);
+
   _gtk_text_btree_insert (iter, text, len);
 
+  if (buffer->priv->enable_undo && !buffer->priv->in_undo_redo)
+    {
+      if (len < 0)
+        len = strlen (text);
+
+      gtk_text_buffer_record_edit (buffer, GTK_TEXT_UNDO_ACTION_INSERT,
+                                   start_offset,
+                                   gtk_text_iter_get_offset (iter),
+                                   g_strndup (text, len), len);
+    }
+
+  gtk_text_buffer_mark_analyze_region (buffer, start_offset,
+                                       gtk_text_iter_get_offset (iter));
+
   g_signal_emit (buffer, signals[CHANGED], 0);
   g_object_notify_by_pspec (G_OBJECT (buffer), text_buffer_props[PROP_CURSOR_POSITION]);
 }
@@ -1793,13 +1957,28 @@ gtk_text_buffer_real_delete_range (GtkTextBuffer *buffer,
                                    GtkTextIter   *end)
 {
   gboolean has_selection;
+  gint start_offset;
 
   g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
   g_return_if_fail (start != NULL);
   g_return_if_fail (end != NULL);
 
+  start_offset = gtk_text_iter_get_offset (start);
+
+  if (buffer->priv->enable_undo && !buffer->priv->in_undo_redo)
+    {
+      gchar *slice = gtk_text_iter_get_slice (start, end);
+
+      gtk_text_buffer_record_edit (buffer, GTK_TEXT_UNDO_ACTION_DELETE,
+                                   start_offset,
+                                   gtk_text_iter_get_offset (end),
+                                   slice, strlen (slice));
+    }
+
   _gtk_text_btree_delete (start, end);
 
+  gtk_text_buffer_mark_analyze_region (buffer, start_offset, start_offset);
+
   /* may have deleted the selection... */
   update_selection_clipboards (buffer);
 
@@ -2812,6 +2991,46 @@ gtk_text_buffer_apply_tag (GtkTextBuffer     *buffer,
   gtk_text_buffer_emit_tag (buffer, tag, TRUE, start, end);
 }
 
+/**
+ * gtk_text_buffer_apply_tags:
+ * @buffer: a #GtkTextBuffer
+ * @spans: (array length=n_spans): the tags and ranges to apply
+ * @n_spans: the number of elements in @spans
+ *
+ * Applies many tags in one go.  The “apply-tag” signal is emitted for
+ * each span as with gtk_text_buffer_apply_tag(), but the layout
+ * invalidation resulting from all of the spans is coalesced into a
+ * single region covering them, instead of one region per span.  This
+ * makes a difference for callers like syntax highlighters that apply
+ * hundreds of tags after an edit.
+ *
+ * The @start and @end of each span do not have to be in order.
+ **/
+void
+gtk_text_buffer_apply_tags (GtkTextBuffer        *buffer,
+                            const GtkTextTagSpan *spans,
+                            guint                 n_spans)
+{
+  GtkTextBTree *btree;
+  guint i;
+
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+  g_return_if_fail (spans != NULL || n_spans == 0);
+
+  if (n_spans == 0)
+    return;
+
+  btree = get_btree (buffer);
+
+  _gtk_text_btree_begin_tag_batch (btree);
+
+  for (i = 0; i < n_spans; i++)
+    gtk_text_buffer_apply_tag (buffer, spans[i].tag,
+                               &spans[i].start, &spans[i].end);
+
+  _gtk_text_btree_end_tag_batch (btree);
+}
+
 /**
  * gtk_text_buffer_remove_tag:
  * @buffer: a #GtkTextBuffer
@@ -4039,6 +4258,550 @@ gtk_text_buffer_end_user_action (GtkTextBuffer *buffer)
     }
 }
 
+/**
+ * gtk_text_buffer_set_enable_undo:
+ * @buffer: a #GtkTextBuffer
+ * @enable_undo: %TRUE to enable undo tracking
+ *
+ * Sets whether @buffer records insertions and deletions so they can
+ * be reverted with gtk_text_buffer_undo().  Undo tracking is disabled
+ * by default; disabling it again discards any recorded history.
+ *
+ * Only character content is restored by undo; pixbufs and child
+ * anchors that were part of a deleted range come back as
+ * replacement characters.
+ **/
+void
+gtk_text_buffer_set_enable_undo (GtkTextBuffer *buffer,
+                                 gboolean       enable_undo)
+{
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+
+  enable_undo = enable_undo != FALSE;
+
+  if (buffer->priv->enable_undo == enable_undo)
+    return;
+
+  buffer->priv->enable_undo = enable_undo;
+
+  if (!enable_undo)
+    {
+      gtk_text_buffer_clear_undo_queue (buffer, &buffer->priv->undo_actions);
+      gtk_text_buffer_clear_undo_queue (buffer, &buffer->priv->redo_actions);
+    }
+}
+
+/**
+ * gtk_text_buffer_get_enable_undo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Returns whether @buffer records edits for undo.
+ *
+ * Returns: %TRUE if undo tracking is enabled
+ **/
+gboolean
+gtk_text_buffer_get_enable_undo (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  return buffer->priv->enable_undo;
+}
+
+/**
+ * gtk_text_buffer_set_undo_size_limit:
+ * @buffer: a #GtkTextBuffer
+ * @limit: maximum number of bytes of stored text, or 0 for no limit
+ *
+ * Sets a memory budget for the undo history.  When the text held by
+ * the recorded actions exceeds @limit bytes, the oldest actions are
+ * discarded; the most recent action is always kept so the last edit
+ * stays undoable.  The default is 0, meaning no limit.
+ **/
+void
+gtk_text_buffer_set_undo_size_limit (GtkTextBuffer *buffer,
+                                     gsize          limit)
+{
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+
+  buffer->priv->undo_size_limit = limit;
+
+  gtk_text_buffer_trim_undo (buffer);
+}
+
+/**
+ * gtk_text_buffer_get_undo_size_limit:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Returns the memory budget set with
+ * gtk_text_buffer_set_undo_size_limit().
+ *
+ * Returns: the limit in bytes, or 0 if unlimited
+ **/
+gsize
+gtk_text_buffer_get_undo_size_limit (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), 0);
+
+  return buffer->priv->undo_size_limit;
+}
+
+/**
+ * gtk_text_buffer_get_can_undo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Returns whether there is a recorded action that
+ * gtk_text_buffer_undo() would revert.
+ *
+ * Returns: %TRUE if an undo action is available
+ **/
+gboolean
+gtk_text_buffer_get_can_undo (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  return !g_queue_is_empty (&buffer->priv->undo_actions);
+}
+
+/**
+ * gtk_text_buffer_get_can_redo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Returns whether there is an undone action that
+ * gtk_text_buffer_redo() would reapply.
+ *
+ * Returns: %TRUE if a redo action is available
+ **/
+gboolean
+gtk_text_buffer_get_can_redo (GtkTextBuffer *buffer)
+{
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  return !g_queue_is_empty (&buffer->priv->redo_actions);
+}
+
+/**
+ * gtk_text_buffer_undo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Reverts the most recent recorded insertion or deletion and places
+ * the cursor at the site of the reverted edit.  The action becomes
+ * available for gtk_text_buffer_redo().
+ *
+ * Returns: %TRUE if an action was undone
+ **/
+gboolean
+gtk_text_buffer_undo (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv;
+  GtkTextUndoAction *action;
+  GtkTextIter start;
+  GtkTextIter end;
+
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  priv = buffer->priv;
+
+  action = g_queue_pop_head (&priv->undo_actions);
+  if (action == NULL)
+    return FALSE;
+
+  priv->in_undo_redo = TRUE;
+
+  if (action->type == GTK_TEXT_UNDO_ACTION_INSERT)
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, action->start_offset);
+      gtk_text_buffer_get_iter_at_offset (buffer, &end, action->end_offset);
+      gtk_text_buffer_delete (buffer, &start, &end);
+      gtk_text_buffer_place_cursor (buffer, &start);
+    }
+  else
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, action->start_offset);
+      gtk_text_buffer_insert (buffer, &start, action->text, action->text_bytes);
+      gtk_text_buffer_place_cursor (buffer, &start);
+    }
+
+  priv->in_undo_redo = FALSE;
+
+  /* undo_bytes spans both stacks, so moving the action over does not
+   * change the accounting
+   */
+  g_queue_push_head (&priv->redo_actions, action);
+
+  return TRUE;
+}
+
+/**
+ * gtk_text_buffer_redo:
+ * @buffer: a #GtkTextBuffer
+ *
+ * Reapplies the most recently undone action.
+ *
+ * Returns: %TRUE if an action was redone
+ **/
+gboolean
+gtk_text_buffer_redo (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv;
+  GtkTextUndoAction *action;
+  GtkTextIter start;
+  GtkTextIter end;
+
+  g_return_val_if_fail (GTK_IS_TEXT_BUFFER (buffer), FALSE);
+
+  priv = buffer->priv;
+
+  action = g_queue_pop_head (&priv->redo_actions);
+  if (action == NULL)
+    return FALSE;
+
+  priv->in_undo_redo = TRUE;
+
+  if (action->type == GTK_TEXT_UNDO_ACTION_INSERT)
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, action->start_offset);
+      gtk_text_buffer_insert (buffer, &start, action->text, action->text_bytes);
+      gtk_text_buffer_place_cursor (buffer, &start);
+    }
+  else
+    {
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, action->start_offset);
+      gtk_text_buffer_get_iter_at_offset (buffer, &end, action->end_offset);
+      gtk_text_buffer_delete (buffer, &start, &end);
+      gtk_text_buffer_place_cursor (buffer, &start);
+    }
+
+  priv->in_undo_redo = FALSE;
+
+  g_queue_push_head (&priv->undo_actions, action);
+
+  return TRUE;
+}
+
+/*
+ * Background analysis
+ */
+
+typedef struct
+{
+  GtkTextBufferAnalyzeFunc func;
+  gpointer user_data;
+  gchar *text;                /* snapshot of the analyzed region */
+  gint start_offset;
+  gint end_offset;
+  guint stamp;
+} AnalyzeJob;
+
+static void
+analyze_job_free (gpointer data)
+{
+  AnalyzeJob *job = data;
+
+  g_free (job->text);
+  g_slice_free (AnalyzeJob, job);
+}
+
+/**
+ * gtk_text_analysis_tag_new:
+ * @tag_name: name of a tag in the buffer's tag table
+ * @start: start of the range to tag, in characters relative to the
+ *     start of the analyzed snapshot
+ * @end: end of the range to tag
+ *
+ * Creates one entry for the batch returned by a
+ * #GtkTextBufferAnalyzeFunc.
+ *
+ * Returns: a new #GtkTextAnalysisTag
+ **/
+GtkTextAnalysisTag *
+gtk_text_analysis_tag_new (const gchar *tag_name,
+                           gint         start,
+                           gint         end)
+{
+  GtkTextAnalysisTag *tag;
+
+  g_return_val_if_fail (tag_name != NULL, NULL);
+
+  tag = g_slice_new (GtkTextAnalysisTag);
+  tag->tag_name = g_strdup (tag_name);
+  tag->start = start;
+  tag->end = end;
+
+  return tag;
+}
+
+/**
+ * gtk_text_analysis_tag_free:
+ * @tag: a #GtkTextAnalysisTag
+ *
+ * Frees a #GtkTextAnalysisTag.
+ **/
+void
+gtk_text_analysis_tag_free (GtkTextAnalysisTag *tag)
+{
+  g_return_if_fail (tag != NULL);
+
+  g_free (tag->tag_name);
+  g_slice_free (GtkTextAnalysisTag, tag);
+}
+
+static gboolean gtk_text_buffer_analyze_idle (gpointer data);
+
+static void
+gtk_text_buffer_queue_analyze (GtkTextBuffer *buffer)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+
+  if (priv->analyze_idle == 0 && !priv->analyze_running)
+    priv->analyze_idle = g_idle_add_full (G_PRIORITY_LOW,
+                                          gtk_text_buffer_analyze_idle,
+                                          buffer, NULL);
+}
+
+static void
+gtk_text_buffer_mark_analyze_region (GtkTextBuffer *buffer,
+                                     gint           start,
+                                     gint           end)
+{
+  GtkTextBufferPrivate *priv = buffer->priv;
+
+  priv->analyze_stamp++;
+
+  if (priv->analyze_func == NULL)
+    return;
+
+  if (priv->analyze_dirty_start < 0)
+    {
+      priv->analyze_dirty_start = start;
+      priv->analyze_dirty_end = end;
+    }
+  else
+    {
+      priv->analyze_dirty_start = MIN (priv->analyze_dirty_start, start);
+      priv->analyze_dirty_end = MAX (priv->analyze_dirty_end, end);
+    }
+
+  gtk_text_buffer_queue_analyze (buffer);
+}
+
+static void
+gtk_text_buffer_analyze_thread (GTask        *task,
+                                gpointer      source_object,
+                                gpointer      task_data,
+                                GCancellable *cancellable)
+{
+  AnalyzeJob *job = task_data;
+
+  g_task_return_pointer (task,
+                         job->func (job->text,
+                                    job->start_offset, job->end_offset,
+                                    job->user_data),
+                         NULL);
+}
+
+static void
+gtk_text_buffer_analyze_done (GObject      *source_object,
+                              GAsyncResult *result,
+                              gpointer      user_data)
+{
+  GtkTextBuffer *buffer = GTK_TEXT_BUFFER (source_object);
+  GtkTextBufferPrivate *priv = buffer->priv;
+  AnalyzeJob *job = g_task_get_task_data (G_TASK (result));
+  GSList *batch, *l;
+
+  batch = g_task_propagate_pointer (G_TASK (result), NULL);
+
+  priv->analyze_running = FALSE;
+
+  if (job->stamp == priv->analyze_stamp)
+    {
+      GtkTextIter start, end;
+
+      gtk_text_buffer_get_iter_at_offset (buffer, &start, job->start_offset);
+      gtk_text_buffer_get_iter_at_offset (buffer, &end, job->end_offset);
+
+      /* The batch replaces earlier results in the analyzed region for
+       * the tags it names, so clear each named tag over the region once
+       */
+      for (l = batch; l != NULL; l = l->next)
+        {
+          GtkTextAnalysisTag *entry = l->data;
+          GSList *m;
+
+          for (m = batch; m != l; m = m->next)
+            if (strcmp (((GtkTextAnalysisTag *) m->data)->tag_name,
+                        entry->tag_name) == 0)
+              break;
+
+          if (m == l)
+            gtk_text_buffer_remove_tag_by_name (buffer, entry->tag_name,
+                                                &start, &end);
+        }
+
+      for (l = batch; l != NULL; l = l->next)
+        {
+          GtkTextAnalysisTag *entry = l->data;
+          GtkTextIter tag_start, tag_end;
+
+          if (entry->start >= entry->end)
+            continue;
+
+          gtk_text_buffer_get_iter_at_offset (buffer, &tag_start,
+                                              job->start_offset + entry->start);
+          gtk_text_buffer_get_iter_at_offset (buffer, &tag_end,
+                                              job->start_offset + entry->end);
+          gtk_text_buffer_apply_tag_by_name (buffer, entry->tag_name,
+                                             &tag_start, &tag_end);
+        }
+    }
+  else
+    {
+      /* The buffer changed while the job was running; fold its region
+       * back into the dirty region so the next job re-analyzes it
+       */
+      if (priv->analyze_dirty_start < 0)
+        {
+          priv->analyze_dirty_start = job->start_offset;
+          priv->analyze_dirty_end = job->end_offset;
+        }
+      else
+        {
+          priv->analyze_dirty_start = MIN (priv->analyze_dirty_start,
+                                           job->start_offset);
+          priv->analyze_dirty_end = MAX (priv->analyze_dirty_end,
+                                         job->end_offset);
+        }
+    }
+
+  g_slist_free_full (batch, (GDestroyNotify) gtk_text_analysis_tag_free);
+
+  if (priv->analyze_dirty_start >= 0)
+    gtk_text_buffer_queue_analyze (buffer);
+}
+
+static gboolean
+gtk_text_buffer_analyze_idle (gpointer data)
+{
+  GtkTextBuffer *buffer = data;
+  GtkTextBufferPrivate *priv = buffer->priv;
+  GtkTextIter start, end;
+  AnalyzeJob *job;
+  GTask *task;
+  gint char_count;
+
+  priv->analyze_idle = 0;
+
+  if (priv->analyze_func == NULL || priv->analyze_dirty_start < 0)
+    return G_SOURCE_REMOVE;
+
+  char_count = gtk_text_buffer_get_char_count (buffer);
+
+  /* Expand to whole lines so the analyzer sees enough context for
+   * words crossing the edges of the edited region
+   */
+  gtk_text_buffer_get_iter_at_offset (buffer, &start,
+                                      MIN (priv->analyze_dirty_start, char_count));
+  gtk_text_buffer_get_iter_at_offset (buffer, &end,
+                                      MIN (priv->analyze_dirty_end, char_count));
+  gtk_text_iter_set_line_offset (&start, 0);
+  if (!gtk_text_iter_ends_line (&end))
+    gtk_text_iter_forward_to_line_end (&end);
+
+  priv->analyze_dirty_start = -1;
+  priv->analyze_dirty_end = -1;
+
+  job = g_slice_new (AnalyzeJob);
+  job->func = priv->analyze_func;
+  job->user_data = priv->analyze_func_user_data;
+  /* The slice keeps unknown-char placeholders for textures and child
+   * anchors, so offsets in the snapshot line up with buffer offsets
+   */
+  job->text = gtk_text_iter_get_slice (&start, &end);
+  job->start_offset = gtk_text_iter_get_offset (&start);
+  job->end_offset = gtk_text_iter_get_offset (&end);
+  job->stamp = priv->analyze_stamp;
+
+  priv->analyze_running = TRUE;
+
+  task = g_task_new (buffer, NULL, gtk_text_buffer_analyze_done, NULL);
+  g_task_set_task_data (task, job, analyze_job_free);
+  g_task_run_in_thread (task, gtk_text_buffer_analyze_thread);
+  g_object_unref (task);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * gtk_text_buffer_set_analyze_func:
+ * @buffer: a #GtkTextBuffer
+ * @analyze_func: (allow-none): the analysis function, or %NULL to
+ *     remove a previously set one
+ * @user_data: data to pass to @analyze_func
+ * @destroy: (allow-none): notify to free @user_data when it is no
+ *     longer needed, or %NULL
+ *
+ * Sets a function analyzing the buffer contents in the background,
+ * for uses like spell checking or syntax validation.
+ *
+ * After the buffer changes, @analyze_func is called on a worker
+ * thread with an immutable text snapshot of the changed region,
+ * expanded to whole lines, and returns a batch of tag applications
+ * which the buffer applies back on the main thread. The analysis
+ * never blocks drawing or input handling, and edits made while a
+ * job is running simply trigger re-analysis of the affected region.
+ *
+ * The tags named in the returned batch must already exist in the
+ * buffer's tag table. Before a batch is applied, each tag it names
+ * is removed from the analyzed region, so a batch replaces the
+ * analyzer's earlier results there; an entry whose @start equals
+ * its @end applies nothing but still clears its tag, which lets an
+ * analyzer retract stale results.
+ *
+ * @analyze_func must not touch the buffer or any other widgetry:
+ * it runs outside the main thread and the snapshot is the only
+ * view of the buffer it may use.
+ **/
+void
+gtk_text_buffer_set_analyze_func (GtkTextBuffer            *buffer,
+                                  GtkTextBufferAnalyzeFunc  analyze_func,
+                                  gpointer                  user_data,
+                                  GDestroyNotify            destroy)
+{
+  GtkTextBufferPrivate *priv;
+
+  g_return_if_fail (GTK_IS_TEXT_BUFFER (buffer));
+
+  priv = buffer->priv;
+
+  if (priv->analyze_func_destroy)
+    priv->analyze_func_destroy (priv->analyze_func_user_data);
+
+  priv->analyze_func = analyze_func;
+  priv->analyze_func_user_data = user_data;
+  priv->analyze_func_destroy = destroy;
+
+  /* Invalidate any job still in flight for the previous func */
+  priv->analyze_stamp++;
+
+  if (analyze_func == NULL)
+    {
+      priv->analyze_dirty_start = -1;
+      priv->analyze_dirty_end = -1;
+
+      if (priv->analyze_idle)
+        {
+          g_source_remove (priv->analyze_idle);
+          priv->analyze_idle = 0;
+        }
+    }
+  else if (gtk_text_buffer_get_char_count (buffer) > 0)
+    {
+      /* Analyze the existing contents once up front */
+      gtk_text_buffer_mark_analyze_region (buffer, 0,
+                                           gtk_text_buffer_get_char_count (buffer));
+    }
+}
+
 /*
  * Logical attribute cache
  */
@@ -328,12 +328,33 @@ void gtk_text_buffer_select_range (GtkTextBuffer     *buffer,
 
 
 /* Tag manipulation */
+
+/**
+ * GtkTextTagSpan:
+ * @tag: a #GtkTextTag
+ * @start: one bound of the range to be tagged
+ * @end: other bound of the range to be tagged
+ *
+ * A (tag, range) pair, used by gtk_text_buffer_apply_tags() to apply
+ * many tags in one go.
+ */
+typedef struct
+{
+  GtkTextTag *tag;
+  GtkTextIter start;
+  GtkTextIter end;
+} GtkTextTagSpan;
+
 GDK_AVAILABLE_IN_ALL
 void gtk_text_buffer_apply_tag             (GtkTextBuffer     *buffer,
                                             GtkTextTag        *tag,
                                             const GtkTextIter *start,
                                             const GtkTextIter *end);
 GDK_AVAILABLE_IN_ALL
+void gtk_text_buffer_apply_tags            (GtkTextBuffer        *buffer,
+                                            const GtkTextTagSpan *spans,
+                                            guint                 n_spans);
+GDK_AVAILABLE_IN_ALL
 void gtk_text_buffer_remove_tag            (GtkTextBuffer     *buffer,
                                             GtkTextTag        *tag,
                                             const GtkTextIter *start,
@@ -457,6 +478,80 @@ void            gtk_text_buffer_begin_user_action       (GtkTextBuffer *buffer);
 GDK_AVAILABLE_IN_ALL
 void            gtk_text_buffer_end_user_action         (GtkTextBuffer *buffer);
 
+/* Native undo support */
+GDK_AVAILABLE_IN_ALL
+void            gtk_text_buffer_set_enable_undo         (GtkTextBuffer *buffer,
+                                                         gboolean       enable_undo);
+GDK_AVAILABLE_IN_ALL
+gboolean        gtk_text_buffer_get_enable_undo         (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_ALL
+void            gtk_text_buffer_set_undo_size_limit     (GtkTextBuffer *buffer,
+                                                         gsize          limit);
+GDK_AVAILABLE_IN_ALL
+gsize           gtk_text_buffer_get_undo_size_limit     (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_ALL
+gboolean        gtk_text_buffer_get_can_undo            (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_ALL
+gboolean        gtk_text_buffer_get_can_redo            (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_ALL
+gboolean        gtk_text_buffer_undo                    (GtkTextBuffer *buffer);
+GDK_AVAILABLE_IN_ALL
+gboolean        gtk_text_buffer_redo                    (GtkTextBuffer *buffer);
+
+/* Background analysis (spell checking and similar); see
+ * gtk_text_buffer_set_analyze_func()
+ */
+
+typedef struct _GtkTextAnalysisTag GtkTextAnalysisTag;
+
+/**
+ * GtkTextAnalysisTag:
+ * @tag_name: name of a tag in the buffer's tag table
+ * @start: start of the range to tag, in characters relative to
+ *     the start of the analyzed snapshot
+ * @end: end of the range to tag
+ *
+ * One tag application in the batch returned by a
+ * #GtkTextBufferAnalyzeFunc.
+ */
+struct _GtkTextAnalysisTag
+{
+  gchar *tag_name;
+  gint   start;
+  gint   end;
+};
+
+/**
+ * GtkTextBufferAnalyzeFunc:
+ * @text: an immutable snapshot of the changed region
+ * @start_offset: offset of the snapshot in the buffer, in characters
+ * @end_offset: offset of the end of the snapshot
+ * @user_data: the data passed to gtk_text_buffer_set_analyze_func()
+ *
+ * A function analyzing buffer contents on a worker thread; see
+ * gtk_text_buffer_set_analyze_func().
+ *
+ * Returns: (transfer full) (element-type GtkTextAnalysisTag) (nullable):
+ *     a list of tags to apply, or %NULL
+ */
+typedef GSList * (* GtkTextBufferAnalyzeFunc) (const gchar *text,
+                                               gint         start_offset,
+                                               gint         end_offset,
+                                               gpointer     user_data);
+
+GDK_AVAILABLE_IN_ALL
+GtkTextAnalysisTag *gtk_text_analysis_tag_new  (const gchar        *tag_name,
+                                                gint                start,
+                                                gint                end);
+GDK_AVAILABLE_IN_ALL
+void                gtk_text_analysis_tag_free (GtkTextAnalysisTag *tag);
+
+GDK_AVAILABLE_IN_ALL
+void            gtk_text_buffer_set_analyze_func (GtkTextBuffer            *buffer,
+                                                  GtkTextBufferAnalyzeFunc  analyze_func,
+                                                  gpointer                  user_data,
+                                                  GDestroyNotify            destroy);
+
 
 G_END_DECLS
 
@@ -174,6 +174,7 @@ gtk_text_renderer_prepare_run (PangoRenderer  *renderer,
   GtkTextRenderer *text_renderer = GTK_TEXT_RENDERER (renderer);
   GdkRGBA *bg_rgba = NULL;
   GdkRGBA *fg_rgba = NULL;
+  GtkStyleContextColors colors;
   GtkTextAppearance *appearance;
 
   PANGO_RENDERER_CLASS (_gtk_text_renderer_parent_class)->prepare_run (renderer, run);
@@ -197,17 +198,15 @@ gtk_text_renderer_prepare_run (PangoRenderer  *renderer,
       selection_node = gtk_text_view_get_selection_node ((GtkTextView *)text_renderer->widget);
       gtk_style_context_save_to_node (context, selection_node);
 
-      gtk_style_context_get (context,
-                             "color", &fg_rgba,
-                             NULL);
+      _gtk_style_context_get_colors (context, &colors);
+      fg_rgba = &colors.color;
 
       gtk_style_context_restore (context);
     }
   else if (text_renderer->state == CURSOR && gtk_widget_has_focus (text_renderer->widget))
     {
-      gtk_style_context_get (context,
-                             "background-color", &fg_rgba,
-                              NULL);
+      _gtk_style_context_get_colors (context, &colors);
+      fg_rgba = &colors.background_color;
     }
   else
     fg_rgba = appearance->fg_rgba;
@@ -233,9 +232,6 @@ gtk_text_renderer_prepare_run (PangoRenderer  *renderer,
     }
   else
     text_renderer_set_rgba (text_renderer, PANGO_RENDER_PART_UNDERLINE, fg_rgba);
-
-  if (fg_rgba != appearance->fg_rgba)
-    gdk_rgba_free (fg_rgba);
 }
 
 static void
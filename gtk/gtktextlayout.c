@@ -112,6 +112,10 @@ static void gtk_text_layout_real_invalidate        (GtkTextLayout     *layout,
 static void gtk_text_layout_real_invalidate_cursors(GtkTextLayout     *layout,
 						    const GtkTextIter *start,
 						    const GtkTextIter *end);
+static void gtk_text_layout_drop_display           (GtkTextLayout     *layout,
+                                                    GList             *link);
+static GList *gtk_text_layout_find_display         (GtkTextLayout     *layout,
+                                                    GtkTextLine       *line);
 static void gtk_text_layout_invalidate_cache       (GtkTextLayout     *layout,
 						    GtkTextLine       *line,
 						    gboolean           cursors_only);
@@ -193,12 +197,8 @@ gtk_text_layout_dispose (GObject *object)
   g_clear_object (&layout->ltr_context);
   g_clear_object (&layout->rtl_context);
 
-  if (layout->one_display_cache)
-    {
-      GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-      layout->one_display_cache = NULL;
-      gtk_text_layout_free_line_display (layout, tmp_display);
-    }
+  while (layout->display_cache.head != NULL)
+    gtk_text_layout_drop_display (layout, layout->display_cache.head);
 
   if (layout->preedit_attrs != NULL)
     {
@@ -277,6 +277,41 @@ static void
 gtk_text_layout_init (GtkTextLayout *text_layout)
 {
   text_layout->cursor_visible = TRUE;
+  g_queue_init (&text_layout->display_cache);
+}
+
+/* How many line displays to keep around. Enough for the lines a
+ * redraw of a typical screen touches, small enough that walking the
+ * list stays in the noise compared to shaping a single line.
+ */
+#define DISPLAY_CACHE_SIZE 16
+
+static void
+gtk_text_layout_drop_display (GtkTextLayout      *layout,
+                              GList              *link)
+{
+  GtkTextLineDisplay *display = link->data;
+
+  g_queue_delete_link (&layout->display_cache, link);
+  display->cached = FALSE;
+  gtk_text_layout_free_line_display (layout, display);
+}
+
+static GList *
+gtk_text_layout_find_display (GtkTextLayout *layout,
+                              GtkTextLine   *line)
+{
+  GList *l;
+
+  for (l = layout->display_cache.head; l != NULL; l = l->next)
+    {
+      GtkTextLineDisplay *display = l->data;
+
+      if (display->line == line)
+        return l;
+    }
+
+  return NULL;
 }
 
 GtkTextLayout*
@@ -635,18 +670,23 @@ text_layout_changed (GtkTextLayout *layout,
                      gint           new_height,
                      gboolean       cursors_only)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GList *l;
+
+  /* Check if the range intersects any cached line display,
+   * and invalidate those lines if so.
    */
-  if (layout->one_display_cache)
+  l = layout->display_cache.head;
+  while (l != NULL)
     {
-      GtkTextLine *line = layout->one_display_cache->line;
+      GtkTextLineDisplay *display = l->data;
+      GList *next = l->next;
       gint cache_y = _gtk_text_btree_find_line_top (_gtk_text_buffer_get_btree (layout->buffer),
-						    line, layout);
-      gint cache_height = layout->one_display_cache->height;
+						    display->line, layout);
+
+      if (cache_y + display->height > y && cache_y < y + old_height)
+	gtk_text_layout_invalidate_cache (layout, display->line, cursors_only);
 
-      if (cache_y + cache_height > y && cache_y < y + old_height)
-	gtk_text_layout_invalidate_cache (layout, line, cursors_only);
+      l = next;
     }
 
   gtk_text_layout_emit_changed (layout, y, old_height, new_height);
@@ -818,9 +858,11 @@ gtk_text_layout_invalidate_cache (GtkTextLayout *layout,
                                   GtkTextLine   *line,
 				  gboolean       cursors_only)
 {
-  if (layout->one_display_cache && line == layout->one_display_cache->line)
+  GList *l = gtk_text_layout_find_display (layout, line);
+
+  if (l != NULL)
     {
-      GtkTextLineDisplay *display = layout->one_display_cache;
+      GtkTextLineDisplay *display = l->data;
 
       if (cursors_only)
 	{
@@ -832,8 +874,7 @@ gtk_text_layout_invalidate_cache (GtkTextLayout *layout,
 	}
       else
 	{
-	  layout->one_display_cache = NULL;
-	  gtk_text_layout_free_line_display (layout, display);
+	  gtk_text_layout_drop_display (layout, l);
 	}
     }
 }
@@ -926,31 +967,33 @@ gtk_text_layout_real_invalidate_cursors (GtkTextLayout     *layout,
 					 const GtkTextIter *start,
 					 const GtkTextIter *end)
 {
-  /* Check if the range intersects our cached line display,
-   * and invalidate the cached line if so.
+  GList *l;
+
+  if (gtk_text_iter_compare (start, end) > 0)
+    {
+      const GtkTextIter *tmp = start;
+      start = end;
+      end = tmp;
+    }
+
+  /* Check if the range intersects any cached line display,
+   * and invalidate the cursors of those lines if so.
    */
-  if (layout->one_display_cache)
+  for (l = layout->display_cache.head; l != NULL; l = l->next)
     {
+      GtkTextLineDisplay *display = l->data;
       GtkTextIter line_start, line_end;
-      GtkTextLine *line = layout->one_display_cache->line;
 
-      gtk_text_layout_get_iter_at_line (layout, &line_start, line, 0);
+      gtk_text_layout_get_iter_at_line (layout, &line_start, display->line, 0);
 
       line_end = line_start;
       if (!gtk_text_iter_ends_line (&line_end))
 	gtk_text_iter_forward_to_line_end (&line_end);
 
-      if (gtk_text_iter_compare (start, end) > 0)
-	{
-	  const GtkTextIter *tmp = start;
-	  start = end;
-	  end = tmp;
-	}
-
       if (gtk_text_iter_compare (&line_start, end) <= 0 &&
 	  gtk_text_iter_compare (start, &line_end) <= 0)
 	{
-	  gtk_text_layout_invalidate_cache (layout, line, TRUE);
+	  gtk_text_layout_invalidate_cache (layout, display->line, TRUE);
 	}
     }
 
@@ -2268,22 +2311,32 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   
   g_return_val_if_fail (line != NULL, NULL);
 
-  if (layout->one_display_cache)
-    {
-      if (line == layout->one_display_cache->line &&
-          (size_only || !layout->one_display_cache->size_only))
-	{
-	  if (!size_only)
-            update_text_display_cursors (layout, line, layout->one_display_cache);
-	  return layout->one_display_cache;
-	}
-      else
-        {
-          GtkTextLineDisplay *tmp_display = layout->one_display_cache;
-          layout->one_display_cache = NULL;
-          gtk_text_layout_free_line_display (layout, tmp_display);
-        }
-    }
+  {
+    GList *l = gtk_text_layout_find_display (layout, line);
+
+    if (l != NULL)
+      {
+        display = l->data;
+
+        if (size_only || !display->size_only)
+	  {
+            /* Keep the cache ordered by most recent use */
+            g_queue_unlink (&layout->display_cache, l);
+            g_queue_push_head_link (&layout->display_cache, l);
+
+	    if (!size_only)
+              update_text_display_cursors (layout, line, display);
+	    return display;
+	  }
+        else
+          {
+            /* A size-only display when we need the real thing
+             * is no use, recompute it from scratch.
+             */
+            gtk_text_layout_drop_display (layout, l);
+          }
+      }
+  }
 
   DV (g_print ("creating one line display cache (%s)\n", G_STRLOC));
 
@@ -2611,11 +2664,15 @@ gtk_text_layout_get_line_display (GtkTextLayout *layout,
   if (tags != NULL)
     g_ptr_array_free (tags, TRUE);
 
-  layout->one_display_cache = display;
+  display->cached = TRUE;
+  g_queue_push_head (&layout->display_cache, display);
+
+  if (g_queue_get_length (&layout->display_cache) > DISPLAY_CACHE_SIZE)
+    gtk_text_layout_drop_display (layout, layout->display_cache.tail);
 
   if (saw_widget)
     allocate_child_widgets (layout, display);
-  
+
   return display;
 }
 
@@ -2623,7 +2680,7 @@ void
 gtk_text_layout_free_line_display (GtkTextLayout      *layout,
                                    GtkTextLineDisplay *display)
 {
-  if (display != layout->one_display_cache)
+  if (!display->cached)
     {
       if (display->layout)
         g_object_unref (display->layout);
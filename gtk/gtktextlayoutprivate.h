@@ -138,10 +138,12 @@ struct _GtkTextLayout
    * over long runs with the same style. */
   GtkTextAttributes *one_style_cache;
 
-  /* A cache of one line display. Getting the same line
-   * many times in a row is the most common case.
+  /* A cache of recently used line displays, most recently used
+   * first. Getting the same few lines many times in a row is the
+   * most common case, and only lines whose content, tags or width
+   * actually changed drop out of the cache.
    */
-  GtkTextLineDisplay *one_display_cache;
+  GQueue display_cache;
 
   /* Whether we are allowed to wrap right now */
   gint wrap_loop_count;
@@ -245,6 +247,7 @@ struct _GtkTextLineDisplay
   guint has_block_cursor : 1;
   guint cursor_at_line_end : 1;
   guint size_only : 1;
+  guint cached : 1;             /* Owned by the layout's display cache */
 
   GdkRGBA *pg_bg_rgba;
 };
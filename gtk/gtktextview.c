@@ -669,9 +669,41 @@ static gint           text_window_get_height      (GtkTextWindow     *win);
 
 static guint signals[LAST_SIGNAL] = { 0 };
 
+static void
+gtk_text_view_anticipate_scroll (GtkScrollable *scrollable,
+                                 gdouble        hvalue,
+                                 gdouble        vvalue)
+{
+  GtkTextView *text_view = GTK_TEXT_VIEW (scrollable);
+  GtkTextViewPrivate *priv = text_view->priv;
+  GtkTextIter iter;
+  gint height;
+
+  if (priv->layout == NULL)
+    return;
+
+  height = SCREEN_HEIGHT (GTK_WIDGET (text_view));
+  if (height <= 0)
+    return;
+
+  /* A fling will show the area around @vvalue shortly; validate one
+   * screenful there now, so the lines are already laid out when the
+   * animation reaches them.
+   */
+  gtk_text_layout_get_line_at_y (priv->layout, &iter, vvalue, NULL);
+  gtk_text_layout_validate_yrange (priv->layout, &iter, 0, height);
+}
+
+static void
+gtk_text_view_scrollable_init (GtkScrollableInterface *iface)
+{
+  iface->anticipate_scroll = gtk_text_view_anticipate_scroll;
+}
+
 G_DEFINE_TYPE_WITH_CODE (GtkTextView, gtk_text_view, GTK_TYPE_CONTAINER,
                          G_ADD_PRIVATE (GtkTextView)
-			 G_IMPLEMENT_INTERFACE (GTK_TYPE_SCROLLABLE, NULL))
+			 G_IMPLEMENT_INTERFACE (GTK_TYPE_SCROLLABLE,
+                                                gtk_text_view_scrollable_init))
 
 static void
 add_move_binding (GtkBindingSet  *binding_set,
@@ -4327,18 +4359,35 @@ first_validate_callback (gpointer data)
   return FALSE;
 }
 
+/* How long one incremental validation idle may run and how many pixels
+ * of text to wrap before checking the clock again.  A pixel count alone
+ * does not bound the time: wrapping a few hundred pixels of pathological
+ * paragraphs can take many milliseconds, while plain lines wrap orders
+ * of magnitude faster.  The time budget keeps the idle short enough to
+ * never delay input handling or a frame noticeably, whatever the text.
+ */
+#define INCREMENTAL_VALIDATION_TIME_BUDGET 2000 /* in µs */
+#define INCREMENTAL_VALIDATION_CHUNK_PIXELS 500
+
 static gboolean
 incremental_validate_callback (gpointer data)
 {
   GtkTextView *text_view = data;
   gboolean result = TRUE;
+  gint64 deadline;
 
   DV(g_print(G_STRLOC"\n"));
-  
-  gtk_text_layout_validate (text_view->priv->layout, 2000);
+
+  deadline = g_get_monotonic_time () + INCREMENTAL_VALIDATION_TIME_BUDGET;
+
+  do
+    gtk_text_layout_validate (text_view->priv->layout,
+                              INCREMENTAL_VALIDATION_CHUNK_PIXELS);
+  while (!gtk_text_layout_is_valid (text_view->priv->layout) &&
+         g_get_monotonic_time () < deadline);
 
   gtk_text_view_update_adjustments (text_view);
-  
+
   if (gtk_text_layout_is_valid (text_view->priv->layout))
     {
       text_view->priv->incremental_validate_idle = 0;
@@ -1198,7 +1198,6 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
   GdkDisplay *display;
   GtkTooltip *current_tooltip;
 
-  has_tooltip_widget = find_topmost_widget_coords (window, dx, dy, &x, &y);
   display = gdk_window_get_display (window);
   current_tooltip = g_object_get_qdata (G_OBJECT (display), quark_current_tooltip);
 
@@ -1213,6 +1212,8 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
       if (!has_tooltip_widget)
 	return;
 
+      x = y = -1;
+
       return_value = gtk_tooltip_run_requery (&has_tooltip_widget,
 					      current_tooltip,
 					      &x, &y);
@@ -1225,15 +1226,6 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
       return;
     }
 
-  /* Hide the tooltip when there's no new tooltip widget */
-  if (!has_tooltip_widget)
-    {
-      if (current_tooltip)
-	gtk_tooltip_hide_tooltip (current_tooltip);
-
-      return;
-    }
-
   switch ((guint) event_type)
     {
       case GDK_BUTTON_PRESS:
@@ -1241,18 +1233,28 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
       case GDK_DRAG_ENTER:
       case GDK_GRAB_BROKEN:
       case GDK_SCROLL:
+      case GDK_LEAVE_NOTIFY:
 	gtk_tooltip_hide_tooltip (current_tooltip);
 	break;
 
       case GDK_MOTION_NOTIFY:
       case GDK_ENTER_NOTIFY:
-      case GDK_LEAVE_NOTIFY:
-	if (current_tooltip)
+	if (current_tooltip && GTK_TOOLTIP_VISIBLE (current_tooltip))
 	  {
 	    gboolean tip_area_set;
 	    GdkRectangle tip_area;
 	    gboolean hide_tooltip;
 
+	    /* While a tooltip is on screen, track the pointer
+	     * precisely so it hides as soon as it no longer applies
+	     */
+	    has_tooltip_widget = find_topmost_widget_coords (window, dx, dy, &x, &y);
+	    if (!has_tooltip_widget)
+	      {
+		gtk_tooltip_hide_tooltip (current_tooltip);
+		break;
+	      }
+
 	    tip_area_set = current_tooltip->tip_area_set;
 	    tip_area = current_tooltip->tip_area;
 
@@ -1260,12 +1262,8 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
                                      current_tooltip,
                                      &x, &y);
 
-	    /* Leave notify should override the query function */
-	    hide_tooltip = (event_type == GDK_LEAVE_NOTIFY);
-
 	    /* Is the pointer above another widget now? */
-	    if (GTK_TOOLTIP_VISIBLE (current_tooltip))
-	      hide_tooltip |= has_tooltip_widget != current_tooltip->tooltip_widget;
+	    hide_tooltip = has_tooltip_widget != current_tooltip->tooltip_widget;
 
 	    /* Did the pointer move out of the previous "context area"? */
 	    if (tip_area_set)
@@ -1281,17 +1279,25 @@ gtk_tooltip_handle_event_internal (GdkEventType  event_type,
 	  }
 	else
 	  {
-	    /* Need a new tooltip for this display */
-	    current_tooltip = g_object_new (GTK_TYPE_TOOLTIP, NULL);
-	    g_object_set_qdata_full (G_OBJECT (display),
-				     quark_current_tooltip,
-				     current_tooltip,
-                                     g_object_unref);
-	    g_signal_connect (display, "closed",
-			      G_CALLBACK (gtk_tooltip_display_closed),
-			      current_tooltip);
-
-	    gtk_tooltip_set_last_window (current_tooltip, window);
+	    /* No tooltip is on screen; don't hit-test the widget tree
+	     * for every motion event.  Just (re)arm the popup delay:
+	     * the hit-test and tooltip query run once, when the delay
+	     * expires, in gtk_tooltip_show_tooltip().
+	     */
+	    if (!current_tooltip)
+	      {
+		/* Need a new tooltip for this display */
+		current_tooltip = g_object_new (GTK_TYPE_TOOLTIP, NULL);
+		g_object_set_qdata_full (G_OBJECT (display),
+					 quark_current_tooltip,
+					 current_tooltip,
+					 g_object_unref);
+		g_signal_connect (display, "closed",
+				  G_CALLBACK (gtk_tooltip_display_closed),
+				  current_tooltip);
+
+		gtk_tooltip_set_last_window (current_tooltip, window);
+	      }
 
 	    gtk_tooltip_start_delay (display);
 	  }
@@ -56,11 +56,24 @@ struct _GtkTooltipWindowClass
 
 G_DEFINE_TYPE (GtkTooltipWindow, gtk_tooltip_window, GTK_TYPE_WINDOW)
 
+static void
+gtk_tooltip_window_realize (GtkWidget *widget)
+{
+  GTK_WIDGET_CLASS (gtk_tooltip_window_parent_class)->realize (widget);
+
+  /* Tooltips are small always-on-top surfaces; hint that they can go
+   * on an overlay plane so updates aren't tied to the compositing cycle
+   */
+  gdk_window_set_overlay_hint (gtk_widget_get_window (widget), TRUE);
+}
+
 static void
 gtk_tooltip_window_class_init (GtkTooltipWindowClass *klass)
 {
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
+  widget_class->realize = gtk_tooltip_window_realize;
+
   gtk_widget_class_set_css_name (widget_class, I_("tooltip"));
   gtk_widget_class_set_accessible_role (widget_class, ATK_ROLE_TOOL_TIP);
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gtk/libgtk/ui/gtktooltipwindow.ui");
@@ -288,6 +288,11 @@ struct _GtkTreeModelFilterPrivate
   guint in_row_deleted       : 1;
   guint virtual_root_deleted : 1;
 
+  /* incremental refilter state; the cursor points at the next child
+   * row to re-evaluate */
+  guint refilter_idle_id;
+  GtkTreeRowReference *refilter_cursor;
+
   /* signal ids */
   gulong changed_id;
   gulong inserted_id;
@@ -509,6 +514,8 @@ gtk_tree_model_filter_init (GtkTreeModelFilter *filter)
   filter->priv->modify_func_set = FALSE;
   filter->priv->in_row_deleted = FALSE;
   filter->priv->virtual_root_deleted = FALSE;
+  filter->priv->refilter_idle_id = 0;
+  filter->priv->refilter_cursor = NULL;
 }
 
 static void
@@ -3627,6 +3634,22 @@ gtk_tree_model_filter_drag_data_delete (GtkTreeDragSource *drag_source,
 }
 
 /* bits and pieces */
+static void
+gtk_tree_model_filter_stop_refilter_incremental (GtkTreeModelFilter *filter)
+{
+  if (filter->priv->refilter_idle_id != 0)
+    {
+      g_source_remove (filter->priv->refilter_idle_id);
+      filter->priv->refilter_idle_id = 0;
+    }
+
+  if (filter->priv->refilter_cursor)
+    {
+      gtk_tree_row_reference_free (filter->priv->refilter_cursor);
+      filter->priv->refilter_cursor = NULL;
+    }
+}
+
 static void
 gtk_tree_model_filter_set_model (GtkTreeModelFilter *filter,
                                  GtkTreeModel       *child_model)
@@ -3635,6 +3658,7 @@ gtk_tree_model_filter_set_model (GtkTreeModelFilter *filter,
 
   if (filter->priv->child_model)
     {
+      gtk_tree_model_filter_stop_refilter_incremental (filter);
       g_signal_handler_disconnect (filter->priv->child_model,
                                    filter->priv->changed_id);
       g_signal_handler_disconnect (filter->priv->child_model,
@@ -4240,12 +4264,141 @@ gtk_tree_model_filter_refilter (GtkTreeModelFilter *filter)
 {
   g_return_if_fail (GTK_IS_TREE_MODEL_FILTER (filter));
 
+  /* This pass visits every row, so a pending incremental pass
+   * has nothing left to do.
+   */
+  gtk_tree_model_filter_stop_refilter_incremental (filter);
+
   /* S L O W */
   gtk_tree_model_foreach (filter->priv->child_model,
                           gtk_tree_model_filter_refilter_helper,
                           filter);
 }
 
+/* Number of rows re-evaluated per main loop iteration.  Small enough
+ * to leave time for input handling and redraw in between, large
+ * enough to finish a six-figure model within a few seconds.
+ */
+#define REFILTER_INCREMENTAL_CHUNK_SIZE 500
+
+static gboolean
+gtk_tree_model_filter_refilter_next (GtkTreeModel *model,
+                                     GtkTreeIter  *iter)
+{
+  GtkTreeIter next;
+
+  if (gtk_tree_model_iter_children (model, &next, iter))
+    {
+      *iter = next;
+      return TRUE;
+    }
+
+  while (TRUE)
+    {
+      next = *iter;
+      if (gtk_tree_model_iter_next (model, &next))
+        {
+          *iter = next;
+          return TRUE;
+        }
+
+      if (!gtk_tree_model_iter_parent (model, &next, iter))
+        return FALSE;
+
+      *iter = next;
+    }
+}
+
+static gboolean
+gtk_tree_model_filter_refilter_idle (gpointer data)
+{
+  GtkTreeModelFilter *filter = data;
+  GtkTreeModel *child_model = filter->priv->child_model;
+  GtkTreeIter iter;
+  gboolean valid = FALSE;
+  guint i;
+
+  if (filter->priv->refilter_cursor)
+    {
+      GtkTreePath *path;
+
+      path = gtk_tree_row_reference_get_path (filter->priv->refilter_cursor);
+      if (path)
+        {
+          valid = gtk_tree_model_get_iter (child_model, &iter, path);
+          gtk_tree_path_free (path);
+        }
+
+      gtk_tree_row_reference_free (filter->priv->refilter_cursor);
+      filter->priv->refilter_cursor = NULL;
+
+      /* The row the cursor pointed at was deleted; start over, rows
+       * processed with the old visibility are just re-evaluated again.
+       */
+      if (!valid)
+        valid = gtk_tree_model_get_iter_first (child_model, &iter);
+    }
+  else
+    valid = gtk_tree_model_get_iter_first (child_model, &iter);
+
+  for (i = 0; valid && i < REFILTER_INCREMENTAL_CHUNK_SIZE; i++)
+    {
+      GtkTreePath *path;
+
+      path = gtk_tree_model_get_path (child_model, &iter);
+      gtk_tree_model_filter_row_changed (child_model, path, &iter, filter);
+      gtk_tree_path_free (path);
+
+      valid = gtk_tree_model_filter_refilter_next (child_model, &iter);
+    }
+
+  if (valid)
+    {
+      GtkTreePath *path;
+
+      path = gtk_tree_model_get_path (child_model, &iter);
+      filter->priv->refilter_cursor =
+        gtk_tree_row_reference_new (child_model, path);
+      gtk_tree_path_free (path);
+
+      return G_SOURCE_CONTINUE;
+    }
+
+  filter->priv->refilter_idle_id = 0;
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * gtk_tree_model_filter_refilter_incremental:
+ * @filter: A #GtkTreeModelFilter.
+ *
+ * Like gtk_tree_model_filter_refilter(), but re-evaluates the rows in
+ * chunks from idle callbacks instead of all at once, so the main loop
+ * keeps running while a large child model is refiltered. Rows keep
+ * their previous visibility until their chunk has been processed.
+ *
+ * Calling this function while a previous incremental pass is still
+ * running restarts the pass from the first row.
+ */
+void
+gtk_tree_model_filter_refilter_incremental (GtkTreeModelFilter *filter)
+{
+  g_return_if_fail (GTK_IS_TREE_MODEL_FILTER (filter));
+
+  if (filter->priv->refilter_cursor)
+    {
+      gtk_tree_row_reference_free (filter->priv->refilter_cursor);
+      filter->priv->refilter_cursor = NULL;
+    }
+
+  if (filter->priv->refilter_idle_id == 0)
+    filter->priv->refilter_idle_id =
+      g_idle_add_full (GDK_PRIORITY_REDRAW + 10,
+                       gtk_tree_model_filter_refilter_idle,
+                       filter, NULL);
+}
+
 /**
  * gtk_tree_model_filter_clear_cache:
  * @filter: A #GtkTreeModelFilter.
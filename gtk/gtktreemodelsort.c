@@ -245,6 +245,12 @@ struct _SortData
   GtkTreePath *parent_path;
   gint *parent_path_indices;
   gint parent_path_depth;
+
+  /* child iters indexed by old_index, so that a full sort looks up
+   * each child iter once instead of twice per comparison; only used
+   * by gtk_tree_model_sort_sort_level()
+   */
+  GtkTreeIter *cached_iters;
 };
 
 /* Properties */
@@ -693,12 +699,14 @@ fill_sort_data (SortData         *data,
     }
   data->parent_path_depth = gtk_tree_path_get_depth (data->parent_path);
   data->parent_path_indices = gtk_tree_path_get_indices (data->parent_path);
+  data->cached_iters = NULL;
 }
 
 static void
 free_sort_data (SortData *data)
 {
   gtk_tree_path_free (data->parent_path);
+  g_free (data->cached_iters);
 }
 
 static SortElt *
@@ -1826,7 +1834,12 @@ gtk_tree_model_sort_compare_func (gconstpointer a,
   GtkTreeIter iter_a, iter_b;
   gint retval;
 
-  if (GTK_TREE_MODEL_SORT_CACHE_CHILD_ITERS (tree_model_sort))
+  if (data->cached_iters)
+    {
+      iter_a = data->cached_iters[sa->old_index];
+      iter_b = data->cached_iters[sb->old_index];
+    }
+  else if (GTK_TREE_MODEL_SORT_CACHE_CHILD_ITERS (tree_model_sort))
     {
       iter_a = sa->iter;
       iter_b = sb->iter;
@@ -1884,6 +1897,116 @@ gtk_tree_model_sort_offset_compare_func (gconstpointer a,
   return retval;
 }
 
+static void
+gtk_tree_model_sort_merge (SortElt         **elts,
+                           gint              start,
+                           gint              mid,
+                           gint              end,
+                           SortElt         **buffer,
+                           GCompareDataFunc  compare_func,
+                           gpointer          user_data)
+{
+  gint a = start;
+  gint b = mid;
+  gint out = 0;
+
+  while (a < mid && b < end)
+    {
+      if (compare_func (elts[a], elts[b], user_data) <= 0)
+        buffer[out++] = elts[a++];
+      else
+        buffer[out++] = elts[b++];
+    }
+
+  while (a < mid)
+    buffer[out++] = elts[a++];
+  while (b < end)
+    buffer[out++] = elts[b++];
+
+  memcpy (elts + start, buffer, out * sizeof (SortElt *));
+}
+
+/* Stable natural merge sort: detects runs that are already sorted
+ * (reversing strictly descending ones) and only merges those, so a
+ * level that is mostly in order needs far fewer comparisons than a
+ * full sort from scratch
+ */
+static void
+gtk_tree_model_sort_merge_sort (SortElt         **elts,
+                                gint              n_elts,
+                                GCompareDataFunc  compare_func,
+                                gpointer          user_data)
+{
+  GArray *runs;
+  SortElt **buffer;
+  gint start;
+
+  /* Find the boundaries of the presorted runs */
+  runs = g_array_new (FALSE, FALSE, sizeof (gint));
+  start = 0;
+  g_array_append_val (runs, start);
+
+  while (start < n_elts)
+    {
+      gint end = start + 1;
+
+      if (end < n_elts &&
+          compare_func (elts[end - 1], elts[end], user_data) > 0)
+        {
+          gint left, right;
+
+          /* Strictly descending run; reversing it keeps the sort stable */
+          while (end < n_elts &&
+                 compare_func (elts[end - 1], elts[end], user_data) > 0)
+            end++;
+
+          for (left = start, right = end - 1; left < right; left++, right--)
+            {
+              SortElt *tmp = elts[left];
+              elts[left] = elts[right];
+              elts[right] = tmp;
+            }
+        }
+      else
+        {
+          while (end < n_elts &&
+                 compare_func (elts[end - 1], elts[end], user_data) <= 0)
+            end++;
+        }
+
+      g_array_append_val (runs, end);
+      start = end;
+    }
+
+  /* Merge pairs of adjacent runs until a single run is left */
+  buffer = g_new (SortElt *, n_elts);
+
+  while (runs->len > 2)
+    {
+      guint i, out;
+
+      for (i = 0, out = 0; i + 2 < runs->len; i += 2)
+        {
+          gtk_tree_model_sort_merge (elts,
+                                     g_array_index (runs, gint, i),
+                                     g_array_index (runs, gint, i + 1),
+                                     g_array_index (runs, gint, i + 2),
+                                     buffer,
+                                     compare_func, user_data);
+
+          g_array_index (runs, gint, ++out) = g_array_index (runs, gint, i + 2);
+        }
+
+      if (i + 1 < runs->len)
+        g_array_index (runs, gint, ++out) = g_array_index (runs, gint, i + 1);
+
+      g_array_set_size (runs, out + 1);
+    }
+
+  g_free (buffer);
+  g_array_free (runs, TRUE);
+}
+
 static void
 gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
 				SortLevel        *level,
@@ -1894,6 +2017,8 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
   gint i;
   GSequenceIter *begin_siter, *end_siter, *siter;
   SortElt *begin_elt;
+  SortElt **elts;
+  gint n_items;
   gint *new_order;
 
   GtkTreeIter iter;
@@ -1915,6 +2040,9 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
 
   gtk_tree_model_sort_ref_node (GTK_TREE_MODEL (tree_model_sort), &iter);
 
+  n_items = g_sequence_get_length (level->seq);
+  elts = g_new (SortElt *, n_items);
+
   i = 0;
   end_siter = g_sequence_get_end_iter (level->seq);
   for (siter = g_sequence_get_begin_iter (level->seq);
@@ -1924,6 +2052,7 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
       SortElt *elt = g_sequence_get (siter);
 
       elt->old_index = i;
+      elts[i] = elt;
       i++;
     }
 
@@ -1933,9 +2062,38 @@ gtk_tree_model_sort_sort_level (GtkTreeModelSort *tree_model_sort,
     g_sequence_sort (level->seq, gtk_tree_model_sort_offset_compare_func,
                      &data);
   else
-    g_sequence_sort (level->seq, gtk_tree_model_sort_compare_func, &data);
+    {
+      if (!GTK_TREE_MODEL_SORT_CACHE_CHILD_ITERS (tree_model_sort))
+        {
+          /* Look up every child iter once up front; the sort makes
+           * O(n log n) comparisons and a path lookup per comparison
+           * dominates the sorting time
+           */
+          data.cached_iters = g_new (GtkTreeIter, n_items);
+          for (i = 0; i < n_items; i++)
+            {
+              data.parent_path_indices[data.parent_path_depth - 1] =
+                  elts[i]->offset;
+              gtk_tree_model_get_iter (GTK_TREE_MODEL (priv->child_model),
+                                       &data.cached_iters[i],
+                                       data.parent_path);
+            }
+        }
+
+      gtk_tree_model_sort_merge_sort (elts, n_items,
+                                      gtk_tree_model_sort_compare_func,
+                                      &data);
+
+      /* Moving the elements to the end in sorted order cycles the
+       * sequence into that order
+       */
+      for (i = 0; i < n_items; i++)
+        g_sequence_move (elts[i]->siter,
+                         g_sequence_get_end_iter (level->seq));
+    }
 
   free_sort_data (&data);
+  g_free (elts);
 
   new_order = g_new (gint, g_sequence_get_length (level->seq));
 
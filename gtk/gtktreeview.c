@@ -441,6 +441,13 @@ struct _GtkTreeViewPrivate
   gulong search_entry_changed_id;
   guint typeselect_flush_timeout;
 
+  /* Lazily built index over the search column, used by the interactive
+   * search when the default compare function is in place.
+   */
+  GPtrArray *search_index;          /* TreeViewSearchIndexEntry per visible row, in tree order */
+  gchar *search_index_prefix;       /* folded key of the previous query */
+  GArray *search_index_matches;     /* index positions matching search_index_prefix */
+
   /* Grid and tree lines */
   GtkTreeViewGridLines grid_lines;
   double grid_line_dashes[2];
@@ -837,6 +844,10 @@ static gboolean gtk_tree_view_search_iter               (GtkTreeModel     *model
 							 const gchar      *text,
 							 gint             *count,
 							 gint              n);
+static void     gtk_tree_view_search_index_invalidate   (GtkTreeView      *tree_view);
+static void     gtk_tree_view_search_index_row_changed  (GtkTreeView      *tree_view,
+							 GtkTreePath      *path,
+							 GtkTreeIter      *iter);
 static void     gtk_tree_view_search_init               (GtkWidget        *entry,
 							 GtkTreeView      *tree_view);
 static void     gtk_tree_view_put                       (GtkTreeView      *tree_view,
@@ -2079,6 +2090,8 @@ gtk_tree_view_destroy (GtkWidget *widget)
   gtk_tree_row_reference_free (tree_view->priv->anchor);
   tree_view->priv->anchor = NULL;
 
+  gtk_tree_view_search_index_invalidate (tree_view);
+
   /* destroy interactive search dialog */
   if (tree_view->priv->search_window)
     {
@@ -6546,7 +6559,14 @@ do_validate_rows (GtkTreeView *tree_view, gboolean queue_resize)
   if (!tree_view->priv->fixed_height_check)
    {
      if (fixed_height)
-       _gtk_rbtree_set_fixed_height (tree_view->priv->tree, prev_height, FALSE);
+       {
+         _gtk_rbtree_set_fixed_height (tree_view->priv->tree, prev_height, FALSE);
+
+         /* Remember the height so rows inserted later can be seeded
+          * with it as an estimate, see gtk_tree_view_row_inserted().
+          */
+         tree_view->priv->fixed_height = prev_height;
+       }
 
      tree_view->priv->fixed_height_check = 1;
    }
@@ -8522,6 +8542,8 @@ gtk_tree_view_row_changed (GtkTreeModel *model,
   else if (iter == NULL)
     gtk_tree_model_get_iter (model, iter, path);
 
+  gtk_tree_view_search_index_row_changed (tree_view, path, iter);
+
   if (_gtk_tree_view_find_node (tree_view,
 				path,
 				&tree,
@@ -8585,8 +8607,16 @@ gtk_tree_view_row_inserted (GtkTreeModel *model,
 
   g_return_if_fail (path != NULL || iter != NULL);
 
-  if (tree_view->priv->fixed_height_mode
-      && tree_view->priv->fixed_height >= 0)
+  gtk_tree_view_search_index_invalidate (tree_view);
+
+  /* If all rows measured so far came out at the same height, seed the
+   * new row with that height instead of 0.  Outside of fixed height
+   * mode the row still gets validated, but the cumulative offsets in
+   * the rbtree map pixels to rows correctly right away, so the
+   * scrollbar range and jumping to the end of a growing list don't
+   * have to wait for every appended row to be measured.
+   */
+  if (tree_view->priv->fixed_height >= 0)
     height = tree_view->priv->fixed_height;
   else
     height = 0;
@@ -8665,7 +8695,7 @@ gtk_tree_view_row_inserted (GtkTreeModel *model,
   _gtk_tree_view_accessible_add (tree_view, tree, tmpnode);
 
  done:
-  if (height > 0)
+  if (height > 0 && tree_view->priv->fixed_height_mode)
     {
       if (tree)
         _gtk_rbtree_node_mark_valid (tree, tmpnode);
@@ -8788,6 +8818,8 @@ gtk_tree_view_row_deleted (GtkTreeModel *model,
 
   g_return_if_fail (path != NULL);
 
+  gtk_tree_view_search_index_invalidate (tree_view);
+
   gtk_tree_row_reference_deleted (G_OBJECT (data), path);
 
   if (_gtk_tree_view_find_node (tree_view, path, &tree, &node))
@@ -8917,6 +8949,8 @@ gtk_tree_view_rows_reordered (GtkTreeModel *model,
   if (len < 2)
     return;
 
+  gtk_tree_view_search_index_invalidate (tree_view);
+
   gtk_tree_row_reference_reordered (G_OBJECT (data),
 				    parent,
 				    iter,
@@ -9072,6 +9106,7 @@ gtk_tree_view_build_tree (GtkTreeView *tree_view,
 {
   GtkRBNode *temp = NULL;
   GtkTreePath *path = NULL;
+  gboolean has_child;
 
   do
     {
@@ -9090,6 +9125,12 @@ gtk_tree_view_build_tree (GtkTreeView *tree_view,
       if (tree_view->priv->is_list)
         continue;
 
+      /* Ask the model once per row; for wrapper models like the filter
+       * and sort models a child query is not cheap, and expanding a
+       * node runs this loop for every newly revealed row.
+       */
+      has_child = gtk_tree_model_iter_has_child (tree_view->priv->model, iter);
+
       if (recurse)
 	{
 	  GtkTreeIter child;
@@ -9099,14 +9140,14 @@ gtk_tree_view_build_tree (GtkTreeView *tree_view,
 	  else
 	    gtk_tree_path_next (path);
 
-	  if (gtk_tree_model_iter_children (tree_view->priv->model, &child, iter))
+	  if (has_child &&
+	      gtk_tree_model_iter_children (tree_view->priv->model, &child, iter))
 	    {
 	      gboolean expand;
 
 	      g_signal_emit (tree_view, tree_view_signals[TEST_EXPAND_ROW], 0, iter, path, &expand);
 
-	      if (gtk_tree_model_iter_has_child (tree_view->priv->model, iter)
-		  && !expand)
+	      if (!expand)
 	        {
 	          temp->children = _gtk_rbtree_new ();
 	          temp->children->parent_tree = tree;
@@ -9116,7 +9157,7 @@ gtk_tree_view_build_tree (GtkTreeView *tree_view,
 	    }
 	}
 
-      if (gtk_tree_model_iter_has_child (tree_view->priv->model, iter))
+      if (has_child)
 	{
 	  if ((temp->flags&GTK_RBNODE_IS_PARENT) != GTK_RBNODE_IS_PARENT)
 	    temp->flags ^= GTK_RBNODE_IS_PARENT;
@@ -10967,6 +11008,8 @@ gtk_tree_view_set_model (GtkTreeView  *tree_view,
 
       g_object_unref (tree_view->priv->model);
 
+      gtk_tree_view_search_index_invalidate (tree_view);
+
       tree_view->priv->search_column = -1;
       tree_view->priv->fixed_height_check = 0;
       tree_view->priv->fixed_height = -1;
@@ -11954,6 +11997,8 @@ gtk_tree_view_expand_all_emission_helper (GtkRBTree *tree,
       path = _gtk_tree_path_new_from_rbtree (tree, node);
       gtk_tree_model_get_iter (tree_view->priv->model, &iter, path);
 
+      gtk_tree_view_search_index_invalidate (tree_view);
+
       g_signal_emit (tree_view, tree_view_signals[ROW_EXPANDED], 0, &iter, path);
 
       gtk_tree_path_free (path);
@@ -12157,6 +12202,8 @@ gtk_tree_view_real_expand_row (GtkTreeView *tree_view,
 
   install_presize_handler (tree_view);
 
+  gtk_tree_view_search_index_invalidate (tree_view);
+
   g_signal_emit (tree_view, tree_view_signals[ROW_EXPANDED], 0, &iter, path);
   if (open_all && node->children)
     {
@@ -12306,8 +12353,10 @@ gtk_tree_view_real_collapse_row (GtkTreeView *tree_view,
       gtk_widget_queue_resize (GTK_WIDGET (tree_view));
     }
 
+  gtk_tree_view_search_index_invalidate (tree_view);
+
   g_signal_emit (tree_view, tree_view_signals[ROW_COLLAPSED], 0, &iter, path);
-  
+
   if (gtk_widget_get_mapped (GTK_WIDGET (tree_view)))
     update_prelight (tree_view,
                      tree_view->priv->event_last_x,
@@ -14053,6 +14102,7 @@ gtk_tree_view_set_search_column (GtkTreeView *tree_view,
     return;
 
   tree_view->priv->search_column = column;
+  gtk_tree_view_search_index_invalidate (tree_view);
   g_object_notify_by_pspec (G_OBJECT (tree_view), tree_view_props[PROP_SEARCH_COLUMN]);
 }
 
@@ -14101,6 +14151,8 @@ gtk_tree_view_set_search_equal_func (GtkTreeView                *tree_view,
   tree_view->priv->search_destroy = search_destroy;
   if (tree_view->priv->search_equal_func == NULL)
     tree_view->priv->search_equal_func = gtk_tree_view_search_equal_func;
+
+  gtk_tree_view_search_index_invalidate (tree_view);
 }
 
 /**
@@ -14513,6 +14565,322 @@ gtk_tree_view_search_key_press_event (GtkWidget *widget,
   return retval;
 }
 
+/* Interactive search index
+ *
+ * Walking the whole model through the compare function on every typed
+ * character gets expensive on large models, so for the default compare
+ * function we lazily build an index of the folded search column text of
+ * every visible row, in tree order.  The index is dropped whenever the
+ * visible row set changes and rebuilt on the next query; a row-changed
+ * signal only refreshes the affected entry.  Since each typed character
+ * narrows the query, extending the previous prefix rescans just the
+ * previous matches instead of the whole index.
+ */
+typedef struct
+{
+  gchar *key;          /* folded cell text, or NULL if not transformable */
+  GtkTreePath *path;
+} TreeViewSearchIndexEntry;
+
+static void
+search_index_entry_free (gpointer data)
+{
+  TreeViewSearchIndexEntry *entry = data;
+
+  g_free (entry->key);
+  gtk_tree_path_free (entry->path);
+  g_slice_free (TreeViewSearchIndexEntry, entry);
+}
+
+/* Folds a row's search column the same way the default compare
+ * function folds it, so indexed and unindexed searches agree.
+ */
+static gchar *
+search_index_fold_value (GtkTreeModel *model,
+			 gint          column,
+			 GtkTreeIter  *iter)
+{
+  const gchar *str;
+  gchar *normalized;
+  gchar *folded = NULL;
+  GValue value = G_VALUE_INIT;
+  GValue transformed = G_VALUE_INIT;
+
+  gtk_tree_model_get_value (model, iter, column, &value);
+
+  g_value_init (&transformed, G_TYPE_STRING);
+
+  if (!g_value_transform (&value, &transformed))
+    {
+      g_value_unset (&value);
+      return NULL;
+    }
+
+  g_value_unset (&value);
+
+  str = g_value_get_string (&transformed);
+  if (str)
+    {
+      normalized = g_utf8_normalize (str, -1, G_NORMALIZE_ALL);
+      if (normalized)
+	{
+	  folded = g_utf8_casefold (normalized, -1);
+	  g_free (normalized);
+	}
+    }
+
+  g_value_unset (&transformed);
+
+  return folded;
+}
+
+static void
+gtk_tree_view_search_index_invalidate (GtkTreeView *tree_view)
+{
+  if (tree_view->priv->search_index)
+    {
+      g_ptr_array_unref (tree_view->priv->search_index);
+      tree_view->priv->search_index = NULL;
+    }
+
+  if (tree_view->priv->search_index_matches)
+    {
+      g_array_unref (tree_view->priv->search_index_matches);
+      tree_view->priv->search_index_matches = NULL;
+    }
+
+  g_free (tree_view->priv->search_index_prefix);
+  tree_view->priv->search_index_prefix = NULL;
+}
+
+static void
+gtk_tree_view_search_index_row_changed (GtkTreeView *tree_view,
+					GtkTreePath *path,
+					GtkTreeIter *iter)
+{
+  GPtrArray *index = tree_view->priv->search_index;
+  guint lo, hi;
+
+  if (index == NULL || iter == NULL)
+    return;
+
+  /* entries are in tree order, so the row can be found by bisection */
+  lo = 0;
+  hi = index->len;
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+      TreeViewSearchIndexEntry *entry = g_ptr_array_index (index, mid);
+      gint cmp = gtk_tree_path_compare (entry->path, path);
+
+      if (cmp == 0)
+	{
+	  g_free (entry->key);
+	  entry->key = search_index_fold_value (tree_view->priv->model,
+						tree_view->priv->search_column,
+						iter);
+
+	  /* the cached matches may no longer agree with the index */
+	  g_free (tree_view->priv->search_index_prefix);
+	  tree_view->priv->search_index_prefix = NULL;
+	  return;
+	}
+      else if (cmp < 0)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+}
+
+static void
+gtk_tree_view_search_index_ensure (GtkTreeView *tree_view)
+{
+  GtkTreeModel *model = tree_view->priv->model;
+  GtkRBTree *tree;
+  GtkRBNode *node;
+  GtkTreeIter iter;
+  GtkTreePath *path;
+
+  if (tree_view->priv->search_index != NULL)
+    return;
+
+  /* the index can only answer for the default compare function;
+   * custom functions are opaque predicates
+   */
+  if (tree_view->priv->search_equal_func != gtk_tree_view_search_equal_func ||
+      tree_view->priv->search_column < 0 ||
+      model == NULL || tree_view->priv->tree == NULL)
+    return;
+
+  if (!gtk_tree_model_get_iter_first (model, &iter))
+    return;
+
+  tree_view->priv->search_index =
+    g_ptr_array_new_with_free_func (search_index_entry_free);
+
+  tree = tree_view->priv->tree;
+  node = _gtk_rbtree_first (tree);
+  path = gtk_tree_path_new_first ();
+
+  do
+    {
+      TreeViewSearchIndexEntry *entry;
+
+      entry = g_slice_new (TreeViewSearchIndexEntry);
+      entry->key = search_index_fold_value (model, tree_view->priv->search_column, &iter);
+      entry->path = gtk_tree_path_copy (path);
+      g_ptr_array_add (tree_view->priv->search_index, entry);
+
+      if (node->children)
+	{
+	  GtkTreeIter tmp;
+
+	  tree = node->children;
+	  node = _gtk_rbtree_first (tree);
+
+	  tmp = iter;
+	  gtk_tree_model_iter_children (model, &iter, &tmp);
+	  gtk_tree_path_down (path);
+	}
+      else
+	{
+	  gboolean done = FALSE;
+
+	  do
+	    {
+	      node = _gtk_rbtree_next (tree, node);
+
+	      if (node)
+		{
+		  gtk_tree_model_iter_next (model, &iter);
+
+		  done = TRUE;
+		  gtk_tree_path_next (path);
+		}
+	      else
+		{
+		  GtkTreeIter tmp_iter = iter;
+
+		  node = tree->parent_node;
+		  tree = tree->parent_tree;
+
+		  if (!tree)
+		    {
+		      gtk_tree_path_free (path);
+		      return;
+		    }
+
+		  gtk_tree_model_iter_parent (model, &iter, &tmp_iter);
+		  gtk_tree_path_up (path);
+		}
+	    }
+	  while (!done);
+	}
+    }
+  while (1);
+}
+
+/* Selects and scrolls to the n-th row matching @text; mirrors the
+ * return convention of gtk_tree_view_search_iter, which it falls back
+ * to when no index is available.
+ */
+static gboolean
+gtk_tree_view_search_find (GtkTreeView      *tree_view,
+			   GtkTreeSelection *selection,
+			   const gchar      *text,
+			   gint             *count,
+			   gint              n)
+{
+  GtkTreeModel *model = gtk_tree_view_get_model (tree_view);
+  GtkTreeIter iter;
+  GtkTreePath *path;
+  TreeViewSearchIndexEntry *entry;
+  gchar *normalized;
+  gchar *key = NULL;
+  gsize key_len;
+  GArray *matches;
+  guint i;
+
+  gtk_tree_view_search_index_ensure (tree_view);
+
+  if (tree_view->priv->search_index == NULL)
+    {
+      if (!gtk_tree_model_get_iter_first (model, &iter))
+	return FALSE;
+
+      return gtk_tree_view_search_iter (model, selection, &iter, text, count, n);
+    }
+
+  normalized = g_utf8_normalize (text, -1, G_NORMALIZE_ALL);
+  if (normalized)
+    {
+      key = g_utf8_casefold (normalized, -1);
+      g_free (normalized);
+    }
+
+  if (key == NULL)
+    return FALSE;
+
+  key_len = strlen (key);
+  matches = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  if (tree_view->priv->search_index_prefix != NULL &&
+      g_str_has_prefix (key, tree_view->priv->search_index_prefix))
+    {
+      /* the new query narrows the previous one */
+      GArray *previous = tree_view->priv->search_index_matches;
+
+      for (i = 0; i < previous->len; i++)
+	{
+	  guint pos = g_array_index (previous, guint, i);
+
+	  entry = g_ptr_array_index (tree_view->priv->search_index, pos);
+	  if (entry->key != NULL && strncmp (key, entry->key, key_len) == 0)
+	    g_array_append_val (matches, pos);
+	}
+    }
+  else
+    {
+      for (i = 0; i < tree_view->priv->search_index->len; i++)
+	{
+	  entry = g_ptr_array_index (tree_view->priv->search_index, i);
+	  if (entry->key != NULL && strncmp (key, entry->key, key_len) == 0)
+	    g_array_append_val (matches, i);
+	}
+    }
+
+  if (tree_view->priv->search_index_matches)
+    g_array_unref (tree_view->priv->search_index_matches);
+  tree_view->priv->search_index_matches = matches;
+  g_free (tree_view->priv->search_index_prefix);
+  tree_view->priv->search_index_prefix = key;
+
+  *count = matches->len;
+
+  if (n < 1 || (guint) n > matches->len)
+    return FALSE;
+
+  entry = g_ptr_array_index (tree_view->priv->search_index,
+			     g_array_index (matches, guint, n - 1));
+
+  /* selecting may run arbitrary handlers that invalidate the index */
+  path = gtk_tree_path_copy (entry->path);
+
+  if (!gtk_tree_model_get_iter (model, &iter, path))
+    {
+      gtk_tree_path_free (path);
+      return FALSE;
+    }
+
+  gtk_tree_view_scroll_to_cell (tree_view, path, NULL, TRUE, 0.5, 0.0);
+  gtk_tree_selection_select_iter (selection, &iter);
+  gtk_tree_view_real_set_cursor (tree_view, path, CLAMP_NODE);
+
+  gtk_tree_path_free (path);
+
+  return TRUE;
+}
+
 /*  this function returns FALSE if there is a search string but
  *  nothing was found, and TRUE otherwise.
  */
@@ -14549,7 +14917,7 @@ gtk_tree_view_search_move (GtkWidget   *window,
   if (!gtk_tree_model_get_iter_first (model, &iter))
     return TRUE;
 
-  ret = gtk_tree_view_search_iter (model, selection, &iter, text,
+  ret = gtk_tree_view_search_find (tree_view, selection, text,
 				   &count, up?((tree_view->priv->selected_iter) - 1):((tree_view->priv->selected_iter + 1)));
 
   if (ret)
@@ -14562,9 +14930,7 @@ gtk_tree_view_search_move (GtkWidget   *window,
     {
       /* return to old iter */
       count = 0;
-      gtk_tree_model_get_iter_first (model, &iter);
-      gtk_tree_view_search_iter (model, selection,
-				 &iter, text,
+      gtk_tree_view_search_find (tree_view, selection, text,
 				 &count, tree_view->priv->selected_iter);
       return FALSE;
     }
@@ -14769,9 +15135,8 @@ gtk_tree_view_search_init (GtkWidget   *entry,
   if (!gtk_tree_model_get_iter_first (model, &iter))
     return;
 
-  ret = gtk_tree_view_search_iter (model, selection,
-				   &iter, text,
-				   &count, 1);
+  ret = gtk_tree_view_search_find (tree_view, selection,
+				   text, &count, 1);
 
   if (ret)
     tree_view->priv->selected_iter = 1;
@@ -15597,8 +15962,27 @@ gtk_tree_view_get_border (GtkScrollable *scrollable,
   return TRUE;
 }
 
+static void
+gtk_tree_view_anticipate_scroll (GtkScrollable *scrollable,
+                                 gdouble        hvalue,
+                                 gdouble        vvalue)
+{
+  GtkTreeView *tree_view = GTK_TREE_VIEW (scrollable);
+
+  /* A fling is on its way towards @vvalue; spend the time until it
+   * gets there validating rows, so the visible-area validation does
+   * not have to do a big synchronous chunk when unvalidated rows
+   * scroll in. do_validate_rows() works in bounded slices, so this
+   * stays well below a frame.
+   */
+  if (tree_view->priv->tree != NULL &&
+      GTK_RBNODE_FLAG_SET (tree_view->priv->tree->root, GTK_RBNODE_DESCENDANTS_INVALID))
+    do_validate_rows (tree_view, FALSE);
+}
+
 static void
 gtk_tree_view_scrollable_init (GtkScrollableInterface *iface)
 {
   iface->get_border = gtk_tree_view_get_border;
+  iface->anticipate_scroll = gtk_tree_view_anticipate_scroll;
 }
@@ -31,6 +31,7 @@
 #include "gtkimage.h"
 #include "gtkcellareacontext.h"
 #include "gtkcellareabox.h"
+#include "gtkcellrenderertext.h"
 #include "gtkprivate.h"
 #include "gtkintl.h"
 #include "gtktypebuiltins.h"
@@ -163,6 +164,11 @@ struct _GtkTreeViewColumnPrivate
   gulong              remove_editable_signal;
   gulong              context_changed_signal;
 
+  /* Measured sizes keyed by row content, see
+   * gtk_tree_view_column_cell_get_size()
+   */
+  GHashTable         *measure_cache;
+
   /* Flags */
   guint visible             : 1;
   guint resizable           : 1;
@@ -172,6 +178,8 @@ struct _GtkTreeViewColumnPrivate
   guint maybe_reordered     : 1;
   guint reorderable         : 1;
   guint expand              : 1;
+  guint measure_cache_checked : 1;
+  guint measure_cache_usable  : 1;
 };
 
 enum
@@ -521,6 +529,9 @@ gtk_tree_view_column_finalize (GObject *object)
   GtkTreeViewColumn        *tree_column = (GtkTreeViewColumn *) object;
   GtkTreeViewColumnPrivate *priv        = tree_column->priv;
 
+  if (priv->measure_cache)
+    g_hash_table_unref (priv->measure_cache);
+
   g_free (priv->title);
 
   G_OBJECT_CLASS (gtk_tree_view_column_parent_class)->finalize (object);
@@ -2724,6 +2735,98 @@ gtk_tree_view_column_cell_set_cell_data (GtkTreeViewColumn *tree_column,
                                   is_expander, is_expanded);
 }
 
+/* Measure cache
+ *
+ * Validation measures every row, and for text cells each measurement
+ * shapes a PangoLayout.  Columns often carry highly repetitive content
+ * (timestamps, enumeration labels), so measured sizes are cached keyed
+ * on the row's text.  The cache only engages when the row content of
+ * every renderer in the column is fully described by a "text"
+ * attribute (or is static); cell data functions and other attribute
+ * mappings can change what a measurement depends on, so they disable
+ * it.  _gtk_tree_view_column_cell_set_dirty() drops the cache along
+ * with everything else that re-requests sizes.
+ */
+#define MEASURE_CACHE_MAX_SIZE 10000
+
+typedef struct
+{
+  gint min_width;
+  gint nat_width;
+  gint min_height;
+} CachedCellSize;
+
+static void
+cached_cell_size_free (gpointer data)
+{
+  g_slice_free (CachedCellSize, data);
+}
+
+static gboolean
+gtk_tree_view_column_measure_cache_usable (GtkTreeViewColumn *tree_column)
+{
+  GtkTreeViewColumnPrivate *priv = tree_column->priv;
+  GList *cells, *l;
+  gboolean usable = TRUE;
+
+  if (priv->measure_cache_checked)
+    return priv->measure_cache_usable;
+
+  cells = gtk_cell_layout_get_cells (GTK_CELL_LAYOUT (tree_column));
+
+  if (cells == NULL)
+    usable = FALSE;
+
+  for (l = cells; l; l = l->next)
+    {
+      if (!_gtk_cell_area_cell_content_is_attribute (priv->cell_area,
+                                                     l->data, "text"))
+        {
+          usable = FALSE;
+          break;
+        }
+    }
+
+  g_list_free (cells);
+
+  priv->measure_cache_checked = TRUE;
+  priv->measure_cache_usable = usable;
+
+  if (usable && priv->measure_cache == NULL)
+    priv->measure_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, cached_cell_size_free);
+
+  return usable;
+}
+
+static gchar *
+gtk_tree_view_column_measure_cache_key (GtkTreeViewColumn *tree_column)
+{
+  GString *key = g_string_new (NULL);
+  GList *cells, *l;
+
+  cells = gtk_cell_layout_get_cells (GTK_CELL_LAYOUT (tree_column));
+
+  for (l = cells; l; l = l->next)
+    {
+      if (GTK_IS_CELL_RENDERER_TEXT (l->data))
+        {
+          gchar *text = NULL;
+
+          g_object_get (l->data, "text", &text, NULL);
+          if (text)
+            g_string_append (key, text);
+          g_free (text);
+        }
+
+      g_string_append_c (key, '\1');
+    }
+
+  g_list_free (cells);
+
+  return g_string_free (key, FALSE);
+}
+
 /**
  * gtk_tree_view_column_cell_get_size:
  * @tree_column: A #GtkTreeViewColumn.
@@ -2745,13 +2848,42 @@ gtk_tree_view_column_cell_get_size (GtkTreeViewColumn  *tree_column,
 				    gint               *height)
 {
   GtkTreeViewColumnPrivate *priv;
-  gint min_width = 0, min_height = 0;
+  CachedCellSize *cached;
+  gchar *key = NULL;
+  gint min_width = 0, nat_width = 0, min_height = 0;
 
   g_return_if_fail (GTK_IS_TREE_VIEW_COLUMN (tree_column));
 
   priv = tree_column->priv;
 
-  g_signal_handler_block (priv->cell_area_context, 
+  if (gtk_tree_view_column_measure_cache_usable (tree_column))
+    {
+      key = gtk_tree_view_column_measure_cache_key (tree_column);
+      cached = g_hash_table_lookup (priv->measure_cache, key);
+
+      if (cached)
+        {
+          /* keep the context aggregate in step with the measured rows */
+          g_signal_handler_block (priv->cell_area_context,
+                                  priv->context_changed_signal);
+          gtk_cell_area_context_push_preferred_width (priv->cell_area_context,
+                                                      cached->min_width,
+                                                      cached->nat_width);
+          g_signal_handler_unblock (priv->cell_area_context,
+                                    priv->context_changed_signal);
+
+          g_free (key);
+
+          if (height)
+            * height = cached->min_height;
+          if (width)
+            * width = cached->min_width;
+
+          return;
+        }
+    }
+
+  g_signal_handler_block (priv->cell_area_context,
 			  priv->context_changed_signal);
 
   gtk_cell_area_get_preferred_width (priv->cell_area,
@@ -2759,7 +2891,7 @@ gtk_tree_view_column_cell_get_size (GtkTreeViewColumn  *tree_column,
                                      priv->tree_view,
                                      NULL, NULL);
 
-  gtk_cell_area_context_get_preferred_width (priv->cell_area_context, &min_width, NULL);
+  gtk_cell_area_context_get_preferred_width (priv->cell_area_context, &min_width, &nat_width);
 
   gtk_cell_area_get_preferred_height_for_width (priv->cell_area,
                                                 priv->cell_area_context,
@@ -2768,9 +2900,22 @@ gtk_tree_view_column_cell_get_size (GtkTreeViewColumn  *tree_column,
                                                 &min_height,
                                                 NULL);
 
-  g_signal_handler_unblock (priv->cell_area_context, 
+  g_signal_handler_unblock (priv->cell_area_context,
 			    priv->context_changed_signal);
 
+  if (key)
+    {
+      if (g_hash_table_size (priv->measure_cache) < MEASURE_CACHE_MAX_SIZE)
+        {
+          cached = g_slice_new (CachedCellSize);
+          cached->min_width = min_width;
+          cached->nat_width = nat_width;
+          cached->min_height = min_height;
+          g_hash_table_insert (priv->measure_cache, key, cached);
+        }
+      else
+        g_free (key);
+    }
 
   if (height)
     * height = min_height;
@@ -2897,6 +3042,10 @@ _gtk_tree_view_column_cell_set_dirty (GtkTreeViewColumn *tree_column,
   priv->padding = 0;
   priv->width = 0;
 
+  if (priv->measure_cache)
+    g_hash_table_remove_all (priv->measure_cache);
+  priv->measure_cache_checked = FALSE;
+
   /* Issue a manual reset on the context to have all
    * sizes re-requested for the context.
    */
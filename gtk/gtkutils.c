@@ -194,6 +194,98 @@ gtk_read_line (FILE *stream, GString *str)
   return (n_read > 0) ? lines : 0;
 }
 
+/* Same semantics as gtk_read_line(), but reading from an in-memory
+ * buffer delimited by @end instead of a stdio stream; @pos is advanced
+ * past the line that was read
+ */
+gint
+gtk_read_line_from_string (const char **pos,
+                           const char  *end,
+                           GString     *str)
+{
+  gboolean quoted = FALSE;
+  gboolean comment = FALSE;
+  const char *p = *pos;
+  int n_read = 0;
+  int lines = 1;
+
+  g_string_truncate (str, 0);
+
+  while (1)
+    {
+      int c;
+
+      if (p == end)
+        {
+          if (quoted)
+            g_string_append_c (str, '\\');
+
+          goto done;
+        }
+
+      c = (unsigned char) *p++;
+      n_read++;
+
+      if (quoted)
+        {
+          quoted = FALSE;
+
+          switch (c)
+            {
+            case '#':
+              g_string_append_c (str, '#');
+              break;
+            case '\r':
+            case '\n':
+              {
+                int next_c = (p == end) ? EOF : (unsigned char) *p;
+
+                if ((c == '\r' && next_c == '\n') ||
+                    (c == '\n' && next_c == '\r'))
+                  p++;
+
+                lines++;
+
+                break;
+              }
+            default:
+              g_string_append_c (str, '\\');
+              g_string_append_c (str, c);
+            }
+        }
+      else
+        {
+          switch (c)
+            {
+            case '#':
+              comment = TRUE;
+              break;
+            case '\\':
+              if (!comment)
+                quoted = TRUE;
+              break;
+            case '\n':
+              {
+                int next_c = (p == end) ? EOF : (unsigned char) *p;
+
+                if (next_c == '\r')
+                  p++;
+
+                goto done;
+              }
+            default:
+              if (!comment)
+               g_string_append_c (str, c);
+            }
+        }
+    }
+
+ done:
+  *pos = p;
+
+  return (n_read > 0) ? lines : 0;
+}
+
 char *
 gtk_trim_string (const char *str)
 {
@@ -11,6 +11,9 @@ gboolean        gtk_scan_string         (const char     **pos,
 gboolean        gtk_skip_space          (const char     **pos);
 gint            gtk_read_line           (FILE            *stream,
                                          GString         *str);
+gint            gtk_read_line_from_string (const char   **pos,
+                                           const char    *end,
+                                           GString       *str);
 char *          gtk_trim_string         (const char      *str);
 char **         gtk_split_file_list     (const char      *str);
 
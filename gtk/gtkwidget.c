@@ -45,6 +45,7 @@
 #include "gtkcssstylepropertyprivate.h"
 #include "gtkintl.h"
 #include "gtkmarshalers.h"
+#include "gtkmemoryaccountingprivate.h"
 #include "gtksettingsprivate.h"
 #include "gtksizegroup-private.h"
 #include "gtkwidget.h"
@@ -76,6 +77,7 @@
 #include "gtkdebugupdatesprivate.h"
 #include "gsk/gskdebugprivate.h"
 #include "gsk/gskrendererprivate.h"
+#include "gsk/gskrendernodeprivate.h"
 #include "gtkeventcontrollerlegacyprivate.h"
 #include "gtkcssfontvariationsvalueprivate.h"
 
@@ -438,6 +440,8 @@ typedef struct {
   gchar               *name;           /* Name of the template automatic child */
   gboolean             internal_child; /* Whether the automatic widget should be exported as an <internal-child> */
   gssize               offset;         /* Instance private data offset where to set the automatic child (or 0) */
+  guint                object_index;   /* Position of the child in builder creation order, learned from the
+                                        * first instance (or G_MAXUINT while unknown) */
 } AutomaticChildClass;
 
 typedef struct {
@@ -3016,6 +3020,7 @@ gtk_widget_init (GTypeInstance *instance, gpointer g_class)
   priv->sensitive = TRUE;
   priv->alloc_needed = TRUE;
   priv->alloc_needed_on_child = TRUE;
+  priv->draw_needed = TRUE;
   priv->focus_on_click = TRUE;
 #ifdef G_ENABLE_DEBUG
   priv->highlight_resize = FALSE;
@@ -3061,6 +3066,8 @@ gtk_widget_init (GTypeInstance *instance, gpointer g_class)
   gtk_css_node_set_widget_type (priv->cssnode, G_TYPE_FROM_CLASS (g_class));
 
   gtk_widget_init_legacy_controller (widget);
+
+  gtk_memory_accounting_add_instance (widget);
 }
 
 
@@ -3959,6 +3966,11 @@ gtk_widget_unrealize (GtkWidget *widget)
       g_signal_emit (widget, widget_signals[UNREALIZE], 0);
       g_assert (!widget->priv->mapped);
       gtk_widget_set_realized (widget, FALSE);
+
+      /* The cached render node may reference resources of the old
+       * renderer, so don't carry it over to the next realization */
+      g_clear_pointer (&widget->priv->render_node, gsk_render_node_unref);
+      widget->priv->draw_needed = TRUE;
     }
 
   gtk_widget_pop_verify_invariants (widget);
@@ -3992,6 +4004,31 @@ gtk_widget_get_window_allocation (GtkWidget     *widget,
   *allocation = alloc;
 }
 
+/*
+ * gtk_widget_set_draw_needed:
+ * @widget: a #GtkWidget
+ *
+ * Marks the render node cached by @widget as out of date, so the next
+ * gtk_widget_snapshot() re-records it instead of reusing it. Because
+ * the cached node of every ancestor contains this widget's node, the
+ * flag is propagated all the way up. We can stop as soon as we hit a
+ * widget that is marked already: its ancestors are guaranteed to be
+ * marked, too.
+ */
+static void
+gtk_widget_set_draw_needed (GtkWidget *widget)
+{
+  GtkWidget *w;
+
+  for (w = widget; w; w = _gtk_widget_get_parent (w))
+    {
+      if (w->priv->draw_needed)
+        break;
+
+      w->priv->draw_needed = TRUE;
+    }
+}
+
 /**
  * gtk_widget_queue_draw_area:
  * @widget: a #GtkWidget
@@ -4050,6 +4087,11 @@ gtk_widget_queue_draw (GtkWidget *widget)
 
   g_return_if_fail (GTK_IS_WIDGET (widget));
 
+  /* For no-window widgets the area below is invalidated on the
+   * parent, so make sure the widget's own cached render node gets
+   * dropped, too */
+  gtk_widget_set_draw_needed (widget);
+
   parent = _gtk_widget_get_parent (widget);
   rect = &widget->priv->clip;
 
@@ -4094,29 +4136,46 @@ gtk_widget_get_resize_needed (GtkWidget *widget)
 }
 
 /*
- * gtk_widget_queue_resize_internal:
+ * gtk_widget_queue_resize_full:
  * @widget: a #GtkWidget
- * 
- * Queue a resize on a widget, and on all other widgets grouped with this widget.
+ * @request_changed: whether the widget's own size request changed
+ *
+ * Queue a resize on a widget, and on all other widgets grouped with
+ * this widget.
+ *
+ * Size group peers only need renegotiation because the group maximum
+ * may have moved - their own requests are untouched - so they are
+ * flagged with @request_changed %FALSE and keep their request caches;
+ * see gtk_widget_ensure_resize(). Parents always pass %TRUE since a
+ * parent's request is computed from its children.
  */
 static void
-gtk_widget_queue_resize_internal (GtkWidget *widget)
+gtk_widget_queue_resize_full (GtkWidget *widget,
+                              gboolean   request_changed)
 {
+  GtkWidgetPrivate *priv = widget->priv;
   GSList *groups, *l, *widgets;
 
   if (gtk_widget_get_resize_needed (widget))
-    return;
+    {
+      if (request_changed)
+        priv->sizegroup_resize = FALSE;
+      return;
+    }
 
-  widget->priv->resize_needed = TRUE;
+  priv->resize_needed = TRUE;
+  priv->sizegroup_resize = !request_changed;
   gtk_widget_set_alloc_needed (widget);
 
   groups = _gtk_widget_get_sizegroups (widget);
 
   for (l = groups; l; l = l->next)
   {
+    _gtk_size_group_invalidate_cache (l->data);
+
     for (widgets = gtk_size_group_get_widgets (l->data); widgets; widgets = widgets->next)
       {
-        gtk_widget_queue_resize_internal (widgets->data);
+        gtk_widget_queue_resize_full (widgets->data, FALSE);
       }
   }
 
@@ -4128,10 +4187,16 @@ gtk_widget_queue_resize_internal (GtkWidget *widget)
     {
       GtkWidget *parent = _gtk_widget_get_parent (widget);
       if (parent)
-        gtk_widget_queue_resize_internal (parent);
+        gtk_widget_queue_resize_full (parent, TRUE);
     }
 }
 
+static void
+gtk_widget_queue_resize_internal (GtkWidget *widget)
+{
+  gtk_widget_queue_resize_full (widget, TRUE);
+}
+
 /**
  * gtk_widget_queue_resize:
  * @widget: a #GtkWidget
@@ -4299,6 +4364,10 @@ gtk_widget_queue_draw_region (GtkWidget            *widget,
   if (cairo_region_is_empty (region))
     return;
 
+  /* Drop the cached render nodes even when unmapped, so that changes
+   * made while the widget is hidden are picked up on the next map */
+  gtk_widget_set_draw_needed (widget);
+
   /* Just return if the widget isn't mapped */
   if (!_gtk_widget_get_mapped (widget))
     return;
@@ -4393,6 +4462,7 @@ gtk_widget_size_allocate (GtkWidget           *widget,
   gboolean size_changed;
   gboolean baseline_changed;
   gboolean position_changed;
+  gboolean pure_move;
   gint natural_width, natural_height, dummy = 0;
   gint min_width, min_height;
   GtkCssStyle *style;
@@ -4451,6 +4521,37 @@ gtk_widget_size_allocate (GtkWidget           *widget,
     }
 #endif /* G_ENABLE_DEBUG */
 
+  /* The adjusted allocation and clip are a pure function of the
+   * incoming allocation, the baseline and the css style, so when all
+   * of those are unchanged and nobody queued a reallocation we can
+   * skip the measuring and adjusting below entirely. Widgets whose
+   * content changed have alloc_needed set via
+   * gtk_widget_queue_resize() or gtk_widget_queue_allocate(), and
+   * size-affecting style changes queue a resize too, so they never
+   * take this path.
+   */
+  if (!priv->alloc_needed &&
+      baseline == priv->allocated_size_baseline &&
+      priv->allocated_size.x == allocation->x &&
+      priv->allocated_size.y == allocation->y &&
+      priv->allocated_size.width == allocation->width &&
+      priv->allocated_size.height == allocation->height)
+    {
+      *out_clip = priv->clip;
+      goto out;
+    }
+
+  /* Only the position of the incoming allocation changed: the measured
+   * sizes and the alignment offsets only depend on the size, so instead
+   * of re-measuring we can translate the previous adjusted allocation.
+   * This is what scrolling a viewport boils down to, so smooth scrolling
+   * of static content does no measuring at all.
+   */
+  pure_move = !priv->alloc_needed &&
+      baseline == priv->allocated_size_baseline &&
+      priv->allocated_size.width == allocation->width &&
+      priv->allocated_size.height == allocation->height;
+
   alloc_needed = priv->alloc_needed;
   /* Preserve request/allocate ordering */
   priv->alloc_needed = FALSE;
@@ -4458,6 +4559,11 @@ gtk_widget_size_allocate (GtkWidget           *widget,
   old_clip = priv->clip;
   real_allocation = *allocation;
 
+  adjusted_allocation.x = priv->allocation.x + allocation->x - priv->allocated_size.x;
+  adjusted_allocation.y = priv->allocation.y + allocation->y - priv->allocated_size.y;
+  adjusted_allocation.width = priv->allocation.width;
+  adjusted_allocation.height = priv->allocation.height;
+
   priv->allocated_size = *allocation;
   priv->allocated_size_baseline = baseline;
 
@@ -4466,6 +4572,12 @@ gtk_widget_size_allocate (GtkWidget           *widget,
   get_box_border (style, &border);
   get_box_padding (style, &padding);
 
+  if (pure_move)
+    {
+      baseline = priv->allocated_baseline;
+      goto skip_measure;
+    }
+
   adjusted_allocation = real_allocation;
   if (gtk_widget_get_request_mode (widget) == GTK_SIZE_REQUEST_HEIGHT_FOR_WIDTH)
     {
@@ -4520,6 +4632,7 @@ gtk_widget_size_allocate (GtkWidget           *widget,
       baseline -= margin.top + border.top + padding.top;
     }
 
+skip_measure:
   if (adjusted_allocation.x < real_allocation.x ||
       adjusted_allocation.y < real_allocation.y ||
       (adjusted_allocation.x + adjusted_allocation.width) >
@@ -4627,6 +4740,12 @@ check_clip:
   position_changed |= (old_clip.x != priv->clip.x ||
                       old_clip.y != priv->clip.y);
 
+  /* The cached render node is recorded in widget-relative coordinates,
+   * so a pure move can reuse it, but any change of size or baseline
+   * cannot */
+  if (size_changed || baseline_changed)
+    gtk_widget_set_draw_needed (widget);
+
   if (_gtk_widget_get_mapped (widget))
     {
       if (position_changed || size_changed || baseline_changed)
@@ -9036,6 +9155,8 @@ gtk_widget_finalize (GObject *object)
 
   g_clear_object (&priv->context);
 
+  g_clear_pointer (&priv->render_node, gsk_render_node_unref);
+
   _gtk_size_request_cache_free (&priv->requests);
 
   for (l = priv->event_controllers; l; l = l->next)
@@ -9066,6 +9187,8 @@ gtk_widget_finalize (GObject *object)
                "reference; the initial floating reference is not owned by anyone\n"
                "and must be removed with g_object_ref_sink().");
 
+  gtk_memory_accounting_remove_instance (widget);
+
   G_OBJECT_CLASS (gtk_widget_parent_class)->finalize (object);
 }
 
@@ -10732,7 +10855,7 @@ accessibility_text (GMarkupParseContext  *context,
 {
   AccessibilitySubParserData *data = (AccessibilitySubParserData*)user_data;
 
-  if (strcmp (g_markup_parse_context_get_element (context), "action") == 0)
+  if (strcmp (_gtk_builder_parser_get_element (context), "action") == 0)
     {
       AtkActionData *action = data->actions->data;
 
@@ -12221,10 +12344,32 @@ gtk_widget_update_alpha (GtkWidget *widget)
 
   if (_gtk_widget_get_realized (widget))
     {
+      GtkWidget *parent;
+      GdkRectangle *rect;
+
       if (_gtk_widget_is_toplevel (widget))
 	gdk_window_set_opacity (priv->window, priv->alpha / 255.0);
 
-      gtk_widget_queue_draw (widget);
+      /* The alpha is applied when compositing the cached render node,
+       * so unlike a regular queue_draw we only need the ancestors
+       * re-composited, not the widget's own node re-recorded. This
+       * keeps opacity fades (overlay scrollbars, crossfades) from
+       * re-snapshotting the faded content every frame.
+       */
+      parent = _gtk_widget_get_parent (widget);
+      rect = &priv->clip;
+
+      /* ... except in fallback draw mode, where the alpha is baked
+       * into the recorded cairo node */
+      if (get_render_mode (GTK_WIDGET_GET_CLASS (widget)) == RENDER_DRAW)
+        gtk_widget_set_draw_needed (widget);
+
+      if (!_gtk_widget_get_has_window (widget))
+        gtk_widget_queue_draw_area (parent ? parent : widget,
+                                    rect->x, rect->y, rect->width, rect->height);
+      else
+        gtk_widget_queue_draw_area (widget,
+                                    0, 0, rect->width, rect->height);
     }
 }
 
@@ -12485,7 +12630,13 @@ gtk_widget_ensure_resize (GtkWidget *widget)
     return;
 
   priv->resize_needed = FALSE;
-  _gtk_size_request_cache_clear (&priv->requests);
+  /* A resize queued only on behalf of a size group peer leaves the
+   * widget's own request cache valid; recomputing the group maximum
+   * then hits the caches of all unchanged members.
+   */
+  if (!priv->sizegroup_resize)
+    _gtk_size_request_cache_clear (&priv->requests);
+  priv->sizegroup_resize = FALSE;
 }
 
 void
@@ -12895,6 +13046,7 @@ template_child_class_new (const gchar *name,
   child_class->name = g_strdup (name);
   child_class->internal_child = internal_child;
   child_class->offset = offset;
+  child_class->object_index = G_MAXUINT;
 
   return child_class;
 }
@@ -12999,7 +13151,12 @@ setup_template_child (GtkWidgetTemplate   *template_data,
   GHashTable *auto_child_hash;
   GObject    *object;
 
-  object = gtk_builder_get_object (builder, child_class->name);
+  /* The class remembers where in builder creation order each child
+   * came from, so every instance after the first resolves its children
+   * by position instead of by name.
+   */
+  object = _gtk_builder_get_object_ordered (builder, child_class->name,
+                                            &child_class->object_index);
   if (!object)
     {
       g_critical ("Unable to retrieve object '%s' from class template for type '%s' while building a '%s'",
@@ -13067,6 +13224,12 @@ gtk_widget_init_template (GtkWidget *widget)
 
   builder = gtk_builder_new ();
 
+  /* Template construction sets many properties back to back; batch
+   * the resulting notifies into a single thaw instead of emitting
+   * each one while the widget is still half built.
+   */
+  g_object_freeze_notify (object);
+
   /* Add any callback symbols declared for this GType to the GtkBuilder namespace */
   for (l = template->callbacks; l; l = l->next)
     {
@@ -13091,6 +13254,7 @@ gtk_widget_init_template (GtkWidget *widget)
       /* This should never happen, if the template XML cannot be built
        * then it is a critical programming error.
        */
+      g_object_thaw_notify (object);
       g_object_unref (builder);
       return;
     }
@@ -13111,6 +13275,7 @@ gtk_widget_init_template (GtkWidget *widget)
 				  widget,
 				  builder))
 	{
+	  g_object_thaw_notify (object);
 	  g_object_unref (builder);
 	  return;
 	}
@@ -13127,6 +13292,8 @@ gtk_widget_init_template (GtkWidget *widget)
   else
     gtk_builder_connect_signals (builder, object);
 
+  g_object_thaw_notify (object);
+
   g_object_unref (builder);
 }
 
@@ -13769,40 +13936,44 @@ gtk_widget_maybe_add_debug_render_nodes (GtkWidget             *widget,
 #endif
 }
 
-void
-gtk_widget_snapshot (GtkWidget   *widget,
-                     GtkSnapshot *snapshot)
+static GskRenderNode *
+gtk_widget_create_render_node (GtkWidget   *widget,
+                               GtkSnapshot *parent_snapshot)
 {
   GtkWidgetClass *klass = GTK_WIDGET_GET_CLASS (widget);
-  GtkWidgetPrivate *priv;
+  GtkWidgetPrivate *priv = widget->priv;
+  GtkSnapshot snapshot;
   GtkCssValue *filter_value;
   RenderMode mode;
-  double opacity;
   cairo_rectangle_int_t offset_clip;
   GtkCssStyle *style;
   GtkAllocation allocation;
   GtkBorder margin, border, padding;
+  GskRenderNodeArena *arena;
+  GskRenderNode *node;
 
-  if (!_gtk_widget_is_drawable (widget))
-    return;
-
-  if (_gtk_widget_get_alloc_needed (widget))
-    {
-      g_warning ("Trying to snapshot %s %p without a current allocation", G_OBJECT_TYPE_NAME (widget), widget);
-      return;
-    }
-
-  priv = widget->priv;
   offset_clip = priv->clip;
   offset_clip.x -= priv->allocation.x;
   offset_clip.y -= priv->allocation.y;
 
-  if (gtk_snapshot_clips_rect (snapshot, &offset_clip))
-    return;
+  /* Record into a fresh snapshot without a clip region: the resulting
+   * node is cached, so it has to contain the complete widget contents,
+   * not just what intersects this frame's expose region. The widget
+   * alpha is deliberately not applied here but when compositing the
+   * cached node, so opacity animations don't invalidate it.
+   *
+   * The cache keeps the node across frames, so record it with the
+   * renderer's per-frame arena suspended: the whole tree has to live
+   * on the heap, not in memory that gets reclaimed when the frame
+   * retires.
+   */
+  arena = gsk_render_node_arena_suspend ();
 
-  opacity = widget->priv->alpha / 255.0;
-  if (opacity <= 0.0)
-    return;
+  gtk_snapshot_init (&snapshot,
+                     gtk_snapshot_get_renderer (parent_snapshot),
+                     parent_snapshot->record_names,
+                     NULL,
+                     "RenderNode<%s>", G_OBJECT_TYPE_NAME (widget));
 
   /* Compatibility mode: if the widget does not have a render node, we draw
    * using gtk_widget_draw() on a temporary node
@@ -13810,10 +13981,10 @@ gtk_widget_snapshot (GtkWidget   *widget,
   mode = get_render_mode (klass);
 
   if (GTK_DEBUG_CHECK (SNAPSHOT))
-    gtk_snapshot_push (snapshot, TRUE, "%s<%p>", gtk_widget_get_name (widget), widget);
+    gtk_snapshot_push (&snapshot, TRUE, "%s<%p>", gtk_widget_get_name (widget), widget);
 
   filter_value = _gtk_style_context_peek_property (_gtk_widget_get_style_context (widget), GTK_CSS_PROPERTY_FILTER);
-  gtk_css_filter_value_push_snapshot (filter_value, snapshot);
+  gtk_css_filter_value_push_snapshot (filter_value, &snapshot);
 
   style = gtk_css_node_get_style (priv->cssnode);
   get_box_margin (style, &margin);
@@ -13833,7 +14004,7 @@ gtk_widget_snapshot (GtkWidget   *widget,
                           offset_clip.width,
                           offset_clip.height);
 
-      cr = gtk_snapshot_append_cairo (snapshot,
+      cr = gtk_snapshot_append_cairo (&snapshot,
                                       &bounds, "Fallback<%s>",
                                       G_OBJECT_TYPE_NAME (widget));
       gtk_widget_draw_internal (widget, cr);
@@ -13841,28 +14012,25 @@ gtk_widget_snapshot (GtkWidget   *widget,
     }
   else
     {
-      if (opacity < 1.0)
-        gtk_snapshot_push_opacity (snapshot, opacity, "Opacity<%s,%f>", G_OBJECT_TYPE_NAME (widget), opacity);
-
       if (!GTK_IS_WINDOW (widget))
         {
-          gtk_snapshot_offset (snapshot, margin.left, margin.top);
+          gtk_snapshot_offset (&snapshot, margin.left, margin.top);
           gtk_css_style_snapshot_background (style,
-                                             snapshot,
+                                             &snapshot,
                                              allocation.width - margin.left - margin.right,
                                              allocation.height - margin.top - margin.bottom);
           gtk_css_style_snapshot_border (style,
-                                         snapshot,
+                                         &snapshot,
                                          allocation.width - margin.left - margin.right,
                                          allocation.height - margin.top - margin.bottom);
-          gtk_snapshot_offset (snapshot, - margin.left, - margin.top);
+          gtk_snapshot_offset (&snapshot, - margin.left, - margin.top);
         }
 
       /* Offset to content allocation */
-      gtk_snapshot_offset (snapshot, margin.left + padding.left + border.left, margin.top + border.top + padding.top);
+      gtk_snapshot_offset (&snapshot, margin.left + padding.left + border.left, margin.top + border.top + padding.top);
       if (gtk_widget_get_width (widget) > 0 || gtk_widget_get_height (widget) > 0)
-        klass->snapshot (widget, snapshot);
-      gtk_snapshot_offset (snapshot, - (margin.left + padding.left + border.left), -(margin.top + border.top + padding.top));
+        klass->snapshot (widget, &snapshot);
+      gtk_snapshot_offset (&snapshot, - (margin.left + padding.left + border.left), -(margin.top + border.top + padding.top));
 
       if (g_signal_has_handler_pending (widget, widget_signals[DRAW], 0, FALSE))
         {
@@ -13879,33 +14047,118 @@ gtk_widget_snapshot (GtkWidget   *widget,
                               offset_clip.width,
                               offset_clip.height);
 
-          cr = gtk_snapshot_append_cairo (snapshot,
+          cr = gtk_snapshot_append_cairo (&snapshot,
                                           &bounds,
                                           "DrawSignalContents<%s>", G_OBJECT_TYPE_NAME (widget));
           g_signal_emit (widget, widget_signals[DRAW], 0, cr, &result);
           cairo_destroy (cr);
         }
 
-      gtk_snapshot_offset (snapshot, margin.left, margin.top);
+      gtk_snapshot_offset (&snapshot, margin.left, margin.top);
       gtk_css_style_snapshot_outline (style,
-                                      snapshot,
+                                      &snapshot,
                                       allocation.width - margin.left - margin.right,
                                       allocation.height - margin.top - margin.bottom);
-      gtk_snapshot_offset (snapshot, - margin.left, - margin.top);
-
-      if (opacity < 1.0)
-        gtk_snapshot_pop (snapshot);
+      gtk_snapshot_offset (&snapshot, - margin.left, - margin.top);
     }
 
 
-  gtk_css_filter_value_pop_snapshot (filter_value, snapshot);
+  gtk_css_filter_value_pop_snapshot (filter_value, &snapshot);
 
 #ifdef G_ENABLE_DEBUG
-  gtk_widget_maybe_add_debug_render_nodes (widget, snapshot);
+  gtk_widget_maybe_add_debug_render_nodes (widget, &snapshot);
 #endif
 
 
   if (GTK_DEBUG_CHECK (SNAPSHOT))
+    gtk_snapshot_pop (&snapshot);
+
+  node = gtk_snapshot_finish (&snapshot);
+
+  gsk_render_node_arena_resume (arena);
+
+  return node;
+}
+
+void
+gtk_widget_snapshot (GtkWidget   *widget,
+                     GtkSnapshot *snapshot)
+{
+  GtkWidgetPrivate *priv;
+  cairo_rectangle_int_t offset_clip;
+  double opacity;
+  gboolean need_opacity;
+  int x, y;
+
+  if (!_gtk_widget_is_drawable (widget))
+    return;
+
+  if (_gtk_widget_get_alloc_needed (widget))
+    {
+      g_warning ("Trying to snapshot %s %p without a current allocation", G_OBJECT_TYPE_NAME (widget), widget);
+      return;
+    }
+
+  priv = widget->priv;
+  offset_clip = priv->clip;
+  offset_clip.x -= priv->allocation.x;
+  offset_clip.y -= priv->allocation.y;
+
+  if (gtk_snapshot_clips_rect (snapshot, &offset_clip))
+    return;
+
+  if (priv->alpha == 0)
+    return;
+
+  /* The cached node is kept in widget-relative coordinates, so as long
+   * as neither allocation nor style changed and nobody queued a redraw,
+   * we can reuse it as is - including after a pure move, which only
+   * changes the offset it is appended at.
+   */
+  if (priv->draw_needed)
+    {
+      GskRenderNode *node;
+
+      node = gtk_widget_create_render_node (widget, snapshot);
+      g_clear_pointer (&priv->render_node, gsk_render_node_unref);
+      priv->render_node = node;
+      priv->draw_needed = FALSE;
+    }
+
+  if (priv->render_node == NULL)
+    return;
+
+  /* The widget alpha is applied here, on top of the cached node, so
+   * that fading a widget in or out only re-composites its node instead
+   * of re-recording the whole subtree. The fallback draw path handles
+   * alpha itself, so don't apply it twice there.
+   */
+  opacity = priv->alpha / 255.0;
+  need_opacity = opacity < 1.0 &&
+      get_render_mode (GTK_WIDGET_GET_CLASS (widget)) != RENDER_DRAW;
+
+  if (need_opacity)
+    gtk_snapshot_push_opacity (snapshot, opacity, "Opacity<%s,%f>", G_OBJECT_TYPE_NAME (widget), opacity);
+
+  gtk_snapshot_get_offset (snapshot, &x, &y);
+  if (x != 0 || y != 0)
+    {
+      graphene_matrix_t transform;
+      GskRenderNode *transform_node;
+
+      graphene_matrix_init_translate (&transform, &GRAPHENE_POINT3D_INIT (x, y, 0));
+      transform_node = gsk_transform_node_new (priv->render_node, &transform);
+      if (snapshot->record_names)
+        gsk_render_node_set_name (transform_node, "CachedWidgetNode");
+      gtk_snapshot_append_node (snapshot, transform_node);
+      gsk_render_node_unref (transform_node);
+    }
+  else
+    {
+      gtk_snapshot_append_node (snapshot, priv->render_node);
+    }
+
+  if (need_opacity)
     gtk_snapshot_pop (snapshot);
 }
 
@@ -13927,6 +14180,7 @@ gtk_widget_render (GtkWidget            *widget,
   GskRenderer *renderer;
   GskRenderNode *root;
   cairo_region_t *clip;
+  static gboolean first_frame_rendered = FALSE;
 
   /* We only render double buffered on native windows */
   if (!gdk_window_has_native (window))
@@ -13962,6 +14216,16 @@ gtk_widget_render (GtkWidget            *widget,
 
 
   gsk_renderer_end_draw_frame (renderer, context);
+
+  if (G_UNLIKELY (!first_frame_rendered))
+    {
+      /* Point event: the duration field is ~0, the interesting part
+       * is the timestamp relative to the other startup marks
+       */
+      _gtk_profile_mark (_gtk_profile_start (), "first-frame",
+                         G_OBJECT_TYPE_NAME (renderer));
+      first_frame_rendered = TRUE;
+    }
 }
 
 /**
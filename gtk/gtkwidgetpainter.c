@@ -0,0 +1,403 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "gtkwidgetpainter.h"
+
+#include "gtkwidgetprivate.h"
+#include "gtksnapshotprivate.h"
+#include "gtkintl.h"
+
+#include "gsk/gskrendernodeprivate.h"
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * SECTION:gtkwidgetpainter
+ * @title: GtkWidgetPainter
+ * @short_description: Paints a widget to a retained offscreen texture
+ * @see_also: #GdkTexture
+ *
+ * #GtkWidgetPainter renders a widget into a texture that can be shown
+ * in another widget's snapshot, for example to implement a minimap or
+ * a preview of a widget that is visible elsewhere.
+ *
+ * The painter keeps the target texture between calls. When
+ * gtk_widget_painter_get_texture() is called again, the widget's
+ * current render nodes are compared against the ones that were last
+ * painted and only the areas whose nodes changed are repainted; if
+ * nothing changed, the retained texture is returned without any
+ * drawing. Renderers are told about the damaged region via
+ * gdk_texture_update(), so they also only re-upload changed pixels.
+ */
+
+struct _GtkWidgetPainter
+{
+  GObject parent_instance;
+
+  GtkWidget *widget;
+
+  cairo_surface_t *surface;
+  GdkTexture *texture;
+  GskRenderNode *rendered_node;
+};
+
+enum {
+  PROP_0,
+  PROP_WIDGET,
+  NUM_PROPERTIES
+};
+
+static GParamSpec *properties[NUM_PROPERTIES] = { NULL, };
+
+G_DEFINE_TYPE (GtkWidgetPainter, gtk_widget_painter, G_TYPE_OBJECT)
+
+static void
+gtk_widget_painter_drop_target (GtkWidgetPainter *self)
+{
+  g_clear_pointer (&self->surface, cairo_surface_destroy);
+  g_clear_object (&self->texture);
+  g_clear_pointer (&self->rendered_node, gsk_render_node_unref);
+}
+
+static void
+gtk_widget_painter_widget_destroyed (GtkWidget        *widget,
+                                     GtkWidgetPainter *self)
+{
+  self->widget = NULL;
+  gtk_widget_painter_drop_target (self);
+}
+
+static void
+gtk_widget_painter_get_property (GObject     *object,
+                                 guint        prop_id,
+                                 GValue      *value,
+                                 GParamSpec  *pspec)
+{
+  GtkWidgetPainter *self = GTK_WIDGET_PAINTER (object);
+
+  switch (prop_id)
+    {
+    case PROP_WIDGET:
+      g_value_set_object (value, self->widget);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+gtk_widget_painter_dispose (GObject *object)
+{
+  GtkWidgetPainter *self = GTK_WIDGET_PAINTER (object);
+
+  if (self->widget)
+    {
+      g_signal_handlers_disconnect_by_func (self->widget,
+                                            gtk_widget_painter_widget_destroyed,
+                                            self);
+      g_clear_object (&self->widget);
+    }
+
+  gtk_widget_painter_drop_target (self);
+
+  G_OBJECT_CLASS (gtk_widget_painter_parent_class)->dispose (object);
+}
+
+static void
+gtk_widget_painter_class_init (GtkWidgetPainterClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->get_property = gtk_widget_painter_get_property;
+  gobject_class->dispose = gtk_widget_painter_dispose;
+
+  /**
+   * GtkWidgetPainter:widget:
+   *
+   * The widget being painted
+   */
+  properties[PROP_WIDGET] =
+      g_param_spec_object ("widget",
+                           P_("Widget"),
+                           P_("The widget being painted"),
+                           GTK_TYPE_WIDGET,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
+}
+
+static void
+gtk_widget_painter_init (GtkWidgetPainter *self)
+{
+}
+
+static void
+add_node_bounds (GskRenderNode  *node,
+                 cairo_region_t *damage)
+{
+  graphene_rect_t bounds;
+  cairo_rectangle_int_t rect;
+
+  gsk_render_node_get_bounds (node, &bounds);
+
+  rect.x = floorf (bounds.origin.x);
+  rect.y = floorf (bounds.origin.y);
+  rect.width = ceilf (bounds.origin.x + bounds.size.width) - rect.x;
+  rect.height = ceilf (bounds.origin.y + bounds.size.height) - rect.y;
+
+  cairo_region_union_rectangle (damage, &rect);
+}
+
+/* Collects the bounds of all subtrees that differ between the node
+ * trees into @damage. Widgets keep their render node between frames
+ * unless they were redrawn, so undamaged subtrees are recognized by
+ * pointer equality. Container and equal-transform nodes are recursed
+ * into, since re-recording a parent recreates those wrappers around
+ * unchanged child nodes.
+ */
+static void
+diff_nodes (GskRenderNode  *old,
+            GskRenderNode  *new,
+            cairo_region_t *damage)
+{
+  GskRenderNodeType type;
+
+  if (old == new)
+    return;
+
+  if (old == NULL || new == NULL)
+    {
+      if (old)
+        add_node_bounds (old, damage);
+      if (new)
+        add_node_bounds (new, damage);
+      return;
+    }
+
+  type = gsk_render_node_get_node_type (new);
+  if (gsk_render_node_get_node_type (old) != type)
+    {
+      add_node_bounds (old, damage);
+      add_node_bounds (new, damage);
+      return;
+    }
+
+  if (type == GSK_CONTAINER_NODE &&
+      gsk_container_node_get_n_children (old) == gsk_container_node_get_n_children (new))
+    {
+      guint i, n;
+
+      for (i = 0, n = gsk_container_node_get_n_children (new); i < n; i++)
+        diff_nodes (gsk_container_node_get_child (old, i),
+                    gsk_container_node_get_child (new, i),
+                    damage);
+      return;
+    }
+
+  if (type == GSK_TRANSFORM_NODE)
+    {
+      float m_old[16], m_new[16];
+
+      graphene_matrix_to_float (gsk_transform_node_peek_transform (old), m_old);
+      graphene_matrix_to_float (gsk_transform_node_peek_transform (new), m_new);
+
+      if (memcmp (m_old, m_new, sizeof (m_old)) == 0)
+        {
+          diff_nodes (gsk_transform_node_get_child (old),
+                      gsk_transform_node_get_child (new),
+                      damage);
+          return;
+        }
+    }
+
+  add_node_bounds (old, damage);
+  add_node_bounds (new, damage);
+}
+
+/**
+ * gtk_widget_painter_new:
+ * @widget: the widget to paint
+ *
+ * Creates a new #GtkWidgetPainter that renders @widget into a
+ * retained texture.
+ *
+ * Returns: a new #GtkWidgetPainter
+ */
+GtkWidgetPainter *
+gtk_widget_painter_new (GtkWidget *widget)
+{
+  GtkWidgetPainter *self;
+
+  g_return_val_if_fail (GTK_IS_WIDGET (widget), NULL);
+
+  self = g_object_new (GTK_TYPE_WIDGET_PAINTER, NULL);
+
+  self->widget = g_object_ref (widget);
+  g_signal_connect (widget, "destroy",
+                    G_CALLBACK (gtk_widget_painter_widget_destroyed), self);
+
+  return self;
+}
+
+/**
+ * gtk_widget_painter_get_widget:
+ * @self: a #GtkWidgetPainter
+ *
+ * Gets the widget painted by @self.
+ *
+ * Returns: (transfer none) (nullable): the widget, or %NULL if it
+ *     was destroyed
+ */
+GtkWidget *
+gtk_widget_painter_get_widget (GtkWidgetPainter *self)
+{
+  g_return_val_if_fail (GTK_IS_WIDGET_PAINTER (self), NULL);
+
+  return self->widget;
+}
+
+/**
+ * gtk_widget_painter_invalidate:
+ * @self: a #GtkWidgetPainter
+ *
+ * Forces a full repaint the next time the texture is requested,
+ * discarding all retained contents.
+ */
+void
+gtk_widget_painter_invalidate (GtkWidgetPainter *self)
+{
+  g_return_if_fail (GTK_IS_WIDGET_PAINTER (self));
+
+  gtk_widget_painter_drop_target (self);
+}
+
+/**
+ * gtk_widget_painter_get_texture:
+ * @self: a #GtkWidgetPainter
+ *
+ * Gets the texture with the current contents of the widget,
+ * repainting the parts of the retained texture whose render nodes
+ * changed since the last call. If nothing changed, no drawing
+ * happens at all.
+ *
+ * The returned texture stays owned by @self and remains valid until
+ * the next call to this function; use it by appending it to a
+ * snapshot with gtk_snapshot_append_texture().
+ *
+ * Returns: (transfer none) (nullable): the texture, or %NULL if the
+ *     widget cannot be rendered (for example, it is not drawable)
+ */
+GdkTexture *
+gtk_widget_painter_get_texture (GtkWidgetPainter *self)
+{
+  GtkSnapshot snapshot;
+  GskRenderNode *node;
+  GskRenderNodeArena *arena;
+  cairo_region_t *damage;
+  cairo_rectangle_int_t extent;
+  cairo_t *cr;
+  GBytes *bytes;
+  int width, height, stride;
+
+  g_return_val_if_fail (GTK_IS_WIDGET_PAINTER (self), NULL);
+
+  if (self->widget == NULL || !_gtk_widget_is_drawable (self->widget))
+    return NULL;
+
+  width = gtk_widget_get_allocated_width (self->widget);
+  height = gtk_widget_get_allocated_height (self->widget);
+  if (width <= 0 || height <= 0)
+    return NULL;
+
+  if (self->surface != NULL &&
+      (cairo_image_surface_get_width (self->surface) != width ||
+       cairo_image_surface_get_height (self->surface) != height))
+    gtk_widget_painter_drop_target (self);
+
+  /* The recorded tree is retained in self->rendered_node until the
+   * next call and compared against it, so it must not contain nodes
+   * from a renderer's per-frame arena: those get reclaimed when the
+   * frame retires, and a later allocation could even reuse the same
+   * address and defeat the pointer comparison. Record on the heap.
+   */
+  arena = gsk_render_node_arena_suspend ();
+
+  gtk_snapshot_init (&snapshot, NULL, FALSE, NULL, "WidgetPainter<%s>",
+                     G_OBJECT_TYPE_NAME (self->widget));
+  gtk_widget_snapshot (self->widget, &snapshot);
+  node = gtk_snapshot_finish (&snapshot);
+
+  gsk_render_node_arena_resume (arena);
+
+  if (node == NULL)
+    return NULL;
+
+  if (node == self->rendered_node && self->texture != NULL)
+    {
+      gsk_render_node_unref (node);
+      return self->texture;
+    }
+
+  if (self->surface == NULL)
+    self->surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                                width, height);
+
+  damage = cairo_region_create ();
+  diff_nodes (self->rendered_node, node, damage);
+
+  extent.x = 0;
+  extent.y = 0;
+  extent.width = width;
+  extent.height = height;
+  cairo_region_intersect_rectangle (damage, &extent);
+
+  cr = cairo_create (self->surface);
+  gdk_cairo_region (cr, damage);
+  cairo_clip (cr);
+
+  cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint (cr);
+  cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+
+  gsk_render_node_draw (node, cr);
+  cairo_destroy (cr);
+  cairo_surface_flush (self->surface);
+
+  stride = cairo_image_surface_get_stride (self->surface);
+  bytes = g_bytes_new_with_free_func (cairo_image_surface_get_data (self->surface),
+                                      (gsize) stride * height,
+                                      (GDestroyNotify) cairo_surface_destroy,
+                                      cairo_surface_reference (self->surface));
+
+  if (self->texture == NULL)
+    self->texture = gdk_texture_new_for_bytes (bytes, width, height, stride);
+  else
+    gdk_texture_update (self->texture, bytes, damage);
+
+  g_bytes_unref (bytes);
+  cairo_region_destroy (damage);
+
+  g_clear_pointer (&self->rendered_node, gsk_render_node_unref);
+  self->rendered_node = node;
+
+  return self->texture;
+}
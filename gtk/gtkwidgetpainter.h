@@ -0,0 +1,46 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTK_WIDGET_PAINTER_H__
+#define __GTK_WIDGET_PAINTER_H__
+
+#if !defined (__GTK_H_INSIDE__) && !defined (GTK_COMPILATION)
+#error "Only <gtk/gtk.h> can be included directly."
+#endif
+
+#include <gtk/gtkwidget.h>
+
+G_BEGIN_DECLS
+
+#define GTK_TYPE_WIDGET_PAINTER (gtk_widget_painter_get_type ())
+
+GDK_AVAILABLE_IN_ALL
+G_DECLARE_FINAL_TYPE (GtkWidgetPainter, gtk_widget_painter, GTK, WIDGET_PAINTER, GObject)
+
+GDK_AVAILABLE_IN_ALL
+GtkWidgetPainter *      gtk_widget_painter_new          (GtkWidget        *widget);
+
+GDK_AVAILABLE_IN_ALL
+GtkWidget *             gtk_widget_painter_get_widget   (GtkWidgetPainter *self);
+GDK_AVAILABLE_IN_ALL
+GdkTexture *            gtk_widget_painter_get_texture  (GtkWidgetPainter *self);
+GDK_AVAILABLE_IN_ALL
+void                    gtk_widget_painter_invalidate   (GtkWidgetPainter *self);
+
+G_END_DECLS
+
+#endif /* __GTK_WIDGET_PAINTER_H__ */
@@ -883,6 +883,27 @@ gtk_widget_path_iter_list_classes (const GtkWidgetPath *path,
   return g_slist_reverse (list);
 }
 
+/* Like gtk_widget_path_iter_list_classes(), but returns the quark
+ * array directly without allocating, for hot paths like computing
+ * ancestor bloom filters.
+ */
+const GQuark *
+gtk_widget_path_iter_get_qclasses (const GtkWidgetPath *path,
+                                   gint                 pos,
+                                   guint               *n_classes)
+{
+  GtkPathElement *elem;
+
+  gtk_internal_return_val_if_fail (path != NULL, NULL);
+  gtk_internal_return_val_if_fail (path->elems->len != 0, NULL);
+
+  if (pos < 0 || pos >= path->elems->len)
+    pos = path->elems->len - 1;
+
+  elem = &g_array_index (path->elems, GtkPathElement, pos);
+  return gtk_css_node_declaration_get_classes (elem->decl, n_classes);
+}
+
 /**
  * gtk_widget_path_iter_has_qclass:
  * @path: a #GtkWidgetPath
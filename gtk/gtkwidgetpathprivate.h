@@ -25,6 +25,9 @@ G_BEGIN_DECLS
 void gtk_widget_path_iter_add_qclass (GtkWidgetPath *path,
                                       gint           pos,
                                       GQuark         qname);
+const GQuark *gtk_widget_path_iter_get_qclasses (const GtkWidgetPath *path,
+                                                 gint                 pos,
+                                                 guint               *n_classes);
 
 G_END_DECLS
 
@@ -73,8 +73,11 @@ struct _GtkWidgetPrivate
 
   /* Queue-resize related flags */
   guint resize_needed         : 1; /* queue_resize() has been called but no get_preferred_size() yet */
+  guint sizegroup_resize      : 1; /* resize_needed was set on behalf of a size group peer only;
+                                    * the widget's own cached size requests are still valid */
   guint alloc_needed          : 1; /* this widget needs a size_allocate() call */
   guint alloc_needed_on_child : 1; /* 0 or more children - or this widget - need a size_allocate() call */
+  guint draw_needed           : 1; /* the cached render node is out of date and needs re-recording */
 
   /* Expand-related flags */
   guint need_compute_expand   : 1; /* Need to recompute computed_[hv]_expand */
@@ -164,6 +167,10 @@ struct _GtkWidgetPrivate
 
   /* Pointer cursor */
   GdkCursor *cursor;
+
+  /* Cached render node in widget-relative coordinates, reused by
+   * gtk_widget_snapshot() while draw_needed is unset */
+  GskRenderNode *render_node;
 };
 
 GtkCssNode *  gtk_widget_get_css_node       (GtkWidget *widget);
@@ -6115,6 +6115,7 @@ gtk_window_show (GtkWidget *widget)
   GtkWindow *window = GTK_WINDOW (widget);
   GtkWindowPrivate *priv = window->priv;
   GtkContainer *container = GTK_CONTAINER (window);
+  static gboolean first_style_validated = FALSE;
 
   if (!_gtk_widget_is_toplevel (GTK_WIDGET (widget)))
     {
@@ -6124,7 +6125,17 @@ gtk_window_show (GtkWidget *widget)
 
   _gtk_widget_set_visible_flag (widget, TRUE);
 
-  gtk_css_node_validate (gtk_widget_get_css_node (widget));
+  if (G_UNLIKELY (!first_style_validated))
+    {
+      gint64 profile_start = _gtk_profile_start ();
+
+      gtk_css_node_validate (gtk_widget_get_css_node (widget));
+
+      _gtk_profile_mark (profile_start, "first-style-validation", NULL);
+      first_style_validated = TRUE;
+    }
+  else
+    gtk_css_node_validate (gtk_widget_get_css_node (widget));
 
   gtk_widget_realize (widget);
 
@@ -63,6 +63,14 @@ struct _GtkWindowGroupPrivate
 {
   GSList *grabs;
   GSList *device_grabs;
+
+  /* Resolved device -> grab widget table, so that per-event grab
+   * lookups don't have to walk the grab lists. Entries are computed
+   * lazily and the whole table is dropped whenever a device grab is
+   * added or removed.
+   */
+  GHashTable *device_grab_cache;
+  guint n_blocking_device_grabs;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkWindowGroup, gtk_window_group, G_TYPE_OBJECT)
@@ -73,9 +81,31 @@ gtk_window_group_init (GtkWindowGroup *group)
   group->priv = gtk_window_group_get_instance_private (group);
 }
 
+static void
+gtk_window_group_finalize (GObject *object)
+{
+  GtkWindowGroup *group = GTK_WINDOW_GROUP (object);
+
+  g_clear_pointer (&group->priv->device_grab_cache, g_hash_table_unref);
+
+  G_OBJECT_CLASS (gtk_window_group_parent_class)->finalize (object);
+}
+
 static void
 gtk_window_group_class_init (GtkWindowGroupClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtk_window_group_finalize;
+}
+
+static void
+window_group_device_grabs_changed (GtkWindowGroup *window_group)
+{
+  GtkWindowGroupPrivate *priv = window_group->priv;
+
+  if (priv->device_grab_cache)
+    g_hash_table_remove_all (priv->device_grab_cache);
 }
 
 
@@ -307,6 +337,10 @@ _gtk_window_group_add_device_grab (GtkWindowGroup *window_group,
   info->block_others = block_others;
 
   priv->device_grabs = g_slist_prepend (priv->device_grabs, info);
+  if (block_others)
+    priv->n_blocking_device_grabs++;
+
+  window_group_device_grabs_changed (window_group);
 
   revoke_implicit_grabs (window_group, device, widget);
 }
@@ -345,7 +379,11 @@ _gtk_window_group_remove_device_grab (GtkWindowGroup *window_group,
       info = node->data;
 
       priv->device_grabs = g_slist_delete_link (priv->device_grabs, node);
+      if (info->block_others)
+        priv->n_blocking_device_grabs--;
       g_slice_free (GtkDeviceGrabInfo, info);
+
+      window_group_device_grabs_changed (window_group);
     }
 }
 
@@ -365,14 +403,32 @@ gtk_window_group_get_current_device_grab (GtkWindowGroup *window_group,
   GtkWindowGroupPrivate *priv;
   GtkDeviceGrabInfo *info;
   GdkDevice *other_device;
+  GtkWidget *widget;
   GSList *list;
 
   g_return_val_if_fail (GTK_IS_WINDOW_GROUP (window_group), NULL);
   g_return_val_if_fail (GDK_IS_DEVICE (device), NULL);
 
   priv = window_group->priv;
-  list = priv->device_grabs;
+
+  if (priv->device_grabs == NULL)
+    return NULL;
+
+  if (priv->device_grab_cache)
+    {
+      gpointer cached;
+
+      if (g_hash_table_lookup_extended (priv->device_grab_cache, device,
+                                        NULL, &cached))
+        return cached;
+    }
+  else
+    priv->device_grab_cache = g_hash_table_new_full (NULL, NULL,
+                                                     g_object_unref, NULL);
+
   other_device = gdk_device_get_associated_device (device);
+  widget = NULL;
+  list = priv->device_grabs;
 
   while (list)
     {
@@ -381,10 +437,19 @@ gtk_window_group_get_current_device_grab (GtkWindowGroup *window_group,
 
       if (info->device == device ||
           info->device == other_device)
-        return info->widget;
+        {
+          widget = info->widget;
+          break;
+        }
     }
 
-  return NULL;
+  /* Negative results are cached too; the table is dropped on the next
+   * grab change, and the grab keeps the widget alive meanwhile.
+   */
+  g_hash_table_insert (priv->device_grab_cache,
+                       g_object_ref (device), widget);
+
+  return widget;
 }
 
 gboolean
@@ -398,6 +463,10 @@ _gtk_window_group_widget_is_blocked_for_device (GtkWindowGroup *window_group,
   GSList *list;
 
   priv = window_group->priv;
+
+  if (priv->n_blocking_device_grabs == 0)
+    return FALSE;
+
   other_device = gdk_device_get_associated_device (device);
   list = priv->device_grabs;
 
@@ -54,6 +54,8 @@ struct _GtkInspectorRecorderPrivate
   GtkWidget *render_node_save_button;
   GtkWidget *node_property_tree;
   GtkTreeModel *render_node_properties;
+  GtkWidget *node_stats_tree;
+  GtkTreeModel *node_stats_model;
 
   GtkInspectorRecording *recording; /* start recording if recording or NULL if not */
 
@@ -62,6 +64,7 @@ struct _GtkInspectorRecorderPrivate
 
 enum {
   COLUMN_NODE_NAME,
+  COLUMN_NODE_WEIGHT,
   /* add more */
   N_NODE_COLUMNS
 };
@@ -78,6 +81,9 @@ static GParamSpec *props[LAST_PROP] = { NULL, };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkInspectorRecorder, gtk_inspector_recorder, GTK_TYPE_BIN)
 
+static void populate_node_stats (GtkListStore  *store,
+                                 GskRenderNode *node);
+
 static void
 recordings_clear_all (GtkButton            *button,
                       GtkInspectorRecorder *recorder)
@@ -112,11 +118,14 @@ recordings_list_row_selected (GtkListBox           *box,
                                          gtk_inspector_render_recording_get_area (GTK_INSPECTOR_RENDER_RECORDING (recording)));
       gtk_tree_model_render_node_set_root_node (GTK_TREE_MODEL_RENDER_NODE (priv->render_node_model),
                                                 gtk_inspector_render_recording_get_node (GTK_INSPECTOR_RENDER_RECORDING (recording)));
+      populate_node_stats (GTK_LIST_STORE (priv->node_stats_model),
+                           gtk_inspector_render_recording_get_node (GTK_INSPECTOR_RENDER_RECORDING (recording)));
     }
   else
     {
       gtk_render_node_view_set_render_node (GTK_RENDER_NODE_VIEW (priv->render_node_view), NULL);
       gtk_tree_model_render_node_set_root_node (GTK_TREE_MODEL_RENDER_NODE (priv->render_node_model), NULL);
+      gtk_list_store_clear (GTK_LIST_STORE (priv->node_stats_model));
     }
 
   gtk_tree_view_expand_all (GTK_TREE_VIEW (priv->render_node_tree));
@@ -125,6 +134,34 @@ recordings_list_row_selected (GtkListBox           *box,
     g_object_unref (recording);
 }
 
+/* Whether rendering this node requires drawing its content to an
+ * offscreen surface first. Offscreen passes are a common source of
+ * rendering slowness, so the recorder highlights nodes that force
+ * them.
+ */
+static gboolean
+node_forces_offscreen (GskRenderNode *node)
+{
+  switch (gsk_render_node_get_node_type (node))
+    {
+    case GSK_OPACITY_NODE:
+      /* Non-container children can be drawn with their alpha adjusted
+       * instead of getting group opacity via an offscreen
+       */
+      return gsk_render_node_get_node_type (gsk_opacity_node_get_child (node)) == GSK_CONTAINER_NODE;
+
+    case GSK_COLOR_MATRIX_NODE:
+    case GSK_REPEAT_NODE:
+    case GSK_BLEND_NODE:
+    case GSK_CROSS_FADE_NODE:
+    case GSK_BLUR_NODE:
+      return TRUE;
+
+    default:
+      return FALSE;
+    }
+}
+
 static void
 render_node_list_get_value (GtkTreeModelRenderNode *model,
                             GskRenderNode          *node,
@@ -137,6 +174,11 @@ render_node_list_get_value (GtkTreeModelRenderNode *model,
       g_value_set_string (value, gsk_render_node_get_name (node));
       break;
 
+    case COLUMN_NODE_WEIGHT:
+      g_value_set_int (value, node_forces_offscreen (node) ? PANGO_WEIGHT_BOLD
+                                                           : PANGO_WEIGHT_NORMAL);
+      break;
+
     default:
       g_assert_not_reached ();
       break;
@@ -195,6 +237,136 @@ node_type_name (GskRenderNodeType type)
     }
 }
 
+typedef struct
+{
+  guint count;
+  guint64 pixels;
+  guint offscreens;
+} NodeStats;
+
+static void
+collect_node_stats (GskRenderNode *node,
+                    NodeStats     *stats)
+{
+  GskRenderNodeType type = gsk_render_node_get_node_type (node);
+  graphene_rect_t bounds;
+  guint i;
+
+  gsk_render_node_get_bounds (node, &bounds);
+
+  stats[type].count++;
+  stats[type].pixels += (guint64) (bounds.size.width * bounds.size.height);
+  if (node_forces_offscreen (node))
+    stats[type].offscreens++;
+
+  switch (type)
+    {
+    case GSK_TRANSFORM_NODE:
+      collect_node_stats (gsk_transform_node_get_child (node), stats);
+      break;
+
+    case GSK_OPACITY_NODE:
+      collect_node_stats (gsk_opacity_node_get_child (node), stats);
+      break;
+
+    case GSK_COLOR_MATRIX_NODE:
+      collect_node_stats (gsk_color_matrix_node_get_child (node), stats);
+      break;
+
+    case GSK_BLUR_NODE:
+      collect_node_stats (gsk_blur_node_get_child (node), stats);
+      break;
+
+    case GSK_REPEAT_NODE:
+      collect_node_stats (gsk_repeat_node_get_child (node), stats);
+      break;
+
+    case GSK_CLIP_NODE:
+      collect_node_stats (gsk_clip_node_get_child (node), stats);
+      break;
+
+    case GSK_ROUNDED_CLIP_NODE:
+      collect_node_stats (gsk_rounded_clip_node_get_child (node), stats);
+      break;
+
+    case GSK_SHADOW_NODE:
+      collect_node_stats (gsk_shadow_node_get_child (node), stats);
+      break;
+
+    case GSK_BLEND_NODE:
+      collect_node_stats (gsk_blend_node_get_bottom_child (node), stats);
+      collect_node_stats (gsk_blend_node_get_top_child (node), stats);
+      break;
+
+    case GSK_CROSS_FADE_NODE:
+      collect_node_stats (gsk_cross_fade_node_get_start_child (node), stats);
+      collect_node_stats (gsk_cross_fade_node_get_end_child (node), stats);
+      break;
+
+    case GSK_CONTAINER_NODE:
+      for (i = 0; i < gsk_container_node_get_n_children (node); i++)
+        collect_node_stats (gsk_container_node_get_child (node, i), stats);
+      break;
+
+    default:
+      break;
+    }
+}
+
+static void
+add_node_stats_row (GtkListStore *store,
+                    const char   *name,
+                    NodeStats    *stats)
+{
+  char *count = g_strdup_printf ("%u", stats->count);
+  char *pixels = g_strdup_printf ("%" G_GUINT64_FORMAT, stats->pixels);
+  char *offscreens = g_strdup_printf ("%u", stats->offscreens);
+
+  gtk_list_store_insert_with_values (store, NULL, -1,
+                                     0, name,
+                                     1, count,
+                                     2, pixels,
+                                     3, offscreens,
+                                     4, stats->offscreens > 0 ? PANGO_WEIGHT_BOLD
+                                                              : PANGO_WEIGHT_NORMAL,
+                                     -1);
+  g_free (count);
+  g_free (pixels);
+  g_free (offscreens);
+}
+
+/* The pixel counts are the sum of node bounds, so they estimate the
+ * rasterization and blend cost of each node type; nodes that force
+ * offscreen passes additionally pay for a render target switch and
+ * are shown in bold.
+ */
+static void
+populate_node_stats (GtkListStore  *store,
+                     GskRenderNode *node)
+{
+  NodeStats stats[GSK_BLUR_NODE + 1] = { { 0, }, };
+  NodeStats total = { 0, };
+  guint i;
+
+  gtk_list_store_clear (store);
+
+  collect_node_stats (node, stats);
+
+  for (i = 0; i <= GSK_BLUR_NODE; i++)
+    {
+      if (i == GSK_NOT_A_RENDER_NODE || stats[i].count == 0)
+        continue;
+
+      add_node_stats_row (store, node_type_name (i), &stats[i]);
+
+      total.count += stats[i].count;
+      total.pixels += stats[i].pixels;
+      total.offscreens += stats[i].offscreens;
+    }
+
+  add_node_stats_row (store, "Total", &total);
+}
+
 static cairo_surface_t *
 get_color_surface (const GdkRGBA *color)
 {
@@ -954,6 +1126,7 @@ gtk_inspector_recorder_class_init (GtkInspectorRecorderClass *klass)
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorRecorder, render_node_tree);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorRecorder, render_node_save_button);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorRecorder, node_property_tree);
+  gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorRecorder, node_stats_tree);
 
   gtk_widget_class_bind_template_callback (widget_class, recordings_clear_all);
   gtk_widget_class_bind_template_callback (widget_class, recordings_list_row_selected);
@@ -977,13 +1150,18 @@ gtk_inspector_recorder_init (GtkInspectorRecorder *recorder)
 
   priv->render_node_model = gtk_tree_model_render_node_new (render_node_list_get_value,
                                                             N_NODE_COLUMNS,
-                                                            G_TYPE_STRING);
+                                                            G_TYPE_STRING,
+                                                            G_TYPE_INT);
   gtk_tree_view_set_model (GTK_TREE_VIEW (priv->render_node_tree), priv->render_node_model);
   g_object_unref (priv->render_node_model);
 
   priv->render_node_properties = GTK_TREE_MODEL (gtk_list_store_new (4, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_BOOLEAN, CAIRO_GOBJECT_TYPE_SURFACE));
   gtk_tree_view_set_model (GTK_TREE_VIEW (priv->node_property_tree), priv->render_node_properties);
   g_object_unref (priv->render_node_properties);
+
+  priv->node_stats_model = GTK_TREE_MODEL (gtk_list_store_new (5, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_INT));
+  gtk_tree_view_set_model (GTK_TREE_VIEW (priv->node_stats_tree), priv->node_stats_model);
+  g_object_unref (priv->node_stats_model);
 }
 
 static void
@@ -27,6 +27,7 @@
 #include "gtkcelllayout.h"
 #include "gtksearchbar.h"
 #include "gtklabel.h"
+#include "gtkmemoryaccountingprivate.h"
 
 enum
 {
@@ -50,6 +51,8 @@ struct _GtkInspectorStatisticsPrivate
   GtkCellRenderer *renderer_self2;
   GtkTreeViewColumn *column_cumulative2;
   GtkCellRenderer *renderer_cumulative2;
+  GtkTreeViewColumn *column_memory;
+  GtkCellRenderer *renderer_memory;
   GHashTable *counts;
   guint update_source_id;
   GtkWidget *search_entry;
@@ -72,7 +75,8 @@ enum
   COLUMN_SELF2,
   COLUMN_CUMULATIVE2,
   COLUMN_SELF_DATA,
-  COLUMN_CUMULATIVE_DATA
+  COLUMN_CUMULATIVE_DATA,
+  COLUMN_MEMORY
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtkInspectorStatistics, gtk_inspector_statistics, GTK_TYPE_BOX)
@@ -121,6 +125,7 @@ add_type_count (GtkInspectorStatistics *sl, GType type)
                       COLUMN_CUMULATIVE1, (int) gtk_graph_data_get_value (data->cumulative, 1),
                       COLUMN_SELF2, (int) gtk_graph_data_get_value (data->self, 0),
                       COLUMN_CUMULATIVE2, (int) gtk_graph_data_get_value (data->cumulative, 0),
+                      COLUMN_MEMORY, (guint64) gtk_memory_accounting_get (type),
                       -1);
   return cumulative;
 }
@@ -234,6 +239,26 @@ cell_data_delta (GtkCellLayout   *layout,
   g_free (text);
 }
 
+static void
+cell_data_memory (GtkCellLayout   *layout,
+                  GtkCellRenderer *cell,
+                  GtkTreeModel    *model,
+                  GtkTreeIter     *iter,
+                  gpointer         data)
+{
+  gint column;
+  guint64 bytes;
+  gchar *text;
+
+  column = GPOINTER_TO_INT (data);
+
+  gtk_tree_model_get (model, iter, column, &bytes, -1);
+
+  text = g_format_size (bytes);
+  g_object_set (cell, "text", text, NULL);
+  g_free (text);
+}
+
 static void
 type_data_free (gpointer data)
 {
@@ -351,6 +376,12 @@ gtk_inspector_statistics_init (GtkInspectorStatistics *sl)
                                       sl->priv->renderer_cumulative2,
                                       cell_data_delta,
                                       GINT_TO_POINTER (COLUMN_CUMULATIVE2), NULL);
+  gtk_cell_layout_set_cell_data_func (GTK_CELL_LAYOUT (sl->priv->column_memory),
+                                      sl->priv->renderer_memory,
+                                      cell_data_memory,
+                                      GINT_TO_POINTER (COLUMN_MEMORY), NULL);
+  gtk_tree_view_column_set_visible (sl->priv->column_memory,
+                                    gtk_memory_accounting_enabled ());
   sl->priv->counts = g_hash_table_new_full (NULL, NULL, NULL, type_data_free);
 
   gtk_tree_view_set_search_entry (sl->priv->view, GTK_ENTRY (sl->priv->search_entry));
@@ -457,6 +488,8 @@ gtk_inspector_statistics_class_init (GtkInspectorStatisticsClass *klass)
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, renderer_self2);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, column_cumulative2);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, renderer_cumulative2);
+  gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, column_memory);
+  gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, renderer_memory);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, search_entry);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, search_bar);
   gtk_widget_class_bind_template_child_private (widget_class, GtkInspectorStatistics, excuse);
@@ -160,6 +160,7 @@ typedef struct
 {
   GdkPixdata pixdata;
   gboolean has_pixdata;
+  gboolean rejected;
   guint32 offset;
   guint size;
 } ImageData;
@@ -457,6 +458,30 @@ follow_links (const gchar *path)
   return path2;
 }
 
+/* Only icons at the common fixed sizes (16/24/32/48 at scale 1 and 2)
+ * get their pixel data embedded; embedding every size balloons the
+ * cache file, while the small sizes are the ones shared between many
+ * programs and worth mmap-sharing
+ */
+static gboolean
+is_common_pixel_size (gint width,
+                      gint height)
+{
+  static const gint common_sizes[] = { 16, 24, 32, 48, 64, 96 };
+  gint i;
+
+  if (width != height)
+    return FALSE;
+
+  for (i = 0; i < G_N_ELEMENTS (common_sizes); i++)
+    {
+      if (width == common_sizes[i])
+	return TRUE;
+    }
+
+  return FALSE;
+}
+
 static void
 maybe_cache_image_data (Image       *image,
 			const gchar *path)
@@ -501,21 +526,31 @@ maybe_cache_image_data (Image       *image,
 	    g_hash_table_insert (image_data_hash, g_strdup (path2), idata);
 	}
 
-      if (!idata->has_pixdata)
+      if (!idata->has_pixdata && !idata->rejected)
 	{
 	  pixbuf = gdk_pixbuf_new_from_file (path, NULL);
 
 	  if (pixbuf)
 	    {
+	      if (is_common_pixel_size (gdk_pixbuf_get_width (pixbuf),
+					gdk_pixbuf_get_height (pixbuf)))
+		{
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
-	      gdk_pixdata_from_pixbuf (&idata->pixdata, pixbuf, FALSE);
+		  gdk_pixdata_from_pixbuf (&idata->pixdata, pixbuf, FALSE);
 G_GNUC_END_IGNORE_DEPRECATIONS;
-	      idata->size = idata->pixdata.length + 8;
-	      idata->has_pixdata = TRUE;
+		  idata->size = idata->pixdata.length + 8;
+		  idata->has_pixdata = TRUE;
+		}
+	      else
+		{
+		  idata->rejected = TRUE;
+		  g_object_unref (pixbuf);
+		}
 	    }
 	}
 
-      image->image_data = idata;
+      if (idata->has_pixdata)
+	image->image_data = idata;
 
       g_free (path2);
     }
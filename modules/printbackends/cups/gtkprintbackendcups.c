@@ -1880,6 +1880,7 @@ static const char * const printer_attrs[] =
     "printer-state-message",
     "printer-state-reasons",
     "printer-state",
+    "printer-state-change-time",
     "queued-job-count",
     "printer-is-accepting-jobs",
     "job-sheets-supported",
@@ -1905,6 +1906,7 @@ static const char * const printer_attrs_detailed[] =
     "printer-state-message",
     "printer-state-reasons",
     "printer-state",
+    "printer-state-change-time",
     "queued-job-count",
     "printer-is-accepting-jobs",
     "job-sheets-supported",
@@ -1956,6 +1958,7 @@ typedef struct
   const gchar *reason_msg;
   PrinterStateLevel reason_level;
   gint state;
+  gint state_change_time;
   gint job_count;
   gboolean is_paused;
   gboolean is_accepting_jobs;
@@ -2143,6 +2146,8 @@ cups_printer_handle_attribute (GtkPrintBackendCups *cups_backend,
     }
   else if (strcmp (ippGetName (attr), "printer-state") == 0)
     info->state = ippGetInteger (attr, 0);
+  else if (strcmp (ippGetName (attr), "printer-state-change-time") == 0)
+    info->state_change_time = ippGetInteger (attr, 0);
   else if (strcmp (ippGetName (attr), "queued-job-count") == 0)
     info->job_count = ippGetInteger (attr, 0);
   else if (strcmp (ippGetName (attr), "printer-is-accepting-jobs") == 0)
@@ -2720,6 +2725,7 @@ cups_request_printer_info_cb (GtkPrintBackendCups *cups_backend,
 
           GTK_PRINTER_CUPS (printer)->remote = info->remote_printer;
           GTK_PRINTER_CUPS (printer)->state = info->state;
+          GTK_PRINTER_CUPS (printer)->state_change_time = info->state_change_time;
           GTK_PRINTER_CUPS (printer)->ipp_version_major = info->ipp_version_major;
           GTK_PRINTER_CUPS (printer)->ipp_version_minor = info->ipp_version_minor;
           GTK_PRINTER_CUPS (printer)->supports_copies = info->supports_copies;
@@ -3587,6 +3593,7 @@ cups_request_printer_list_cb (GtkPrintBackendCups *cups_backend,
         }
 
       GTK_PRINTER_CUPS (printer)->state = info->state;
+      GTK_PRINTER_CUPS (printer)->state_change_time = info->state_change_time;
       GTK_PRINTER_CUPS (printer)->ipp_version_major = info->ipp_version_major;
       GTK_PRINTER_CUPS (printer)->ipp_version_minor = info->ipp_version_minor;
       GTK_PRINTER_CUPS (printer)->supports_copies = info->supports_copies;
@@ -3754,6 +3761,148 @@ typedef struct {
   http_t *http;
 } GetPPDData;
 
+/* On-disk cache of fetched PPDs, so that reopening the print dialog
+ * against a remote server doesn't download every PPD again.  Entries
+ * are keyed by the printer's "printer-state-change-time" serial; any
+ * change on the queue moves the serial forward and makes the old
+ * entry stale.
+ */
+static gchar *
+ppd_cache_get_filename (GtkPrinterCups *cups_printer)
+{
+  gchar *key;
+  gchar *checksum;
+  gchar *filename;
+
+#ifdef HAVE_CUPS_API_1_6
+  /* Avahi printers get their details via IPP, not from a PPD */
+  if (cups_printer->avahi_browsed)
+    return NULL;
+#endif
+
+  /* Without a state serial a cached copy could never be validated */
+  if (cups_printer->state_change_time == 0 ||
+      cups_printer->ppd_name == NULL ||
+      cups_printer->hostname == NULL)
+    return NULL;
+
+  key = g_strdup_printf ("%s:%d:%s",
+                         cups_printer->hostname,
+                         cups_printer->port,
+                         cups_printer->ppd_name);
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, key, -1);
+
+  filename = g_strdup_printf ("%s-%d.ppd",
+                              checksum,
+                              cups_printer->state_change_time);
+
+  g_free (checksum);
+  g_free (key);
+
+  return g_build_filename (g_get_user_cache_dir (), "gtk-4.0", "cups-ppds",
+                           filename, NULL);
+}
+
+/* Removes cache entries for the same printer with other serials */
+static void
+ppd_cache_prune (const gchar *path)
+{
+  gchar *dirname;
+  gchar *basename;
+  gchar *dash;
+  const gchar *name;
+  GDir *dir;
+
+  dirname = g_path_get_dirname (path);
+  basename = g_path_get_basename (path);
+
+  dash = strrchr (basename, '-');
+  if (dash == NULL || (dir = g_dir_open (dirname, 0, NULL)) == NULL)
+    {
+      g_free (dirname);
+      g_free (basename);
+      return;
+    }
+
+  while ((name = g_dir_read_name (dir)) != NULL)
+    {
+      if (strncmp (name, basename, dash - basename + 1) == 0 &&
+          strcmp (name, basename) != 0)
+        {
+          gchar *stale = g_build_filename (dirname, name, NULL);
+          g_remove (stale);
+          g_free (stale);
+        }
+    }
+
+  g_dir_close (dir);
+  g_free (dirname);
+  g_free (basename);
+}
+
+static void
+ppd_cache_save (GtkPrinterCups *cups_printer,
+                GIOChannel     *ppd_io)
+{
+  gchar *path;
+  gchar *dirname;
+  gchar *contents = NULL;
+  gsize length = 0;
+
+  path = ppd_cache_get_filename (cups_printer);
+  if (path == NULL)
+    return;
+
+  dirname = g_path_get_dirname (path);
+  g_mkdir_with_parents (dirname, 0700);
+
+  g_io_channel_seek_position (ppd_io, 0, G_SEEK_SET, NULL);
+  if (g_io_channel_read_to_end (ppd_io, &contents, &length, NULL) == G_IO_STATUS_NORMAL &&
+      length > 0)
+    {
+      if (g_file_set_contents (path, contents, length, NULL))
+        ppd_cache_prune (path);
+    }
+
+  g_free (contents);
+  g_free (dirname);
+  g_free (path);
+}
+
+/* Tries to satisfy a details request from the PPD cache; returns
+ * %TRUE and emits "details-acquired" on a hit.
+ */
+static gboolean
+cups_request_ppd_from_cache (GtkPrinter *printer)
+{
+  GtkPrinterCups *cups_printer = GTK_PRINTER_CUPS (printer);
+  ppd_file_t *ppd_file;
+  gchar *path;
+
+  path = ppd_cache_get_filename (cups_printer);
+  if (path == NULL)
+    return FALSE;
+
+  ppd_file = ppdOpenFile (path);
+  g_free (path);
+
+  if (ppd_file == NULL)
+    return FALSE;
+
+  GTK_NOTE (PRINTING,
+            g_print ("CUPS Backend: Loading PPD for %s from cache\n",
+                     gtk_printer_get_name (printer)));
+
+  ppdLocalize (ppd_file);
+  ppdMarkDefaults (ppd_file);
+  cups_printer->ppd_file = ppd_file;
+
+  gtk_printer_set_has_details (printer, TRUE);
+  g_signal_emit_by_name (printer, "details-acquired", TRUE);
+
+  return TRUE;
+}
+
 static void
 get_ppd_data_free (GetPPDData *data)
 {
@@ -3831,6 +3980,10 @@ cups_request_ppd_cb (GtkPrintBackendCups *print_backend,
     }
 #endif
 
+  if (!gtk_cups_result_is_error (result) &&
+      data->printer->ppd_file != NULL)
+    ppd_cache_save (data->printer, data->ppd_io);
+
   gtk_printer_set_has_details (printer, TRUE);
   g_signal_emit_by_name (printer, "details-acquired", TRUE);
 }
@@ -4258,6 +4411,12 @@ cups_printer_request_details (GtkPrinter *printer)
   if (!cups_printer->reading_ppd &&
       gtk_printer_cups_get_ppd (cups_printer) == NULL)
     {
+      /* A cache hit skips the whole round trip, including the
+       * connection test polling for remote printers.
+       */
+      if (cups_request_ppd_from_cache (printer))
+        return;
+
       if (cups_printer->remote
 #ifdef HAVE_CUPS_API_1_6
           && !cups_printer->avahi_browsed
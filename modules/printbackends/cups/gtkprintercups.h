@@ -55,6 +55,7 @@ struct _GtkPrinterCups
   gchar **auth_info_required;
 
   ipp_pstate_t state;
+  gint state_change_time;  /* "printer-state-change-time", keys the on-disk PPD cache */
   gboolean reading_ppd;
   gchar      *ppd_name;
   ppd_file_t *ppd_file;
@@ -1,6 +1,11 @@
 /* -*- mode: C; c-basic-offset: 2; indent-tabs-mode: nil; -*- */
 
+#include <string.h>
+
+#include <gtk/gtk.h>
 #include <gsk/gskcairoblurprivate.h>
+#include <gsk/gskrendererprivate.h>
+#include <gsk/gskprofilerprivate.h>
 
 static void
 init_surface (cairo_t *cr)
@@ -16,8 +21,8 @@ init_surface (cairo_t *cr)
   cairo_fill (cr);
 }
 
-int
-main (int argc, char **argv)
+static void
+run_cairo_benchmark (void)
 {
   cairo_surface_t *surface;
   cairo_t *cr;
@@ -34,7 +39,9 @@ main (int argc, char **argv)
 
   cr = cairo_create (surface);
 
-  /* We do everything three times, first two as warmup */
+  g_print ("Cairo blur (gsk_cairo_blur_surface), %dx%d:\n", size, size);
+
+  /* We do everything two times, first one as warmup */
   for (j = 0; j < 2; j++)
     {
       for (i = 1; i < 16; i++)
@@ -48,7 +55,159 @@ main (int argc, char **argv)
 	}
     }
 
+  cairo_destroy (cr);
+  cairo_surface_destroy (surface);
   g_timer_destroy (timer);
+}
+
+static GdkTexture *
+create_texture (int size)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  GdkTexture *texture;
+
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size, size);
+  cr = cairo_create (surface);
+  cairo_set_source_rgb (cr, 0, 0, 0);
+  cairo_paint (cr);
+  cairo_set_source_rgb (cr, 1, 1, 1);
+  cairo_arc (cr, size/2, size/2, size/2, 0, 2*G_PI);
+  cairo_fill (cr);
+  cairo_destroy (cr);
+
+  cairo_surface_flush (surface);
+  texture = gdk_texture_new_for_data (cairo_image_surface_get_data (surface),
+                                      size, size,
+                                      cairo_image_surface_get_stride (surface));
+  cairo_surface_destroy (surface);
+
+  return texture;
+}
+
+/* The GL and Vulkan renderers register a "gpu-time" timer on their
+ * profiler (in debug builds); the cairo renderer does not. Asking the
+ * profiler for an unknown timer is a programmer error, so check first.
+ */
+static gboolean
+renderer_has_gpu_timer (GskRenderer *renderer)
+{
+#ifdef G_ENABLE_DEBUG
+  const char *name = G_OBJECT_TYPE_NAME (renderer);
+
+  return strcmp (name, "GskGLRenderer") == 0 ||
+         strcmp (name, "GskVulkanRenderer") == 0;
+#else
+  return FALSE;
+#endif
+}
+
+static void
+run_renderer_benchmark (GskRenderer *renderer)
+{
+  static const int sizes[] = { 256, 512, 1024, 2048 };
+  static const double radii[] = { 1, 2, 4, 8, 16, 32, 64 };
+  gboolean have_gpu_timer;
+  GTimer *timer;
+  guint s, r;
+  int j;
+
+  have_gpu_timer = renderer_has_gpu_timer (renderer);
+  timer = g_timer_new ();
+
+  g_print ("\nGskBlurNode offscreen rendering, renderer %s:\n",
+           G_OBJECT_TYPE_NAME (renderer));
+  if (!have_gpu_timer)
+    g_print ("(no \"gpu-time\" profiler timer for this renderer%s)\n",
+#ifdef G_ENABLE_DEBUG
+             ""
+#else
+             "; rebuild with G_ENABLE_DEBUG"
+#endif
+             );
+
+  for (s = 0; s < G_N_ELEMENTS (sizes); s++)
+    {
+      int size = sizes[s];
+      GdkTexture *texture = create_texture (size);
+      GskRenderNode *texture_node;
+
+      texture_node = gsk_texture_node_new (texture,
+                                           &GRAPHENE_RECT_INIT (0, 0, size, size));
+
+      for (r = 0; r < G_N_ELEMENTS (radii); r++)
+        {
+          double radius = radii[r];
+          double msec = 0;
+
+          /* First pass is warmup (shader compilation, cache setup) */
+          for (j = 0; j < 2; j++)
+            {
+              GskRenderNode *blur;
+              GdkTexture *result;
+
+              blur = gsk_blur_node_new (texture_node, radius);
+
+              g_timer_start (timer);
+              result = gsk_renderer_render_texture (renderer, blur, NULL);
+              msec = g_timer_elapsed (timer, NULL) * 1000;
+
+              g_object_unref (result);
+              gsk_render_node_unref (blur);
+            }
+
+          g_print ("Size %4d radius %4g: %8.2f msec wall, %.2f kpixels/msec",
+                   size, radius, msec, size*size/(msec*1000));
+
+#ifdef G_ENABLE_DEBUG
+          if (have_gpu_timer)
+            {
+              GskProfiler *profiler = gsk_renderer_get_profiler (renderer);
+              gint64 gpu_time;
+
+              gpu_time = gsk_profiler_timer_get (profiler,
+                                                 g_quark_from_string ("gpu-time"));
+              g_print (", %.2f msec gpu", gpu_time / (1000.0 * 1000.0));
+            }
+#endif
+          g_print ("\n");
+        }
+
+      gsk_render_node_unref (texture_node);
+      g_object_unref (texture);
+    }
+
+  g_timer_destroy (timer);
+}
+
+int
+main (int argc, char **argv)
+{
+  GtkWidget *window;
+  GskRenderer *renderer;
+
+  gtk_init ();
+
+  run_cairo_benchmark ();
+
+  /* The renderer backend is chosen the usual way, so run this with
+   * GSK_RENDERER=gl and GSK_RENDERER=vulkan to compare the GPU paths.
+   */
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  gtk_widget_realize (window);
+
+  renderer = gsk_renderer_new_for_window (gtk_widget_get_window (window));
+  if (renderer == NULL)
+    {
+      g_printerr ("Could not realize a renderer\n");
+      return 1;
+    }
+
+  run_renderer_benchmark (renderer);
+
+  gsk_renderer_unrealize (renderer);
+  g_object_unref (renderer);
+  gtk_widget_destroy (window);
 
   return 0;
 }
@@ -2,6 +2,8 @@
 
 #include <gtk/gtk.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "frame-stats.h"
 
@@ -51,6 +53,126 @@ create_widget_factory_content (void)
   return result;
 }
 
+static GtkWidget *
+create_treeview_content (void)
+{
+  GtkListStore *store;
+  GtkWidget *treeview;
+  int i;
+
+  store = gtk_list_store_new (3, G_TYPE_INT, G_TYPE_STRING, G_TYPE_BOOLEAN);
+  for (i = 0; i < 2000; i++)
+    {
+      char *text = g_strdup_printf ("Row %d with some text that needs ellipsizing when the column shrinks", i);
+      gtk_list_store_insert_with_values (store, NULL, -1,
+                                         0, i,
+                                         1, text,
+                                         2, (i % 3) == 0,
+                                         -1);
+      g_free (text);
+    }
+
+  treeview = gtk_tree_view_new_with_model (GTK_TREE_MODEL (store));
+  g_object_unref (store);
+
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (treeview), -1,
+                                               "Index", gtk_cell_renderer_text_new (),
+                                               "text", 0,
+                                               NULL);
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (treeview), -1,
+                                               "Text", gtk_cell_renderer_text_new (),
+                                               "text", 1,
+                                               NULL);
+  gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (treeview), -1,
+                                               "Active", gtk_cell_renderer_toggle_new (),
+                                               "active", 2,
+                                               NULL);
+
+  return treeview;
+}
+
+static GtkWidget *
+create_textview_content (void)
+{
+  GtkWidget *textview;
+  GtkTextBuffer *buffer;
+  GString *text;
+  int i;
+
+  text = g_string_new (NULL);
+  for (i = 0; i < 2000; i++)
+    g_string_append_printf (text,
+                            "Line %d of a fairly long paragraph of text that wraps "
+                            "around and therefore exercises line breaking as well "
+                            "as text rendering while scrolling.\n", i);
+
+  textview = gtk_text_view_new ();
+  gtk_text_view_set_wrap_mode (GTK_TEXT_VIEW (textview), GTK_WRAP_WORD);
+  buffer = gtk_text_view_get_buffer (GTK_TEXT_VIEW (textview));
+  gtk_text_buffer_set_text (buffer, text->str, -1);
+  g_string_free (text, TRUE);
+
+  return textview;
+}
+
+static GtkWidget *
+create_flowbox_content (void)
+{
+  GtkWidget *flowbox;
+  int i;
+
+  flowbox = gtk_flow_box_new ();
+  gtk_flow_box_set_homogeneous (GTK_FLOW_BOX (flowbox), TRUE);
+  gtk_flow_box_set_max_children_per_line (GTK_FLOW_BOX (flowbox), 12);
+
+  for (i = 0; i < 1000; i++)
+    {
+      char *text = g_strdup_printf ("Child %d", i);
+      GtkWidget *button = gtk_button_new_with_label (text);
+      gtk_flow_box_insert (GTK_FLOW_BOX (flowbox), button, -1);
+      g_free (text);
+    }
+
+  return flowbox;
+}
+
+static GtkWidget *
+create_iconview_content (void)
+{
+  GtkListStore *store;
+  GtkWidget *iconview;
+  GtkCellRenderer *cell;
+  int i;
+
+  store = gtk_list_store_new (2, G_TYPE_STRING, G_TYPE_STRING);
+  for (i = 0; i < 1000; i++)
+    {
+      char *text = g_strdup_printf ("Item %d", i);
+      gtk_list_store_insert_with_values (store, NULL, -1,
+                                         0, "folder",
+                                         1, text,
+                                         -1);
+      g_free (text);
+    }
+
+  iconview = gtk_icon_view_new_with_model (GTK_TREE_MODEL (store));
+  g_object_unref (store);
+
+  cell = gtk_cell_renderer_pixbuf_new ();
+  gtk_cell_layout_pack_start (GTK_CELL_LAYOUT (iconview), cell, FALSE);
+  gtk_cell_layout_set_attributes (GTK_CELL_LAYOUT (iconview), cell,
+                                  "icon-name", 0,
+                                  NULL);
+
+  cell = gtk_cell_renderer_text_new ();
+  gtk_cell_layout_pack_start (GTK_CELL_LAYOUT (iconview), cell, FALSE);
+  gtk_cell_layout_set_attributes (GTK_CELL_LAYOUT (iconview), cell,
+                                  "text", 1,
+                                  NULL);
+
+  return iconview;
+}
+
 static void
 set_adjustment_to_fraction (GtkAdjustment *adjustment,
                             gdouble        fraction)
@@ -64,12 +186,23 @@ set_adjustment_to_fraction (GtkAdjustment *adjustment,
                             fraction * (upper - page_size));
 }
 
+static gboolean benchmark = FALSE;
+static gboolean json_output = FALSE;
+static double warmup_time = 2.;
+static double benchmark_time = 10.;
+static char *content_type = NULL;
+
+/* Frame intervals in milliseconds, collected after the warmup phase */
+static GArray *frame_times;
+static gint64 benchmark_start_time;
+
 gboolean
 scroll_viewport (GtkWidget     *viewport,
                  GdkFrameClock *frame_clock,
                  gpointer       user_data)
 {
   static gint64 start_time;
+  static gint64 last_frame_time;
   gint64 now = gdk_frame_clock_get_frame_time (frame_clock);
   gdouble elapsed;
   GtkAdjustment *hadjustment, *vadjustment;
@@ -85,10 +218,98 @@ scroll_viewport (GtkWidget     *viewport,
   set_adjustment_to_fraction (hadjustment, 0.5 + 0.5 * sin (elapsed));
   set_adjustment_to_fraction (vadjustment, 0.5 + 0.5 * cos (elapsed));
 
+  if (benchmark && elapsed >= warmup_time)
+    {
+      if (benchmark_start_time == 0)
+        benchmark_start_time = now;
+      else
+        {
+          double interval = (now - last_frame_time) / 1000.;
+          g_array_append_val (frame_times, interval);
+        }
+
+      if ((now - benchmark_start_time) / 1000000. >= benchmark_time)
+        gtk_main_quit ();
+    }
+
+  last_frame_time = now;
+
   return TRUE;
 }
 
+static int
+compare_double (gconstpointer a,
+                gconstpointer b)
+{
+  double da = *(const double *) a;
+  double db = *(const double *) b;
+
+  return (da > db) - (da < db);
+}
+
+static double
+percentile (GArray *sorted,
+            double  fraction)
+{
+  return g_array_index (sorted, double, (guint) (fraction * (sorted->len - 1)));
+}
+
+static void
+print_benchmark_results (void)
+{
+  const char *renderer;
+  double sum = 0.;
+  double p50, p95, p99, max;
+  guint i;
+
+  if (frame_times->len < 2)
+    {
+      g_printerr ("Not enough frames collected, increase --benchmark-time\n");
+      return;
+    }
+
+  for (i = 0; i < frame_times->len; i++)
+    sum += g_array_index (frame_times, double, i);
+
+  g_array_sort (frame_times, compare_double);
+
+  p50 = percentile (frame_times, 0.50);
+  p95 = percentile (frame_times, 0.95);
+  p99 = percentile (frame_times, 0.99);
+  max = g_array_index (frame_times, double, frame_times->len - 1);
+
+  /* The renderer is selected through the GSK_RENDERER environment
+   * variable, so that is what distinguishes comparison runs */
+  renderer = g_getenv ("GSK_RENDERER");
+  if (renderer == NULL)
+    renderer = "default";
+
+  if (json_output)
+    {
+      g_print ("{ \"content\" : \"%s\", \"renderer\" : \"%s\", "
+               "\"frames\" : %u, \"fps\" : %g, "
+               "\"frame-time-ms\" : { \"mean\" : %g, \"p50\" : %g, \"p95\" : %g, \"p99\" : %g, \"max\" : %g } }\n",
+               content_type, renderer,
+               frame_times->len, 1000. * frame_times->len / sum,
+               sum / frame_times->len, p50, p95, p99, max);
+    }
+  else
+    {
+      g_print ("Content: %s\n", content_type);
+      g_print ("Renderer: %s\n", renderer);
+      g_print ("Frames: %u\n", frame_times->len);
+      g_print ("Frame rate: %g fps\n", 1000. * frame_times->len / sum);
+      g_print ("Frame time: %g ms mean, %g ms p50, %g ms p95, %g ms p99, %g ms max\n",
+               sum / frame_times->len, p50, p95, p99, max);
+    }
+}
+
 static GOptionEntry options[] = {
+  { "content", 'c', 0, G_OPTION_ARG_STRING, &content_type, "Content to scroll (widget-factory/treeview/textview/flowbox/iconview)", "CONTENT" },
+  { "benchmark", 'b', 0, G_OPTION_ARG_NONE, &benchmark, "Run for a fixed time and print frame time percentiles", NULL },
+  { "warmup-time", 0, 0, G_OPTION_ARG_DOUBLE, &warmup_time, "Warmup time before frames are counted", "TIME" },
+  { "benchmark-time", 0, 0, G_OPTION_ARG_DOUBLE, &benchmark_time, "Time to collect frames for", "TIME" },
+  { "json", 0, 0, G_OPTION_ARG_NONE, &json_output, "Print benchmark results as JSON", NULL },
   { NULL }
 };
 
@@ -98,7 +319,7 @@ main (int argc, char **argv)
   GtkWidget *window;
   GtkWidget *scrolled_window;
   GtkWidget *viewport;
-  GtkWidget *grid;
+  GtkWidget *content;
   GError *error = NULL;
   int i;
 
@@ -114,6 +335,9 @@ main (int argc, char **argv)
 
   gtk_init ();
 
+  if (content_type == NULL)
+    content_type = g_strdup ("widget-factory");
+
   window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
   frame_stats_ensure (GTK_WINDOW (window));
   gtk_window_set_default_size (GTK_WINDOW (window), 800, 600);
@@ -124,17 +348,41 @@ main (int argc, char **argv)
   viewport = gtk_viewport_new (NULL, NULL);
   gtk_container_add (GTK_CONTAINER (scrolled_window), viewport);
 
-  grid = gtk_grid_new ();
-  gtk_container_add (GTK_CONTAINER (viewport), grid);
-
-  for (i = 0; i < 4; i++)
+  if (strcmp (content_type, "widget-factory") == 0)
     {
-      GtkWidget *content = create_widget_factory_content ();
-      gtk_grid_attach (GTK_GRID (grid), content,
-                       i % 2, i / 2, 1, 1);
-      g_object_unref (content);
+      GtkWidget *grid = gtk_grid_new ();
+      gtk_container_add (GTK_CONTAINER (viewport), grid);
+
+      for (i = 0; i < 4; i++)
+        {
+          content = create_widget_factory_content ();
+          gtk_grid_attach (GTK_GRID (grid), content,
+                           i % 2, i / 2, 1, 1);
+          g_object_unref (content);
+        }
+    }
+  else
+    {
+      if (strcmp (content_type, "treeview") == 0)
+        content = create_treeview_content ();
+      else if (strcmp (content_type, "textview") == 0)
+        content = create_textview_content ();
+      else if (strcmp (content_type, "flowbox") == 0)
+        content = create_flowbox_content ();
+      else if (strcmp (content_type, "iconview") == 0)
+        content = create_iconview_content ();
+      else
+        {
+          g_printerr ("Unknown content type '%s'\n", content_type);
+          return 1;
+        }
+
+      gtk_container_add (GTK_CONTAINER (viewport), content);
     }
 
+  if (benchmark)
+    frame_times = g_array_new (FALSE, FALSE, sizeof (double));
+
   gtk_widget_add_tick_callback (viewport,
                                 scroll_viewport,
                                 NULL,
@@ -145,5 +393,8 @@ main (int argc, char **argv)
                     G_CALLBACK (gtk_main_quit), NULL);
   gtk_main ();
 
+  if (benchmark)
+    print_benchmark_results ();
+
   return 0;
 }
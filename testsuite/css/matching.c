@@ -0,0 +1,162 @@
+/* CSS selector matching benchmark
+ *
+ * Builds synthetic widget trees of configurable depth and breadth,
+ * styles them with the default theme (plus optional extra CSS), and
+ * measures how long the initial style validation and subsequent
+ * re-validations take. Run with GTK_DEBUG=css-stats in a debug build
+ * to also get selector-level counters at exit.
+ *
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+
+static int depth = 6;
+static int breadth = 3;
+static int iterations = 5;
+static char *extra_css = NULL;
+
+static GOptionEntry options[] = {
+  { "depth", 0, 0, G_OPTION_ARG_INT, &depth, "Depth of the widget tree", "DEPTH" },
+  { "breadth", 0, 0, G_OPTION_ARG_INT, &breadth, "Children per container", "BREADTH" },
+  { "iterations", 0, 0, G_OPTION_ARG_INT, &iterations, "Number of re-validation runs", "COUNT" },
+  { "css", 0, 0, G_OPTION_ARG_FILENAME, &extra_css, "Additional CSS file to load", "FILE" },
+  { NULL }
+};
+
+static guint n_widgets;
+
+static GtkWidget *
+create_leaf (int index)
+{
+  GtkWidget *widget;
+
+  /* A mix of leaves so different theme rules come into play */
+  switch (index % 5)
+    {
+    case 0:
+      widget = gtk_button_new_with_label ("Button");
+      break;
+    case 1:
+      widget = gtk_check_button_new_with_label ("Check");
+      break;
+    case 2:
+      widget = gtk_entry_new ();
+      break;
+    case 3:
+      widget = gtk_scale_new_with_range (GTK_ORIENTATION_HORIZONTAL, 0, 100, 1);
+      break;
+    default:
+      widget = gtk_label_new ("Label");
+      break;
+    }
+
+  if (index % 2 == 0)
+    gtk_style_context_add_class (gtk_widget_get_style_context (widget), "frame");
+
+  n_widgets++;
+
+  return widget;
+}
+
+static GtkWidget *
+create_tree (int level)
+{
+  GtkWidget *box;
+  int i;
+
+  if (level >= depth)
+    return create_leaf (n_widgets);
+
+  box = gtk_box_new (level % 2 == 0 ? GTK_ORIENTATION_VERTICAL
+                                    : GTK_ORIENTATION_HORIZONTAL, 0);
+  n_widgets++;
+
+  for (i = 0; i < breadth; i++)
+    gtk_container_add (GTK_CONTAINER (box), create_tree (level + 1));
+
+  return box;
+}
+
+static void
+drain_main_context (void)
+{
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+}
+
+int
+main (int argc, char **argv)
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  GtkWidget *window;
+  GtkStyleContext *root_context;
+  gint64 start;
+  double initial_ms, sum_ms = 0;
+  int i;
+
+  context = g_option_context_new ("- benchmark css selector matching");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+
+  gtk_init ();
+
+  if (extra_css)
+    {
+      GtkCssProvider *provider = gtk_css_provider_new ();
+
+      gtk_css_provider_load_from_path (provider, extra_css);
+      gtk_style_context_add_provider_for_display (gdk_display_get_default (),
+                                                  GTK_STYLE_PROVIDER (provider),
+                                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+    }
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  gtk_container_add (GTK_CONTAINER (window), create_tree (0));
+
+  /* The initial validation has to match every widget against
+   * everything the theme brought along */
+  start = g_get_monotonic_time ();
+  gtk_widget_show (window);
+  drain_main_context ();
+  initial_ms = (g_get_monotonic_time () - start) / 1000.0;
+
+  /* Toggling a class on the root invalidates styles down the whole
+   * tree, so every iteration re-runs the matching */
+  root_context = gtk_widget_get_style_context (window);
+  for (i = 0; i < iterations; i++)
+    {
+      start = g_get_monotonic_time ();
+      if (i % 2 == 0)
+        gtk_style_context_add_class (root_context, "benchmark");
+      else
+        gtk_style_context_remove_class (root_context, "benchmark");
+      drain_main_context ();
+      sum_ms += (g_get_monotonic_time () - start) / 1000.0;
+    }
+
+  g_print ("%u widgets (depth %d, breadth %d)\n", n_widgets, depth, breadth);
+  g_print ("initial style validation: %.2f ms\n", initial_ms);
+  g_print ("re-validation: %.2f ms (mean of %d runs)\n",
+           sum_ms / iterations, iterations);
+
+  return 0;
+}
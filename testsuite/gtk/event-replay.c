@@ -0,0 +1,257 @@
+/* Replay a recorded event stream against a widget tree and report
+ * frame-time distributions.
+ *
+ * Record a session with GDK_EVENT_RECORD=<file> and feed the file to
+ * this harness; the replay itself is done by GDK (see the
+ * GDK_EVENT_REPLAY handling in gdk/gdkevents.c), we provide the
+ * widget tree and the measurements.
+ *
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+#include <stdlib.h>
+
+static char *ui_file = NULL;
+static double speed = 1.0;
+
+static GOptionEntry options[] = {
+  { "ui", 'u', 0, G_OPTION_ARG_FILENAME, &ui_file, "Builder file with the widget tree to replay against", "FILE" },
+  { "speed", 's', 0, G_OPTION_ARG_DOUBLE, &speed, "Playback rate (2.0 replays twice as fast)", "RATE" },
+  { NULL }
+};
+
+static GArray *frame_times;
+static gint64 last_frame_time;
+
+static void
+on_after_paint (GdkFrameClock *frame_clock,
+                gpointer       data)
+{
+  gint64 frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+
+  if (last_frame_time != 0)
+    {
+      double interval_ms = (frame_time - last_frame_time) / 1000.0;
+      g_array_append_val (frame_times, interval_ms);
+    }
+
+  last_frame_time = frame_time;
+}
+
+static int
+compare_double (gconstpointer a,
+                gconstpointer b)
+{
+  double da = *(const double *) a;
+  double db = *(const double *) b;
+
+  if (da < db)
+    return -1;
+  else if (da > db)
+    return 1;
+  else
+    return 0;
+}
+
+static double
+percentile (GArray *values,
+            double  fraction)
+{
+  return g_array_index (values, double, (guint) (fraction * (values->len - 1)));
+}
+
+static void
+report_frame_times (void)
+{
+  double sum = 0;
+  guint i;
+
+  if (frame_times->len < 2)
+    {
+      g_print ("Not enough frames painted to report statistics\n");
+      return;
+    }
+
+  g_array_sort (frame_times, compare_double);
+
+  for (i = 0; i < frame_times->len; i++)
+    sum += g_array_index (frame_times, double, i);
+
+  g_print ("%u frames\n", frame_times->len);
+  g_print ("frame time (ms): mean %.2f, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f\n",
+           sum / frame_times->len,
+           percentile (frame_times, 0.5),
+           percentile (frame_times, 0.95),
+           percentile (frame_times, 0.99),
+           percentile (frame_times, 1.0));
+}
+
+static gboolean
+quit_cb (gpointer data)
+{
+  gtk_main_quit ();
+
+  return G_SOURCE_REMOVE;
+}
+
+/* The recording's duration is the timestamp of its last event */
+static gint64
+recording_duration (const char *filename)
+{
+  char *contents;
+  char **lines;
+  gint64 duration = 0;
+  guint i;
+
+  if (!g_file_get_contents (filename, &contents, NULL, NULL))
+    return 0;
+
+  lines = g_strsplit (contents, "\n", -1);
+  for (i = 0; lines[i] != NULL; i++)
+    {
+      if (lines[i][0] != '\0')
+        duration = g_ascii_strtoll (lines[i], NULL, 10);
+    }
+  g_strfreev (lines);
+  g_free (contents);
+
+  return duration;
+}
+
+static GtkWidget *
+create_default_content (void)
+{
+  GtkWidget *box, *sw, *textview, *entry, *button;
+  GtkTextBuffer *buffer;
+  GString *text;
+  int i;
+
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
+
+  entry = gtk_entry_new ();
+  gtk_container_add (GTK_CONTAINER (box), entry);
+
+  button = gtk_button_new_with_label ("A button");
+  gtk_container_add (GTK_CONTAINER (box), button);
+
+  sw = gtk_scrolled_window_new (NULL, NULL);
+  gtk_widget_set_vexpand (sw, TRUE);
+
+  text = g_string_new (NULL);
+  for (i = 0; i < 1000; i++)
+    g_string_append_printf (text, "Line %d of filler text to scroll through\n", i);
+
+  buffer = gtk_text_buffer_new (NULL);
+  gtk_text_buffer_set_text (buffer, text->str, -1);
+  g_string_free (text, TRUE);
+
+  textview = gtk_text_view_new_with_buffer (buffer);
+  g_object_unref (buffer);
+  gtk_container_add (GTK_CONTAINER (sw), textview);
+  gtk_container_add (GTK_CONTAINER (box), sw);
+
+  return box;
+}
+
+int
+main (int argc, char **argv)
+{
+  GOptionContext *context;
+  GError *error = NULL;
+  GtkWidget *window = NULL;
+  gint64 duration;
+  char speed_str[G_ASCII_DTOSTR_BUF_SIZE];
+
+  context = g_option_context_new ("RECORDING - replay an event recording");
+  g_option_context_add_main_entries (context, options, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Option parsing failed: %s\n", error->message);
+      return 1;
+    }
+
+  if (argc < 2)
+    {
+      g_printerr ("Usage: event-replay [OPTIONS] RECORDING\n");
+      return 1;
+    }
+
+  duration = recording_duration (argv[1]);
+  if (duration == 0)
+    {
+      g_printerr ("'%s' does not look like an event recording\n", argv[1]);
+      return 1;
+    }
+
+  /* The replay is driven from inside GDK */
+  g_setenv ("GDK_EVENT_REPLAY", argv[1], TRUE);
+  g_ascii_dtostr (speed_str, sizeof (speed_str), speed);
+  g_setenv ("GDK_EVENT_REPLAY_SPEED", speed_str, TRUE);
+
+  gtk_init ();
+
+  if (ui_file)
+    {
+      GtkBuilder *builder = gtk_builder_new ();
+      GSList *objects, *l;
+
+      if (!gtk_builder_add_from_file (builder, ui_file, &error))
+        {
+          g_printerr ("Could not load '%s': %s\n", ui_file, error->message);
+          return 1;
+        }
+
+      objects = gtk_builder_get_objects (builder);
+      for (l = objects; l; l = l->next)
+        {
+          if (GTK_IS_WINDOW (l->data))
+            {
+              window = l->data;
+              break;
+            }
+        }
+      g_slist_free (objects);
+
+      if (window == NULL)
+        {
+          g_printerr ("'%s' does not contain a window\n", ui_file);
+          return 1;
+        }
+    }
+  else
+    {
+      window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+      gtk_window_set_default_size (GTK_WINDOW (window), 800, 600);
+      gtk_container_add (GTK_CONTAINER (window), create_default_content ());
+    }
+
+  g_signal_connect (window, "destroy", G_CALLBACK (gtk_main_quit), NULL);
+  gtk_widget_show (window);
+
+  frame_times = g_array_new (FALSE, FALSE, sizeof (double));
+  g_signal_connect (gtk_widget_get_frame_clock (window), "after-paint",
+                    G_CALLBACK (on_after_paint), NULL);
+
+  /* Leave some slack after the last replayed event before quitting */
+  g_timeout_add ((guint) (duration / speed / 1000) + 2000, quit_cb, NULL);
+
+  gtk_main ();
+
+  report_frame_times ();
+
+  return 0;
+}
@@ -0,0 +1,245 @@
+/* GTK - The GIMP Toolkit
+ * Copyright (C) 2018 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtk/gtk.h>
+
+/* We use adjustments as items because they are plain GObjects that can
+ * carry a number */
+
+typedef struct {
+  guint count;
+  guint position;
+  guint removed;
+  guint added;
+} ChangeData;
+
+static void
+items_changed_cb (GListModel *model,
+                  guint       position,
+                  guint       removed,
+                  guint       added,
+                  gpointer    data)
+{
+  ChangeData *change = data;
+
+  change->count++;
+  change->position = position;
+  change->removed = removed;
+  change->added = added;
+}
+
+static GtkAdjustment *
+make_item (double value)
+{
+  return gtk_adjustment_new (value, 0.0, 1000.0, 1.0, 1.0, 1.0);
+}
+
+static double
+get_value (GListModel *model,
+           guint       position)
+{
+  GtkAdjustment *item = g_list_model_get_item (model, position);
+  double value;
+
+  g_assert_nonnull (item);
+  value = gtk_adjustment_get_value (item);
+  g_object_unref (item);
+
+  return value;
+}
+
+static GListStore *
+make_store (guint n_items)
+{
+  GListStore *store = g_list_store_new (GTK_TYPE_ADJUSTMENT);
+  guint i;
+
+  for (i = 0; i < n_items; i++)
+    {
+      GtkAdjustment *item = make_item (i);
+      g_list_store_append (store, item);
+      g_object_unref (item);
+    }
+
+  return store;
+}
+
+static gboolean
+is_even (gpointer item,
+         gpointer user_data)
+{
+  return ((int) gtk_adjustment_get_value (item)) % 2 == 0;
+}
+
+static void
+test_filter (void)
+{
+  GListStore *store = make_store (10);
+  GtkFilterListModel *filter;
+  ChangeData change = { 0, };
+  GtkAdjustment *item;
+  guint i;
+
+  filter = gtk_filter_list_model_new (G_LIST_MODEL (store), is_even, NULL, NULL);
+  g_signal_connect (filter, "items-changed", G_CALLBACK (items_changed_cb), &change);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 5);
+  for (i = 0; i < 5; i++)
+    g_assert_cmpfloat (get_value (G_LIST_MODEL (filter), i), ==, 2 * i);
+
+  /* Removing a visible item is a single one-item change */
+  g_list_store_remove (store, 4);
+  g_assert_cmpuint (change.count, ==, 1);
+  g_assert_cmpuint (change.position, ==, 2);
+  g_assert_cmpuint (change.removed, ==, 1);
+  g_assert_cmpuint (change.added, ==, 0);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 4);
+
+  /* Removing a filtered-out item is not a change at all */
+  g_list_store_remove (store, 4);
+  g_assert_cmpuint (change.count, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==, 4);
+
+  /* Inserting a visible item is a single one-item change */
+  item = make_item (100);
+  g_list_store_insert (store, 0, item);
+  g_object_unref (item);
+  g_assert_cmpuint (change.count, ==, 2);
+  g_assert_cmpuint (change.position, ==, 0);
+  g_assert_cmpuint (change.removed, ==, 0);
+  g_assert_cmpuint (change.added, ==, 1);
+  g_assert_cmpfloat (get_value (G_LIST_MODEL (filter), 0), ==, 100);
+
+  gtk_filter_list_model_set_filter_func (filter, NULL, NULL, NULL);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (filter)), ==,
+                    g_list_model_get_n_items (G_LIST_MODEL (store)));
+
+  g_object_unref (filter);
+  g_object_unref (store);
+}
+
+static int
+compare_values (gconstpointer a,
+                gconstpointer b,
+                gpointer      user_data)
+{
+  double va = gtk_adjustment_get_value (GTK_ADJUSTMENT ((gpointer) a));
+  double vb = gtk_adjustment_get_value (GTK_ADJUSTMENT ((gpointer) b));
+
+  return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+static void
+test_sort (void)
+{
+  GListStore *store = g_list_store_new (GTK_TYPE_ADJUSTMENT);
+  GtkSortListModel *sort;
+  ChangeData change = { 0, };
+  GtkAdjustment *item;
+  const double values[] = { 3, 1, 4, 1, 5 };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (values); i++)
+    {
+      item = make_item (values[i]);
+      g_list_store_append (store, item);
+      g_object_unref (item);
+    }
+
+  sort = gtk_sort_list_model_new (G_LIST_MODEL (store), compare_values, NULL, NULL);
+  g_signal_connect (sort, "items-changed", G_CALLBACK (items_changed_cb), &change);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (sort)), ==, 5);
+  for (i = 1; i < 5; i++)
+    g_assert_cmpfloat (get_value (G_LIST_MODEL (sort), i - 1), <=,
+                       get_value (G_LIST_MODEL (sort), i));
+
+  /* Adding an item inserts it at its sorted position */
+  item = make_item (2);
+  g_list_store_append (store, item);
+  g_object_unref (item);
+  g_assert_cmpuint (change.count, ==, 1);
+  g_assert_cmpuint (change.position, ==, 2);
+  g_assert_cmpuint (change.removed, ==, 0);
+  g_assert_cmpuint (change.added, ==, 1);
+  g_assert_cmpfloat (get_value (G_LIST_MODEL (sort), 2), ==, 2);
+
+  /* Removing an item removes it from its sorted position */
+  g_list_store_remove (store, 4); /* the 5 */
+  g_assert_cmpuint (change.count, ==, 2);
+  g_assert_cmpuint (change.position, ==, 5);
+  g_assert_cmpuint (change.removed, ==, 1);
+  g_assert_cmpuint (change.added, ==, 0);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (sort)), ==, 5);
+
+  g_object_unref (sort);
+  g_object_unref (store);
+}
+
+static gpointer
+map_double (gpointer item,
+            gpointer user_data)
+{
+  GtkAdjustment *mapped = make_item (2 * gtk_adjustment_get_value (item));
+
+  g_object_unref (item);
+
+  return mapped;
+}
+
+static void
+test_map (void)
+{
+  GListStore *store = make_store (3);
+  GtkMapListModel *map;
+  ChangeData change = { 0, };
+  GtkAdjustment *item;
+  guint i;
+
+  map = gtk_map_list_model_new (G_LIST_MODEL (store), map_double, NULL, NULL);
+  g_signal_connect (map, "items-changed", G_CALLBACK (items_changed_cb), &change);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (map)), ==, 3);
+  for (i = 0; i < 3; i++)
+    g_assert_cmpfloat (get_value (G_LIST_MODEL (map), i), ==, 2 * i);
+
+  /* Changes are passed through unmodified */
+  item = make_item (10);
+  g_list_store_insert (store, 1, item);
+  g_object_unref (item);
+  g_assert_cmpuint (change.count, ==, 1);
+  g_assert_cmpuint (change.position, ==, 1);
+  g_assert_cmpuint (change.removed, ==, 0);
+  g_assert_cmpuint (change.added, ==, 1);
+  g_assert_cmpfloat (get_value (G_LIST_MODEL (map), 1), ==, 20);
+
+  g_object_unref (map);
+  g_object_unref (store);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  gtk_test_init (&argc, &argv);
+
+  g_test_add_func ("/listmodels/filter", test_filter);
+  g_test_add_func ("/listmodels/sort", test_sort);
+  g_test_add_func ("/listmodels/map", test_map);
+
+  return g_test_run ();
+}
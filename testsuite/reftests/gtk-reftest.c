@@ -256,18 +256,61 @@ save_image (cairo_surface_t *surface,
   g_free (filename);
 }
 
+/* When REFTEST_TIMINGS_FILE is set, append one CSV line per test with
+ * the time it took to render the test ui file, so CI can track render
+ * times per renderer. The file is opened in append mode: parallel
+ * runners for different shards can share one file per renderer.
+ */
+static void
+save_timing (const char *test_name,
+             gint64      elapsed_usec)
+{
+  static FILE *timings_file = NULL;
+  static int enabled = -1;
+  const char *renderer;
+  char *base;
+
+  if (enabled < 0)
+    {
+      const char *filename = g_getenv ("REFTEST_TIMINGS_FILE");
+
+      enabled = 0;
+      if (filename)
+        {
+          timings_file = fopen (filename, "a");
+          if (timings_file == NULL)
+            g_printerr ("Could not open '%s' for timings\n", filename);
+          else
+            enabled = 1;
+        }
+    }
+
+  if (!enabled)
+    return;
+
+  renderer = g_getenv ("GSK_RENDERER");
+  get_components_of_test_file (test_name, NULL, &base);
+  fprintf (timings_file, "%s,%s,%.3f\n",
+           base, renderer ? renderer : "default", elapsed_usec / 1000.0);
+  fflush (timings_file);
+  g_free (base);
+}
+
 static void
 test_ui_file (GFile *file)
 {
   char *ui_file, *reference_file;
   cairo_surface_t *ui_image, *reference_image, *diff_image;
   GtkStyleProvider *provider;
+  gint64 snapshot_start;
 
   ui_file = g_file_get_path (file);
 
   provider = add_extra_css (ui_file, ".css");
 
+  snapshot_start = g_get_monotonic_time ();
   ui_image = reftest_snapshot_ui_file (ui_file);
+  save_timing (ui_file, g_get_monotonic_time () - snapshot_start);
 
   if ((reference_file = get_reference_image (ui_file)) != NULL)
     reference_image = cairo_image_surface_create_from_png (reference_file);
@@ -0,0 +1,58 @@
+#!/bin/sh
+#
+# Shard the reftests across processes and run each shard against
+# several renderers, instead of one serial gtk-reftest run.
+#
+# Usage: run-reftests-parallel.sh [OPTIONS] [TESTDIR]
+#
+#   -j JOBS       number of parallel processes (default: number of cores)
+#   -r RENDERERS  space-separated GSK_RENDERER values (default: "cairo gl")
+#   -o OUTPUT     output directory for images and timings (default: reftest-results)
+#   -b REFTEST    path to the gtk-reftest binary (default: $GTK_REFTEST or ./gtk-reftest)
+#
+# Per-test render times end up in OUTPUT/timings-<renderer>.csv
+# (test,renderer,milliseconds), suitable for tracking as a CI artifact.
+
+JOBS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)
+RENDERERS="cairo gl"
+OUTPUT=reftest-results
+REFTEST=${GTK_REFTEST:-./gtk-reftest}
+
+while getopts j:r:o:b: opt; do
+  case $opt in
+    j) JOBS=$OPTARG ;;
+    r) RENDERERS=$OPTARG ;;
+    o) OUTPUT=$OPTARG ;;
+    b) REFTEST=$OPTARG ;;
+    *) echo "Usage: $0 [-j JOBS] [-r RENDERERS] [-o OUTPUT] [-b REFTEST] [TESTDIR]" >&2
+       exit 2 ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+TESTDIR=${1:-$(dirname "$0")}
+
+if ! test -x "$REFTEST"; then
+  echo "gtk-reftest binary not found at '$REFTEST' (use -b or \$GTK_REFTEST)" >&2
+  exit 2
+fi
+
+mkdir -p "$OUTPUT"
+status=0
+
+for renderer in $RENDERERS; do
+  echo "=== Running reftests with GSK_RENDERER=$renderer, $JOBS processes ==="
+  mkdir -p "$OUTPUT/$renderer"
+  rm -f "$OUTPUT/timings-$renderer.csv"
+
+  # xargs shards the sorted test list into chunks of 10 files and keeps
+  # up to $JOBS gtk-reftest processes busy; each line appended to the
+  # timings file is small enough to stay atomic across processes.
+  find "$TESTDIR" -name '*.ui' ! -name '*.ref.ui' | sort | \
+    xargs -P "$JOBS" -n 10 \
+      env GSK_RENDERER="$renderer" \
+          REFTEST_TIMINGS_FILE="$OUTPUT/timings-$renderer.csv" \
+          "$REFTEST" -o "$OUTPUT/$renderer" -d "$TESTDIR" || status=1
+done
+
+exit $status